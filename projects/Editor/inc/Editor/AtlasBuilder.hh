@@ -0,0 +1,85 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_EDITOR_ATLAS_BUILDER_HH
+#define DD25_EDITOR_ATLAS_BUILDER_HH
+//////////////////////////////////////////////////////////////////
+
+#include <Engine/gfx/TextureAtlas.hh>
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+enum class MipFilter : uint8_t {
+	Box				= 0,	// 2x2 average
+	Kaiser			= 1		// 6-tap Kaiser-windowed sinc, sharper
+};
+
+// Source image, ARGB8888 row order
+struct AtlasImage {
+	const uint32_t*	argb;
+	uint32_t		width;
+	uint32_t		height;
+};
+
+struct AtlasBuildSettings {
+	uint32_t	pageWidth	= 512U;				// Power of two for the PowerVR
+	uint32_t	pageHeight	= 512U;
+	uint32_t	padding		= 8U;				// Edge-extruded gutter around every image
+	bool		mipmaps		= true;
+	MipFilter	filter		= MipFilter::Kaiser;
+	bool		srgb		= true;				// Filter in linear light
+};
+
+struct AtlasPage {
+	uint32_t							width;
+	uint32_t							height;
+	std::vector<std::vector<uint32_t>>	mips;	// Level 0 first, ARGB8888 row order
+};
+
+struct AtlasBuildStats {
+	size_t		images;
+	size_t		pages;
+	double		occupancy;		// Image texels over page texels, gutters count as waste
+	size_t		bindsBefore;	// Texture binds to draw every image once, unpacked
+	size_t		bindsAfter;		// Same, from the atlas
+	double		packSeconds;
+	double		mipSeconds;
+};
+
+//================================================================
+
+//
+// Offline atlas builder.
+//
+// Images are packed largest first with MaxRects (best short side fit),
+// opening a new page when nothing fits. Each image is surrounded by
+// `padding` texels copied from its nearest edge, so bilinear filtering
+// and the first log2(padding) mip levels never sample a neighbour. Mip
+// chains are filtered with premultiplied alpha in linear light and run
+// row-parallel on the job system. The result is the pages plus an
+// AtlasRect per image, in input order, for TextureAtlas.
+//
+class AtlasBuilder {
+public:
+	// Default Constructor
+	AtlasBuilder() = default;
+
+	// Destructor
+	~AtlasBuilder() noexcept = default;
+
+	bool build(const AtlasImage* images, size_t count, const AtlasBuildSettings& settings, std::vector<AtlasPage>& pages, std::vector<AtlasRect>& rects, AtlasBuildStats* stats = nullptr) const;
+
+	// Fill `mips` (level 0 already present) down to 1x1
+	static void buildMipChain(std::vector<std::vector<uint32_t>>& mips, uint32_t width, uint32_t height, MipFilter filter, bool srgb);
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_EDITOR_ATLAS_BUILDER_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,162 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_EDITOR_LIGHTMAP_BAKER_HH
+#define DD25_EDITOR_LIGHTMAP_BAKER_HH
+//////////////////////////////////////////////////////////////////
+
+#include <Editor/TextureCooker.hh>
+#include <Editor/TriangleBvh.hh>
+
+#include <Engine/math/Geometry.hh>
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+enum class LightmapLightType : uint8_t {
+	Directional		= 0,
+	Point			= 1
+};
+
+struct LightmapLight {
+	LightmapLightType	type		= LightmapLightType::Directional;
+	Float3				position	= { 0.0f, 0.0f, 0.0f };		// Point
+	Float3				direction	= { 0.0f, -1.0f, 0.0f };	// Directional, the way the light travels
+	Float3				color		= { 1.0f, 1.0f, 1.0f };		// Light on a white surface facing it (at distance 1 for points)
+	float				range		= 0.0f;						// Point, no light beyond it; 0 = unbounded
+};
+
+// Level geometry to bake, everything in it casts and receives
+struct LightmapBakeInput {
+	const Float3*			positions;
+	const Float3*			normals;		// Per vertex, nullptr for flat shading
+	const uint32_t*			indices;
+	size_t					indexCount;
+	const Float3*			albedo;			// Per triangle reflectance, nullptr for 0.5 grey
+	const Float3*			emission;		// Per triangle emitted light, nullptr for none
+	const LightmapLight*	lights;
+	size_t					lightCount;
+};
+
+struct LightmapBakeSettings {
+	uint32_t			size			= 512U;			// Lightmap width and height, power of two
+	float				texelsPerUnit	= 4.0f;			// Shrunk until every chart fits
+	uint32_t			padding			= 2U;			// Gutter texels around each chart
+	float				chartAngle		= 0.9f;			// Cosine, neighbours bent further than this start a new chart
+	uint32_t			samplesPerPass	= 4U;			// Paths per texel per pass
+	uint32_t			bounces			= 2U;			// Indirect bounces, 0 for direct light only
+	Float3				sky				= { 0.0f, 0.0f, 0.0f };	// Light arriving along rays that leave the level
+	float				rayBias			= 1.0e-3f;		// Ray origins are pushed off the surface by this
+	bool				denoise			= true;			// Edge-aware blur within each chart
+	uint32_t			dilate			= 4U;			// Rings of gutter filled from the chart edge
+	float				overbright		= 2.0f;			// Texels store light / overbright
+	TextureCookSettings	cook			= { PixelFormat::RGB565 };
+	uint32_t			seed			= 0x9E3779B9U;	// Sampling seed, bakes are deterministic
+};
+
+struct LightmapBakeStats {
+	size_t		triangles;
+	size_t		charts;
+	size_t		texels;				// Covered by a triangle, gutters excluded
+	float		texelsPerUnit;		// After shrinking to fit
+	uint32_t	passes;
+	uint64_t	rays;				// Shadow and bounce rays, all passes
+	double		chartSeconds;
+	double		traceSeconds;		// All passes
+	double		raysPerSecond;
+};
+
+// Cooked lightmap plus the UVs that address it; once the texture is
+// uploaded, it and `intensityScale` make a Lightmap
+struct LightmapBakeResult {
+	CookedTexture		texture;
+	std::vector<Float2>	uvs;				// One per index, [0, 1]
+	float				intensityScale;		// ILightmap::intensityScale()
+};
+
+//================================================================
+
+//
+// Offline lightmap baker.
+//
+// `begin()` splits the level into charts, flood-filling across shared
+// edges while face normals stay within `chartAngle`, projects each chart
+// onto its own plane, shelf-packs the charts into the page (shrinking
+// the texel density until they fit) and rasterizes one sample per
+// covered texel.
+//
+// Each `bakePass()` path-traces `samplesPerPass` more paths per texel
+// and folds them into a running mean, so a preview can be resolved
+// after any pass and refined by calling it again. Paths gather direct
+// light with shadow rays to every light and follow cosine-weighted
+// bounces off the level. Texels are traced four at a time as packets
+// through the BVH, spread across the job system, and every path's
+// random numbers come from its texel, pass and sample, so results do
+// not depend on thread count.
+//
+// `resolve()` denoises with a bilateral filter that stays inside a
+// chart, dilates into the gutters so filtering never reads unlit
+// texels, and cooks the page into one of the PowerVR formats.
+//
+class LightmapBaker {
+public:
+	// Default Constructor
+	LightmapBaker() = default;
+
+	// Destructor
+	~LightmapBaker() noexcept = default;
+
+	LightmapBaker(const LightmapBaker&) = delete;
+	LightmapBaker& operator=(const LightmapBaker&) = delete;
+
+	// Chart, pack and rasterize; false when the input is empty or no chart layout fits
+	bool begin(const LightmapBakeInput& input, const LightmapBakeSettings& settings);
+
+	// Trace one more pass over every texel
+	void bakePass();
+
+	// Filter, encode and cook the estimate so far
+	bool resolve(LightmapBakeResult& out, TextureCookStats* cookStats = nullptr) const;
+
+	// begin(), `passes` x bakePass(), resolve()
+	bool bake(const LightmapBakeInput& input, const LightmapBakeSettings& settings, uint32_t passes, LightmapBakeResult& out);
+
+	// Unfiltered estimate so far as row-order ARGB8888, for progress views
+	void preview(std::vector<uint32_t>& argb) const;
+
+	constexpr inline const LightmapBakeStats& stats() const noexcept { return mStats; }
+
+private:
+	// One lightmap texel's sample point
+	struct Texel {
+		Float3		position;
+		Float3		normal;			// Shading normal
+		Float3		face;			// Geometric normal, for the ray offset
+		uint32_t	pixel;			// y * size + x
+	};
+
+	Float3 mean(size_t texel) const noexcept;
+	uint32_t encode(const Float3& light) const noexcept;
+
+	LightmapBakeSettings	mSettings;
+	TriangleBvh				mBvh;
+	std::vector<Float3>		mFaceNormals;
+	std::vector<Float3>		mAlbedo;
+	std::vector<Float3>		mEmission;
+	std::vector<LightmapLight>	mLights;
+	std::vector<Float2>		mUvs;
+	std::vector<Texel>		mTexels;
+	std::vector<Float3>		mSums;			// Per texel, summed over every path
+	std::vector<int32_t>	mCharts;		// Per pixel, owning chart or -1
+	LightmapBakeStats		mStats		= {};
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_EDITOR_LIGHTMAP_BAKER_HH
+//////////////////////////////////////////////////////////////////
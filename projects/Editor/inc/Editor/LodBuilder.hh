@@ -0,0 +1,74 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_EDITOR_LOD_BUILDER_HH
+#define DD25_EDITOR_LOD_BUILDER_HH
+//////////////////////////////////////////////////////////////////
+
+#include <Engine/math/Geometry.hh>
+#include <Engine/scene/MeshLod.hh>
+
+#include <cstdint>
+#include <cstddef>
+
+class Mesh;
+
+//================================================================
+
+// Indexed triangle list to simplify (normals and uvs are optional)
+struct LodSourceMesh {
+	const Float3*		positions;
+	const Float3*		normals;
+	const Float2*		uvs;
+	size_t				vertexCount;
+	const uint16_t*		indices;
+	size_t				indexCount;
+};
+
+struct LodBuildSettings {
+	size_t		levels			= 4;		// Levels to emit, including level 0
+	float		reduction		= 0.5f;		// Triangle ratio kept per level
+	float		maxError		= 1.0e30f;	// Stop collapsing past this object-space error
+	float		normalWeight	= 0.5f;		// Attribute weights in the quadric metric
+	float		uvWeight		= 1.0f;
+	float		borderWeight	= 10.0f;	// Penalty for moving open mesh borders
+	float		pixelError		= 1.0f;		// Projected error at which a level switches in
+};
+
+//================================================================
+
+//
+// Quadric error metric (Garland-Heckbert) mesh simplifier.
+//
+// Quadrics are built over position + normal + uv, so collapses that
+// would smear shading or stretch texture cost more than pure geometric
+// ones. Collapses are half-edge (a vertex merges into a neighbour and
+// keeps its position and attributes), so every level shares the source
+// vertex buffer and only the index list changes. Vertices on uv/normal
+// seams are locked, open borders are held by perpendicular planes.
+//
+class LodBuilder {
+public:
+	// Default Constructor
+	LodBuilder() = default;
+
+	// Destructor
+	~LodBuilder() noexcept = default;
+
+	//
+	// Build `settings.levels` levels into `out` (cleared first). Level 0
+	// is the source index list. Returns the number of levels emitted,
+	// which may be lower when the mesh can't be reduced any further.
+	//
+	size_t build(const LodSourceMesh& src, const LodBuildSettings& settings, MeshLodChain& out) const;
+
+	// Build the chain of a bound mesh in place (see `Mesh::lods()`)
+	size_t build(Mesh& mesh, const LodBuildSettings& settings) const;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_EDITOR_LOD_BUILDER_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,70 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_EDITOR_PVS_BAKER_HH
+#define DD25_EDITOR_PVS_BAKER_HH
+//////////////////////////////////////////////////////////////////
+
+#include <Engine/math/Geometry.hh>
+#include <Engine/scene/CellVisibility.hh>
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+// Cells to bake and the level geometry that blocks sight between them
+struct PvsBakeInput {
+	const Aabb*			cells;
+	size_t				cellCount;
+	const Float3*		positions;
+	const uint32_t*		indices;		// Occluder triangles
+	size_t				indexCount;
+};
+
+struct PvsBakeSettings {
+	uint32_t	samplesPerPair	= 256;			// Rays cast between two non-adjacent cells
+	float		touchEpsilon	= 1.0e-3f;		// Max gap between faces that still share a portal
+	uint32_t	seed			= 0x9E3779B9U;	// Sampling seed, bakes are deterministic
+};
+
+struct PvsBakeStats {
+	size_t		cells;
+	size_t		portals;
+	size_t		visiblePairs;	// Set bits in the PVS (including each cell itself)
+	size_t		raysCast;
+	double		seconds;
+};
+
+//================================================================
+
+//
+// Offline cell/portal/PVS builder.
+//
+// Portals are the shared face rectangles of touching cells. A cell can see
+// another if it is reachable through the portal graph and at least one
+// sample ray between the two cells clears the occluder geometry (cells
+// sharing a portal always see each other). Source cells are baked in
+// parallel on the engine's job system.
+//
+class PvsBaker {
+public:
+	// Default Constructor
+	PvsBaker() = default;
+
+	// Destructor
+	~PvsBaker() noexcept = default;
+
+	// Uniform grid partition of `level`, for levels without authored cells
+	static std::vector<Aabb> partitionGrid(const Aabb& level, const Float3& cellSize);
+
+	bool bake(const PvsBakeInput& input, const PvsBakeSettings& settings, CellVisibility& out, PvsBakeStats* stats = nullptr) const;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_EDITOR_PVS_BAKER_HH
+//////////////////////////////////////////////////////////////////
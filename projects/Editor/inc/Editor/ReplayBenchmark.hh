@@ -0,0 +1,68 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_EDITOR_REPLAY_BENCHMARK_HH
+#define DD25_EDITOR_REPLAY_BENCHMARK_HH
+//////////////////////////////////////////////////////////////////
+
+#include <Engine/gfx/CommandCapture.hh>
+
+#include <cstdint>
+#include <cstddef>
+
+//================================================================
+
+struct ReplaySettings {
+	uint32_t	iterations		= 100U;		// Timed replays
+	uint32_t	warmup			= 5U;		// Untimed replays first
+	uint32_t	width			= 0;		// Target size, 0 = as captured
+	uint32_t	height			= 0;
+};
+
+// Timings are per replayed frame
+struct ReplayResult {
+	uint32_t	draws;			// Executed per frame
+	uint32_t	stateChanges;
+	uint32_t	iterations;
+	float		minMs;
+	float		medianMs;
+	float		meanMs;
+	float		maxMs;
+	float		sortMs;			// Medians of the stages
+	float		executeMs;
+	float		rasterMs;
+	uint64_t	frameHash;		// Of the last frame, equal runs draw equal pixels
+};
+
+//================================================================
+
+//
+// Headless render benchmark over a captured frame (see
+// Engine/gfx/CommandCapture.hh).
+//
+// Each iteration records the capture into a fresh queue, sorts it and
+// executes it on the software backend into an off-screen target, so the
+// whole submission path is timed on identical input every run. The
+// frame hash confirms that two builds being compared drew the same
+// thing.
+//
+class ReplayBenchmark {
+public:
+	// Default Constructor
+	ReplayBenchmark() = default;
+
+	// Destructor
+	~ReplayBenchmark() noexcept = default;
+
+	bool run(const CommandReplay& replay, const ReplaySettings& settings, ReplayResult& result) const;
+
+	// Open `path` and run it
+	bool run(const char* path, const ReplaySettings& settings, ReplayResult& result) const;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_EDITOR_REPLAY_BENCHMARK_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,87 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_EDITOR_SCENE_WRITER_HH
+#define DD25_EDITOR_SCENE_WRITER_HH
+//////////////////////////////////////////////////////////////////
+
+#include <Editor/LodBuilder.hh>
+
+#include <Engine/core/StringId.hh>
+#include <Engine/io/SceneFile.hh>
+#include <Engine/scene/CellVisibility.hh>
+#include <Engine/scene/MeshLod.hh>
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//================================================================
+
+//
+// Collects meshes, objects and visibility and writes them as a cooked
+// scene file (see Engine/io/SceneFile.hh) that `Scene::load()` uses in
+// place. Everything is copied on add, callers may free their data.
+//
+class SceneWriter {
+public:
+	// Default Constructor
+	SceneWriter() = default;
+
+	// Destructor
+	~SceneWriter() noexcept = default;
+
+	void clear();
+
+	// Add a mesh (and its LOD chain, if built), returns its mesh index
+	uint32_t addMesh(const char* name, const LodSourceMesh& mesh, const MeshLodChain* lods = nullptr);
+
+	// Place an instance of mesh `mesh`
+	void addObject(const char* name, uint32_t mesh, const Sphere& worldBounds);
+
+	void setVisibility(const CellVisibility& visibility);
+
+	// Keep the names in the file (for tools), ids are always written
+	inline void setKeepStrings(bool keep) noexcept { mKeepStrings = keep; }
+
+	// Lay the file out in memory
+	void serialize(std::vector<uint8_t>& out) const;
+
+	bool write(const char* path) const;
+
+private:
+	StringId intern(const char* name);
+
+	// Meshes
+	std::vector<SceneMeshRecord>	mMeshes;
+	std::vector<MeshLodLevel>		mLodLevels;
+	std::vector<Float3>				mPositions;
+	std::vector<Float3>				mNormals;
+	std::vector<Float2>				mUvs;
+	std::vector<uint16_t>			mIndices;
+
+	// Objects
+	std::vector<Sphere>				mObjBounds;
+	std::vector<uint32_t>			mObjMeshes;
+	std::vector<StringId>			mObjNames;
+
+	// Visibility
+	std::vector<VisCell>			mCells;
+	std::vector<VisPortal>			mPortals;
+	std::vector<uint32_t>			mPvs;
+
+	// Strings
+	std::vector<SceneStringRecord>	mStringTable;
+	std::string						mStrings;
+	bool							mKeepStrings = true;
+	bool							mHasNormals = true;
+	bool							mHasUvs = true;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_EDITOR_SCENE_WRITER_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,92 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_EDITOR_TRIANGLE_BVH_HH
+#define DD25_EDITOR_TRIANGLE_BVH_HH
+//////////////////////////////////////////////////////////////////
+
+#include <Engine/math/Geometry.hh>
+#include <Engine/physics/Ray.hh>
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+struct BvhHit {
+	float		t;
+	float		u, v;		// Barycentrics of the hit on `triangle`
+	uint32_t	triangle;	// Index into the source triangle list
+};
+
+// Four rays traced together, laid out for SIMD
+struct alignas(16) RayPacket {
+	float	ox[4], oy[4], oz[4];
+	float	dx[4], dy[4], dz[4];
+	float	ix[4], iy[4], iz[4];	// Reciprocal directions
+
+	inline void set(size_t lane, const Float3& origin, const Float3& dir) noexcept {
+		ox[lane] = origin.x; oy[lane] = origin.y; oz[lane] = origin.z;
+		dx[lane] = dir.x; dy[lane] = dir.y; dz[lane] = dir.z;
+		ix[lane] = 1.0f / dir.x; iy[lane] = 1.0f / dir.y; iz[lane] = 1.0f / dir.z;
+	}
+};
+
+//================================================================
+
+//
+// Bounding volume hierarchy over a static triangle soup, used by the
+// offline bakers. Median split on the longest centroid axis, small
+// leaves, triangles copied into leaf order for cache-friendly traversal.
+//
+class TriangleBvh {
+public:
+	static constexpr uint32_t LEAF_SIZE = 4U;
+
+	// Default Constructor
+	TriangleBvh() = default;
+
+	// Destructor
+	~TriangleBvh() noexcept = default;
+
+	void build(const Float3* positions, const uint32_t* indices, size_t triangleCount);
+
+	// Any hit closer than `tMax` (shadow/visibility rays)
+	bool occluded(const Ray& ray, float tMax) const noexcept;
+
+	// Closest hit closer than `tMax`
+	bool intersect(const Ray& ray, float tMax, BvhHit& hit) const noexcept;
+
+	//
+	// Packet versions, one traversal for four rays. Only lanes set in
+	// `mask` are traced; the result has bit i set when lane i is occluded
+	// or hit something. Coherent packets (neighbouring texels, one light)
+	// share most of their node visits, so each box and triangle test is
+	// done for four rays at the cost of one.
+	//
+	uint32_t occluded4(const RayPacket& packet, const float (&tMax)[4], uint32_t mask = 0xFU) const noexcept;
+	uint32_t intersect4(const RayPacket& packet, const float (&tMax)[4], BvhHit (&hits)[4], uint32_t mask = 0xFU) const noexcept;
+
+	inline bool empty() const noexcept { return mNodes.empty(); }
+	inline size_t triangleCount() const noexcept { return mTriIds.size(); }
+	inline const Aabb& bounds() const noexcept { return mNodes.front().bounds; }
+
+private:
+	struct Node {
+		Aabb		bounds;
+		uint32_t	first;		// Leaf: first triangle, interior: left child (right = first + 1)
+		uint32_t	count;		// Triangles in the leaf, 0 for interior nodes
+	};
+
+	std::vector<Node>		mNodes;
+	std::vector<Float3>		mVerts;		// 3 per triangle, in leaf order
+	std::vector<uint32_t>	mTriIds;	// Source triangle per leaf slot
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_EDITOR_TRIANGLE_BVH_HH
+//////////////////////////////////////////////////////////////////
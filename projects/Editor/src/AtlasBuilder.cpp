@@ -0,0 +1,327 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Editor/AtlasBuilder.hh>
+
+#include <Engine/core/Jobs.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+//================================================================
+
+namespace {
+
+struct PackRect {
+	int32_t		x, y;
+	int32_t		w, h;
+
+	inline bool contains(const PackRect& o) const noexcept {
+		return o.x >= x && o.y >= y && o.x + o.w <= x + w && o.y + o.h <= y + h;
+	}
+};
+
+// MaxRects bin, best short side fit
+class MaxRectsBin {
+public:
+	MaxRectsBin(int32_t width, int32_t height)
+		: mFree{ { 0, 0, width, height } } {
+	}
+
+	bool insert(int32_t w, int32_t h, PackRect& out) {
+		int32_t bestShort = INT32_MAX;
+		int32_t bestLong = INT32_MAX;
+		const PackRect* best = nullptr;
+		for (const PackRect& r : mFree) {
+			if (r.w < w || r.h < h) {
+				continue;
+			}
+			const int32_t shortSide = std::min(r.w - w, r.h - h);
+			const int32_t longSide = std::max(r.w - w, r.h - h);
+			if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong)) {
+				bestShort = shortSide;
+				bestLong = longSide;
+				best = &r;
+			}
+		}
+		if (!best) {
+			return false;
+		}
+
+		out = { best->x, best->y, w, h };
+		place(out);
+		return true;
+	}
+
+private:
+	void place(const PackRect& used) {
+		std::vector<PackRect> next;
+		next.reserve(mFree.size() + 4U);
+		for (const PackRect& r : mFree) {
+			if (used.x >= r.x + r.w || used.x + used.w <= r.x || used.y >= r.y + r.h || used.y + used.h <= r.y) {
+				next.push_back(r);
+				continue;
+			}
+
+			// Keep the parts of the free rectangle on each side of the used one
+			if (used.x > r.x) {
+				next.push_back({ r.x, r.y, used.x - r.x, r.h });
+			}
+			if (used.x + used.w < r.x + r.w) {
+				next.push_back({ used.x + used.w, r.y, r.x + r.w - (used.x + used.w), r.h });
+			}
+			if (used.y > r.y) {
+				next.push_back({ r.x, r.y, r.w, used.y - r.y });
+			}
+			if (used.y + used.h < r.y + r.h) {
+				next.push_back({ r.x, used.y + used.h, r.w, r.y + r.h - (used.y + used.h) });
+			}
+		}
+
+		// Drop free rectangles inside others
+		mFree.clear();
+		for (size_t i = 0; i < next.size(); ++i) {
+			bool redundant = false;
+			for (size_t j = 0; j < next.size() && !redundant; ++j) {
+				if (i != j && next[j].contains(next[i])) {
+					redundant = !next[i].contains(next[j]) || j < i;
+				}
+			}
+			if (!redundant) {
+				mFree.push_back(next[i]);
+			}
+		}
+	}
+
+	std::vector<PackRect>	mFree;
+};
+
+//----------------------------------------------------------------
+
+struct Linear {
+	float		r, g, b, a;
+};
+
+inline float srgbToLinear(float c) noexcept {
+	return (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+inline float linearToSrgb(float c) noexcept {
+	return (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+}
+
+inline uint32_t toByte(float v) noexcept {
+	return static_cast<uint32_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+// Zeroth order modified Bessel function, for the Kaiser window
+inline double besselI0(double x) noexcept {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; ++k) {
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+// Weights for source texels 2i-2 .. 2i+3 when halving
+struct DownsampleKernel {
+	float		taps[6];
+
+	explicit DownsampleKernel(MipFilter filter) noexcept {
+		constexpr double PI = 3.14159265358979323846;
+		constexpr double ALPHA = 4.0;
+		constexpr double RADIUS = 3.0;
+		double weights[6];
+		double total = 0.0;
+		for (int i = 0; i < 6; ++i) {
+			const double d = static_cast<double>(i) - 2.5;
+			if (filter == MipFilter::Box) {
+				weights[i] = (i == 2 || i == 3) ? 1.0 : 0.0;
+			} else {
+				const double x = d * 0.5;
+				const double sinc = (x == 0.0) ? 1.0 : std::sin(PI * x) / (PI * x);
+				const double r = d / RADIUS;
+				weights[i] = sinc * besselI0(ALPHA * std::sqrt(std::max(0.0, 1.0 - r * r))) / besselI0(ALPHA);
+			}
+			total += weights[i];
+		}
+		for (int i = 0; i < 6; ++i) {
+			taps[i] = static_cast<float>(weights[i] / total);
+		}
+	}
+};
+
+// Halve one axis of `src` (w x h), `horizontal` picks which
+void downsampleAxis(const std::vector<Linear>& src, uint32_t w, uint32_t h, bool horizontal, const DownsampleKernel& kernel, std::vector<Linear>& dst) {
+	const uint32_t dw = horizontal ? std::max(1U, w / 2U) : w;
+	const uint32_t dh = horizontal ? h : std::max(1U, h / 2U);
+	dst.resize(static_cast<size_t>(dw) * dh);
+	const uint32_t length = horizontal ? w : h;
+
+	JobSystem::instance().parallelFor(dh, 8, [&](size_t begin, size_t end) {
+		for (size_t y = begin; y < end; ++y) {
+			for (uint32_t x = 0; x < dw; ++x) {
+				Linear& out = dst[y * dw + x];
+				if (length == 1U) {
+					out = src[y * w + x];
+					continue;
+				}
+				const int32_t center = static_cast<int32_t>(horizontal ? x : y) * 2;
+				out = { 0.0f, 0.0f, 0.0f, 0.0f };
+				for (int32_t t = 0; t < 6; ++t) {
+					const int32_t s = std::clamp(center - 2 + t, 0, static_cast<int32_t>(length) - 1);
+					const Linear& in = horizontal ? src[y * w + static_cast<uint32_t>(s)] : src[static_cast<size_t>(s) * w + x];
+					const float k = kernel.taps[t];
+					out.r += in.r * k;
+					out.g += in.g * k;
+					out.b += in.b * k;
+					out.a += in.a * k;
+				}
+			}
+		}
+	});
+}
+
+} // namespace
+
+//================================================================
+
+void AtlasBuilder::buildMipChain(std::vector<std::vector<uint32_t>>& mips, uint32_t width, uint32_t height, MipFilter filter, bool srgb) {
+	if (mips.empty()) {
+		return;
+	}
+	mips.resize(1);
+
+	float decode[256];
+	for (uint32_t i = 0; i < 256; ++i) {
+		const float c = static_cast<float>(i) / 255.0f;
+		decode[i] = srgb ? srgbToLinear(c) : c;
+	}
+
+	// Premultiplied linear copy of level 0
+	std::vector<Linear> level(static_cast<size_t>(width) * height);
+	const std::vector<uint32_t>& base = mips[0];
+	for (size_t i = 0; i < level.size(); ++i) {
+		const uint32_t p = base[i];
+		const float a = static_cast<float>(p >> 24) / 255.0f;
+		level[i] = { decode[(p >> 16) & 0xFFU] * a, decode[(p >> 8) & 0xFFU] * a, decode[p & 0xFFU] * a, a };
+	}
+
+	const DownsampleKernel kernel(filter);
+	std::vector<Linear> half;
+	uint32_t w = width, h = height;
+	while (w > 1U || h > 1U) {
+		downsampleAxis(level, w, h, true, kernel, half);
+		w = std::max(1U, w / 2U);
+		downsampleAxis(half, w, h, false, kernel, level);
+		h = std::max(1U, h / 2U);
+
+		std::vector<uint32_t> out(static_cast<size_t>(w) * h);
+		JobSystem::instance().parallelFor(h, 16, [&](size_t begin, size_t end) {
+			for (size_t i = begin * w; i < end * w; ++i) {
+				const Linear& c = level[i];
+				const float inv = (c.a > 0.0f) ? 1.0f / c.a : 0.0f;
+				auto encode = [&](float v) { return toByte(srgb ? linearToSrgb(v * inv) : v * inv); };
+				out[i] = (toByte(c.a) << 24) | (encode(c.r) << 16) | (encode(c.g) << 8) | encode(c.b);
+			}
+		});
+		mips.push_back(std::move(out));
+	}
+}
+
+//----------------------------------------------------------------
+
+bool AtlasBuilder::build(const AtlasImage* images, size_t count, const AtlasBuildSettings& settings, std::vector<AtlasPage>& pages, std::vector<AtlasRect>& rects, AtlasBuildStats* stats) const {
+	const auto start = std::chrono::steady_clock::now();
+	const int32_t pad = static_cast<int32_t>(settings.padding);
+	const int32_t pageW = static_cast<int32_t>(settings.pageWidth);
+	const int32_t pageH = static_cast<int32_t>(settings.pageHeight);
+	pages.clear();
+	rects.assign(count, AtlasRect{});
+
+	// Largest side first, then area, ties in input order
+	std::vector<uint32_t> order(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		order[i] = i;
+		if (!images[i].argb || !images[i].width || !images[i].height
+		|| static_cast<int32_t>(images[i].width) + pad * 2 > pageW || static_cast<int32_t>(images[i].height) + pad * 2 > pageH) {
+			return false;
+		}
+	}
+	std::stable_sort(order.begin(), order.end(), [images](uint32_t a, uint32_t b) {
+		const uint32_t sa = std::max(images[a].width, images[a].height), sb = std::max(images[b].width, images[b].height);
+		if (sa != sb) {
+			return sa > sb;
+		}
+		return images[a].width * images[a].height > images[b].width * images[b].height;
+	});
+
+	std::vector<MaxRectsBin> bins;
+	std::vector<PackRect> slots(count);
+	std::vector<uint16_t> pageOf(count);
+	for (uint32_t i : order) {
+		const int32_t w = static_cast<int32_t>(images[i].width) + pad * 2;
+		const int32_t h = static_cast<int32_t>(images[i].height) + pad * 2;
+		size_t page = 0;
+		while (page < bins.size() && !bins[page].insert(w, h, slots[i])) {
+			++page;
+		}
+		if (page == bins.size()) {
+			bins.emplace_back(pageW, pageH);
+			bins.back().insert(w, h, slots[i]);
+		}
+		pageOf[i] = static_cast<uint16_t>(page);
+	}
+
+	// Copy images in with their gutters, extruding the edge texels outwards
+	pages.resize(bins.size());
+	for (AtlasPage& page : pages) {
+		page.width = settings.pageWidth;
+		page.height = settings.pageHeight;
+		page.mips.assign(1, std::vector<uint32_t>(static_cast<size_t>(pageW) * pageH, 0U));
+	}
+
+	size_t imageTexels = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		const AtlasImage& image = images[i];
+		const PackRect& slot = slots[i];
+		std::vector<uint32_t>& texels = pages[pageOf[i]].mips[0];
+		for (int32_t y = 0; y < slot.h; ++y) {
+			const int32_t sy = std::clamp(y - pad, 0, static_cast<int32_t>(image.height) - 1);
+			for (int32_t x = 0; x < slot.w; ++x) {
+				const int32_t sx = std::clamp(x - pad, 0, static_cast<int32_t>(image.width) - 1);
+				texels[static_cast<size_t>(slot.y + y) * pageW + static_cast<size_t>(slot.x + x)] = image.argb[static_cast<size_t>(sy) * image.width + static_cast<size_t>(sx)];
+			}
+		}
+
+		rects[i] = {
+			static_cast<float>(slot.x + pad) / static_cast<float>(pageW),
+			static_cast<float>(slot.y + pad) / static_cast<float>(pageH),
+			static_cast<float>(slot.x + pad + static_cast<int32_t>(image.width)) / static_cast<float>(pageW),
+			static_cast<float>(slot.y + pad + static_cast<int32_t>(image.height)) / static_cast<float>(pageH),
+			pageOf[i], 0
+		};
+		imageTexels += static_cast<size_t>(image.width) * image.height;
+	}
+	const auto packed = std::chrono::steady_clock::now();
+
+	if (settings.mipmaps) {
+		for (AtlasPage& page : pages) {
+			buildMipChain(page.mips, page.width, page.height, settings.filter, settings.srgb);
+		}
+	}
+
+	if (stats) {
+		const auto now = std::chrono::steady_clock::now();
+		stats->images = count;
+		stats->pages = pages.size();
+		stats->occupancy = pages.empty() ? 0.0 : static_cast<double>(imageTexels) / (static_cast<double>(pageW) * pageH * pages.size());
+		stats->bindsBefore = count;
+		stats->bindsAfter = pages.size();
+		stats->packSeconds = std::chrono::duration<double>(packed - start).count();
+		stats->mipSeconds = std::chrono::duration<double>(now - packed).count();
+	}
+	return true;
+}
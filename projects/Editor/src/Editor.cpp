@@ -1,9 +1,51 @@
 #include <Editor/Editor.hh>
+#include <Editor/ReplayBenchmark.hh>
 
 #ifndef EXIT_SUCCESS
 #define EXIT_SUCCESS	0
 #endif//EXIT_SUCCESS
 
+#ifndef EXIT_FAILURE
+#define EXIT_FAILURE	1
+#endif//EXIT_FAILURE
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//================================================================
+
+namespace {
+
+// replay <capture> [iterations] [width height]
+int replayCommand(int argc, char** argv) {
+	if (argc < 1) {
+		std::fprintf(stderr, "usage: replay <capture> [iterations] [width height]\n");
+		return EXIT_FAILURE;
+	}
+	ReplaySettings settings;
+	if (argc > 1) {
+		settings.iterations = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+	}
+	if (argc > 3) {
+		settings.width = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+		settings.height = static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10));
+	}
+
+	ReplayResult result;
+	if (!ReplayBenchmark().run(argv[0], settings, result)) {
+		std::fprintf(stderr, "replay: can't play %s\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	std::printf("%s: %u draws, %u state changes, %u runs\n", argv[0], result.draws, result.stateChanges, result.iterations);
+	std::printf("  frame  min %.3f  median %.3f  mean %.3f  max %.3f ms\n", result.minMs, result.medianMs, result.meanMs, result.maxMs);
+	std::printf("  sort %.3f  execute %.3f  raster %.3f ms (medians)\n", result.sortMs, result.executeMs, result.rasterMs);
+	std::printf("  hash %016llx\n", static_cast<unsigned long long>(result.frameHash));
+	return EXIT_SUCCESS;
+}
+
+} // namespace
+
 //================================================================
 
 int main(
@@ -11,6 +53,9 @@ int main(
 	char**		argv,
 	char**		envp
 ) {
+	if (argc > 1 && std::strcmp(argv[1], "replay") == 0) {
+		return replayCommand(argc - 2, argv + 2);
+	}
 	//TODO: Editor Main Loop
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,652 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Editor/LightmapBaker.hh>
+
+#include <Engine/core/Jobs.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr float PI = 3.14159265358979f;
+constexpr float FAR = 1.0e30f;
+constexpr uint32_t FILTER_RADIUS = 2U;
+
+inline double secondsSince(Clock::time_point start) noexcept {
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+inline Float3 mul(const Float3& a, const Float3& b) noexcept {
+	return { a.x * b.x, a.y * b.y, a.z * b.z };
+}
+
+inline float luminance(const Float3& c) noexcept {
+	return c.x * 0.299f + c.y * 0.587f + c.z * 0.114f;
+}
+
+inline uint32_t popcount4(uint32_t mask) noexcept {
+	return (mask & 1U) + ((mask >> 1) & 1U) + ((mask >> 2) & 1U) + ((mask >> 3) & 1U);
+}
+
+// Integer hash, turns (texel, sample) into an independent stream seed
+inline uint32_t mix(uint32_t h) noexcept {
+	h ^= h >> 16;
+	h *= 0x7FEB352DU;
+	h ^= h >> 15;
+	h *= 0x846CA68BU;
+	h ^= h >> 16;
+	return h;
+}
+
+// xorshift32, seeded per path so results don't depend on thread scheduling
+struct Rng {
+	uint32_t	state;
+
+	inline float next() noexcept {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+	}
+};
+
+// Cosine-weighted direction about `n`, the pdf cancels the cosine and 1/pi of a diffuse bounce
+inline Float3 cosineSample(const Float3& n, Rng& rng) noexcept {
+	const float phi = 2.0f * PI * rng.next();
+	const float r2 = rng.next();
+	const float r = std::sqrt(r2);
+	const float x = r * std::cos(phi);
+	const float y = r * std::sin(phi);
+	const float z = std::sqrt(1.0f - r2);
+
+	// Orthonormal basis without branches on the normal (Duff et al. 2017)
+	const float sign = std::copysign(1.0f, n.z);
+	const float a = -1.0f / (sign + n.z);
+	const float b = n.x * n.y * a;
+	const Float3 t = { 1.0f + sign * n.x * n.x * a, sign * b, -sign * n.x };
+	const Float3 s = { b, sign + n.y * n.y * a, -n.y };
+	return t * x + s * y + n * z;
+}
+
+// Planar chart, triangles are listed by the chart order array
+struct Chart {
+	uint32_t	first;
+	uint32_t	count;
+	Float3		tangent;
+	Float3		bitangent;
+	Float2		min;
+	Float2		max;
+	uint32_t	width;
+	uint32_t	height;
+	uint32_t	x;
+	uint32_t	y;
+};
+
+// Shelf packing at texel density `scale`, false when the page overflows
+bool packCharts(std::vector<Chart>& charts, const std::vector<uint32_t>& bySize, float scale, uint32_t size, uint32_t padding) {
+	for (Chart& chart : charts) {
+		chart.width = static_cast<uint32_t>(std::ceil((chart.max.x - chart.min.x) * scale)) + 1U + padding * 2U;
+		chart.height = static_cast<uint32_t>(std::ceil((chart.max.y - chart.min.y) * scale)) + 1U + padding * 2U;
+	}
+	uint32_t x = 0, y = 0, shelf = 0;
+	for (uint32_t c : bySize) {
+		Chart& chart = charts[c];
+		if (chart.width > size) {
+			return false;
+		}
+		if (x + chart.width > size) {
+			x = 0;
+			y += shelf;
+			shelf = 0;
+		}
+		if (y + chart.height > size) {
+			return false;
+		}
+		chart.x = x;
+		chart.y = y;
+		x += chart.width;
+		shelf = std::max(shelf, chart.height);
+	}
+	return true;
+}
+
+} // namespace
+
+//================================================================
+
+bool LightmapBaker::begin(const LightmapBakeInput& input, const LightmapBakeSettings& settings) {
+	const auto start = Clock::now();
+	mSettings = settings;
+	mStats = {};
+	mFaceNormals.clear();
+	mAlbedo.clear();
+	mEmission.clear();
+	mLights.clear();
+	mUvs.clear();
+	mTexels.clear();
+	mSums.clear();
+	mCharts.clear();
+
+	const size_t triangles = input.indexCount / 3U;
+	const uint32_t size = settings.size;
+	if (!input.positions || !input.indices || triangles == 0 || size == 0 || (size & (size - 1U)) != 0) {
+		return false;
+	}
+	const uint32_t* indices = input.indices;
+	const Float3* positions = input.positions;
+	uint32_t vertexCount = 0;
+	for (size_t i = 0; i < triangles * 3U; ++i) {
+		vertexCount = std::max(vertexCount, indices[i] + 1U);
+	}
+
+	mBvh.build(positions, indices, triangles);
+	mLights.assign(input.lights, input.lights + (input.lights ? input.lightCount : 0U));
+	mFaceNormals.resize(triangles);
+	mAlbedo.resize(triangles);
+	mEmission.resize(triangles);
+	for (size_t t = 0; t < triangles; ++t) {
+		const Float3& a = positions[indices[t * 3U + 0U]];
+		const Float3& b = positions[indices[t * 3U + 1U]];
+		const Float3& c = positions[indices[t * 3U + 2U]];
+		mFaceNormals[t] = normalize(cross(b - a, c - a));
+		mAlbedo[t] = input.albedo ? input.albedo[t] : Float3{ 0.5f, 0.5f, 0.5f };
+		mEmission[t] = input.emission ? input.emission[t] : Float3{ 0.0f, 0.0f, 0.0f };
+	}
+
+	//------------------------------------------------------------
+	// Adjacency across shared edges, vertices welded by position
+	//------------------------------------------------------------
+	std::vector<uint32_t> weld(vertexCount);
+	{
+		std::vector<uint32_t> order(vertexCount);
+		for (uint32_t v = 0; v < vertexCount; ++v) {
+			order[v] = v;
+		}
+		const auto less = [positions](uint32_t a, uint32_t b) {
+			const Float3& p = positions[a];
+			const Float3& q = positions[b];
+			return (p.x != q.x) ? p.x < q.x : ((p.y != q.y) ? p.y < q.y : p.z < q.z);
+		};
+		std::sort(order.begin(), order.end(), less);
+		for (size_t i = 0; i < order.size(); ++i) {
+			const bool same = i > 0 && !less(order[i - 1U], order[i]);
+			weld[order[i]] = same ? weld[order[i - 1U]] : order[i];
+		}
+	}
+
+	std::vector<std::pair<uint64_t, uint32_t>> edges;
+	edges.reserve(triangles * 3U);
+	for (size_t t = 0; t < triangles; ++t) {
+		for (size_t k = 0; k < 3U; ++k) {
+			const uint64_t a = weld[indices[t * 3U + k]];
+			const uint64_t b = weld[indices[t * 3U + (k + 1U) % 3U]];
+			if (a != b) {
+				edges.emplace_back(a < b ? (a << 32) | b : (b << 32) | a, static_cast<uint32_t>(t));
+			}
+		}
+	}
+	std::sort(edges.begin(), edges.end());
+
+	std::vector<std::vector<uint32_t>> adjacent(triangles);
+	for (size_t i = 0; i < edges.size();) {
+		size_t j = i + 1U;
+		while (j < edges.size() && edges[j].first == edges[i].first) {
+			++j;
+		}
+		for (size_t a = i; a < j; ++a) {
+			for (size_t b = i; b < j; ++b) {
+				if (a != b) {
+					adjacent[edges[a].second].push_back(edges[b].second);
+				}
+			}
+		}
+		i = j;
+	}
+
+	//------------------------------------------------------------
+	// Charts: flood fill while normals stay close to the seed's
+	//------------------------------------------------------------
+	std::vector<Chart> charts;
+	std::vector<uint32_t> chartTris;
+	std::vector<int32_t> chartOf(triangles, -1);
+	chartTris.reserve(triangles);
+	for (size_t seed = 0; seed < triangles; ++seed) {
+		if (chartOf[seed] >= 0) {
+			continue;
+		}
+		const int32_t id = static_cast<int32_t>(charts.size());
+		const Float3 seedNormal = mFaceNormals[seed];
+		Chart chart = {};
+		chart.first = static_cast<uint32_t>(chartTris.size());
+		chartOf[seed] = id;
+		chartTris.push_back(static_cast<uint32_t>(seed));
+		for (size_t qi = chart.first; qi < chartTris.size(); ++qi) {
+			for (uint32_t n : adjacent[chartTris[qi]]) {
+				if (chartOf[n] < 0 && dot(mFaceNormals[n], seedNormal) >= settings.chartAngle) {
+					chartOf[n] = id;
+					chartTris.push_back(n);
+				}
+			}
+		}
+		chart.count = static_cast<uint32_t>(chartTris.size()) - chart.first;
+
+		// Project onto the plane of the area-weighted normal
+		Float3 normal = { 0.0f, 0.0f, 0.0f };
+		for (uint32_t i = chart.first; i < chart.first + chart.count; ++i) {
+			const uint32_t t = chartTris[i];
+			const Float3& a = positions[indices[t * 3U + 0U]];
+			normal = normal + cross(positions[indices[t * 3U + 1U]] - a, positions[indices[t * 3U + 2U]] - a);
+		}
+		normal = (length(normal) > 0.0f) ? normalize(normal) : seedNormal;
+		if (length(normal) == 0.0f) {
+			normal = { 0.0f, 0.0f, 1.0f };
+		}
+		const Float3 helper = (std::fabs(normal.x) < 0.9f) ? Float3{ 1.0f, 0.0f, 0.0f } : Float3{ 0.0f, 1.0f, 0.0f };
+		chart.tangent = normalize(cross(helper, normal));
+		chart.bitangent = cross(normal, chart.tangent);
+		chart.min = { FAR, FAR };
+		chart.max = { -FAR, -FAR };
+		for (uint32_t i = chart.first; i < chart.first + chart.count; ++i) {
+			for (size_t k = 0; k < 3U; ++k) {
+				const Float3& p = positions[indices[chartTris[i] * 3U + k]];
+				const float u = dot(p, chart.tangent);
+				const float v = dot(p, chart.bitangent);
+				chart.min = { std::min(chart.min.x, u), std::min(chart.min.y, v) };
+				chart.max = { std::max(chart.max.x, u), std::max(chart.max.y, v) };
+			}
+		}
+		charts.push_back(chart);
+	}
+
+	//------------------------------------------------------------
+	// Pack, tallest first, shrinking the density until it fits
+	//------------------------------------------------------------
+	std::vector<uint32_t> bySize(charts.size());
+	for (uint32_t c = 0; c < bySize.size(); ++c) {
+		bySize[c] = c;
+	}
+	std::stable_sort(bySize.begin(), bySize.end(), [&charts](uint32_t a, uint32_t b) {
+		return (charts[a].max.y - charts[a].min.y) > (charts[b].max.y - charts[b].min.y);
+	});
+
+	float scale = settings.texelsPerUnit;
+	bool packed = false;
+	for (uint32_t attempt = 0; attempt < 48U && !packed; ++attempt) {
+		packed = packCharts(charts, bySize, scale, size, settings.padding);
+		if (!packed) {
+			scale *= 0.9f;
+		}
+	}
+	if (!packed) {
+		return false;
+	}
+
+	//------------------------------------------------------------
+	// UVs and one sample per texel centre a triangle covers
+	//------------------------------------------------------------
+	mUvs.resize(triangles * 3U);
+	mCharts.assign(static_cast<size_t>(size) * size, -1);
+	const float invSize = 1.0f / static_cast<float>(size);
+	for (size_t c = 0; c < charts.size(); ++c) {
+		const Chart& chart = charts[c];
+		const float ox = static_cast<float>(chart.x + settings.padding) + 0.5f;
+		const float oy = static_cast<float>(chart.y + settings.padding) + 0.5f;
+		for (uint32_t i = chart.first; i < chart.first + chart.count; ++i) {
+			const uint32_t t = chartTris[i];
+			Float2 px[3];
+			Float3 p[3];
+			Float3 n[3];
+			for (size_t k = 0; k < 3U; ++k) {
+				const uint32_t index = indices[t * 3U + k];
+				p[k] = positions[index];
+				n[k] = input.normals ? input.normals[index] : mFaceNormals[t];
+				px[k] = { ox + (dot(p[k], chart.tangent) - chart.min.x) * scale, oy + (dot(p[k], chart.bitangent) - chart.min.y) * scale };
+				mUvs[t * 3U + k] = { px[k].x * invSize, px[k].y * invSize };
+			}
+
+			const float area = (px[1].x - px[0].x) * (px[2].y - px[0].y) - (px[2].x - px[0].x) * (px[1].y - px[0].y);
+			if (std::fabs(area) < 1.0e-8f) {
+				continue;
+			}
+			const float invArea = 1.0f / area;
+			const int x0 = std::max(0, static_cast<int>(std::floor(std::min({ px[0].x, px[1].x, px[2].x }))));
+			const int y0 = std::max(0, static_cast<int>(std::floor(std::min({ px[0].y, px[1].y, px[2].y }))));
+			const int x1 = std::min(static_cast<int>(size) - 1, static_cast<int>(std::ceil(std::max({ px[0].x, px[1].x, px[2].x }))));
+			const int y1 = std::min(static_cast<int>(size) - 1, static_cast<int>(std::ceil(std::max({ px[0].y, px[1].y, px[2].y }))));
+			for (int y = y0; y <= y1; ++y) {
+				for (int x = x0; x <= x1; ++x) {
+					const size_t pixel = static_cast<size_t>(y) * size + static_cast<size_t>(x);
+					if (mCharts[pixel] >= 0) {
+						continue;
+					}
+					const float cx = static_cast<float>(x) + 0.5f;
+					const float cy = static_cast<float>(y) + 0.5f;
+					const float w0 = ((px[1].x - cx) * (px[2].y - cy) - (px[2].x - cx) * (px[1].y - cy)) * invArea;
+					const float w1 = ((px[2].x - cx) * (px[0].y - cy) - (px[0].x - cx) * (px[2].y - cy)) * invArea;
+					const float w2 = 1.0f - w0 - w1;
+					if (w0 < -1.0e-4f || w1 < -1.0e-4f || w2 < -1.0e-4f) {
+						continue;
+					}
+					Texel texel;
+					texel.position = p[0] * w0 + p[1] * w1 + p[2] * w2;
+					texel.face = mFaceNormals[t];
+					texel.normal = normalize(n[0] * w0 + n[1] * w1 + n[2] * w2);
+					if (dot(texel.normal, texel.face) <= 0.0f) {
+						texel.normal = texel.face;
+					}
+					texel.pixel = static_cast<uint32_t>(pixel);
+					mTexels.push_back(texel);
+					mCharts[pixel] = static_cast<int32_t>(c);
+				}
+			}
+		}
+	}
+	mSums.assign(mTexels.size(), Float3{ 0.0f, 0.0f, 0.0f });
+
+	mStats.triangles = triangles;
+	mStats.charts = charts.size();
+	mStats.texels = mTexels.size();
+	mStats.texelsPerUnit = scale;
+	mStats.chartSeconds = secondsSince(start);
+	return true;
+}
+
+//----------------------------------------------------------------
+
+void LightmapBaker::bakePass() {
+	if (mTexels.empty()) {
+		return;
+	}
+	const auto start = Clock::now();
+	const LightmapBakeSettings& settings = mSettings;
+	const uint32_t spp = std::max(settings.samplesPerPass, 1U);
+	const uint32_t firstSample = mStats.passes * spp;
+	const size_t packets = (mTexels.size() + 3U) / 4U;
+	std::atomic<uint64_t> rays{ 0 };
+
+	JobSystem::instance().parallelFor(packets, 16U, [&](size_t begin, size_t end) {
+		uint64_t localRays = 0;
+
+		// Shadow rays from each live lane to every light, adds what they see
+		const auto gather = [&](const Float3 (&pos)[4], const Float3 (&nrm)[4], const Float3 (&face)[4],
+			const Float3 (&throughput)[4], uint32_t alive, Float3 (&sum)[4]) {
+			for (const LightmapLight& light : mLights) {
+				RayPacket packet = {};
+				float tMax[4] = { FAR, FAR, FAR, FAR };
+				Float3 contribution[4];
+				uint32_t lanes = 0;
+				for (uint32_t lane = 0; lane < 4U; ++lane) {
+					if (!(alive & (1U << lane))) {
+						continue;
+					}
+					const Float3 origin = pos[lane] + face[lane] * settings.rayBias;
+					Float3 toLight;
+					Float3 incoming;
+					if (light.type == LightmapLightType::Directional) {
+						toLight = normalize(-light.direction);
+						incoming = light.color;
+					} else {
+						const Float3 d = light.position - origin;
+						const float dist2 = dot(d, d);
+						if (dist2 <= 1.0e-8f || (light.range > 0.0f && dist2 > light.range * light.range)) {
+							continue;
+						}
+						toLight = d * (1.0f / std::sqrt(dist2));
+						incoming = light.color * (1.0f / std::max(dist2, 1.0e-4f));
+						tMax[lane] = std::sqrt(dist2) - settings.rayBias;
+					}
+					const float cosine = dot(nrm[lane], toLight);
+					if (cosine <= 0.0f || dot(face[lane], toLight) <= 0.0f) {
+						continue;
+					}
+					contribution[lane] = mul(throughput[lane], incoming * cosine);
+					packet.set(lane, origin, toLight);
+					lanes |= 1U << lane;
+				}
+				if (lanes == 0) {
+					continue;
+				}
+				localRays += popcount4(lanes);
+				const uint32_t lit = lanes & ~mBvh.occluded4(packet, tMax, lanes);
+				for (uint32_t lane = 0; lane < 4U; ++lane) {
+					if (lit & (1U << lane)) {
+						sum[lane] = sum[lane] + contribution[lane];
+					}
+				}
+			}
+		};
+
+		for (size_t p = begin; p < end; ++p) {
+			const size_t first = p * 4U;
+			const uint32_t count = static_cast<uint32_t>(std::min<size_t>(4U, mTexels.size() - first));
+			const uint32_t all = (1U << count) - 1U;
+			Float3 sum[4] = {};
+
+			for (uint32_t s = 0; s < spp; ++s) {
+				Float3 pos[4], nrm[4], face[4], throughput[4];
+				Rng rng[4];
+				for (uint32_t lane = 0; lane < count; ++lane) {
+					const Texel& texel = mTexels[first + lane];
+					pos[lane] = texel.position;
+					nrm[lane] = texel.normal;
+					face[lane] = texel.face;
+					throughput[lane] = { 1.0f, 1.0f, 1.0f };
+					rng[lane].state = mix(settings.seed ^ mix(static_cast<uint32_t>(first + lane) * 0x9E3779B9U + firstSample + s)) | 1U;
+				}
+
+				uint32_t alive = all;
+				for (uint32_t bounce = 0;; ++bounce) {
+					gather(pos, nrm, face, throughput, alive, sum);
+					if (bounce == settings.bounces || alive == 0) {
+						break;
+					}
+
+					RayPacket packet = {};
+					const float tMax[4] = { FAR, FAR, FAR, FAR };
+					Float3 dirs[4];
+					for (uint32_t lane = 0; lane < count; ++lane) {
+						if (alive & (1U << lane)) {
+							dirs[lane] = cosineSample(face[lane], rng[lane]);
+							packet.set(lane, pos[lane] + face[lane] * settings.rayBias, dirs[lane]);
+						}
+					}
+					BvhHit hits[4];
+					localRays += popcount4(alive);
+					const uint32_t hit = mBvh.intersect4(packet, tMax, hits, alive);
+
+					for (uint32_t lane = 0; lane < count; ++lane) {
+						const uint32_t bit = 1U << lane;
+						if (!(alive & bit)) {
+							continue;
+						}
+						if (!(hit & bit)) {
+							sum[lane] = sum[lane] + mul(throughput[lane], settings.sky);
+							alive &= ~bit;
+							continue;
+						}
+						// Double sided, so face the surface back along the ray
+						const uint32_t t = hits[lane].triangle;
+						Float3 n = mFaceNormals[t];
+						if (dot(n, dirs[lane]) > 0.0f) {
+							n = -n;
+						}
+						pos[lane] = pos[lane] + face[lane] * settings.rayBias + dirs[lane] * hits[lane].t;
+						nrm[lane] = n;
+						face[lane] = n;
+						sum[lane] = sum[lane] + mul(throughput[lane], mEmission[t]);
+						throughput[lane] = mul(throughput[lane], mAlbedo[t]);
+						if (throughput[lane].x + throughput[lane].y + throughput[lane].z <= 0.0f) {
+							alive &= ~bit;
+						}
+					}
+				}
+			}
+
+			// Packets own disjoint texels, no synchronization needed
+			for (uint32_t lane = 0; lane < count; ++lane) {
+				mSums[first + lane] = mSums[first + lane] + sum[lane];
+			}
+		}
+		rays.fetch_add(localRays, std::memory_order_relaxed);
+	});
+
+	++mStats.passes;
+	mStats.rays += rays.load(std::memory_order_relaxed);
+	mStats.traceSeconds += secondsSince(start);
+	mStats.raysPerSecond = (mStats.traceSeconds > 0.0) ? static_cast<double>(mStats.rays) / mStats.traceSeconds : 0.0;
+}
+
+//----------------------------------------------------------------
+
+Float3 LightmapBaker::mean(size_t texel) const noexcept {
+	const uint32_t samples = mStats.passes * std::max(mSettings.samplesPerPass, 1U);
+	return samples ? mSums[texel] * (1.0f / static_cast<float>(samples)) : Float3{ 0.0f, 0.0f, 0.0f };
+}
+
+uint32_t LightmapBaker::encode(const Float3& light) const noexcept {
+	const float scale = 255.0f / std::max(mSettings.overbright, 1.0e-6f);
+	const auto channel = [scale](float v) {
+		return static_cast<uint32_t>(std::clamp(v * scale, 0.0f, 255.0f) + 0.5f);
+	};
+	return 0xFF000000U | (channel(light.x) << 16) | (channel(light.y) << 8) | channel(light.z);
+}
+
+void LightmapBaker::preview(std::vector<uint32_t>& argb) const {
+	argb.assign(mCharts.size(), 0xFF000000U);
+	for (size_t i = 0; i < mTexels.size(); ++i) {
+		argb[mTexels[i].pixel] = encode(mean(i));
+	}
+}
+
+bool LightmapBaker::resolve(LightmapBakeResult& out, TextureCookStats* cookStats) const {
+	if (mTexels.empty()) {
+		return false;
+	}
+	const uint32_t size = mSettings.size;
+	const size_t pixels = mCharts.size();
+	std::vector<Float3> image(pixels, Float3{ 0.0f, 0.0f, 0.0f });
+	std::vector<Float3> normals(pixels, Float3{ 0.0f, 0.0f, 0.0f });
+	std::vector<uint8_t> covered(pixels, 0);
+	for (size_t i = 0; i < mTexels.size(); ++i) {
+		image[mTexels[i].pixel] = mean(i);
+		normals[mTexels[i].pixel] = mTexels[i].normal;
+		covered[mTexels[i].pixel] = 1;
+	}
+
+	//------------------------------------------------------------
+	// Denoise: bilateral on light and normal, never across charts
+	//------------------------------------------------------------
+	if (mSettings.denoise) {
+		std::vector<Float3> filtered(image);
+		JobSystem::instance().parallelFor(size, 8U, [&](size_t begin, size_t end) {
+			const int r = static_cast<int>(FILTER_RADIUS);
+			for (size_t y = begin; y < end; ++y) {
+				for (size_t x = 0; x < size; ++x) {
+					const size_t pixel = y * size + x;
+					if (!covered[pixel]) {
+						continue;
+					}
+					const int32_t chart = mCharts[pixel];
+					const float lum = luminance(image[pixel]);
+					// Relative range, noise is proportional to brightness but shadow edges are not
+					const float sigma = lum * 0.5f + 0.02f;
+					const float invRange = 1.0f / (2.0f * sigma * sigma);
+					Float3 sum = { 0.0f, 0.0f, 0.0f };
+					float weights = 0.0f;
+					for (int dy = -r; dy <= r; ++dy) {
+						const int sy = static_cast<int>(y) + dy;
+						if (sy < 0 || sy >= static_cast<int>(size)) {
+							continue;
+						}
+						for (int dx = -r; dx <= r; ++dx) {
+							const int sx = static_cast<int>(x) + dx;
+							if (sx < 0 || sx >= static_cast<int>(size)) {
+								continue;
+							}
+							const size_t q = static_cast<size_t>(sy) * size + static_cast<size_t>(sx);
+							if (!covered[q] || mCharts[q] != chart) {
+								continue;
+							}
+							const float diff = luminance(image[q]) - lum;
+							const float facing = std::max(dot(normals[q], normals[pixel]), 0.0f);
+							const float facing4 = (facing * facing) * (facing * facing);
+							const float w = std::exp(-static_cast<float>(dx * dx + dy * dy) * 0.25f - diff * diff * invRange) * facing4;
+							sum = sum + image[q] * w;
+							weights += w;
+						}
+					}
+					filtered[pixel] = (weights > 0.0f) ? sum * (1.0f / weights) : image[pixel];
+				}
+			}
+		});
+		image.swap(filtered);
+	}
+
+	//------------------------------------------------------------
+	// Dilate into the gutters, one ring at a time
+	//------------------------------------------------------------
+	for (uint32_t ring = 0; ring < mSettings.dilate; ++ring) {
+		std::vector<uint8_t> next(covered);
+		for (size_t y = 0; y < size; ++y) {
+			for (size_t x = 0; x < size; ++x) {
+				const size_t pixel = y * size + x;
+				if (covered[pixel]) {
+					continue;
+				}
+				Float3 sum = { 0.0f, 0.0f, 0.0f };
+				uint32_t count = 0;
+				for (int dy = -1; dy <= 1; ++dy) {
+					for (int dx = -1; dx <= 1; ++dx) {
+						const int sx = static_cast<int>(x) + dx;
+						const int sy = static_cast<int>(y) + dy;
+						if (sx < 0 || sy < 0 || sx >= static_cast<int>(size) || sy >= static_cast<int>(size)) {
+							continue;
+						}
+						const size_t q = static_cast<size_t>(sy) * size + static_cast<size_t>(sx);
+						if (covered[q]) {
+							sum = sum + image[q];
+							++count;
+						}
+					}
+				}
+				if (count) {
+					image[pixel] = sum * (1.0f / static_cast<float>(count));
+					next[pixel] = 1;
+				}
+			}
+		}
+		covered.swap(next);
+	}
+
+	//------------------------------------------------------------
+	// Encode and cook
+	//------------------------------------------------------------
+	std::vector<uint32_t> argb(pixels);
+	for (size_t i = 0; i < pixels; ++i) {
+		argb[i] = encode(image[i]);
+	}
+	if (!TextureCooker().cook(argb.data(), size, size, mSettings.cook, out.texture, cookStats)) {
+		return false;
+	}
+	out.uvs = mUvs;
+	out.intensityScale = mSettings.overbright;
+	return true;
+}
+
+bool LightmapBaker::bake(const LightmapBakeInput& input, const LightmapBakeSettings& settings, uint32_t passes, LightmapBakeResult& out) {
+	if (!begin(input, settings)) {
+		return false;
+	}
+	for (uint32_t pass = 0; pass < passes; ++pass) {
+		bakePass();
+	}
+	return resolve(out);
+}
@@ -0,0 +1,445 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Editor/LodBuilder.hh>
+
+#include <Engine/scene/Mesh.hh>
+
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+// Position (3) + normal (3) + uv (2)
+constexpr size_t QDIM	= 8U;
+constexpr size_t QTRI	= (QDIM * (QDIM + 1U)) / 2U;
+
+struct Quadric {
+	double		a[QTRI];	// Symmetric QDIM x QDIM matrix, upper triangle
+	double		b[QDIM];
+	double		c;
+	double		w;			// Accumulated area, to turn cost into a distance
+};
+
+using QVec = double[QDIM];
+
+constexpr size_t triIndex(size_t i, size_t j) noexcept {
+	// Row-major upper triangle offset of (i, j), i <= j
+	return i * QDIM - (i * (i - 1U)) / 2U + (j - i);
+}
+
+inline double qdot(const QVec& a, const QVec& b) noexcept {
+	double r = 0.0;
+	for (size_t i = 0; i < QDIM; ++i) {
+		r += a[i] * b[i];
+	}
+	return r;
+}
+
+inline void quadricAdd(Quadric& dst, const Quadric& src) noexcept {
+	for (size_t i = 0; i < QTRI; ++i) {
+		dst.a[i] += src.a[i];
+	}
+	for (size_t i = 0; i < QDIM; ++i) {
+		dst.b[i] += src.b[i];
+	}
+	dst.c += src.c;
+	dst.w += src.w;
+}
+
+// v^T A v + 2 b.v + c
+inline double quadricEval(const Quadric& q, const QVec& v) noexcept {
+	double r = q.c;
+	for (size_t i = 0; i < QDIM; ++i) {
+		double row = q.a[triIndex(i, i)] * v[i];
+		for (size_t j = i + 1U; j < QDIM; ++j) {
+			row += 2.0 * q.a[triIndex(i, j)] * v[j];
+		}
+		r += v[i] * row + 2.0 * q.b[i] * v[i];
+	}
+	return r;
+}
+
+//
+// Generalized triangle quadric (Garland-Heckbert '98): squared distance
+// to the plane spanned by the triangle in QDIM-space,
+//   A = I - e1 e1^T - e2 e2^T, b = (p.e1) e1 + (p.e2) e2 - p, c = p.p - (p.e1)^2 - (p.e2)^2
+//
+bool quadricFromTriangle(Quadric& q, const QVec& p0, const QVec& p1, const QVec& p2, double weight) noexcept {
+	QVec e1, e2;
+	for (size_t i = 0; i < QDIM; ++i) {
+		e1[i] = p1[i] - p0[i];
+		e2[i] = p2[i] - p0[i];
+	}
+	const double l1 = std::sqrt(qdot(e1, e1));
+	if (l1 <= 1.0e-12) {
+		return false;
+	}
+	for (size_t i = 0; i < QDIM; ++i) {
+		e1[i] /= l1;
+	}
+	const double d12 = qdot(e1, e2);
+	for (size_t i = 0; i < QDIM; ++i) {
+		e2[i] -= d12 * e1[i];
+	}
+	const double l2 = std::sqrt(qdot(e2, e2));
+	if (l2 <= 1.0e-12) {
+		return false;
+	}
+	for (size_t i = 0; i < QDIM; ++i) {
+		e2[i] /= l2;
+	}
+
+	const double pe1 = qdot(p0, e1);
+	const double pe2 = qdot(p0, e2);
+	for (size_t i = 0; i < QDIM; ++i) {
+		for (size_t j = i; j < QDIM; ++j) {
+			const double ident = (i == j) ? 1.0 : 0.0;
+			q.a[triIndex(i, j)] = weight * (ident - e1[i] * e1[j] - e2[i] * e2[j]);
+		}
+		q.b[i] = weight * (pe1 * e1[i] + pe2 * e2[i] - p0[i]);
+	}
+	q.c = weight * (qdot(p0, p0) - pe1 * pe1 - pe2 * pe2);
+	q.w = weight;
+	return true;
+}
+
+// Position-only plane quadric, embedded in the top-left 3x3 block
+void quadricFromPlane(Quadric& q, const Float3& n, float d, double weight) noexcept {
+	std::memset(&q, 0, sizeof(q));
+	const double nn[3] = { n.x, n.y, n.z };
+	for (size_t i = 0; i < 3U; ++i) {
+		for (size_t j = i; j < 3U; ++j) {
+			q.a[triIndex(i, j)] = weight * nn[i] * nn[j];
+		}
+		q.b[i] = weight * d * nn[i];
+	}
+	q.c = weight * static_cast<double>(d) * d;
+}
+
+//----------------------------------------------------------------
+
+struct Collapse {
+	double		cost;
+	uint32_t	from;		// Vertex removed
+	uint32_t	to;			// Vertex kept
+	uint32_t	verFrom;	// Vertex versions when queued, stale entries are skipped
+	uint32_t	verTo;
+
+	inline bool operator<(const Collapse& rhs) const noexcept { return cost > rhs.cost; }
+};
+
+inline Float3 triNormal(const Float3& a, const Float3& b, const Float3& c) noexcept {
+	return cross(b - a, c - a);
+}
+
+} // namespace
+
+//================================================================
+
+size_t LodBuilder::build(const LodSourceMesh& src, const LodBuildSettings& settings, MeshLodChain& out) const {
+	out.clear();
+	if (!src.positions || !src.indices || src.indexCount < 3U || settings.levels == 0) {
+		return 0;
+	}
+
+	// Malformed input would index the attribute and quadric arrays out of bounds
+	for (size_t i = 0; i < src.indexCount; ++i) {
+		if (src.indices[i] >= src.vertexCount) {
+			return 0;
+		}
+	}
+
+	const size_t vcount = src.vertexCount;
+	const size_t tcount = src.indexCount / 3U;
+	const Float3* pos = src.positions;
+
+	// Level 0 is the source itself
+	out.addLevel(src.indices, static_cast<uint32_t>(tcount * 3U), 0.0f);
+
+	//------------------------------------------------------------
+	// Attribute vectors
+	//------------------------------------------------------------
+	std::vector<double> attr(vcount * QDIM, 0.0);
+	for (size_t v = 0; v < vcount; ++v) {
+		double* a = &attr[v * QDIM];
+		a[0] = pos[v].x;
+		a[1] = pos[v].y;
+		a[2] = pos[v].z;
+		if (src.normals) {
+			a[3] = src.normals[v].x * settings.normalWeight;
+			a[4] = src.normals[v].y * settings.normalWeight;
+			a[5] = src.normals[v].z * settings.normalWeight;
+		}
+		if (src.uvs) {
+			a[6] = src.uvs[v].x * settings.uvWeight;
+			a[7] = src.uvs[v].y * settings.uvWeight;
+		}
+	}
+	auto attrOf = [&attr](uint32_t v) -> const QVec& {
+		return *reinterpret_cast<const QVec*>(&attr[v * QDIM]);
+	};
+
+	//------------------------------------------------------------
+	// Lock seam vertices (same position, split attributes)
+	//------------------------------------------------------------
+	std::vector<uint8_t> locked(vcount, 0);
+	{
+		struct PosHash {
+			size_t operator()(const Float3& p) const noexcept {
+				uint32_t h[3];
+				std::memcpy(h, &p, sizeof(h));
+				return (h[0] * 73856093U) ^ (h[1] * 19349663U) ^ (h[2] * 83492791U);
+			}
+		};
+		struct PosEq {
+			bool operator()(const Float3& a, const Float3& b) const noexcept {
+				return a.x == b.x && a.y == b.y && a.z == b.z;
+			}
+		};
+		std::unordered_map<Float3, uint32_t, PosHash, PosEq> first;
+		first.reserve(vcount);
+		for (uint32_t v = 0; v < vcount; ++v) {
+			auto it = first.emplace(pos[v], v);
+			if (!it.second) {
+				locked[v] = 1;
+				locked[it.first->second] = 1;
+			}
+		}
+	}
+
+	//------------------------------------------------------------
+	// Triangles, adjacency and vertex quadrics
+	//------------------------------------------------------------
+	std::vector<uint32_t> tris(tcount * 3U);
+	std::vector<uint8_t> triAlive(tcount, 1);
+	std::vector<std::vector<uint32_t>> adj(vcount);
+	std::vector<Quadric> quadrics(vcount);
+	std::memset(quadrics.data(), 0, quadrics.size() * sizeof(Quadric));
+
+	size_t liveTris = 0;
+	std::unordered_map<uint64_t, uint32_t> edgeUse;
+	edgeUse.reserve(tcount * 3U);
+	for (size_t t = 0; t < tcount; ++t) {
+		const uint32_t i0 = src.indices[t * 3U + 0U];
+		const uint32_t i1 = src.indices[t * 3U + 1U];
+		const uint32_t i2 = src.indices[t * 3U + 2U];
+		tris[t * 3U + 0U] = i0;
+		tris[t * 3U + 1U] = i1;
+		tris[t * 3U + 2U] = i2;
+		if (i0 == i1 || i1 == i2 || i0 == i2) {
+			triAlive[t] = 0;
+			continue;
+		}
+		++liveTris;
+		adj[i0].push_back(static_cast<uint32_t>(t));
+		adj[i1].push_back(static_cast<uint32_t>(t));
+		adj[i2].push_back(static_cast<uint32_t>(t));
+
+		const double area = 0.5 * length(triNormal(pos[i0], pos[i1], pos[i2]));
+		Quadric q;
+		if (quadricFromTriangle(q, attrOf(i0), attrOf(i1), attrOf(i2), area)) {
+			quadricAdd(quadrics[i0], q);
+			quadricAdd(quadrics[i1], q);
+			quadricAdd(quadrics[i2], q);
+		}
+
+		const uint32_t e[3][2] = { { i0, i1 }, { i1, i2 }, { i2, i0 } };
+		for (const auto& ed : e) {
+			const uint32_t lo = ed[0] < ed[1] ? ed[0] : ed[1];
+			const uint32_t hi = ed[0] < ed[1] ? ed[1] : ed[0];
+			++edgeUse[(static_cast<uint64_t>(lo) << 32) | hi];
+		}
+	}
+
+	// Open borders: plane through the edge, perpendicular to the face
+	for (size_t t = 0; t < tcount; ++t) {
+		if (!triAlive[t]) {
+			continue;
+		}
+		const uint32_t* tri = &tris[t * 3U];
+		const Float3 fn = normalize(triNormal(pos[tri[0]], pos[tri[1]], pos[tri[2]]));
+		for (size_t k = 0; k < 3U; ++k) {
+			const uint32_t a = tri[k];
+			const uint32_t b = tri[(k + 1U) % 3U];
+			const uint32_t lo = a < b ? a : b;
+			const uint32_t hi = a < b ? b : a;
+			if (edgeUse[(static_cast<uint64_t>(lo) << 32) | hi] != 1U) {
+				continue;
+			}
+			const Float3 dir = pos[b] - pos[a];
+			const Float3 n = normalize(cross(dir, fn));
+			Quadric q;
+			quadricFromPlane(q, n, -dot(n, pos[a]), settings.borderWeight * dot(dir, dir));
+			quadricAdd(quadrics[a], q);
+			quadricAdd(quadrics[b], q);
+		}
+	}
+
+	//------------------------------------------------------------
+	// Collapse queue
+	//------------------------------------------------------------
+	std::vector<uint32_t> version(vcount, 0);
+	std::vector<uint8_t> alive(vcount, 1);
+	std::priority_queue<Collapse> heap;
+
+	auto push = [&](uint32_t from, uint32_t to) {
+		if (locked[from] || from == to) {
+			return;
+		}
+		const QVec& target = attrOf(to);
+		const double cost = quadricEval(quadrics[from], target) + quadricEval(quadrics[to], target);
+		heap.push({ cost < 0.0 ? 0.0 : cost, from, to, version[from], version[to] });
+	};
+
+	for (size_t t = 0; t < tcount; ++t) {
+		if (!triAlive[t]) {
+			continue;
+		}
+		const uint32_t* tri = &tris[t * 3U];
+		for (size_t k = 0; k < 3U; ++k) {
+			push(tri[k], tri[(k + 1U) % 3U]);
+			push(tri[(k + 1U) % 3U], tri[k]);
+		}
+	}
+
+	// Reject collapses that flip or degenerate a surviving triangle
+	auto collapseValid = [&](uint32_t from, uint32_t to) -> bool {
+		for (uint32_t t : adj[from]) {
+			if (!triAlive[t]) {
+				continue;
+			}
+			const uint32_t* tri = &tris[t * 3U];
+			if (tri[0] == to || tri[1] == to || tri[2] == to) {
+				continue;	// This one disappears
+			}
+			Float3 p[3] = { pos[tri[0]], pos[tri[1]], pos[tri[2]] };
+			const Float3 before = triNormal(p[0], p[1], p[2]);
+			for (size_t k = 0; k < 3U; ++k) {
+				if (tri[k] == from) {
+					p[k] = pos[to];
+				}
+			}
+			const Float3 after = triNormal(p[0], p[1], p[2]);
+			const float lb = length(before);
+			const float la = length(after);
+			if (la <= 1.0e-12f || dot(before, after) < 0.25f * lb * la) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	//------------------------------------------------------------
+	// Simplify level by level, continuing from the previous level
+	//------------------------------------------------------------
+	std::vector<uint16_t> levelIndices;
+	levelIndices.reserve(tcount * 3U);
+	double maxCostDist = 0.0;
+	size_t prevTris = liveTris;
+
+	for (size_t lvl = 1; lvl < settings.levels; ++lvl) {
+		const size_t target = static_cast<size_t>(static_cast<float>(prevTris) * settings.reduction);
+		bool capped = false;
+
+		while (liveTris > target && !heap.empty()) {
+			const Collapse c = heap.top();
+			if (!alive[c.from] || !alive[c.to] || version[c.from] != c.verFrom || version[c.to] != c.verTo) {
+				heap.pop();
+				continue;
+			}
+			const double weight = quadrics[c.from].w + quadrics[c.to].w;
+			const double dist = std::sqrt(c.cost / (weight > 0.0 ? weight : 1.0));
+			if (dist > settings.maxError) {
+				capped = true;
+				break;
+			}
+			heap.pop();
+			if (!collapseValid(c.from, c.to)) {
+				continue;
+			}
+
+			// Merge `from` into `to`
+			for (uint32_t t : adj[c.from]) {
+				if (!triAlive[t]) {
+					continue;
+				}
+				uint32_t* tri = &tris[t * 3U];
+				if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+					triAlive[t] = 0;
+					--liveTris;
+					continue;
+				}
+				for (size_t k = 0; k < 3U; ++k) {
+					if (tri[k] == c.from) {
+						tri[k] = c.to;
+					}
+				}
+				adj[c.to].push_back(t);
+			}
+			adj[c.from].clear();
+			alive[c.from] = 0;
+			quadricAdd(quadrics[c.to], quadrics[c.from]);
+			++version[c.to];
+			if (dist > maxCostDist) {
+				maxCostDist = dist;
+			}
+
+			// Re-queue edges around the kept vertex
+			for (uint32_t t : adj[c.to]) {
+				if (!triAlive[t]) {
+					continue;
+				}
+				const uint32_t* tri = &tris[t * 3U];
+				for (size_t k = 0; k < 3U; ++k) {
+					if (tri[k] != c.to) {
+						push(c.to, tri[k]);
+						push(tri[k], c.to);
+					}
+				}
+			}
+		}
+
+		if (liveTris >= prevTris) {
+			break;	// No progress, the mesh can't be reduced further
+		}
+
+		levelIndices.clear();
+		for (size_t t = 0; t < tcount; ++t) {
+			if (!triAlive[t]) {
+				continue;
+			}
+			levelIndices.push_back(static_cast<uint16_t>(tris[t * 3U + 0U]));
+			levelIndices.push_back(static_cast<uint16_t>(tris[t * 3U + 1U]));
+			levelIndices.push_back(static_cast<uint16_t>(tris[t * 3U + 2U]));
+		}
+		if (!out.addLevel(levelIndices.data(), static_cast<uint32_t>(levelIndices.size()), static_cast<float>(maxCostDist))) {
+			break;
+		}
+		prevTris = liveTris;
+
+		if (capped) {
+			break;
+		}
+	}
+
+	// Switch distances from the bounds of the source
+	Aabb box = { pos[0], pos[0] };
+	for (size_t v = 1; v < vcount; ++v) {
+		box.min = min(box.min, pos[v]);
+		box.max = max(box.max, pos[v]);
+	}
+	out.computeScreenSizes(length(box.extents()), settings.pixelError);
+
+	return out.levelCount();
+}
+
+size_t LodBuilder::build(Mesh& mesh, const LodBuildSettings& settings) const {
+	const LodSourceMesh src = { mesh.positions(), mesh.normals(), mesh.uvs(), mesh.vertexCount(), mesh.indices(), mesh.indexCount() };
+	return build(src, settings, mesh.lods());
+}
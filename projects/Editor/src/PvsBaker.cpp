@@ -0,0 +1,229 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Editor/PvsBaker.hh>
+#include <Editor/TriangleBvh.hh>
+
+#include <Engine/core/Jobs.hh>
+#include <Engine/physics/Ray.hh>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+//================================================================
+
+namespace {
+
+inline float axisOf(const Float3& v, int axis) noexcept {
+	return (axis == 0) ? v.x : ((axis == 1) ? v.y : v.z);
+}
+
+inline void setAxis(Float3& v, int axis, float value) noexcept {
+	(axis == 0 ? v.x : (axis == 1 ? v.y : v.z)) = value;
+}
+
+// xorshift32, per cell pair so results don't depend on thread scheduling
+struct Rng {
+	uint32_t	state;
+
+	inline float next() noexcept {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+	}
+};
+
+inline Float3 samplePoint(const Aabb& box, Rng& rng) noexcept {
+	// Stay off the faces, they are usually coplanar with walls
+	const Float3 inset = box.extents() * 0.02f;
+	const Float3 lo = box.min + inset;
+	const Float3 hi = box.max - inset;
+	return { lo.x + (hi.x - lo.x) * rng.next(), lo.y + (hi.y - lo.y) * rng.next(), lo.z + (hi.z - lo.z) * rng.next() };
+}
+
+// Shared face of two touching boxes as a quad, if any
+bool findPortal(const Aabb& a, const Aabb& b, float eps, Float3 (&quad)[4]) noexcept {
+	for (int axis = 0; axis < 3; ++axis) {
+		float plane;
+		if (std::fabs(axisOf(a.max, axis) - axisOf(b.min, axis)) <= eps) {
+			plane = axisOf(a.max, axis);
+		} else if (std::fabs(axisOf(a.min, axis) - axisOf(b.max, axis)) <= eps) {
+			plane = axisOf(a.min, axis);
+		} else {
+			continue;
+		}
+		const int u = (axis + 1) % 3;
+		const int v = (axis + 2) % 3;
+		const float u0 = std::fmax(axisOf(a.min, u), axisOf(b.min, u));
+		const float u1 = std::fmin(axisOf(a.max, u), axisOf(b.max, u));
+		const float v0 = std::fmax(axisOf(a.min, v), axisOf(b.min, v));
+		const float v1 = std::fmin(axisOf(a.max, v), axisOf(b.max, v));
+		if ((u1 - u0) <= eps || (v1 - v0) <= eps) {
+			return false;	// Touching along an edge or a corner only
+		}
+		const float corners[4][2] = { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+		for (size_t i = 0; i < 4U; ++i) {
+			setAxis(quad[i], axis, plane);
+			setAxis(quad[i], u, corners[i][0]);
+			setAxis(quad[i], v, corners[i][1]);
+		}
+		return true;
+	}
+	return false;
+}
+
+} // namespace
+
+//================================================================
+
+std::vector<Aabb> PvsBaker::partitionGrid(const Aabb& level, const Float3& cellSize) {
+	std::vector<Aabb> cells;
+	const Float3 size = level.max - level.min;
+	const int nx = static_cast<int>(std::ceil(size.x / cellSize.x));
+	const int ny = static_cast<int>(std::ceil(size.y / cellSize.y));
+	const int nz = static_cast<int>(std::ceil(size.z / cellSize.z));
+	cells.reserve(static_cast<size_t>(nx > 0 ? nx : 0) * (ny > 0 ? ny : 0) * (nz > 0 ? nz : 0));
+	for (int z = 0; z < nz; ++z) {
+		for (int y = 0; y < ny; ++y) {
+			for (int x = 0; x < nx; ++x) {
+				const Float3 lo = level.min + Float3{ x * cellSize.x, y * cellSize.y, z * cellSize.z };
+				cells.push_back({ lo, min(lo + cellSize, level.max) });
+			}
+		}
+	}
+	return cells;
+}
+
+//----------------------------------------------------------------
+
+bool PvsBaker::bake(const PvsBakeInput& input, const PvsBakeSettings& settings, CellVisibility& out, PvsBakeStats* stats) const {
+	const auto start = std::chrono::steady_clock::now();
+	out.clear();
+	const size_t n = input.cellCount;
+	if (n == 0 || !input.cells) {
+		return false;
+	}
+
+	//------------------------------------------------------------
+	// Portals (grouped by owning cell)
+	//------------------------------------------------------------
+	std::vector<std::vector<VisPortal>> owned(n);
+	for (size_t a = 0; a < n; ++a) {
+		for (size_t b = a + 1U; b < n; ++b) {
+			VisPortal p;
+			if (!findPortal(input.cells[a], input.cells[b], settings.touchEpsilon, p.verts)) {
+				continue;
+			}
+			p.target = static_cast<uint32_t>(b);
+			owned[a].push_back(p);
+			p.target = static_cast<uint32_t>(a);
+			owned[b].push_back(p);
+		}
+	}
+
+	std::vector<VisCell> cells(n);
+	std::vector<VisPortal> portals;
+	for (size_t c = 0; c < n; ++c) {
+		cells[c].bounds = input.cells[c];
+		cells[c].firstPortal = static_cast<uint32_t>(portals.size());
+		cells[c].portalCount = static_cast<uint32_t>(owned[c].size());
+		portals.insert(portals.end(), owned[c].begin(), owned[c].end());
+	}
+
+	//------------------------------------------------------------
+	// Visibility between cell pairs
+	//------------------------------------------------------------
+	TriangleBvh bvh;
+	if (input.positions && input.indices) {
+		bvh.build(input.positions, input.indices, input.indexCount / 3U);
+	}
+
+	// Row a holds the answers for b > a, mirrored afterwards
+	std::vector<uint8_t> vis(n * n, 0);
+	std::atomic<size_t> rays{ 0 };
+
+	JobSystem::instance().parallelFor(n, 1, [&](size_t begin, size_t end) {
+		std::vector<uint8_t> reached(n);
+		std::vector<uint32_t> queue;
+		size_t localRays = 0;
+		for (size_t a = begin; a < end; ++a) {
+			// Portal graph reachability, unreachable cells can never be seen
+			std::fill(reached.begin(), reached.end(), 0);
+			queue.clear();
+			queue.push_back(static_cast<uint32_t>(a));
+			reached[a] = 1;
+			for (size_t qi = 0; qi < queue.size(); ++qi) {
+				const VisCell& c = cells[queue[qi]];
+				for (uint32_t p = 0; p < c.portalCount; ++p) {
+					const uint32_t t = portals[c.firstPortal + p].target;
+					if (!reached[t]) {
+						reached[t] = 1;
+						queue.push_back(t);
+					}
+				}
+			}
+
+			uint8_t* row = &vis[a * n];
+			row[a] = 1;
+			const VisCell& ca = cells[a];
+			for (uint32_t p = 0; p < ca.portalCount; ++p) {
+				row[portals[ca.firstPortal + p].target] = 1;
+			}
+
+			for (size_t b = a + 1U; b < n; ++b) {
+				if (row[b] || !reached[b]) {
+					continue;
+				}
+				if (bvh.empty()) {
+					row[b] = 1;
+					continue;
+				}
+				Rng rng = { settings.seed ^ static_cast<uint32_t>(a * 73856093U) ^ static_cast<uint32_t>(b * 19349663U) };
+				if (rng.state == 0) {
+					rng.state = 1;
+				}
+				for (uint32_t s = 0; s < settings.samplesPerPair; ++s) {
+					const Float3 pa = samplePoint(input.cells[a], rng);
+					const Float3 pb = samplePoint(input.cells[b], rng);
+					++localRays;
+					if (!bvh.occluded(Ray(pa, pb - pa), 1.0f)) {
+						row[b] = 1;
+						break;
+					}
+				}
+			}
+		}
+		rays += localRays;
+	});
+
+	//------------------------------------------------------------
+	// Pack the symmetric result into bit rows
+	//------------------------------------------------------------
+	const uint32_t words = CellVisibility::rowWords(n);
+	std::vector<uint32_t> pvs(n * words, 0U);
+	size_t visiblePairs = 0;
+	for (size_t a = 0; a < n; ++a) {
+		for (size_t b = a; b < n; ++b) {
+			if (!vis[a * n + b]) {
+				continue;
+			}
+			pvs[a * words + (b >> 5)] |= 1U << (b & 31U);
+			pvs[b * words + (a >> 5)] |= 1U << (a & 31U);
+			visiblePairs += (a == b) ? 1U : 2U;
+		}
+	}
+
+	const size_t portalCount = portals.size();
+	out.assign(std::move(cells), std::move(portals), std::move(pvs));
+
+	if (stats) {
+		stats->cells = n;
+		stats->portals = portalCount;
+		stats->visiblePairs = visiblePairs;
+		stats->raysCast = rays.load();
+		stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+	return true;
+}
@@ -0,0 +1,110 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Editor/ReplayBenchmark.hh>
+
+#include <Engine/gfx/CommandQueue.hh>
+#include <Engine/gfx/backend/Software/GBESoftware.hh>
+#include <Engine/gfx/backend/Software/SoftwareFrameBuffer.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline float elapsedMs(Clock::time_point start) noexcept {
+	return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+float median(std::vector<float>& samples) {
+	if (samples.empty()) {
+		return 0.0f;
+	}
+	std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+	return samples[samples.size() / 2];
+}
+
+} // namespace
+
+//================================================================
+
+bool ReplayBenchmark::run(const CommandReplay& replay, const ReplaySettings& settings, ReplayResult& result) const {
+	result = {};
+	if (!replay.isOpen()) {
+		return false;
+	}
+
+	const CaptureFrameRecord& frame = replay.frame();
+	const uint32_t width = settings.width ? settings.width : frame.width;
+	const uint32_t height = settings.height ? settings.height : frame.height;
+	if (!width || !height) {
+		return false;
+	}
+
+	const uint32_t draws = static_cast<uint32_t>(replay.drawCount());
+	CommandQueue queue(std::max(draws, 1U), std::max<size_t>(size_t(draws) * sizeof(DrawCommand) * 2U, 1U << 16));
+	GBESoftware gbe;
+	SoftwareFrameBuffer target(width, height);
+
+	std::vector<float> frameMs;
+	std::vector<float> sortMs;
+	std::vector<float> executeMs;
+	std::vector<float> rasterMs;
+	frameMs.reserve(settings.iterations);
+	sortMs.reserve(settings.iterations);
+	executeMs.reserve(settings.iterations);
+	rasterMs.reserve(settings.iterations);
+
+	for (uint32_t i = 0; i < settings.warmup + settings.iterations; ++i) {
+		const Clock::time_point start = Clock::now();
+		queue.reset();
+		replay.submit(queue);
+		queue.sort();
+		gbe.beginFrame(target, frame.clearColor);
+		gbe.setViewProjection(frame.viewProjection);
+		queue.execute(gbe);
+		gbe.endFrame();
+		const float ms = elapsedMs(start);
+
+		if (i < settings.warmup) {
+			continue;
+		}
+		frameMs.push_back(ms);
+		sortMs.push_back(queue.stats().sortMs);
+		executeMs.push_back(queue.stats().executeMs);
+		rasterMs.push_back(gbe.stats().rasterMs);
+	}
+
+	result.draws = queue.stats().draws;
+	result.stateChanges = queue.stats().stateChanges;
+	result.iterations = settings.iterations;
+	if (!frameMs.empty()) {
+		result.minMs = *std::min_element(frameMs.begin(), frameMs.end());
+		result.maxMs = *std::max_element(frameMs.begin(), frameMs.end());
+		float sum = 0.0f;
+		for (const float ms : frameMs) {
+			sum += ms;
+		}
+		result.meanMs = sum / static_cast<float>(frameMs.size());
+	}
+	result.medianMs = median(frameMs);
+	result.sortMs = median(sortMs);
+	result.executeMs = median(executeMs);
+	result.rasterMs = median(rasterMs);
+	result.frameHash = target.hash();
+	return true;
+}
+
+bool ReplayBenchmark::run(const char* path, const ReplaySettings& settings, ReplayResult& result) const {
+	CommandReplay replay;
+	if (!replay.open(path)) {
+		result = {};
+		return false;
+	}
+	return run(replay, settings, result);
+}
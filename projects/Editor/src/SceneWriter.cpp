@@ -0,0 +1,182 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Editor/SceneWriter.hh>
+
+#include <cstdio>
+#include <cstring>
+
+//================================================================
+
+namespace {
+
+constexpr size_t alignUp(size_t v) noexcept {
+	return (v + SCENE_FILE_ALIGNMENT - 1U) & ~(SCENE_FILE_ALIGNMENT - 1U);
+}
+
+struct PendingSection {
+	SceneSection	type;
+	const void*		data;
+	size_t			size;
+	size_t			count;
+};
+
+} // namespace
+
+//================================================================
+
+void SceneWriter::clear() {
+	*this = SceneWriter();
+}
+
+StringId SceneWriter::intern(const char* name) {
+	const StringId id(name);
+	if (!name || id.empty()) {
+		return id;
+	}
+	for (const SceneStringRecord& rec : mStringTable) {
+		if (rec.id == id) {
+			return id;
+		}
+	}
+	mStringTable.push_back({ id, static_cast<uint32_t>(mStrings.size()) });
+	mStrings.append(name);
+	mStrings.push_back('\0');
+	return id;
+}
+
+//----------------------------------------------------------------
+
+uint32_t SceneWriter::addMesh(const char* name, const LodSourceMesh& mesh, const MeshLodChain* lods) {
+	SceneMeshRecord rec = {};
+	rec.name = intern(name);
+	rec.firstVertex = static_cast<uint32_t>(mPositions.size());
+	rec.vertexCount = static_cast<uint32_t>(mesh.vertexCount);
+	rec.firstLodIndex = static_cast<uint32_t>(mIndices.size());
+	rec.firstLod = static_cast<uint32_t>(mLodLevels.size());
+
+	// Vertex streams (a stream missing on any mesh is dropped from the file)
+	mPositions.insert(mPositions.end(), mesh.positions, mesh.positions + mesh.vertexCount);
+	mHasNormals &= (mesh.normals != nullptr);
+	mHasUvs &= (mesh.uvs != nullptr);
+	if (mesh.normals) {
+		mNormals.insert(mNormals.end(), mesh.normals, mesh.normals + mesh.vertexCount);
+	}
+	if (mesh.uvs) {
+		mUvs.insert(mUvs.end(), mesh.uvs, mesh.uvs + mesh.vertexCount);
+	}
+
+	// Index lists, LOD level 0 is the source
+	if (lods && lods->levelCount() > 0) {
+		uint32_t offset = 0;
+		for (size_t l = 0; l < lods->levelCount(); ++l) {
+			MeshLodLevel lvl = lods->level(l);
+			mIndices.insert(mIndices.end(), lods->indices(l), lods->indices(l) + lvl.indexCount);
+			lvl.firstIndex = offset;
+			offset += lvl.indexCount;
+			mLodLevels.push_back(lvl);
+		}
+		rec.lodCount = static_cast<uint32_t>(lods->levelCount());
+	} else {
+		mIndices.insert(mIndices.end(), mesh.indices, mesh.indices + mesh.indexCount);
+		mLodLevels.push_back({ 0U, static_cast<uint32_t>(mesh.indexCount), 0.0f, 1.0e30f });
+		rec.lodCount = 1;
+	}
+
+	// Object-space bounds (an empty mesh keeps a zero sphere)
+	if (mesh.vertexCount > 0) {
+		Aabb box = { mesh.positions[0], mesh.positions[0] };
+		for (size_t v = 1; v < mesh.vertexCount; ++v) {
+			box.min = min(box.min, mesh.positions[v]);
+			box.max = max(box.max, mesh.positions[v]);
+		}
+		rec.bounds = { box.center(), length(box.extents()) };
+	}
+
+	mMeshes.push_back(rec);
+	return static_cast<uint32_t>(mMeshes.size() - 1U);
+}
+
+void SceneWriter::addObject(const char* name, uint32_t mesh, const Sphere& worldBounds) {
+	mObjBounds.push_back(worldBounds);
+	mObjMeshes.push_back(mesh);
+	mObjNames.push_back(intern(name));
+}
+
+void SceneWriter::setVisibility(const CellVisibility& visibility) {
+	mCells.clear();
+	mPortals.clear();
+	for (size_t i = 0; i < visibility.cellCount(); ++i) {
+		mCells.push_back(visibility.cell(i));
+	}
+	for (size_t i = 0; i < visibility.portalCount(); ++i) {
+		mPortals.push_back(visibility.portal(i));
+	}
+	mPvs = visibility.pvsBits();
+}
+
+//----------------------------------------------------------------
+
+void SceneWriter::serialize(std::vector<uint8_t>& out) const {
+	std::vector<PendingSection> sections;
+	auto add = [&sections](SceneSection type, const auto& vec) {
+		using T = typename std::decay_t<decltype(vec)>::value_type;
+		if (!vec.empty()) {
+			sections.push_back({ type, vec.data(), vec.size() * sizeof(T), vec.size() });
+		}
+	};
+	if (mKeepStrings && !mStrings.empty()) {
+		sections.push_back({ SceneSection::Strings, mStrings.data(), mStrings.size(), mStrings.size() });
+		add(SceneSection::StringTable, mStringTable);
+	}
+	add(SceneSection::Meshes, mMeshes);
+	add(SceneSection::LodLevels, mLodLevels);
+	add(SceneSection::Positions, mPositions);
+	if (mHasNormals) {
+		add(SceneSection::Normals, mNormals);
+	}
+	if (mHasUvs) {
+		add(SceneSection::Uvs, mUvs);
+	}
+	add(SceneSection::Indices, mIndices);
+	add(SceneSection::ObjectBounds, mObjBounds);
+	add(SceneSection::ObjectMeshes, mObjMeshes);
+	add(SceneSection::ObjectNames, mObjNames);
+	add(SceneSection::Cells, mCells);
+	add(SceneSection::Portals, mPortals);
+	add(SceneSection::Pvs, mPvs);
+
+	// Header, section table, then each section on an aligned offset
+	size_t offset = alignUp(sizeof(SceneFileHeader) + sections.size() * sizeof(SceneSectionEntry));
+	std::vector<SceneSectionEntry> table;
+	for (const PendingSection& s : sections) {
+		table.push_back({ static_cast<uint32_t>(s.type), static_cast<uint32_t>(offset),
+			static_cast<uint32_t>(s.size), static_cast<uint32_t>(s.count) });
+		offset = alignUp(offset + s.size);
+	}
+
+	out.assign(offset, 0);
+	SceneFileHeader hdr = {};
+	hdr.magic = SCENE_FILE_MAGIC;
+	hdr.version = SCENE_FILE_VERSION;
+	hdr.sectionCount = static_cast<uint16_t>(sections.size());
+	hdr.fileSize = static_cast<uint32_t>(offset);
+	std::memcpy(out.data(), &hdr, sizeof(hdr));
+	if (!table.empty()) {
+		std::memcpy(out.data() + sizeof(hdr), table.data(), table.size() * sizeof(SceneSectionEntry));
+	}
+	for (size_t i = 0; i < sections.size(); ++i) {
+		std::memcpy(out.data() + table[i].offset, sections[i].data, sections[i].size);
+	}
+}
+
+bool SceneWriter::write(const char* path) const {
+	std::vector<uint8_t> bytes;
+	serialize(bytes);
+	std::FILE* fp = std::fopen(path, "wb");
+	if (!fp) {
+		return false;
+	}
+	const bool ok = std::fwrite(bytes.data(), 1, bytes.size(), fp) == bytes.size();
+	return (std::fclose(fp) == 0) && ok;
+}
@@ -0,0 +1,456 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Editor/TextureCooker.hh>
+
+#include <Engine/core/Jobs.hh>
+#include <Engine/gfx/Color.hh>
+#include <Engine/math/simd.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+//================================================================
+
+namespace {
+
+// Bit widths and positions of the A, R, G, B fields
+struct FormatLayout {
+	uint32_t	bits[4];
+	uint32_t	shift[4];
+};
+
+inline FormatLayout layoutOf(PixelFormat format) noexcept {
+	switch (format) {
+	case PixelFormat::ARGB1555:	return { { 1, 5, 5, 5 }, { 15, 10, 5, 0 } };
+	case PixelFormat::RGB565:	return { { 0, 5, 6, 5 }, { 0, 11, 5, 0 } };
+	case PixelFormat::ARGB4444:	return { { 4, 4, 4, 4 }, { 12, 8, 4, 0 } };
+	default:					return { { 8, 8, 8, 8 }, { 24, 16, 8, 0 } };
+	}
+}
+
+inline uint32_t quantize(float v, uint32_t bits) noexcept {
+	if (bits == 0) {
+		return 0;
+	}
+	const float maxQ = static_cast<float>((1U << bits) - 1U);
+	return static_cast<uint32_t>(std::clamp(v * maxQ / 255.0f + 0.5f, 0.0f, maxQ));
+}
+
+inline uint32_t channel(uint32_t argb, uint32_t c) noexcept {
+	return (argb >> (24U - c * 8U)) & 0xFFU;
+}
+
+inline bool isPowerOfTwo(uint32_t v) noexcept {
+	return v && !(v & (v - 1U));
+}
+
+//----------------------------------------------------------------
+// VQ
+//----------------------------------------------------------------
+
+constexpr uint32_t VQ_DIMS		= 16U;		// 2x2 texels, ARGB each
+constexpr size_t VQ_CHUNK		= 1024U;	// Vectors per job, fixed so sums don't depend on threads
+constexpr float VQ_UNUSED		= 1.0e15f;	// Padding entries that never win
+constexpr float VQ_SPLIT		= 2.0f;		// LBG perturbation, in 8-bit channel units
+
+struct ChunkAccum {
+	std::vector<double>		sums;		// Per entry, per dimension
+	std::vector<double>		error;		// Per entry
+	std::vector<uint32_t>	counts;
+	std::vector<float>		worstDist;	// Per entry, its farthest member
+	std::vector<uint32_t>	worst;
+	double					distortion;
+	float					farthestDist;
+	uint32_t				farthest;
+};
+
+class VqEncoder {
+public:
+	VqEncoder(const std::vector<float>& vectors, uint32_t entries)
+		: mVectors(vectors)
+		, mCount(vectors.size() / VQ_DIMS)
+		, mEntries(entries)
+		, mStride((entries + 3U) & ~3U)
+		, mActive(0)
+		, mCentroids(static_cast<size_t>(VQ_DIMS) * mStride, VQ_UNUSED)
+		, mAssign(mCount, 0U)
+		, mChunks((mCount + VQ_CHUNK - 1U) / VQ_CHUNK) {
+		for (ChunkAccum& acc : mChunks) {
+			acc.sums.resize(static_cast<size_t>(mEntries) * VQ_DIMS);
+			acc.error.resize(mEntries);
+			acc.counts.resize(mEntries);
+			acc.worstDist.resize(mEntries);
+			acc.worst.resize(mEntries);
+		}
+	}
+
+	// LBG: start from the mean, split and refine until the codebook is full
+	uint32_t train(uint32_t maxIterations, float convergence) {
+		uint32_t iterations = 0;
+		mActive = 1;
+		std::fill(mCentroids.begin(), mCentroids.end(), VQ_UNUSED);
+		for (uint32_t d = 0; d < VQ_DIMS; ++d) {
+			mCentroids[d * mStride] = 0.0f;
+		}
+		assign();
+		update();
+		++iterations;
+
+		while (true) {
+			double previous = std::numeric_limits<double>::max();
+			for (uint32_t i = 0; i < maxIterations; ++i) {
+				const double distortion = assign();
+				update();
+				++iterations;
+				if (previous - distortion <= convergence * previous) {
+					break;
+				}
+				previous = distortion;
+			}
+			if (mActive >= mEntries || mActive >= mCount) {
+				break;
+			}
+			split(std::min(mActive, std::min(mEntries, static_cast<uint32_t>(mCount)) - mActive));
+		}
+		return iterations;
+	}
+
+	// Replace the centroids with their quantized form and assign against those
+	void finalize(const std::vector<float>& quantized) {
+		std::copy(quantized.begin(), quantized.end(), mCentroids.begin());
+		assign();
+	}
+
+	inline float centroid(uint32_t entry, uint32_t dim) const noexcept { return mCentroids[dim * mStride + entry]; }
+	constexpr inline uint32_t stride() const noexcept { return mStride; }
+	constexpr inline uint32_t active() const noexcept { return mActive; }
+	inline const std::vector<uint32_t>& assignment() const noexcept { return mAssign; }
+
+private:
+	// Nearest entry per vector, four entries per SIMD step. Returns the mean distortion.
+	double assign() {
+		const uint32_t padded = (mActive + 3U) & ~3U;
+		JobSystem::instance().parallelFor(mChunks.size(), 1, [&](size_t begin, size_t end) {
+			for (size_t chunk = begin; chunk < end; ++chunk) {
+				ChunkAccum& acc = mChunks[chunk];
+				std::fill(acc.sums.begin(), acc.sums.end(), 0.0);
+				std::fill(acc.error.begin(), acc.error.end(), 0.0);
+				std::fill(acc.counts.begin(), acc.counts.end(), 0U);
+				std::fill(acc.worstDist.begin(), acc.worstDist.end(), -1.0f);
+				acc.distortion = 0.0;
+				acc.farthestDist = -1.0f;
+				acc.farthest = 0;
+
+				const size_t first = chunk * VQ_CHUNK;
+				const size_t last = std::min(mCount, first + VQ_CHUNK);
+				for (size_t n = first; n < last; ++n) {
+					const float* v = &mVectors[n * VQ_DIMS];
+					SimdFloat4 bestDist = simdSplat(std::numeric_limits<float>::max());
+					SimdFloat4 bestIndex = simdSplat(0.0f);
+					SimdFloat4 index = simdSet(0.0f, 1.0f, 2.0f, 3.0f);
+					const SimdFloat4 four = simdSplat(4.0f);
+
+					for (uint32_t k = 0; k < padded; k += 4U) {
+						SimdFloat4 dist = simdSplat(0.0f);
+						for (uint32_t d = 0; d < VQ_DIMS; ++d) {
+							const SimdFloat4 diff = simdSplat(v[d]) - simdLoadU(&mCentroids[d * mStride + k]);
+							dist = dist + diff * diff;
+						}
+						const SimdFloat4 closer = simdCmpLt(dist, bestDist);
+						bestDist = simdSelect(closer, dist, bestDist);
+						bestIndex = simdSelect(closer, index, bestIndex);
+						index = index + four;
+					}
+
+					// Lowest index wins ties, as in a scalar search
+					alignas(16) float dists[4];
+					alignas(16) float indices[4];
+					simdStore(dists, bestDist);
+					simdStore(indices, bestIndex);
+					uint32_t best = 0;
+					for (uint32_t lane = 1; lane < 4; ++lane) {
+						if (dists[lane] < dists[best] || (dists[lane] == dists[best] && indices[lane] < indices[best])) {
+							best = lane;
+						}
+					}
+
+					const uint32_t entry = static_cast<uint32_t>(indices[best]);
+					mAssign[n] = entry;
+					acc.counts[entry]++;
+					acc.error[entry] += dists[best];
+					acc.distortion += dists[best];
+					double* sum = &acc.sums[static_cast<size_t>(entry) * VQ_DIMS];
+					for (uint32_t d = 0; d < VQ_DIMS; ++d) {
+						sum[d] += v[d];
+					}
+					if (dists[best] > acc.worstDist[entry]) {
+						acc.worstDist[entry] = dists[best];
+						acc.worst[entry] = static_cast<uint32_t>(n);
+					}
+					if (dists[best] > acc.farthestDist) {
+						acc.farthestDist = dists[best];
+						acc.farthest = static_cast<uint32_t>(n);
+					}
+				}
+			}
+		});
+
+		double distortion = 0.0;
+		for (const ChunkAccum& acc : mChunks) {
+			distortion += acc.distortion;
+		}
+		return mCount ? distortion / static_cast<double>(mCount) : 0.0;
+	}
+
+	// Move each entry to the mean of its vectors, reseeding empty ones at the worst-fit vectors
+	void update() {
+		mError.assign(mActive, 0.0);
+		std::vector<uint32_t> empty;
+		for (uint32_t k = 0; k < mActive; ++k) {
+			double sum[VQ_DIMS] = {};
+			uint32_t count = 0;
+			for (const ChunkAccum& acc : mChunks) {
+				count += acc.counts[k];
+				mError[k] += acc.error[k];
+				const double* s = &acc.sums[static_cast<size_t>(k) * VQ_DIMS];
+				for (uint32_t d = 0; d < VQ_DIMS; ++d) {
+					sum[d] += s[d];
+				}
+			}
+			if (!count) {
+				empty.push_back(k);
+				continue;
+			}
+			for (uint32_t d = 0; d < VQ_DIMS; ++d) {
+				mCentroids[d * mStride + k] = static_cast<float>(sum[d] / count);
+			}
+		}
+
+		if (empty.empty()) {
+			return;
+		}
+		std::vector<const ChunkAccum*> worst;
+		for (const ChunkAccum& acc : mChunks) {
+			worst.push_back(&acc);
+		}
+		std::stable_sort(worst.begin(), worst.end(), [](const ChunkAccum* a, const ChunkAccum* b) { return a->farthestDist > b->farthestDist; });
+		for (size_t i = 0; i < empty.size() && i < worst.size(); ++i) {
+			const float* v = &mVectors[static_cast<size_t>(worst[i]->farthest) * VQ_DIMS];
+			for (uint32_t d = 0; d < VQ_DIMS; ++d) {
+				mCentroids[d * mStride + empty[i]] = v[d];
+			}
+		}
+	}
+
+	// Split the `count` entries with the highest error in two, along the
+	// line to their worst-fit member. A fixed offset would keep every entry
+	// on the diagonal through the mean, and k-means can't leave it when the
+	// data is symmetric about it (a red/green ramp is).
+	void split(uint32_t count) {
+		std::vector<uint32_t> order(mActive);
+		for (uint32_t k = 0; k < mActive; ++k) {
+			order[k] = k;
+		}
+		std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) { return mError[a] > mError[b]; });
+
+		for (uint32_t i = 0; i < count; ++i) {
+			const uint32_t from = order[i];
+			const uint32_t to = mActive + i;
+			const float* far = nullptr;
+			float farDist = 0.0f;
+			for (const ChunkAccum& acc : mChunks) {
+				if (acc.worstDist[from] > farDist) {
+					farDist = acc.worstDist[from];
+					far = &mVectors[static_cast<size_t>(acc.worst[from]) * VQ_DIMS];
+				}
+			}
+			for (uint32_t d = 0; d < VQ_DIMS; ++d) {
+				const float c = mCentroids[d * mStride + from];
+				const float offset = far ? (far[d] - c) * 0.5f : VQ_SPLIT;
+				mCentroids[d * mStride + to] = c + offset;
+				mCentroids[d * mStride + from] = far ? c : c - offset;
+			}
+		}
+		mActive += count;
+	}
+
+	const std::vector<float>&	mVectors;
+	size_t						mCount;
+	uint32_t					mEntries;
+	uint32_t					mStride;
+	uint32_t					mActive;
+	std::vector<float>			mCentroids;		// SoA, dimension major
+	std::vector<uint32_t>		mAssign;
+	std::vector<double>			mError;			// Per active entry, from the last update
+	std::vector<ChunkAccum>		mChunks;
+};
+
+} // namespace
+
+//================================================================
+
+uint32_t TextureCooker::twiddleIndex(uint32_t x, uint32_t y, uint32_t width, uint32_t height) noexcept {
+	const uint32_t side = std::min(width, height);
+	uint32_t index = 0;
+	uint32_t shift = 0;
+	for (uint32_t bit = 1; bit < side; bit <<= 1) {
+		index |= ((y & bit) ? 1U : 0U) << shift++;
+		index |= ((x & bit) ? 1U : 0U) << shift++;
+	}
+
+	// Rectangles are a row or column of twiddled squares
+	const uint32_t rest = (width > height) ? x : y;
+	return index | ((rest / side) << shift);
+}
+
+//----------------------------------------------------------------
+
+bool TextureCooker::cook(const uint32_t* argb, uint32_t width, uint32_t height, const TextureCookSettings& settings, CookedTexture& out, TextureCookStats* stats) const {
+	const auto start = std::chrono::steady_clock::now();
+	const bool vq = settings.vq;
+	const bool sixteenBit = (settings.format != PixelFormat::ARGB8888);
+	if (!argb || !isPowerOfTwo(width) || !isPowerOfTwo(height)
+	|| (vq && (!sixteenBit || width < 2U || height < 2U || settings.codebookSize == 0 || settings.codebookSize > 256U))) {
+		return false;
+	}
+
+	const FormatLayout layout = layoutOf(settings.format);
+	out.width = width;
+	out.height = height;
+	out.format = settings.format;
+	out.twiddled = vq || settings.twiddle;
+	out.vq = vq;
+	out.data.clear();
+	out.codebook.clear();
+
+	uint32_t iterations = 0;
+	if (!vq) {
+		// Straight conversion, error diffusion (serial in row order) when dithering to 16 bits
+		const size_t bytes = pixelFormatBytes(settings.format);
+		const size_t size = static_cast<size_t>(width) * height * bytes;
+		const Dither dither = (settings.dither && sixteenBit) ? Dither::ErrorDiffusion : Dither::None;
+		out.data.resize(size);
+		if (!out.twiddled) {
+			convertPixels(argb, PixelFormat::ARGB8888, width * sizeof(uint32_t), out.data.data(), settings.format, width * bytes, width, height, dither);
+		} else {
+			std::vector<uint8_t> linear(size);
+			convertPixels(argb, PixelFormat::ARGB8888, width * sizeof(uint32_t), linear.data(), settings.format, width * bytes, width, height, dither);
+			for (uint32_t y = 0; y < height; ++y) {
+				for (uint32_t x = 0; x < width; ++x) {
+					std::memcpy(&out.data[twiddleIndex(x, y, width, height) * bytes], &linear[(static_cast<size_t>(y) * width + x) * bytes], bytes);
+				}
+			}
+		}
+	} else {
+		// One 16-dimensional vector per 2x2 block, texels in twiddled order
+		const uint32_t blocksX = width / 2U;
+		const uint32_t blocksY = height / 2U;
+		const size_t count = static_cast<size_t>(blocksX) * blocksY;
+		std::vector<float> vectors(count * VQ_DIMS);
+		for (uint32_t by = 0; by < blocksY; ++by) {
+			for (uint32_t bx = 0; bx < blocksX; ++bx) {
+				float* v = &vectors[(static_cast<size_t>(by) * blocksX + bx) * VQ_DIMS];
+				for (uint32_t t = 0; t < 4; ++t) {
+					const uint32_t src = argb[static_cast<size_t>(by * 2U + (t & 1U)) * width + bx * 2U + (t >> 1)];
+					for (uint32_t c = 0; c < 4; ++c) {
+						// Channels the format drops don't take part in the search
+						v[t * 4U + c] = layout.bits[c] ? static_cast<float>(channel(src, c)) : 255.0f;
+					}
+				}
+			}
+		}
+
+		VqEncoder encoder(vectors, settings.codebookSize);
+		iterations = encoder.train(std::max(1U, settings.maxIterations), settings.convergence);
+
+		// Quantize the codebook, then pick indices against what the hardware will decode
+		const uint32_t entries = encoder.active();
+		std::vector<float> quantized(static_cast<size_t>(VQ_DIMS) * encoder.stride(), VQ_UNUSED);
+		out.codebook.resize(static_cast<size_t>(settings.codebookSize) * 4U, 0U);
+		for (uint32_t k = 0; k < entries; ++k) {
+			for (uint32_t t = 0; t < 4; ++t) {
+				uint32_t texel = 0;
+				for (uint32_t c = 0; c < 4; ++c) {
+					const uint32_t q = quantize(encoder.centroid(k, t * 4U + c), layout.bits[c]);
+					texel |= q << layout.shift[c];
+					quantized[(t * 4U + c) * encoder.stride() + k] = static_cast<float>(expandChannel(q, layout.bits[c]));
+				}
+				out.codebook[k * 4U + t] = static_cast<uint16_t>(texel);
+			}
+		}
+		encoder.finalize(quantized);
+
+		out.data.resize(count);
+		const std::vector<uint32_t>& assignment = encoder.assignment();
+		for (uint32_t by = 0; by < blocksY; ++by) {
+			for (uint32_t bx = 0; bx < blocksX; ++bx) {
+				out.data[twiddleIndex(bx, by, blocksX, blocksY)] = static_cast<uint8_t>(assignment[static_cast<size_t>(by) * blocksX + bx]);
+			}
+		}
+	}
+
+	if (stats) {
+		stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		stats->iterations = iterations;
+		stats->sourceBytes = static_cast<size_t>(width) * height * 4U;
+		stats->cookedBytes = out.sizeBytes();
+
+		std::vector<uint32_t> decoded;
+		decode(out, decoded);
+		const uint32_t firstChannel = layout.bits[0] ? 0U : 1U;
+		double sum = 0.0;
+		for (size_t i = 0; i < decoded.size(); ++i) {
+			for (uint32_t c = firstChannel; c < 4; ++c) {
+				const double d = static_cast<double>(channel(argb[i], c)) - static_cast<double>(channel(decoded[i], c));
+				sum += d * d;
+			}
+		}
+		stats->mse = sum / (static_cast<double>(decoded.size()) * (4U - firstChannel));
+		stats->psnr = (stats->mse > 0.0) ? 10.0 * std::log10(255.0 * 255.0 / stats->mse) : std::numeric_limits<double>::infinity();
+	}
+	return true;
+}
+
+bool TextureCooker::decode(const CookedTexture& texture, std::vector<uint32_t>& argb) {
+	const uint32_t width = texture.width;
+	const uint32_t height = texture.height;
+	argb.assign(static_cast<size_t>(width) * height, 0U);
+
+	if (texture.vq) {
+		const uint32_t blocksX = width / 2U;
+		const uint32_t blocksY = height / 2U;
+		if (texture.data.size() < static_cast<size_t>(blocksX) * blocksY) {
+			return false;
+		}
+		for (uint32_t by = 0; by < blocksY; ++by) {
+			for (uint32_t bx = 0; bx < blocksX; ++bx) {
+				const size_t entry = texture.data[twiddleIndex(bx, by, blocksX, blocksY)];
+				if (entry * 4U + 3U >= texture.codebook.size()) {
+					return false;
+				}
+				for (uint32_t t = 0; t < 4; ++t) {
+					argb[static_cast<size_t>(by * 2U + (t & 1U)) * width + bx * 2U + (t >> 1)] = unpackPixel(texture.format, texture.codebook[entry * 4U + t]);
+				}
+			}
+		}
+		return true;
+	}
+
+	const size_t bytes = pixelFormatBytes(texture.format);
+	if (texture.data.size() < static_cast<size_t>(width) * height * bytes) {
+		return false;
+	}
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			const size_t index = texture.twiddled ? twiddleIndex(x, y, width, height) : static_cast<size_t>(y) * width + x;
+			uint32_t texel = 0;
+			std::memcpy(&texel, &texture.data[index * bytes], bytes);
+			argb[static_cast<size_t>(y) * width + x] = unpackPixel(texture.format, texel);
+		}
+	}
+	return true;
+}
@@ -0,0 +1,306 @@
+// Dream Disk 2025 Game Editor
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Editor/TriangleBvh.hh>
+
+#include <Engine/math/simd.hh>
+
+#include <algorithm>
+
+//================================================================
+
+namespace {
+
+inline float axisOf(const Float3& v, int axis) noexcept {
+	return (axis == 0) ? v.x : ((axis == 1) ? v.y : v.z);
+}
+
+// Packet rays, loaded once per traversal
+struct PacketRays {
+	SimdFloat4	ox, oy, oz;
+	SimdFloat4	dx, dy, dz;
+	SimdFloat4	ix, iy, iz;
+
+	explicit PacketRays(const RayPacket& p) noexcept
+		: ox(simdLoad(p.ox)), oy(simdLoad(p.oy)), oz(simdLoad(p.oz))
+		, dx(simdLoad(p.dx)), dy(simdLoad(p.dy)), dz(simdLoad(p.dz))
+		, ix(simdLoad(p.ix)), iy(simdLoad(p.iy)), iz(simdLoad(p.iz)) {}
+};
+
+// Lanes whose slab interval meets the box within [0, tMax]
+inline int slab4(const PacketRays& r, const Aabb& box, SimdFloat4 tMax) noexcept {
+	SimdFloat4 t0 = (simdSplat(box.min.x) - r.ox) * r.ix;
+	SimdFloat4 t1 = (simdSplat(box.max.x) - r.ox) * r.ix;
+	SimdFloat4 lo = simdMin(t0, t1);
+	SimdFloat4 hi = simdMax(t0, t1);
+	t0 = (simdSplat(box.min.y) - r.oy) * r.iy;
+	t1 = (simdSplat(box.max.y) - r.oy) * r.iy;
+	lo = simdMax(lo, simdMin(t0, t1));
+	hi = simdMin(hi, simdMax(t0, t1));
+	t0 = (simdSplat(box.min.z) - r.oz) * r.iz;
+	t1 = (simdSplat(box.max.z) - r.oz) * r.iz;
+	lo = simdMax(lo, simdMin(t0, t1));
+	hi = simdMin(hi, simdMax(t0, t1));
+	lo = simdMax(lo, simdSplat(0.0f));
+	return simdMoveMask(simdCmpLe(lo, hi) & simdCmpLe(lo, tMax));
+}
+
+// Moller-Trumbore against four rays, double sided like Ray::intersect
+inline int triangle4(const PacketRays& r, const Float3& a, const Float3& b, const Float3& c, SimdFloat4 tMax,
+	SimdFloat4& t, SimdFloat4& u, SimdFloat4& v) noexcept {
+	const Float3 e1 = b - a;
+	const Float3 e2 = c - a;
+	const SimdFloat4 e1x = simdSplat(e1.x), e1y = simdSplat(e1.y), e1z = simdSplat(e1.z);
+	const SimdFloat4 e2x = simdSplat(e2.x), e2y = simdSplat(e2.y), e2z = simdSplat(e2.z);
+
+	const SimdFloat4 px = r.dy * e2z - r.dz * e2y;
+	const SimdFloat4 py = r.dz * e2x - r.dx * e2z;
+	const SimdFloat4 pz = r.dx * e2y - r.dy * e2x;
+	const SimdFloat4 det = e1x * px + e1y * py + e1z * pz;
+	const SimdFloat4 zero = simdSplat(0.0f);
+	const SimdFloat4 one = simdSplat(1.0f);
+	const SimdFloat4 absDet = simdMax(det, zero - det);
+	const SimdFloat4 inv = one / simdSelect(simdCmpLt(absDet, simdSplat(1.0e-12f)), one, det);
+
+	const SimdFloat4 sx = r.ox - simdSplat(a.x);
+	const SimdFloat4 sy = r.oy - simdSplat(a.y);
+	const SimdFloat4 sz = r.oz - simdSplat(a.z);
+	u = (sx * px + sy * py + sz * pz) * inv;
+
+	const SimdFloat4 qx = sy * e1z - sz * e1y;
+	const SimdFloat4 qy = sz * e1x - sx * e1z;
+	const SimdFloat4 qz = sx * e1y - sy * e1x;
+	v = (r.dx * qx + r.dy * qy + r.dz * qz) * inv;
+	t = (e2x * qx + e2y * qy + e2z * qz) * inv;
+
+	const SimdFloat4 ok = simdCmpGe(absDet, simdSplat(1.0e-12f))
+		& simdCmpGe(u, zero) & simdCmpLe(u, one)
+		& simdCmpGe(v, zero) & simdCmpLe(u + v, one)
+		& simdCmpLt(zero, t) & simdCmpLt(t, tMax);
+	return simdMoveMask(ok);
+}
+
+} // namespace
+
+//================================================================
+
+void TriangleBvh::build(const Float3* positions, const uint32_t* indices, size_t triangleCount) {
+	mNodes.clear();
+	mVerts.clear();
+	mTriIds.clear();
+	if (triangleCount == 0) {
+		return;
+	}
+
+	std::vector<Float3> centroids(triangleCount);
+	std::vector<uint32_t> order(triangleCount);
+	for (size_t t = 0; t < triangleCount; ++t) {
+		const Float3& a = positions[indices[t * 3U + 0U]];
+		const Float3& b = positions[indices[t * 3U + 1U]];
+		const Float3& c = positions[indices[t * 3U + 2U]];
+		centroids[t] = (a + b + c) * (1.0f / 3.0f);
+		order[t] = static_cast<uint32_t>(t);
+	}
+
+	struct Task {
+		uint32_t	node;
+		uint32_t	begin;
+		uint32_t	end;
+	};
+	std::vector<Task> stack;
+	mNodes.reserve(triangleCount * 2U / LEAF_SIZE + 1U);
+	mNodes.push_back({});
+	stack.push_back({ 0, 0, static_cast<uint32_t>(triangleCount) });
+
+	while (!stack.empty()) {
+		const Task task = stack.back();
+		stack.pop_back();
+
+		Aabb box = { { 1.0e30f, 1.0e30f, 1.0e30f }, { -1.0e30f, -1.0e30f, -1.0e30f } };
+		Aabb cbox = box;
+		for (uint32_t i = task.begin; i < task.end; ++i) {
+			const uint32_t t = order[i];
+			for (size_t k = 0; k < 3U; ++k) {
+				const Float3& p = positions[indices[t * 3U + k]];
+				box.min = min(box.min, p);
+				box.max = max(box.max, p);
+			}
+			cbox.min = min(cbox.min, centroids[t]);
+			cbox.max = max(cbox.max, centroids[t]);
+		}
+		mNodes[task.node].bounds = box;
+
+		const uint32_t count = task.end - task.begin;
+		if (count <= LEAF_SIZE) {
+			mNodes[task.node].first = task.begin;
+			mNodes[task.node].count = count;
+			continue;
+		}
+
+		const Float3 ext = cbox.max - cbox.min;
+		const int axis = (ext.x >= ext.y && ext.x >= ext.z) ? 0 : ((ext.y >= ext.z) ? 1 : 2);
+		const uint32_t mid = task.begin + count / 2U;
+		std::nth_element(order.begin() + task.begin, order.begin() + mid, order.begin() + task.end,
+			[&centroids, axis](uint32_t a, uint32_t b) { return axisOf(centroids[a], axis) < axisOf(centroids[b], axis); });
+
+		const uint32_t left = static_cast<uint32_t>(mNodes.size());
+		mNodes.push_back({});
+		mNodes.push_back({});
+		mNodes[task.node].first = left;
+		mNodes[task.node].count = 0;
+		stack.push_back({ left, task.begin, mid });
+		stack.push_back({ left + 1U, mid, task.end });
+	}
+
+	mVerts.resize(triangleCount * 3U);
+	mTriIds = std::move(order);
+	for (size_t i = 0; i < triangleCount; ++i) {
+		const uint32_t t = mTriIds[i];
+		mVerts[i * 3U + 0U] = positions[indices[t * 3U + 0U]];
+		mVerts[i * 3U + 1U] = positions[indices[t * 3U + 1U]];
+		mVerts[i * 3U + 2U] = positions[indices[t * 3U + 2U]];
+	}
+}
+
+//----------------------------------------------------------------
+
+bool TriangleBvh::occluded(const Ray& ray, float tMax) const noexcept {
+	if (mNodes.empty()) {
+		return false;
+	}
+	uint32_t stack[64];
+	size_t top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		const Node& node = mNodes[stack[--top]];
+		float tNear;
+		if (!ray.intersect(node.bounds, tMax, tNear)) {
+			continue;
+		}
+		if (node.count == 0) {
+			stack[top++] = node.first;
+			stack[top++] = node.first + 1U;
+			continue;
+		}
+		for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+			float t, u, v;
+			if (ray.intersect(mVerts[i * 3U], mVerts[i * 3U + 1U], mVerts[i * 3U + 2U], tMax, t, u, v)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool TriangleBvh::intersect(const Ray& ray, float tMax, BvhHit& hit) const noexcept {
+	if (mNodes.empty()) {
+		return false;
+	}
+	bool found = false;
+	uint32_t stack[64];
+	size_t top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		const Node& node = mNodes[stack[--top]];
+		float tNear;
+		if (!ray.intersect(node.bounds, tMax, tNear)) {
+			continue;
+		}
+		if (node.count == 0) {
+			stack[top++] = node.first;
+			stack[top++] = node.first + 1U;
+			continue;
+		}
+		for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+			float t, u, v;
+			if (ray.intersect(mVerts[i * 3U], mVerts[i * 3U + 1U], mVerts[i * 3U + 2U], tMax, t, u, v)) {
+				tMax = t;
+				hit = { t, u, v, mTriIds[i] };
+				found = true;
+			}
+		}
+	}
+	return found;
+}
+
+//----------------------------------------------------------------
+
+uint32_t TriangleBvh::occluded4(const RayPacket& packet, const float (&tMax)[4], uint32_t mask) const noexcept {
+	mask &= 0xFU;
+	if (mNodes.empty() || mask == 0) {
+		return 0;
+	}
+	const PacketRays rays(packet);
+	const SimdFloat4 far = simdLoadU(tMax);
+	uint32_t blocked = 0;
+	uint32_t stack[64];
+	size_t top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		const Node& node = mNodes[stack[--top]];
+		// Lanes already blocked drop out of the remaining tests
+		const uint32_t active = mask & ~blocked & static_cast<uint32_t>(slab4(rays, node.bounds, far));
+		if (active == 0) {
+			continue;
+		}
+		if (node.count == 0) {
+			stack[top++] = node.first;
+			stack[top++] = node.first + 1U;
+			continue;
+		}
+		for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+			SimdFloat4 t, u, v;
+			blocked |= active & static_cast<uint32_t>(triangle4(rays, mVerts[i * 3U], mVerts[i * 3U + 1U], mVerts[i * 3U + 2U], far, t, u, v));
+		}
+		if (blocked == mask) {
+			break;
+		}
+	}
+	return blocked;
+}
+
+uint32_t TriangleBvh::intersect4(const RayPacket& packet, const float (&tMax)[4], BvhHit (&hits)[4], uint32_t mask) const noexcept {
+	mask &= 0xFU;
+	if (mNodes.empty() || mask == 0) {
+		return 0;
+	}
+	const PacketRays rays(packet);
+	SimdFloat4 far = simdLoadU(tMax);
+	uint32_t found = 0;
+	uint32_t stack[64];
+	size_t top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		const Node& node = mNodes[stack[--top]];
+		const uint32_t active = mask & static_cast<uint32_t>(slab4(rays, node.bounds, far));
+		if (active == 0) {
+			continue;
+		}
+		if (node.count == 0) {
+			stack[top++] = node.first;
+			stack[top++] = node.first + 1U;
+			continue;
+		}
+		for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+			SimdFloat4 t, u, v;
+			const uint32_t hit = active & static_cast<uint32_t>(triangle4(rays, mVerts[i * 3U], mVerts[i * 3U + 1U], mVerts[i * 3U + 2U], far, t, u, v));
+			if (hit == 0) {
+				continue;
+			}
+			alignas(16) float ts[4], us[4], vs[4], fs[4];
+			simdStore(ts, t);
+			simdStore(us, u);
+			simdStore(vs, v);
+			simdStore(fs, far);
+			for (uint32_t lane = 0; lane < 4U; ++lane) {
+				if (hit & (1U << lane)) {
+					hits[lane] = { ts[lane], us[lane], vs[lane], mTriIds[i] };
+					fs[lane] = ts[lane];
+				}
+			}
+			far = simdLoad(fs);
+			found |= hit;
+		}
+	}
+	return found;
+}
@@ -2,8 +2,3 @@
 # [Dream Disk 25] - Engine
 # ~/projects/Engine/cmake/dreamcast.cmake
 #================================================================
-
-target_include_directories(${TGT}
-	PUBLIC
-		${CMAKE_SOURCE_DIR}/third-party/sh4zam/include
-)
@@ -2,3 +2,11 @@
 # [Dream Disk 25] - Engine
 # ~/projects/Engine/cmake/linux.cmake
 #================================================================
+
+#----------------------------------------------------------------
+# Link Libraries: (JobSystem worker threads)
+#----------------------------------------------------------------
+find_package(Threads REQUIRED)
+target_link_libraries(${TGT} PUBLIC
+	Threads::Threads
+)
@@ -0,0 +1,84 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_CORE_FRAME_ARENA_HH
+#define DD25_ENGINE_CORE_FRAME_ARENA_HH
+//////////////////////////////////////////////////////////////////
+
+#include "core.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+//================================================================
+
+//
+// Linear per-frame allocator. `allocate()` is a single atomic add, so
+// any thread may allocate while recording; everything is released at
+// once by `reset()`. Allocations never move and are never freed
+// individually, an exhausted arena returns nullptr.
+//
+class FrameArena {
+public:
+	static constexpr size_t ALIGNMENT = 64U;
+
+	// Constructor
+	explicit FrameArena(size_t capacity);
+
+	// Destructor
+	~FrameArena() noexcept;
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	// `align` must be a power of two no larger than ALIGNMENT
+	inline void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) noexcept {
+		// Over-allocate by the alignment so the start can be rounded up
+		const size_t start = mUsed.fetch_add(bytes + align - 1U, std::memory_order_relaxed);
+		const size_t offset = (start + align - 1U) & ~(align - 1U);
+		if (offset + bytes > mCapacity) {
+			return nullptr;
+		}
+		return mData + offset;
+	}
+
+	template <typename T>
+	inline T* allocate(size_t count = 1) noexcept {
+		return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	// Release everything (no allocations may be in flight)
+	inline void reset() noexcept {
+		const size_t used = mUsed.load(std::memory_order_relaxed);
+		mHighWater = (used > mHighWater) ? used : mHighWater;
+		mUsed.store(0, std::memory_order_relaxed);
+	}
+
+	inline size_t used() const noexcept {
+		const size_t used = mUsed.load(std::memory_order_relaxed);
+		return (used < mCapacity) ? used : mCapacity;
+	}
+
+	constexpr inline size_t capacity() const noexcept { return mCapacity; }
+	constexpr inline size_t highWater() const noexcept { return mHighWater; }
+	constexpr inline uint8_t* data() const noexcept { return mData; }
+
+	// Offset of an arena pointer from the base (for compact references)
+	inline uint32_t offsetOf(const void* p) const noexcept {
+		return static_cast<uint32_t>(static_cast<const uint8_t*>(p) - mData);
+	}
+
+private:
+	uint8_t*				mData;
+	size_t					mCapacity;
+	std::atomic<size_t>		mUsed;
+	size_t					mHighWater;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_CORE_FRAME_ARENA_HH
+//////////////////////////////////////////////////////////////////
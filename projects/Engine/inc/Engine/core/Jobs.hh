@@ -0,0 +1,70 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_CORE_JOBS_HH
+#define DD25_ENGINE_CORE_JOBS_HH
+//////////////////////////////////////////////////////////////////
+
+#include "core.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+//================================================================
+
+// The Dreamcast has a single core, jobs run inline on the caller there.
+#ifndef DD25_JOBS_THREADED
+#if defined(__DREAMCAST__)
+#define DD25_JOBS_THREADED		0
+#else
+#define DD25_JOBS_THREADED		1
+#endif//__DREAMCAST__
+#endif//DD25_JOBS_THREADED
+
+//================================================================
+
+//
+// Fixed pool of worker threads running data-parallel loops.
+//
+// `parallelFor()` splits [0, count) into `grain` sized ranges, the
+// calling thread works alongside the pool and the call returns once
+// every range has run. A `parallelFor()` issued from inside a job runs
+// inline, so nested loops can't deadlock the pool.
+//
+class JobSystem {
+public:
+	using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+	// Constructor, `workers` = 0 uses one per hardware thread (minus the caller)
+	explicit JobSystem(size_t workers = 0);
+
+	// Destructor (joins the workers)
+	~JobSystem() noexcept;
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// Run `fn` over [0, count) in ranges of at most `grain` items
+	void parallelFor(size_t count, size_t grain, const RangeFn& fn);
+
+	// Threads that execute jobs, including the caller
+	size_t threadCount() const noexcept;
+
+	// Index of the calling thread within this pool (0 = the caller)
+	static size_t threadIndex() noexcept;
+
+	// Shared engine-wide pool
+	static JobSystem& instance();
+
+private:
+	struct Impl;
+	Impl*		mImpl;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_CORE_JOBS_HH
+//////////////////////////////////////////////////////////////////
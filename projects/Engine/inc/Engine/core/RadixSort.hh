@@ -0,0 +1,36 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_CORE_RADIX_SORT_HH
+#define DD25_ENGINE_CORE_RADIX_SORT_HH
+//////////////////////////////////////////////////////////////////
+
+#include "core.hh"
+
+#include <cstdint>
+#include <cstddef>
+
+//================================================================
+
+// 64-bit key with a 32-bit payload (an index or arena offset)
+struct SortPair {
+	uint64_t	key;
+	uint32_t	value;
+	uint32_t	pad;
+};
+
+//
+// Stable LSD radix sort on `key`, 8 bits per pass. Passes where every
+// key has the same digit are skipped, so keys that only use a few bits
+// cost a few passes. Large inputs split into blocks sorted by the job
+// system (histogram and scatter both run per block). `scratch` must hold
+// `count` items; the result always ends up in `items`.
+//
+void radixSort(SortPair* items, SortPair* scratch, size_t count);
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_CORE_RADIX_SORT_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,66 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_CORE_STRING_ID_HH
+#define DD25_ENGINE_CORE_STRING_ID_HH
+//////////////////////////////////////////////////////////////////
+
+#include "core.hh"
+
+#include <cstdint>
+#include <cstddef>
+
+//================================================================
+
+//
+// 32-bit hashed name (FNV-1a). Cooked data stores names as StringIds so
+// lookups are integer compares and records stay fixed-size; the original
+// strings live in an optional string table for tools and debugging.
+//
+class StringId {
+public:
+	// Default Constructor (the empty id)
+	constexpr StringId() noexcept : mHash(0) {}
+
+	// Hash Constructor
+	constexpr explicit StringId(uint32_t hash) noexcept : mHash(hash) {}
+
+	// String Constructors
+	constexpr StringId(const char* str) noexcept : mHash(hash(str)) {}
+	constexpr StringId(const char* str, size_t len) noexcept : mHash(hash(str, len)) {}
+
+	static constexpr uint32_t hash(const char* str, size_t len) noexcept {
+		uint32_t h = 2166136261U;
+		for (size_t i = 0; i < len; ++i) {
+			h = (h ^ static_cast<uint8_t>(str[i])) * 16777619U;
+		}
+		return h;
+	}
+
+	static constexpr uint32_t hash(const char* str) noexcept {
+		size_t len = 0;
+		while (str && str[len]) {
+			++len;
+		}
+		return str ? hash(str, len) : 0U;
+	}
+
+	constexpr inline uint32_t value() const noexcept { return mHash; }
+	constexpr inline bool empty() const noexcept { return mHash == 0; }
+
+	friend constexpr inline bool operator==(StringId a, StringId b) noexcept { return a.mHash == b.mHash; }
+	friend constexpr inline bool operator!=(StringId a, StringId b) noexcept { return a.mHash != b.mHash; }
+	friend constexpr inline bool operator<(StringId a, StringId b) noexcept { return a.mHash < b.mHash; }
+
+private:
+	uint32_t	mHash;
+};
+
+static_assert(sizeof(StringId) == sizeof(uint32_t), "StringId is stored in cooked data");
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_CORE_STRING_ID_HH
+//////////////////////////////////////////////////////////////////
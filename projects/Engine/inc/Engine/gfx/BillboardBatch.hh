@@ -0,0 +1,166 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_BILLBOARD_BATCH_HH
+#define DD25_ENGINE_GFX_BILLBOARD_BATCH_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "../core/RadixSort.hh"
+#include "../math/Geometry.hh"
+#include "IBillboard.hh"
+#include "ICommandQueue.hh"
+#include "StreamVertexBuffer.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+// Billboards kept as growable arrays, one per attribute
+class BillboardSet final : public IBillboard {
+public:
+	// Constructor
+	explicit BillboardSet(BillboardMode mode = BillboardMode::Camera, const ITexture* texture = nullptr) noexcept
+		: mTexture(texture)
+		, mMode(mode) {}
+
+	// Destructor
+	~BillboardSet() noexcept override;
+
+	inline BillboardMode mode() const noexcept override { return mMode; }
+	inline Float3 axis() const noexcept override { return mAxis; }
+	inline Float2 pivot() const noexcept override { return mPivot; }
+	inline const ITexture* texture() const noexcept override { return mTexture; }
+	inline AtlasRect region() const noexcept override { return mRegion; }
+	inline uint32_t color() const noexcept override { return mColor; }
+	BillboardArrays arrays() const noexcept override;
+
+	void clear() noexcept;
+	void reserve(size_t count);
+
+	// Rotation and colour arrays are only kept once a billboard uses them
+	void add(const Float3& position, const Float2& size, float rotation = 0.0f);
+	void add(const Float3& position, const Float2& size, float rotation, uint32_t color);
+
+	inline void setMode(BillboardMode mode) noexcept { mMode = mode; }
+	inline void setAxis(const Float3& axis) noexcept { mAxis = normalize(axis); }
+	inline void setPivot(const Float2& pivot) noexcept { mPivot = pivot; }
+	inline void setTexture(const ITexture* texture, const AtlasRect& region = { 0.0f, 0.0f, 1.0f, 1.0f, 0, 0 }) noexcept { mTexture = texture; mRegion = region; }
+	inline void setColor(uint32_t color) noexcept { mColor = color; }
+
+	inline size_t size() const noexcept { return mX.size(); }
+
+private:
+	std::vector<float>		mX;
+	std::vector<float>		mY;
+	std::vector<float>		mZ;
+	std::vector<float>		mWidth;
+	std::vector<float>		mHeight;
+	std::vector<float>		mRotation;
+	std::vector<uint32_t>	mColors;
+	const ITexture*			mTexture;
+	AtlasRect				mRegion		= { 0.0f, 0.0f, 1.0f, 1.0f, 0, 0 };
+	Float3					mAxis		= { 0.0f, 1.0f, 0.0f };
+	Float2					mPivot		= { 0.5f, 0.5f };
+	uint32_t				mColor		= 0xFFFFFFFFU;
+	BillboardMode			mMode;
+};
+
+//================================================================
+
+struct BillboardBatchSettings {
+	bool	sortTranslucent		= true;		// Back to front within each translucent set
+};
+
+// Per-frame counters, reset by `BillboardBatch::begin()`
+struct BillboardBatchStats {
+	uint32_t	sets;
+	uint32_t	billboards;
+	uint32_t	sorted;			// Billboards put back to front
+	uint32_t	dropped;		// Sets the stream had no room for
+	uint32_t	vertices;
+	float		sortMs;
+	float		expandMs;
+};
+
+//================================================================
+
+//
+// Expands billboard sets into camera-facing or axis-locked quads.
+//
+// `build()` reads each set's arrays four billboards at a time and
+// writes two triangles per billboard straight into this frame's part
+// of the streaming vertex buffer, across the job system. Camera mode
+// uses the view's right and up; Axis mode keeps the set's axis as up
+// and turns each quad about it to face the eye, falling back to the
+// view's right when looking along the axis.
+//
+// Sets added to the translucent list are sorted back to front by view
+// depth first (a radix sort on the float bits), the others keep their
+// order. Each set becomes one draw, keyed by its mean view depth, so
+// the queue orders sets against each other and everything else.
+//
+class BillboardBatch {
+public:
+	// Constructor, `stream` must outlive the batch
+	explicit BillboardBatch(StreamVertexBuffer& stream, const BillboardBatchSettings& settings = {});
+
+	// Destructor
+	~BillboardBatch() noexcept;
+
+	BillboardBatch(const BillboardBatch&) = delete;
+	BillboardBatch& operator=(const BillboardBatch&) = delete;
+
+	// Start a frame seen through `view` (world -> view, as `lookAt()` builds), depths normalized by `farPlane`
+	void begin(const Float4x4& view, float farPlane);
+
+	// Queue a set for `list`; it must stay unchanged until `build()`
+	void add(const IBillboard& set, RenderList list);
+
+	// Sort and write the vertex stream
+	void build();
+
+	// Record one draw per set
+	void submit(ICommandQueue& queue, uint8_t pass, const IMaterial* material = nullptr, uint32_t materialKey = 0) const;
+
+	inline void setSettings(const BillboardBatchSettings& settings) noexcept { mSettings = settings; }
+
+	constexpr inline const BillboardBatchSettings& settings() const noexcept { return mSettings; }
+	constexpr inline const BillboardBatchStats& stats() const noexcept { return mStats; }
+
+private:
+	struct Entry {
+		const IBillboard*	set;
+		RenderList			list;
+		uint32_t			first;		// In the stream
+		uint32_t			count;		// Vertices, 0 when dropped
+		uint32_t			texture;	// Into `mTextures`
+		float				depth;		// Mean view depth
+	};
+
+	uint32_t textureIndex(const ITexture* texture);
+
+	void expand(const IBillboard& set, GfxVertex* out, const SortPair* order) const;
+
+	std::vector<Entry>				mEntries;
+	std::vector<SortPair>			mOrder;
+	std::vector<SortPair>			mScratch;
+	std::vector<const ITexture*>	mTextures;		// Sort key texture index -> texture
+	StreamVertexBuffer&				mStream;
+	BillboardBatchSettings			mSettings;
+	BillboardBatchStats				mStats;
+	Float3							mEye;
+	Float3							mRight;
+	Float3							mUp;
+	Float3							mForward;
+	float							mFar;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_BILLBOARD_BATCH_HH
+//////////////////////////////////////////////////////////////////
@@ -8,8 +8,35 @@
 #define DD25_ENGINE_GFX_COLOR_HH
 //////////////////////////////////////////////////////////////////
 
+#include "../core/core.hh"
+#include "../math/Geometry.hh"
+#include "ITexture.hh"
+
+#include <cstdint>
+#include <cstddef>
+
 //================================================================
 
+// 8-bit channel from a `bits` wide field by bit replication, as the texture unit widens it
+constexpr inline uint32_t expandChannel(uint32_t q, uint32_t bits) noexcept {
+	if (bits == 0) {
+		return 255U;
+	}
+	if (bits >= 8U) {
+		return q & 0xFFU;
+	}
+	uint32_t v = q << (8U - bits);
+	for (uint32_t s = bits; s < 8U; s *= 2U) {
+		v |= v >> s;
+	}
+	return v & 0xFFU;
+}
+
+//
+// One packed pixel. CRTP supplies the layout as BITS / SHIFT tables in
+// A, R, G, B order (a channel with 0 bits reads as 255), `T` is the
+// storage type and `N` the number of stored channels.
+//
 template <
 	typename	CRTP,
 	typename	T,
@@ -17,16 +44,147 @@ template <
 >
 class Color {
 public:
+	using Storage = T;
+	static constexpr size_t CHANNELS = N;
+
 	// Default Constructor
-	Color() = default;
+	constexpr Color() noexcept = default;
+
+	// Constructor, from the packed value
+	constexpr explicit Color(T value) noexcept : mValue(value) {}
 
 	// Destructor
-	~Color() noexcept;
+	~Color() noexcept = default;
+
+	// Rounded to the nearest representable value
+	static constexpr T pack(uint32_t argb) noexcept {
+		uint32_t value = 0;
+		for (uint32_t c = 0; c < 4U; ++c) {
+			const uint32_t bits = CRTP::BITS[c];
+			if (bits) {
+				const uint32_t max = (1U << bits) - 1U;
+				value |= ((((argb >> (24U - c * 8U)) & 0xFFU) * max + 127U) / 255U) << CRTP::SHIFT[c];
+			}
+		}
+		return static_cast<T>(value);
+	}
+
+	static constexpr uint32_t unpack(T value) noexcept {
+		uint32_t argb = 0;
+		for (uint32_t c = 0; c < 4U; ++c) {
+			const uint32_t bits = CRTP::BITS[c];
+			const uint32_t q = bits ? (static_cast<uint32_t>(value) >> CRTP::SHIFT[c]) & ((1U << bits) - 1U) : 0U;
+			argb |= expandChannel(q, bits) << (24U - c * 8U);
+		}
+		return argb;
+	}
+
+	static constexpr CRTP fromArgb(uint32_t argb) noexcept { return CRTP(pack(argb)); }
+
+	static constexpr CRTP fromChannels(uint8_t a, uint8_t r, uint8_t g, uint8_t b) noexcept {
+		return fromArgb((static_cast<uint32_t>(a) << 24) | (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b);
+	}
+
+	constexpr inline T value() const noexcept { return mValue; }
+	constexpr inline uint32_t argb() const noexcept { return unpack(mValue); }
+
+	constexpr inline uint8_t a() const noexcept { return static_cast<uint8_t>(argb() >> 24); }
+	constexpr inline uint8_t r() const noexcept { return static_cast<uint8_t>(argb() >> 16); }
+	constexpr inline uint8_t g() const noexcept { return static_cast<uint8_t>(argb() >> 8); }
+	constexpr inline uint8_t b() const noexcept { return static_cast<uint8_t>(argb()); }
+
+	constexpr bool operator==(const Color& other) const noexcept = default;
 
 private:
+	T		mValue	= 0;
+};
+
+//================================================================
 
+class ColorARGB8888 final : public Color<ColorARGB8888, uint32_t, 4> {
+public:
+	static constexpr PixelFormat FORMAT = PixelFormat::ARGB8888;
+	static constexpr uint32_t BITS[4] = { 8, 8, 8, 8 };
+	static constexpr uint32_t SHIFT[4] = { 24, 16, 8, 0 };
+
+	using Color::Color;
 };
 
+class ColorARGB4444 final : public Color<ColorARGB4444, uint16_t, 4> {
+public:
+	static constexpr PixelFormat FORMAT = PixelFormat::ARGB4444;
+	static constexpr uint32_t BITS[4] = { 4, 4, 4, 4 };
+	static constexpr uint32_t SHIFT[4] = { 12, 8, 4, 0 };
+
+	using Color::Color;
+};
+
+class ColorARGB1555 final : public Color<ColorARGB1555, uint16_t, 4> {
+public:
+	static constexpr PixelFormat FORMAT = PixelFormat::ARGB1555;
+	static constexpr uint32_t BITS[4] = { 1, 5, 5, 5 };
+	static constexpr uint32_t SHIFT[4] = { 15, 10, 5, 0 };
+
+	using Color::Color;
+};
+
+class ColorRGB565 final : public Color<ColorRGB565, uint16_t, 3> {
+public:
+	static constexpr PixelFormat FORMAT = PixelFormat::RGB565;
+	static constexpr uint32_t BITS[4] = { 0, 5, 6, 5 };
+	static constexpr uint32_t SHIFT[4] = { 0, 11, 5, 0 };
+
+	using Color::Color;
+};
+
+// Any format's texel to ARGB8888
+inline uint32_t unpackPixel(PixelFormat format, uint32_t texel) noexcept {
+	switch (format) {
+	case PixelFormat::ARGB1555:		return ColorARGB1555::unpack(static_cast<uint16_t>(texel));
+	case PixelFormat::RGB565:		return ColorRGB565::unpack(static_cast<uint16_t>(texel));
+	case PixelFormat::ARGB4444:		return ColorARGB4444::unpack(static_cast<uint16_t>(texel));
+	default:						return texel;
+	}
+}
+
+//================================================================
+// Batch kernels
+//
+// Four pixels at a time in SIMD. Images are row order with strides in
+// bytes; source and destination must not overlap.
+//================================================================
+
+enum class Dither : uint8_t {
+	None			= 0,
+	Ordered			= 1,	// 4x4 Bayer threshold, rows independent
+	ErrorDiffusion	= 2		// Floyd-Steinberg, serial in row order
+};
+
+//
+// Convert between any two pixel formats, rounding to nearest. Dithering
+// applies when narrowing and never to 1-bit alpha, which is a cut-out
+// mask. Rows are spread over the job system except with error
+// diffusion, whose result depends on every pixel before it.
+//
+bool convertPixels(const void* src, PixelFormat srcFormat, size_t srcStride,
+	void* dst, PixelFormat dstFormat, size_t dstStride,
+	uint32_t width, uint32_t height, Dither dither = Dither::None);
+
+//
+// ARGB8888 <-> one float array per colour channel, in [0, 1]. Packing
+// clamps and takes each pixel's alpha from `alpha`, which may be
+// `argb` itself.
+//
+void argbToPlanar(const uint32_t* argb, float* r, float* g, float* b, size_t count) noexcept;
+void planarToArgb(const float* r, const float* g, const float* b, const uint32_t* alpha, uint32_t* argb, size_t count) noexcept;
+
+// Multiply colour by alpha in place, ARGB8888
+void premultiplyAlpha(uint32_t* argb, size_t count) noexcept;
+
+// sRGB-encoded ARGB8888 <-> linear x = r, y = g, z = b, w = a in [0, 1]. Alpha is linear both ways
+void srgbToLinear(const uint32_t* argb, Float4* linear, size_t count) noexcept;
+void linearToSrgb(const Float4* linear, uint32_t* argb, size_t count) noexcept;
+
 //////////////////////////////////////////////////////////////////
 #endif//DD25_ENGINE_GFX_COLOR_HH
 //////////////////////////////////////////////////////////////////
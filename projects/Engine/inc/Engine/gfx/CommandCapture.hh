@@ -0,0 +1,211 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_COMMAND_CAPTURE_HH
+#define DD25_ENGINE_GFX_COMMAND_CAPTURE_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "../io/CaptureFile.hh"
+#include "CommandQueue.hh"
+#include "IMaterial.hh"
+#include "ITexture.hh"
+#include "IVertexBuffer.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+//================================================================
+
+// Filled by `CommandCapture::capture()`
+struct CommandCaptureStats {
+	uint32_t	draws;
+	uint32_t	buffers;
+	uint32_t	textures;
+	uint32_t	materials;
+	uint32_t	transforms;
+	uint32_t	vertices;		// Over every buffer's captured span
+	uint32_t	missing;		// Buffers and textures without a CPU copy, captured empty
+	size_t		texelBytes;
+};
+
+//================================================================
+
+//
+// Snapshots one frame of a CommandQueue into a capture file (see
+// io/CaptureFile.hh) that CommandReplay plays back without the game.
+//
+// Every draw is kept with its key. Materials, textures, vertex buffers
+// and transforms are stored once each, keyed by address, and a vertex
+// buffer only contributes the range its draws read, so a frame drawn
+// from a large streaming buffer stays small. Resources that only live
+// in video memory are recorded with their sizes and no contents.
+//
+class CommandCapture {
+public:
+	// Default Constructor
+	CommandCapture() = default;
+
+	// Destructor
+	~CommandCapture() noexcept = default;
+
+	void clear();
+
+	//
+	// Copy every draw `queue` holds, in its current order, along with what
+	// they point at. Call after the frame's draws are recorded and before
+	// `reset()`; the resources must still be alive.
+	//
+	void capture(const CommandQueue& queue, const CaptureFrameRecord& frame);
+
+	// Lay the file out in memory
+	void serialize(std::vector<uint8_t>& out) const;
+
+	bool write(const char* path) const;
+
+	constexpr inline const CommandCaptureStats& stats() const noexcept { return mStats; }
+
+private:
+	uint32_t materialIndex(const IMaterial* material);
+	uint32_t textureIndex(const ITexture* texture);
+	uint32_t transformIndex(const Float4x4* transform);
+
+	std::vector<CaptureDrawRecord>					mDraws;
+	std::vector<CaptureBufferRecord>				mBuffers;
+	std::vector<GfxVertex>							mVertices;
+	std::vector<CaptureTextureRecord>				mTextures;
+	std::vector<uint8_t>							mTexels;
+	std::vector<CaptureMaterialRecord>				mMaterials;
+	std::vector<Float4x4>							mTransforms;
+	std::unordered_map<const IMaterial*, uint32_t>	mMaterialIndex;
+	std::unordered_map<const ITexture*, uint32_t>	mTextureIndex;
+	std::unordered_map<const Float4x4*, uint32_t>	mTransformIndex;
+	CaptureFrameRecord								mFrame		= {};
+	CommandCaptureStats								mStats		= {};
+};
+
+//================================================================
+
+// Vertex span of a capture, used in place
+class ReplayVertexBuffer final : public IVertexBuffer {
+public:
+	// Constructor
+	ReplayVertexBuffer(const GfxVertex* vertices, uint32_t count) noexcept
+		: mVertices(vertices)
+		, mCount(count) {}
+
+	// Destructor
+	~ReplayVertexBuffer() noexcept override;
+
+	inline const GfxVertex* vertices() const noexcept override { return mVertices; }
+	inline uint32_t vertexCount() const noexcept override { return mCount; }
+
+private:
+	const GfxVertex*	mVertices;
+	uint32_t			mCount;
+};
+
+// Texels of a capture, used in place
+class ReplayTexture final : public ITexture {
+public:
+	// Constructor
+	ReplayTexture(const CaptureTextureRecord& record, const void* pixels) noexcept
+		: mPixels(pixels)
+		, mWidth(record.width)
+		, mHeight(record.height)
+		, mFormat(static_cast<PixelFormat>(record.format)) {}
+
+	// Destructor
+	~ReplayTexture() noexcept override;
+
+	inline uint32_t width() const noexcept override { return mWidth; }
+	inline uint32_t height() const noexcept override { return mHeight; }
+	inline PixelFormat format() const noexcept override { return mFormat; }
+	inline const void* pixels() const noexcept override { return mPixels; }
+
+private:
+	const void*		mPixels;
+	uint32_t		mWidth;
+	uint32_t		mHeight;
+	PixelFormat		mFormat;
+};
+
+// Material rebuilt from its captured state and parameters
+class ReplayMaterial final : public IMaterial {
+public:
+	// Constructor
+	explicit ReplayMaterial(const CaptureMaterialRecord& record) noexcept;
+
+	// Destructor
+	~ReplayMaterial() noexcept override;
+
+	inline const PipelineState& state() const noexcept override { return mState; }
+	inline uint32_t stateHash() const noexcept override { return mHash; }
+	inline uint32_t sortKey() const noexcept override { return mSortKey; }
+	inline const MaterialParams& params() const noexcept override { return mParams; }
+
+private:
+	PipelineState		mState;
+	MaterialParams		mParams;
+	uint32_t			mHash;
+	uint32_t			mSortKey;
+};
+
+//================================================================
+
+//
+// Plays a capture file back through any backend, headless.
+//
+// `open()` validates every index, range and enum in the file and rebuilds the
+// resources as views into it. `submit()` records the captured draws into
+// a queue with their original keys, after which the usual `sort()` and
+// `execute()` issue the same binds and draws the game did, so a replay
+// measures the queue and the backend on exactly the captured frame.
+//
+class CommandReplay {
+public:
+	// Default Constructor
+	CommandReplay() = default;
+
+	// Destructor
+	~CommandReplay() noexcept = default;
+
+	CommandReplay(const CommandReplay&) = delete;
+	CommandReplay& operator=(const CommandReplay&) = delete;
+
+	// Map (or read, `map` = false) and validate `path`
+	bool open(const char* path, bool map = true);
+
+	void close() noexcept;
+
+	// Record every captured draw into `queue`, returns how many it accepted
+	uint32_t submit(ICommandQueue& queue) const;
+
+	constexpr inline bool isOpen() const noexcept { return mFrame != nullptr; }
+	constexpr inline const CaptureFrameRecord& frame() const noexcept { return *mFrame; }
+	constexpr inline size_t drawCount() const noexcept { return mDrawCount; }
+	inline size_t bufferCount() const noexcept { return mBuffers.size(); }
+	inline size_t textureCount() const noexcept { return mTextures.size(); }
+	inline size_t materialCount() const noexcept { return mMaterials.size(); }
+	constexpr inline const CaptureFile& file() const noexcept { return mFile; }
+
+private:
+	CaptureFile							mFile;
+	std::vector<ReplayVertexBuffer>		mBuffers;
+	std::vector<ReplayTexture>			mTextures;
+	std::vector<ReplayMaterial>			mMaterials;
+	const CaptureFrameRecord*			mFrame			= nullptr;
+	const CaptureDrawRecord*			mDraws			= nullptr;
+	size_t								mDrawCount		= 0;
+	const Float4x4*						mTransforms		= nullptr;
+	size_t								mTransformCount	= 0;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_COMMAND_CAPTURE_HH
+//////////////////////////////////////////////////////////////////
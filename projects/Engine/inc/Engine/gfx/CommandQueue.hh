@@ -0,0 +1,70 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_COMMAND_QUEUE_HH
+#define DD25_ENGINE_GFX_COMMAND_QUEUE_HH
+//////////////////////////////////////////////////////////////////
+
+#include "ICommandQueue.hh"
+#include "../core/FrameArena.hh"
+#include "../core/RadixSort.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+//
+// Default ICommandQueue. Commands are copied into a frame arena and the
+// queue itself only holds (key, arena offset) pairs, 16 bytes per draw,
+// so sorting never moves command data. Keys are ordered with a parallel
+// radix sort and execution tracks the bound state to skip redundant
+// binds.
+//
+class CommandQueue final : public ICommandQueue {
+public:
+	// Constructor
+	explicit CommandQueue(uint32_t maxCommands = 16384U, size_t arenaBytes = 1U << 20);
+
+	// Destructor
+	~CommandQueue() noexcept override;
+
+	void reset() override;
+	bool submit(uint64_t key, const DrawCommand& cmd) override;
+	void* allocate(size_t bytes, size_t align) override;
+	void sort() override;
+	void execute(IGfxBackend& backend) override;
+
+	inline const CommandQueueStats& stats() const noexcept override { return mStats; }
+
+	// Recorded draws, never more than capacity()
+	inline uint32_t size() const noexcept { return mCount.load(std::memory_order_relaxed); }
+
+	constexpr inline uint32_t capacity() const noexcept { return mCapacity; }
+
+	// Sorted order, valid between sort() and reset()
+	constexpr inline const SortPair* items() const noexcept { return mItems.data(); }
+
+	inline const DrawCommand& command(const SortPair& item) const noexcept {
+		return *reinterpret_cast<const DrawCommand*>(mArena.data() + item.value);
+	}
+
+private:
+	std::vector<SortPair>		mItems;
+	std::vector<SortPair>		mScratch;
+	FrameArena					mArena;
+	std::atomic<uint32_t>		mCount;
+	std::atomic<uint32_t>		mDropped;
+	uint32_t					mCapacity;
+	std::atomic<bool>			mSorted;		// Cleared by any submit()
+	CommandQueueStats			mStats;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_COMMAND_QUEUE_HH
+//////////////////////////////////////////////////////////////////
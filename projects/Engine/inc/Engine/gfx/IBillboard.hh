@@ -8,8 +8,37 @@
 #define DD25_ENGINE_GFX_I_BILLBOARD_HH
 //////////////////////////////////////////////////////////////////
 
+#include "../core/core.hh"
+#include "../math/Geometry.hh"
+#include "TextureAtlas.hh"
+
+#include <cstdint>
+
+//================================================================
+
+enum class BillboardMode : uint8_t {
+	Camera	= 0,	// Parallel to the view plane (particles, flares)
+	Axis	= 1		// Upright along `axis()`, turned about it towards the eye (foliage, impostors, beams)
+};
+
+// Per-billboard attributes, structure of arrays, `count` entries each
+struct BillboardArrays {
+	const float*	x;
+	const float*	y;
+	const float*	z;
+	const float*	width;
+	const float*	height;
+	const float*	rotation;		// Radians, counter-clockwise as seen; nullptr = none
+	const uint32_t*	color;			// ARGB8888; nullptr = `IBillboard::color()`
+	uint32_t		count;
+};
+
 //================================================================
 
+//
+// A set of billboards that share a texture, mode and pivot, drawn
+// together as one run of quads.
+//
 class IBillboard {
 public:
 	// Default Constructor
@@ -18,6 +47,23 @@ public:
 	// Virtual Destructor
 	virtual ~IBillboard() noexcept;
 
+	virtual BillboardMode mode() const noexcept = 0;
+
+	// World space up of the quads in Axis mode, normalized
+	virtual Float3 axis() const noexcept = 0;
+
+	// Placement and rotation origin, [0, 1] across the quad; (0.5, 0) stands on the ground
+	virtual Float2 pivot() const noexcept = 0;
+
+	// Texture and the part of it on every quad
+	virtual const ITexture* texture() const noexcept = 0;
+	virtual AtlasRect region() const noexcept = 0;
+
+	// Colour of every billboard when the set has none of its own
+	virtual uint32_t color() const noexcept = 0;
+
+	virtual BillboardArrays arrays() const noexcept = 0;
+
 private:
 
 };
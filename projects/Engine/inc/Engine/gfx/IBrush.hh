@@ -10,8 +10,11 @@
 
 #include "../core/core.hh"
 
+#include <cstdint>
+
 //================================================================
 
+// How a filled path is painted
 class IBrush {
 public:
 	// Default Constructor
@@ -20,6 +23,9 @@ public:
 	// Virtual Destructor
 	virtual ~IBrush() noexcept;
 
+	// ARGB8888
+	virtual uint32_t color() const noexcept = 0;
+
 private:
 
 };
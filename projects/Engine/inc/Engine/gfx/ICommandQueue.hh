@@ -9,9 +9,110 @@
 //////////////////////////////////////////////////////////////////
 
 #include "../core/core.hh"
+#include "../math/Geometry.hh"
+
+#include <cstdint>
+#include <cstddef>
+
+class IGfxBackend;
+class IMaterial;
+class ITexture;
+class IVertexBuffer;
+
+//================================================================
+
+// PowerVR display lists, submitted in this order within a pass
+enum class RenderList : uint8_t {
+	Opaque			= 0,
+	PunchThrough	= 1,	// Alpha tested
+	Translucent		= 2		// Blended, drawn back to front
+};
+
+enum class Primitive : uint8_t {
+	Triangles		= 0,
+	TriangleStrip	= 1
+};
 
 //================================================================
 
+//
+// 64-bit draw sort key, most significant field first:
+//
+//   opaque / punch-through:  pass:4 | list:2 | material:24 | texture:16 | depth:18
+//   translucent:             pass:4 | list:2 | ~depth:18    | material:24 | texture:16
+//
+// Solid lists group by state and go front to back within a state,
+// translucent draws go back to front and only group when depths tie.
+// `depth` is the view depth normalized to [0, 1].
+//
+struct SortKey {
+	static constexpr uint32_t PASS_BITS		= 4U;
+	static constexpr uint32_t LIST_BITS		= 2U;
+	static constexpr uint32_t MATERIAL_BITS	= 24U;
+	static constexpr uint32_t TEXTURE_BITS	= 16U;
+	static constexpr uint32_t DEPTH_BITS	= 18U;
+
+	static constexpr uint32_t PASS_SHIFT	= 60U;
+	static constexpr uint32_t LIST_SHIFT	= 58U;
+
+	static constexpr uint64_t mask(uint32_t bits) noexcept { return (uint64_t(1) << bits) - 1U; }
+
+	static constexpr uint64_t quantizeDepth(float depth) noexcept {
+		const float d = (depth < 0.0f) ? 0.0f : (depth > 1.0f) ? 1.0f : depth;
+		return static_cast<uint64_t>(d * static_cast<float>(mask(DEPTH_BITS)));
+	}
+
+	static constexpr uint64_t make(uint8_t pass, RenderList list, float depth, uint32_t material, uint32_t texture) noexcept {
+		const uint64_t head = (uint64_t(pass & mask(PASS_BITS)) << PASS_SHIFT) | (uint64_t(list) << LIST_SHIFT);
+		const uint64_t mat = material & mask(MATERIAL_BITS);
+		const uint64_t tex = texture & mask(TEXTURE_BITS);
+		const uint64_t z = quantizeDepth(depth);
+		if (list == RenderList::Translucent) {
+			return head | ((mask(DEPTH_BITS) - z) << (MATERIAL_BITS + TEXTURE_BITS)) | (mat << TEXTURE_BITS) | tex;
+		}
+		return head | (mat << (TEXTURE_BITS + DEPTH_BITS)) | (tex << DEPTH_BITS) | z;
+	}
+
+	static constexpr uint8_t pass(uint64_t key) noexcept { return static_cast<uint8_t>(key >> PASS_SHIFT); }
+	static constexpr RenderList list(uint64_t key) noexcept { return static_cast<RenderList>((key >> LIST_SHIFT) & mask(LIST_BITS)); }
+};
+
+//================================================================
+
+//
+// One recorded draw. Lives in the queue's frame arena until `reset()`,
+// so anything it points at (transform, vertex data) must stay valid
+// until the frame has executed.
+//
+struct DrawCommand {
+	const IMaterial*		material;
+	const ITexture*			texture;
+	const IVertexBuffer*	vertices;
+	const Float4x4*			transform;		// Object -> world, nullptr = identity
+	uint32_t				first;			// First vertex
+	uint32_t				count;			// Vertex count
+	Primitive				primitive;
+};
+
+// Per-frame counters, reset by `ICommandQueue::reset()`
+struct CommandQueueStats {
+	uint32_t	submitted;			// Draws recorded
+	uint32_t	dropped;			// Draws lost to a full queue or arena
+	uint32_t	draws;				// Draws executed
+	uint32_t	stateChanges;		// Pass, list, material, texture and vertex buffer binds issued
+	uint32_t	pipelineChanges;	// Material binds whose pipeline state differed from the last
+	uint32_t	redundantSkipped;	// Binds avoided because the state was already set
+	size_t		arenaBytes;			// Frame arena in use
+	float		sortMs;
+	float		executeMs;
+};
+
+//================================================================
+
+//
+// Records draws from any thread as (sort key, payload) pairs, sorts them
+// once per frame and replays them to a backend in key order.
+//
 class ICommandQueue {
 public:
 	// Default Constructor
@@ -20,8 +121,22 @@ public:
 	// Virtual Destructor
 	virtual ~ICommandQueue() noexcept;
 
-private:
+	// Start a new frame, drops every recorded command and arena allocation
+	virtual void reset() = 0;
+
+	// Record a draw (thread safe), false when the queue is full
+	virtual bool submit(uint64_t key, const DrawCommand& cmd) = 0;
+
+	// Frame scratch for command data such as transforms (thread safe)
+	virtual void* allocate(size_t bytes, size_t align) = 0;
+
+	// Order the recorded draws by key
+	virtual void sort() = 0;
+
+	// Walk the sorted draws, binding only state that changed
+	virtual void execute(IGfxBackend& backend) = 0;
 
+	virtual const CommandQueueStats& stats() const noexcept = 0;
 };
 
 //////////////////////////////////////////////////////////////////
@@ -9,6 +9,9 @@
 //////////////////////////////////////////////////////////////////
 
 #include "../core/core.hh"
+#include "ITexture.hh"
+
+#include <cstdint>
 
 //================================================================
 
@@ -20,6 +23,10 @@ public:
 	// Virtual Destructor
 	virtual ~IFrameBuffer() noexcept;
 
+	virtual uint32_t width() const noexcept = 0;
+	virtual uint32_t height() const noexcept = 0;
+	virtual PixelFormat format() const noexcept = 0;
+
 private:
 
 };
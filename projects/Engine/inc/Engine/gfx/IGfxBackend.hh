@@ -37,6 +37,17 @@ public:
 	// Virtual Destructor
 	virtual ~IGfxBackend() noexcept;
 
+	//
+	// Command execution, driven by `ICommandQueue::execute()` in sort key
+	// order. The queue only calls a bind when the state actually changes.
+	//
+	virtual void setPass(uint8_t pass) = 0;
+	virtual void setRenderList(RenderList list) = 0;
+	virtual void bindMaterial(const IMaterial* material) = 0;
+	virtual void bindTexture(const ITexture* texture) = 0;
+	virtual void bindVertexBuffer(const IVertexBuffer* vertices) = 0;
+	virtual void draw(const DrawCommand& cmd) = 0;
+
 private:
 
 };
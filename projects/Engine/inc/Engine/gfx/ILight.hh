@@ -9,6 +9,17 @@
 //////////////////////////////////////////////////////////////////
 
 #include "../core/core.hh"
+#include "../math/Geometry.hh"
+
+#include <cstdint>
+
+//================================================================
+
+enum class LightType : uint8_t {
+	Directional		= 0,
+	Point			= 1,
+	Spot			= 2
+};
 
 //================================================================
 
@@ -20,6 +31,25 @@ public:
 	// Virtual Destructor
 	virtual ~ILight() noexcept;
 
+	virtual LightType type() const noexcept = 0;
+
+	// Linear, may exceed 1
+	virtual Float3 color() const noexcept = 0;
+
+	// World space. `direction()` is normalized and points the way the light travels
+	virtual Float3 position() const noexcept = 0;
+	virtual Float3 direction() const noexcept = 0;
+
+	// Point and spot lights reach zero at `range()`
+	virtual float range() const noexcept = 0;
+
+	// Spot cone as cosines of the half angles, full inside `innerCone()`, none outside `outerCone()`
+	virtual float innerCone() const noexcept = 0;
+	virtual float outerCone() const noexcept = 0;
+
+	// Never moves or changes, so lighting from it may be cached
+	virtual bool isStatic() const noexcept = 0;
+
 private:
 
 };
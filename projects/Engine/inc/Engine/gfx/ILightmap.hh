@@ -9,6 +9,7 @@
 //////////////////////////////////////////////////////////////////
 
 #include "../core/core.hh"
+#include "ITexture.hh"
 
 //================================================================
 
@@ -20,6 +21,12 @@ public:
 	// Virtual Destructor
 	virtual ~ILightmap() noexcept;
 
+	// Baked light, addressed by a second UV set and multiplied with the surface texture
+	virtual const ITexture* texture() const noexcept = 0;
+
+	// Texels hold light divided by this (overbright), shading multiplies it back
+	virtual float intensityScale() const noexcept = 0;
+
 private:
 
 };
@@ -9,6 +9,108 @@
 //////////////////////////////////////////////////////////////////
 
 #include "../core/core.hh"
+#include "../math/Geometry.hh"
+#include "ICommandQueue.hh"
+
+#include <cstdint>
+#include <cstddef>
+
+//================================================================
+
+// PowerVR blend factors, "other" is the destination for the source factor and vice versa
+enum class BlendFactor : uint8_t {
+	Zero			= 0,
+	One				= 1,
+	OtherColor		= 2,
+	InvOtherColor	= 3,
+	SrcAlpha		= 4,
+	InvSrcAlpha		= 5,
+	DstAlpha		= 6,
+	InvDstAlpha		= 7
+};
+
+enum class DepthCompare : uint8_t {
+	Never			= 0,
+	Less			= 1,
+	Equal			= 2,
+	LessEqual		= 3,
+	Greater			= 4,
+	NotEqual		= 5,
+	GreaterEqual	= 6,
+	Always			= 7
+};
+
+enum class CullMode : uint8_t {
+	None			= 0,
+	Back			= 1,
+	Front			= 2
+};
+
+enum class TextureFilter : uint8_t {
+	Point			= 0,
+	Bilinear		= 1,
+	Trilinear		= 2
+};
+
+enum class TextureWrap : uint8_t {
+	Repeat			= 0,
+	Clamp			= 1,
+	Mirror			= 2
+};
+
+enum class ShadeMode : uint8_t {
+	Flat			= 0,
+	Gouraud			= 1
+};
+
+//================================================================
+
+//
+// Everything about how a material draws that costs a state change. A
+// material's state never changes after creation, so its hash is taken
+// once and two materials with equal states share one state id.
+//
+struct PipelineState {
+	uint32_t		shader			= 0;	// Shader permutation key, 0 = fixed function
+	RenderList		list			= RenderList::Opaque;
+	BlendFactor		srcBlend		= BlendFactor::One;
+	BlendFactor		dstBlend		= BlendFactor::Zero;
+	DepthCompare	depthCompare	= DepthCompare::LessEqual;
+	bool			depthWrite		= true;
+	CullMode		cull			= CullMode::None;
+	TextureFilter	filter			= TextureFilter::Bilinear;
+	TextureWrap		wrapU			= TextureWrap::Repeat;
+	TextureWrap		wrapV			= TextureWrap::Repeat;
+	ShadeMode		shading			= ShadeMode::Gouraud;
+	bool			fog				= false;
+
+	constexpr bool operator==(const PipelineState&) const noexcept = default;
+
+	// FNV-1a over the fields, padding never takes part
+	constexpr uint32_t hash() const noexcept {
+		const uint8_t bytes[] = {
+			static_cast<uint8_t>(shader), static_cast<uint8_t>(shader >> 8), static_cast<uint8_t>(shader >> 16), static_cast<uint8_t>(shader >> 24),
+			static_cast<uint8_t>(list), static_cast<uint8_t>(srcBlend), static_cast<uint8_t>(dstBlend), static_cast<uint8_t>(depthCompare),
+			static_cast<uint8_t>(depthWrite), static_cast<uint8_t>(cull), static_cast<uint8_t>(filter), static_cast<uint8_t>(wrapU),
+			static_cast<uint8_t>(wrapV), static_cast<uint8_t>(shading), static_cast<uint8_t>(fog)
+		};
+		uint32_t h = 2166136261U;
+		for (uint8_t b : bytes) {
+			h = (h ^ b) * 16777619U;
+		}
+		return h;
+	}
+};
+
+// Per-instance values, changed freely without touching the pipeline state
+struct MaterialParams {
+	Float4		color		= { 1.0f, 1.0f, 1.0f, 1.0f };	// Multiplies the vertex colour
+	Float2		uvOffset	= { 0.0f, 0.0f };
+	float		alphaRef	= 0.5f;							// Punch-through threshold
+	float		user		= 0.0f;
+};
+
+static_assert(sizeof(MaterialParams) == 32, "Parameter blocks are pooled as 32 byte records");
 
 //================================================================
 
@@ -20,6 +122,14 @@ public:
 	// Virtual Destructor
 	virtual ~IMaterial() noexcept;
 
+	virtual const PipelineState& state() const noexcept = 0;
+	virtual uint32_t stateHash() const noexcept = 0;
+
+	// The material field of a SortKey, groups draws by pipeline state first
+	virtual uint32_t sortKey() const noexcept = 0;
+
+	virtual const MaterialParams& params() const noexcept = 0;
+
 private:
 
 };
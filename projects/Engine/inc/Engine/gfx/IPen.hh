@@ -10,8 +10,25 @@
 
 #include "../core/core.hh"
 
+#include <cstdint>
+
 //================================================================
 
+// Shape where two stroked segments meet
+enum class LineJoin : uint8_t {
+	Miter	= 0,		// Falls back to Bevel past the pen's miter limit
+	Bevel	= 1,
+	Round	= 2
+};
+
+// Shape of an open stroke's ends
+enum class LineCap : uint8_t {
+	Butt	= 0,
+	Square	= 1,		// Extended by half the width
+	Round	= 2
+};
+
+// How a path's outline is stroked
 class IPen {
 public:
 	// Default Constructor
@@ -20,6 +37,15 @@ public:
 	// Virtual Destructor
 	virtual ~IPen() noexcept;
 
+	// ARGB8888
+	virtual uint32_t color() const noexcept = 0;
+	virtual float width() const noexcept = 0;
+	virtual LineJoin join() const noexcept = 0;
+	virtual LineCap cap() const noexcept = 0;
+
+	// Longest miter allowed, in multiples of half the width
+	virtual float miterLimit() const noexcept = 0;
+
 private:
 
 };
@@ -10,6 +10,47 @@
 
 #include "../core/core.hh"
 
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+//================================================================
+
+// Permutation of a shader program, an OR of ShaderFeature bits
+using ShaderKey = uint32_t;
+
+struct ShaderFeature {
+	static constexpr ShaderKey LIGHTING		= 1U << 0;
+	static constexpr ShaderKey SKINNING		= 1U << 1;
+	static constexpr ShaderKey FOG			= 1U << 2;
+	static constexpr ShaderKey ALPHA_TEST	= 1U << 3;
+	static constexpr ShaderKey VERTEX_COLOR	= 1U << 4;
+	static constexpr ShaderKey TEXTURE		= 1U << 5;
+
+	static constexpr uint32_t COUNT = 6U;
+
+	// Preprocessor name for bit `index`
+	static constexpr const char* name(uint32_t index) noexcept {
+		constexpr const char* names[COUNT] = {
+			"DD25_LIGHTING", "DD25_SKINNING", "DD25_FOG", "DD25_ALPHA_TEST", "DD25_VERTEX_COLOR", "DD25_TEXTURE"
+		};
+		return (index < COUNT) ? names[index] : "";
+	}
+};
+
+// "#define <feature> 1" lines for every bit set in `key`, in bit order
+inline std::string shaderDefines(ShaderKey key) {
+	std::string defines;
+	for (uint32_t i = 0; i < ShaderFeature::COUNT; ++i) {
+		if (key & (1U << i)) {
+			defines += "#define ";
+			defines += ShaderFeature::name(i);
+			defines += " 1\n";
+		}
+	}
+	return defines;
+}
+
 //================================================================
 
 class IShader {
@@ -20,6 +61,12 @@ public:
 	// Virtual Destructor
 	virtual ~IShader() noexcept;
 
+	virtual ShaderKey key() const noexcept = 0;
+
+	// Backend program binary
+	virtual const uint8_t* binary() const noexcept = 0;
+	virtual size_t binarySize() const noexcept = 0;
+
 private:
 
 };
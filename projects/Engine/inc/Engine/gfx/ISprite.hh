@@ -9,6 +9,9 @@
 //////////////////////////////////////////////////////////////////
 
 #include "../core/core.hh"
+#include "TextureAtlas.hh"
+
+#include <cstdint>
 
 //================================================================
 
@@ -20,6 +23,10 @@ public:
 	// Virtual Destructor
 	virtual ~ISprite() noexcept;
 
+	// Image as a region of an atlas page
+	virtual const TextureAtlas* atlas() const noexcept = 0;
+	virtual uint32_t region() const noexcept = 0;
+
 private:
 
 };
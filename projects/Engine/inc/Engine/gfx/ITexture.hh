@@ -10,6 +10,23 @@
 
 #include "../core/core.hh"
 
+#include <cstdint>
+#include <cstddef>
+
+//================================================================
+
+// Texel formats supported by the PowerVR texture unit
+enum class PixelFormat : uint8_t {
+	ARGB1555		= 0,
+	RGB565			= 1,
+	ARGB4444		= 2,
+	ARGB8888		= 3
+};
+
+constexpr inline size_t pixelFormatBytes(PixelFormat format) noexcept {
+	return (format == PixelFormat::ARGB8888) ? 4U : 2U;
+}
+
 //================================================================
 
 class ITexture {
@@ -20,6 +37,13 @@ public:
 	// Virtual Destructor
 	virtual ~ITexture() noexcept;
 
+	virtual uint32_t width() const noexcept = 0;
+	virtual uint32_t height() const noexcept = 0;
+	virtual PixelFormat format() const noexcept = 0;
+
+	// CPU copy of the texels in row order, nullptr when they only live in video memory
+	virtual const void* pixels() const noexcept = 0;
+
 private:
 
 };
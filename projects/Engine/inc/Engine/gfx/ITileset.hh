@@ -9,6 +9,9 @@
 //////////////////////////////////////////////////////////////////
 
 #include "../core/core.hh"
+#include "TextureAtlas.hh"
+
+#include <cstdint>
 
 //================================================================
 
@@ -20,6 +23,10 @@ public:
 	// Virtual Destructor
 	virtual ~ITileset() noexcept;
 
+	// Tile images, tile `i` is atlas region `i`
+	virtual const TextureAtlas* atlas() const noexcept = 0;
+	virtual uint32_t tileCount() const noexcept = 0;
+
 private:
 
 };
@@ -9,6 +9,18 @@
 //////////////////////////////////////////////////////////////////
 
 #include "../core/core.hh"
+#include "../math/Geometry.hh"
+
+#include <cstdint>
+
+//================================================================
+
+// Common vertex layout, a PowerVR packed colour vertex
+struct GfxVertex {
+	Float3		position;
+	uint32_t	color;		// ARGB8888
+	Float2		uv;
+};
 
 //================================================================
 
@@ -20,6 +32,10 @@ public:
 	// Virtual Destructor
 	virtual ~IVertexBuffer() noexcept;
 
+	// CPU copy of the vertices, nullptr when they only live in video memory
+	virtual const GfxVertex* vertices() const noexcept = 0;
+	virtual uint32_t vertexCount() const noexcept = 0;
+
 private:
 
 };
@@ -10,8 +10,15 @@
 
 #include "../core/core.hh"
 
+#include <cstdint>
+
 //================================================================
 
+//
+// An area of the output and the resolution the scene is rendered at for
+// it. The render size is the output size times `renderScale()`; the
+// rendered image is upscaled to fill the output.
+//
 class IViewport {
 public:
 	// Default Constructor
@@ -20,6 +27,15 @@ public:
 	// Virtual Destructor
 	virtual ~IViewport() noexcept;
 
+	// Output size in pixels
+	virtual uint32_t width() const noexcept = 0;
+	virtual uint32_t height() const noexcept = 0;
+
+	// Rendered size, at least 1 x 1
+	virtual float renderScale() const noexcept = 0;
+	virtual uint32_t renderWidth() const noexcept = 0;
+	virtual uint32_t renderHeight() const noexcept = 0;
+
 private:
 
 };
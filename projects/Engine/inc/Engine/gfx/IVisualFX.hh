@@ -10,8 +10,61 @@
 
 #include "../core/core.hh"
 
+#include <cstdint>
+#include <cstddef>
+
+class RenderTargetPool;
+
 //================================================================
 
+// An ARGB8888 image, stride in bytes
+struct PostImage {
+	uint32_t*	pixels;
+	uint32_t	width;
+	uint32_t	height;
+	size_t		stride;
+
+	inline uint32_t* row(uint32_t y) const noexcept {
+		return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(pixels) + y * stride);
+	}
+};
+
+// Most pixels in one PostSpan
+constexpr uint32_t POST_SPAN_MAX = 64U;
+
+//
+// Part of a row being shaded, channels in [0, 1] stored apart, 16 byte
+// aligned. `x` and `count` are multiples of 4; lanes past the image
+// edge hold copies of the last pixel and are never written back.
+// Values may leave [0, 1] between effects, they are clamped once packed.
+//
+struct PostSpan {
+	float*		r;
+	float*		g;
+	float*		b;
+	uint32_t	x;
+	uint32_t	y;
+	uint32_t	count;
+};
+
+// What `IVisualFX::setup()` needs to declare its render targets
+struct PostSetup {
+	RenderTargetPool*	pool;
+	uint32_t			width;
+	uint32_t			height;
+	uint32_t			preparePass;	// Pool pass of `prepare()`
+	uint32_t			shadePass;		// Pool pass of the shading it joins
+};
+
+//================================================================
+
+//
+// A post-processing effect. Per-pixel work goes in `shade()`, which the
+// chain runs back to back with its neighbours' on one span at a time.
+// Effects that need the whole image first (a blur, a histogram) build
+// what they need in `prepare()`; the chain then finishes the image up
+// to them before calling it.
+//
 class IVisualFX {
 public:
 	// Default Constructor
@@ -20,6 +73,20 @@ public:
 	// Virtual Destructor
 	virtual ~IVisualFX() noexcept;
 
+	virtual bool enabled() const noexcept = 0;
+
+	// True when `prepare()` reads the image
+	virtual bool readsInput() const noexcept = 0;
+
+	// Declare this frame's render targets in `setup.pool`
+	virtual void setup(const PostSetup& setup) = 0;
+
+	// Once the targets are placed; `input` is the image as the effects before left it
+	virtual void prepare(const PostImage& input, RenderTargetPool& pool) = 0;
+
+	// Any thread, concurrently
+	virtual void shade(PostSpan& span) const noexcept = 0;
+
 private:
 
 };
@@ -0,0 +1,41 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_LIGHTMAP_HH
+#define DD25_ENGINE_GFX_LIGHTMAP_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "ILightmap.hh"
+
+//================================================================
+
+//
+// A baked lightmap once its page is a texture: the Editor's
+// LightmapBakeResult cooks the page and carries the overbright scale,
+// the loader uploads the one and hands both here.
+//
+class Lightmap final : public ILightmap {
+public:
+	// Constructor, `texture` must outlive the lightmap
+	Lightmap(const ITexture* texture, float intensityScale) noexcept
+		: mTexture(texture)
+		, mIntensityScale(intensityScale) {}
+
+	// Destructor
+	~Lightmap() noexcept override = default;
+
+	inline const ITexture* texture() const noexcept override { return mTexture; }
+	inline float intensityScale() const noexcept override { return mIntensityScale; }
+
+private:
+	const ITexture*		mTexture;
+	float				mIntensityScale;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_LIGHTMAP_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,124 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_MATERIAL_SYSTEM_HH
+#define DD25_ENGINE_GFX_MATERIAL_SYSTEM_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "IMaterial.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+class MaterialSystem;
+
+//================================================================
+
+// A material created by MaterialSystem, parameters live in its pool
+class Material final : public IMaterial {
+public:
+	// Default Constructor, unusable until MaterialSystem fills it in
+	Material() = default;
+
+	// Destructor
+	~Material() noexcept override;
+
+	inline const PipelineState& state() const noexcept override { return mState; }
+	inline uint32_t stateHash() const noexcept override { return mHash; }
+	inline uint32_t sortKey() const noexcept override { return mSortKey; }
+	inline const MaterialParams& params() const noexcept override { return *mParams; }
+
+	// In place, never allocates
+	inline void setParams(const MaterialParams& params) noexcept { *mParams = params; }
+	inline void setColor(const Float4& color) noexcept { mParams->color = color; }
+	inline void setUvOffset(const Float2& offset) noexcept { mParams->uvOffset = offset; }
+	inline MaterialParams& editParams() noexcept { return *mParams; }
+
+	constexpr inline uint32_t stateId() const noexcept { return mStateId; }
+
+private:
+	friend class MaterialSystem;
+
+	PipelineState		mState;
+	uint32_t			mHash		= 0;
+	uint32_t			mStateId	= 0;
+	uint32_t			mSortKey	= 0;
+	MaterialParams*		mParams		= nullptr;
+	bool				mLive		= false;
+};
+
+// Counters over the live materials
+struct MaterialSystemStats {
+	uint32_t	materials;
+	uint32_t	uniqueStates;		// Distinct pipeline states in use
+	uint32_t	deduplicated;		// Creates whose state was already interned, all time
+	size_t		paramBytes;			// Parameter pool in use
+};
+
+//================================================================
+
+//
+// Owns materials and interns their pipeline states.
+//
+// `create()` hashes the state once and looks it up, so every material
+// with an equal state gets the same dense state id. Sort keys carry the
+// state id above the material's slot, so draws sharing a pipeline stay
+// together and, within it, draws of one material do too. Parameter
+// blocks sit in one pool allocated up front, indexed like the materials,
+// so editing them is a plain store and walking every material's
+// parameters is a linear read.
+//
+class MaterialSystem {
+public:
+	// Sort key layout, state:12 | slot:12
+	static constexpr uint32_t SLOT_BITS = 12U;
+	static constexpr uint32_t MAX_MATERIALS = 1U << SLOT_BITS;
+	static constexpr uint32_t MAX_STATES = 1U << (SortKey::MATERIAL_BITS - SLOT_BITS);
+
+	// Constructor, `maxMaterials` is capped at MAX_MATERIALS
+	explicit MaterialSystem(uint32_t maxMaterials = 1024U);
+
+	// Destructor
+	~MaterialSystem() noexcept;
+
+	MaterialSystem(const MaterialSystem&) = delete;
+	MaterialSystem& operator=(const MaterialSystem&) = delete;
+
+	// nullptr once `maxMaterials` are live or MAX_STATES distinct states exist
+	Material* create(const PipelineState& state, const MaterialParams& params = {});
+
+	// Ignores nullptr, materials of another system and ones already destroyed
+	void destroy(Material* material) noexcept;
+
+	// Interned state by id, ids stay valid for the system's lifetime
+	inline const PipelineState& state(uint32_t stateId) const noexcept { return mStates[stateId]; }
+	inline size_t stateCount() const noexcept { return mStates.size(); }
+
+	// Parameter pool, one block per material slot
+	constexpr inline const MaterialParams* paramPool() const noexcept { return mParams.data(); }
+
+	MaterialSystemStats stats() const noexcept;
+
+private:
+	uint32_t intern(const PipelineState& state, uint32_t hash);
+
+	std::vector<Material>						mMaterials;		// Sized once, addresses stay put
+	std::vector<MaterialParams>					mParams;		// Sized once, never reallocates
+	std::vector<uint32_t>						mFreeSlots;
+	std::vector<PipelineState>					mStates;
+	std::vector<uint32_t>						mStateRefs;
+	std::unordered_multimap<uint32_t, uint32_t>	mStateIds;		// Hash -> state id
+	uint32_t									mCapacity;
+	uint32_t									mLive;
+	uint32_t									mDeduplicated;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_MATERIAL_SYSTEM_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,101 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_POST_CHAIN_HH
+#define DD25_ENGINE_GFX_POST_CHAIN_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "IVisualFX.hh"
+#include "RenderTargetPool.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+struct PostChainSettings {
+	bool		fuse		= true;				// Off runs every effect as its own pass, for comparison
+	size_t		vramBudget	= 1U << 20;			// For the effects' own targets
+};
+
+// Per-call counters, reset by `PostChain::apply()`
+struct PostChainStats {
+	uint32_t	effects;			// Enabled
+	uint32_t	passes;				// Full image read-modify-writes
+	uint32_t	tiles;
+	uint32_t	skipped;			// Dropped because their targets didn't fit the budget
+	float		prepareMs;
+	float		shadeMs;
+	float		totalMs;
+};
+
+//================================================================
+
+//
+// Runs IVisualFX effects over a frame, in the order added.
+//
+// Consecutive effects are fused: each tile is read once, unpacked to
+// float channels, put through every effect's `shade()` while it sits in
+// L1 and packed once. A new pass only starts before an effect whose
+// `prepare()` reads the image, since that needs the effects ahead of it
+// finished everywhere. So bloom, grading, fade, scanlines and palette
+// in that order are one read and one write of the frame.
+//
+// Tiles are TILE_WIDTH x TILE_HEIGHT and spread over the job system.
+// The first pass reads `src` and writes `dst`, later ones work on `dst`
+// in place; `src` may be `dst`.
+//
+class PostChain {
+public:
+	static constexpr uint32_t TILE_WIDTH = POST_SPAN_MAX;
+	static constexpr uint32_t TILE_HEIGHT = 16U;
+
+	// Constructor
+	explicit PostChain(const PostChainSettings& settings = {});
+
+	// Destructor
+	~PostChain() noexcept;
+
+	PostChain(const PostChain&) = delete;
+	PostChain& operator=(const PostChain&) = delete;
+
+	// Not owned, must outlive the chain or be removed
+	void add(IVisualFX* effect);
+	void remove(IVisualFX* effect) noexcept;
+	void clear() noexcept;
+
+	// False when `src` and `dst` differ in size; `dst` then holds nothing new
+	bool apply(const PostImage& src, const PostImage& dst);
+
+	void setSettings(const PostChainSettings& settings) noexcept;
+
+	constexpr inline const PostChainSettings& settings() const noexcept { return mSettings; }
+	constexpr inline const PostChainStats& stats() const noexcept { return mStats; }
+	constexpr inline const RenderTargetPool& pool() const noexcept { return mPool; }
+
+private:
+	// Effects shaded in one pass, `first` is the one whose prepare() began it
+	struct Pass {
+		uint32_t	first;
+		uint32_t	end;
+	};
+
+	bool plan(uint32_t width, uint32_t height);
+	void shade(const PostImage& src, const PostImage& dst, const Pass& pass);
+
+	std::vector<IVisualFX*>		mEffects;
+	std::vector<IVisualFX*>		mActive;		// Enabled this call
+	std::vector<Pass>			mPasses;
+	RenderTargetPool			mPool;
+	PostChainSettings			mSettings;
+	PostChainStats				mStats;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_POST_CHAIN_HH
+//////////////////////////////////////////////////////////////////
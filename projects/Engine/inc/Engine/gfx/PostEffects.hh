@@ -0,0 +1,208 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_POST_EFFECTS_HH
+#define DD25_ENGINE_GFX_POST_EFFECTS_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "../math/Geometry.hh"
+#include "IVisualFX.hh"
+#include "RenderTargetPool.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+//
+// Glow around bright areas. What exceeds `threshold` is box filtered
+// down to quarter resolution, blurred `passes` times with a 5-tap
+// binomial each way and added back, bilinearly filtered.
+//
+class BloomFX final : public IVisualFX {
+public:
+	static constexpr uint32_t SCALE = 4U;
+
+	// Default Constructor
+	BloomFX() = default;
+
+	// Destructor
+	~BloomFX() noexcept override;
+
+	inline bool enabled() const noexcept override { return mIntensity > 0.0f; }
+	inline bool readsInput() const noexcept override { return true; }
+
+	void setup(const PostSetup& setup) override;
+	void prepare(const PostImage& input, RenderTargetPool& pool) override;
+	void shade(PostSpan& span) const noexcept override;
+
+	inline void setThreshold(float threshold) noexcept { mThreshold = threshold; }
+	inline void setIntensity(float intensity) noexcept { mIntensity = intensity; }
+	inline void setPasses(uint32_t passes) noexcept { mPasses = passes; }
+
+private:
+	const RenderTarget*		mGlow		= nullptr;		// Set by prepare(), nullptr skips shading
+	RenderTargetId			mGlowId		= RenderTargetPool::INVALID;
+	RenderTargetId			mScratchId	= RenderTargetPool::INVALID;
+	float					mThreshold	= 0.7f;
+	float					mIntensity	= 0.6f;
+	uint32_t				mPasses		= 2U;
+};
+
+//================================================================
+
+// Parameters `ColorGradeFX::setGrade()` bakes, applied in this order
+struct ColorGrade {
+	float		exposure	= 0.0f;					// Stops
+	Float3		tint		= { 1.0f, 1.0f, 1.0f };
+	float		contrast	= 1.0f;					// Around mid grey
+	float		saturation	= 1.0f;
+	float		gamma		= 1.0f;
+};
+
+//
+// Colour grading through a 3D lookup table, trilinearly filtered.
+// Either baked from ColorGrade parameters or loaded from a strip image
+// as artists author them: `size` blocks of `size` x `size`, red across
+// a block, green down it and blue from block to block.
+//
+class ColorGradeFX final : public IVisualFX {
+public:
+	static constexpr uint32_t MAX_LUT_SIZE = 64U;
+
+	// Default Constructor
+	ColorGradeFX();
+
+	// Destructor
+	~ColorGradeFX() noexcept override;
+
+	inline bool enabled() const noexcept override { return mEnabled; }
+	inline bool readsInput() const noexcept override { return false; }
+
+	inline void setup(const PostSetup&) override {}
+	inline void prepare(const PostImage&, RenderTargetPool&) override {}
+	void shade(PostSpan& span) const noexcept override;
+
+	void setGrade(const ColorGrade& grade, uint32_t size = 16U);
+
+	// False if `size` is out of [2, MAX_LUT_SIZE]
+	bool setLut(const uint32_t* strip, uint32_t size);
+
+	inline void setEnabled(bool enabled) noexcept { mEnabled = enabled; }
+
+	constexpr inline uint32_t lutSize() const noexcept { return mSize; }
+
+private:
+	std::vector<float>		mLut;			// r, g, b, unused per entry, red fastest
+	uint32_t				mSize		= 0;
+	bool					mEnabled	= false;
+};
+
+//================================================================
+
+// Blend towards a flat colour, for fades to and from black
+class FadeFX final : public IVisualFX {
+public:
+	// Default Constructor
+	FadeFX() = default;
+
+	// Destructor
+	~FadeFX() noexcept override;
+
+	inline bool enabled() const noexcept override { return mAmount > 0.0f; }
+	inline bool readsInput() const noexcept override { return false; }
+
+	inline void setup(const PostSetup&) override {}
+	inline void prepare(const PostImage&, RenderTargetPool&) override {}
+	void shade(PostSpan& span) const noexcept override;
+
+	inline void setColor(const Float3& color) noexcept { mColor = color; }
+	inline void setAmount(float amount) noexcept { mAmount = amount; }
+
+private:
+	Float3		mColor		= { 0.0f, 0.0f, 0.0f };
+	float		mAmount		= 0.0f;
+};
+
+//================================================================
+
+//
+// CRT look: dark gaps between scanlines `lineHeight` pixels apart, an
+// aperture grille of red, green and blue columns and a vignette.
+//
+class CrtFX final : public IVisualFX {
+public:
+	// Default Constructor
+	CrtFX();
+
+	// Destructor
+	~CrtFX() noexcept override;
+
+	inline bool enabled() const noexcept override { return mScanlines > 0.0f || mMask > 0.0f || mVignette > 0.0f; }
+	inline bool readsInput() const noexcept override { return false; }
+
+	void setup(const PostSetup& setup) override;
+	inline void prepare(const PostImage&, RenderTargetPool&) override {}
+	void shade(PostSpan& span) const noexcept override;
+
+	void setScanlines(float strength, uint32_t lineHeight = 2U) noexcept;
+	void setMask(float strength) noexcept;
+	inline void setVignette(float strength) noexcept { mVignette = strength; }
+
+private:
+	alignas(16) float	mMaskLanes[3][3][4];	// [x / 4 % 3][channel][lane]
+	float				mScanlines	= 0.0f;
+	float				mMask		= 0.0f;
+	float				mVignette	= 0.0f;
+	uint32_t			mLineHeight	= 2U;
+	float				mInvWidth	= 1.0f;
+	float				mInvHeight	= 1.0f;
+};
+
+//================================================================
+
+//
+// Maps brightness onto a palette ordered dark to light, for limited
+// colour looks (four greens, sepia, night vision), optionally with a
+// 4x4 ordered dither between neighbouring entries.
+//
+class PaletteFX final : public IVisualFX {
+public:
+	static constexpr uint32_t MAX_COLORS = 32U;
+
+	// Default Constructor
+	PaletteFX() = default;
+
+	// Destructor
+	~PaletteFX() noexcept override;
+
+	inline bool enabled() const noexcept override { return mAmount > 0.0f && mCount > 0; }
+	inline bool readsInput() const noexcept override { return false; }
+
+	inline void setup(const PostSetup&) override {}
+	inline void prepare(const PostImage&, RenderTargetPool&) override {}
+	void shade(PostSpan& span) const noexcept override;
+
+	// ARGB8888, at most MAX_COLORS are kept
+	void setPalette(const uint32_t* argb, uint32_t count) noexcept;
+
+	inline void setDither(bool dither) noexcept { mDither = dither; }
+	inline void setAmount(float amount) noexcept { mAmount = amount; }
+
+private:
+	float		mR[MAX_COLORS];
+	float		mG[MAX_COLORS];
+	float		mB[MAX_COLORS];
+	uint32_t	mCount		= 0;
+	float		mAmount		= 1.0f;
+	bool		mDither		= false;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_POST_EFFECTS_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,178 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_RENDER_TARGET_POOL_HH
+#define DD25_ENGINE_GFX_RENDER_TARGET_POOL_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "IFrameBuffer.hh"
+#include "ITexture.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+using RenderTargetId = uint32_t;
+
+struct RenderTargetDesc {
+	uint32_t	width;
+	uint32_t	height;
+	PixelFormat	format;
+};
+
+struct RenderTargetPoolSettings {
+	size_t		vramBudget	= 2U << 20;		// Intermediate targets' share of the 8 MB
+	uint32_t	idleFrames	= 8U;			// Surfaces unused this long are freed
+};
+
+// Per-frame counters, reset by `RenderTargetPool::beginFrame()`
+struct RenderTargetPoolStats {
+	uint32_t	targets;			// Declared
+	uint32_t	culled;				// Declared but never used, given no memory
+	uint32_t	aliased;			// Placed in a surface another of this frame's targets also uses
+	uint32_t	surfaces;			// Backing this frame's targets
+	uint32_t	surfacesCreated;
+	uint32_t	surfacesFreed;
+	size_t		requestedBytes;		// What the targets would take without aliasing
+	size_t		usedBytes;			// Surfaces backing this frame's targets
+	size_t		allocatedBytes;		// Every surface held, idle ones included
+	bool		overBudget;
+};
+
+// A transient target, rendered to as a frame buffer and sampled as a texture
+class RenderTarget final : public IFrameBuffer, public ITexture {
+public:
+	// Default Constructor
+	RenderTarget() = default;
+
+	// Destructor
+	~RenderTarget() noexcept override;
+
+	inline uint32_t width() const noexcept override { return mWidth; }
+	inline uint32_t height() const noexcept override { return mHeight; }
+	inline PixelFormat format() const noexcept override { return mFormat; }
+	inline const void* pixels() const noexcept override { return mPixels; }
+
+	inline void* data() noexcept { return mPixels; }
+	inline size_t stride() const noexcept { return mWidth * pixelFormatBytes(mFormat); }
+
+private:
+	friend class RenderTargetPool;
+
+	void*			mPixels	= nullptr;
+	uint32_t		mWidth	= 0;
+	uint32_t		mHeight	= 0;
+	PixelFormat		mFormat	= PixelFormat::ARGB8888;
+};
+
+//================================================================
+
+//
+// Memory for the intermediate targets of a frame (post effects,
+// render-to-texture), shared between targets that are never live at
+// the same time.
+//
+// Each frame the renderer declares the targets it wants and, for each
+// pass in execution order, the targets that pass reads or writes. A
+// target lives from its first use to its last. `compile()` then places
+// every target in a surface, largest first and best fit: any surface at
+// least as large whose other targets' lifetimes don't overlap, else a
+// new one. A target takes only the front of a larger surface, so a
+// half-resolution pass can sit in what a full-resolution one left.
+//
+// Surfaces outlive the frame and are reused by the next one, so a
+// steady frame allocates nothing. Those left idle for `idleFrames`
+// frames are freed, sooner when the budget is short.
+//
+// Contents are undefined when a target's lifetime starts; its first
+// pass must overwrite or clear it.
+//
+class RenderTargetPool {
+public:
+	static constexpr RenderTargetId INVALID = 0xFFFFFFFFU;
+
+	// Constructor
+	explicit RenderTargetPool(const RenderTargetPoolSettings& settings = {});
+
+	// Destructor
+	~RenderTargetPool() noexcept;
+
+	RenderTargetPool(const RenderTargetPool&) = delete;
+	RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+	// Drop the previous frame's targets, their surfaces stay pooled
+	void beginFrame();
+
+	// Drop this frame's targets to declare them again, the frame carries on
+	void redeclare() noexcept;
+
+	RenderTargetId declare(const RenderTargetDesc& desc);
+
+	// `pass` reads or writes the target, passes are numbered in execution order
+	void use(RenderTargetId id, uint32_t pass) noexcept;
+
+	//
+	// Place the declared targets. False when they don't fit the budget
+	// even after freeing idle surfaces; nothing is placed then and the
+	// frame can be declared again, cheaper, after `redeclare()`.
+	//
+	bool compile();
+
+	// Valid after a successful `compile()` until the next `beginFrame()`, nullptr for culled targets
+	RenderTarget* target(RenderTargetId id) noexcept;
+
+	// Free every surface this frame doesn't use
+	void trim();
+
+	void setSettings(const RenderTargetPoolSettings& settings) noexcept { mSettings = settings; }
+
+	constexpr inline const RenderTargetPoolSettings& settings() const noexcept { return mSettings; }
+	constexpr inline const RenderTargetPoolStats& stats() const noexcept { return mStats; }
+	constexpr inline size_t allocatedBytes() const noexcept { return mAllocatedBytes; }
+	constexpr inline size_t peakBytes() const noexcept { return mPeakBytes; }
+
+private:
+	// First and last pass of a lifetime, inclusive
+	struct Span {
+		uint32_t	first;
+		uint32_t	last;
+	};
+
+	struct Slot {
+		RenderTargetDesc	desc;
+		Span				life;
+		size_t				bytes;
+		uint32_t			surface;
+		RenderTarget		target;
+	};
+
+	struct Surface {
+		std::vector<uint32_t>	memory;
+		size_t					bytes;
+		uint64_t				lastUsed;
+		std::vector<Span>		busy;		// Lifetimes placed in it this frame
+	};
+
+	bool fits(const Surface& surface, size_t bytes, const Span& life) const noexcept;
+	void freeSurface(uint32_t index);
+
+	std::vector<Slot>			mSlots;
+	std::vector<Surface>		mSurfaces;
+	std::vector<uint32_t>		mOrder;
+	RenderTargetPoolSettings	mSettings;
+	RenderTargetPoolStats		mStats;
+	uint64_t					mFrame;
+	size_t						mAllocatedBytes;
+	size_t						mPeakBytes;
+	bool						mCompiled;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_RENDER_TARGET_POOL_HH
+//////////////////////////////////////////////////////////////////
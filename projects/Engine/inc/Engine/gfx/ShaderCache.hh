@@ -0,0 +1,142 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_SHADER_CACHE_HH
+#define DD25_ENGINE_GFX_SHADER_CACHE_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "IShader.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//================================================================
+
+// Backend compiler, source with `defines` prepended -> binary. Called from any thread.
+using ShaderCompileFn = std::function<bool(const std::string& source, const std::string& defines, std::vector<uint8_t>& binary)>;
+
+struct ShaderCacheStats {
+	uint32_t	requests;
+	uint32_t	memoryHits;
+	uint32_t	diskHits;
+	uint32_t	compiles;
+	uint32_t	failures;
+	uint32_t	diskWrites;
+	float		compileMs;		// Summed over threads
+	float		diskMs;
+};
+
+//================================================================
+
+//
+// Lazily built shader variants, one per (program, ShaderKey).
+//
+// `get()` returns the variant if it exists, otherwise exactly one caller
+// builds it while concurrent callers for the same variant wait, and
+// callers for other variants carry on. A build first looks in the disk
+// cache, files named by a hash of the program source, the permutation's
+// defines and the compiler version, so any edit to either misses and
+// recompiles; a warm cache never calls the compiler.
+//
+// `savePrewarmList()` writes every variant built this session, by
+// program name and key. `prewarm()` builds such a list up front on the
+// job system, so a recorded play session's shaders are ready before the
+// first frame instead of hitching on first use.
+//
+class ShaderCache {
+public:
+	static constexpr uint32_t INVALID_PROGRAM = 0xFFFFFFFFU;
+
+	// Constructor, `cacheDir` must exist; empty disables the disk cache
+	explicit ShaderCache(ShaderCompileFn compile, std::string cacheDir = {}, uint32_t compilerVersion = 0);
+
+	// Destructor
+	~ShaderCache() noexcept;
+
+	ShaderCache(const ShaderCache&) = delete;
+	ShaderCache& operator=(const ShaderCache&) = delete;
+
+	// Register a program before any `get()` for it, safe alongside `get()` on other threads
+	uint32_t addProgram(const char* name, std::string source);
+	uint32_t findProgram(const char* name) const noexcept;
+
+	// The variant, built on first use (thread safe); nullptr if compiling failed
+	const IShader* get(uint32_t program, ShaderKey key);
+
+	bool savePrewarmList(const char* path) const;
+
+	// Build every listed variant, returns how many are ready
+	size_t prewarm(const char* path);
+
+	// Disk cache file hash for a variant
+	static uint64_t variantHash(uint64_t sourceHash, const std::string& defines, uint32_t compilerVersion) noexcept;
+
+	ShaderCacheStats stats() const noexcept;
+
+private:
+	enum class State : uint8_t {
+		Building	= 0,
+		Ready		= 1,
+		Failed		= 2
+	};
+
+	class Variant final : public IShader {
+	public:
+		// Constructor
+		explicit Variant(ShaderKey key) noexcept : mKey(key) {}
+
+		// Destructor
+		~Variant() noexcept override;
+
+		inline ShaderKey key() const noexcept override { return mKey; }
+		inline const uint8_t* binary() const noexcept override { return mBinary.data(); }
+		inline size_t binarySize() const noexcept override { return mBinary.size(); }
+
+		ShaderKey				mKey;
+		std::vector<uint8_t>	mBinary;
+		State					mState	= State::Building;
+	};
+
+	struct Program {
+		std::string		name;
+		std::string		source;
+		uint64_t		sourceHash;
+	};
+
+	bool build(const Program& program, Variant& variant);
+	std::string cachePath(uint64_t hash) const;
+
+	ShaderCompileFn										mCompile;
+	std::string											mCacheDir;
+	uint32_t											mCompilerVersion;
+	std::deque<Program>									mPrograms;		// Deque keeps programs put while variants build from them
+	std::unordered_map<uint64_t, std::unique_ptr<Variant>>	mVariants;		// program << 32 | key
+	mutable std::mutex									mMutex;
+	std::condition_variable								mBuilt;
+
+	std::atomic<uint32_t>								mRequests;
+	std::atomic<uint32_t>								mMemoryHits;
+	std::atomic<uint32_t>								mDiskHits;
+	std::atomic<uint32_t>								mCompiles;
+	std::atomic<uint32_t>								mFailures;
+	std::atomic<uint32_t>								mDiskWrites;
+	std::atomic<uint64_t>								mCompileNs;
+	std::atomic<uint64_t>								mDiskNs;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_SHADER_CACHE_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,141 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_SPRITE_BATCH_HH
+#define DD25_ENGINE_GFX_SPRITE_BATCH_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "../core/RadixSort.hh"
+#include "../math/Geometry.hh"
+#include "ICommandQueue.hh"
+#include "ISprite.hh"
+#include "IVertexBuffer.hh"
+#include "StreamVertexBuffer.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+// One sprite to draw this frame
+struct SpriteInstance {
+	const ISprite*	sprite;
+	Float2			position;
+	Float2			size;						// World units
+	Float2			pivot		= { 0.5f, 0.5f };	// Placement and rotation origin, [0, 1] across `size`
+	float			rotation	= 0.0f;			// Radians, counter-clockwise
+	float			depth		= 0.0f;			// Vertex z
+	uint32_t		color		= 0xFFFFFFFFU;	// ARGB8888, modulates the texture
+	uint16_t		layer		= 0;			// Drawn in ascending order
+};
+
+// A run of sprites drawn with one texture, as vertices in the stream
+struct SpriteBatchRange {
+	const ITexture*	texture;
+	uint32_t		first;
+	uint32_t		count;
+};
+
+// Per-frame counters, reset by `SpriteBatch::begin()`
+struct SpriteBatchStats {
+	uint32_t	sprites;
+	uint32_t	dropped;		// Over capacity or without a sprite
+	uint32_t	batches;		// Draws submitted
+	uint32_t	merged;			// Layer / texture runs folded into the previous batch
+	uint32_t	vertices;
+	float		sortMs;
+	float		expandMs;
+};
+
+//================================================================
+
+//
+// Collects sprites for a frame and turns them into a few draws.
+//
+// `build()` orders sprites by layer, then by atlas page within a layer
+// (stable, so sprites sharing a page keep submission order), and expands
+// every sprite into two triangles written straight into one streaming
+// vertex buffer. Corners are rotated and scaled four sprites at a time
+// on the job system. Runs that share a page become one batch, including
+// runs on either side of a layer boundary.
+//
+// Sprites in one layer that use different pages may be drawn in either
+// order, use separate layers where overlap order matters. Given a
+// StreamVertexBuffer, vertices go into that frame's part of the ring;
+// otherwise into a buffer of the batch's own that the next `build()`
+// rewrites, so the frame must have executed before the batch is reused.
+//
+class SpriteBatch {
+public:
+	// Constructor, `stream` (optional) must outlive the batch
+	explicit SpriteBatch(uint32_t maxSprites = 8192U, StreamVertexBuffer* stream = nullptr);
+
+	// Destructor
+	~SpriteBatch() noexcept;
+
+	SpriteBatch(const SpriteBatch&) = delete;
+	SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+	// Start a new frame, drops every sprite
+	void begin();
+
+	// Queue a sprite, false when it was dropped
+	bool add(const SpriteInstance& instance);
+
+	// Sort, merge and write the vertex stream
+	void build();
+
+	//
+	// Record one draw per batch. Batches keep their order through the
+	// queue's sort via the depth field: back to front in the translucent
+	// list, front to back otherwise.
+	//
+	void submit(ICommandQueue& queue, uint8_t pass, RenderList list, const IMaterial* material = nullptr, uint32_t materialKey = 0) const;
+
+	inline const IVertexBuffer& vertices() const noexcept { return *mSource; }
+	inline size_t batchCount() const noexcept { return mBatches.size(); }
+	inline const SpriteBatchRange& batch(size_t index) const noexcept { return mBatches[index]; }
+
+	constexpr inline uint32_t capacity() const noexcept { return mCapacity; }
+	constexpr inline const SpriteBatchStats& stats() const noexcept { return mStats; }
+
+private:
+	// CPU side vertex stream shared by every batch
+	class Stream final : public IVertexBuffer {
+	public:
+		// Default Constructor
+		Stream() = default;
+
+		// Destructor
+		~Stream() noexcept override;
+
+		inline const GfxVertex* vertices() const noexcept override { return mVertices.data(); }
+		inline uint32_t vertexCount() const noexcept override { return mCount; }
+
+		std::vector<GfxVertex>	mVertices;
+		uint32_t				mCount	= 0;
+	};
+
+	uint16_t textureIndex(const ITexture* texture);
+
+	std::vector<SpriteInstance>		mSprites;
+	std::vector<SortPair>			mOrder;
+	std::vector<SortPair>			mScratch;
+	std::vector<const ITexture*>	mTextures;		// Sort key texture index -> texture
+	std::vector<SpriteBatchRange>	mBatches;
+	Stream							mStream;
+	StreamVertexBuffer*				mTarget;
+	const IVertexBuffer*			mSource;		// Where this frame's vertices went
+	uint32_t						mCapacity;
+	uint16_t						mLastTexture;
+	SpriteBatchStats				mStats;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_SPRITE_BATCH_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,107 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_STREAM_VERTEX_BUFFER_HH
+#define DD25_ENGINE_GFX_STREAM_VERTEX_BUFFER_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "IVertexBuffer.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+//================================================================
+
+// Per-frame counters, reset by `StreamVertexBuffer::beginFrame()`
+struct StreamVertexStats {
+	uint32_t	allocations;
+	uint32_t	failed;			// Larger than the frame could ever get
+	size_t		bytesStreamed;
+	uint32_t	wrapStalls;		// Waits for an in-flight frame to retire
+	size_t		peakBytes;		// Most bytes in flight at once, all frames so far
+	float		stallMs;
+};
+
+//================================================================
+
+//
+// Ring buffer for vertices rebuilt every frame (particles, sprites, UI,
+// skinning).
+//
+// Each frame sub-allocates linearly from where the previous one ended
+// and wraps to the start when it reaches the end. A frame's space comes
+// back once its fence, returned by `endFrame()`, has been passed to
+// `retire()` by whoever reads the vertices. At most `framesInFlight`
+// frames are live: `beginFrame()` waits for the oldest to retire, and an
+// allocation that would overrun an unretired frame waits for it too,
+// which is counted as a wrap stall. Sized for three frames of peak use,
+// neither ever waits.
+//
+// Allocations start on 32 bytes (a multiple of 4 vertices) so copies
+// can go out as whole, in-order store bursts, see `write()`. Any thread
+// may allocate between `beginFrame()` and `endFrame()`.
+//
+class StreamVertexBuffer final : public IVertexBuffer {
+public:
+	static constexpr size_t ALIGNMENT = 32U;
+	static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 4U;
+
+	// Constructor
+	explicit StreamVertexBuffer(uint32_t capacity, uint32_t framesInFlight = 3U);
+
+	// Destructor
+	~StreamVertexBuffer() noexcept override;
+
+	StreamVertexBuffer(const StreamVertexBuffer&) = delete;
+	StreamVertexBuffer& operator=(const StreamVertexBuffer&) = delete;
+
+	inline const GfxVertex* vertices() const noexcept override { return mData; }
+	inline uint32_t vertexCount() const noexcept override { return mCapacity; }
+
+	void beginFrame();
+
+	// Close the frame, returns its fence
+	uint64_t endFrame() noexcept;
+
+	// Every frame up to `fence` has been consumed (any thread)
+	void retire(uint64_t fence) noexcept;
+
+	// Space for `count` vertices, `first` receives the index of the first; nullptr on failure
+	GfxVertex* allocate(uint32_t count, uint32_t& first);
+
+	// Allocate and copy with aligned 16 byte stores in address order
+	bool write(const GfxVertex* src, uint32_t count, uint32_t& first);
+
+	constexpr inline uint32_t capacity() const noexcept { return mCapacity; }
+	constexpr inline uint32_t framesInFlight() const noexcept { return mFramesInFlight; }
+	constexpr inline const StreamVertexStats& stats() const noexcept { return mStats; }
+
+private:
+	// Ring position where the oldest unretired frame starts
+	uint64_t liveStart() const noexcept;
+	void waitRetired(uint64_t fence);
+
+	GfxVertex*					mData;
+	uint32_t					mCapacity;
+	uint32_t					mFramesInFlight;
+	uint64_t					mFrame;
+	uint64_t					mFrameStart[MAX_FRAMES_IN_FLIGHT];
+	std::atomic<uint64_t>		mHead;			// Vertices ever allocated, including wrap padding
+	std::atomic<uint64_t>		mRetired;
+	std::atomic<uint32_t>		mAllocations;
+	std::atomic<uint32_t>		mFailed;
+	std::atomic<uint32_t>		mStalls;
+	std::atomic<size_t>			mBytes;
+	std::atomic<size_t>			mPeak;
+	std::atomic<uint64_t>		mStallNs;
+	StreamVertexStats			mStats;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_STREAM_VERTEX_BUFFER_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,66 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_TEXTURE_ATLAS_HH
+#define DD25_ENGINE_GFX_TEXTURE_ATLAS_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "../math/Geometry.hh"
+#include "ITexture.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+//================================================================
+
+// Where a source image landed in an atlas, UVs on texel edges
+struct AtlasRect {
+	float		u0, v0;
+	float		u1, v1;
+	uint16_t	page;
+	uint16_t	flags;
+};
+
+// Map a UV in the source image's [0, 1] range onto its atlas page
+constexpr inline Float2 remapUv(const AtlasRect& rect, const Float2& uv) noexcept {
+	return { rect.u0 + (rect.u1 - rect.u0) * uv.x, rect.v0 + (rect.v1 - rect.v0) * uv.y };
+}
+
+//================================================================
+
+//
+// Atlas pages and the UV remap table built by the Editor's atlas
+// builder, indexed in source image order. Tilesets and sprites refer to
+// regions by index, so one page bind covers every region on it.
+//
+class TextureAtlas {
+public:
+	// Default Constructor
+	TextureAtlas() = default;
+
+	// Destructor
+	~TextureAtlas() noexcept = default;
+
+	inline void setPages(std::vector<const ITexture*> pages) { mPages = std::move(pages); }
+	inline void setRects(std::vector<AtlasRect> rects) { mRects = std::move(rects); }
+
+	inline size_t pageCount() const noexcept { return mPages.size(); }
+	inline size_t rectCount() const noexcept { return mRects.size(); }
+	inline const ITexture* page(uint16_t index) const noexcept { return mPages[index]; }
+	inline const AtlasRect& rect(uint32_t index) const noexcept { return mRects[index]; }
+	inline const ITexture* pageOf(uint32_t index) const noexcept { return mPages[mRects[index].page]; }
+
+private:
+	std::vector<const ITexture*>	mPages;
+	std::vector<AtlasRect>			mRects;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_TEXTURE_ATLAS_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,165 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_TEXTURE_CACHE_HH
+#define DD25_ENGINE_GFX_TEXTURE_CACHE_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "ITexture.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+//================================================================
+
+using TextureId = uint32_t;
+
+// System memory copy of a texture, every mip level down to the last given
+struct TextureSource {
+	uint32_t					width;
+	uint32_t					height;
+	PixelFormat					format;
+	std::vector<const void*>	levels;		// Level 0 first, must outlive the cache entry
+};
+
+struct TextureCacheSettings {
+	size_t		vramBudget				= 6U << 20;		// Textures' share of the 8 MB
+	size_t		uploadBytesPerFrame		= 256U << 10;
+	size_t		fallbackBytes			= 8U << 10;		// Largest mip uploaded ahead of other textures' full chains
+};
+
+// Per-frame counters, reset by `TextureCache::beginFrame()`
+struct TextureCacheStats {
+	uint32_t	requests;
+	uint32_t	misses;				// Requests for a texture that wasn't fully resident
+	uint32_t	evictions;
+	size_t		evictedBytes;
+	size_t		uploadBytes;
+	uint32_t	levelsCompleted;	// Mip levels that became usable
+	uint32_t	budgetDeferred;		// Uploads that couldn't start, everything evictable was in use
+	size_t		residentBytes;		// After the frame's uploads
+	uint32_t	residentTextures;
+};
+
+//================================================================
+
+//
+// VRAM residency for textures.
+//
+// `request()` marks a texture used this frame and returns what is
+// resident of it. Uploads are queued in request order and copied during
+// `endFrame()` in pieces, never more than `uploadBytesPerFrame` a frame,
+// so streaming in a large texture costs several frames instead of one
+// hitch. Mips upload smallest first: every queued texture first gets
+// the levels up to `fallbackBytes`, then full chains complete in
+// request order. The returned view always describes the finest
+// complete level, so textures show up blurry and sharpen.
+//
+// Space for the whole chain is reserved when its upload starts. When it
+// doesn't fit, the least recently used textures that were not requested
+// this frame are evicted; if that isn't enough the upload waits, without
+// holding back the textures queued behind it. A chain larger than the
+// whole budget is held from the finest level whose tail fits.
+//
+class TextureCache {
+public:
+	static constexpr TextureId INVALID = 0xFFFFFFFFU;
+
+	// Constructor
+	explicit TextureCache(const TextureCacheSettings& settings = {});
+
+	// Destructor
+	~TextureCache() noexcept;
+
+	TextureCache(const TextureCache&) = delete;
+	TextureCache& operator=(const TextureCache&) = delete;
+
+	TextureId add(const TextureSource& source);
+
+	// Evict and forget a texture, its id is not reused
+	void remove(TextureId id);
+
+	void beginFrame();
+
+	// Best resident version of `id`, nullptr until its smallest mip is in
+	const ITexture* request(TextureId id);
+
+	// Run this frame's uploads
+	void endFrame();
+
+	bool isResident(TextureId id) const noexcept;
+	void setSettings(const TextureCacheSettings& settings) noexcept { mSettings = settings; }
+
+	constexpr inline const TextureCacheSettings& settings() const noexcept { return mSettings; }
+	constexpr inline const TextureCacheStats& stats() const noexcept { return mStats; }
+	constexpr inline size_t residentBytes() const noexcept { return mResidentBytes; }
+	constexpr inline size_t peakResidentBytes() const noexcept { return mPeakResidentBytes; }
+
+private:
+	// The resident part of a texture, as the backends see it
+	class View final : public ITexture {
+	public:
+		// Default Constructor
+		View() = default;
+
+		// Destructor
+		~View() noexcept override;
+
+		inline uint32_t width() const noexcept override { return mWidth; }
+		inline uint32_t height() const noexcept override { return mHeight; }
+		inline PixelFormat format() const noexcept override { return mFormat; }
+		inline const void* pixels() const noexcept override { return mPixels; }
+
+		const void*		mPixels	= nullptr;
+		uint32_t		mWidth	= 0;
+		uint32_t		mHeight	= 0;
+		PixelFormat		mFormat	= PixelFormat::ARGB1555;
+	};
+
+	struct Entry {
+		TextureSource			source;
+		std::vector<size_t>		offsets;		// Per level, into vram
+		std::vector<uint8_t>	vram;			// Empty when not allocated
+		View					view;
+		size_t					chainBytes;
+		uint64_t				lastUsed;
+		uint32_t				baseLevel;		// Finest level vram holds, > 0 when the chain exceeds the budget
+		uint32_t				residentLevel;	// Finest complete level, == level count when none
+		uint32_t				uploadLevel;	// Level being copied
+		size_t					uploadOffset;	// Bytes of it done
+		uint32_t				prev;			// LRU list of allocated entries, most recent first
+		uint32_t				next;
+		bool					queued;
+		bool					removed;
+	};
+
+	size_t levelBytes(const Entry& e, uint32_t level) const noexcept;
+	uint32_t fallbackLevel(const Entry& e) const noexcept;
+	bool upload(TextureId id, uint32_t target, size_t& budget);
+	void updateView(Entry& e) noexcept;
+	void touch(TextureId id) noexcept;
+	void unlink(TextureId id) noexcept;
+	void evict(TextureId id) noexcept;
+	bool reserve(TextureId id);
+
+	std::deque<Entry>		mEntries;		// Deque keeps views at stable addresses
+	std::deque<TextureId>	mUploads;
+	TextureCacheSettings	mSettings;
+	TextureCacheStats		mStats;
+	uint64_t				mFrame;
+	size_t					mResidentBytes;
+	size_t					mPeakResidentBytes;
+	uint32_t				mResidentCount;
+	uint32_t				mHead;
+	uint32_t				mTail;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_TEXTURE_CACHE_HH
+//////////////////////////////////////////////////////////////////
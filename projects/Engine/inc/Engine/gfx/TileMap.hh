@@ -0,0 +1,186 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_TILE_MAP_HH
+#define DD25_ENGINE_GFX_TILE_MAP_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "../math/Geometry.hh"
+#include "ICommandQueue.hh"
+#include "ITileset.hh"
+#include "IVertexBuffer.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+//================================================================
+
+struct TileMapSettings {
+	uint32_t	chunkSize			= 32U;		// Tiles along a chunk edge
+	uint32_t	maxResidentChunks	= 32U;		// Baked chunks kept, visible ones are never dropped
+	Float2		tileSize			= { 16.0f, 16.0f };
+	Float2		origin				= { 0.0f, 0.0f };	// World position of tile (0, 0)'s top-left corner
+	float		depth				= 0.0f;		// Vertex z
+};
+
+// Per-frame counters, reset by `TileMap::draw()`
+struct TileMapStats {
+	uint32_t	visibleChunks;
+	uint32_t	chunksBaked;		// Built or rebuilt this frame
+	uint32_t	chunksEvicted;
+	uint32_t	residentChunks;
+	uint32_t	animatedPatched;	// Animated tiles whose UVs were rewritten
+	uint32_t	buffersRetired;		// Chunk vertices replaced while a frame in flight could draw them
+	uint32_t	draws;
+	uint32_t	vertices;			// In the submitted draws
+	float		bakeMs;
+	float		submitMs;
+};
+
+//================================================================
+
+//
+// One tile layer split into square chunks of baked geometry.
+//
+// A chunk's vertices are built the first time it becomes visible and
+// only rebuilt after one of its tiles changes, grouped by atlas page so
+// a chunk costs one draw per page it uses. Culling is a range lookup on
+// the chunk grid, so its cost follows the view rather than the map.
+// Chunks that scroll out of view stay baked until more than
+// `maxResidentChunks` exist, then the least recently visible go first;
+// a 4096x4096 map never holds more than a screen or two of geometry.
+//
+// Animated tiles keep a table of frame UVs. Advancing the clock only
+// rewrites the UVs of animated tiles in visible chunks, the positions
+// and every other tile stay as baked.
+//
+// Draws point at a chunk's vertex buffer, which frames still being
+// executed may read for FRAMES_IN_FLIGHT draws after recording it. A
+// buffer drawn that recently is never written or freed: rebaking or
+// animating the chunk moves it to a copy, and evicting it only retires
+// it. Retired buffers are reused once out of flight. Call `draw()` once
+// per frame.
+//
+class TileMap {
+public:
+	static constexpr uint16_t EMPTY = 0xFFFFU;
+	static constexpr uint32_t FRAMES_IN_FLIGHT = 3U;
+
+	// Constructor, every tile starts EMPTY
+	TileMap(const ITileset* tileset, uint32_t width, uint32_t height, const TileMapSettings& settings = {});
+
+	// Destructor
+	~TileMap() noexcept;
+
+	TileMap(const TileMap&) = delete;
+	TileMap& operator=(const TileMap&) = delete;
+
+	uint16_t tile(uint32_t x, uint32_t y) const noexcept;
+	void setTile(uint32_t x, uint32_t y, uint16_t tile) noexcept;
+
+	// Replace every tile, `tiles` holds width * height in row order
+	void setTiles(const uint16_t* tiles);
+
+	//
+	// Animate every occurrence of `frames[0]`, showing each frame for
+	// `frameSeconds`. Frames must be on the same atlas page as the first,
+	// others are skipped. Returns false if `frames[0]` is already animated.
+	//
+	bool addAnimation(const uint16_t* frames, uint32_t count, float frameSeconds);
+
+	// Advance the animation clock
+	inline void update(float seconds) noexcept { mTime += seconds; }
+
+	// Bake, animate and record the chunks overlapping the world rectangle [min, max]
+	void draw(ICommandQueue& queue, const Float2& viewMin, const Float2& viewMax, uint8_t pass, RenderList list, const IMaterial* material = nullptr, uint32_t materialKey = 0);
+
+	constexpr inline uint32_t width() const noexcept { return mWidth; }
+	constexpr inline uint32_t height() const noexcept { return mHeight; }
+	constexpr inline const TileMapSettings& settings() const noexcept { return mSettings; }
+	constexpr inline const TileMapStats& stats() const noexcept { return mStats; }
+
+private:
+	// Vertices of one page in a chunk
+	struct Range {
+		uint16_t	page;
+		uint32_t	first;
+		uint32_t	count;
+	};
+
+	// An animated tile's six vertices
+	struct AnimatedTile {
+		uint32_t	vertex;
+		uint16_t	animation;
+		uint16_t	frame;			// Frame the UVs currently show
+	};
+
+	struct Animation {
+		std::vector<AtlasRect>	frames;
+		float					frameSeconds;
+	};
+
+	// A chunk's vertices as draws see them, unchanged while in flight
+	class Buffer final : public IVertexBuffer {
+	public:
+		// Default Constructor
+		Buffer() = default;
+
+		// Destructor
+		~Buffer() noexcept override;
+
+		inline const GfxVertex* vertices() const noexcept override { return mVertices.data(); }
+		inline uint32_t vertexCount() const noexcept override { return static_cast<uint32_t>(mVertices.size()); }
+
+		std::vector<GfxVertex>		mVertices;
+		uint64_t					mLastDrawn		= 0;
+	};
+
+	struct Chunk {
+		std::unique_ptr<Buffer>		mBuffer;
+		std::vector<Range>			mRanges;
+		std::vector<AnimatedTile>	mAnimated;
+		uint64_t					mLastVisible	= 0;
+		bool						mBaked			= false;
+		bool						mDirty			= false;
+	};
+
+	// Recorded by one of the last FRAMES_IN_FLIGHT draws
+	inline bool inFlight(const Buffer& buffer) const noexcept { return buffer.mLastDrawn && buffer.mLastDrawn + FRAMES_IN_FLIGHT >= mFrame; }
+
+	// The chunk's buffer made safe to write, a copy of it when `keep` is set
+	Buffer& writable(Chunk& chunk, bool keep);
+	void retire(std::unique_ptr<Buffer> buffer);
+
+	void bake(uint32_t chunk);
+	void release(uint32_t chunk);
+	void animate(Chunk& chunk);
+
+	const ITileset*				mTileset;
+	TileMapSettings				mSettings;
+	uint32_t					mWidth;
+	uint32_t					mHeight;
+	uint32_t					mChunksX;
+	uint32_t					mChunksY;
+	std::vector<uint16_t>		mTiles;
+	std::vector<Chunk>			mChunks;
+	std::vector<std::unique_ptr<Buffer>>	mRetired;	// Replaced, reused once out of flight
+	std::vector<std::unique_ptr<Buffer>>	mSpare;
+	std::vector<uint32_t>		mResident;		// Baked chunk indices
+	std::vector<uint32_t>		mVisible;		// This frame's chunks
+	std::vector<uint32_t>		mToBake;
+	std::vector<uint16_t>		mTileAnimation;	// Per tileset tile, EMPTY when static
+	std::vector<Animation>		mAnimations;
+	float						mTime;
+	uint64_t					mFrame;
+	TileMapStats				mStats;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_TILE_MAP_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,135 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_VECTOR_CACHE_HH
+#define DD25_ENGINE_GFX_VECTOR_CACHE_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "ICommandQueue.hh"
+#include "IVertexBuffer.hh"
+#include "VectorPath.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+//================================================================
+
+//
+// Triangulate the inside of `path` (every contour taken as closed) by
+// ear clipping, holes bridged into their outer contour first; convex
+// contours without holes are fanned. Appends a triangle list in the
+// brush's colour at z = 0, returns the vertices added.
+//
+uint32_t tessellateFill(const VectorPath& path, const IBrush& brush, std::vector<GfxVertex>& out);
+
+//
+// Triangulate the outline of `path` as the pen draws it. Segments are
+// quads, joined and capped as the pen asks; triangles overlap on the
+// inside of joins, so translucent strokes darken there.
+//
+uint32_t tessellateStroke(const VectorPath& path, const IPen& pen, std::vector<GfxVertex>& out);
+
+//================================================================
+
+struct VectorCacheSettings {
+	size_t		maxVertices		= 64U << 10;	// Over this, meshes idle longest are dropped first
+	uint32_t	idleFrames		= 120U;			// Meshes unused this long are dropped
+};
+
+// Per-frame counters, reset by `VectorCache::beginFrame()`
+struct VectorCacheStats {
+	uint32_t	requests;
+	uint32_t	hits;
+	uint32_t	tessellated;
+	uint32_t	evicted;
+	uint32_t	meshes;				// Cached
+	size_t		vertices;			// Cached
+	float		tessellateMs;
+};
+
+//================================================================
+
+//
+// Tessellated vector shapes, kept between frames.
+//
+// Meshes are keyed by the path's hash and the style (brush colour, or
+// pen colour, width, join, cap and miter limit), so a shape is only
+// tessellated again when its path or style changes and a static one
+// costs a hash lookup. The returned buffer is drawn as a triangle list
+// with whatever transform places it, see `submit()`.
+//
+// A mesh stays valid for at least FRAMES_IN_FLIGHT frames after its
+// last request, so frames still being executed never lose their
+// vertices. `clear()` follows the same rule: it forgets every mesh at
+// once but frees them only when no frame in flight can draw them.
+//
+class VectorCache {
+public:
+	static constexpr uint32_t FRAMES_IN_FLIGHT = 3U;
+
+	// Constructor
+	explicit VectorCache(const VectorCacheSettings& settings = {});
+
+	// Destructor
+	~VectorCache() noexcept;
+
+	VectorCache(const VectorCache&) = delete;
+	VectorCache& operator=(const VectorCache&) = delete;
+
+	// Drop idle meshes
+	void beginFrame();
+
+	// nullptr when the shape has no area
+	const IVertexBuffer* fill(const VectorPath& path, const IBrush& brush);
+	const IVertexBuffer* stroke(const VectorPath& path, const IPen& pen);
+
+	// Record one draw of `mesh`; `transform` must stay valid until the frame has executed
+	static void submit(ICommandQueue& queue, const IVertexBuffer* mesh, const Float4x4* transform, uint64_t key, const IMaterial* material = nullptr);
+
+	// Tessellate everything again from the next request on
+	void clear();
+	void setSettings(const VectorCacheSettings& settings) noexcept { mSettings = settings; }
+
+	constexpr inline const VectorCacheSettings& settings() const noexcept { return mSettings; }
+	constexpr inline const VectorCacheStats& stats() const noexcept { return mStats; }
+
+private:
+	class Mesh final : public IVertexBuffer {
+	public:
+		// Default Constructor
+		Mesh() = default;
+
+		// Destructor
+		~Mesh() noexcept override;
+
+		inline const GfxVertex* vertices() const noexcept override { return mVertices.data(); }
+		inline uint32_t vertexCount() const noexcept override { return static_cast<uint32_t>(mVertices.size()); }
+
+		std::vector<GfxVertex>	mVertices;
+		uint64_t				mLastUsed	= 0;
+	};
+
+	// The cached mesh for `key`, or a new empty one to tessellate into
+	Mesh* find(uint64_t key, bool& created);
+
+	void evict(std::unordered_map<uint64_t, std::unique_ptr<Mesh>>::iterator it);
+
+	std::unordered_map<uint64_t, std::unique_ptr<Mesh>>	mMeshes;
+	std::vector<std::unique_ptr<Mesh>>					mRetired;		// Cleared, freed once out of flight
+	std::vector<uint64_t>								mScratch;
+	VectorCacheSettings									mSettings;
+	VectorCacheStats									mStats;
+	uint64_t											mFrame;
+	size_t												mVertices;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_VECTOR_CACHE_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,138 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_VECTOR_PATH_HH
+#define DD25_ENGINE_GFX_VECTOR_PATH_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "../math/Geometry.hh"
+#include "IBrush.hh"
+#include "IPen.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+// A flat colour fill
+class Brush final : public IBrush {
+public:
+	// Constructor
+	explicit Brush(uint32_t color = 0xFFFFFFFFU) noexcept : mColor(color) {}
+
+	// Destructor
+	~Brush() noexcept override;
+
+	inline uint32_t color() const noexcept override { return mColor; }
+
+	inline void setColor(uint32_t color) noexcept { mColor = color; }
+
+private:
+	uint32_t	mColor;
+};
+
+class Pen final : public IPen {
+public:
+	// Constructor
+	explicit Pen(uint32_t color = 0xFFFFFFFFU, float width = 1.0f) noexcept
+		: mColor(color)
+		, mWidth(width) {}
+
+	// Destructor
+	~Pen() noexcept override;
+
+	inline uint32_t color() const noexcept override { return mColor; }
+	inline float width() const noexcept override { return mWidth; }
+	inline LineJoin join() const noexcept override { return mJoin; }
+	inline LineCap cap() const noexcept override { return mCap; }
+	inline float miterLimit() const noexcept override { return mMiterLimit; }
+
+	inline void setColor(uint32_t color) noexcept { mColor = color; }
+	inline void setWidth(float width) noexcept { mWidth = width; }
+	inline void setJoin(LineJoin join) noexcept { mJoin = join; }
+	inline void setCap(LineCap cap) noexcept { mCap = cap; }
+	inline void setMiterLimit(float limit) noexcept { mMiterLimit = limit; }
+
+private:
+	uint32_t	mColor;
+	float		mWidth;
+	LineJoin	mJoin		= LineJoin::Miter;
+	LineCap		mCap		= LineCap::Butt;
+	float		mMiterLimit	= 4.0f;
+};
+
+//================================================================
+
+// A run of flattened points, see `VectorPath::flatten()`
+struct VectorContour {
+	uint32_t	first;
+	uint32_t	count;
+	bool		closed;
+};
+
+//
+// 2D outline made of lines and quadratic / cubic Beziers, in any units
+// (pixels for UI). Several contours may make up one path. For filling,
+// contours must not cross; one wound against the outermost contour that
+// contains it cuts a hole.
+//
+// The hash covers every command and the flattening tolerance and is
+// updated as commands are added, so it costs nothing to ask for; equal
+// hashes mean equal tessellation.
+//
+class VectorPath {
+public:
+	// Default Constructor
+	VectorPath() = default;
+
+	// Destructor
+	~VectorPath() noexcept = default;
+
+	void clear() noexcept;
+
+	void moveTo(const Float2& p);
+	void lineTo(const Float2& p);
+	void quadTo(const Float2& control, const Float2& p);
+	void cubicTo(const Float2& control0, const Float2& control1, const Float2& p);
+	void close();
+
+	// Closed contours, counter-clockwise with y up
+	void rect(const Float2& min, const Float2& size);
+	void roundedRect(const Float2& min, const Float2& size, float radius);
+	void ellipse(const Float2& center, const Float2& radii);
+
+	// Furthest a flattened curve strays from the true one
+	inline void setTolerance(float tolerance) noexcept { mTolerance = tolerance; }
+
+	// Curves as line segments, appended to `points`
+	void flatten(std::vector<Float2>& points, std::vector<VectorContour>& contours) const;
+
+	uint64_t hash() const noexcept;
+	constexpr inline float tolerance() const noexcept { return mTolerance; }
+	inline bool empty() const noexcept { return mVerbs.empty(); }
+
+private:
+	enum class Verb : uint8_t {
+		Move	= 0,
+		Line	= 1,
+		Quad	= 2,
+		Cubic	= 3,
+		Close	= 4
+	};
+
+	void append(Verb verb, const Float2* points, uint32_t count);
+
+	std::vector<Verb>		mVerbs;
+	std::vector<Float2>		mPoints;
+	float					mTolerance	= 0.25f;
+	uint64_t				mHash		= 14695981039346656037ULL;		// FNV-1a over the commands so far
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_VECTOR_PATH_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,180 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_VERTEX_LIGHTING_HH
+#define DD25_ENGINE_GFX_VERTEX_LIGHTING_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "../math/Geometry.hh"
+#include "ILight.hh"
+#include "IVertexBuffer.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+class VertexLighting;
+
+//================================================================
+
+// A light owned by game code
+class Light final : public ILight {
+public:
+	// Constructor
+	explicit Light(LightType type = LightType::Point, bool isStatic = false) noexcept
+		: mType(type)
+		, mStatic(isStatic) {}
+
+	// Destructor
+	~Light() noexcept override;
+
+	inline LightType type() const noexcept override { return mType; }
+	inline Float3 color() const noexcept override { return mColor; }
+	inline Float3 position() const noexcept override { return mPosition; }
+	inline Float3 direction() const noexcept override { return mDirection; }
+	inline float range() const noexcept override { return mRange; }
+	inline float innerCone() const noexcept override { return mInner; }
+	inline float outerCone() const noexcept override { return mOuter; }
+	inline bool isStatic() const noexcept override { return mStatic; }
+
+	inline void setColor(const Float3& color) noexcept { mColor = color; }
+	inline void setPosition(const Float3& position) noexcept { mPosition = position; }
+	inline void setDirection(const Float3& direction) noexcept { mDirection = normalize(direction); }
+	inline void setRange(float range) noexcept { mRange = range; }
+
+	// Half angles in radians
+	void setCone(float inner, float outer) noexcept;
+
+private:
+	LightType	mType;
+	bool		mStatic;
+	Float3		mColor		= { 1.0f, 1.0f, 1.0f };
+	Float3		mPosition	= { 0.0f, 0.0f, 0.0f };
+	Float3		mDirection	= { 0.0f, -1.0f, 0.0f };
+	float		mRange		= 10.0f;
+	float		mInner		= 0.9f;
+	float		mOuter		= 0.8f;
+};
+
+// Unlit mesh data, object space
+struct VertexLightingMesh {
+	const Float3*	positions;
+	const Float3*	normals;
+	const uint32_t*	colors;			// ARGB8888 base colours, nullptr for white
+	uint32_t		vertexCount;
+};
+
+//
+// Per-object lighting cache for objects that rarely move. Holds the
+// world-space mesh and the light from static lights, rebuilt whenever
+// the static lights reaching the object, its mesh or its placement
+// change. Call `invalidate()` if the mesh is edited in place.
+//
+class VertexLightCache {
+public:
+	// Default Constructor
+	VertexLightCache() = default;
+
+	// Destructor
+	~VertexLightCache() noexcept = default;
+
+	inline void invalidate() noexcept { mKey = 0; }
+
+	inline size_t sizeBytes() const noexcept { return mData.size() * sizeof(float); }
+
+private:
+	friend class VertexLighting;
+
+	std::vector<float>	mData;		// Per 4 vertices: px, py, pz, nx, ny, nz, r, g, b (x4 lanes)
+	uint64_t			mKey	= 0;
+};
+
+// Per-frame counters, reset by `VertexLighting::beginFrame()`
+struct VertexLightingStats {
+	uint32_t	lights;
+	uint32_t	objects;
+	uint32_t	lightsCulled;		// Light / object pairs rejected by bounds
+	uint32_t	lightsDropped;		// Over MAX_LIGHTS_PER_OBJECT, weakest first
+	uint32_t	verticesLit;		// Transformed and lit this frame
+	uint32_t	verticesCached;		// Written straight from a cache, no light evaluated
+	uint32_t	cacheRebuilds;
+	float		lightMs;
+};
+
+//================================================================
+
+//
+// CPU vertex lighting, the PowerVR has no per-pixel lighting.
+//
+// Lights are collected each frame. Every object is lit by at most
+// MAX_LIGHTS_PER_OBJECT of them: those whose range misses the object's
+// bounds (or whose cone misses them, for spots) are culled, and the
+// rest ranked by their strength at the bounds. Vertices are transformed
+// and lit four at a time in SIMD, the lights for the whole mesh applied
+// in one pass, and written as modulated ARGB vertex colours.
+//
+// Objects given a VertexLightCache keep their world-space vertices and
+// the light from static lights between frames. While the same static
+// lights reach them, only dynamic lights and ambient are evaluated, and
+// with no dynamic light, colours are written straight from the cache.
+//
+class VertexLighting {
+public:
+	static constexpr uint32_t MAX_LIGHTS_PER_OBJECT = 4U;
+	static constexpr uint32_t MAX_FRAME_LIGHTS = 256U;
+
+	// Default Constructor
+	VertexLighting() = default;
+
+	// Destructor
+	~VertexLighting() noexcept;
+
+	VertexLighting(const VertexLighting&) = delete;
+	VertexLighting& operator=(const VertexLighting&) = delete;
+
+	// Start a new frame, drops every light
+	void beginFrame(const Float3& ambient = { 0.0f, 0.0f, 0.0f });
+
+	// False once MAX_FRAME_LIGHTS are collected; `light` must live until the frame ends
+	bool addLight(const ILight* light);
+
+	//
+	// Light `mesh` placed by `world` (rotation and uniform scale) into
+	// the colours of `out`, one vertex per mesh vertex; only `color` is
+	// written. `bounds` is the world-space box used for culling.
+	//
+	void light(const VertexLightingMesh& mesh, const Float4x4& world, const Aabb& bounds, GfxVertex* out, VertexLightCache* cache = nullptr);
+
+	constexpr inline const VertexLightingStats& stats() const noexcept { return mStats; }
+
+private:
+	// A collected light in the form the kernel wants
+	struct Source {
+		LightType	type;
+		bool		isStatic;
+		uint64_t	hash;			// Every parameter, keys the caches it lights
+		Float3		color;
+		Float3		position;
+		Float3		direction;
+		float		range;
+		float		invRange2;
+		float		spotScale;		// Cone falloff is cos * spotScale + spotBias, clamped to [0, 1]
+		float		spotBias;
+		float		sinOuter;
+		float		cosOuter;
+	};
+
+	uint32_t select(const Aabb& bounds, uint32_t (&picked)[MAX_LIGHTS_PER_OBJECT]);
+
+	std::vector<Source>		mSources;
+	Float3					mAmbient	= { 0.0f, 0.0f, 0.0f };
+	VertexLightingStats		mStats		= {};
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_VERTEX_LIGHTING_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,124 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_VIEWPORT_HH
+#define DD25_ENGINE_GFX_VIEWPORT_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "IViewport.hh"
+
+#include <cstdint>
+#include <cstddef>
+
+//================================================================
+
+enum class UpscaleFilter : uint8_t {
+	Nearest		= 0,
+	Bilinear	= 1
+};
+
+//
+// Stretch an ARGB8888 image over another, strides in bytes. Bilinear
+// samples at pixel centres with 8-bit weights, two channels per
+// multiply, blending the two source rows first and then across; rows
+// run on the job system. Equal sizes copy.
+//
+void upscaleArgb(const uint32_t* src, uint32_t srcWidth, uint32_t srcHeight, size_t srcStride,
+	uint32_t* dst, uint32_t dstWidth, uint32_t dstHeight, size_t dstStride, UpscaleFilter filter);
+
+//================================================================
+
+struct ViewportSettings {
+	float			budgetMs		= 16.6f;	// Frame time to hold, 60 Hz
+	float			minScale		= 0.5f;
+	float			maxScale		= 1.0f;
+	float			dropAbove		= 0.95f;	// Of the budget: over this on average, scale down at once
+	float			raiseBelow		= 0.75f;	// Of the budget: under this for `raiseFrames` in a row, scale up a step
+	uint32_t		raiseFrames		= 30U;
+	float			raiseStep		= 0.05f;
+	float			smoothing		= 0.2f;		// Weight of the newest frame in the running average
+	UpscaleFilter	filter			= UpscaleFilter::Bilinear;
+};
+
+// One frame as `Viewport::update()` saw it
+struct ViewportSample {
+	float	frameMs;
+	float	averageMs;
+	float	scale;			// Chosen for the next frame
+};
+
+//================================================================
+
+//
+// Viewport with dynamic resolution.
+//
+// Feed `update()` the measured render time of every frame (GPU time
+// where there is one, the CPU's raster time on the software backend).
+// The time is smoothed, and the scale reacts with hysteresis: when the
+// average passes `dropAbove` of the budget the scale falls straight to
+// what should land mid-band (pixel cost taken as proportional to area),
+// while rising takes `raiseFrames` calm frames and a small step that is
+// predicted to stay under `dropAbove`. Between the two thresholds
+// nothing changes, so the scale settles instead of oscillating.
+//
+// The last TRACE_LENGTH frames are kept for graphs and logs.
+//
+class Viewport final : public IViewport {
+public:
+	static constexpr uint32_t TRACE_LENGTH = 256U;
+
+	// Constructor
+	Viewport(uint32_t width, uint32_t height, const ViewportSettings& settings = {});
+
+	// Destructor
+	~Viewport() noexcept override;
+
+	inline uint32_t width() const noexcept override { return mWidth; }
+	inline uint32_t height() const noexcept override { return mHeight; }
+	inline float renderScale() const noexcept override { return mScale; }
+	inline uint32_t renderWidth() const noexcept override { return mRenderWidth; }
+	inline uint32_t renderHeight() const noexcept override { return mRenderHeight; }
+
+	void resize(uint32_t width, uint32_t height) noexcept;
+
+	// Fix the scale (clamped to the settings), the average restarts
+	void setScale(float scale) noexcept;
+
+	// Account a frame, true when the render size changed
+	bool update(float frameMs) noexcept;
+
+	// Upscale a frame rendered at the render size to the output
+	void present(const uint32_t* rendered, size_t renderedStride, uint32_t* output, size_t outputStride) const;
+
+	void setSettings(const ViewportSettings& settings) noexcept;
+
+	constexpr inline const ViewportSettings& settings() const noexcept { return mSettings; }
+	constexpr inline float averageMs() const noexcept { return mAverage; }
+
+	// `age` 0 is the latest frame, up to `traceCount()` - 1
+	inline uint32_t traceCount() const noexcept { return mTraceCount; }
+	inline const ViewportSample& trace(uint32_t age) const noexcept { return mTrace[(mTraceHead + TRACE_LENGTH - 1U - age) % TRACE_LENGTH]; }
+
+private:
+	void applyScale(float scale) noexcept;
+
+	ViewportSettings	mSettings;
+	ViewportSample		mTrace[TRACE_LENGTH];
+	uint32_t			mTraceHead;
+	uint32_t			mTraceCount;
+	uint32_t			mWidth;
+	uint32_t			mHeight;
+	uint32_t			mRenderWidth;
+	uint32_t			mRenderHeight;
+	uint32_t			mCalmFrames;
+	float				mScale;
+	float				mAverage;		// 0 until the first frame
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_VIEWPORT_HH
+//////////////////////////////////////////////////////////////////
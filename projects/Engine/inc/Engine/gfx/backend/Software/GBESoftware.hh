@@ -0,0 +1,138 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_BACKEND_SOFTWARE_HH
+#define DD25_ENGINE_GFX_BACKEND_SOFTWARE_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../../IGfxBackend.hh"
+#include "../../../math/Geometry.hh"
+#include "SoftwareFrameBuffer.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+// Per-frame counters, reset by `GBESoftware::beginFrame()`
+struct SoftwareRasterStats {
+	uint32_t	draws;
+	uint32_t	trianglesSubmitted;
+	uint32_t	trianglesBinned;	// Survived clipping and off-screen rejection
+	uint32_t	binEntries;			// Triangle / tile pairs
+	uint32_t	tilesRendered;		// Tiles with at least one triangle
+	uint64_t	fragments;			// Pixels that passed the depth and alpha tests
+	float		binMs;				// Transform, clip, set up and bin, summed over draws
+	float		rasterMs;			// Tile rendering and write-out
+};
+
+//================================================================
+
+//
+// Headless software backend emulating the PowerVR's tile based deferred
+// renderer. Draws are transformed, near-clipped and set up as they are
+// submitted, then binned into TILE_WIDTH x TILE_HEIGHT screen tiles.
+// `endFrame()` renders each tile as a job: colour and depth stay in
+// tile-local memory (the on-chip tile buffer) while the bin is
+// processed in submission order, and the tile is written out once.
+//
+// Coverage and depth are evaluated four pixels at a time with SIMD edge
+// functions and a top-left fill rule. Texturing is point sampled with
+// wrapping from ARGB1555, RGB565, ARGB4444 or ARGB8888 texels,
+// modulated by the perspective-correct vertex colour. The render list
+// selects the blend: opaque, punch-through (alpha test at 128) or
+// translucent (source alpha, no depth write).
+//
+// Every pixel is owned by a single tile and tiles never share state, so
+// the output is bit-identical for any thread count.
+//
+class GBESoftware final : public IGfxBackend {
+public:
+	static constexpr uint32_t TILE_WIDTH	= 32U;
+	static constexpr uint32_t TILE_HEIGHT	= 32U;
+
+	// Default Constructor
+	GBESoftware();
+
+	// Destructor
+	~GBESoftware() noexcept override;
+
+	// Start a frame rendering into `target`, cleared to `clearColor` (ARGB8888)
+	void beginFrame(SoftwareFrameBuffer& target, uint32_t clearColor);
+
+	// World -> clip transform for the following draws
+	inline void setViewProjection(const Float4x4& viewProj) noexcept { mViewProj = viewProj; }
+
+	// Render every tile and write the frame to the target
+	void endFrame();
+
+	void setPass(uint8_t pass) override;
+	void setRenderList(RenderList list) override;
+	void bindMaterial(const IMaterial* material) override;
+	void bindTexture(const ITexture* texture) override;
+	void bindVertexBuffer(const IVertexBuffer* vertices) override;
+	void draw(const DrawCommand& cmd) override;
+
+	constexpr inline const SoftwareRasterStats& stats() const noexcept { return mStats; }
+
+private:
+	// Clip-space vertex with its attributes
+	struct ClipVertex {
+		float		x, y, z, w;
+		float		u, v;
+		float		r, g, b, a;
+	};
+
+	// Screen-space plane, f = dx * x + dy * y + c at pixel centres
+	struct Gradient {
+		float		dx, dy, c;
+	};
+
+	struct SetupTri {
+		float		edgeA[3];
+		float		edgeB[3];
+		float		edgeC[3];
+		Gradient	z;
+		Gradient	invW;
+		Gradient	attr[6];	// u, v, r, g, b, a, all divided by w
+		int32_t		x0, y0;		// Pixel bounds, inclusive
+		int32_t		x1, y1;
+		uint32_t	topLeft;	// Bit per edge
+		uint32_t	state;
+	};
+
+	struct DrawState {
+		const ITexture*	texture;
+		RenderList		list;
+	};
+
+	void setupTriangle(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c);
+	void clipTriangle(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c);
+	void rasterizeTile(uint32_t tile) noexcept;
+
+	std::vector<SetupTri>				mTris;
+	std::vector<DrawState>				mStates;
+	std::vector<std::vector<uint32_t>>	mTileBins;
+	std::vector<uint64_t>				mTileFragments;
+	std::vector<ClipVertex>				mClip;
+	SoftwareFrameBuffer*				mTarget;
+	Float4x4							mViewProj;
+	const IMaterial*					mMaterial;
+	const ITexture*						mTexture;
+	const IVertexBuffer*				mVertices;
+	RenderList							mList;
+	uint8_t								mPass;
+	bool								mStateDirty;
+	uint32_t							mClearColor;
+	uint32_t							mTilesX;
+	uint32_t							mTilesY;
+	SoftwareRasterStats					mStats;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_BACKEND_SOFTWARE_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,53 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_BACKEND_SOFTWARE_FRAME_BUFFER_HH
+#define DD25_ENGINE_GFX_BACKEND_SOFTWARE_FRAME_BUFFER_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../../IFrameBuffer.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+// ARGB8888 colour buffer in system memory, the target of GBESoftware
+class SoftwareFrameBuffer final : public IFrameBuffer {
+public:
+	// Constructor
+	SoftwareFrameBuffer(uint32_t width, uint32_t height);
+
+	// Destructor
+	~SoftwareFrameBuffer() noexcept override;
+
+	void resize(uint32_t width, uint32_t height);
+	void clear(uint32_t color) noexcept;
+
+	//
+	// FNV-1a over the pixels. Rendering is deterministic regardless of
+	// thread count, so golden-image tests can compare hashes.
+	//
+	uint64_t hash() const noexcept;
+
+	inline uint32_t width() const noexcept override { return mWidth; }
+	inline uint32_t height() const noexcept override { return mHeight; }
+	inline PixelFormat format() const noexcept override { return PixelFormat::ARGB8888; }
+
+	inline uint32_t* pixels() noexcept { return mPixels.data(); }
+	inline const uint32_t* pixels() const noexcept { return mPixels.data(); }
+	inline uint32_t pixel(uint32_t x, uint32_t y) const noexcept { return mPixels[static_cast<size_t>(y) * mWidth + x]; }
+
+private:
+	std::vector<uint32_t>	mPixels;
+	uint32_t				mWidth;
+	uint32_t				mHeight;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_BACKEND_SOFTWARE_FRAME_BUFFER_HH
+//////////////////////////////////////////////////////////////////
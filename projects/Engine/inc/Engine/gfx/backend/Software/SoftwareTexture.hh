@@ -0,0 +1,46 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_BACKEND_SOFTWARE_TEXTURE_HH
+#define DD25_ENGINE_GFX_BACKEND_SOFTWARE_TEXTURE_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../../ITexture.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+// Texture held in system memory, linear row order
+class SoftwareTexture final : public ITexture {
+public:
+	// Constructor, `pixels` (optional) is copied
+	SoftwareTexture(uint32_t width, uint32_t height, PixelFormat format, const void* pixels = nullptr);
+
+	// Destructor
+	~SoftwareTexture() noexcept override;
+
+	inline uint32_t width() const noexcept override { return mWidth; }
+	inline uint32_t height() const noexcept override { return mHeight; }
+	inline PixelFormat format() const noexcept override { return mFormat; }
+	inline const void* pixels() const noexcept override { return mPixels.data(); }
+
+	inline uint8_t* data() noexcept { return mPixels.data(); }
+	inline size_t sizeBytes() const noexcept { return mPixels.size(); }
+	constexpr inline size_t stride() const noexcept { return mWidth * pixelFormatBytes(mFormat); }
+
+private:
+	std::vector<uint8_t>	mPixels;
+	uint32_t				mWidth;
+	uint32_t				mHeight;
+	PixelFormat				mFormat;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_BACKEND_SOFTWARE_TEXTURE_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,38 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_GFX_BACKEND_SOFTWARE_VERTEX_BUFFER_HH
+#define DD25_ENGINE_GFX_BACKEND_SOFTWARE_VERTEX_BUFFER_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../../IVertexBuffer.hh"
+
+#include <cstdint>
+#include <vector>
+
+//================================================================
+
+// Vertex buffer held in system memory
+class SoftwareVertexBuffer final : public IVertexBuffer {
+public:
+	// Constructor, `vertices` (optional) is copied
+	explicit SoftwareVertexBuffer(uint32_t count, const GfxVertex* vertices = nullptr);
+
+	// Destructor
+	~SoftwareVertexBuffer() noexcept override;
+
+	inline const GfxVertex* vertices() const noexcept override { return mVertices.data(); }
+	inline uint32_t vertexCount() const noexcept override { return static_cast<uint32_t>(mVertices.size()); }
+
+	inline GfxVertex* data() noexcept { return mVertices.data(); }
+
+private:
+	std::vector<GfxVertex>	mVertices;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_GFX_BACKEND_SOFTWARE_VERTEX_BUFFER_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,165 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_IO_CAPTURE_FILE_HH
+#define DD25_ENGINE_IO_CAPTURE_FILE_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "../gfx/IMaterial.hh"
+#include "../math/Geometry.hh"
+#include "MappedFile.hh"
+
+#include <cstdint>
+#include <cstddef>
+
+//================================================================
+// On-disk layout (little-endian), one captured frame
+//
+//   CaptureFileHeader
+//   CaptureSectionEntry[sectionCount]
+//   sections...          (each starts on a CAPTURE_FILE_ALIGNMENT boundary)
+//
+// Same scheme as scene files: flat arrays of fixed-size records that
+// refer to each other by index, never by pointer. Resources are stored
+// once however many draws use them, and of each vertex buffer only the
+// span the frame's draws touched.
+//================================================================
+
+constexpr uint32_t CAPTURE_FILE_MAGIC		= 0x51434444U;	// "DDCQ"
+constexpr uint16_t CAPTURE_FILE_VERSION		= 1U;			// Bump on any layout change
+constexpr size_t   CAPTURE_FILE_ALIGNMENT	= MappedFile::ALIGNMENT;
+constexpr uint32_t CAPTURE_NONE				= 0xFFFFFFFFU;	// Index standing in for nullptr
+
+enum class CaptureSection : uint32_t {
+	Frame			= 0,	// CaptureFrameRecord, exactly one
+	Draws			= 1,	// CaptureDrawRecord[], in queue order
+	Buffers			= 2,	// CaptureBufferRecord[]
+	Vertices		= 3,	// GfxVertex[], every buffer's span back to back
+	Textures		= 4,	// CaptureTextureRecord[]
+	Texels			= 5,	// uint8_t[], each texture on an aligned offset
+	Materials		= 6,	// CaptureMaterialRecord[]
+	Transforms		= 7,	// Float4x4[]
+
+	Count
+};
+
+struct CaptureFileHeader {
+	uint32_t	magic;
+	uint16_t	version;
+	uint16_t	sectionCount;
+	uint32_t	fileSize;
+	uint32_t	flags;			// Reserved, 0
+};
+
+struct CaptureSectionEntry {
+	uint32_t	type;			// CaptureSection
+	uint32_t	offset;			// From the start of the file
+	uint32_t	size;			// Bytes
+	uint32_t	count;			// Records
+};
+
+// What the frame was drawn with besides its commands
+struct CaptureFrameRecord {
+	Float4x4	viewProjection;
+	uint64_t	frame;
+	uint32_t	width;			// Target size in pixels
+	uint32_t	height;
+	uint32_t	clearColor;		// ARGB8888
+	uint32_t	dropped;		// Draws the queue had lost before capture
+};
+
+struct CaptureDrawRecord {
+	uint64_t	key;
+	uint32_t	material;		// Into Materials, or CAPTURE_NONE
+	uint32_t	texture;		// Into Textures, or CAPTURE_NONE
+	uint32_t	buffer;			// Into Buffers, or CAPTURE_NONE
+	uint32_t	transform;		// Into Transforms, or CAPTURE_NONE (identity)
+	uint32_t	first;			// Relative to the buffer's captured span
+	uint32_t	count;
+	uint32_t	primitive;		// Primitive
+	uint32_t	reserved;
+};
+
+struct CaptureBufferRecord {
+	uint32_t	firstVertex;	// Into Vertices
+	uint32_t	vertexCount;	// Captured span, 0 when the buffer had no CPU copy
+	uint32_t	base;			// Source index of the span's first vertex
+	uint32_t	sourceCount;	// Size of the source buffer
+};
+
+struct CaptureTextureRecord {
+	uint32_t	width;
+	uint32_t	height;
+	uint32_t	format;			// PixelFormat
+	uint32_t	offset;			// Into Texels
+	uint32_t	size;			// Bytes, 0 when the texture had no CPU copy
+};
+
+struct CaptureMaterialRecord {
+	uint32_t		shader;
+	uint32_t		sortKey;
+	uint8_t			list;			// The PipelineState fields, one byte each
+	uint8_t			srcBlend;
+	uint8_t			dstBlend;
+	uint8_t			depthCompare;
+	uint8_t			depthWrite;
+	uint8_t			cull;
+	uint8_t			filter;
+	uint8_t			wrapU;
+	uint8_t			wrapV;
+	uint8_t			shading;
+	uint8_t			fog;
+	uint8_t			reserved;
+	MaterialParams	params;
+};
+
+//================================================================
+
+//
+// A validated capture file, read the same way as SceneFile: `section()`
+// points straight into the file's memory.
+//
+class CaptureFile {
+public:
+	// Default Constructor
+	CaptureFile() = default;
+
+	// Destructor
+	~CaptureFile() noexcept = default;
+
+	// Map (or read, `map` = false) and validate `path`
+	bool open(const char* path, bool map = true);
+
+	void close() noexcept;
+
+	constexpr inline bool isOpen() const noexcept { return mFile.isOpen(); }
+	constexpr inline const MappedFile& file() const noexcept { return mFile; }
+
+	// Section contents as an array of T, nullptr (count 0) when absent
+	template <typename T>
+	inline const T* section(CaptureSection type, size_t& count) const noexcept {
+		const CaptureSectionEntry* e = find(type);
+		if (!e || e->count == 0 || e->size < static_cast<size_t>(e->count) * sizeof(T)) {
+			count = 0;
+			return nullptr;
+		}
+		count = e->count;
+		return reinterpret_cast<const T*>(mFile.data() + e->offset);
+	}
+
+private:
+	const CaptureSectionEntry* find(CaptureSection type) const noexcept;
+	bool validate() const noexcept;
+
+	MappedFile					mFile;
+	const CaptureSectionEntry*	mSections	= nullptr;
+	size_t						mCount		= 0;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_IO_CAPTURE_FILE_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,63 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_IO_MAPPED_FILE_HH
+#define DD25_ENGINE_IO_MAPPED_FILE_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+
+#include <cstdint>
+#include <cstddef>
+
+//================================================================
+
+//
+// Read-only view of a whole file in memory.
+//
+// Desktop targets map the file copy-on-write (pages load on first touch,
+// in-place fixups never reach the disk). Where mapping isn't available
+// (Dreamcast CD-ROM) the file is read with one read into a block aligned
+// to MappedFile::ALIGNMENT, so cooked data can be used in place either way.
+//
+class MappedFile {
+public:
+	static constexpr size_t ALIGNMENT = 32U;
+
+	// Default Constructor
+	MappedFile() = default;
+
+	// Destructor
+	~MappedFile() noexcept;
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Move Constructor
+	MappedFile(MappedFile&& other) noexcept;
+
+	// Move Assignment Operator
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	// `map` = false always reads the whole file up front (no page faults later)
+	bool open(const char* path, bool map = true);
+	void close() noexcept;
+
+	constexpr inline bool isOpen() const noexcept { return mData != nullptr; }
+	constexpr inline bool isMapped() const noexcept { return mMapped; }
+	constexpr inline uint8_t* data() const noexcept { return mData; }
+	constexpr inline size_t size() const noexcept { return mSize; }
+
+private:
+	uint8_t*	mData		= nullptr;
+	size_t		mSize		= 0;
+	bool		mMapped		= false;	// Mapping (true) or aligned heap block (false)
+	void*		mHandle		= nullptr;	// Platform mapping handle (Windows)
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_IO_MAPPED_FILE_HH
+//////////////////////////////////////////////////////////////////
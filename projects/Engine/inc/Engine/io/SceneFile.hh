@@ -0,0 +1,132 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_IO_SCENE_FILE_HH
+#define DD25_ENGINE_IO_SCENE_FILE_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "../core/StringId.hh"
+#include "../math/Geometry.hh"
+#include "MappedFile.hh"
+
+#include <cstdint>
+#include <cstddef>
+
+//================================================================
+// On-disk layout (little-endian)
+//
+//   SceneFileHeader
+//   SceneSectionEntry[sectionCount]
+//   sections...          (each starts on a SCENE_FILE_ALIGNMENT boundary)
+//
+// Sections are flat arrays of fixed-size records with no pointers, only
+// element indices and byte offsets relative to their section, so a
+// loaded file is used exactly as it sits in memory.
+//================================================================
+
+constexpr uint32_t SCENE_FILE_MAGIC			= 0x43534444U;	// "DDSC"
+constexpr uint16_t SCENE_FILE_VERSION		= 1U;			// Bump on any layout change
+constexpr size_t   SCENE_FILE_ALIGNMENT		= MappedFile::ALIGNMENT;
+
+enum class SceneSection : uint32_t {
+	Strings			= 0,	// char[], NUL terminated names
+	StringTable		= 1,	// SceneStringRecord[]
+	Meshes			= 2,	// SceneMeshRecord[]
+	LodLevels		= 3,	// MeshLodLevel[] (firstIndex relative to the mesh's firstLodIndex)
+	Positions		= 4,	// Float3[]
+	Normals			= 5,	// Float3[] (optional)
+	Uvs				= 6,	// Float2[] (optional)
+	Indices			= 7,	// uint16_t[], base and LOD index lists
+	ObjectBounds	= 8,	// Sphere[]
+	ObjectMeshes	= 9,	// uint32_t[], index into Meshes
+	ObjectNames		= 10,	// StringId[]
+	Cells			= 11,	// VisCell[]
+	Portals			= 12,	// VisPortal[]
+	Pvs				= 13,	// uint32_t[] PVS bit rows
+
+	Count
+};
+
+struct SceneFileHeader {
+	uint32_t	magic;
+	uint16_t	version;
+	uint16_t	sectionCount;
+	uint32_t	fileSize;
+	uint32_t	flags;			// Reserved, 0
+};
+
+struct SceneSectionEntry {
+	uint32_t	type;			// SceneSection
+	uint32_t	offset;			// From the start of the file
+	uint32_t	size;			// Bytes
+	uint32_t	count;			// Records
+};
+
+struct SceneStringRecord {
+	StringId	id;
+	uint32_t	offset;			// Into the Strings section
+};
+
+struct SceneMeshRecord {
+	StringId	name;
+	uint32_t	firstVertex;	// Into Positions/Normals/Uvs
+	uint32_t	vertexCount;
+	uint32_t	firstLodIndex;	// Into Indices, LOD level 0 starts here
+	uint32_t	firstLod;		// Into LodLevels
+	uint32_t	lodCount;
+	Sphere		bounds;			// Object space
+};
+
+//================================================================
+
+//
+// A validated scene file. `section()` hands out typed pointers straight
+// into the file's memory, nothing is parsed or copied.
+//
+class SceneFile {
+public:
+	// Default Constructor
+	SceneFile() = default;
+
+	// Destructor
+	~SceneFile() noexcept = default;
+
+	// Map (or read, `map` = false) and validate `path`
+	bool open(const char* path, bool map = true);
+
+	void close() noexcept;
+
+	constexpr inline bool isOpen() const noexcept { return mFile.isOpen(); }
+	constexpr inline const MappedFile& file() const noexcept { return mFile; }
+
+	// Section contents as an array of T, nullptr (count 0) when absent
+	template <typename T>
+	inline const T* section(SceneSection type, size_t& count) const noexcept {
+		const SceneSectionEntry* e = find(type);
+		if (!e || e->count == 0 || e->size < static_cast<size_t>(e->count) * sizeof(T)) {
+			count = 0;
+			return nullptr;
+		}
+		count = e->count;
+		return reinterpret_cast<const T*>(mFile.data() + e->offset);
+	}
+
+	// Name for `id` from the string table, nullptr when stripped
+	const char* lookup(StringId id) const noexcept;
+
+private:
+	const SceneSectionEntry* find(SceneSection type) const noexcept;
+	bool validate() const noexcept;
+
+	MappedFile					mFile;
+	const SceneSectionEntry*	mSections	= nullptr;
+	size_t						mCount		= 0;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_IO_SCENE_FILE_HH
+//////////////////////////////////////////////////////////////////
@@ -0,0 +1,266 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_MATH_GEOMETRY_HH
+#define DD25_ENGINE_MATH_GEOMETRY_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+//================================================================
+// Scalars
+//================================================================
+
+// Clamp in float before converting, out-of-range float -> int casts are undefined (NaN -> lo)
+inline int32_t clampToInt(float v, int32_t lo, int32_t hi) noexcept {
+	if (!(v > static_cast<float>(lo))) {
+		return lo;
+	}
+	if (!(v < static_cast<float>(hi))) {
+		return hi;
+	}
+	return static_cast<int32_t>(v);
+}
+
+//================================================================
+// Plain (POD) float types shared by the scene, gfx and tooling code.
+// These are layout-compatible with `shz_vec2`/`shz_vec3`/`shz_vec4`,
+// so cooked data can be handed to sh4zam without conversion.
+//================================================================
+
+struct Float2 {
+	float		x, y;
+};
+
+struct Float3 {
+	float		x, y, z;
+};
+
+struct Float4 {
+	float		x, y, z, w;
+};
+
+//----------------------------------------------------------------
+
+constexpr inline Float3 operator+(const Float3& a, const Float3& b) noexcept { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+constexpr inline Float3 operator-(const Float3& a, const Float3& b) noexcept { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+constexpr inline Float3 operator-(const Float3& a) noexcept { return { -a.x, -a.y, -a.z }; }
+constexpr inline Float3 operator*(const Float3& a, float s) noexcept { return { a.x * s, a.y * s, a.z * s }; }
+constexpr inline Float3 operator*(float s, const Float3& a) noexcept { return { a.x * s, a.y * s, a.z * s }; }
+
+constexpr inline float dot(const Float3& a, const Float3& b) noexcept {
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+constexpr inline Float3 cross(const Float3& a, const Float3& b) noexcept {
+	return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+inline float length(const Float3& a) noexcept {
+	return std::sqrt(dot(a, a));
+}
+
+inline Float3 normalize(const Float3& a) noexcept {
+	const float len = length(a);
+	return (len > 0.0f) ? a * (1.0f / len) : Float3{ 0.0f, 0.0f, 0.0f };
+}
+
+constexpr inline Float3 min(const Float3& a, const Float3& b) noexcept {
+	return { a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z };
+}
+
+constexpr inline Float3 max(const Float3& a, const Float3& b) noexcept {
+	return { a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y, a.z > b.z ? a.z : b.z };
+}
+
+//================================================================
+// Float4x4 (column-major, column vectors: p' = M * p)
+//================================================================
+
+struct Float4x4 {
+	float		m[16];
+
+	static constexpr Float4x4 identity() noexcept {
+		return { {
+			1.0f, 0.0f, 0.0f, 0.0f,
+			0.0f, 1.0f, 0.0f, 0.0f,
+			0.0f, 0.0f, 1.0f, 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f
+		} };
+	}
+
+	// Element at (row, column)
+	constexpr inline float at(size_t row, size_t col) const noexcept { return m[col * 4 + row]; }
+};
+
+constexpr inline Float4x4 operator*(const Float4x4& a, const Float4x4& b) noexcept {
+	Float4x4 r = {};
+	for (size_t c = 0; c < 4; ++c) {
+		for (size_t rr = 0; rr < 4; ++rr) {
+			r.m[c * 4 + rr] =
+				a.m[0 * 4 + rr] * b.m[c * 4 + 0] +
+				a.m[1 * 4 + rr] * b.m[c * 4 + 1] +
+				a.m[2 * 4 + rr] * b.m[c * 4 + 2] +
+				a.m[3 * 4 + rr] * b.m[c * 4 + 3];
+		}
+	}
+	return r;
+}
+
+// Transform a point (w = 1), returning the homogeneous result
+constexpr inline Float4 transform(const Float4x4& a, const Float3& p) noexcept {
+	return {
+		a.m[0] * p.x + a.m[4] * p.y + a.m[8]  * p.z + a.m[12],
+		a.m[1] * p.x + a.m[5] * p.y + a.m[9]  * p.z + a.m[13],
+		a.m[2] * p.x + a.m[6] * p.y + a.m[10] * p.z + a.m[14],
+		a.m[3] * p.x + a.m[7] * p.y + a.m[11] * p.z + a.m[15]
+	};
+}
+
+// Right-handed perspective projection, clip space z in [-1, 1]
+inline Float4x4 perspective(float fovY, float aspect, float zNear, float zFar) noexcept {
+	const float f = 1.0f / std::tan(fovY * 0.5f);
+	Float4x4 r = {};
+	r.m[0]  = f / aspect;
+	r.m[5]  = f;
+	r.m[10] = (zFar + zNear) / (zNear - zFar);
+	r.m[11] = -1.0f;
+	r.m[14] = (2.0f * zFar * zNear) / (zNear - zFar);
+	return r;
+}
+
+// Right-handed orthographic projection, clip space z in [-1, 1]
+constexpr inline Float4x4 orthographic(float left, float right, float bottom, float top, float zNear, float zFar) noexcept {
+	Float4x4 r = {};
+	r.m[0]  = 2.0f / (right - left);
+	r.m[5]  = 2.0f / (top - bottom);
+	r.m[10] = -2.0f / (zFar - zNear);
+	r.m[12] = -(right + left) / (right - left);
+	r.m[13] = -(top + bottom) / (top - bottom);
+	r.m[14] = -(zFar + zNear) / (zFar - zNear);
+	r.m[15] = 1.0f;
+	return r;
+}
+
+// Right-handed view matrix looking from `eye` towards `target`
+inline Float4x4 lookAt(const Float3& eye, const Float3& target, const Float3& up) noexcept {
+	const Float3 f = normalize(target - eye);
+	const Float3 s = normalize(cross(f, up));
+	const Float3 u = cross(s, f);
+	Float4x4 r = Float4x4::identity();
+	r.m[0] = s.x;	r.m[4] = s.y;	r.m[8]  = s.z;
+	r.m[1] = u.x;	r.m[5] = u.y;	r.m[9]  = u.z;
+	r.m[2] = -f.x;	r.m[6] = -f.y;	r.m[10] = -f.z;
+	r.m[12] = -dot(s, eye);
+	r.m[13] = -dot(u, eye);
+	r.m[14] = dot(f, eye);
+	return r;
+}
+
+//================================================================
+// Bounding Volumes
+//================================================================
+
+struct Sphere {
+	Float3		center;
+	float		radius;
+};
+
+struct Aabb {
+	Float3		min;
+	Float3		max;
+
+	constexpr inline Float3 center() const noexcept { return (min + max) * 0.5f; }
+	constexpr inline Float3 extents() const noexcept { return (max - min) * 0.5f; }
+
+	constexpr inline bool contains(const Float3& p) const noexcept {
+		return p.x >= min.x && p.y >= min.y && p.z >= min.z
+			&& p.x <= max.x && p.y <= max.y && p.z <= max.z;
+	}
+};
+
+//================================================================
+// Planes and Frusta
+//================================================================
+
+// Points with dot(n, p) + d >= 0 are on the inside
+struct Plane {
+	Float3		n;
+	float		d;
+
+	constexpr inline float distance(const Float3& p) const noexcept { return dot(n, p) + d; }
+
+	inline Plane normalized() const noexcept {
+		const float len = length(n);
+		return (len > 0.0f) ? Plane{ n * (1.0f / len), d / len } : *this;
+	}
+
+	// Plane through `a`, `b`, `c`, facing `inside`
+	static inline Plane through(const Float3& a, const Float3& b, const Float3& c, const Float3& inside) noexcept {
+		const Float3 n = normalize(cross(b - a, c - a));
+		Plane p = { n, -dot(n, a) };
+		return (p.distance(inside) < 0.0f) ? Plane{ -p.n, -p.d } : p;
+	}
+};
+
+//
+// Convex volume bounded by up to MAX_PLANES planes. Camera frusta use 6,
+// portal-narrowed frusta use one plane per portal edge plus the far plane.
+//
+struct Frustum {
+	static constexpr size_t MAX_PLANES = 16U;
+
+	Plane		planes[MAX_PLANES];
+	uint32_t	count;
+
+	// Gribb-Hartmann extraction from a (column-major) world -> clip matrix
+	static inline Frustum fromMatrix(const Float4x4& vp) noexcept {
+		auto row = [&vp](size_t r) { return Float4{ vp.m[r], vp.m[4 + r], vp.m[8 + r], vp.m[12 + r] }; };
+		const Float4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+		auto mk = [](const Float4& a, const Float4& b, float s) {
+			return Plane{ { a.x + s * b.x, a.y + s * b.y, a.z + s * b.z }, a.w + s * b.w }.normalized();
+		};
+		Frustum f = {};
+		f.planes[0] = mk(r3, r0,  1.0f);	// Left
+		f.planes[1] = mk(r3, r0, -1.0f);	// Right
+		f.planes[2] = mk(r3, r1,  1.0f);	// Bottom
+		f.planes[3] = mk(r3, r1, -1.0f);	// Top
+		f.planes[4] = mk(r3, r2,  1.0f);	// Near
+		f.planes[5] = mk(r3, r2, -1.0f);	// Far
+		f.count = 6;
+		return f;
+	}
+
+	inline bool intersects(const Sphere& s) const noexcept {
+		for (uint32_t i = 0; i < count; ++i) {
+			if (planes[i].distance(s.center) < -s.radius) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	inline bool intersects(const Aabb& b) const noexcept {
+		const Float3 c = b.center();
+		const Float3 e = b.extents();
+		for (uint32_t i = 0; i < count; ++i) {
+			const Plane& p = planes[i];
+			const float r = e.x * std::fabs(p.n.x) + e.y * std::fabs(p.n.y) + e.z * std::fabs(p.n.z);
+			if (p.distance(c) < -r) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_MATH_GEOMETRY_HH
+//////////////////////////////////////////////////////////////////
@@ -10,26 +10,269 @@
 
 #include "../core/core.hh"
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+//================================================================
+// Instruction set, picked by ISA rather than platform. SH4 (Dreamcast)
+// has no integer/compare vector unit, it takes the scalar path, as does
+// 32-bit ARM (no round-to-nearest convert).
 //================================================================
 
-#if defined(__DREAMCAST__)
-//TODO: Include simd headers/define simd functions
+#if defined(DD25_SIMD_FORCE_SCALAR)
+#define DD25_SIMD_SCALAR		1
 
-#elif defined(__WINDOWS__)
-//TODO: Include simd header
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DD25_SIMD_SSE2			1
+#include <emmintrin.h>
 
-#elif defined(__OSX__)
-//TODO: Include simd header
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DD25_SIMD_NEON			1
+#include <arm_neon.h>
 
-#elif defined(__FREEBSD__)
-//TODO: Include simd header
+#else
+#define DD25_SIMD_SCALAR		1
 
-#elif defined(__LINUX__)
-//TODO: Include simd header
+#endif//SSE2, NEON, scalar
 
-#else
-//#error "simd.hh - Unsupported target platform."
-#endif//Dreamcast, Windows, macOS, FreeBSD, Linux
+//================================================================
+// SimdFloat4 / SimdInt4
+//
+// Four lanes of float / int32. Comparisons return all-ones/all-zero
+// lanes in a SimdFloat4 (like the hardware does) for `select()` and
+// `movemask()`. Aligned loads/stores expect 16-byte alignment.
+//
+// Every backend divides exactly (IEEE), `simdToInt()` rounds half to
+// even, the SSE2 default rounding mode, and `simdMin()` / `simdMax()`
+// return `b` when either lane is NaN, as SSE2 does, so all three give
+// bit-identical results.
+//================================================================
+
+#if defined(DD25_SIMD_SSE2)
+
+struct SimdFloat4 {
+	__m128		v;
+};
+
+struct SimdInt4 {
+	__m128i		v;
+};
+
+inline SimdFloat4 simdLoad(const float* p) noexcept { return { _mm_load_ps(p) }; }
+inline SimdFloat4 simdLoadU(const float* p) noexcept { return { _mm_loadu_ps(p) }; }
+inline void simdStore(float* p, SimdFloat4 a) noexcept { _mm_store_ps(p, a.v); }
+inline void simdStoreU(float* p, SimdFloat4 a) noexcept { _mm_storeu_ps(p, a.v); }
+inline SimdFloat4 simdSplat(float s) noexcept { return { _mm_set1_ps(s) }; }
+inline SimdFloat4 simdSet(float x, float y, float z, float w) noexcept { return { _mm_setr_ps(x, y, z, w) }; }
+
+inline SimdFloat4 operator+(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_add_ps(a.v, b.v) }; }
+inline SimdFloat4 operator-(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_sub_ps(a.v, b.v) }; }
+inline SimdFloat4 operator*(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_mul_ps(a.v, b.v) }; }
+inline SimdFloat4 operator/(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_div_ps(a.v, b.v) }; }
+inline SimdFloat4 operator&(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_and_ps(a.v, b.v) }; }
+inline SimdFloat4 operator|(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_or_ps(a.v, b.v) }; }
+inline SimdFloat4 simdMin(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_min_ps(a.v, b.v) }; }
+inline SimdFloat4 simdMax(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_max_ps(a.v, b.v) }; }
+inline SimdFloat4 simdSqrt(SimdFloat4 a) noexcept { return { _mm_sqrt_ps(a.v) }; }
+inline SimdFloat4 simdCmpLt(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_cmplt_ps(a.v, b.v) }; }
+inline SimdFloat4 simdCmpLe(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_cmple_ps(a.v, b.v) }; }
+inline SimdFloat4 simdCmpGe(SimdFloat4 a, SimdFloat4 b) noexcept { return { _mm_cmpge_ps(a.v, b.v) }; }
+
+// Lanes of `a` where `mask` is set, else `b`
+inline SimdFloat4 simdSelect(SimdFloat4 mask, SimdFloat4 a, SimdFloat4 b) noexcept {
+	return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) };
+}
+
+// One bit per lane (lane 0 = bit 0) from the sign bits
+inline int simdMoveMask(SimdFloat4 a) noexcept { return _mm_movemask_ps(a.v); }
+
+inline SimdInt4 simdLoad(const int32_t* p) noexcept { return { _mm_load_si128(reinterpret_cast<const __m128i*>(p)) }; }
+inline SimdInt4 simdLoadU(const int32_t* p) noexcept { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)) }; }
+inline void simdStore(int32_t* p, SimdInt4 a) noexcept { _mm_store_si128(reinterpret_cast<__m128i*>(p), a.v); }
+inline void simdStoreU(int32_t* p, SimdInt4 a) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a.v); }
+inline SimdInt4 simdSplat(int32_t s) noexcept { return { _mm_set1_epi32(s) }; }
+
+inline SimdInt4 operator+(SimdInt4 a, SimdInt4 b) noexcept { return { _mm_add_epi32(a.v, b.v) }; }
+inline SimdInt4 operator-(SimdInt4 a, SimdInt4 b) noexcept { return { _mm_sub_epi32(a.v, b.v) }; }
+inline SimdInt4 operator&(SimdInt4 a, SimdInt4 b) noexcept { return { _mm_and_si128(a.v, b.v) }; }
+inline SimdInt4 operator|(SimdInt4 a, SimdInt4 b) noexcept { return { _mm_or_si128(a.v, b.v) }; }
+template <int N> inline SimdInt4 simdShl(SimdInt4 a) noexcept { return { _mm_slli_epi32(a.v, N) }; }
+template <int N> inline SimdInt4 simdShr(SimdInt4 a) noexcept { return { _mm_srli_epi32(a.v, N) }; }
+
+// Float <-> int (round to nearest or toward zero / exact)
+inline SimdInt4 simdToInt(SimdFloat4 a) noexcept { return { _mm_cvtps_epi32(a.v) }; }
+inline SimdInt4 simdTruncate(SimdFloat4 a) noexcept { return { _mm_cvttps_epi32(a.v) }; }
+inline SimdFloat4 simdToFloat(SimdInt4 a) noexcept { return { _mm_cvtepi32_ps(a.v) }; }
+
+#elif defined(DD25_SIMD_NEON)
+
+struct SimdFloat4 {
+	float32x4_t		v;
+};
+
+struct SimdInt4 {
+	int32x4_t		v;
+};
+
+inline SimdFloat4 simdLoad(const float* p) noexcept { return { vld1q_f32(p) }; }
+inline SimdFloat4 simdLoadU(const float* p) noexcept { return { vld1q_f32(p) }; }
+inline void simdStore(float* p, SimdFloat4 a) noexcept { vst1q_f32(p, a.v); }
+inline void simdStoreU(float* p, SimdFloat4 a) noexcept { vst1q_f32(p, a.v); }
+inline SimdFloat4 simdSplat(float s) noexcept { return { vdupq_n_f32(s) }; }
+inline SimdFloat4 simdSet(float x, float y, float z, float w) noexcept {
+	const float lanes[4] = { x, y, z, w };
+	return { vld1q_f32(lanes) };
+}
+
+inline SimdFloat4 operator+(SimdFloat4 a, SimdFloat4 b) noexcept { return { vaddq_f32(a.v, b.v) }; }
+inline SimdFloat4 operator-(SimdFloat4 a, SimdFloat4 b) noexcept { return { vsubq_f32(a.v, b.v) }; }
+inline SimdFloat4 operator*(SimdFloat4 a, SimdFloat4 b) noexcept { return { vmulq_f32(a.v, b.v) }; }
+inline SimdFloat4 operator/(SimdFloat4 a, SimdFloat4 b) noexcept { return { vdivq_f32(a.v, b.v) }; }
+inline SimdFloat4 operator&(SimdFloat4 a, SimdFloat4 b) noexcept {
+	return { vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))) };
+}
+inline SimdFloat4 operator|(SimdFloat4 a, SimdFloat4 b) noexcept {
+	return { vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))) };
+}
+// Select rather than vminq/vmaxq, which propagate NaN where SSE returns `b`
+inline SimdFloat4 simdMin(SimdFloat4 a, SimdFloat4 b) noexcept { return { vbslq_f32(vcltq_f32(a.v, b.v), a.v, b.v) }; }
+inline SimdFloat4 simdMax(SimdFloat4 a, SimdFloat4 b) noexcept { return { vbslq_f32(vcgtq_f32(a.v, b.v), a.v, b.v) }; }
+inline SimdFloat4 simdSqrt(SimdFloat4 a) noexcept { return { vsqrtq_f32(a.v) }; }
+inline SimdFloat4 simdCmpLt(SimdFloat4 a, SimdFloat4 b) noexcept { return { vreinterpretq_f32_u32(vcltq_f32(a.v, b.v)) }; }
+inline SimdFloat4 simdCmpLe(SimdFloat4 a, SimdFloat4 b) noexcept { return { vreinterpretq_f32_u32(vcleq_f32(a.v, b.v)) }; }
+inline SimdFloat4 simdCmpGe(SimdFloat4 a, SimdFloat4 b) noexcept { return { vreinterpretq_f32_u32(vcgeq_f32(a.v, b.v)) }; }
+
+inline SimdFloat4 simdSelect(SimdFloat4 mask, SimdFloat4 a, SimdFloat4 b) noexcept {
+	return { vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v) };
+}
+
+inline int simdMoveMask(SimdFloat4 a) noexcept {
+	const uint32x4_t sign = vshrq_n_u32(vreinterpretq_u32_f32(a.v), 31);
+	return static_cast<int>(vgetq_lane_u32(sign, 0) | (vgetq_lane_u32(sign, 1) << 1)
+		| (vgetq_lane_u32(sign, 2) << 2) | (vgetq_lane_u32(sign, 3) << 3));
+}
+
+inline SimdInt4 simdLoad(const int32_t* p) noexcept { return { vld1q_s32(p) }; }
+inline SimdInt4 simdLoadU(const int32_t* p) noexcept { return { vld1q_s32(p) }; }
+inline void simdStore(int32_t* p, SimdInt4 a) noexcept { vst1q_s32(p, a.v); }
+inline void simdStoreU(int32_t* p, SimdInt4 a) noexcept { vst1q_s32(p, a.v); }
+inline SimdInt4 simdSplat(int32_t s) noexcept { return { vdupq_n_s32(s) }; }
+
+inline SimdInt4 operator+(SimdInt4 a, SimdInt4 b) noexcept { return { vaddq_s32(a.v, b.v) }; }
+inline SimdInt4 operator-(SimdInt4 a, SimdInt4 b) noexcept { return { vsubq_s32(a.v, b.v) }; }
+inline SimdInt4 operator&(SimdInt4 a, SimdInt4 b) noexcept { return { vandq_s32(a.v, b.v) }; }
+inline SimdInt4 operator|(SimdInt4 a, SimdInt4 b) noexcept { return { vorrq_s32(a.v, b.v) }; }
+template <int N> inline SimdInt4 simdShl(SimdInt4 a) noexcept { return { vshlq_n_s32(a.v, N) }; }
+template <int N> inline SimdInt4 simdShr(SimdInt4 a) noexcept {
+	return { vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a.v), N)) };
+}
+
+inline SimdInt4 simdToInt(SimdFloat4 a) noexcept { return { vcvtq_s32_f32(vrndnq_f32(a.v)) }; }
+inline SimdInt4 simdTruncate(SimdFloat4 a) noexcept { return { vcvtq_s32_f32(a.v) }; }
+inline SimdFloat4 simdToFloat(SimdInt4 a) noexcept { return { vcvtq_f32_s32(a.v) }; }
+
+#else//DD25_SIMD_SCALAR
+
+struct alignas(16) SimdFloat4 {
+	float		v[4];
+};
+
+struct alignas(16) SimdInt4 {
+	int32_t		v[4];
+};
+
+namespace simd_detail {
+inline float bits(uint32_t u) noexcept { float f; std::memcpy(&f, &u, sizeof(f)); return f; }
+inline uint32_t bits(float f) noexcept { uint32_t u; std::memcpy(&u, &f, sizeof(u)); return u; }
+inline float mask(bool b) noexcept { return bits(b ? 0xFFFFFFFFU : 0U); }
+template <typename F> inline SimdFloat4 mapf(F f) noexcept { return { { f(0), f(1), f(2), f(3) } }; }
+template <typename F> inline SimdInt4 mapi(F f) noexcept { return { { f(0), f(1), f(2), f(3) } }; }
+} // namespace simd_detail
+
+inline SimdFloat4 simdLoad(const float* p) noexcept { return { { p[0], p[1], p[2], p[3] } }; }
+inline SimdFloat4 simdLoadU(const float* p) noexcept { return simdLoad(p); }
+inline void simdStore(float* p, SimdFloat4 a) noexcept { std::memcpy(p, a.v, sizeof(a.v)); }
+inline void simdStoreU(float* p, SimdFloat4 a) noexcept { simdStore(p, a); }
+inline SimdFloat4 simdSplat(float s) noexcept { return { { s, s, s, s } }; }
+inline SimdFloat4 simdSet(float x, float y, float z, float w) noexcept { return { { x, y, z, w } }; }
+
+inline SimdFloat4 operator+(SimdFloat4 a, SimdFloat4 b) noexcept { return simd_detail::mapf([&](int i) { return a.v[i] + b.v[i]; }); }
+inline SimdFloat4 operator-(SimdFloat4 a, SimdFloat4 b) noexcept { return simd_detail::mapf([&](int i) { return a.v[i] - b.v[i]; }); }
+inline SimdFloat4 operator*(SimdFloat4 a, SimdFloat4 b) noexcept { return simd_detail::mapf([&](int i) { return a.v[i] * b.v[i]; }); }
+inline SimdFloat4 operator/(SimdFloat4 a, SimdFloat4 b) noexcept { return simd_detail::mapf([&](int i) { return a.v[i] / b.v[i]; }); }
+inline SimdFloat4 operator&(SimdFloat4 a, SimdFloat4 b) noexcept {
+	return simd_detail::mapf([&](int i) { return simd_detail::bits(simd_detail::bits(a.v[i]) & simd_detail::bits(b.v[i])); });
+}
+inline SimdFloat4 operator|(SimdFloat4 a, SimdFloat4 b) noexcept {
+	return simd_detail::mapf([&](int i) { return simd_detail::bits(simd_detail::bits(a.v[i]) | simd_detail::bits(b.v[i])); });
+}
+inline SimdFloat4 simdMin(SimdFloat4 a, SimdFloat4 b) noexcept { return simd_detail::mapf([&](int i) { return a.v[i] < b.v[i] ? a.v[i] : b.v[i]; }); }
+inline SimdFloat4 simdMax(SimdFloat4 a, SimdFloat4 b) noexcept { return simd_detail::mapf([&](int i) { return a.v[i] > b.v[i] ? a.v[i] : b.v[i]; }); }
+inline SimdFloat4 simdSqrt(SimdFloat4 a) noexcept { return simd_detail::mapf([&](int i) { return std::sqrt(a.v[i]); }); }
+inline SimdFloat4 simdCmpLt(SimdFloat4 a, SimdFloat4 b) noexcept { return simd_detail::mapf([&](int i) { return simd_detail::mask(a.v[i] < b.v[i]); }); }
+inline SimdFloat4 simdCmpLe(SimdFloat4 a, SimdFloat4 b) noexcept { return simd_detail::mapf([&](int i) { return simd_detail::mask(a.v[i] <= b.v[i]); }); }
+inline SimdFloat4 simdCmpGe(SimdFloat4 a, SimdFloat4 b) noexcept { return simd_detail::mapf([&](int i) { return simd_detail::mask(a.v[i] >= b.v[i]); }); }
+
+inline SimdFloat4 simdSelect(SimdFloat4 mask, SimdFloat4 a, SimdFloat4 b) noexcept {
+	return simd_detail::mapf([&](int i) { return simd_detail::bits(mask.v[i]) ? a.v[i] : b.v[i]; });
+}
+
+inline int simdMoveMask(SimdFloat4 a) noexcept {
+	int m = 0;
+	for (int i = 0; i < 4; ++i) {
+		m |= static_cast<int>(simd_detail::bits(a.v[i]) >> 31) << i;
+	}
+	return m;
+}
+
+inline SimdInt4 simdLoad(const int32_t* p) noexcept { return { { p[0], p[1], p[2], p[3] } }; }
+inline SimdInt4 simdLoadU(const int32_t* p) noexcept { return simdLoad(p); }
+inline void simdStore(int32_t* p, SimdInt4 a) noexcept { std::memcpy(p, a.v, sizeof(a.v)); }
+inline void simdStoreU(int32_t* p, SimdInt4 a) noexcept { simdStore(p, a); }
+inline SimdInt4 simdSplat(int32_t s) noexcept { return { { s, s, s, s } }; }
+
+inline SimdInt4 operator+(SimdInt4 a, SimdInt4 b) noexcept {
+	return simd_detail::mapi([&](int i) { return static_cast<int32_t>(static_cast<uint32_t>(a.v[i]) + static_cast<uint32_t>(b.v[i])); });
+}
+inline SimdInt4 operator-(SimdInt4 a, SimdInt4 b) noexcept {
+	return simd_detail::mapi([&](int i) { return static_cast<int32_t>(static_cast<uint32_t>(a.v[i]) - static_cast<uint32_t>(b.v[i])); });
+}
+inline SimdInt4 operator&(SimdInt4 a, SimdInt4 b) noexcept { return simd_detail::mapi([&](int i) { return a.v[i] & b.v[i]; }); }
+inline SimdInt4 operator|(SimdInt4 a, SimdInt4 b) noexcept { return simd_detail::mapi([&](int i) { return a.v[i] | b.v[i]; }); }
+template <int N> inline SimdInt4 simdShl(SimdInt4 a) noexcept {
+	return simd_detail::mapi([&](int i) { return static_cast<int32_t>(static_cast<uint32_t>(a.v[i]) << N); });
+}
+template <int N> inline SimdInt4 simdShr(SimdInt4 a) noexcept {
+	return simd_detail::mapi([&](int i) { return static_cast<int32_t>(static_cast<uint32_t>(a.v[i]) >> N); });
+}
+
+inline SimdInt4 simdToInt(SimdFloat4 a) noexcept {
+	return simd_detail::mapi([&](int i) { return static_cast<int32_t>(std::nearbyint(a.v[i])); });
+}
+inline SimdInt4 simdTruncate(SimdFloat4 a) noexcept { return simd_detail::mapi([&](int i) { return static_cast<int32_t>(a.v[i]); }); }
+inline SimdFloat4 simdToFloat(SimdInt4 a) noexcept { return simd_detail::mapf([&](int i) { return static_cast<float>(a.v[i]); }); }
+
+#endif//DD25_SIMD_SSE2, DD25_SIMD_NEON, DD25_SIMD_SCALAR
+
+//----------------------------------------------------------------
+
+// Horizontal reductions (shared, not on any hot inner loop)
+inline float simdHMax(SimdFloat4 a) noexcept {
+	alignas(16) float l[4];
+	simdStore(l, a);
+	const float m0 = (l[0] > l[1]) ? l[0] : l[1];
+	const float m1 = (l[2] > l[3]) ? l[2] : l[3];
+	return (m0 > m1) ? m0 : m1;
+}
+
+inline float simdHMin(SimdFloat4 a) noexcept {
+	alignas(16) float l[4];
+	simdStore(l, a);
+	const float m0 = (l[0] < l[1]) ? l[0] : l[1];
+	const float m1 = (l[2] < l[3]) ? l[2] : l[3];
+	return (m0 < m1) ? m0 : m1;
+}
 
 //////////////////////////////////////////////////////////////////
 #endif//DD25_ENGINE_MATH_SIMD_HH
@@ -8,18 +8,75 @@
 #define DD25_ENGINE_PHYSICS_RAY_HH
 //////////////////////////////////////////////////////////////////
 
+#include "../math/Geometry.hh"
+
 //================================================================
 
 class Ray {
 public:
 	// Default Constructor
-	Ray();
+	Ray() = default;
+
+	// Initialize Constructor (`dir` need not be normalized, t is in units of `dir`)
+	inline Ray(const Float3& origin, const Float3& dir) noexcept
+		: mOrigin(origin)
+		, mDir(dir)
+		, mInvDir{ 1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z } {}
 
 	// Destructor
-	~Ray() noexcept;
+	~Ray() noexcept = default;
 
-private:
+	constexpr inline const Float3& origin() const noexcept { return mOrigin; }
+	constexpr inline const Float3& direction() const noexcept { return mDir; }
+	constexpr inline const Float3& invDirection() const noexcept { return mInvDir; }
+	constexpr inline Float3 at(float t) const noexcept { return mOrigin + mDir * t; }
 
+	// Slab test, `tNear` receives the entry distance (clamped to 0)
+	inline bool intersect(const Aabb& box, float tMax, float& tNear) const noexcept {
+		float t0 = (box.min.x - mOrigin.x) * mInvDir.x;
+		float t1 = (box.max.x - mOrigin.x) * mInvDir.x;
+		float lo = t0 < t1 ? t0 : t1;
+		float hi = t0 < t1 ? t1 : t0;
+		t0 = (box.min.y - mOrigin.y) * mInvDir.y;
+		t1 = (box.max.y - mOrigin.y) * mInvDir.y;
+		lo = std::fmax(lo, t0 < t1 ? t0 : t1);
+		hi = std::fmin(hi, t0 < t1 ? t1 : t0);
+		t0 = (box.min.z - mOrigin.z) * mInvDir.z;
+		t1 = (box.max.z - mOrigin.z) * mInvDir.z;
+		lo = std::fmax(lo, t0 < t1 ? t0 : t1);
+		hi = std::fmin(hi, t0 < t1 ? t1 : t0);
+		tNear = lo > 0.0f ? lo : 0.0f;
+		return hi >= tNear && tNear <= tMax;
+	}
+
+	// Moller-Trumbore, double sided. Returns the hit distance and barycentrics
+	inline bool intersect(const Float3& a, const Float3& b, const Float3& c, float tMax, float& t, float& u, float& v) const noexcept {
+		const Float3 e1 = b - a;
+		const Float3 e2 = c - a;
+		const Float3 p = cross(mDir, e2);
+		const float det = dot(e1, p);
+		if (std::fabs(det) < 1.0e-12f) {
+			return false;
+		}
+		const float inv = 1.0f / det;
+		const Float3 s = mOrigin - a;
+		u = dot(s, p) * inv;
+		if (u < 0.0f || u > 1.0f) {
+			return false;
+		}
+		const Float3 q = cross(s, e1);
+		v = dot(mDir, q) * inv;
+		if (v < 0.0f || (u + v) > 1.0f) {
+			return false;
+		}
+		t = dot(e2, q) * inv;
+		return t > 0.0f && t < tMax;
+	}
+
+private:
+	Float3		mOrigin;
+	Float3		mDir;
+	Float3		mInvDir;
 };
 
 //////////////////////////////////////////////////////////////////
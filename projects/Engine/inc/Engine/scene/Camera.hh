@@ -9,6 +9,7 @@
 //////////////////////////////////////////////////////////////////
 
 #include "Mesh.hh"
+#include "../math/Geometry.hh"
 
 //================================================================
 
@@ -20,8 +21,48 @@ public:
 	// Destructor
 	~Camera() noexcept;
 
+	// Set the projection (vertical field of view in radians)
+	void setPerspective(float fovY, float aspect, float zNear, float zFar) noexcept;
+
+	// Position the camera at `eye`, looking at `target`
+	void lookAt(const Float3& eye, const Float3& target, const Float3& up) noexcept;
+
+	// Output size in pixels, used for screen-space metrics
+	void setViewportSize(uint16_t width, uint16_t height) noexcept;
+
+	//
+	// Radius in pixels that a sphere projects to on screen. This is what
+	// LOD selection works from, it only needs the distance to the camera
+	// so it is independent of view direction (no popping when turning).
+	//
+	inline float projectedRadius(const Sphere& s) const noexcept {
+		const float dist = length(s.center - mPos);
+		if (dist <= s.radius) {
+			return 1.0e30f;	// Camera is inside the bounds
+		}
+		return s.radius * mProjScale / dist;
+	}
+
+	constexpr inline const Float3& position() const noexcept { return mPos; }
+	constexpr inline const Float4x4& view() const noexcept { return mView; }
+	constexpr inline const Float4x4& projection() const noexcept { return mProj; }
+	constexpr inline const Float4x4& viewProjection() const noexcept { return mViewProj; }
+	constexpr inline const Frustum& frustum() const noexcept { return mFrustum; }
+	constexpr inline uint16_t viewportWidth() const noexcept { return mWidth; }
+	constexpr inline uint16_t viewportHeight() const noexcept { return mHeight; }
+
 private:
+	void updateDerived() noexcept;
 
+	Float3			mPos;			// Eye position (world)
+	Float4x4		mView;			// World -> view
+	Float4x4		mProj;			// View -> clip
+	Float4x4		mViewProj;		// World -> clip
+	Frustum			mFrustum;		// World-space planes of mViewProj (far plane last)
+	float			mFovY;			// Vertical field of view (radians)
+	float			mProjScale;		// Pixels per unit at distance 1
+	uint16_t		mWidth;			// Viewport width (pixels)
+	uint16_t		mHeight;		// Viewport height (pixels)
 };
 
 //////////////////////////////////////////////////////////////////
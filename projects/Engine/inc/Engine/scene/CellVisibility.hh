@@ -0,0 +1,134 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_SCENE_CELL_VISIBILITY_HH
+#define DD25_ENGINE_SCENE_CELL_VISIBILITY_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "../math/Geometry.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+// A convex region of the level (baked by the Editor)
+struct VisCell {
+	Aabb		bounds;
+	uint32_t	firstPortal;	// Into the portal list, portals are grouped by owning cell
+	uint32_t	portalCount;
+};
+
+// An opening from the owning cell into `target`, a convex quad
+struct VisPortal {
+	Float3		verts[4];
+	uint32_t	target;
+};
+
+// A cell reached by the portal walk, with the frustum it was seen through
+struct VisibleCell {
+	uint32_t	cell;
+	Frustum		frustum;
+};
+
+//================================================================
+
+//
+// Cell/portal visibility with a precomputed potentially-visible set.
+//
+// Rejecting a cell is a single bit test in the camera cell's PVS row.
+// Cells that pass are then walked through their portals from the camera
+// cell, narrowing the view frustum to each portal's silhouette, so
+// objects outside the openings are culled even inside a visible cell.
+//
+class CellVisibility {
+public:
+	static constexpr uint32_t INVALID_CELL	= 0xFFFFFFFFU;
+	static constexpr size_t MAX_DEPTH		= 16U;	// Portal walk recursion limit
+
+	// Default Constructor
+	CellVisibility() = default;
+
+	// Destructor
+	~CellVisibility() noexcept = default;
+
+	void clear() noexcept;
+
+	// Portal ranges and targets of untrusted data (a loaded file) all in bounds
+	static bool validate(const VisCell* cells, size_t cellCount, const VisPortal* portals, size_t portalCount) noexcept;
+
+	// Build from baked data, `portals` grouped by owner as `cells` describe
+	void assign(std::vector<VisCell>&& cells, std::vector<VisPortal>&& portals, std::vector<uint32_t>&& pvs);
+
+	// Cell containing `p`, or INVALID_CELL when outside the level
+	uint32_t findCell(const Float3& p) const noexcept;
+
+	// O(1) PVS lookup
+	inline bool potentiallyVisible(uint32_t from, uint32_t to) const noexcept {
+		const uint32_t bit = from * mRowWords * 32U + to;
+		return (mPvs[bit >> 5] >> (bit & 31U)) & 1U;
+	}
+
+	//
+	// Walk the portal graph from `cameraCell`, appending every reachable
+	// cell with its narrowed frustum to `out`. A cell reached again through
+	// an opening that lies inside a frustum it already has is not walked a
+	// second time, so a cell appears once per distinct view into it rather
+	// than once per path. Returns false if the camera is outside the cell
+	// set, callers should then fall back to the frustum. Uses per-cell
+	// scratch, don't call concurrently on one instance.
+	//
+	bool gatherVisible(uint32_t cameraCell, const Float3& eye, const Frustum& view, std::vector<VisibleCell>& out) const;
+
+	inline bool empty() const noexcept { return mCells.empty(); }
+	inline size_t cellCount() const noexcept { return mCells.size(); }
+	inline size_t portalCount() const noexcept { return mPortals.size(); }
+	inline const VisCell& cell(size_t i) const noexcept { return mCells[i]; }
+	inline const VisPortal& portal(size_t i) const noexcept { return mPortals[i]; }
+	inline const std::vector<uint32_t>& pvsBits() const noexcept { return mPvs; }
+	constexpr inline uint32_t pvsRowWords() const noexcept { return mRowWords; }
+
+	// Words per PVS row for a set of `cellCount` cells
+	static constexpr uint32_t rowWords(size_t cellCount) noexcept {
+		return static_cast<uint32_t>((cellCount + 31U) / 32U);
+	}
+
+private:
+	// Per-cell walk state, valid while `generation` matches the current walk
+	struct CellVisit {
+		uint32_t	generation;
+		uint32_t	latest;		// Newest entry of the cell in `out`
+	};
+
+	// Per-entry walk state, parallel to the walk's part of `out`
+	struct EntryVisit {
+		uint32_t	previous;	// Older entry of the same cell, or INVALID_CELL
+		uint32_t	depth;
+	};
+
+	void walk(uint32_t cell, const Float3& eye, const Frustum& frustum, uint32_t cameraCell,
+		size_t depth, uint32_t* path, std::vector<VisibleCell>& out) const;
+
+	// An earlier entry of `cell` at no greater depth already sees all of `poly`
+	bool alreadySeen(uint32_t cell, const Float3* poly, size_t count, size_t depth, const std::vector<VisibleCell>& out) const noexcept;
+
+	std::vector<VisCell>	mCells;
+	std::vector<VisPortal>	mPortals;
+	std::vector<uint32_t>	mPvs;			// cellCount rows of mRowWords words
+	uint32_t				mRowWords = 0;
+
+	// Walk scratch
+	mutable std::vector<CellVisit>	mVisits;
+	mutable std::vector<EntryVisit>	mEntries;
+	mutable size_t					mOutBase = 0;
+	mutable uint32_t				mGeneration = 0;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_SCENE_CELL_VISIBILITY_HH
+//////////////////////////////////////////////////////////////////
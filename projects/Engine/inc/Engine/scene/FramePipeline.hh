@@ -0,0 +1,147 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_SCENE_FRAME_PIPELINE_HH
+#define DD25_ENGINE_SCENE_FRAME_PIPELINE_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+#include "../core/Jobs.hh"
+#include "../gfx/CommandQueue.hh"
+#include "../gfx/StreamVertexBuffer.hh"
+#include "../math/Geometry.hh"
+#include "Camera.hh"
+#include "Scene.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//================================================================
+
+//
+// Everything the render side needs to draw one simulated frame. The
+// simulation fills it between `FramePipeline::acquire()` and `submit()`,
+// after which it belongs to the render side and nothing in it changes
+// (executing the queue only updates the queue's own counters).
+//
+// DrawCommand transforms may point into `transforms`: the vector is not
+// touched again until the packet comes back to the simulation, so fill
+// it completely before submitting draws.
+//
+struct FramePacket {
+	uint64_t						frame;			// Simulation frame that built it, from 0
+	Camera							camera;
+	std::vector<Scene::ObjectId>	visible;
+	std::vector<Float4x4>			transforms;		// Object -> world, parallel to `visible`
+	CommandQueue					queue;			// Sorted by `submit()`
+	uint64_t						streamFence;	// Retired once rendered, 0 without a stream
+	float							simulateMs;		// From `acquire()` returning to `submit()`
+
+	// Constructor
+	FramePacket(uint32_t maxCommands, size_t arenaBytes)
+		: frame(0)
+		, queue(maxCommands, arenaBytes)
+		, streamFence(0)
+		, simulateMs(0.0f) {}
+};
+
+//================================================================
+
+struct FramePipelineSettings {
+	bool					threaded		= DD25_JOBS_THREADED;	// Render on a thread of its own
+	uint32_t				maxCommands		= 16384U;				// Per packet queue
+	size_t					arenaBytes		= 1U << 20;
+	StreamVertexBuffer*		stream			= nullptr;				// Framed per packet when set
+};
+
+// Latest frame on each side
+struct FramePipelineStats {
+	uint64_t	submitted;		// Packets handed to the render side
+	uint64_t	rendered;		// Packets it has finished
+	float		simulateMs;		// Last packet's simulation time
+	float		renderMs;		// Last packet's render callback
+	float		simulateWaitMs;	// Last `acquire()` blocked on the render side
+	float		renderWaitMs;	// Render thread idle before the last packet
+};
+
+//================================================================
+
+//
+// Double-buffered simulation / render frame loop.
+//
+// The simulation thread (the caller) acquires a packet, culls and
+// records into it and submits it; the render side then runs the render
+// callback on it while the simulation builds the next one in the other
+// packet, so simulation and submission of consecutive frames overlap.
+// `acquire()` only waits when the render side is still on the packet
+// from two frames back, which bounds latency to one frame.
+//
+// With a stream set, `acquire()` begins a stream frame, `submit()` ends
+// it and the render side retires it after the callback; the stream needs
+// at least PACKETS frames in flight for the two sides never to stall on
+// each other (the default three does).
+//
+// The same goes for anything else a packet's draws point at: vertex
+// buffers, textures and materials recorded in frame N may be read until
+// frame N + PACKETS is acquired, so the simulation must not write, move
+// or free them before then. Caches that rewrite or evict buffers while
+// the simulation runs (TileMap, VectorCache) hold on to them for their
+// FRAMES_IN_FLIGHT, which is at least PACKETS.
+//
+// When `threaded` is off, or on targets without threads (see
+// DD25_JOBS_THREADED), `submit()` renders inline and the same calling
+// code runs one frame after the other.
+//
+class FramePipeline {
+public:
+	static constexpr uint32_t PACKETS = 2U;
+
+	using RenderFn = std::function<void(FramePacket& packet)>;
+
+	// Constructor, `render` is called on the render thread once per packet in order
+	explicit FramePipeline(RenderFn render, const FramePipelineSettings& settings = {});
+
+	// Destructor (renders what was submitted, then joins)
+	~FramePipeline() noexcept;
+
+	FramePipeline(const FramePipeline&) = delete;
+	FramePipeline& operator=(const FramePipeline&) = delete;
+
+	// Next packet to fill, emptied; waits while the render side still has it
+	FramePacket& acquire();
+
+	// Sort the acquired packet's queue and hand it to the render side
+	void submit();
+
+	// Wait until every submitted packet has been rendered
+	void flush();
+
+	// Rendering on its own thread
+	bool threaded() const noexcept;
+
+	FramePipelineStats stats() const;
+
+	constexpr inline const FramePipelineSettings& settings() const noexcept { return mSettings; }
+
+private:
+	struct Impl;
+
+	// Run the callback and give the stream frame back, returns the callback's time
+	float render(FramePacket& packet);
+
+	FramePipelineSettings	mSettings;
+	RenderFn				mRender;
+	FramePacket*			mBuilding;		// Between `acquire()` and `submit()`
+	uint64_t				mFrame;			// Next frame to acquire
+	std::unique_ptr<Impl>	mImpl;			// Packets and the render thread
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_SCENE_FRAME_PIPELINE_HH
+//////////////////////////////////////////////////////////////////
@@ -9,10 +9,17 @@
 //////////////////////////////////////////////////////////////////
 
 #include "../core/core.hh"
+#include "MeshLod.hh"
+#include "../math/Geometry.hh"
 
 // Include Third-Party Library Headers
 #include <sh4zam/shz_sh4zam.hpp>
 
+#include <vector>
+
+struct GfxVertex;
+class IVertexBuffer;
+
 //================================================================
 
 using Point2d			= shz::vec2;
@@ -94,14 +101,60 @@ public:
 	// Destructor
 	~Mesh() noexcept;
 
+	//
+	// Point the mesh at vertex and index data owned elsewhere (a loaded
+	// scene file or an Editor buffer). The mesh never frees these arrays.
+	// `normals` and `uvs` may be null.
+	//
+	void bind(size_t vertexCount, const Float3* positions, const Float3* normals, const Float2* uvs,
+		const uint16_t* indices, size_t indexCount) noexcept;
+
+	constexpr inline size_t vertexCount() const noexcept { return mLen; }
+	constexpr inline size_t indexCount() const noexcept { return mIndexCount; }
+	inline const Float3* positions() const noexcept { return reinterpret_cast<const Float3*>(mVerts); }
+	inline const Float3* normals() const noexcept { return reinterpret_cast<const Float3*>(mNormals); }
+	inline const Float2* uvs() const noexcept { return reinterpret_cast<const Float2*>(mUVs); }
+	constexpr inline const uint16_t* indices() const noexcept { return mIDs; }
+
+	// Level of detail chain (baked by the Editor, level 0 = full detail)
+	inline MeshLodChain& lods() noexcept { return mLods; }
+	inline const MeshLodChain& lods() const noexcept { return mLods; }
+
+	//
+	// Expand every level (the whole index list without LODs) into
+	// non-indexed vertices appended to `out`, one per index, and record
+	// where each level starts. Upload `out` and pass the buffer to
+	// `setDrawBuffer()`.
+	//
+	void expandLevels(std::vector<GfxVertex>& out, uint32_t color);
+
+	//
+	// Vertex buffer the mesh is drawn from, owned elsewhere. `levelFirst`
+	// gives the first vertex of each level's run (null keeps the ranges
+	// from `expandLevels()`), a level draws one vertex per index.
+	//
+	void setDrawBuffer(const IVertexBuffer* buffer, const uint32_t* levelFirst = nullptr, size_t levels = 0) noexcept;
+
+	constexpr inline const IVertexBuffer* drawBuffer() const noexcept { return mDrawBuffer; }
+	constexpr inline uint32_t drawFirst(uint8_t lod) const noexcept { return mDrawFirst[lod]; }
+	inline uint32_t drawCount(uint8_t lod) const noexcept {
+		return (mLods.levelCount() > 0) ? mLods.level(lod).indexCount : static_cast<uint32_t>(mIndexCount);
+	}
+
 private:
-	size_t		mLen;
-	Vertex*		mVerts;
-	shz_vec2*	mWeights;
-	shz_vec3*	mNormals;
-	UV*			mUVs;
-	uint16_t*	mIDs;
-	Matrix4 	mObjMatrix;
+	size_t			mLen;
+	Vertex*			mVerts;
+	shz_vec2*		mWeights;
+	shz_vec3*		mNormals;
+	UV*				mUVs;
+	uint16_t*		mIDs;
+	size_t			mIndexCount;
+	Matrix4 		mObjMatrix;
+	MeshLodChain	mLods;
+
+	// Draw data
+	const IVertexBuffer*	mDrawBuffer;
+	uint32_t				mDrawFirst[MeshLodChain::MAX_LEVELS];
 };
 
 //////////////////////////////////////////////////////////////////
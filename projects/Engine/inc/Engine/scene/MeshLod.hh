@@ -0,0 +1,130 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_SCENE_MESH_LOD_HH
+#define DD25_ENGINE_SCENE_MESH_LOD_HH
+//////////////////////////////////////////////////////////////////
+
+#include "../core/core.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+//
+// A single level of detail. Every level indexes the same vertex data as
+// level 0, only the index list differs (half-edge collapse never creates
+// new vertices), so a chain costs index memory only.
+//
+struct MeshLodLevel {
+	uint32_t	firstIndex;		// Offset into the chain's shared index list
+	uint32_t	indexCount;		// Number of indices (3 per triangle)
+	float		error;			// Object-space geometric error introduced by this level
+	float		screenSize;		// Switch to this level below this projected radius (pixels)
+};
+
+//================================================================
+
+class MeshLodChain {
+public:
+	static constexpr size_t MAX_LEVELS = 8U;
+
+	// Default Constructor
+	MeshLodChain() = default;
+
+	// Destructor
+	~MeshLodChain() noexcept = default;
+
+	inline void clear() noexcept {
+		mIndices.clear();
+		mExternal = nullptr;
+		mCount = 0;
+	}
+
+	//
+	// Reference levels and indices that live elsewhere (a loaded scene
+	// file) instead of copying them. The data must outlive the chain.
+	//
+	void assignExternal(const MeshLodLevel* levels, size_t count, const uint16_t* indices) noexcept {
+		mIndices.clear();
+		mCount = (count < MAX_LEVELS) ? count : MAX_LEVELS;
+		for (size_t i = 0; i < mCount; ++i) {
+			mLevels[i] = levels[i];
+		}
+		mExternal = indices;
+	}
+
+	// Append the next (coarser) level, returns false when the chain is full
+	bool addLevel(const uint16_t* indices, uint32_t indexCount, float error) {
+		if (mCount >= MAX_LEVELS || mExternal) {
+			return false;
+		}
+		MeshLodLevel& lvl = mLevels[mCount++];
+		lvl.firstIndex = static_cast<uint32_t>(mIndices.size());
+		lvl.indexCount = indexCount;
+		lvl.error = error;
+		lvl.screenSize = 0.0f;
+		mIndices.insert(mIndices.end(), indices, indices + indexCount);
+		return true;
+	}
+
+	//
+	// Derive the per-level switch sizes from the simplification error.
+	// A level is used once its error projects to less than `pixelError`
+	// pixels, i.e. when the bounds' projected radius drops below
+	// `pixelError * radius / error`.
+	//
+	void computeScreenSizes(float boundsRadius, float pixelError) noexcept {
+		float prev = 1.0e30f;
+		for (size_t i = 0; i < mCount; ++i) {
+			MeshLodLevel& lvl = mLevels[i];
+			float size = prev;
+			if (i > 0 && lvl.error > 0.0f) {
+				size = pixelError * boundsRadius / lvl.error;
+			}
+			// Keep thresholds monotonic, coarser levels never switch in earlier
+			lvl.screenSize = prev = (size < prev) ? size : prev;
+		}
+	}
+
+	//
+	// Pick a level for the given projected radius (pixels), starting from
+	// the level used last frame. `hysteresis` widens each threshold by
+	// that fraction in the direction of travel, so objects sitting right
+	// on a boundary don't pop back and forth every frame.
+	//
+	inline uint8_t select(float screenSize, uint8_t current, float hysteresis) const noexcept {
+		if (mCount == 0) {
+			return 0;
+		}
+		uint8_t lod = (current < mCount) ? current : static_cast<uint8_t>(mCount - 1);
+		while ((lod + 1U) < mCount && screenSize < mLevels[lod + 1].screenSize * (1.0f - hysteresis)) {
+			++lod;
+		}
+		while (lod > 0 && screenSize > mLevels[lod].screenSize * (1.0f + hysteresis)) {
+			--lod;
+		}
+		return lod;
+	}
+
+	constexpr inline size_t levelCount() const noexcept { return mCount; }
+	constexpr inline const MeshLodLevel& level(size_t i) const noexcept { return mLevels[i]; }
+	inline const uint16_t* indices(size_t i) const noexcept { return (mExternal ? mExternal : mIndices.data()) + mLevels[i].firstIndex; }
+	constexpr inline bool isExternal() const noexcept { return mExternal != nullptr; }
+	inline uint32_t triangleCount(size_t i) const noexcept { return mLevels[i].indexCount / 3U; }
+
+private:
+	std::vector<uint16_t>	mIndices;			// Owned storage (built in the Editor)
+	const uint16_t*			mExternal = nullptr;	// Set when referencing a loaded file
+	MeshLodLevel			mLevels[MAX_LEVELS] = {};
+	size_t					mCount = 0;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_SCENE_MESH_LOD_HH
+//////////////////////////////////////////////////////////////////
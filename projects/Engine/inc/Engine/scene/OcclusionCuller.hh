@@ -0,0 +1,122 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_SCENE_OCCLUSION_CULLER_HH
+#define DD25_ENGINE_SCENE_OCCLUSION_CULLER_HH
+//////////////////////////////////////////////////////////////////
+
+#include "Mesh.hh"
+#include "Camera.hh"
+#include "../math/Geometry.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+// Per-frame occlusion counters, reset by `OcclusionCuller::render()`
+struct OcclusionStats {
+	uint32_t	occluders;				// Occluders in the frustum
+	uint32_t	trianglesRasterized;	// After near clipping
+	uint32_t	tested;					// Bounds tested
+	uint32_t	culled;					// Bounds found hidden
+	float		rasterMs;				// Transform, bin, rasterize, build the hierarchy
+	float		testMs;
+
+	inline float culledPercent() const noexcept { return tested ? 100.0f * static_cast<float>(culled) / static_cast<float>(tested) : 0.0f; }
+};
+
+//================================================================
+
+//
+// Software occlusion culling against a small depth buffer.
+//
+// Occluder triangles are transformed and near-clipped, binned into
+// TILE_WIDTH x TILE_HEIGHT screen tiles and rasterized a tile per job,
+// so no two threads ever touch the same pixels. Rows are processed four
+// pixels at a time with SIMD edge functions. Each tile then reduces its
+// pixels to a BLOCK_SIZE x BLOCK_SIZE hierarchy of farthest depths, and
+// bounds are tested against that: an object is hidden when its nearest
+// depth lies behind every covered block. Only pixel centres are written,
+// so the buffer never claims more occlusion than the occluders provide.
+//
+class OcclusionCuller {
+public:
+	static constexpr uint32_t TILE_WIDTH	= 32U;
+	static constexpr uint32_t TILE_HEIGHT	= 32U;
+	static constexpr uint32_t BLOCK_SIZE	= 4U;
+
+	// Default Constructor
+	OcclusionCuller();
+
+	// Destructor
+	~OcclusionCuller() noexcept;
+
+	// Depth buffer size, rounded up to whole tiles (default 256x128)
+	void setResolution(uint32_t width, uint32_t height);
+
+	//
+	// Register an occluder, normally a simplified stand-in for a large
+	// object (walls, terrain, buildings). Vertex and index data are
+	// referenced, not copied. Returns the occluder index.
+	//
+	uint32_t addOccluder(const Mesh* mesh, const Float4x4& toWorld);
+	void clearOccluders() noexcept;
+
+	// Rasterize every occluder in the camera's frustum
+	void render(const Camera& camera);
+
+	// True when `bounds` is definitely hidden behind the last render()
+	bool isOccluded(const Sphere& bounds) const noexcept;
+
+	//
+	// Drop hidden entries from `ids` (indices into `bounds`) in place,
+	// keeping order. Returns the number left and updates the test stats.
+	//
+	size_t filter(const Sphere* bounds, uint32_t* ids, size_t count) noexcept;
+
+	constexpr inline uint32_t width() const noexcept { return mWidth; }
+	constexpr inline uint32_t height() const noexcept { return mHeight; }
+	inline size_t occluderCount() const noexcept { return mOccluders.size(); }
+	inline const float* depth() const noexcept { return mDepth.data(); }
+	constexpr inline const OcclusionStats& stats() const noexcept { return mStats; }
+
+private:
+	struct Occluder {
+		const Mesh*		mesh;
+		Float4x4		toWorld;
+		Aabb			bounds;		// World space
+	};
+
+	// Screen-space triangle (x, y in pixels, z in [0, 1])
+	struct ScreenTri {
+		Float3			v[3];
+	};
+
+	void transform(const Occluder& occ, ScreenTri* out, uint32_t& count) const noexcept;
+	void rasterizeTile(uint32_t tile) noexcept;
+
+	std::vector<Occluder>			mOccluders;
+	std::vector<uint32_t>			mVisibleOccluders;
+	std::vector<uint32_t>			mTriFirst;		// Per visible occluder offset into mTris
+	std::vector<uint32_t>			mTriCount;
+	std::vector<ScreenTri>			mTris;
+	std::vector<std::vector<uint32_t>>	mTileBins;		// Triangle indices per tile
+	std::vector<float>				mDepth;			// Nearest depth per pixel, 1 = empty
+	std::vector<float>				mHiZ;			// Farthest depth per block
+	Float4x4						mViewProj;
+	uint32_t						mWidth;
+	uint32_t						mHeight;
+	uint32_t						mTilesX;
+	uint32_t						mTilesY;
+	uint32_t						mBlocksX;
+	OcclusionStats					mStats;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_SCENE_OCCLUSION_CULLER_HH
+//////////////////////////////////////////////////////////////////
@@ -9,19 +9,178 @@
 //////////////////////////////////////////////////////////////////
 
 #include "Mesh.hh"
+#include "Camera.hh"
+#include "CellVisibility.hh"
+#include "OcclusionCuller.hh"
+#include "SceneChunk.hh"
+#include "../core/StringId.hh"
+#include "../math/Geometry.hh"
+
+#include <vector>
+
+class ICommandQueue;
+class IMaterial;
+
+//================================================================
+
+// Per-frame level of detail counters, reset by `Scene::selectLods()`
+struct SceneLodStats {
+	uint32_t	objects;								// Objects considered
+	uint32_t	trianglesSubmitted;						// Triangles at the selected levels
+	uint32_t	trianglesFullDetail;					// Triangles had every object used level 0
+	uint32_t	lodChanges;								// Objects that switched level this frame
+	uint32_t	objectsPerLod[MeshLodChain::MAX_LEVELS];	// Distribution over levels
+};
+
+// Per-frame visibility counters, reset by `Scene::cull()`
+struct SceneVisStats {
+	uint32_t	objects;			// Objects considered
+	uint32_t	frustumVisible;		// Would be submitted with frustum culling alone
+	uint32_t	submitted;			// Submitted after PVS, portal narrowing and occlusion
+	uint32_t	pvsRejected;		// Rejected by the O(1) PVS test
+	uint32_t	cellsVisited;		// Cell entries produced by the portal walk
+	uint32_t	occlusionCulled;	// Removed by the software depth buffer
+};
+
+// Filled by `Scene::load()`
+struct SceneLoadStats {
+	size_t		fileBytes;		// Size of the scene file
+	size_t		copiedBytes;	// Bytes copied out of it (per-object and cell tables)
+	uint32_t	meshes;
+	uint32_t	objects;
+	bool		mapped;			// Memory mapped (true) or a single aligned read
+	double		seconds;		// Open, validate and bind
+};
 
 //================================================================
 
 class Scene {
 public:
+	using ObjectId = uint32_t;
+
+	static constexpr ObjectId INVALID_OBJECT = 0xFFFFFFFFU;
+
 	// Default Constructor
 	Scene();
 
 	// Destructor
 	~Scene() noexcept;
 
+	// Remove every object, visibility and any loaded file
+	void clear();
+
+	//
+	// Load a cooked scene file (see io/SceneFile.hh). Vertex, index and LOD
+	// data are used in place from the mapped file, only the small mutable
+	// per-object and cell tables are copied out.
+	//
+	bool load(const char* path);
+
+	// Register a mesh instance with its world-space bounds
+	ObjectId addObject(const Mesh* mesh, const Sphere& worldBounds, StringId name = StringId());
+
+	//
+	// Append every object of an open chunk, returns the first new id (they
+	// are consecutive). The chunk must stay open until its objects are
+	// removed again.
+	//
+	ObjectId addObjects(const SceneChunk& chunk);
+
+	//
+	// Remove `count` objects starting at `first`. Later objects move down
+	// by `count`, so ids above the removed range change.
+	//
+	void removeObjects(ObjectId first, size_t count);
+
+	// First object called `name`, or INVALID_OBJECT
+	ObjectId findObject(StringId name) const noexcept;
+
+	// Update the world-space bounds of an object (after it moved)
+	void setObjectBounds(ObjectId id, const Sphere& worldBounds) noexcept;
+
+	// Pick a level of detail per visible object from its projected size, call after `cull()`
+	void selectLods(const Camera& camera) noexcept;
+
+	//
+	// Record a draw per visible object at its selected level of detail.
+	// `transforms` runs parallel to `visibleObjects()` (null = identity)
+	// and must outlive the queue's frame, depth is the eye distance over
+	// `farDistance`. Objects whose mesh has no draw buffer are skipped.
+	// Returns the number of draws recorded.
+	//
+	uint32_t submit(ICommandQueue& queue, const Camera& camera, float farDistance, const Float4x4* transforms = nullptr,
+		const IMaterial* material = nullptr, uint8_t pass = 0) const;
+
+	// Install baked cell/portal visibility, objects are re-assigned to cells
+	void setVisibility(CellVisibility&& visibility);
+
+	//
+	// Build the visible object list for `camera`. With visibility data the
+	// camera cell's PVS rejects cells first, then objects are tested against
+	// the portal-narrowed frusta of the cells they overlap. Without it (or
+	// with the camera outside every cell) this is plain frustum culling.
+	// Survivors are then tested against the occluders, when enabled.
+	//
+	void cull(const Camera& camera);
+
+	// Occluders live in the culler, see `occlusion().addOccluder()`
+	inline void setOcclusionCulling(bool enable) noexcept { mOcclusionEnabled = enable; }
+	inline OcclusionCuller& occlusion() noexcept { return mOcclusion; }
+
+	// Fraction each LOD threshold is widened by to avoid popping (default 10%)
+	inline void setLodHysteresis(float fraction) noexcept { mLodHysteresis = fraction; }
+
+	constexpr inline float lodHysteresis() const noexcept { return mLodHysteresis; }
+	inline size_t objectCount() const noexcept { return mMeshes.size(); }
+	inline const Mesh* objectMesh(ObjectId id) const noexcept { return mMeshes[id]; }
+	inline const Sphere& objectBounds(ObjectId id) const noexcept { return mBounds[id]; }
+	inline uint8_t objectLod(ObjectId id) const noexcept { return mLods[id]; }
+	inline StringId objectName(ObjectId id) const noexcept { return mNames[id]; }
+	constexpr inline const SceneFile& file() const noexcept { return mFile.file(); }
+	constexpr inline const SceneLoadStats& loadStats() const noexcept { return mLoadStats; }
+	constexpr inline const SceneLodStats& lodStats() const noexcept { return mLodStats; }
+	constexpr inline const CellVisibility& visibility() const noexcept { return mVisibility; }
+	inline const std::vector<ObjectId>& visibleObjects() const noexcept { return mVisible; }
+	constexpr inline const SceneVisStats& visStats() const noexcept { return mVisStats; }
+	constexpr inline bool occlusionCulling() const noexcept { return mOcclusionEnabled; }
+	constexpr inline const OcclusionCuller& occlusion() const noexcept { return mOcclusion; }
+
 private:
+	// Cells an object's bounds overlap, more than MAX_CELLS is treated as exterior
+	struct ObjectCells {
+		static constexpr size_t MAX_CELLS = 4U;
+		uint32_t	cells[MAX_CELLS];
+		uint32_t	count;		// 0 = exterior, always frustum tested
+	};
+
+	void assignCells(ObjectId id) noexcept;
+
+	// Objects (SoA, indexed by ObjectId)
+	std::vector<const Mesh*>	mMeshes;
+	std::vector<Sphere>			mBounds;
+	std::vector<uint8_t>		mLods;
+	std::vector<ObjectCells>	mObjCells;
+	std::vector<StringId>		mNames;
+
+	// Loaded scene file and the meshes bound into it
+	SceneChunk					mFile;
+	SceneLoadStats				mLoadStats;
+
+	float						mLodHysteresis;
+	SceneLodStats				mLodStats;
+
+	// Visibility
+	CellVisibility				mVisibility;
+	std::vector<VisibleCell>	mVisibleCells;		// Portal walk output
+	std::vector<uint32_t>		mCellFirst;			// Per cell offset into mCellEntries (CSR)
+	std::vector<uint32_t>		mCellEntries;		// Indices into mVisibleCells
+	std::vector<uint32_t>		mCellFill;			// Scratch for building mCellEntries
+	std::vector<ObjectId>		mVisible;
+	SceneVisStats				mVisStats;
 
+	// Occlusion
+	OcclusionCuller				mOcclusion;
+	bool						mOcclusionEnabled;
 };
 
 //////////////////////////////////////////////////////////////////
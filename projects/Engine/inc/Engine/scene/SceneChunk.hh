@@ -0,0 +1,71 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_SCENE_CHUNK_HH
+#define DD25_ENGINE_SCENE_CHUNK_HH
+//////////////////////////////////////////////////////////////////
+
+#include "Mesh.hh"
+#include "../core/StringId.hh"
+#include "../io/SceneFile.hh"
+#include "../math/Geometry.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+//================================================================
+
+//
+// A cooked scene file with its meshes bound in place and its object
+// tables bounds-checked. Opening touches no shared state, so chunks can
+// be opened on a worker thread and handed to `Scene::addObjects()` later.
+//
+class SceneChunk {
+public:
+	// Default Constructor
+	SceneChunk() = default;
+
+	// Destructor
+	~SceneChunk() noexcept = default;
+
+	SceneChunk(const SceneChunk&) = delete;
+	SceneChunk& operator=(const SceneChunk&) = delete;
+
+	// Open, validate and bind `path` (`map` = false reads it up front)
+	bool open(const char* path, bool map = true);
+
+	void close() noexcept;
+
+	constexpr inline bool isOpen() const noexcept { return mFile.isOpen(); }
+	constexpr inline const SceneFile& file() const noexcept { return mFile; }
+
+	constexpr inline size_t meshCount() const noexcept { return mMeshCount; }
+	inline const Mesh& mesh(size_t i) const noexcept { return mMeshes[i]; }
+
+	constexpr inline size_t objectCount() const noexcept { return mObjectCount; }
+	inline const Sphere& objectBounds(size_t i) const noexcept { return mBounds[i]; }
+	inline const Mesh* objectMesh(size_t i) const noexcept { return (mObjMeshes[i] < mMeshCount) ? &mMeshes[mObjMeshes[i]] : nullptr; }
+	inline StringId objectName(size_t i) const noexcept { return mNames ? mNames[i] : StringId(); }
+
+	// Memory held while open (file data plus mesh headers)
+	inline size_t residentBytes() const noexcept { return mFile.file().size() + mMeshCount * sizeof(Mesh); }
+
+private:
+	bool bind();
+
+	SceneFile				mFile;
+	std::unique_ptr<Mesh[]>	mMeshes;
+	size_t					mMeshCount		= 0;
+	const Sphere*			mBounds			= nullptr;
+	const uint32_t*			mObjMeshes		= nullptr;
+	const StringId*			mNames			= nullptr;
+	size_t					mObjectCount	= 0;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_SCENE_CHUNK_HH
+//////////////////////////////////////////////////////////////////
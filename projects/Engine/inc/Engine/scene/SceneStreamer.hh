@@ -0,0 +1,147 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_ENGINE_SCENE_STREAMER_HH
+#define DD25_ENGINE_SCENE_STREAMER_HH
+//////////////////////////////////////////////////////////////////
+
+#include "Scene.hh"
+#include "SceneChunk.hh"
+#include "../core/Jobs.hh"
+#include "../math/Geometry.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+//================================================================
+
+// One streamable region of a level, a cooked scene file (see io/SceneFile.hh)
+struct StreamChunkDesc {
+	std::string		path;
+	Aabb			bounds;		// World space, covers every object in the chunk
+	size_t			bytes;		// Expected resident size (0 = learnt on first load)
+};
+
+struct SceneStreamSettings {
+	float		loadRadius			= 64.0f;				// Request chunks closer than this to the camera
+	float		lookAhead			= 1.0f;					// Seconds of camera motion to predict ahead
+	size_t		memoryBudget		= 8U * 1024U * 1024U;	// Resident + in-flight bytes
+	size_t		maxBytesInFlight	= 1024U * 1024U;		// Outstanding I/O
+	size_t		ioBytesPerSecond	= 0;					// Read bandwidth cap, 0 = unlimited
+	float		commitBudgetMs		= 1.0f;					// Main thread time per frame
+	uint32_t	retryFrames			= 60U;					// Before a failed read is tried again, doubling per failure
+};
+
+//
+// Streaming counters. "frame" fields are reset by every `update()`, the
+// rest are running totals since `setChunks()`.
+//
+struct SceneStreamStats {
+	uint32_t	resident;			// Chunks whose objects are in the scene
+	uint32_t	inFlight;			// Chunks queued or loading
+	uint32_t	pending;			// Chunks loaded and waiting for a commit slot
+	size_t		bytesResident;
+	size_t		bytesInFlight;
+	size_t		peakBytesInFlight;
+	uint64_t	bytesRead;
+	uint32_t	requested;
+	uint32_t	committed;
+	uint32_t	evicted;
+	uint32_t	failed;
+	uint32_t	retries;			// Failed chunks made requestable again
+	uint32_t	budgetDeferred;		// Requests held back by the memory budget (frame)
+	uint32_t	stalls;				// Frames the camera stood in a chunk that wasn't resident
+	uint32_t	hitches;			// Frames where `update()` ran over the commit budget
+	float		updateMs;			// Main thread time of the last `update()` (frame)
+	float		maxUpdateMs;
+};
+
+//================================================================
+
+//
+// Streams scene chunks in and out of a `Scene` around the camera.
+//
+// Chunks near the camera, or near where it will be `lookAhead` seconds
+// from now, are queued nearest first. An I/O worker reads each one and
+// validates/binds it off the main thread (`SceneChunk::open()`), then
+// `update()` commits finished chunks into the scene within the per-frame
+// time budget. When the memory budget is reached the least recently
+// wanted chunks are evicted. Targets without worker threads
+// (DD25_JOBS_THREADED = 0) service one request inside each `update()`.
+//
+// A chunk that fails to read (disc swap, slow media) is requested again
+// after `retryFrames`, twice as long after each further failure up to
+// 16x; `unloadAll()` forgets the failures.
+//
+// Committing appends the chunk's objects to the scene and evicting
+// removes them, so ids of objects added after a chunk shift when it goes.
+//
+class SceneStreamer {
+public:
+	// Default Constructor
+	SceneStreamer();
+
+	// Destructor (waits for the I/O worker)
+	~SceneStreamer() noexcept;
+
+	SceneStreamer(const SceneStreamer&) = delete;
+	SceneStreamer& operator=(const SceneStreamer&) = delete;
+
+	//
+	// Replace the chunk list. Call `unloadAll()` on the scene the previous
+	// chunks were committed to first.
+	//
+	void setChunks(const std::vector<StreamChunkDesc>& chunks);
+
+	inline void setSettings(const SceneStreamSettings& settings) noexcept { mSettings = settings; }
+
+	// Request, commit and evict around `camera`, `dt` in seconds
+	void update(Scene& scene, const Camera& camera, float dt);
+
+	// Remove every committed chunk from `scene` and drop loaded data
+	void unloadAll(Scene& scene);
+
+	// Block until nothing is queued or loading (loading screens, tests)
+	void flush();
+
+	constexpr inline const SceneStreamSettings& settings() const noexcept { return mSettings; }
+	constexpr inline size_t chunkCount() const noexcept { return mChunkCount; }
+	bool isResident(size_t chunk) const noexcept;
+	constexpr inline const SceneStreamStats& stats() const noexcept { return mStats; }
+
+private:
+	struct Chunk;
+	struct Worker;
+
+	void request(Scene& scene, const Float3& position, const Float3& predicted);
+	void commit(Scene& scene, double budgetEnd, uint32_t cameraChunk);
+	void attach(Scene& scene, Chunk& chunk);
+	size_t evictOne(Scene& scene);
+	void evict(Scene& scene, Chunk& chunk);
+
+	// I/O side, runs on the worker (or inline without threads)
+	Chunk* nextQueued() noexcept;
+	void service(Chunk& chunk);
+
+	std::unique_ptr<Chunk[]>	mChunks;
+	size_t						mChunkCount;
+	std::vector<uint32_t>		mCandidates;		// Request scratch
+	std::unique_ptr<Worker>		mWorker;
+	SceneStreamSettings			mSettings;
+	SceneStreamStats			mStats;
+	uint64_t					mCommittedBytes;	// For estimating chunks never loaded
+	uint32_t					mFrame;
+	Float3						mLastPosition;
+	Float3						mVelocity;
+	bool						mHasPosition;
+};
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_ENGINE_SCENE_STREAMER_HH
+//////////////////////////////////////////////////////////////////
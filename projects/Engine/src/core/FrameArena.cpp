@@ -0,0 +1,30 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/core/FrameArena.hh>
+
+#include <cstdlib>
+
+//================================================================
+
+FrameArena::FrameArena(size_t capacity)
+	: mData(nullptr)
+	, mCapacity(0)
+	, mUsed(0)
+	, mHighWater(0) {
+	const size_t padded = (capacity + ALIGNMENT - 1U) & ~(ALIGNMENT - 1U);
+#if defined(_MSC_VER)
+	mData = static_cast<uint8_t*>(_aligned_malloc(padded, ALIGNMENT));
+#else
+	mData = static_cast<uint8_t*>(std::aligned_alloc(ALIGNMENT, padded));
+#endif//_MSC_VER
+	mCapacity = mData ? padded : 0;
+}
+
+FrameArena::~FrameArena() noexcept {
+#if defined(_MSC_VER)
+	_aligned_free(mData);
+#else
+	std::free(mData);
+#endif//_MSC_VER
+}
@@ -0,0 +1,190 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/core/Jobs.hh>
+
+#if DD25_JOBS_THREADED
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif//DD25_JOBS_THREADED
+
+//================================================================
+
+namespace {
+thread_local size_t		tThreadIndex	= 0;
+thread_local bool		tInJob			= false;
+} // namespace
+
+#if DD25_JOBS_THREADED
+
+struct JobSystem::Impl {
+	std::vector<std::thread>	threads;
+	std::mutex					lock;		// Guards the fields below
+	std::condition_variable		wake;
+	std::condition_variable		done;
+	std::mutex					submit;		// One loop in flight at a time
+	const RangeFn*				fn			= nullptr;
+	size_t						count		= 0;
+	size_t						grain		= 1;
+	std::atomic<size_t>			next{ 0 };
+	size_t						busy		= 0;
+	uint64_t					generation	= 0;
+	bool						quit		= false;
+
+	// Pull ranges until the loop is exhausted
+	void drain(const RangeFn& loopFn, size_t loopCount, size_t loopGrain) {
+		const bool nested = tInJob;
+		tInJob = true;
+		for (;;) {
+			const size_t begin = next.fetch_add(loopGrain);
+			if (begin >= loopCount) {
+				break;
+			}
+			const size_t end = (begin + loopGrain < loopCount) ? (begin + loopGrain) : loopCount;
+			loopFn(begin, end);
+		}
+		tInJob = nested;
+	}
+
+	void worker(size_t index) {
+		tThreadIndex = index;
+		uint64_t seen = 0;
+		for (;;) {
+			const RangeFn* loopFn = nullptr;
+			size_t loopCount = 0;
+			size_t loopGrain = 1;
+			{
+				std::unique_lock<std::mutex> guard(lock);
+				wake.wait(guard, [&] { return quit || generation != seen; });
+				if (quit) {
+					return;
+				}
+				seen = generation;
+				if (!fn) {
+					continue;	// Woke after the loop already finished
+				}
+				// Snapshot under the lock, the caller can't return while we're busy
+				loopFn = fn;
+				loopCount = count;
+				loopGrain = grain;
+				++busy;
+			}
+			drain(*loopFn, loopCount, loopGrain);
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				if (--busy == 0) {
+					done.notify_all();
+				}
+			}
+		}
+	}
+};
+
+//----------------------------------------------------------------
+
+JobSystem::JobSystem(size_t workers)
+	: mImpl(new Impl()) {
+	if (workers == 0) {
+		const size_t hw = std::thread::hardware_concurrency();
+		workers = (hw > 1) ? (hw - 1) : 0;
+	}
+	mImpl->threads.reserve(workers);
+	for (size_t i = 0; i < workers; ++i) {
+		mImpl->threads.emplace_back([this, i] { mImpl->worker(i + 1); });
+	}
+}
+
+JobSystem::~JobSystem() noexcept {
+	{
+		std::lock_guard<std::mutex> guard(mImpl->lock);
+		mImpl->quit = true;
+	}
+	mImpl->wake.notify_all();
+	for (std::thread& t : mImpl->threads) {
+		t.join();
+	}
+	delete mImpl;
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const RangeFn& fn) {
+	if (count == 0) {
+		return;
+	}
+	if (grain == 0) {
+		grain = 1;
+	}
+	// Small loops, nested loops and empty pools run on the caller
+	if (tInJob || mImpl->threads.empty() || count <= grain) {
+		const bool nested = tInJob;
+		tInJob = true;
+		for (size_t begin = 0; begin < count; begin += grain) {
+			fn(begin, (begin + grain < count) ? (begin + grain) : count);
+		}
+		tInJob = nested;
+		return;
+	}
+
+	std::lock_guard<std::mutex> serial(mImpl->submit);
+	{
+		std::lock_guard<std::mutex> guard(mImpl->lock);
+		mImpl->fn = &fn;
+		mImpl->count = count;
+		mImpl->grain = grain;
+		mImpl->next.store(0);
+		++mImpl->busy;	// The caller
+		++mImpl->generation;
+	}
+	mImpl->wake.notify_all();
+
+	mImpl->drain(fn, count, grain);
+
+	std::unique_lock<std::mutex> guard(mImpl->lock);
+	--mImpl->busy;
+	mImpl->done.wait(guard, [&] { return mImpl->busy == 0; });
+	mImpl->fn = nullptr;
+}
+
+size_t JobSystem::threadCount() const noexcept {
+	return mImpl->threads.size() + 1U;
+}
+
+#else // !DD25_JOBS_THREADED
+
+struct JobSystem::Impl {};
+
+JobSystem::JobSystem(size_t)
+	: mImpl(nullptr) {}
+
+JobSystem::~JobSystem() noexcept {}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const RangeFn& fn) {
+	if (grain == 0) {
+		grain = 1;
+	}
+	const bool nested = tInJob;
+	tInJob = true;
+	for (size_t begin = 0; begin < count; begin += grain) {
+		fn(begin, (begin + grain < count) ? (begin + grain) : count);
+	}
+	tInJob = nested;
+}
+
+size_t JobSystem::threadCount() const noexcept {
+	return 1U;
+}
+
+#endif//DD25_JOBS_THREADED
+
+//----------------------------------------------------------------
+
+size_t JobSystem::threadIndex() noexcept {
+	return tThreadIndex;
+}
+
+JobSystem& JobSystem::instance() {
+	static JobSystem sJobs;
+	return sJobs;
+}
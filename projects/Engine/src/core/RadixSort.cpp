@@ -0,0 +1,104 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/core/RadixSort.hh>
+#include <Engine/core/Jobs.hh>
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr size_t RADIX_BITS		= 8U;
+constexpr size_t RADIX_BUCKETS	= 1U << RADIX_BITS;
+constexpr size_t RADIX_PASSES	= 64U / RADIX_BITS;
+constexpr size_t MIN_BLOCK		= 4096U;	// Below this per block, threading costs more than it saves
+constexpr size_t MAX_BLOCKS		= 64U;
+
+using Histogram = uint32_t[RADIX_BUCKETS];
+
+inline size_t digit(uint64_t key, size_t pass) noexcept {
+	return static_cast<size_t>(key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1U);
+}
+
+} // namespace
+
+//================================================================
+
+void radixSort(SortPair* items, SortPair* scratch, size_t count) {
+	if (count < 2) {
+		return;
+	}
+
+	JobSystem& jobs = JobSystem::instance();
+	size_t blocks = count / MIN_BLOCK;
+	blocks = (blocks < 1) ? 1 : (blocks > MAX_BLOCKS) ? MAX_BLOCKS : blocks;
+	blocks = (blocks > jobs.threadCount() * 2U) ? jobs.threadCount() * 2U : blocks;
+	const size_t blockSize = (count + blocks - 1U) / blocks;
+
+	// Which passes actually move anything (one read over the keys)
+	bool active[RADIX_PASSES];
+	{
+		uint64_t diff = 0;
+		const uint64_t first = items[0].key;
+		for (size_t i = 1; i < count; ++i) {
+			diff |= items[i].key ^ first;
+		}
+		for (size_t p = 0; p < RADIX_PASSES; ++p) {
+			active[p] = digit(diff, p) != 0;
+		}
+	}
+
+	std::vector<uint32_t> hist(blocks * RADIX_BUCKETS);
+	SortPair* src = items;
+	SortPair* dst = scratch;
+
+	for (size_t pass = 0; pass < RADIX_PASSES; ++pass) {
+		if (!active[pass]) {
+			continue;
+		}
+
+		// Per-block digit counts
+		jobs.parallelFor(blocks, 1, [&](size_t begin, size_t end) {
+			for (size_t b = begin; b < end; ++b) {
+				uint32_t* h = &hist[b * RADIX_BUCKETS];
+				std::memset(h, 0, sizeof(Histogram));
+				const size_t lo = b * blockSize;
+				const size_t hi = (lo + blockSize < count) ? lo + blockSize : count;
+				for (size_t i = lo; i < hi; ++i) {
+					++h[digit(src[i].key, pass)];
+				}
+			}
+		});
+
+		// Exclusive scan, bucket-major so each block's run stays in order
+		uint32_t sum = 0;
+		for (size_t d = 0; d < RADIX_BUCKETS; ++d) {
+			for (size_t b = 0; b < blocks; ++b) {
+				const uint32_t n = hist[b * RADIX_BUCKETS + d];
+				hist[b * RADIX_BUCKETS + d] = sum;
+				sum += n;
+			}
+		}
+
+		// Scatter, blocks write disjoint ranges
+		jobs.parallelFor(blocks, 1, [&](size_t begin, size_t end) {
+			for (size_t b = begin; b < end; ++b) {
+				uint32_t* h = &hist[b * RADIX_BUCKETS];
+				const size_t lo = b * blockSize;
+				const size_t hi = (lo + blockSize < count) ? lo + blockSize : count;
+				for (size_t i = lo; i < hi; ++i) {
+					dst[h[digit(src[i].key, pass)]++] = src[i];
+				}
+			}
+		});
+		std::swap(src, dst);
+	}
+
+	if (src != items) {
+		std::memcpy(items, src, count * sizeof(SortPair));
+	}
+}
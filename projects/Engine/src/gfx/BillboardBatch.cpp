@@ -0,0 +1,361 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/BillboardBatch.hh>
+#include <Engine/core/Jobs.hh>
+#include <Engine/math/simd.hh>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline float elapsedMs(Clock::time_point start) noexcept {
+	return static_cast<float>(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+}
+
+constexpr uint32_t VERTS_PER_BILLBOARD = 6U;
+constexpr size_t EXPAND_GRAIN = 2048U;		// Billboards per job, a multiple of 4
+constexpr size_t KEY_GRAIN = 8192U;
+
+// Float bits as an unsigned key that sorts like the float, inverted so the farthest comes first
+inline uint64_t backToFrontKey(float depth) noexcept {
+	uint32_t u;
+	std::memcpy(&u, &depth, sizeof(u));
+	u = (u & 0x80000000U) ? ~u : (u | 0x80000000U);
+	return ~u;
+}
+
+// View depth of the set's centroid
+float meanDepth(const BillboardArrays& a, const Float3& eye, const Float3& forward) noexcept {
+	SimdFloat4 sx = simdSplat(0.0f);
+	SimdFloat4 sy = simdSplat(0.0f);
+	SimdFloat4 sz = simdSplat(0.0f);
+	uint32_t i = 0;
+	for (; i + 4U <= a.count; i += 4U) {
+		sx = sx + simdLoadU(a.x + i);
+		sy = sy + simdLoadU(a.y + i);
+		sz = sz + simdLoadU(a.z + i);
+	}
+	alignas(16) float lx[4], ly[4], lz[4];
+	simdStore(lx, sx);
+	simdStore(ly, sy);
+	simdStore(lz, sz);
+	Float3 sum = { lx[0] + lx[1] + lx[2] + lx[3], ly[0] + ly[1] + ly[2] + ly[3], lz[0] + lz[1] + lz[2] + lz[3] };
+	for (; i < a.count; ++i) {
+		sum = sum + Float3{ a.x[i], a.y[i], a.z[i] };
+	}
+	return dot(sum * (1.0f / static_cast<float>(a.count)) - eye, forward);
+}
+
+} // namespace
+
+//================================================================
+
+BillboardSet::~BillboardSet() noexcept {}
+
+BillboardArrays BillboardSet::arrays() const noexcept {
+	return {
+		mX.data(), mY.data(), mZ.data(), mWidth.data(), mHeight.data(),
+		mRotation.empty() ? nullptr : mRotation.data(),
+		mColors.empty() ? nullptr : mColors.data(),
+		static_cast<uint32_t>(mX.size())
+	};
+}
+
+void BillboardSet::clear() noexcept {
+	mX.clear();
+	mY.clear();
+	mZ.clear();
+	mWidth.clear();
+	mHeight.clear();
+	mRotation.clear();
+	mColors.clear();
+}
+
+void BillboardSet::reserve(size_t count) {
+	mX.reserve(count);
+	mY.reserve(count);
+	mZ.reserve(count);
+	mWidth.reserve(count);
+	mHeight.reserve(count);
+}
+
+void BillboardSet::add(const Float3& position, const Float2& size, float rotation) {
+	if (!mColors.empty()) {
+		mColors.push_back(mColor);
+	}
+	if (rotation != 0.0f && mRotation.empty()) {
+		mRotation.resize(mX.size(), 0.0f);
+	}
+	if (!mRotation.empty()) {
+		mRotation.push_back(rotation);
+	}
+	mX.push_back(position.x);
+	mY.push_back(position.y);
+	mZ.push_back(position.z);
+	mWidth.push_back(size.x);
+	mHeight.push_back(size.y);
+}
+
+void BillboardSet::add(const Float3& position, const Float2& size, float rotation, uint32_t color) {
+	if (mColors.empty()) {
+		mColors.resize(mX.size(), mColor);
+	}
+	mColors.push_back(color);
+	if (rotation != 0.0f && mRotation.empty()) {
+		mRotation.resize(mX.size(), 0.0f);
+	}
+	if (!mRotation.empty()) {
+		mRotation.push_back(rotation);
+	}
+	mX.push_back(position.x);
+	mY.push_back(position.y);
+	mZ.push_back(position.z);
+	mWidth.push_back(size.x);
+	mHeight.push_back(size.y);
+}
+
+//================================================================
+
+BillboardBatch::BillboardBatch(StreamVertexBuffer& stream, const BillboardBatchSettings& settings)
+	: mStream(stream)
+	, mSettings(settings)
+	, mStats{}
+	, mEye{ 0.0f, 0.0f, 0.0f }
+	, mRight{ 1.0f, 0.0f, 0.0f }
+	, mUp{ 0.0f, 1.0f, 0.0f }
+	, mForward{ 0.0f, 0.0f, -1.0f }
+	, mFar(1.0f) {
+}
+
+BillboardBatch::~BillboardBatch() noexcept {}
+
+void BillboardBatch::begin(const Float4x4& view, float farPlane) {
+	// Rows of the rotation are the camera axes, the eye undoes the translation
+	const float* m = view.m;
+	mRight = { m[0], m[4], m[8] };
+	mUp = { m[1], m[5], m[9] };
+	const Float3 back = { m[2], m[6], m[10] };
+	mForward = -back;
+	mEye = -(mRight * m[12] + mUp * m[13] + back * m[14]);
+	mFar = (farPlane > 0.0f) ? farPlane : 1.0f;
+
+	mEntries.clear();
+	mTextures.clear();
+	mStats = {};
+}
+
+void BillboardBatch::add(const IBillboard& set, RenderList list) {
+	mEntries.push_back({ &set, list, 0U, 0U, 0U, 0.0f });
+}
+
+uint32_t BillboardBatch::textureIndex(const ITexture* texture) {
+	for (size_t i = 0; i < mTextures.size(); ++i) {
+		if (mTextures[i] == texture) {
+			return static_cast<uint32_t>(i);
+		}
+	}
+	mTextures.push_back(texture);
+	return static_cast<uint32_t>(mTextures.size() - 1U);
+}
+
+void BillboardBatch::build() {
+	for (Entry& entry : mEntries) {
+		const IBillboard& set = *entry.set;
+		const BillboardArrays a = set.arrays();
+		if (!a.count) {
+			continue;
+		}
+		++mStats.sets;
+		mStats.billboards += a.count;
+		entry.texture = textureIndex(set.texture());
+		entry.depth = meanDepth(a, mEye, mForward);
+
+		// Back to front by view depth, translucent sets only
+		const SortPair* order = nullptr;
+		if (entry.list == RenderList::Translucent && mSettings.sortTranslucent) {
+			const auto start = Clock::now();
+			if (mOrder.size() < a.count) {
+				mOrder.resize(a.count);
+				mScratch.resize(a.count);
+			}
+			SortPair* keys = mOrder.data();
+			const Float3 eye = mEye;
+			const Float3 forward = mForward;
+			JobSystem::instance().parallelFor(a.count, KEY_GRAIN, [=](size_t begin, size_t end) {
+				const SimdFloat4 ex = simdSplat(eye.x), ey = simdSplat(eye.y), ez = simdSplat(eye.z);
+				const SimdFloat4 fx = simdSplat(forward.x), fy = simdSplat(forward.y), fz = simdSplat(forward.z);
+				size_t i = begin;
+				for (; i + 4U <= end; i += 4U) {
+					alignas(16) float d[4];
+					simdStore(d, (simdLoadU(a.x + i) - ex) * fx + (simdLoadU(a.y + i) - ey) * fy + (simdLoadU(a.z + i) - ez) * fz);
+					for (size_t l = 0; l < 4; ++l) {
+						keys[i + l] = { backToFrontKey(d[l]), static_cast<uint32_t>(i + l), 0U };
+					}
+				}
+				for (; i < end; ++i) {
+					const float d = (a.x[i] - eye.x) * forward.x + (a.y[i] - eye.y) * forward.y + (a.z[i] - eye.z) * forward.z;
+					keys[i] = { backToFrontKey(d), static_cast<uint32_t>(i), 0U };
+				}
+			});
+			radixSort(mOrder.data(), mScratch.data(), a.count);
+			order = mOrder.data();
+			mStats.sorted += a.count;
+			mStats.sortMs += elapsedMs(start);
+		}
+
+		const auto start = Clock::now();
+		GfxVertex* out = mStream.allocate(a.count * VERTS_PER_BILLBOARD, entry.first);
+		if (!out) {
+			++mStats.dropped;
+			continue;
+		}
+		entry.count = a.count * VERTS_PER_BILLBOARD;
+		expand(set, out, order);
+		mStats.vertices += entry.count;
+		mStats.expandMs += elapsedMs(start);
+	}
+}
+
+void BillboardBatch::expand(const IBillboard& set, GfxVertex* out, const SortPair* order) const {
+	const BillboardArrays a = set.arrays();
+	const bool axisLocked = (set.mode() == BillboardMode::Axis);
+	const Float3 axis = set.axis();
+	const Float2 pivot = set.pivot();
+	const AtlasRect r = set.region();
+	const uint32_t tint = set.color();
+	const Float3 eye = mEye;
+	const Float3 right = mRight;
+	const Float3 up = axisLocked ? axis : mUp;
+
+	JobSystem::instance().parallelFor(a.count, EXPAND_GRAIN, [=](size_t begin, size_t end) {
+		const SimdFloat4 rx = simdSplat(right.x), ry = simdSplat(right.y), rz = simdSplat(right.z);
+		const SimdFloat4 ux = simdSplat(up.x), uy = simdSplat(up.y), uz = simdSplat(up.z);
+		const SimdFloat4 one = simdSplat(1.0f);
+		const SimdFloat4 pivotX = simdSplat(-pivot.x), pivotX1 = simdSplat(1.0f - pivot.x);
+		const SimdFloat4 pivotY = simdSplat(-pivot.y), pivotY1 = simdSplat(1.0f - pivot.y);
+
+		for (size_t base = begin; base < end; base += 4) {
+			const size_t lanes = (end - base < 4) ? (end - base) : 4;
+
+			// Four billboards, straight from the arrays when they are in order
+			alignas(16) float px[4], py[4], pz[4], w[4], h[4], cs[4], sn[4];
+			uint32_t index[4];
+			for (size_t l = 0; l < 4; ++l) {
+				const size_t i = base + ((l < lanes) ? l : 0);
+				index[l] = order ? order[i].value : static_cast<uint32_t>(i);
+			}
+			SimdFloat4 x, y, z, sw, sh;
+			if (!order && lanes == 4) {
+				x = simdLoadU(a.x + base);
+				y = simdLoadU(a.y + base);
+				z = simdLoadU(a.z + base);
+				sw = simdLoadU(a.width + base);
+				sh = simdLoadU(a.height + base);
+			} else {
+				for (size_t l = 0; l < 4; ++l) {
+					px[l] = a.x[index[l]];
+					py[l] = a.y[index[l]];
+					pz[l] = a.z[index[l]];
+					w[l] = a.width[index[l]];
+					h[l] = a.height[index[l]];
+				}
+				x = simdLoad(px);
+				y = simdLoad(py);
+				z = simdLoad(pz);
+				sw = simdLoad(w);
+				sh = simdLoad(h);
+			}
+
+			// Quad right: the view's, or across the axis towards the eye
+			SimdFloat4 qx = rx, qy = ry, qz = rz;
+			if (axisLocked) {
+				const SimdFloat4 tx = simdSplat(eye.x) - x;
+				const SimdFloat4 ty = simdSplat(eye.y) - y;
+				const SimdFloat4 tz = simdSplat(eye.z) - z;
+				const SimdFloat4 cx = uy * tz - uz * ty;
+				const SimdFloat4 cy = uz * tx - ux * tz;
+				const SimdFloat4 cz = ux * ty - uy * tx;
+				const SimdFloat4 len2 = cx * cx + cy * cy + cz * cz;
+				const SimdFloat4 valid = simdCmpGe(len2, simdSplat(1e-12f));
+				const SimdFloat4 inv = one / simdSqrt(simdMax(len2, simdSplat(1e-12f)));
+				qx = simdSelect(valid, cx * inv, rx);
+				qy = simdSelect(valid, cy * inv, ry);
+				qz = simdSelect(valid, cz * inv, rz);
+			}
+
+			// In-plane rotation: a = c R + s U, b = c U - s R
+			SimdFloat4 ax = qx, ay = qy, az = qz;
+			SimdFloat4 bx = ux, by = uy, bz = uz;
+			if (a.rotation) {
+				for (size_t l = 0; l < 4; ++l) {
+					const float angle = a.rotation[index[l]];
+					cs[l] = (angle != 0.0f) ? std::cos(angle) : 1.0f;
+					sn[l] = (angle != 0.0f) ? std::sin(angle) : 0.0f;
+				}
+				const SimdFloat4 c = simdLoad(cs);
+				const SimdFloat4 s = simdLoad(sn);
+				ax = c * qx + s * ux;	ay = c * qy + s * uy;	az = c * qz + s * uz;
+				bx = c * ux - s * qx;	by = c * uy - s * qy;	bz = c * uz - s * qz;
+			}
+
+			// Corner = position + a * local x + b * local y, local corners from the pivot
+			const SimdFloat4 lx0 = pivotX * sw, lx1 = pivotX1 * sw;
+			const SimdFloat4 ly0 = pivotY * sh, ly1 = pivotY1 * sh;
+
+			alignas(16) float cx[4][4], cy[4][4], cz[4][4];
+			{
+				const SimdFloat4 a0 = ax * lx0, a1 = ax * lx1, b0 = bx * ly0, b1 = bx * ly1;
+				simdStore(cx[0], x + a0 + b0);	simdStore(cx[1], x + a1 + b0);
+				simdStore(cx[2], x + a1 + b1);	simdStore(cx[3], x + a0 + b1);
+			}
+			{
+				const SimdFloat4 a0 = ay * lx0, a1 = ay * lx1, b0 = by * ly0, b1 = by * ly1;
+				simdStore(cy[0], y + a0 + b0);	simdStore(cy[1], y + a1 + b0);
+				simdStore(cy[2], y + a1 + b1);	simdStore(cy[3], y + a0 + b1);
+			}
+			{
+				const SimdFloat4 a0 = az * lx0, a1 = az * lx1, b0 = bz * ly0, b1 = bz * ly1;
+				simdStore(cz[0], z + a0 + b0);	simdStore(cz[1], z + a1 + b0);
+				simdStore(cz[2], z + a1 + b1);	simdStore(cz[3], z + a0 + b1);
+			}
+
+			// Texture top on the upper edge, counter-clockwise as seen from the eye
+			for (size_t l = 0; l < lanes; ++l) {
+				const uint32_t color = a.color ? a.color[index[l]] : tint;
+
+				const GfxVertex v0 = { { cx[0][l], cy[0][l], cz[0][l] }, color, { r.u0, r.v1 } };
+				const GfxVertex v1 = { { cx[1][l], cy[1][l], cz[1][l] }, color, { r.u1, r.v1 } };
+				const GfxVertex v2 = { { cx[2][l], cy[2][l], cz[2][l] }, color, { r.u1, r.v0 } };
+				const GfxVertex v3 = { { cx[3][l], cy[3][l], cz[3][l] }, color, { r.u0, r.v0 } };
+
+				GfxVertex* v = out + (base + l) * VERTS_PER_BILLBOARD;
+				v[0] = v0;	v[1] = v1;	v[2] = v2;
+				v[3] = v0;	v[4] = v2;	v[5] = v3;
+			}
+		}
+	});
+}
+
+void BillboardBatch::submit(ICommandQueue& queue, uint8_t pass, const IMaterial* material, uint32_t materialKey) const {
+	for (const Entry& entry : mEntries) {
+		if (!entry.count) {
+			continue;
+		}
+		DrawCommand cmd;
+		cmd.material = material;
+		cmd.texture = mTextures[entry.texture];
+		cmd.vertices = &mStream;
+		cmd.transform = nullptr;
+		cmd.first = entry.first;
+		cmd.count = entry.count;
+		cmd.primitive = Primitive::Triangles;
+		queue.submit(SortKey::make(pass, entry.list, entry.depth / mFar, materialKey, entry.texture), cmd);
+	}
+}
@@ -0,0 +1,373 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/Color.hh>
+#include <Engine/core/Jobs.hh>
+#include <Engine/math/simd.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr size_t ROW_GRAIN = 16U;
+constexpr uint32_t SRGB_STEPS = 4096U;		// Linear -> sRGB table resolution
+
+// 4x4 Bayer thresholds as offsets in [-0.5, 0.5) of one quantization step
+constexpr float BAYER[4][4] = {
+	{ 0.5f / 16.0f - 0.5f,  8.5f / 16.0f - 0.5f,  2.5f / 16.0f - 0.5f, 10.5f / 16.0f - 0.5f },
+	{ 12.5f / 16.0f - 0.5f, 4.5f / 16.0f - 0.5f, 14.5f / 16.0f - 0.5f,  6.5f / 16.0f - 0.5f },
+	{ 3.5f / 16.0f - 0.5f, 11.5f / 16.0f - 0.5f,  1.5f / 16.0f - 0.5f,  9.5f / 16.0f - 0.5f },
+	{ 15.5f / 16.0f - 0.5f, 7.5f / 16.0f - 0.5f, 13.5f / 16.0f - 0.5f,  5.5f / 16.0f - 0.5f }
+};
+
+template <typename C>
+constexpr float maxLevel(uint32_t c) noexcept {
+	return C::BITS[c] ? static_cast<float>((1U << C::BITS[c]) - 1U) : 0.0f;
+}
+
+// Nearest level of an 8-bit channel, `offset` in levels; the scalar twin of the SIMD path
+template <typename C>
+inline uint32_t quantize(float v, uint32_t c, float offset) noexcept {
+	const float max = maxLevel<C>(c);
+	return static_cast<uint32_t>(std::clamp(v * max / 255.0f + 0.5f + offset, 0.0f, max));
+}
+
+//----------------------------------------------------------------
+// Decode: format -> ARGB8888
+//----------------------------------------------------------------
+
+template <uint32_t BITS>
+inline SimdInt4 expand4(SimdInt4 q) noexcept {
+	if constexpr (BITS == 1U) {
+		return (simdSplat(0) - q) & simdSplat(0xFF);
+	} else if constexpr (BITS >= 8U) {
+		return q;
+	} else {
+		return simdShl<8 - BITS>(q) | simdShr<2 * BITS - 8>(q);
+	}
+}
+
+template <typename C, uint32_t c>
+inline SimdInt4 decodeChannel(SimdInt4 texels) noexcept {
+	constexpr uint32_t bits = C::BITS[c];
+	if constexpr (bits == 0) {
+		return simdSplat(static_cast<int32_t>(0xFFU << (24U - c * 8U)));
+	} else {
+		const SimdInt4 q = simdShr<C::SHIFT[c]>(texels) & simdSplat(static_cast<int32_t>((1U << bits) - 1U));
+		return simdShl<24 - c * 8>(expand4<bits>(q));
+	}
+}
+
+template <typename C>
+void decodeRow(const void* src, uint32_t* argb, uint32_t width) noexcept {
+	const typename C::Storage* texels = static_cast<const typename C::Storage*>(src);
+	uint32_t x = 0;
+	for (; x + 4U <= width; x += 4U) {
+		alignas(16) int32_t t[4] = { texels[x], texels[x + 1U], texels[x + 2U], texels[x + 3U] };
+		const SimdInt4 v = simdLoad(t);
+		const SimdInt4 out = decodeChannel<C, 0>(v) | decodeChannel<C, 1>(v) | decodeChannel<C, 2>(v) | decodeChannel<C, 3>(v);
+		simdStoreU(reinterpret_cast<int32_t*>(argb + x), out);
+	}
+	for (; x < width; ++x) {
+		argb[x] = C::unpack(texels[x]);
+	}
+}
+
+//----------------------------------------------------------------
+// Encode: ARGB8888 -> format, plain or ordered dither
+//----------------------------------------------------------------
+
+template <typename C, uint32_t c>
+inline SimdInt4 encodeChannel(SimdInt4 argb, SimdFloat4 offset) noexcept {
+	constexpr uint32_t bits = C::BITS[c];
+	if constexpr (bits == 0) {
+		return simdSplat(0);
+	} else {
+		const SimdFloat4 max = simdSplat(maxLevel<C>(c));
+		const SimdFloat4 v = simdToFloat(simdShr<24 - c * 8>(argb) & simdSplat(0xFF));
+		SimdFloat4 level = v * max / simdSplat(255.0f) + simdSplat(0.5f);
+		if constexpr (bits > 1U) {
+			level = level + offset;
+		}
+		return simdShl<C::SHIFT[c]>(simdTruncate(simdMin(simdMax(level, simdSplat(0.0f)), max)));
+	}
+}
+
+template <typename C>
+void encodeRow(const uint32_t* argb, void* dst, uint32_t width, uint32_t y, bool ordered) noexcept {
+	typename C::Storage* texels = static_cast<typename C::Storage*>(dst);
+	const float* bayer = BAYER[y & 3U];
+	const SimdFloat4 offset = ordered ? simdLoadU(bayer) : simdSplat(0.0f);
+	uint32_t x = 0;
+	for (; x + 4U <= width; x += 4U) {
+		const SimdInt4 v = simdLoadU(reinterpret_cast<const int32_t*>(argb + x));
+		const SimdInt4 out = encodeChannel<C, 0>(v, offset) | encodeChannel<C, 1>(v, offset)
+			| encodeChannel<C, 2>(v, offset) | encodeChannel<C, 3>(v, offset);
+		alignas(16) int32_t t[4];
+		simdStore(t, out);
+		for (uint32_t i = 0; i < 4U; ++i) {
+			texels[x + i] = static_cast<typename C::Storage>(t[i]);
+		}
+	}
+	for (; x < width; ++x) {
+		uint32_t texel = 0;
+		for (uint32_t c = 0; c < 4U; ++c) {
+			if (C::BITS[c]) {
+				const float v = static_cast<float>((argb[x] >> (24U - c * 8U)) & 0xFFU);
+				texel |= quantize<C>(v, c, (ordered && C::BITS[c] > 1U) ? bayer[x & 3U] : 0.0f) << C::SHIFT[c];
+			}
+		}
+		texels[x] = static_cast<typename C::Storage>(texel);
+	}
+}
+
+//----------------------------------------------------------------
+// Encode with Floyd-Steinberg, one pixel's four channels per vector
+//----------------------------------------------------------------
+
+template <typename C>
+void diffuseRow(const uint32_t* argb, void* dst, uint32_t width, float* current, float* next) noexcept {
+	typename C::Storage* texels = static_cast<typename C::Storage*>(dst);
+	const SimdFloat4 max = simdSet(maxLevel<C>(0), maxLevel<C>(1), maxLevel<C>(2), maxLevel<C>(3));
+	// 1-bit alpha is a cut-out mask, diffusing it only adds noise to the edge
+	const SimdFloat4 spread = simdSet(C::BITS[0] > 1U ? 1.0f : 0.0f, C::BITS[1] > 1U ? 1.0f : 0.0f,
+		C::BITS[2] > 1U ? 1.0f : 0.0f, C::BITS[3] > 1U ? 1.0f : 0.0f);
+	const SimdFloat4 zero = simdSplat(0.0f);
+
+	std::fill(next, next + static_cast<size_t>(width + 2U) * 4U, 0.0f);
+	for (uint32_t x = 0; x < width; ++x) {
+		const uint32_t p = argb[x];
+		float* e = current + static_cast<size_t>(x + 1U) * 4U;
+		float* n = next + static_cast<size_t>(x + 1U) * 4U;
+		const SimdFloat4 v = simdSet(static_cast<float>(p >> 24), static_cast<float>((p >> 16) & 0xFFU),
+			static_cast<float>((p >> 8) & 0xFFU), static_cast<float>(p & 0xFFU)) + simdLoadU(e);
+
+		alignas(16) int32_t q[4];
+		simdStore(q, simdTruncate(simdMin(simdMax(v * max / simdSplat(255.0f) + simdSplat(0.5f), zero), max)));
+		uint32_t texel = 0;
+		for (uint32_t c = 0; c < 4U; ++c) {
+			texel |= C::BITS[c] ? static_cast<uint32_t>(q[c]) << C::SHIFT[c] : 0U;
+		}
+		texels[x] = static_cast<typename C::Storage>(texel);
+
+		const SimdFloat4 expanded = simdSet(static_cast<float>(expandChannel(static_cast<uint32_t>(q[0]), C::BITS[0])),
+			static_cast<float>(expandChannel(static_cast<uint32_t>(q[1]), C::BITS[1])),
+			static_cast<float>(expandChannel(static_cast<uint32_t>(q[2]), C::BITS[2])),
+			static_cast<float>(expandChannel(static_cast<uint32_t>(q[3]), C::BITS[3])));
+		const SimdFloat4 error = (v - expanded) * spread;
+		simdStoreU(e + 4, simdLoadU(e + 4) + error * simdSplat(7.0f / 16.0f));
+		simdStoreU(n - 4, simdLoadU(n - 4) + error * simdSplat(3.0f / 16.0f));
+		simdStoreU(n, simdLoadU(n) + error * simdSplat(5.0f / 16.0f));
+		simdStoreU(n + 4, simdLoadU(n + 4) + error * simdSplat(1.0f / 16.0f));
+	}
+}
+
+//----------------------------------------------------------------
+
+using DecodeRowFn = void (*)(const void*, uint32_t*, uint32_t);
+using EncodeRowFn = void (*)(const uint32_t*, void*, uint32_t, uint32_t, bool);
+using DiffuseRowFn = void (*)(const uint32_t*, void*, uint32_t, float*, float*);
+
+// nullptr for ARGB8888, which needs no work
+inline DecodeRowFn decoderFor(PixelFormat format) noexcept {
+	switch (format) {
+	case PixelFormat::ARGB1555:		return &decodeRow<ColorARGB1555>;
+	case PixelFormat::RGB565:		return &decodeRow<ColorRGB565>;
+	case PixelFormat::ARGB4444:		return &decodeRow<ColorARGB4444>;
+	default:						return nullptr;
+	}
+}
+
+inline EncodeRowFn encoderFor(PixelFormat format) noexcept {
+	switch (format) {
+	case PixelFormat::ARGB1555:		return &encodeRow<ColorARGB1555>;
+	case PixelFormat::RGB565:		return &encodeRow<ColorRGB565>;
+	case PixelFormat::ARGB4444:		return &encodeRow<ColorARGB4444>;
+	default:						return nullptr;
+	}
+}
+
+inline DiffuseRowFn diffuserFor(PixelFormat format) noexcept {
+	switch (format) {
+	case PixelFormat::ARGB1555:		return &diffuseRow<ColorARGB1555>;
+	case PixelFormat::RGB565:		return &diffuseRow<ColorRGB565>;
+	case PixelFormat::ARGB4444:		return &diffuseRow<ColorARGB4444>;
+	default:						return nullptr;
+	}
+}
+
+// The source row as ARGB8888, decoded into `scratch` when it isn't already
+inline const uint32_t* sourceRow(const uint8_t* row, DecodeRowFn decode, uint32_t* scratch, uint32_t width) noexcept {
+	if (!decode) {
+		std::memcpy(scratch, row, static_cast<size_t>(width) * sizeof(uint32_t));
+		return scratch;
+	}
+	decode(row, scratch, width);
+	return scratch;
+}
+
+//----------------------------------------------------------------
+
+struct SrgbTables {
+	float		decode[256];
+	uint8_t		encode[SRGB_STEPS];
+
+	SrgbTables() noexcept {
+		for (uint32_t i = 0; i < 256U; ++i) {
+			const float s = static_cast<float>(i) / 255.0f;
+			decode[i] = (s <= 0.04045f) ? s / 12.92f : std::pow((s + 0.055f) / 1.055f, 2.4f);
+		}
+		for (uint32_t i = 0; i < SRGB_STEPS; ++i) {
+			const float l = static_cast<float>(i) / static_cast<float>(SRGB_STEPS - 1U);
+			const float s = (l <= 0.0031308f) ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+			encode[i] = static_cast<uint8_t>(std::clamp(s * 255.0f + 0.5f, 0.0f, 255.0f));
+		}
+	}
+};
+
+const SrgbTables& srgbTables() noexcept {
+	static const SrgbTables tables;
+	return tables;
+}
+
+} // namespace
+
+//================================================================
+
+bool convertPixels(const void* src, PixelFormat srcFormat, size_t srcStride,
+	void* dst, PixelFormat dstFormat, size_t dstStride,
+	uint32_t width, uint32_t height, Dither dither) {
+	if (!src || !dst || width == 0 || height == 0) {
+		return false;
+	}
+	const uint8_t* srcBytes = static_cast<const uint8_t*>(src);
+	uint8_t* dstBytes = static_cast<uint8_t*>(dst);
+	const size_t rowBytes = static_cast<size_t>(width) * pixelFormatBytes(dstFormat);
+
+	if (srcFormat == dstFormat) {
+		for (uint32_t y = 0; y < height; ++y) {
+			std::memcpy(dstBytes + y * dstStride, srcBytes + y * srcStride, rowBytes);
+		}
+		return true;
+	}
+
+	const DecodeRowFn decode = decoderFor(srcFormat);
+	const EncodeRowFn encode = encoderFor(dstFormat);
+
+	if (dither == Dither::ErrorDiffusion && encode) {
+		const DiffuseRowFn diffuse = diffuserFor(dstFormat);
+		std::vector<uint32_t> scratch(width);
+		std::vector<float> errorRows(static_cast<size_t>(width + 2U) * 4U * 2U, 0.0f);
+		float* current = errorRows.data();
+		float* next = current + static_cast<size_t>(width + 2U) * 4U;
+		for (uint32_t y = 0; y < height; ++y) {
+			diffuse(sourceRow(srcBytes + y * srcStride, decode, scratch.data(), width), dstBytes + y * dstStride, width, current, next);
+			std::swap(current, next);
+		}
+		return true;
+	}
+
+	const bool ordered = (dither == Dither::Ordered);
+	JobSystem::instance().parallelFor(height, ROW_GRAIN, [&](size_t begin, size_t end) {
+		std::vector<uint32_t> scratch(width);
+		for (size_t y = begin; y < end; ++y) {
+			uint8_t* out = dstBytes + y * dstStride;
+			if (!encode) {
+				decode(srcBytes + y * srcStride, reinterpret_cast<uint32_t*>(out), width);
+				continue;
+			}
+			const uint32_t* argb = sourceRow(srcBytes + y * srcStride, decode, scratch.data(), width);
+			encode(argb, out, width, static_cast<uint32_t>(y), ordered);
+		}
+	});
+	return true;
+}
+
+//----------------------------------------------------------------
+
+void argbToPlanar(const uint32_t* argb, float* r, float* g, float* b, size_t count) noexcept {
+	const SimdInt4 byte = simdSplat(0xFF);
+	const SimdFloat4 inv255 = simdSplat(1.0f / 255.0f);
+	size_t i = 0;
+	for (; i + 4U <= count; i += 4U) {
+		const SimdInt4 v = simdLoadU(reinterpret_cast<const int32_t*>(argb + i));
+		simdStoreU(r + i, simdToFloat(simdShr<16>(v) & byte) * inv255);
+		simdStoreU(g + i, simdToFloat(simdShr<8>(v) & byte) * inv255);
+		simdStoreU(b + i, simdToFloat(v & byte) * inv255);
+	}
+	for (; i < count; ++i) {
+		r[i] = static_cast<float>((argb[i] >> 16) & 0xFFU) * (1.0f / 255.0f);
+		g[i] = static_cast<float>((argb[i] >> 8) & 0xFFU) * (1.0f / 255.0f);
+		b[i] = static_cast<float>(argb[i] & 0xFFU) * (1.0f / 255.0f);
+	}
+}
+
+void planarToArgb(const float* r, const float* g, const float* b, const uint32_t* alpha, uint32_t* argb, size_t count) noexcept {
+	const SimdFloat4 zero = simdSplat(0.0f);
+	const SimdFloat4 one = simdSplat(1.0f);
+	const SimdFloat4 scale = simdSplat(255.0f);
+	const SimdFloat4 half = simdSplat(0.5f);
+	const SimdInt4 alphaMask = simdSplat(static_cast<int32_t>(0xFF000000U));
+	const auto quantize = [&](SimdFloat4 v) { return simdTruncate(simdMin(simdMax(v, zero), one) * scale + half); };
+	size_t i = 0;
+	for (; i + 4U <= count; i += 4U) {
+		const SimdInt4 a = simdLoadU(reinterpret_cast<const int32_t*>(alpha + i)) & alphaMask;
+		const SimdInt4 out = a | simdShl<16>(quantize(simdLoadU(r + i))) | simdShl<8>(quantize(simdLoadU(g + i))) | quantize(simdLoadU(b + i));
+		simdStoreU(reinterpret_cast<int32_t*>(argb + i), out);
+	}
+	for (; i < count; ++i) {
+		const auto q = [](float v) { return static_cast<uint32_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+		argb[i] = (alpha[i] & 0xFF000000U) | (q(r[i]) << 16) | (q(g[i]) << 8) | q(b[i]);
+	}
+}
+
+void premultiplyAlpha(uint32_t* argb, size_t count) noexcept {
+	const SimdInt4 byte = simdSplat(0xFF);
+	const SimdFloat4 inv255 = simdSplat(1.0f / 255.0f);
+	const SimdFloat4 half = simdSplat(0.5f);
+	size_t i = 0;
+	for (; i + 4U <= count; i += 4U) {
+		int32_t* p = reinterpret_cast<int32_t*>(argb + i);
+		const SimdInt4 v = simdLoadU(p);
+		const SimdInt4 alpha = simdShr<24>(v);
+		const SimdFloat4 a = simdToFloat(alpha) * inv255;
+		const SimdInt4 r = simdTruncate(simdToFloat(simdShr<16>(v) & byte) * a + half);
+		const SimdInt4 g = simdTruncate(simdToFloat(simdShr<8>(v) & byte) * a + half);
+		const SimdInt4 b = simdTruncate(simdToFloat(v & byte) * a + half);
+		simdStoreU(p, simdShl<24>(alpha) | simdShl<16>(r) | simdShl<8>(g) | b);
+	}
+	for (; i < count; ++i) {
+		const uint32_t v = argb[i];
+		const float a = static_cast<float>(v >> 24) * (1.0f / 255.0f);
+		const auto scale = [a](uint32_t c) { return static_cast<uint32_t>(static_cast<float>(c & 0xFFU) * a + 0.5f); };
+		argb[i] = (v & 0xFF000000U) | (scale(v >> 16) << 16) | (scale(v >> 8) << 8) | scale(v);
+	}
+}
+
+void srgbToLinear(const uint32_t* argb, Float4* linear, size_t count) noexcept {
+	// A table lookup per channel, nothing left for vectors to speed up
+	const float* decode = srgbTables().decode;
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t v = argb[i];
+		linear[i] = { decode[(v >> 16) & 0xFFU], decode[(v >> 8) & 0xFFU], decode[v & 0xFFU], static_cast<float>(v >> 24) * (1.0f / 255.0f) };
+	}
+}
+
+void linearToSrgb(const Float4* linear, uint32_t* argb, size_t count) noexcept {
+	const uint8_t* encode = srgbTables().encode;
+	const SimdFloat4 zero = simdSplat(0.0f);
+	const SimdFloat4 one = simdSplat(1.0f);
+	const SimdFloat4 scale = simdSet(static_cast<float>(SRGB_STEPS - 1U), static_cast<float>(SRGB_STEPS - 1U), static_cast<float>(SRGB_STEPS - 1U), 255.0f);
+	for (size_t i = 0; i < count; ++i) {
+		// Colour channels become table indices, alpha its 8-bit value
+		alignas(16) int32_t q[4];
+		simdStore(q, simdToInt(simdMin(simdMax(simdLoadU(&linear[i].x), zero), one) * scale));
+		argb[i] = (static_cast<uint32_t>(q[3]) << 24) | (static_cast<uint32_t>(encode[q[0]]) << 16)
+			| (static_cast<uint32_t>(encode[q[1]]) << 8) | encode[q[2]];
+	}
+}
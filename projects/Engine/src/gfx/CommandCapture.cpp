@@ -0,0 +1,377 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/CommandCapture.hh>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+//================================================================
+
+namespace {
+
+inline size_t alignUp(size_t v) noexcept {
+	return (v + CAPTURE_FILE_ALIGNMENT - 1U) & ~(CAPTURE_FILE_ALIGNMENT - 1U);
+}
+
+// Range of a vertex buffer the frame's draws read
+struct BufferSpan {
+	uint32_t	index;		// Into the capture's buffer records
+	uint32_t	lo;
+	uint32_t	hi;
+};
+
+// Every enum byte names a value ReplayMaterial can cast to
+bool validMaterial(const CaptureMaterialRecord& m) noexcept {
+	return m.list <= static_cast<uint8_t>(RenderList::Translucent)
+		&& m.srcBlend <= static_cast<uint8_t>(BlendFactor::InvDstAlpha)
+		&& m.dstBlend <= static_cast<uint8_t>(BlendFactor::InvDstAlpha)
+		&& m.depthCompare <= static_cast<uint8_t>(DepthCompare::Always)
+		&& m.cull <= static_cast<uint8_t>(CullMode::Front)
+		&& m.filter <= static_cast<uint8_t>(TextureFilter::Trilinear)
+		&& m.wrapU <= static_cast<uint8_t>(TextureWrap::Mirror)
+		&& m.wrapV <= static_cast<uint8_t>(TextureWrap::Mirror)
+		&& m.shading <= static_cast<uint8_t>(ShadeMode::Gouraud);
+}
+
+} // namespace
+
+//================================================================
+
+void CommandCapture::clear() {
+	mDraws.clear();
+	mBuffers.clear();
+	mVertices.clear();
+	mTextures.clear();
+	mTexels.clear();
+	mMaterials.clear();
+	mTransforms.clear();
+	mMaterialIndex.clear();
+	mTextureIndex.clear();
+	mTransformIndex.clear();
+	mFrame = {};
+	mStats = {};
+}
+
+uint32_t CommandCapture::materialIndex(const IMaterial* material) {
+	if (!material) {
+		return CAPTURE_NONE;
+	}
+	const auto [it, added] = mMaterialIndex.try_emplace(material, static_cast<uint32_t>(mMaterials.size()));
+	if (added) {
+		const PipelineState& s = material->state();
+		CaptureMaterialRecord r = {};
+		r.shader = s.shader;
+		r.sortKey = material->sortKey();
+		r.list = static_cast<uint8_t>(s.list);
+		r.srcBlend = static_cast<uint8_t>(s.srcBlend);
+		r.dstBlend = static_cast<uint8_t>(s.dstBlend);
+		r.depthCompare = static_cast<uint8_t>(s.depthCompare);
+		r.depthWrite = s.depthWrite ? 1U : 0U;
+		r.cull = static_cast<uint8_t>(s.cull);
+		r.filter = static_cast<uint8_t>(s.filter);
+		r.wrapU = static_cast<uint8_t>(s.wrapU);
+		r.wrapV = static_cast<uint8_t>(s.wrapV);
+		r.shading = static_cast<uint8_t>(s.shading);
+		r.fog = s.fog ? 1U : 0U;
+		r.params = material->params();
+		mMaterials.push_back(r);
+	}
+	return it->second;
+}
+
+uint32_t CommandCapture::textureIndex(const ITexture* texture) {
+	if (!texture) {
+		return CAPTURE_NONE;
+	}
+	const auto [it, added] = mTextureIndex.try_emplace(texture, static_cast<uint32_t>(mTextures.size()));
+	if (added) {
+		CaptureTextureRecord r = {};
+		r.width = texture->width();
+		r.height = texture->height();
+		r.format = static_cast<uint32_t>(texture->format());
+		// Rows start aligned in the file, as they do in memory
+		mTexels.resize(alignUp(mTexels.size()));
+		r.offset = static_cast<uint32_t>(mTexels.size());
+		if (const uint8_t* pixels = static_cast<const uint8_t*>(texture->pixels())) {
+			r.size = static_cast<uint32_t>(static_cast<size_t>(r.width) * r.height * pixelFormatBytes(texture->format()));
+			mTexels.insert(mTexels.end(), pixels, pixels + r.size);
+		} else {
+			++mStats.missing;
+		}
+		mTextures.push_back(r);
+	}
+	return it->second;
+}
+
+uint32_t CommandCapture::transformIndex(const Float4x4* transform) {
+	if (!transform) {
+		return CAPTURE_NONE;
+	}
+	const auto [it, added] = mTransformIndex.try_emplace(transform, static_cast<uint32_t>(mTransforms.size()));
+	if (added) {
+		mTransforms.push_back(*transform);
+	}
+	return it->second;
+}
+
+void CommandCapture::capture(const CommandQueue& queue, const CaptureFrameRecord& frame) {
+	clear();
+	mFrame = frame;
+	mFrame.dropped = queue.stats().dropped;
+
+	const uint32_t count = queue.size();
+	const SortPair* items = queue.items();
+
+	// First the span each vertex buffer is read over
+	std::unordered_map<const IVertexBuffer*, BufferSpan> spans;
+	for (uint32_t i = 0; i < count; ++i) {
+		const DrawCommand& cmd = queue.command(items[i]);
+		if (!cmd.vertices) {
+			continue;
+		}
+		const auto [it, added] = spans.try_emplace(cmd.vertices, BufferSpan{ static_cast<uint32_t>(mBuffers.size()), cmd.first, cmd.first + cmd.count });
+		if (added) {
+			mBuffers.push_back({ 0, 0, 0, cmd.vertices->vertexCount() });
+		} else {
+			it->second.lo = std::min(it->second.lo, cmd.first);
+			it->second.hi = std::max(it->second.hi, cmd.first + cmd.count);
+		}
+	}
+
+	// Then the spans themselves, clamped to what each buffer holds
+	for (const auto& [buffer, span] : spans) {
+		CaptureBufferRecord& r = mBuffers[span.index];
+		const GfxVertex* src = buffer->vertices();
+		const uint32_t hi = std::min(span.hi, r.sourceCount);
+		r.firstVertex = static_cast<uint32_t>(mVertices.size());
+		r.base = span.lo;
+		if (!src) {
+			++mStats.missing;
+			continue;
+		}
+		if (span.lo < hi) {
+			r.vertexCount = hi - span.lo;
+			mVertices.insert(mVertices.end(), src + span.lo, src + hi);
+		}
+	}
+
+	mDraws.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		const DrawCommand& cmd = queue.command(items[i]);
+		CaptureDrawRecord r = {};
+		r.key = items[i].key;
+		r.material = materialIndex(cmd.material);
+		r.texture = textureIndex(cmd.texture);
+		r.buffer = cmd.vertices ? spans[cmd.vertices].index : CAPTURE_NONE;
+		r.transform = transformIndex(cmd.transform);
+		r.first = cmd.vertices ? (cmd.first - mBuffers[r.buffer].base) : cmd.first;
+		r.count = cmd.count;
+		r.primitive = static_cast<uint32_t>(cmd.primitive);
+		mDraws.push_back(r);
+	}
+
+	mStats.draws = count;
+	mStats.buffers = static_cast<uint32_t>(mBuffers.size());
+	mStats.textures = static_cast<uint32_t>(mTextures.size());
+	mStats.materials = static_cast<uint32_t>(mMaterials.size());
+	mStats.transforms = static_cast<uint32_t>(mTransforms.size());
+	mStats.vertices = static_cast<uint32_t>(mVertices.size());
+	mStats.texelBytes = mTexels.size();
+}
+
+void CommandCapture::serialize(std::vector<uint8_t>& out) const {
+	struct PendingSection {
+		CaptureSection	type;
+		const void*		data;
+		size_t			size;
+		size_t			count;
+	};
+	std::vector<PendingSection> sections;
+	auto add = [&](CaptureSection type, const auto& v) {
+		if (!v.empty()) {
+			sections.push_back({ type, v.data(), v.size() * sizeof(v[0]), v.size() });
+		}
+	};
+	sections.push_back({ CaptureSection::Frame, &mFrame, sizeof(mFrame), 1U });
+	add(CaptureSection::Draws, mDraws);
+	add(CaptureSection::Buffers, mBuffers);
+	add(CaptureSection::Vertices, mVertices);
+	add(CaptureSection::Textures, mTextures);
+	add(CaptureSection::Texels, mTexels);
+	add(CaptureSection::Materials, mMaterials);
+	add(CaptureSection::Transforms, mTransforms);
+
+	// Header, section table, then each section on an aligned offset
+	size_t offset = alignUp(sizeof(CaptureFileHeader) + sections.size() * sizeof(CaptureSectionEntry));
+	std::vector<CaptureSectionEntry> table;
+	for (const PendingSection& s : sections) {
+		table.push_back({ static_cast<uint32_t>(s.type), static_cast<uint32_t>(offset),
+			static_cast<uint32_t>(s.size), static_cast<uint32_t>(s.count) });
+		offset = alignUp(offset + s.size);
+	}
+
+	out.assign(offset, 0);
+	CaptureFileHeader hdr = {};
+	hdr.magic = CAPTURE_FILE_MAGIC;
+	hdr.version = CAPTURE_FILE_VERSION;
+	hdr.sectionCount = static_cast<uint16_t>(sections.size());
+	hdr.fileSize = static_cast<uint32_t>(offset);
+	std::memcpy(out.data(), &hdr, sizeof(hdr));
+	std::memcpy(out.data() + sizeof(hdr), table.data(), table.size() * sizeof(CaptureSectionEntry));
+	for (size_t i = 0; i < sections.size(); ++i) {
+		std::memcpy(out.data() + table[i].offset, sections[i].data, sections[i].size);
+	}
+}
+
+bool CommandCapture::write(const char* path) const {
+	std::vector<uint8_t> bytes;
+	serialize(bytes);
+	std::FILE* fp = std::fopen(path, "wb");
+	if (!fp) {
+		return false;
+	}
+	const bool ok = std::fwrite(bytes.data(), 1, bytes.size(), fp) == bytes.size();
+	return (std::fclose(fp) == 0) && ok;
+}
+
+//================================================================
+
+ReplayVertexBuffer::~ReplayVertexBuffer() noexcept {}
+
+ReplayTexture::~ReplayTexture() noexcept {}
+
+ReplayMaterial::ReplayMaterial(const CaptureMaterialRecord& record) noexcept
+	: mParams(record.params)
+	, mSortKey(record.sortKey) {
+	mState.shader = record.shader;
+	mState.list = static_cast<RenderList>(record.list);
+	mState.srcBlend = static_cast<BlendFactor>(record.srcBlend);
+	mState.dstBlend = static_cast<BlendFactor>(record.dstBlend);
+	mState.depthCompare = static_cast<DepthCompare>(record.depthCompare);
+	mState.depthWrite = (record.depthWrite != 0U);
+	mState.cull = static_cast<CullMode>(record.cull);
+	mState.filter = static_cast<TextureFilter>(record.filter);
+	mState.wrapU = static_cast<TextureWrap>(record.wrapU);
+	mState.wrapV = static_cast<TextureWrap>(record.wrapV);
+	mState.shading = static_cast<ShadeMode>(record.shading);
+	mState.fog = (record.fog != 0U);
+	mHash = mState.hash();
+}
+
+ReplayMaterial::~ReplayMaterial() noexcept {}
+
+//================================================================
+
+bool CommandReplay::open(const char* path, bool map) {
+	close();
+	if (!mFile.open(path, map)) {
+		return false;
+	}
+
+	size_t frames = 0;
+	size_t bufferCount = 0;
+	size_t vertexCount = 0;
+	size_t textureCount = 0;
+	size_t texelBytes = 0;
+	size_t materialCount = 0;
+	const CaptureFrameRecord* frame = mFile.section<CaptureFrameRecord>(CaptureSection::Frame, frames);
+	const CaptureBufferRecord* buffers = mFile.section<CaptureBufferRecord>(CaptureSection::Buffers, bufferCount);
+	const GfxVertex* vertices = mFile.section<GfxVertex>(CaptureSection::Vertices, vertexCount);
+	const CaptureTextureRecord* textures = mFile.section<CaptureTextureRecord>(CaptureSection::Textures, textureCount);
+	const uint8_t* texels = mFile.section<uint8_t>(CaptureSection::Texels, texelBytes);
+	const CaptureMaterialRecord* materials = mFile.section<CaptureMaterialRecord>(CaptureSection::Materials, materialCount);
+	mDraws = mFile.section<CaptureDrawRecord>(CaptureSection::Draws, mDrawCount);
+	mTransforms = mFile.section<Float4x4>(CaptureSection::Transforms, mTransformCount);
+	if (frames != 1U) {
+		close();
+		return false;
+	}
+
+	// Every reference has to land inside the file before anything points into it
+	for (size_t i = 0; i < bufferCount; ++i) {
+		const CaptureBufferRecord& b = buffers[i];
+		if (static_cast<size_t>(b.firstVertex) + b.vertexCount > vertexCount) {
+			close();
+			return false;
+		}
+	}
+	for (size_t i = 0; i < textureCount; ++i) {
+		const CaptureTextureRecord& t = textures[i];
+		const size_t expected = static_cast<size_t>(t.width) * t.height * pixelFormatBytes(static_cast<PixelFormat>(t.format));
+		if (t.format > static_cast<uint32_t>(PixelFormat::ARGB8888) || (t.size != 0U && t.size != expected)
+		|| static_cast<size_t>(t.offset) + t.size > texelBytes) {
+			close();
+			return false;
+		}
+	}
+	for (size_t i = 0; i < materialCount; ++i) {
+		if (!validMaterial(materials[i])) {
+			close();
+			return false;
+		}
+	}
+	for (size_t i = 0; i < mDrawCount; ++i) {
+		const CaptureDrawRecord& d = mDraws[i];
+		if ((d.material != CAPTURE_NONE && d.material >= materialCount)
+		|| (d.texture != CAPTURE_NONE && d.texture >= textureCount)
+		|| (d.buffer != CAPTURE_NONE && d.buffer >= bufferCount)
+		|| (d.transform != CAPTURE_NONE && d.transform >= mTransformCount)
+		|| d.primitive > static_cast<uint32_t>(Primitive::TriangleStrip)) {
+			close();
+			return false;
+		}
+
+		// Inside the captured span, unless the buffer had no CPU copy to capture
+		const uint32_t span = (d.buffer != CAPTURE_NONE) ? buffers[d.buffer].vertexCount : 0U;
+		if (span != 0U && static_cast<uint64_t>(d.first) + d.count > span) {
+			close();
+			return false;
+		}
+	}
+
+	mBuffers.reserve(bufferCount);
+	for (size_t i = 0; i < bufferCount; ++i) {
+		mBuffers.emplace_back(buffers[i].vertexCount ? vertices + buffers[i].firstVertex : nullptr, buffers[i].vertexCount);
+	}
+	mTextures.reserve(textureCount);
+	for (size_t i = 0; i < textureCount; ++i) {
+		mTextures.emplace_back(textures[i], textures[i].size ? texels + textures[i].offset : nullptr);
+	}
+	mMaterials.reserve(materialCount);
+	for (size_t i = 0; i < materialCount; ++i) {
+		mMaterials.emplace_back(materials[i]);
+	}
+	mFrame = frame;
+	return true;
+}
+
+void CommandReplay::close() noexcept {
+	mBuffers.clear();
+	mTextures.clear();
+	mMaterials.clear();
+	mFrame = nullptr;
+	mDraws = nullptr;
+	mDrawCount = 0;
+	mTransforms = nullptr;
+	mTransformCount = 0;
+	mFile.close();
+}
+
+uint32_t CommandReplay::submit(ICommandQueue& queue) const {
+	uint32_t accepted = 0;
+	for (size_t i = 0; i < mDrawCount; ++i) {
+		const CaptureDrawRecord& d = mDraws[i];
+		DrawCommand cmd = {};
+		cmd.material = (d.material != CAPTURE_NONE) ? &mMaterials[d.material] : nullptr;
+		cmd.texture = (d.texture != CAPTURE_NONE) ? &mTextures[d.texture] : nullptr;
+		cmd.vertices = (d.buffer != CAPTURE_NONE) ? &mBuffers[d.buffer] : nullptr;
+		cmd.transform = (d.transform != CAPTURE_NONE) ? &mTransforms[d.transform] : nullptr;
+		cmd.first = d.first;
+		cmd.count = d.count;
+		cmd.primitive = static_cast<Primitive>(d.primitive);
+		accepted += queue.submit(d.key, cmd) ? 1U : 0U;
+	}
+	return accepted;
+}
@@ -0,0 +1,170 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/CommandQueue.hh>
+#include <Engine/gfx/IGfxBackend.hh>
+#include <Engine/gfx/IVertexBuffer.hh>
+
+#include <chrono>
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline float elapsedMs(Clock::time_point start) noexcept {
+	return static_cast<float>(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+}
+
+} // namespace
+
+//================================================================
+
+CommandQueue::CommandQueue(uint32_t maxCommands, size_t arenaBytes)
+	: mItems(maxCommands)
+	, mScratch(maxCommands)
+	, mArena(arenaBytes)
+	, mCount(0)
+	, mDropped(0)
+	, mCapacity(maxCommands)
+	, mSorted(false)
+	, mStats{} {
+}
+
+CommandQueue::~CommandQueue() noexcept {}
+
+void CommandQueue::reset() {
+	mArena.reset();
+	mCount.store(0, std::memory_order_relaxed);
+	mDropped.store(0, std::memory_order_relaxed);
+	mSorted.store(false, std::memory_order_relaxed);
+	mStats = {};
+}
+
+bool CommandQueue::submit(uint64_t key, const DrawCommand& cmd) {
+	// A full queue must not keep eating arena space
+	if (mCount.load(std::memory_order_relaxed) >= mCapacity) {
+		mDropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	DrawCommand* payload = mArena.allocate<DrawCommand>();
+	if (!payload) {
+		mDropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	// Claim a slot without ever counting past capacity (a thread losing
+	// the race for the last slot wastes one payload of arena)
+	uint32_t slot = mCount.load(std::memory_order_relaxed);
+	do {
+		if (slot >= mCapacity) {
+			mDropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+	} while (!mCount.compare_exchange_weak(slot, slot + 1U, std::memory_order_relaxed));
+
+	*payload = cmd;
+	mItems[slot] = { key, mArena.offsetOf(payload), 0U };
+	mSorted.store(false, std::memory_order_relaxed);
+	return true;
+}
+
+void* CommandQueue::allocate(size_t bytes, size_t align) {
+	return mArena.allocate(bytes, align);
+}
+
+void CommandQueue::sort() {
+	const auto start = Clock::now();
+	const uint32_t count = size();
+
+	radixSort(mItems.data(), mScratch.data(), count);
+
+	mSorted.store(true, std::memory_order_relaxed);
+	mStats.submitted = count;
+	mStats.dropped = mDropped.load(std::memory_order_relaxed);
+	mStats.arenaBytes = mArena.used();
+	mStats.sortMs = elapsedMs(start);
+}
+
+void CommandQueue::execute(IGfxBackend& backend) {
+	if (!mSorted.load(std::memory_order_relaxed)) {
+		sort();
+	}
+
+	const auto start = Clock::now();
+	const uint32_t count = size();
+
+	// Nothing is bound at the start of a frame, so the first draw binds everything
+	bool first = true;
+	uint8_t pass = 0;
+	RenderList list = RenderList::Opaque;
+	const IMaterial* material = nullptr;
+	const ITexture* texture = nullptr;
+	const IVertexBuffer* vertices = nullptr;
+
+	uint32_t changes = 0;
+	uint32_t pipelines = 0;
+	uint32_t skipped = 0;
+
+	for (uint32_t i = 0; i < count; ++i) {
+		const SortPair& item = mItems[i];
+		const DrawCommand& cmd = command(item);
+
+		const uint8_t itemPass = SortKey::pass(item.key);
+		const RenderList itemList = SortKey::list(item.key);
+
+		if (first || itemPass != pass) {
+			backend.setPass(itemPass);
+			pass = itemPass;
+			++changes;
+		} else {
+			++skipped;
+		}
+
+		if (first || itemList != list) {
+			backend.setRenderList(itemList);
+			list = itemList;
+			++changes;
+		} else {
+			++skipped;
+		}
+
+		if (first || cmd.material != material) {
+			// Materials sharing a pipeline state only change parameters
+			const bool samePipeline = !first && cmd.material && material && cmd.material->state() == material->state();
+			pipelines += samePipeline ? 0U : 1U;
+			backend.bindMaterial(cmd.material);
+			material = cmd.material;
+			++changes;
+		} else {
+			++skipped;
+		}
+
+		if (first || cmd.texture != texture) {
+			backend.bindTexture(cmd.texture);
+			texture = cmd.texture;
+			++changes;
+		} else {
+			++skipped;
+		}
+
+		if (first || cmd.vertices != vertices) {
+			backend.bindVertexBuffer(cmd.vertices);
+			vertices = cmd.vertices;
+			++changes;
+		} else {
+			++skipped;
+		}
+
+		backend.draw(cmd);
+		first = false;
+	}
+
+	mStats.draws = count;
+	mStats.stateChanges = changes;
+	mStats.pipelineChanges = pipelines;
+	mStats.redundantSkipped = skipped;
+	mStats.executeMs = elapsedMs(start);
+}
@@ -0,0 +1,56 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/IBillboard.hh>
+#include <Engine/gfx/IBrush.hh>
+#include <Engine/gfx/ICommandQueue.hh>
+#include <Engine/gfx/IFrameBuffer.hh>
+#include <Engine/gfx/IGfxBackend.hh>
+#include <Engine/gfx/ILight.hh>
+#include <Engine/gfx/ILightmap.hh>
+#include <Engine/gfx/IMaterial.hh>
+#include <Engine/gfx/IPen.hh>
+#include <Engine/gfx/IShader.hh>
+#include <Engine/gfx/ISprite.hh>
+#include <Engine/gfx/ITexture.hh>
+#include <Engine/gfx/ITileset.hh>
+#include <Engine/gfx/IVertexBuffer.hh>
+#include <Engine/gfx/IViewport.hh>
+#include <Engine/gfx/IVisualFX.hh>
+
+//================================================================
+// Out of line so each interface's vtable is emitted once, here,
+// rather than in whichever implementation happens to use it.
+//================================================================
+
+IBillboard::~IBillboard() noexcept {}
+
+IBrush::~IBrush() noexcept {}
+
+ICommandQueue::~ICommandQueue() noexcept {}
+
+IFrameBuffer::~IFrameBuffer() noexcept {}
+
+IGfxBackend::~IGfxBackend() noexcept {}
+
+ILight::~ILight() noexcept {}
+
+ILightmap::~ILightmap() noexcept {}
+
+IMaterial::~IMaterial() noexcept {}
+
+IPen::~IPen() noexcept {}
+
+IShader::~IShader() noexcept {}
+
+ISprite::~ISprite() noexcept {}
+
+ITexture::~ITexture() noexcept {}
+
+ITileset::~ITileset() noexcept {}
+
+IVertexBuffer::~IVertexBuffer() noexcept {}
+
+IViewport::~IViewport() noexcept {}
+
+IVisualFX::~IVisualFX() noexcept {}
@@ -0,0 +1,101 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/MaterialSystem.hh>
+
+#include <functional>
+
+//================================================================
+
+Material::~Material() noexcept {}
+
+//================================================================
+
+MaterialSystem::MaterialSystem(uint32_t maxMaterials)
+	: mMaterials((maxMaterials < MAX_MATERIALS) ? maxMaterials : MAX_MATERIALS)
+	, mParams(mMaterials.size())
+	, mCapacity(static_cast<uint32_t>(mMaterials.size()))
+	, mLive(0)
+	, mDeduplicated(0) {
+	// Hand out low slots first so the live part of the pool stays dense
+	mFreeSlots.reserve(mCapacity);
+	for (uint32_t slot = mCapacity; slot > 0; --slot) {
+		mFreeSlots.push_back(slot - 1U);
+	}
+}
+
+MaterialSystem::~MaterialSystem() noexcept {}
+
+//----------------------------------------------------------------
+
+uint32_t MaterialSystem::intern(const PipelineState& state, uint32_t hash) {
+	const auto range = mStateIds.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it) {
+		if (mStates[it->second] == state) {
+			++mDeduplicated;
+			return it->second;
+		}
+	}
+
+	const uint32_t id = static_cast<uint32_t>(mStates.size());
+	if (id >= MAX_STATES) {
+		return MAX_STATES;
+	}
+	mStates.push_back(state);
+	mStateRefs.push_back(0);
+	mStateIds.emplace(hash, id);
+	return id;
+}
+
+Material* MaterialSystem::create(const PipelineState& state, const MaterialParams& params) {
+	if (mFreeSlots.empty()) {
+		return nullptr;
+	}
+
+	const uint32_t hash = state.hash();
+	const uint32_t id = intern(state, hash);
+	if (id == MAX_STATES) {
+		return nullptr;
+	}
+	++mStateRefs[id];
+
+	const uint32_t slot = mFreeSlots.back();
+	mFreeSlots.pop_back();
+
+	Material& material = mMaterials[slot];
+	material.mState = state;
+	material.mHash = hash;
+	material.mStateId = id;
+	material.mSortKey = (id << SLOT_BITS) | slot;
+	material.mParams = &mParams[slot];
+	material.mLive = true;
+	mParams[slot] = params;
+	++mLive;
+	return &material;
+}
+
+void MaterialSystem::destroy(Material* material) noexcept {
+	// Only our own live slots go back on the free list, anything else would hand a slot out twice
+	const std::less<const Material*> before;
+	const Material* first = mMaterials.data();
+	if (!material || before(material, first) || !before(material, first + mCapacity) || !material->mLive) {
+		return;
+	}
+
+	--mStateRefs[material->mStateId];
+	material->mLive = false;
+	material->mParams = nullptr;
+	mFreeSlots.push_back(static_cast<uint32_t>(material - first));
+	--mLive;
+}
+
+MaterialSystemStats MaterialSystem::stats() const noexcept {
+	MaterialSystemStats stats = {};
+	stats.materials = mLive;
+	for (uint32_t refs : mStateRefs) {
+		stats.uniqueStates += (refs != 0) ? 1U : 0U;
+	}
+	stats.deduplicated = mDeduplicated;
+	stats.paramBytes = static_cast<size_t>(mLive) * sizeof(MaterialParams);
+	return stats;
+}
@@ -0,0 +1,182 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/PostChain.hh>
+#include <Engine/gfx/Color.hh>
+#include <Engine/core/Jobs.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline float elapsedMs(Clock::time_point start) noexcept {
+	return static_cast<float>(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+}
+
+}
+
+//================================================================
+
+PostChain::PostChain(const PostChainSettings& settings)
+	: mPool({ settings.vramBudget })
+	, mSettings(settings)
+	, mStats{} {
+}
+
+PostChain::~PostChain() noexcept {}
+
+void PostChain::add(IVisualFX* effect) {
+	if (effect) {
+		mEffects.push_back(effect);
+	}
+}
+
+void PostChain::remove(IVisualFX* effect) noexcept {
+	mEffects.erase(std::remove(mEffects.begin(), mEffects.end(), effect), mEffects.end());
+}
+
+void PostChain::clear() noexcept {
+	mEffects.clear();
+}
+
+void PostChain::setSettings(const PostChainSettings& settings) noexcept {
+	mSettings = settings;
+	RenderTargetPoolSettings poolSettings = mPool.settings();
+	poolSettings.vramBudget = settings.vramBudget;
+	mPool.setSettings(poolSettings);
+}
+
+//----------------------------------------------------------------
+
+bool PostChain::plan(uint32_t width, uint32_t height) {
+	mActive.clear();
+	for (IVisualFX* effect : mEffects) {
+		if (effect->enabled()) {
+			mActive.push_back(effect);
+		}
+	}
+
+	// An effect whose targets don't fit is dropped and the rest planned again, within the same pool frame
+	mPool.beginFrame();
+	for (;;) {
+		mPasses.clear();
+		for (uint32_t i = 0; i < mActive.size(); ++i) {
+			if (mPasses.empty() || !mSettings.fuse || mActive[i]->readsInput()) {
+				mPasses.push_back({ i, i });
+			}
+			mPasses.back().end = i + 1U;
+		}
+
+		std::vector<uint32_t> declared(mActive.size(), 0U);
+		for (uint32_t p = 0; p < mPasses.size(); ++p) {
+			for (uint32_t i = mPasses[p].first; i < mPasses[p].end; ++i) {
+				const uint32_t before = mPool.stats().targets;
+				mActive[i]->setup({ &mPool, width, height, p * 2U, p * 2U + 1U });
+				declared[i] = mPool.stats().targets - before;
+			}
+		}
+		if (mPool.compile()) {
+			return true;
+		}
+
+		// Drop the last effect with targets, the earlier ones usually matter more
+		uint32_t drop = static_cast<uint32_t>(mActive.size());
+		for (uint32_t i = static_cast<uint32_t>(mActive.size()); i-- > 0;) {
+			if (declared[i]) {
+				drop = i;
+				break;
+			}
+		}
+		if (drop == mActive.size()) {
+			return false;
+		}
+		mActive.erase(mActive.begin() + drop);
+		mPool.redeclare();
+		++mStats.skipped;
+	}
+}
+
+void PostChain::shade(const PostImage& src, const PostImage& dst, const Pass& pass) {
+	const uint32_t width = dst.width;
+	const uint32_t height = dst.height;
+	const uint32_t tilesX = (width + TILE_WIDTH - 1U) / TILE_WIDTH;
+	const uint32_t tilesY = (height + TILE_HEIGHT - 1U) / TILE_HEIGHT;
+	mStats.tiles += tilesX * tilesY;
+	++mStats.passes;
+
+	IVisualFX* const* effects = mActive.data() + pass.first;
+	const uint32_t effectCount = pass.end - pass.first;
+
+	JobSystem::instance().parallelFor(static_cast<size_t>(tilesX) * tilesY, 1U, [&](size_t begin, size_t end) {
+		alignas(16) float r[TILE_WIDTH];
+		alignas(16) float g[TILE_WIDTH];
+		alignas(16) float b[TILE_WIDTH];
+		for (size_t tile = begin; tile < end; ++tile) {
+			const uint32_t x0 = static_cast<uint32_t>(tile % tilesX) * TILE_WIDTH;
+			const uint32_t y0 = static_cast<uint32_t>(tile / tilesX) * TILE_HEIGHT;
+			const uint32_t count = std::min(TILE_WIDTH, width - x0);
+			const uint32_t padded = (count + 3U) & ~3U;
+			const uint32_t y1 = std::min(height, y0 + TILE_HEIGHT);
+
+			for (uint32_t y = y0; y < y1; ++y) {
+				const uint32_t* in = src.row(y) + x0;
+				uint32_t* out = dst.row(y) + x0;
+
+				argbToPlanar(in, r, g, b, count);
+				for (uint32_t i = count; i < padded; ++i) {
+					r[i] = r[count - 1U];
+					g[i] = g[count - 1U];
+					b[i] = b[count - 1U];
+				}
+
+				PostSpan span = { r, g, b, x0, y, padded };
+				for (uint32_t e = 0; e < effectCount; ++e) {
+					effects[e]->shade(span);
+				}
+
+				planarToArgb(r, g, b, in, out, count);
+			}
+		}
+	});
+}
+
+bool PostChain::apply(const PostImage& src, const PostImage& dst) {
+	const Clock::time_point start = Clock::now();
+	mStats = {};
+	if (src.width != dst.width || src.height != dst.height || !src.pixels || !dst.pixels) {
+		return false;
+	}
+
+	if (!plan(dst.width, dst.height) || mPasses.empty()) {
+		if (src.pixels != dst.pixels) {
+			for (uint32_t y = 0; y < dst.height; ++y) {
+				std::memcpy(dst.row(y), src.row(y), static_cast<size_t>(dst.width) * sizeof(uint32_t));
+			}
+		}
+		mStats.totalMs = elapsedMs(start);
+		return true;
+	}
+	mStats.effects = static_cast<uint32_t>(mActive.size());
+
+	for (uint32_t p = 0; p < mPasses.size(); ++p) {
+		const PostImage& input = (p == 0) ? src : dst;
+
+		const Clock::time_point prepareStart = Clock::now();
+		for (uint32_t i = mPasses[p].first; i < mPasses[p].end; ++i) {
+			mActive[i]->prepare(input, mPool);
+		}
+		mStats.prepareMs += elapsedMs(prepareStart);
+
+		const Clock::time_point shadeStart = Clock::now();
+		shade(input, dst, mPasses[p]);
+		mStats.shadeMs += elapsedMs(shadeStart);
+	}
+	mStats.totalMs = elapsedMs(start);
+	return true;
+}
@@ -0,0 +1,463 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/PostEffects.hh>
+#include <Engine/gfx/Color.hh>
+#include <Engine/core/Jobs.hh>
+#include <Engine/math/simd.hh>
+
+#include <algorithm>
+#include <cmath>
+
+//================================================================
+
+namespace {
+
+constexpr size_t BLOOM_ROW_GRAIN = 4U;
+constexpr float PI = 3.14159265358979f;
+
+// 4x4 Bayer thresholds in (0, 1), [y][x]
+constexpr float BAYER[4][4] = {
+	{  0.5f / 16.0f,  8.5f / 16.0f,  2.5f / 16.0f, 10.5f / 16.0f },
+	{ 12.5f / 16.0f,  4.5f / 16.0f, 14.5f / 16.0f,  6.5f / 16.0f },
+	{  3.5f / 16.0f, 11.5f / 16.0f,  1.5f / 16.0f,  9.5f / 16.0f },
+	{ 15.5f / 16.0f,  7.5f / 16.0f, 13.5f / 16.0f,  5.5f / 16.0f }
+};
+
+inline uint32_t clampIndex(int32_t i, uint32_t size) noexcept {
+	return static_cast<uint32_t>(std::clamp(i, 0, static_cast<int32_t>(size) - 1));
+}
+
+inline SimdFloat4 lerp(SimdFloat4 a, SimdFloat4 b, SimdFloat4 t) noexcept {
+	return a + (b - a) * t;
+}
+
+// Planar rows of one image, sized once per job
+struct PlanarRows {
+	std::vector<float>	data;
+	size_t				width;
+
+	PlanarRows(size_t w, size_t rows) : data(w * 3U * rows), width(w) {}
+
+	inline float* r(size_t row) noexcept { return data.data() + row * width * 3U; }
+	inline float* g(size_t row) noexcept { return r(row) + width; }
+	inline float* b(size_t row) noexcept { return r(row) + width * 2U; }
+};
+
+//
+// 5-tap binomial along rows of `src` into `dst`. Each row is unpacked
+// with two clamped pixels either side so every tap is a plain load.
+//
+void blurRows(const RenderTarget& src, RenderTarget& dst) {
+	const uint32_t width = src.width();
+	JobSystem::instance().parallelFor(src.height(), BLOOM_ROW_GRAIN, [&](size_t begin, size_t end) {
+		PlanarRows rows(width + 4U, 2U);
+		for (size_t y = begin; y < end; ++y) {
+			const uint32_t* in = static_cast<const uint32_t*>(src.pixels()) + y * width;
+			argbToPlanar(in, rows.r(0) + 2, rows.g(0) + 2, rows.b(0) + 2, width);
+			for (float* c : { rows.r(0), rows.g(0), rows.b(0) }) {
+				c[0] = c[1] = c[2];
+				c[width + 3U] = c[width + 2U] = c[width + 1U];
+			}
+			for (uint32_t ch = 0; ch < 3U; ++ch) {
+				const float* c = rows.r(0) + ch * rows.width;
+				float* out = rows.r(1) + ch * rows.width;
+				uint32_t x = 0;
+				for (; x + 4U <= width; x += 4U) {
+					const SimdFloat4 sum = (simdLoadU(c + x) + simdLoadU(c + x + 4U))
+						+ (simdLoadU(c + x + 1U) + simdLoadU(c + x + 3U)) * simdSplat(4.0f)
+						+ simdLoadU(c + x + 2U) * simdSplat(6.0f);
+					simdStoreU(out + x, sum * simdSplat(1.0f / 16.0f));
+				}
+				for (; x < width; ++x) {
+					out[x] = (c[x] + c[x + 4U] + (c[x + 1U] + c[x + 3U]) * 4.0f + c[x + 2U] * 6.0f) * (1.0f / 16.0f);
+				}
+			}
+			uint32_t* outRow = static_cast<uint32_t*>(dst.data()) + y * width;
+			planarToArgb(rows.r(1), rows.g(1), rows.b(1), in, outRow, width);
+		}
+	});
+}
+
+// 5-tap binomial down columns of `src` into `dst`
+void blurColumns(const RenderTarget& src, RenderTarget& dst) {
+	const uint32_t width = src.width();
+	const uint32_t height = src.height();
+	const uint32_t* pixels = static_cast<const uint32_t*>(src.pixels());
+	JobSystem::instance().parallelFor(height, BLOOM_ROW_GRAIN, [&](size_t begin, size_t end) {
+		PlanarRows rows(width, 6U);
+		for (size_t y = begin; y < end; ++y) {
+			for (uint32_t k = 0; k < 5U; ++k) {
+				const uint32_t sy = clampIndex(static_cast<int32_t>(y + k) - 2, height);
+				argbToPlanar(pixels + static_cast<size_t>(sy) * width, rows.r(k), rows.g(k), rows.b(k), width);
+			}
+			for (uint32_t ch = 0; ch < 3U; ++ch) {
+				const size_t offset = ch * rows.width;
+				float* out = rows.r(5) + offset;
+				uint32_t x = 0;
+				for (; x + 4U <= width; x += 4U) {
+					const auto at = [&](uint32_t k) { return simdLoadU(rows.r(k) + offset + x); };
+					const SimdFloat4 sum = (at(0) + at(4)) + (at(1) + at(3)) * simdSplat(4.0f) + at(2) * simdSplat(6.0f);
+					simdStoreU(out + x, sum * simdSplat(1.0f / 16.0f));
+				}
+				for (; x < width; ++x) {
+					const auto at = [&](uint32_t k) { return rows.r(k)[offset + x]; };
+					out[x] = (at(0) + at(4) + (at(1) + at(3)) * 4.0f + at(2) * 6.0f) * (1.0f / 16.0f);
+				}
+			}
+			uint32_t* outRow = static_cast<uint32_t*>(dst.data()) + y * width;
+			planarToArgb(rows.r(5), rows.g(5), rows.b(5), outRow, outRow, width);
+		}
+	});
+}
+
+}
+
+//================================================================
+// BloomFX
+//================================================================
+
+BloomFX::~BloomFX() noexcept {}
+
+void BloomFX::setup(const PostSetup& setup) {
+	const RenderTargetDesc desc = { (setup.width + SCALE - 1U) / SCALE, (setup.height + SCALE - 1U) / SCALE, PixelFormat::ARGB8888 };
+	mGlowId = setup.pool->declare(desc);
+	mScratchId = setup.pool->declare(desc);
+	setup.pool->use(mGlowId, setup.preparePass);
+	setup.pool->use(mGlowId, setup.shadePass);
+	setup.pool->use(mScratchId, setup.preparePass);
+	mGlow = nullptr;
+}
+
+void BloomFX::prepare(const PostImage& input, RenderTargetPool& pool) {
+	RenderTarget* glow = pool.target(mGlowId);
+	RenderTarget* scratch = pool.target(mScratchId);
+	mGlow = nullptr;
+	if (!glow || !scratch) {
+		return;
+	}
+
+	// Bright pass and box filter: rows summed in SIMD, then columns four at a time
+	const uint32_t width = input.width;
+	const uint32_t glowWidth = glow->width();
+	const float threshold = mThreshold;
+	const float scale = 1.0f / (16.0f * std::max(1.0f - threshold, 1.0f / 255.0f));
+	JobSystem::instance().parallelFor(glow->height(), BLOOM_ROW_GRAIN, [&](size_t begin, size_t end) {
+		PlanarRows rows(width, 2U);
+		PlanarRows out(glowWidth, 1U);
+		for (size_t gy = begin; gy < end; ++gy) {
+			std::fill(rows.data.begin(), rows.data.begin() + width * 3U, 0.0f);
+			for (uint32_t k = 0; k < SCALE; ++k) {
+				const uint32_t y = clampIndex(static_cast<int32_t>(gy * SCALE + k), input.height);
+				argbToPlanar(input.row(y), rows.r(1), rows.g(1), rows.b(1), width);
+				for (size_t i = 0; i < width * 3U; i += 4U) {
+					float* sum = rows.r(0) + i;
+					const float* row = rows.r(1) + i;
+					if (i + 4U <= width * 3U) {
+						simdStoreU(sum, simdLoadU(sum) + simdLoadU(row));
+					} else {
+						for (size_t j = 0; i + j < width * 3U; ++j) {
+							sum[j] += row[j];
+						}
+					}
+				}
+			}
+			for (uint32_t ch = 0; ch < 3U; ++ch) {
+				const float* sum = rows.r(0) + ch * width;
+				float* dst = out.r(0) + ch * glowWidth;
+				for (uint32_t gx = 0; gx < glowWidth; ++gx) {
+					float s = 0.0f;
+					for (uint32_t k = 0; k < SCALE; ++k) {
+						s += sum[std::min(gx * SCALE + k, width - 1U)];
+					}
+					dst[gx] = std::max(s - threshold * 16.0f, 0.0f) * scale;
+				}
+			}
+			uint32_t* glowRow = static_cast<uint32_t*>(glow->data()) + gy * glowWidth;
+			planarToArgb(out.r(0), out.g(0), out.b(0), glowRow, glowRow, glowWidth);
+		}
+	});
+
+	for (uint32_t pass = 0; pass < mPasses; ++pass) {
+		blurRows(*glow, *scratch);
+		blurColumns(*scratch, *glow);
+	}
+	mGlow = glow;
+}
+
+void BloomFX::shade(PostSpan& span) const noexcept {
+	if (!mGlow) {
+		return;
+	}
+	const uint32_t glowWidth = mGlow->width();
+	const uint32_t glowHeight = mGlow->height();
+	const uint32_t* pixels = static_cast<const uint32_t*>(mGlow->pixels());
+
+	// The two glow rows around this one, blended, over the columns the span touches
+	const float fy = (static_cast<float>(span.y) + 0.5f) / static_cast<float>(SCALE) - 0.5f;
+	const float floorY = std::floor(fy);
+	const float wy = fy - floorY;
+	const uint32_t* row0 = pixels + static_cast<size_t>(clampIndex(static_cast<int32_t>(floorY), glowHeight)) * glowWidth;
+	const uint32_t* row1 = pixels + static_cast<size_t>(clampIndex(static_cast<int32_t>(floorY) + 1, glowHeight)) * glowWidth;
+
+	constexpr uint32_t COLUMNS = POST_SPAN_MAX / SCALE + 2U;
+	float cr[COLUMNS];
+	float cg[COLUMNS];
+	float cb[COLUMNS];
+	const int32_t firstColumn = static_cast<int32_t>(span.x / SCALE) - 1;
+	const uint32_t columns = span.count / SCALE + 2U;
+	const float w0 = (1.0f - wy) * (1.0f / 255.0f);
+	const float w1 = wy * (1.0f / 255.0f);
+	for (uint32_t i = 0; i < columns; ++i) {
+		const uint32_t x = clampIndex(firstColumn + static_cast<int32_t>(i), glowWidth);
+		const uint32_t a = row0[x];
+		const uint32_t b = row1[x];
+		cr[i] = static_cast<float>((a >> 16) & 0xFFU) * w0 + static_cast<float>((b >> 16) & 0xFFU) * w1;
+		cg[i] = static_cast<float>((a >> 8) & 0xFFU) * w0 + static_cast<float>((b >> 8) & 0xFFU) * w1;
+		cb[i] = static_cast<float>(a & 0xFFU) * w0 + static_cast<float>(b & 0xFFU) * w1;
+	}
+
+	// Four pixels share a glow column: lanes 0, 1 blend with the one left, 2, 3 with the one right
+	const SimdFloat4 weight = simdSet(0.625f, 0.875f, 0.125f, 0.375f);
+	const SimdFloat4 intensity = simdSplat(mIntensity);
+	for (uint32_t i = 0; i < span.count; i += 4U) {
+		const uint32_t c = i / SCALE + 1U;
+		const auto sample = [&](const float* col) {
+			const SimdFloat4 left = simdSet(col[c - 1U], col[c - 1U], col[c], col[c]);
+			const SimdFloat4 right = simdSet(col[c], col[c], col[c + 1U], col[c + 1U]);
+			return lerp(left, right, weight) * intensity;
+		};
+		simdStore(span.r + i, simdLoad(span.r + i) + sample(cr));
+		simdStore(span.g + i, simdLoad(span.g + i) + sample(cg));
+		simdStore(span.b + i, simdLoad(span.b + i) + sample(cb));
+	}
+}
+
+//================================================================
+// ColorGradeFX
+//================================================================
+
+ColorGradeFX::ColorGradeFX() {
+	setGrade({});
+	mEnabled = false;
+}
+
+ColorGradeFX::~ColorGradeFX() noexcept {}
+
+void ColorGradeFX::setGrade(const ColorGrade& grade, uint32_t size) {
+	size = std::clamp(size, 2U, MAX_LUT_SIZE);
+	mSize = size;
+	mLut.assign(static_cast<size_t>(size) * size * size * 4U, 0.0f);
+
+	const float exposure = std::exp2(grade.exposure);
+	const float invGamma = 1.0f / std::max(grade.gamma, 0.01f);
+	const float step = 1.0f / static_cast<float>(size - 1U);
+	float* entry = mLut.data();
+	for (uint32_t b = 0; b < size; ++b) {
+		for (uint32_t g = 0; g < size; ++g) {
+			for (uint32_t r = 0; r < size; ++r, entry += 4) {
+				float c[3] = {
+					static_cast<float>(r) * step * exposure * grade.tint.x,
+					static_cast<float>(g) * step * exposure * grade.tint.y,
+					static_cast<float>(b) * step * exposure * grade.tint.z
+				};
+				const float luma = 0.299f * c[0] + 0.587f * c[1] + 0.114f * c[2];
+				for (uint32_t ch = 0; ch < 3U; ++ch) {
+					float v = (c[ch] - 0.5f) * grade.contrast + 0.5f;
+					v = luma + (v - luma) * grade.saturation;
+					entry[ch] = std::pow(std::clamp(v, 0.0f, 1.0f), invGamma);
+				}
+			}
+		}
+	}
+	mEnabled = true;
+}
+
+bool ColorGradeFX::setLut(const uint32_t* strip, uint32_t size) {
+	if (!strip || size < 2U || size > MAX_LUT_SIZE) {
+		return false;
+	}
+	mSize = size;
+	mLut.assign(static_cast<size_t>(size) * size * size * 4U, 0.0f);
+
+	const size_t stripWidth = static_cast<size_t>(size) * size;
+	float* entry = mLut.data();
+	for (uint32_t b = 0; b < size; ++b) {
+		for (uint32_t g = 0; g < size; ++g) {
+			const uint32_t* texel = strip + g * stripWidth + static_cast<size_t>(b) * size;
+			for (uint32_t r = 0; r < size; ++r, entry += 4) {
+				entry[0] = static_cast<float>((texel[r] >> 16) & 0xFFU) * (1.0f / 255.0f);
+				entry[1] = static_cast<float>((texel[r] >> 8) & 0xFFU) * (1.0f / 255.0f);
+				entry[2] = static_cast<float>(texel[r] & 0xFFU) * (1.0f / 255.0f);
+			}
+		}
+	}
+	mEnabled = true;
+	return true;
+}
+
+void ColorGradeFX::shade(PostSpan& span) const noexcept {
+	const uint32_t size = mSize;
+	const float* lut = mLut.data();
+	const SimdFloat4 zero = simdSplat(0.0f);
+	const SimdFloat4 top = simdSplat(static_cast<float>(size - 1U));
+	const SimdFloat4 lastCell = simdSplat(static_cast<float>(size - 2U));
+	const SimdInt4 rowStride = simdSplat(static_cast<int32_t>(size));
+	const SimdInt4 sliceStride = simdSplat(static_cast<int32_t>(size * size));
+
+	// Corner offsets in floats, red then green then blue step
+	const size_t dr = 4U;
+	const size_t dg = static_cast<size_t>(size) * 4U;
+	const size_t db = static_cast<size_t>(size) * size * 4U;
+
+	for (uint32_t i = 0; i < span.count; i += 4U) {
+		const SimdFloat4 pr = simdMin(simdMax(simdLoad(span.r + i), zero), simdSplat(1.0f)) * top;
+		const SimdFloat4 pg = simdMin(simdMax(simdLoad(span.g + i), zero), simdSplat(1.0f)) * top;
+		const SimdFloat4 pb = simdMin(simdMax(simdLoad(span.b + i), zero), simdSplat(1.0f)) * top;
+		const SimdInt4 ir = simdTruncate(simdMin(pr, lastCell));
+		const SimdInt4 ig = simdTruncate(simdMin(pg, lastCell));
+		const SimdInt4 ib = simdTruncate(simdMin(pb, lastCell));
+
+		// Integer multiply isn't in simd.hh, go through float (indices stay far below 2^24)
+		const SimdInt4 cell = ir + simdTruncate(simdToFloat(ig) * simdToFloat(rowStride)) + simdTruncate(simdToFloat(ib) * simdToFloat(sliceStride));
+
+		alignas(16) int32_t base[4];
+		alignas(16) float fr[4];
+		alignas(16) float fg[4];
+		alignas(16) float fb[4];
+		simdStore(base, cell);
+		simdStore(fr, pr - simdToFloat(ir));
+		simdStore(fg, pg - simdToFloat(ig));
+		simdStore(fb, pb - simdToFloat(ib));
+
+		// One pixel per lane group from here: an entry is r, g, b, unused, so a corner is one load
+		for (uint32_t lane = 0; lane < 4U; ++lane) {
+			const float* c = lut + static_cast<size_t>(base[lane]) * 4U;
+			const SimdFloat4 tr = simdSplat(fr[lane]);
+			const SimdFloat4 tg = simdSplat(fg[lane]);
+			const SimdFloat4 tb = simdSplat(fb[lane]);
+			const SimdFloat4 c00 = lerp(simdLoadU(c), simdLoadU(c + dr), tr);
+			const SimdFloat4 c10 = lerp(simdLoadU(c + dg), simdLoadU(c + dg + dr), tr);
+			const SimdFloat4 c01 = lerp(simdLoadU(c + db), simdLoadU(c + db + dr), tr);
+			const SimdFloat4 c11 = lerp(simdLoadU(c + db + dg), simdLoadU(c + db + dg + dr), tr);
+			alignas(16) float out[4];
+			simdStore(out, lerp(lerp(c00, c10, tg), lerp(c01, c11, tg), tb));
+			span.r[i + lane] = out[0];
+			span.g[i + lane] = out[1];
+			span.b[i + lane] = out[2];
+		}
+	}
+}
+
+//================================================================
+// FadeFX
+//================================================================
+
+FadeFX::~FadeFX() noexcept {}
+
+void FadeFX::shade(PostSpan& span) const noexcept {
+	const SimdFloat4 amount = simdSplat(std::min(mAmount, 1.0f));
+	const SimdFloat4 r = simdSplat(mColor.x);
+	const SimdFloat4 g = simdSplat(mColor.y);
+	const SimdFloat4 b = simdSplat(mColor.z);
+	for (uint32_t i = 0; i < span.count; i += 4U) {
+		simdStore(span.r + i, lerp(simdLoad(span.r + i), r, amount));
+		simdStore(span.g + i, lerp(simdLoad(span.g + i), g, amount));
+		simdStore(span.b + i, lerp(simdLoad(span.b + i), b, amount));
+	}
+}
+
+//================================================================
+// CrtFX
+//================================================================
+
+CrtFX::CrtFX() {
+	setMask(0.0f);
+}
+
+CrtFX::~CrtFX() noexcept {}
+
+void CrtFX::setup(const PostSetup& setup) {
+	mInvWidth = 1.0f / static_cast<float>(std::max(setup.width, 1U));
+	mInvHeight = 1.0f / static_cast<float>(std::max(setup.height, 1U));
+}
+
+void CrtFX::setScanlines(float strength, uint32_t lineHeight) noexcept {
+	mScanlines = strength;
+	mLineHeight = std::max(lineHeight, 1U);
+}
+
+void CrtFX::setMask(float strength) noexcept {
+	mMask = strength;
+
+	// The grille repeats every 3 pixels, vectors every 4: three vectors cover the cycle
+	for (uint32_t phase = 0; phase < 3U; ++phase) {
+		for (uint32_t ch = 0; ch < 3U; ++ch) {
+			for (uint32_t lane = 0; lane < 4U; ++lane) {
+				const uint32_t column = (phase * 4U + lane) % 3U;
+				mMaskLanes[phase][ch][lane] = (column == ch) ? 1.0f : 1.0f - strength;
+			}
+		}
+	}
+}
+
+void CrtFX::shade(PostSpan& span) const noexcept {
+	// Brightest mid-line, darkest between lines
+	const float linePhase = (static_cast<float>(span.y % mLineHeight) + 0.5f) / static_cast<float>(mLineHeight);
+	const float gap = std::cos(PI * linePhase);
+	const float scan = 1.0f - mScanlines * gap * gap;
+
+	const float dy = (static_cast<float>(span.y) + 0.5f) * mInvHeight * 2.0f - 1.0f;
+	const SimdFloat4 vignette = simdSplat(mVignette * 0.5f);
+	const SimdFloat4 dy2 = simdSplat(dy * dy);
+	const SimdFloat4 xScale = simdSplat(mInvWidth * 2.0f);
+	const SimdFloat4 zero = simdSplat(0.0f);
+	const SimdFloat4 scanline = simdSplat(scan);
+
+	uint32_t phase = (span.x / 4U) % 3U;
+	SimdFloat4 px = simdSet(0.5f, 1.5f, 2.5f, 3.5f) + simdSplat(static_cast<float>(span.x));
+	for (uint32_t i = 0; i < span.count; i += 4U) {
+		const SimdFloat4 dx = px * xScale - simdSplat(1.0f);
+		const SimdFloat4 shade = scanline * simdMax(simdSplat(1.0f) - (dx * dx + dy2) * vignette, zero);
+		simdStore(span.r + i, simdLoad(span.r + i) * shade * simdLoad(mMaskLanes[phase][0]));
+		simdStore(span.g + i, simdLoad(span.g + i) * shade * simdLoad(mMaskLanes[phase][1]));
+		simdStore(span.b + i, simdLoad(span.b + i) * shade * simdLoad(mMaskLanes[phase][2]));
+		px = px + simdSplat(4.0f);
+		phase = (phase == 2U) ? 0U : phase + 1U;
+	}
+}
+
+//================================================================
+// PaletteFX
+//================================================================
+
+PaletteFX::~PaletteFX() noexcept {}
+
+void PaletteFX::setPalette(const uint32_t* argb, uint32_t count) noexcept {
+	mCount = argb ? std::min(count, MAX_COLORS) : 0U;
+	argbToPlanar(argb, mR, mG, mB, mCount);
+}
+
+void PaletteFX::shade(PostSpan& span) const noexcept {
+	const SimdFloat4 levels = simdSplat(static_cast<float>(mCount - 1U));
+	const SimdFloat4 amount = simdSplat(std::min(mAmount, 1.0f));
+	const SimdFloat4 zero = simdSplat(0.0f);
+	const SimdFloat4 offset = mDither ? simdLoadU(BAYER[span.y & 3U]) : simdSplat(0.5f);
+
+	for (uint32_t i = 0; i < span.count; i += 4U) {
+		const SimdFloat4 r = simdLoad(span.r + i);
+		const SimdFloat4 g = simdLoad(span.g + i);
+		const SimdFloat4 b = simdLoad(span.b + i);
+		const SimdFloat4 luma = r * simdSplat(0.299f) + g * simdSplat(0.587f) + b * simdSplat(0.114f);
+
+		alignas(16) int32_t index[4];
+		simdStore(index, simdTruncate(simdMin(simdMax(luma * levels + offset, zero), levels)));
+		const SimdFloat4 pr = simdSet(mR[index[0]], mR[index[1]], mR[index[2]], mR[index[3]]);
+		const SimdFloat4 pg = simdSet(mG[index[0]], mG[index[1]], mG[index[2]], mG[index[3]]);
+		const SimdFloat4 pb = simdSet(mB[index[0]], mB[index[1]], mB[index[2]], mB[index[3]]);
+
+		simdStore(span.r + i, lerp(r, pr, amount));
+		simdStore(span.g + i, lerp(g, pg, amount));
+		simdStore(span.b + i, lerp(b, pb, amount));
+	}
+}
@@ -0,0 +1,236 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/RenderTargetPool.hh>
+
+#include <algorithm>
+
+//================================================================
+
+namespace {
+
+constexpr uint32_t NEVER = 0xFFFFFFFFU;
+constexpr uint32_t NO_SURFACE = 0xFFFFFFFFU;
+
+}
+
+//================================================================
+
+RenderTarget::~RenderTarget() noexcept {}
+
+//================================================================
+
+RenderTargetPool::RenderTargetPool(const RenderTargetPoolSettings& settings)
+	: mSettings(settings)
+	, mStats{}
+	, mFrame(0)
+	, mAllocatedBytes(0)
+	, mPeakBytes(0)
+	, mCompiled(false) {
+}
+
+RenderTargetPool::~RenderTargetPool() noexcept {}
+
+//----------------------------------------------------------------
+
+void RenderTargetPool::beginFrame() {
+	++mFrame;
+	mSlots.clear();
+	mCompiled = false;
+	mStats = {};
+
+	for (uint32_t i = static_cast<uint32_t>(mSurfaces.size()); i-- > 0;) {
+		mSurfaces[i].busy.clear();
+		if (mSurfaces[i].lastUsed + mSettings.idleFrames < mFrame) {
+			freeSurface(i);
+		}
+	}
+	mStats.allocatedBytes = mAllocatedBytes;
+}
+
+void RenderTargetPool::redeclare() noexcept {
+	mSlots.clear();
+	mCompiled = false;
+	mStats.targets = 0;
+}
+
+RenderTargetId RenderTargetPool::declare(const RenderTargetDesc& desc) {
+	const RenderTargetId id = static_cast<RenderTargetId>(mSlots.size());
+	Slot& slot = mSlots.emplace_back();
+	slot.desc = desc;
+	slot.life = { NEVER, 0 };
+	slot.bytes = static_cast<size_t>(desc.width) * desc.height * pixelFormatBytes(desc.format);
+	slot.surface = NO_SURFACE;
+	++mStats.targets;
+	return id;
+}
+
+void RenderTargetPool::use(RenderTargetId id, uint32_t pass) noexcept {
+	if (id >= mSlots.size()) {
+		return;
+	}
+	Span& life = mSlots[id].life;
+	life.first = std::min(life.first, pass);
+	life.last = std::max(life.last, pass);
+}
+
+//----------------------------------------------------------------
+
+bool RenderTargetPool::fits(const Surface& surface, size_t bytes, const Span& life) const noexcept {
+	if (surface.bytes < bytes) {
+		return false;
+	}
+	for (const Span& other : surface.busy) {
+		if (life.first <= other.last && other.first <= life.last) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void RenderTargetPool::freeSurface(uint32_t index) {
+	mAllocatedBytes -= mSurfaces[index].bytes;
+	++mStats.surfacesFreed;
+
+	// Swap with the last, re-pointing its targets if this frame placed any
+	const uint32_t last = static_cast<uint32_t>(mSurfaces.size()) - 1U;
+	if (index != last) {
+		mSurfaces[index] = std::move(mSurfaces[last]);
+		for (Slot& slot : mSlots) {
+			if (slot.surface == last) {
+				slot.surface = index;
+			}
+		}
+	}
+	mSurfaces.pop_back();
+}
+
+bool RenderTargetPool::compile() {
+	for (Surface& surface : mSurfaces) {
+		surface.busy.clear();
+	}
+
+	mOrder.clear();
+	mStats.culled = 0;
+	mStats.aliased = 0;
+	mStats.requestedBytes = 0;
+	for (uint32_t i = 0; i < mSlots.size(); ++i) {
+		mSlots[i].surface = NO_SURFACE;
+		if (mSlots[i].life.first == NEVER) {
+			++mStats.culled;
+			continue;
+		}
+		mStats.requestedBytes += mSlots[i].bytes;
+		mOrder.push_back(i);
+	}
+
+	// Largest first, so small targets fill in around them
+	std::sort(mOrder.begin(), mOrder.end(), [this](uint32_t a, uint32_t b) {
+		const Slot& sa = mSlots[a];
+		const Slot& sb = mSlots[b];
+		if (sa.bytes != sb.bytes) {
+			return sa.bytes > sb.bytes;
+		}
+		return (sa.life.first != sb.life.first) ? sa.life.first < sb.life.first : a < b;
+	});
+
+	const size_t existing = mSurfaces.size();
+	for (uint32_t i : mOrder) {
+		Slot& slot = mSlots[i];
+
+		uint32_t best = NO_SURFACE;
+		for (uint32_t s = 0; s < mSurfaces.size(); ++s) {
+			if (fits(mSurfaces[s], slot.bytes, slot.life) && (best == NO_SURFACE || mSurfaces[s].bytes < mSurfaces[best].bytes)) {
+				best = s;
+			}
+		}
+
+		if (best == NO_SURFACE) {
+			best = static_cast<uint32_t>(mSurfaces.size());
+			Surface& surface = mSurfaces.emplace_back();
+			surface.bytes = slot.bytes;
+			surface.lastUsed = mFrame;
+		} else if (!mSurfaces[best].busy.empty()) {
+			++mStats.aliased;
+		}
+		mSurfaces[best].busy.push_back(slot.life);
+		slot.surface = best;
+	}
+
+	size_t used = 0;
+	uint32_t surfaces = 0;
+	for (const Surface& surface : mSurfaces) {
+		if (!surface.busy.empty()) {
+			used += surface.bytes;
+			++surfaces;
+		}
+	}
+	mStats.usedBytes = used;
+	mStats.surfaces = surfaces;
+
+	if (used > mSettings.vramBudget) {
+		// Nothing was allocated yet, forget the placement
+		mSurfaces.resize(existing);
+		for (Surface& surface : mSurfaces) {
+			surface.busy.clear();
+		}
+		for (Slot& slot : mSlots) {
+			slot.surface = NO_SURFACE;
+		}
+		mStats.overBudget = true;
+		mCompiled = false;
+		return false;
+	}
+	mStats.overBudget = false;
+
+	// Make room by dropping idle surfaces before allocating new ones
+	const size_t created = mSurfaces.size() - existing;
+	size_t newBytes = 0;
+	for (size_t s = existing; s < mSurfaces.size(); ++s) {
+		newBytes += mSurfaces[s].bytes;
+	}
+	for (uint32_t i = static_cast<uint32_t>(existing); i-- > 0 && mAllocatedBytes + newBytes > mSettings.vramBudget;) {
+		if (mSurfaces[i].busy.empty()) {
+			freeSurface(i);
+		}
+	}
+
+	for (Surface& surface : mSurfaces) {
+		if (surface.memory.empty() && surface.bytes) {
+			surface.memory.resize((surface.bytes + 3U) / 4U);
+			mAllocatedBytes += surface.bytes;
+		}
+		if (!surface.busy.empty()) {
+			surface.lastUsed = mFrame;
+		}
+	}
+	mStats.surfacesCreated = static_cast<uint32_t>(created);
+	mStats.allocatedBytes = mAllocatedBytes;
+	mPeakBytes = std::max(mPeakBytes, mAllocatedBytes);
+
+	for (Slot& slot : mSlots) {
+		RenderTarget& target = slot.target;
+		target.mWidth = slot.desc.width;
+		target.mHeight = slot.desc.height;
+		target.mFormat = slot.desc.format;
+		target.mPixels = (slot.surface != NO_SURFACE) ? mSurfaces[slot.surface].memory.data() : nullptr;
+	}
+	mCompiled = true;
+	return true;
+}
+
+RenderTarget* RenderTargetPool::target(RenderTargetId id) noexcept {
+	if (!mCompiled || id >= mSlots.size() || !mSlots[id].target.mPixels) {
+		return nullptr;
+	}
+	return &mSlots[id].target;
+}
+
+void RenderTargetPool::trim() {
+	for (uint32_t i = static_cast<uint32_t>(mSurfaces.size()); i-- > 0;) {
+		if (mSurfaces[i].busy.empty()) {
+			freeSurface(i);
+		}
+	}
+	mStats.allocatedBytes = mAllocatedBytes;
+}
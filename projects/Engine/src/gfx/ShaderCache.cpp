@@ -0,0 +1,285 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/ShaderCache.hh>
+#include <Engine/core/Jobs.hh>
+#include <Engine/io/MappedFile.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN		1
+#endif//WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif//_WIN32
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline uint64_t elapsedNs(Clock::time_point start) noexcept {
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+inline uint64_t fnv64(uint64_t h, const void* data, size_t size) noexcept {
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		h = (h ^ bytes[i]) * FNV_PRIME;
+	}
+	return h;
+}
+
+constexpr uint32_t CACHE_MAGIC = 0x48534444U;	// "DDSH"
+constexpr uint32_t CACHE_FORMAT = 1U;
+
+// Disk cache file header, the binary follows
+struct CacheHeader {
+	uint32_t	magic;
+	uint32_t	format;
+	uint64_t	hash;
+	uint32_t	key;
+	uint32_t	size;
+};
+
+// Rename over an existing file, which std::rename refuses on Windows
+inline bool replaceFile(const char* from, const char* to) noexcept {
+#if defined(_WIN32)
+	return ::MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	return std::rename(from, to) == 0;
+#endif//_WIN32
+}
+
+} // namespace
+
+//================================================================
+
+ShaderCache::Variant::~Variant() noexcept {}
+
+//================================================================
+
+ShaderCache::ShaderCache(ShaderCompileFn compile, std::string cacheDir, uint32_t compilerVersion)
+	: mCompile(std::move(compile))
+	, mCacheDir(std::move(cacheDir))
+	, mCompilerVersion(compilerVersion)
+	, mRequests(0)
+	, mMemoryHits(0)
+	, mDiskHits(0)
+	, mCompiles(0)
+	, mFailures(0)
+	, mDiskWrites(0)
+	, mCompileNs(0)
+	, mDiskNs(0) {
+}
+
+ShaderCache::~ShaderCache() noexcept {}
+
+//----------------------------------------------------------------
+
+uint32_t ShaderCache::addProgram(const char* name, std::string source) {
+	Program program;
+	program.name = name;
+	program.sourceHash = fnv64(FNV_OFFSET, source.data(), source.size());
+	program.source = std::move(source);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	mPrograms.push_back(std::move(program));
+	return static_cast<uint32_t>(mPrograms.size() - 1U);
+}
+
+uint32_t ShaderCache::findProgram(const char* name) const noexcept {
+	std::lock_guard<std::mutex> lock(mMutex);
+	for (size_t i = 0; i < mPrograms.size(); ++i) {
+		if (mPrograms[i].name == name) {
+			return static_cast<uint32_t>(i);
+		}
+	}
+	return INVALID_PROGRAM;
+}
+
+uint64_t ShaderCache::variantHash(uint64_t sourceHash, const std::string& defines, uint32_t compilerVersion) noexcept {
+	uint64_t h = fnv64(FNV_OFFSET, &sourceHash, sizeof(sourceHash));
+	h = fnv64(h, defines.data(), defines.size());
+	return fnv64(h, &compilerVersion, sizeof(compilerVersion));
+}
+
+std::string ShaderCache::cachePath(uint64_t hash) const {
+	char name[32];
+	std::snprintf(name, sizeof(name), "/%016" PRIx64 ".shd", hash);
+	return mCacheDir + name;
+}
+
+//----------------------------------------------------------------
+
+bool ShaderCache::build(const Program& program, Variant& variant) {
+	const std::string defines = shaderDefines(variant.mKey);
+	const uint64_t hash = variantHash(program.sourceHash, defines, mCompilerVersion);
+	const std::string path = mCacheDir.empty() ? std::string() : cachePath(hash);
+
+	// Disk cache first, a header mismatch is treated as a miss
+	if (!path.empty()) {
+		const auto start = Clock::now();
+		MappedFile file;
+		if (file.open(path.c_str(), false) && file.size() >= sizeof(CacheHeader)) {
+			CacheHeader header;
+			std::memcpy(&header, file.data(), sizeof(header));
+			if (header.magic == CACHE_MAGIC && header.format == CACHE_FORMAT && header.hash == hash
+				&& header.key == variant.mKey && header.size == file.size() - sizeof(header)) {
+				variant.mBinary.assign(file.data() + sizeof(header), file.data() + file.size());
+				mDiskHits.fetch_add(1, std::memory_order_relaxed);
+				mDiskNs.fetch_add(elapsedNs(start), std::memory_order_relaxed);
+				return true;
+			}
+		}
+		mDiskNs.fetch_add(elapsedNs(start), std::memory_order_relaxed);
+	}
+
+	const auto start = Clock::now();
+	const bool compiled = mCompile && mCompile(program.source, defines, variant.mBinary);
+	mCompileNs.fetch_add(elapsedNs(start), std::memory_order_relaxed);
+	if (!compiled) {
+		mFailures.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	mCompiles.fetch_add(1, std::memory_order_relaxed);
+
+	// Write beside the final name and rename, so readers never see half a file
+	if (!path.empty()) {
+		const std::string temp = path + ".tmp";
+		std::FILE* fp = std::fopen(temp.c_str(), "wb");
+		if (fp) {
+			const CacheHeader header = { CACHE_MAGIC, CACHE_FORMAT, hash, variant.mKey, static_cast<uint32_t>(variant.mBinary.size()) };
+			bool ok = std::fwrite(&header, sizeof(header), 1, fp) == 1;
+			ok = ok && std::fwrite(variant.mBinary.data(), 1, variant.mBinary.size(), fp) == variant.mBinary.size();
+			ok = (std::fclose(fp) == 0) && ok;
+			if (ok && replaceFile(temp.c_str(), path.c_str())) {
+				mDiskWrites.fetch_add(1, std::memory_order_relaxed);
+			} else {
+				std::remove(temp.c_str());
+			}
+		}
+	}
+	return true;
+}
+
+const IShader* ShaderCache::get(uint32_t program, ShaderKey key) {
+	mRequests.fetch_add(1, std::memory_order_relaxed);
+	std::unique_lock<std::mutex> lock(mMutex);
+	if (program >= mPrograms.size()) {
+		return nullptr;
+	}
+
+	const uint64_t id = (static_cast<uint64_t>(program) << 32) | key;
+	const auto it = mVariants.find(id);
+	if (it != mVariants.end()) {
+		Variant& variant = *it->second;
+		if (variant.mState == State::Building) {
+			mBuilt.wait(lock, [&variant] { return variant.mState != State::Building; });
+		} else {
+			mMemoryHits.fetch_add(1, std::memory_order_relaxed);
+		}
+		return (variant.mState == State::Ready) ? &variant : nullptr;
+	}
+
+	// Claim it, then build without holding the lock; programs never move once added
+	Variant& variant = *mVariants.emplace(id, std::make_unique<Variant>(key)).first->second;
+	const Program& source = mPrograms[program];
+	lock.unlock();
+
+	const bool ok = build(source, variant);
+
+	lock.lock();
+	variant.mState = ok ? State::Ready : State::Failed;
+	lock.unlock();
+	mBuilt.notify_all();
+	return ok ? &variant : nullptr;
+}
+
+//----------------------------------------------------------------
+
+bool ShaderCache::savePrewarmList(const char* path) const {
+	std::vector<uint64_t> ids;
+	std::vector<const Program*> programs;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		for (const auto& [id, variant] : mVariants) {
+			if (variant->mState == State::Ready) {
+				ids.push_back(id);
+			}
+		}
+		for (const Program& program : mPrograms) {
+			programs.push_back(&program);
+		}
+	}
+	std::sort(ids.begin(), ids.end());
+
+	std::FILE* fp = std::fopen(path, "w");
+	if (!fp) {
+		return false;
+	}
+	bool ok = true;
+	for (uint64_t id : ids) {
+		const Program& program = *programs[static_cast<uint32_t>(id >> 32)];
+		ok = ok && std::fprintf(fp, "%s %08" PRIx32 "\n", program.name.c_str(), static_cast<uint32_t>(id)) > 0;
+	}
+	return (std::fclose(fp) == 0) && ok;
+}
+
+size_t ShaderCache::prewarm(const char* path) {
+	MappedFile file;
+	if (!file.open(path, false)) {
+		return 0;
+	}
+
+	// "<program> <key hex>" per line, unknown programs are skipped
+	std::vector<std::pair<uint32_t, ShaderKey>> list;
+	const char* cursor = reinterpret_cast<const char*>(file.data());
+	const char* end = cursor + file.size();
+	while (cursor < end) {
+		const char* eol = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+		const std::string line(cursor, eol ? eol : end);
+		cursor = eol ? eol + 1 : end;
+
+		const size_t space = line.find(' ');
+		if (space == std::string::npos) {
+			continue;
+		}
+		const uint32_t program = findProgram(line.substr(0, space).c_str());
+		if (program != INVALID_PROGRAM) {
+			list.emplace_back(program, static_cast<ShaderKey>(std::strtoul(line.c_str() + space + 1, nullptr, 16)));
+		}
+	}
+
+	std::atomic<size_t> ready(0);
+	JobSystem::instance().parallelFor(list.size(), 1U, [this, &list, &ready](size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) {
+			if (get(list[i].first, list[i].second)) {
+				ready.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	});
+	return ready.load(std::memory_order_relaxed);
+}
+
+ShaderCacheStats ShaderCache::stats() const noexcept {
+	ShaderCacheStats stats;
+	stats.requests = mRequests.load(std::memory_order_relaxed);
+	stats.memoryHits = mMemoryHits.load(std::memory_order_relaxed);
+	stats.diskHits = mDiskHits.load(std::memory_order_relaxed);
+	stats.compiles = mCompiles.load(std::memory_order_relaxed);
+	stats.failures = mFailures.load(std::memory_order_relaxed);
+	stats.diskWrites = mDiskWrites.load(std::memory_order_relaxed);
+	stats.compileMs = static_cast<float>(mCompileNs.load(std::memory_order_relaxed)) * 1.0e-6f;
+	stats.diskMs = static_cast<float>(mDiskNs.load(std::memory_order_relaxed)) * 1.0e-6f;
+	return stats;
+}
@@ -0,0 +1,211 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/SpriteBatch.hh>
+#include <Engine/core/Jobs.hh>
+#include <Engine/math/simd.hh>
+
+#include <chrono>
+#include <cmath>
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline float elapsedMs(Clock::time_point start) noexcept {
+	return static_cast<float>(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+}
+
+constexpr uint32_t VERTS_PER_SPRITE = 6U;
+constexpr size_t EXPAND_GRAIN = 1024U;		// Sprites per job, a multiple of 4
+
+constexpr inline uint32_t spriteTexture(uint64_t key) noexcept { return static_cast<uint32_t>(key & 0xFFFFU); }
+
+} // namespace
+
+//================================================================
+
+SpriteBatch::Stream::~Stream() noexcept {}
+
+//================================================================
+
+SpriteBatch::SpriteBatch(uint32_t maxSprites, StreamVertexBuffer* stream)
+	: mOrder(maxSprites)
+	, mScratch(maxSprites)
+	, mTarget(stream)
+	, mSource(&mStream)
+	, mCapacity(maxSprites)
+	, mLastTexture(0)
+	, mStats{} {
+	mSprites.reserve(maxSprites);
+	if (!mTarget) {
+		mStream.mVertices.resize(static_cast<size_t>(maxSprites) * VERTS_PER_SPRITE);
+	}
+}
+
+SpriteBatch::~SpriteBatch() noexcept {}
+
+void SpriteBatch::begin() {
+	mSprites.clear();
+	mTextures.clear();
+	mBatches.clear();
+	mStream.mCount = 0;
+	mLastTexture = 0;
+	mStats = {};
+}
+
+uint16_t SpriteBatch::textureIndex(const ITexture* texture) {
+	// Sprites tend to arrive in runs from the same page
+	if (mLastTexture < mTextures.size() && mTextures[mLastTexture] == texture) {
+		return mLastTexture;
+	}
+	for (size_t i = 0; i < mTextures.size(); ++i) {
+		if (mTextures[i] == texture) {
+			mLastTexture = static_cast<uint16_t>(i);
+			return mLastTexture;
+		}
+	}
+	mLastTexture = static_cast<uint16_t>(mTextures.size());
+	mTextures.push_back(texture);
+	return mLastTexture;
+}
+
+bool SpriteBatch::add(const SpriteInstance& instance) {
+	const ISprite* sprite = instance.sprite;
+	if (mSprites.size() >= mCapacity || !sprite || !sprite->atlas()) {
+		++mStats.dropped;
+		return false;
+	}
+
+	const uint16_t texture = textureIndex(sprite->atlas()->pageOf(sprite->region()));
+	const uint32_t index = static_cast<uint32_t>(mSprites.size());
+	mOrder[index] = { (uint64_t(instance.layer) << 16) | texture, index, 0U };
+	mSprites.push_back(instance);
+	return true;
+}
+
+void SpriteBatch::build() {
+	const uint32_t count = static_cast<uint32_t>(mSprites.size());
+	mStats.sprites = count;
+
+	// Layer, then page; stable so runs keep submission order
+	auto start = Clock::now();
+	radixSort(mOrder.data(), mScratch.data(), count);
+
+	// Ring space for the frame when streaming, else our own buffer
+	uint32_t base = 0;
+	GfxVertex* out = nullptr;
+	if (mTarget && count) {
+		out = mTarget->allocate(count * VERTS_PER_SPRITE, base);
+		mSource = mTarget;
+	}
+	if (!out) {
+		if (mStream.mVertices.size() < static_cast<size_t>(mCapacity) * VERTS_PER_SPRITE) {
+			mStream.mVertices.resize(static_cast<size_t>(mCapacity) * VERTS_PER_SPRITE);
+		}
+		out = mStream.mVertices.data();
+		base = 0;
+		mSource = &mStream;
+	}
+
+	uint32_t runs = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		if (i == 0 || mOrder[i].key != mOrder[i - 1].key) {
+			++runs;
+		}
+		const uint32_t texture = spriteTexture(mOrder[i].key);
+		if (mBatches.empty() || mBatches.back().texture != mTextures[texture]) {
+			mBatches.push_back({ mTextures[texture], base + i * VERTS_PER_SPRITE, 0U });
+		}
+		mBatches.back().count += VERTS_PER_SPRITE;
+	}
+	mStats.sortMs = elapsedMs(start);
+
+	// Expand corners, four sprites per SIMD lane group
+	start = Clock::now();
+	const SpriteInstance* sprites = mSprites.data();
+	const SortPair* order = mOrder.data();
+
+	JobSystem::instance().parallelFor(count, EXPAND_GRAIN, [=](size_t begin, size_t end) {
+		for (size_t quad = begin; quad < end; quad += 4) {
+			const size_t lanes = (end - quad < 4) ? (end - quad) : 4;
+
+			alignas(16) float px[4], py[4], x0[4], x1[4], y0[4], y1[4], cs[4], sn[4];
+			const SpriteInstance* s[4];
+			for (size_t l = 0; l < 4; ++l) {
+				s[l] = &sprites[order[quad + ((l < lanes) ? l : 0)].value];
+				const SpriteInstance& inst = *s[l];
+				px[l] = inst.position.x;
+				py[l] = inst.position.y;
+				x0[l] = -inst.pivot.x * inst.size.x;
+				x1[l] = (1.0f - inst.pivot.x) * inst.size.x;
+				y0[l] = -inst.pivot.y * inst.size.y;
+				y1[l] = (1.0f - inst.pivot.y) * inst.size.y;
+				cs[l] = (inst.rotation != 0.0f) ? std::cos(inst.rotation) : 1.0f;
+				sn[l] = (inst.rotation != 0.0f) ? std::sin(inst.rotation) : 0.0f;
+			}
+
+			// Corner = position + R * local, local corners from the pivot
+			const SimdFloat4 c = simdLoad(cs);
+			const SimdFloat4 sv = simdLoad(sn);
+			const SimdFloat4 ox = simdLoad(px);
+			const SimdFloat4 oy = simdLoad(py);
+			const SimdFloat4 lx0 = simdLoad(x0), lx1 = simdLoad(x1);
+			const SimdFloat4 ly0 = simdLoad(y0), ly1 = simdLoad(y1);
+			const SimdFloat4 x0c = lx0 * c, x1c = lx1 * c, x0s = lx0 * sv, x1s = lx1 * sv;
+			const SimdFloat4 y0c = ly0 * c, y1c = ly1 * c, y0s = ly0 * sv, y1s = ly1 * sv;
+
+			alignas(16) float cx[4][4], cy[4][4];
+			simdStore(cx[0], ox + x0c - y0s);	simdStore(cy[0], oy + x0s + y0c);
+			simdStore(cx[1], ox + x1c - y0s);	simdStore(cy[1], oy + x1s + y0c);
+			simdStore(cx[2], ox + x1c - y1s);	simdStore(cy[2], oy + x1s + y1c);
+			simdStore(cx[3], ox + x0c - y1s);	simdStore(cy[3], oy + x0s + y1c);
+
+			for (size_t l = 0; l < lanes; ++l) {
+				const SpriteInstance& inst = *s[l];
+				const AtlasRect& r = inst.sprite->atlas()->rect(inst.sprite->region());
+				const float z = inst.depth;
+				const uint32_t color = inst.color;
+
+				const GfxVertex v0 = { { cx[0][l], cy[0][l], z }, color, { r.u0, r.v0 } };
+				const GfxVertex v1 = { { cx[1][l], cy[1][l], z }, color, { r.u1, r.v0 } };
+				const GfxVertex v2 = { { cx[2][l], cy[2][l], z }, color, { r.u1, r.v1 } };
+				const GfxVertex v3 = { { cx[3][l], cy[3][l], z }, color, { r.u0, r.v1 } };
+
+				GfxVertex* v = out + (quad + l) * VERTS_PER_SPRITE;
+				v[0] = v0;	v[1] = v1;	v[2] = v2;
+				v[3] = v0;	v[4] = v2;	v[5] = v3;
+			}
+		}
+	});
+
+	mStream.mCount = (mSource == &mStream) ? count * VERTS_PER_SPRITE : 0U;
+	mStats.batches = static_cast<uint32_t>(mBatches.size());
+	mStats.merged = runs - mStats.batches;
+	mStats.vertices = count * VERTS_PER_SPRITE;
+	mStats.expandMs = elapsedMs(start);
+}
+
+void SpriteBatch::submit(ICommandQueue& queue, uint8_t pass, RenderList list, const IMaterial* material, uint32_t materialKey) const {
+	const size_t count = mBatches.size();
+	const bool backToFront = (list == RenderList::Translucent);
+
+	for (size_t i = 0; i < count; ++i) {
+		const SpriteBatchRange& range = mBatches[i];
+		const float order = (static_cast<float>(i) + 0.5f) / static_cast<float>(count);
+		const float depth = backToFront ? (1.0f - order) : order;
+
+		DrawCommand cmd;
+		cmd.material = material;
+		cmd.texture = range.texture;
+		cmd.vertices = mSource;
+		cmd.transform = nullptr;
+		cmd.first = range.first;
+		cmd.count = range.count;
+		cmd.primitive = Primitive::Triangles;
+		// Batch index as the texture field too, so solid lists can't reorder batches either
+		queue.submit(SortKey::make(pass, list, depth, materialKey, static_cast<uint32_t>(i)), cmd);
+	}
+}
@@ -0,0 +1,174 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/StreamVertexBuffer.hh>
+#include <Engine/math/simd.hh>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t VERTEX_GRANULE = 4U;		// 4 vertices = 96 bytes, keeps every allocation 32 byte aligned
+
+} // namespace
+
+//================================================================
+
+StreamVertexBuffer::StreamVertexBuffer(uint32_t capacity, uint32_t framesInFlight)
+	: mData(nullptr)
+	, mCapacity(0)
+	, mFramesInFlight((framesInFlight < 1U) ? 1U : (framesInFlight > MAX_FRAMES_IN_FLIGHT) ? MAX_FRAMES_IN_FLIGHT : framesInFlight)
+	, mFrame(0)
+	, mFrameStart{}
+	, mHead(0)
+	, mRetired(0)
+	, mAllocations(0)
+	, mFailed(0)
+	, mStalls(0)
+	, mBytes(0)
+	, mPeak(0)
+	, mStallNs(0)
+	, mStats{} {
+	const uint32_t count = capacity & ~(VERTEX_GRANULE - 1U);
+	const size_t bytes = static_cast<size_t>(count) * sizeof(GfxVertex);
+	if (bytes) {
+#if defined(_MSC_VER)
+		mData = static_cast<GfxVertex*>(_aligned_malloc(bytes, ALIGNMENT));
+#else
+		mData = static_cast<GfxVertex*>(std::aligned_alloc(ALIGNMENT, bytes));
+#endif//_MSC_VER
+	}
+	mCapacity = mData ? count : 0;
+}
+
+StreamVertexBuffer::~StreamVertexBuffer() noexcept {
+#if defined(_MSC_VER)
+	_aligned_free(mData);
+#else
+	std::free(mData);
+#endif//_MSC_VER
+}
+
+//----------------------------------------------------------------
+
+void StreamVertexBuffer::beginFrame() {
+	mAllocations.store(0, std::memory_order_relaxed);
+	mFailed.store(0, std::memory_order_relaxed);
+	mStalls.store(0, std::memory_order_relaxed);
+	mBytes.store(0, std::memory_order_relaxed);
+	mStallNs.store(0, std::memory_order_relaxed);
+
+	// Reuse the oldest frame's slot once it is done with
+	++mFrame;
+	if (mFrame > mFramesInFlight) {
+		waitRetired(mFrame - mFramesInFlight);
+	}
+	mFrameStart[mFrame % mFramesInFlight] = mHead.load(std::memory_order_relaxed);
+}
+
+uint64_t StreamVertexBuffer::endFrame() noexcept {
+	mStats.allocations = mAllocations.load(std::memory_order_relaxed);
+	mStats.failed = mFailed.load(std::memory_order_relaxed);
+	mStats.bytesStreamed = mBytes.load(std::memory_order_relaxed);
+	mStats.wrapStalls = mStalls.load(std::memory_order_relaxed);
+	mStats.peakBytes = mPeak.load(std::memory_order_relaxed);
+	mStats.stallMs = static_cast<float>(mStallNs.load(std::memory_order_relaxed)) * 1.0e-6f;
+	return mFrame;
+}
+
+void StreamVertexBuffer::retire(uint64_t fence) noexcept {
+	uint64_t retired = mRetired.load(std::memory_order_relaxed);
+	while (fence > retired && !mRetired.compare_exchange_weak(retired, fence, std::memory_order_release, std::memory_order_relaxed)) {
+	}
+	mRetired.notify_all();
+}
+
+uint64_t StreamVertexBuffer::liveStart() const noexcept {
+	const uint64_t retired = mRetired.load(std::memory_order_acquire);
+	const uint64_t oldest = (retired < mFrame) ? retired + 1U : mFrame;
+	return mFrameStart[oldest % mFramesInFlight];
+}
+
+void StreamVertexBuffer::waitRetired(uint64_t fence) {
+	uint64_t retired = mRetired.load(std::memory_order_acquire);
+	if (retired >= fence) {
+		return;
+	}
+
+	const auto start = Clock::now();
+	mStalls.fetch_add(1, std::memory_order_relaxed);
+	while (retired < fence) {
+		mRetired.wait(retired, std::memory_order_acquire);
+		retired = mRetired.load(std::memory_order_acquire);
+	}
+	const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+	mStallNs.fetch_add(static_cast<uint64_t>(ns), std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------
+
+GfxVertex* StreamVertexBuffer::allocate(uint32_t count, uint32_t& first) {
+	const uint32_t rounded = (count + VERTEX_GRANULE - 1U) & ~(VERTEX_GRANULE - 1U);
+	if (!count || rounded > mCapacity) {
+		mFailed.fetch_add(count ? 1U : 0U, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	const uint64_t capacity = mCapacity;
+	uint64_t head = mHead.load(std::memory_order_relaxed);
+	for (;;) {
+		// Never straddle the end, skip to the start instead
+		const uint64_t pos = head % capacity;
+		const uint64_t start = (pos + rounded > capacity) ? head + (capacity - pos) : head;
+		const uint64_t end = start + rounded;
+		const uint64_t live = liveStart();
+
+		if (end - live > capacity) {
+			const uint64_t retired = mRetired.load(std::memory_order_acquire);
+			if (retired + 1U >= mFrame) {
+				// Only this frame is left in the ring and it still doesn't fit
+				mFailed.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+			waitRetired(retired + 1U);
+			head = mHead.load(std::memory_order_relaxed);
+			continue;
+		}
+
+		if (mHead.compare_exchange_weak(head, end, std::memory_order_relaxed)) {
+			const size_t used = static_cast<size_t>(end - live) * sizeof(GfxVertex);
+			size_t peak = mPeak.load(std::memory_order_relaxed);
+			while (used > peak && !mPeak.compare_exchange_weak(peak, used, std::memory_order_relaxed)) {
+			}
+			mAllocations.fetch_add(1, std::memory_order_relaxed);
+			mBytes.fetch_add(static_cast<size_t>(count) * sizeof(GfxVertex), std::memory_order_relaxed);
+
+			first = static_cast<uint32_t>(start % capacity);
+			return mData + first;
+		}
+	}
+}
+
+bool StreamVertexBuffer::write(const GfxVertex* src, uint32_t count, uint32_t& first) {
+	GfxVertex* dst = allocate(count, first);
+	if (!dst) {
+		return false;
+	}
+
+	// Sequential aligned stores, so write-combining sees whole 32 byte lines
+	const size_t bytes = static_cast<size_t>(count) * sizeof(GfxVertex);
+	const size_t blocks = bytes / 16U;
+	const float* s = reinterpret_cast<const float*>(src);
+	float* d = reinterpret_cast<float*>(dst);
+	for (size_t i = 0; i < blocks; ++i) {
+		simdStore(d + i * 4U, simdLoadU(s + i * 4U));
+	}
+	std::memcpy(d + blocks * 4U, s + blocks * 4U, bytes - blocks * 16U);
+	return true;
+}
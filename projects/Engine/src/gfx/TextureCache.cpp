@@ -0,0 +1,272 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/TextureCache.hh>
+
+#include <algorithm>
+#include <cstring>
+
+//================================================================
+
+TextureCache::View::~View() noexcept {}
+
+//================================================================
+
+TextureCache::TextureCache(const TextureCacheSettings& settings)
+	: mSettings(settings)
+	, mStats{}
+	, mFrame(0)
+	, mResidentBytes(0)
+	, mPeakResidentBytes(0)
+	, mResidentCount(0)
+	, mHead(INVALID)
+	, mTail(INVALID) {
+}
+
+TextureCache::~TextureCache() noexcept {}
+
+//----------------------------------------------------------------
+
+size_t TextureCache::levelBytes(const Entry& e, uint32_t level) const noexcept {
+	const size_t w = std::max(1U, e.source.width >> level);
+	const size_t h = std::max(1U, e.source.height >> level);
+	return w * h * pixelFormatBytes(e.source.format);
+}
+
+TextureId TextureCache::add(const TextureSource& source) {
+	const TextureId id = static_cast<TextureId>(mEntries.size());
+	Entry& e = mEntries.emplace_back();
+	e.source = source;
+	e.chainBytes = 0;
+	for (uint32_t level = 0; level < source.levels.size(); ++level) {
+		e.offsets.push_back(e.chainBytes);
+		e.chainBytes += levelBytes(e, level);
+	}
+	e.lastUsed = 0;
+	e.baseLevel = 0;
+	e.residentLevel = static_cast<uint32_t>(source.levels.size());
+	e.uploadLevel = e.residentLevel;
+	e.uploadOffset = 0;
+	e.prev = INVALID;
+	e.next = INVALID;
+	e.queued = false;
+	e.removed = false;
+	e.view.mFormat = source.format;
+	return id;
+}
+
+void TextureCache::remove(TextureId id) {
+	if (id >= mEntries.size() || mEntries[id].removed) {
+		return;
+	}
+	evict(id);
+	mEntries[id].removed = true;
+}
+
+//----------------------------------------------------------------
+
+void TextureCache::beginFrame() {
+	++mFrame;
+	mStats = {};
+}
+
+const ITexture* TextureCache::request(TextureId id) {
+	if (id >= mEntries.size() || mEntries[id].removed) {
+		return nullptr;
+	}
+
+	Entry& e = mEntries[id];
+	++mStats.requests;
+	e.lastUsed = mFrame;
+	if (!e.vram.empty()) {
+		touch(id);
+	}
+
+	if (e.residentLevel != 0) {
+		++mStats.misses;
+		if (!e.queued && e.residentLevel > e.baseLevel) {
+			e.queued = true;
+			mUploads.push_back(id);
+		}
+	}
+	return (e.residentLevel < e.source.levels.size()) ? &e.view : nullptr;
+}
+
+void TextureCache::endFrame() {
+	size_t budget = mSettings.uploadBytesPerFrame;
+
+	// Fallback mips first, so everything requested shows something soon
+	for (TextureId id : mUploads) {
+		if (!budget) {
+			break;
+		}
+		if (mEntries[id].queued && !upload(id, fallbackLevel(mEntries[id]), budget)) {
+			++mStats.budgetDeferred;
+		}
+	}
+
+	// Then whole chains in request order, one that can't get space waits in place
+	for (auto it = mUploads.begin(); budget && it != mUploads.end();) {
+		const TextureId id = *it;
+		Entry& e = mEntries[id];
+		if (e.queued) {
+			if (!upload(id, 0, budget)) {
+				++mStats.budgetDeferred;
+				++it;
+				continue;
+			}
+			if (e.residentLevel > e.baseLevel) {
+				continue;
+			}
+			e.queued = false;
+		}
+
+		// Done, or evicted / removed while waiting
+		it = mUploads.erase(it);
+	}
+
+	mStats.residentBytes = mResidentBytes;
+	mStats.residentTextures = mResidentCount;
+}
+
+bool TextureCache::isResident(TextureId id) const noexcept {
+	return id < mEntries.size() && mEntries[id].residentLevel == 0 && !mEntries[id].source.levels.empty();
+}
+
+//----------------------------------------------------------------
+
+uint32_t TextureCache::fallbackLevel(const Entry& e) const noexcept {
+	const uint32_t levels = static_cast<uint32_t>(e.source.levels.size());
+	for (uint32_t level = 0; level < levels; ++level) {
+		if (levelBytes(e, level) <= mSettings.fallbackBytes) {
+			return level;
+		}
+	}
+	return levels ? levels - 1U : 0U;
+}
+
+bool TextureCache::upload(TextureId id, uint32_t target, size_t& budget) {
+	Entry& e = mEntries[id];
+	if (e.vram.empty() && !reserve(id)) {
+		return false;
+	}
+
+	// Coarsest level first, a piece at a time
+	target = std::max(target, e.baseLevel);
+	while (budget && e.residentLevel > target) {
+		const size_t bytes = levelBytes(e, e.uploadLevel);
+		const size_t piece = std::min(budget, bytes - e.uploadOffset);
+		std::memcpy(e.vram.data() + e.offsets[e.uploadLevel] - e.offsets[e.baseLevel] + e.uploadOffset,
+			static_cast<const uint8_t*>(e.source.levels[e.uploadLevel]) + e.uploadOffset, piece);
+		e.uploadOffset += piece;
+		budget -= piece;
+		mStats.uploadBytes += piece;
+
+		if (e.uploadOffset == bytes) {
+			e.residentLevel = e.uploadLevel;
+			e.uploadOffset = 0;
+			++mStats.levelsCompleted;
+			updateView(e);
+			if (e.uploadLevel > e.baseLevel) {
+				--e.uploadLevel;
+			}
+		}
+	}
+	return true;
+}
+
+void TextureCache::updateView(Entry& e) noexcept {
+	const uint32_t level = e.residentLevel;
+	if (level >= e.source.levels.size()) {
+		e.view.mPixels = nullptr;
+		e.view.mWidth = 0;
+		e.view.mHeight = 0;
+		return;
+	}
+	e.view.mPixels = e.vram.data() + e.offsets[level] - e.offsets[e.baseLevel];
+	e.view.mWidth = std::max(1U, e.source.width >> level);
+	e.view.mHeight = std::max(1U, e.source.height >> level);
+}
+
+void TextureCache::touch(TextureId id) noexcept {
+	if (mHead == id) {
+		return;
+	}
+	unlink(id);
+	Entry& e = mEntries[id];
+	e.prev = INVALID;
+	e.next = mHead;
+	if (mHead != INVALID) {
+		mEntries[mHead].prev = id;
+	}
+	mHead = id;
+	if (mTail == INVALID) {
+		mTail = id;
+	}
+}
+
+void TextureCache::unlink(TextureId id) noexcept {
+	Entry& e = mEntries[id];
+	if (e.prev != INVALID) {
+		mEntries[e.prev].next = e.next;
+	} else if (mHead == id) {
+		mHead = e.next;
+	}
+	if (e.next != INVALID) {
+		mEntries[e.next].prev = e.prev;
+	} else if (mTail == id) {
+		mTail = e.prev;
+	}
+	e.prev = INVALID;
+	e.next = INVALID;
+}
+
+void TextureCache::evict(TextureId id) noexcept {
+	Entry& e = mEntries[id];
+	if (!e.vram.empty()) {
+		unlink(id);
+		mResidentBytes -= e.vram.size();
+		--mResidentCount;
+		++mStats.evictions;
+		mStats.evictedBytes += e.vram.size();
+		std::vector<uint8_t>().swap(e.vram);
+	}
+	e.residentLevel = static_cast<uint32_t>(e.source.levels.size());
+	e.uploadLevel = e.residentLevel;
+	e.uploadOffset = 0;
+	e.queued = false;
+	updateView(e);
+}
+
+bool TextureCache::reserve(TextureId id) {
+	Entry& e = mEntries[id];
+	const uint32_t levels = static_cast<uint32_t>(e.source.levels.size());
+
+	// Drop the finest levels of a chain that could never fit
+	e.baseLevel = 0;
+	while (e.baseLevel < levels && e.chainBytes - e.offsets[e.baseLevel] > mSettings.vramBudget) {
+		++e.baseLevel;
+	}
+	if (e.baseLevel == levels) {
+		e.baseLevel = 0;
+		return false;
+	}
+	const size_t bytes = e.chainBytes - e.offsets[e.baseLevel];
+
+	// Least recently used first, stopping at anything this frame needs
+	while (mResidentBytes + bytes > mSettings.vramBudget) {
+		if (mTail == INVALID || mEntries[mTail].lastUsed >= mFrame) {
+			return false;
+		}
+		evict(mTail);
+	}
+
+	e.vram.resize(bytes);
+	e.uploadLevel = levels - 1U;
+	e.uploadOffset = 0;
+	mResidentBytes += bytes;
+	mPeakResidentBytes = std::max(mPeakResidentBytes, mResidentBytes);
+	++mResidentCount;
+	touch(id);
+	return true;
+}
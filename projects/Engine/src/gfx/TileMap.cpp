@@ -0,0 +1,362 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/TileMap.hh>
+#include <Engine/core/Jobs.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline float elapsedMs(Clock::time_point start) noexcept {
+	return static_cast<float>(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+}
+
+constexpr uint32_t VERTS_PER_TILE = 6U;
+
+// Two triangles, corners clockwise from the top-left
+inline void writeUvs(GfxVertex* v, const AtlasRect& r) noexcept {
+	v[0].uv = { r.u0, r.v0 };
+	v[1].uv = { r.u1, r.v0 };
+	v[2].uv = { r.u1, r.v1 };
+	v[3].uv = { r.u0, r.v0 };
+	v[4].uv = { r.u1, r.v1 };
+	v[5].uv = { r.u0, r.v1 };
+}
+
+// Tile index covering world coordinate `w`, may be out of range
+inline int64_t tileAt(float w, float origin, float size) noexcept {
+	return static_cast<int64_t>(std::floor((w - origin) / size));
+}
+
+} // namespace
+
+//================================================================
+
+TileMap::Buffer::~Buffer() noexcept {}
+
+//================================================================
+
+TileMap::TileMap(const ITileset* tileset, uint32_t width, uint32_t height, const TileMapSettings& settings)
+	: mTileset(tileset)
+	, mSettings(settings)
+	, mWidth(width)
+	, mHeight(height)
+	, mChunksX((width + settings.chunkSize - 1U) / settings.chunkSize)
+	, mChunksY((height + settings.chunkSize - 1U) / settings.chunkSize)
+	, mTiles(static_cast<size_t>(width) * height, EMPTY)
+	, mChunks(static_cast<size_t>(mChunksX) * mChunksY)
+	, mTileAnimation(tileset ? tileset->tileCount() : 0U, EMPTY)
+	, mTime(0.0f)
+	, mFrame(0)
+	, mStats{} {
+}
+
+TileMap::~TileMap() noexcept {}
+
+//----------------------------------------------------------------
+
+uint16_t TileMap::tile(uint32_t x, uint32_t y) const noexcept {
+	return (x < mWidth && y < mHeight) ? mTiles[static_cast<size_t>(y) * mWidth + x] : EMPTY;
+}
+
+void TileMap::setTile(uint32_t x, uint32_t y, uint16_t tile) noexcept {
+	if (x >= mWidth || y >= mHeight) {
+		return;
+	}
+	uint16_t& slot = mTiles[static_cast<size_t>(y) * mWidth + x];
+	if (slot != tile) {
+		slot = tile;
+		mChunks[(y / mSettings.chunkSize) * mChunksX + x / mSettings.chunkSize].mDirty = true;
+	}
+}
+
+void TileMap::setTiles(const uint16_t* tiles) {
+	std::copy(tiles, tiles + mTiles.size(), mTiles.begin());
+	for (uint32_t chunk : mResident) {
+		mChunks[chunk].mDirty = true;
+	}
+}
+
+bool TileMap::addAnimation(const uint16_t* frames, uint32_t count, float frameSeconds) {
+	const TextureAtlas* atlas = mTileset ? mTileset->atlas() : nullptr;
+	if (!atlas || !count || frames[0] >= mTileAnimation.size() || mTileAnimation[frames[0]] != EMPTY || mAnimations.size() >= EMPTY) {
+		return false;
+	}
+
+	Animation animation;
+	animation.frameSeconds = (frameSeconds > 0.0f) ? frameSeconds : 1.0f;
+	const uint16_t page = atlas->rect(frames[0]).page;
+	for (uint32_t i = 0; i < count; ++i) {
+		if (frames[i] < mTileAnimation.size() && atlas->rect(frames[i]).page == page) {
+			animation.frames.push_back(atlas->rect(frames[i]));
+		}
+	}
+
+	mTileAnimation[frames[0]] = static_cast<uint16_t>(mAnimations.size());
+	mAnimations.push_back(std::move(animation));
+
+	// Baked chunks don't know which of their tiles animate yet
+	for (uint32_t chunk : mResident) {
+		mChunks[chunk].mDirty = true;
+	}
+	return true;
+}
+
+//----------------------------------------------------------------
+
+TileMap::Buffer& TileMap::writable(Chunk& chunk, bool keep) {
+	if (chunk.mBuffer && !inFlight(*chunk.mBuffer)) {
+		return *chunk.mBuffer;
+	}
+
+	std::unique_ptr<Buffer> buffer;
+	if (mSpare.empty()) {
+		buffer = std::make_unique<Buffer>();
+	} else {
+		buffer = std::move(mSpare.back());
+		mSpare.pop_back();
+		buffer->mLastDrawn = 0;
+	}
+	if (chunk.mBuffer) {
+		if (keep) {
+			buffer->mVertices.assign(chunk.mBuffer->mVertices.begin(), chunk.mBuffer->mVertices.end());
+		}
+		retire(std::move(chunk.mBuffer));
+		++mStats.buffersRetired;
+	}
+	chunk.mBuffer = std::move(buffer);
+	return *chunk.mBuffer;
+}
+
+void TileMap::retire(std::unique_ptr<Buffer> buffer) {
+	if (buffer) {
+		mRetired.push_back(std::move(buffer));
+	}
+}
+
+//----------------------------------------------------------------
+
+void TileMap::bake(uint32_t index) {
+	Chunk& chunk = mChunks[index];
+	const TextureAtlas* atlas = mTileset->atlas();
+	const uint32_t tileCount = static_cast<uint32_t>(mTileAnimation.size());
+
+	const uint32_t size = mSettings.chunkSize;
+	const uint32_t x0 = (index % mChunksX) * size;
+	const uint32_t y0 = (index / mChunksX) * size;
+	const uint32_t x1 = std::min(x0 + size, mWidth);
+	const uint32_t y1 = std::min(y0 + size, mHeight);
+
+	// Count per page, then lay pages out back to back
+	std::vector<uint32_t> cursor(atlas->pageCount(), 0U);
+	for (uint32_t y = y0; y < y1; ++y) {
+		const uint16_t* row = mTiles.data() + static_cast<size_t>(y) * mWidth;
+		for (uint32_t x = x0; x < x1; ++x) {
+			if (row[x] < tileCount) {
+				cursor[atlas->rect(row[x]).page] += VERTS_PER_TILE;
+			}
+		}
+	}
+
+	chunk.mRanges.clear();
+	uint32_t total = 0;
+	for (size_t page = 0; page < cursor.size(); ++page) {
+		const uint32_t count = cursor[page];
+		if (count) {
+			chunk.mRanges.push_back({ static_cast<uint16_t>(page), total, count });
+		}
+		cursor[page] = total;
+		total += count;
+	}
+
+	std::vector<GfxVertex>& vertices = chunk.mBuffer->mVertices;
+	vertices.resize(total);
+	chunk.mAnimated.clear();
+
+	const float tw = mSettings.tileSize.x;
+	const float th = mSettings.tileSize.y;
+	const float z = mSettings.depth;
+	for (uint32_t y = y0; y < y1; ++y) {
+		const uint16_t* row = mTiles.data() + static_cast<size_t>(y) * mWidth;
+		const float top = mSettings.origin.y + static_cast<float>(y) * th;
+		for (uint32_t x = x0; x < x1; ++x) {
+			const uint16_t t = row[x];
+			if (t >= tileCount) {
+				continue;
+			}
+
+			const AtlasRect& rect = atlas->rect(t);
+			const uint32_t first = cursor[rect.page];
+			cursor[rect.page] += VERTS_PER_TILE;
+
+			const float left = mSettings.origin.x + static_cast<float>(x) * tw;
+			GfxVertex* v = vertices.data() + first;
+			v[0].position = { left, top, z };
+			v[1].position = { left + tw, top, z };
+			v[2].position = { left + tw, top + th, z };
+			v[3].position = v[0].position;
+			v[4].position = v[2].position;
+			v[5].position = { left, top + th, z };
+			for (uint32_t i = 0; i < VERTS_PER_TILE; ++i) {
+				v[i].color = 0xFFFFFFFFU;
+			}
+			writeUvs(v, rect);
+
+			if (mTileAnimation[t] != EMPTY) {
+				chunk.mAnimated.push_back({ first, mTileAnimation[t], EMPTY });
+			}
+		}
+	}
+
+	chunk.mBaked = true;
+	chunk.mDirty = false;
+}
+
+void TileMap::release(uint32_t index) {
+	Chunk& chunk = mChunks[index];
+	retire(std::move(chunk.mBuffer));
+	std::vector<Range>().swap(chunk.mRanges);
+	std::vector<AnimatedTile>().swap(chunk.mAnimated);
+	chunk.mBaked = false;
+	chunk.mDirty = false;
+}
+
+void TileMap::animate(Chunk& chunk) {
+	GfxVertex* vertices = nullptr;
+	for (AnimatedTile& tile : chunk.mAnimated) {
+		const Animation& animation = mAnimations[tile.animation];
+		if (animation.frames.empty()) {
+			continue;
+		}
+		const uint16_t frame = static_cast<uint16_t>(static_cast<uint64_t>(mTime / animation.frameSeconds) % animation.frames.size());
+		if (frame != tile.frame) {
+			if (!vertices) {
+				vertices = writable(chunk, true).mVertices.data();
+			}
+			writeUvs(vertices + tile.vertex, animation.frames[frame]);
+			tile.frame = frame;
+			++mStats.animatedPatched;
+		}
+	}
+}
+
+//----------------------------------------------------------------
+
+void TileMap::draw(ICommandQueue& queue, const Float2& viewMin, const Float2& viewMax, uint8_t pass, RenderList list, const IMaterial* material, uint32_t materialKey) {
+	mStats = {};
+	++mFrame;
+
+	// Buffers no frame in flight can read any more, about a frame's worth kept for reuse
+	const size_t keep = std::max<size_t>(mVisible.size(), 1U);
+	for (size_t i = 0; i < mRetired.size();) {
+		if (inFlight(*mRetired[i])) {
+			++i;
+			continue;
+		}
+		if (mSpare.size() < keep) {
+			mSpare.push_back(std::move(mRetired[i]));
+		}
+		mRetired[i] = std::move(mRetired.back());
+		mRetired.pop_back();
+	}
+	if (mSpare.size() > keep) {
+		mSpare.resize(keep);
+	}
+
+	const TextureAtlas* atlas = mTileset ? mTileset->atlas() : nullptr;
+	if (!atlas || !mWidth || !mHeight) {
+		return;
+	}
+
+	// Chunks under the view rectangle
+	auto start = Clock::now();
+	const int64_t tx0 = std::max<int64_t>(tileAt(viewMin.x, mSettings.origin.x, mSettings.tileSize.x), 0);
+	const int64_t ty0 = std::max<int64_t>(tileAt(viewMin.y, mSettings.origin.y, mSettings.tileSize.y), 0);
+	const int64_t tx1 = std::min<int64_t>(tileAt(viewMax.x, mSettings.origin.x, mSettings.tileSize.x), mWidth - 1);
+	const int64_t ty1 = std::min<int64_t>(tileAt(viewMax.y, mSettings.origin.y, mSettings.tileSize.y), mHeight - 1);
+
+	mVisible.clear();
+	mToBake.clear();
+	if (tx0 <= tx1 && ty0 <= ty1) {
+		const uint32_t size = mSettings.chunkSize;
+		for (uint32_t cy = static_cast<uint32_t>(ty0) / size; cy <= static_cast<uint32_t>(ty1) / size; ++cy) {
+			for (uint32_t cx = static_cast<uint32_t>(tx0) / size; cx <= static_cast<uint32_t>(tx1) / size; ++cx) {
+				const uint32_t index = cy * mChunksX + cx;
+				Chunk& chunk = mChunks[index];
+				chunk.mLastVisible = mFrame;
+				mVisible.push_back(index);
+				if (!chunk.mBaked) {
+					mResident.push_back(index);
+					mToBake.push_back(index);
+				} else if (chunk.mDirty) {
+					mToBake.push_back(index);
+				}
+			}
+		}
+	}
+
+	// Chunks bake independently, each into a buffer no frame in flight reads
+	for (uint32_t index : mToBake) {
+		writable(mChunks[index], false);
+	}
+	const uint32_t* toBake = mToBake.data();
+	JobSystem::instance().parallelFor(mToBake.size(), 1U, [this, toBake](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			bake(toBake[i]);
+		}
+	});
+
+	// Over the limit, drop whatever has been out of view the longest
+	while (mResident.size() > mSettings.maxResidentChunks) {
+		size_t oldest = mResident.size();
+		for (size_t i = 0; i < mResident.size(); ++i) {
+			const uint64_t seen = mChunks[mResident[i]].mLastVisible;
+			if (seen < mFrame && (oldest == mResident.size() || seen < mChunks[mResident[oldest]].mLastVisible)) {
+				oldest = i;
+			}
+		}
+		if (oldest == mResident.size()) {
+			break;
+		}
+		release(mResident[oldest]);
+		mResident[oldest] = mResident.back();
+		mResident.pop_back();
+		++mStats.chunksEvicted;
+	}
+
+	mStats.visibleChunks = static_cast<uint32_t>(mVisible.size());
+	mStats.chunksBaked = static_cast<uint32_t>(mToBake.size());
+	mStats.residentChunks = static_cast<uint32_t>(mResident.size());
+	mStats.bakeMs = elapsedMs(start);
+
+	// One draw per page per chunk; chunks don't overlap, so only state goes in the key
+	start = Clock::now();
+	for (uint32_t index : mVisible) {
+		Chunk& chunk = mChunks[index];
+		animate(chunk);
+		chunk.mBuffer->mLastDrawn = mFrame;
+
+		for (const Range& range : chunk.mRanges) {
+			DrawCommand cmd;
+			cmd.material = material;
+			cmd.texture = atlas->page(range.page);
+			cmd.vertices = chunk.mBuffer.get();
+			cmd.transform = nullptr;
+			cmd.first = range.first;
+			cmd.count = range.count;
+			cmd.primitive = Primitive::Triangles;
+			if (queue.submit(SortKey::make(pass, list, 0.0f, materialKey, range.page), cmd)) {
+				++mStats.draws;
+				mStats.vertices += range.count;
+			}
+		}
+	}
+	mStats.submitMs = elapsedMs(start);
+}
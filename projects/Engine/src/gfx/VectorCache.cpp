@@ -0,0 +1,719 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/VectorCache.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline float elapsedMs(Clock::time_point start) noexcept {
+	return static_cast<float>(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+}
+
+constexpr float PI = 3.14159265358979f;
+constexpr uint32_t NONE = 0xFFFFFFFFU;
+constexpr uint32_t MAX_ARC_SEGMENTS = 64U;
+
+inline uint64_t fnv1a(uint64_t h, const void* data, size_t size) noexcept {
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		h = (h ^ bytes[i]) * 1099511628211ULL;
+	}
+	return h;
+}
+
+inline Float2 operator+(const Float2& a, const Float2& b) noexcept { return { a.x + b.x, a.y + b.y }; }
+inline Float2 operator-(const Float2& a, const Float2& b) noexcept { return { a.x - b.x, a.y - b.y }; }
+inline Float2 operator*(const Float2& a, float s) noexcept { return { a.x * s, a.y * s }; }
+inline float cross(const Float2& a, const Float2& b) noexcept { return a.x * b.y - a.y * b.x; }
+inline float dot(const Float2& a, const Float2& b) noexcept { return a.x * b.x + a.y * b.y; }
+
+inline Float2 direction(const Float2& from, const Float2& to) noexcept {
+	const Float2 d = to - from;
+	const float len = std::sqrt(dot(d, d));
+	return (len > 0.0f) ? d * (1.0f / len) : Float2{ 1.0f, 0.0f };
+}
+
+// Left of `d`, counter-clockwise with y up
+inline Float2 normal(const Float2& d) noexcept {
+	return { -d.y, d.x };
+}
+
+// Arc segments of `radius` keeping the chord within `tolerance`
+inline uint32_t arcSegments(float angle, float radius, float tolerance) noexcept {
+	const float step = 2.0f * std::acos(std::clamp(1.0f - tolerance / std::max(radius, 1e-4f), -1.0f, 1.0f));
+	const float n = std::ceil(angle / std::max(step, 1e-3f));
+	return std::clamp(static_cast<uint32_t>(n), 1U, MAX_ARC_SEGMENTS);
+}
+
+inline float signedArea(const Float2* p, uint32_t count) noexcept {
+	float area = 0.0f;
+	for (uint32_t i = 0, j = count - 1U; i < count; j = i++) {
+		area += cross(p[j], p[i]);
+	}
+	return area * 0.5f;
+}
+
+bool isConvex(const Float2* p, uint32_t count) noexcept {
+	float sign = 0.0f;
+	for (uint32_t i = 0; i < count; ++i) {
+		const Float2& a = p[i];
+		const Float2& b = p[(i + 1U) % count];
+		const Float2& c = p[(i + 2U) % count];
+		const float turn = cross(b - a, c - b);
+		if (turn * sign < 0.0f) {
+			return false;
+		}
+		if (turn != 0.0f) {
+			sign = turn;
+		}
+	}
+	return true;
+}
+
+bool pointInPolygon(const Float2* p, uint32_t count, const Float2& q) noexcept {
+	bool inside = false;
+	for (uint32_t i = 0, j = count - 1U; i < count; j = i++) {
+		if ((p[i].y > q.y) != (p[j].y > q.y) && q.x < (p[j].x - p[i].x) * (q.y - p[i].y) / (p[j].y - p[i].y) + p[i].x) {
+			inside = !inside;
+		}
+	}
+	return inside;
+}
+
+// Triangles in one colour
+struct Emitter {
+	std::vector<GfxVertex>&	out;
+	uint32_t				color;
+
+	inline void triangle(const Float2& a, const Float2& b, const Float2& c) {
+		out.push_back({ { a.x, a.y, 0.0f }, color, { 0.0f, 0.0f } });
+		out.push_back({ { b.x, b.y, 0.0f }, color, { 0.0f, 0.0f } });
+		out.push_back({ { c.x, c.y, 0.0f }, color, { 0.0f, 0.0f } });
+	}
+
+	// Fan around `center` from `from`, `angle` radians (negative = clockwise)
+	void arc(const Float2& center, const Float2& from, float angle, float radius, float tolerance) {
+		const uint32_t n = arcSegments(std::fabs(angle), radius, tolerance);
+		const float step = angle / static_cast<float>(n);
+		const float c = std::cos(step);
+		const float s = std::sin(step);
+		Float2 offset = from - center;
+		for (uint32_t i = 0; i < n; ++i) {
+			const Float2 next = { offset.x * c - offset.y * s, offset.x * s + offset.y * c };
+			triangle(center, center + offset, center + next);
+			offset = next;
+		}
+	}
+};
+
+//----------------------------------------------------------------
+// Ear clipping with hole bridging, after Mapbox's earcut
+//----------------------------------------------------------------
+
+class EarClipper {
+public:
+	EarClipper(const Float2* points, std::vector<uint32_t>& triangles)
+		: mPoints(points)
+		, mTriangles(triangles) {}
+
+	// `outer` and `holes` index `points`; any winding
+	void run(const VectorContour& outer, const std::vector<const VectorContour*>& holes) {
+		uint32_t total = outer.count;
+		for (const VectorContour* hole : holes) {
+			total += hole->count + 2U;
+		}
+		mNodes.clear();
+		mNodes.reserve(total);
+
+		uint32_t start = ring(outer, true);
+		if (start == NONE || next(start) == prev(start)) {
+			return;
+		}
+		if (!holes.empty()) {
+			start = eliminateHoles(start, holes);
+		}
+		clip(start, 0);
+	}
+
+private:
+	struct Node {
+		uint32_t	i;			// Point index
+		uint32_t	prev;
+		uint32_t	next;
+		float		x;
+		float		y;
+	};
+
+	inline uint32_t prev(uint32_t n) const noexcept { return mNodes[n].prev; }
+	inline uint32_t next(uint32_t n) const noexcept { return mNodes[n].next; }
+
+	// Twice the signed area of p, q, r; negative when counter-clockwise in earcut's sense
+	inline float area(uint32_t p, uint32_t q, uint32_t r) const noexcept {
+		const Node& a = mNodes[p];
+		const Node& b = mNodes[q];
+		const Node& c = mNodes[r];
+		return (b.y - a.y) * (c.x - b.x) - (b.x - a.x) * (c.y - b.y);
+	}
+
+	inline bool equals(uint32_t p, uint32_t q) const noexcept {
+		return mNodes[p].x == mNodes[q].x && mNodes[p].y == mNodes[q].y;
+	}
+
+	static inline bool pointInTriangle(float ax, float ay, float bx, float by, float cx, float cy, float px, float py) noexcept {
+		return (cx - px) * (ay - py) >= (ax - px) * (cy - py)
+			&& (ax - px) * (by - py) >= (bx - px) * (ay - py)
+			&& (bx - px) * (cy - py) >= (cx - px) * (by - py);
+	}
+
+	uint32_t insert(uint32_t i, uint32_t last) {
+		const uint32_t n = static_cast<uint32_t>(mNodes.size());
+		mNodes.push_back({ i, n, n, mPoints[i].x, mPoints[i].y });
+		if (last != NONE) {
+			mNodes[n].next = mNodes[last].next;
+			mNodes[n].prev = last;
+			mNodes[mNodes[last].next].prev = n;
+			mNodes[last].next = n;
+		}
+		return n;
+	}
+
+	void remove(uint32_t n) noexcept {
+		mNodes[mNodes[n].next].prev = mNodes[n].prev;
+		mNodes[mNodes[n].prev].next = mNodes[n].next;
+	}
+
+	// Circular list for a contour, outer rings one way round and holes the other
+	uint32_t ring(const VectorContour& contour, bool outer) {
+		float sum = 0.0f;
+		for (uint32_t k = 0, j = contour.count - 1U; k < contour.count; j = k++) {
+			const Float2& a = mPoints[contour.first + k];
+			const Float2& b = mPoints[contour.first + j];
+			sum += (b.x - a.x) * (a.y + b.y);
+		}
+		uint32_t last = NONE;
+		if (outer == (sum > 0.0f)) {
+			for (uint32_t k = 0; k < contour.count; ++k) {
+				last = insert(contour.first + k, last);
+			}
+		} else {
+			for (uint32_t k = contour.count; k-- > 0;) {
+				last = insert(contour.first + k, last);
+			}
+		}
+		if (last != NONE && equals(last, next(last))) {
+			const uint32_t n = next(last);
+			remove(last);
+			last = n;
+		}
+		return last;
+	}
+
+	// Drop repeated and collinear points between `start` and `end`
+	uint32_t filter(uint32_t start, uint32_t end = NONE) noexcept {
+		if (end == NONE) {
+			end = start;
+		}
+		uint32_t p = start;
+		bool again;
+		do {
+			again = false;
+			if (equals(p, next(p)) || area(prev(p), p, next(p)) == 0.0f) {
+				remove(p);
+				p = end = prev(p);
+				if (p == next(p)) {
+					break;
+				}
+				again = true;
+			} else {
+				p = next(p);
+			}
+		} while (again || p != end);
+		return end;
+	}
+
+	bool isEar(uint32_t ear) const noexcept {
+		const uint32_t a = prev(ear);
+		const uint32_t c = next(ear);
+		if (area(a, ear, c) >= 0.0f) {
+			return false;
+		}
+		const Node& na = mNodes[a];
+		const Node& nb = mNodes[ear];
+		const Node& nc = mNodes[c];
+		for (uint32_t p = next(c); p != a; p = next(p)) {
+			const Node& np = mNodes[p];
+			if (pointInTriangle(na.x, na.y, nb.x, nb.y, nc.x, nc.y, np.x, np.y) && area(prev(p), p, next(p)) >= 0.0f) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void clip(uint32_t ear, uint32_t pass) {
+		uint32_t stop = ear;
+		while (prev(ear) != next(ear)) {
+			const uint32_t a = prev(ear);
+			const uint32_t c = next(ear);
+			if (isEar(ear)) {
+				mTriangles.push_back(mNodes[a].i);
+				mTriangles.push_back(mNodes[ear].i);
+				mTriangles.push_back(mNodes[c].i);
+				remove(ear);
+				ear = next(c);
+				stop = ear;
+				continue;
+			}
+			ear = c;
+			if (ear == stop) {
+				if (pass == 0) {
+					// Try again without degenerate points
+					clip(filter(ear), 1);
+				} else {
+					// Self-touching or bad input: clip what is left as it comes rather than leave holes
+					forceClip(ear);
+				}
+				return;
+			}
+		}
+	}
+
+	void forceClip(uint32_t ear) {
+		while (prev(ear) != next(ear)) {
+			const uint32_t a = prev(ear);
+			const uint32_t c = next(ear);
+			if (area(a, ear, c) < 0.0f) {
+				mTriangles.push_back(mNodes[a].i);
+				mTriangles.push_back(mNodes[ear].i);
+				mTriangles.push_back(mNodes[c].i);
+			}
+			remove(ear);
+			ear = c;
+		}
+	}
+
+	bool locallyInside(uint32_t a, uint32_t b) const noexcept {
+		return (area(prev(a), a, next(a)) < 0.0f)
+			? area(a, b, next(a)) >= 0.0f && area(a, prev(a), b) >= 0.0f
+			: area(a, b, prev(a)) < 0.0f || area(a, next(a), b) < 0.0f;
+	}
+
+	bool sectorContainsSector(uint32_t m, uint32_t p) const noexcept {
+		return area(prev(m), m, prev(p)) < 0.0f && area(next(p), m, next(m)) < 0.0f;
+	}
+
+	// Outer ring vertex a straight cut from hole vertex `hole` can reach
+	uint32_t findBridge(uint32_t hole, uint32_t outer) const noexcept {
+		const float hx = mNodes[hole].x;
+		const float hy = mNodes[hole].y;
+		float qx = -INFINITY;
+		uint32_t m = NONE;
+
+		// Nearest edge left of the hole point on a horizontal ray
+		uint32_t p = outer;
+		do {
+			const Node& a = mNodes[p];
+			const Node& b = mNodes[next(p)];
+			if (hy <= a.y && hy >= b.y && b.y != a.y) {
+				const float x = a.x + (hy - a.y) * (b.x - a.x) / (b.y - a.y);
+				if (x <= hx && x > qx) {
+					qx = x;
+					m = (a.x < b.x) ? p : next(p);
+					if (x == hx) {
+						return m;
+					}
+				}
+			}
+			p = next(p);
+		} while (p != outer);
+		if (m == NONE) {
+			return NONE;
+		}
+
+		// A reflex vertex inside the triangle of hole point, hit and edge end blocks the view; take the one nearest the ray
+		const uint32_t stop = m;
+		const float mx = mNodes[m].x;
+		const float my = mNodes[m].y;
+		float tanMin = INFINITY;
+		p = m;
+		do {
+			const Node& np = mNodes[p];
+			if (hx >= np.x && np.x >= mx && hx != np.x
+				&& pointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, np.x, np.y)) {
+				const float tan = std::fabs(hy - np.y) / (hx - np.x);
+				if (locallyInside(p, hole)
+					&& (tan < tanMin || (tan == tanMin && (np.x > mNodes[m].x || (np.x == mNodes[m].x && sectorContainsSector(m, p)))))) {
+					m = p;
+					tanMin = tan;
+				}
+			}
+			p = next(p);
+		} while (p != stop);
+		return m;
+	}
+
+	// Cut from `a` to `b` and back, joining their rings into one; returns the copy of `b`
+	uint32_t split(uint32_t a, uint32_t b) {
+		const uint32_t a2 = static_cast<uint32_t>(mNodes.size());
+		mNodes.push_back(mNodes[a]);
+		const uint32_t b2 = a2 + 1U;
+		mNodes.push_back(mNodes[b]);
+		const uint32_t an = next(a);
+		const uint32_t bp = prev(b);
+
+		mNodes[a].next = b;
+		mNodes[b].prev = a;
+		mNodes[a2].next = an;
+		mNodes[an].prev = a2;
+		mNodes[b2].next = a2;
+		mNodes[a2].prev = b2;
+		mNodes[bp].next = b2;
+		mNodes[b2].prev = bp;
+		return b2;
+	}
+
+	uint32_t eliminateHoles(uint32_t outer, const std::vector<const VectorContour*>& holes) {
+		// Leftmost point of every hole, holes bridged left to right
+		std::vector<uint32_t> lefts;
+		lefts.reserve(holes.size());
+		for (const VectorContour* hole : holes) {
+			const uint32_t start = ring(*hole, false);
+			if (start == NONE) {
+				continue;
+			}
+			uint32_t left = start;
+			uint32_t p = start;
+			do {
+				if (mNodes[p].x < mNodes[left].x || (mNodes[p].x == mNodes[left].x && mNodes[p].y < mNodes[left].y)) {
+					left = p;
+				}
+				p = next(p);
+			} while (p != start);
+			lefts.push_back(left);
+		}
+		std::sort(lefts.begin(), lefts.end(), [this](uint32_t a, uint32_t b) {
+			return (mNodes[a].x != mNodes[b].x) ? mNodes[a].x < mNodes[b].x : mNodes[a].y < mNodes[b].y;
+		});
+
+		for (uint32_t hole : lefts) {
+			const uint32_t bridge = findBridge(hole, outer);
+			if (bridge == NONE) {
+				continue;
+			}
+			const uint32_t reverse = split(bridge, hole);
+			filter(reverse, next(reverse));
+			outer = filter(bridge, next(bridge));
+		}
+		return outer;
+	}
+
+	const Float2*				mPoints;
+	std::vector<uint32_t>&		mTriangles;
+	std::vector<Node>			mNodes;
+};
+
+//----------------------------------------------------------------
+
+// Join at `p` from direction `a` into direction `b`
+void strokeJoin(Emitter& emit, const IPen& pen, const Float2& p, const Float2& a, const Float2& b, float halfWidth, float tolerance) {
+	const float turn = cross(a, b);
+	const float cosAngle = dot(a, b);
+	if (std::fabs(turn) < 1e-6f && cosAngle > 0.0f) {
+		return;
+	}
+
+	// The gap opens on the outside of the turn, right of a left turn
+	const float side = (turn > 0.0f) ? -1.0f : 1.0f;
+	const Float2 na = normal(a) * (side * halfWidth);
+	const Float2 nb = normal(b) * (side * halfWidth);
+
+	switch (pen.join()) {
+	case LineJoin::Round:
+		emit.arc(p, p + na, -side * std::atan2(std::fabs(turn), cosAngle), halfWidth, tolerance);
+		return;
+
+	case LineJoin::Miter: {
+		// Tip at (na + nb) / (1 + cos), 1 / cos(angle / 2) half widths out
+		const float denom = 1.0f + cosAngle;
+		if (denom > 1e-4f && 2.0f / denom <= pen.miterLimit() * pen.miterLimit()) {
+			const Float2 tip = p + (na + nb) * (1.0f / denom);
+			emit.triangle(p, p + na, tip);
+			emit.triangle(p, tip, p + nb);
+			return;
+		}
+		[[fallthrough]];
+	}
+
+	case LineJoin::Bevel:
+		emit.triangle(p, p + na, p + nb);
+		return;
+	}
+}
+
+}
+
+//================================================================
+
+uint32_t tessellateFill(const VectorPath& path, const IBrush& brush, std::vector<GfxVertex>& out) {
+	const size_t start = out.size();
+	std::vector<Float2> points;
+	std::vector<VectorContour> contours;
+	path.flatten(points, contours);
+
+	// Outer contours wind like the largest one, the rest are holes in the smallest outer around them
+	std::vector<float> areas(contours.size(), 0.0f);
+	uint32_t largest = NONE;
+	for (uint32_t c = 0; c < contours.size(); ++c) {
+		if (contours[c].count < 3U) {
+			continue;
+		}
+		areas[c] = signedArea(points.data() + contours[c].first, contours[c].count);
+		if (largest == NONE || std::fabs(areas[c]) > std::fabs(areas[largest])) {
+			largest = c;
+		}
+	}
+	if (largest == NONE) {
+		return 0;
+	}
+
+	std::vector<std::vector<const VectorContour*>> holes(contours.size());
+	for (uint32_t c = 0; c < contours.size(); ++c) {
+		if (areas[c] == 0.0f || (areas[c] > 0.0f) == (areas[largest] > 0.0f)) {
+			continue;
+		}
+		const Float2 q = points[contours[c].first];
+		uint32_t owner = NONE;
+		for (uint32_t o = 0; o < contours.size(); ++o) {
+			if (areas[o] == 0.0f || (areas[o] > 0.0f) != (areas[largest] > 0.0f)) {
+				continue;
+			}
+			if ((owner == NONE || std::fabs(areas[o]) < std::fabs(areas[owner])) && pointInPolygon(points.data() + contours[o].first, contours[o].count, q)) {
+				owner = o;
+			}
+		}
+		if (owner != NONE) {
+			holes[owner].push_back(&contours[c]);
+		}
+	}
+
+	Emitter emit = { out, brush.color() };
+	std::vector<uint32_t> triangles;
+	EarClipper clipper(points.data(), triangles);
+	for (uint32_t c = 0; c < contours.size(); ++c) {
+		if (areas[c] == 0.0f || (areas[c] > 0.0f) != (areas[largest] > 0.0f)) {
+			continue;
+		}
+		const Float2* p = points.data() + contours[c].first;
+		if (holes[c].empty() && isConvex(p, contours[c].count)) {
+			for (uint32_t i = 2; i < contours[c].count; ++i) {
+				emit.triangle(p[0], p[i - 1U], p[i]);
+			}
+			continue;
+		}
+		triangles.clear();
+		clipper.run(contours[c], holes[c]);
+		for (size_t i = 0; i < triangles.size(); i += 3U) {
+			emit.triangle(points[triangles[i]], points[triangles[i + 1U]], points[triangles[i + 2U]]);
+		}
+	}
+	return static_cast<uint32_t>(out.size() - start);
+}
+
+uint32_t tessellateStroke(const VectorPath& path, const IPen& pen, std::vector<GfxVertex>& out) {
+	const size_t start = out.size();
+	const float halfWidth = pen.width() * 0.5f;
+	if (halfWidth <= 0.0f) {
+		return 0;
+	}
+	std::vector<Float2> points;
+	std::vector<VectorContour> contours;
+	path.flatten(points, contours);
+
+	const float tolerance = path.tolerance();
+	Emitter emit = { out, pen.color() };
+	for (const VectorContour& contour : contours) {
+		Float2* p = points.data() + contour.first;
+		const uint32_t n = contour.count;
+		const bool closed = contour.closed && n >= 3U;
+		const uint32_t segments = closed ? n : n - 1U;
+
+		const Float2 firstDir = direction(p[0], p[1]);
+		const Float2 lastDir = direction(p[n - 2U], p[n - 1U]);
+		if (!closed && pen.cap() == LineCap::Square) {
+			p[0] = p[0] - firstDir * halfWidth;
+			p[n - 1U] = p[n - 1U] + lastDir * halfWidth;
+		}
+
+		Float2 prevDir = closed ? direction(p[n - 1U], p[0]) : firstDir;
+		for (uint32_t s = 0; s < segments; ++s) {
+			const Float2& a = p[s];
+			const Float2& b = p[(s + 1U) % n];
+			const Float2 d = direction(a, b);
+			const Float2 offset = normal(d) * halfWidth;
+			emit.triangle(a + offset, a - offset, b + offset);
+			emit.triangle(b + offset, a - offset, b - offset);
+			if (s > 0 || closed) {
+				strokeJoin(emit, pen, a, prevDir, d, halfWidth, tolerance);
+			}
+			prevDir = d;
+		}
+
+		if (!closed && pen.cap() == LineCap::Round) {
+			emit.arc(p[0], p[0] - normal(firstDir) * halfWidth, -PI, halfWidth, tolerance);
+			emit.arc(p[n - 1U], p[n - 1U] + normal(lastDir) * halfWidth, -PI, halfWidth, tolerance);
+		}
+	}
+	return static_cast<uint32_t>(out.size() - start);
+}
+
+//================================================================
+
+VectorCache::Mesh::~Mesh() noexcept {}
+
+//================================================================
+
+VectorCache::VectorCache(const VectorCacheSettings& settings)
+	: mSettings(settings)
+	, mStats{}
+	, mFrame(0)
+	, mVertices(0) {
+}
+
+VectorCache::~VectorCache() noexcept {}
+
+void VectorCache::evict(std::unordered_map<uint64_t, std::unique_ptr<Mesh>>::iterator it) {
+	mVertices -= it->second->mVertices.size();
+	mMeshes.erase(it);
+	++mStats.evicted;
+}
+
+void VectorCache::beginFrame() {
+	++mFrame;
+	mStats = {};
+
+	mRetired.erase(std::remove_if(mRetired.begin(), mRetired.end(), [this](const std::unique_ptr<Mesh>& mesh) {
+		return mesh->mLastUsed + FRAMES_IN_FLIGHT < mFrame;
+	}), mRetired.end());
+
+	const uint64_t idle = std::max(mSettings.idleFrames, FRAMES_IN_FLIGHT);
+	for (auto it = mMeshes.begin(); it != mMeshes.end();) {
+		auto current = it++;
+		if (current->second->mLastUsed + idle < mFrame) {
+			evict(current);
+		}
+	}
+
+	// Over budget, least recently used first among those no frame in flight can be drawing
+	if (mVertices > mSettings.maxVertices) {
+		mScratch.clear();
+		for (const auto& [key, mesh] : mMeshes) {
+			if (mesh->mLastUsed + FRAMES_IN_FLIGHT < mFrame) {
+				mScratch.push_back(key);
+			}
+		}
+		std::sort(mScratch.begin(), mScratch.end(), [this](uint64_t a, uint64_t b) {
+			return mMeshes[a]->mLastUsed < mMeshes[b]->mLastUsed;
+		});
+		for (uint64_t key : mScratch) {
+			if (mVertices <= mSettings.maxVertices) {
+				break;
+			}
+			evict(mMeshes.find(key));
+		}
+	}
+	mStats.meshes = static_cast<uint32_t>(mMeshes.size());
+	mStats.vertices = mVertices;
+}
+
+VectorCache::Mesh* VectorCache::find(uint64_t key, bool& created) {
+	++mStats.requests;
+	std::unique_ptr<Mesh>& slot = mMeshes[key];
+	created = !slot;
+	if (created) {
+		slot = std::make_unique<Mesh>();
+		++mStats.meshes;
+	} else {
+		++mStats.hits;
+	}
+	slot->mLastUsed = mFrame;
+	return slot.get();
+}
+
+const IVertexBuffer* VectorCache::fill(const VectorPath& path, const IBrush& brush) {
+	const uint8_t kind = 0;
+	const uint32_t color = brush.color();
+	uint64_t key = fnv1a(path.hash(), &kind, sizeof(kind));
+	key = fnv1a(key, &color, sizeof(color));
+
+	bool created;
+	Mesh* mesh = find(key, created);
+	if (created) {
+		const Clock::time_point start = Clock::now();
+		mVertices += tessellateFill(path, brush, mesh->mVertices);
+		mesh->mVertices.shrink_to_fit();
+		++mStats.tessellated;
+		mStats.tessellateMs += elapsedMs(start);
+		mStats.vertices = mVertices;
+	}
+	return mesh->mVertices.empty() ? nullptr : mesh;
+}
+
+const IVertexBuffer* VectorCache::stroke(const VectorPath& path, const IPen& pen) {
+	struct Style {
+		uint32_t	color;
+		float		width;
+		float		miterLimit;
+		uint8_t		kind;
+		uint8_t		join;
+		uint8_t		cap;
+		uint8_t		pad;
+	};
+	const Style style = { pen.color(), pen.width(), pen.miterLimit(), 1U, static_cast<uint8_t>(pen.join()), static_cast<uint8_t>(pen.cap()), 0U };
+	const uint64_t key = fnv1a(path.hash(), &style, sizeof(style));
+
+	bool created;
+	Mesh* mesh = find(key, created);
+	if (created) {
+		const Clock::time_point start = Clock::now();
+		mVertices += tessellateStroke(path, pen, mesh->mVertices);
+		mesh->mVertices.shrink_to_fit();
+		++mStats.tessellated;
+		mStats.tessellateMs += elapsedMs(start);
+		mStats.vertices = mVertices;
+	}
+	return mesh->mVertices.empty() ? nullptr : mesh;
+}
+
+void VectorCache::submit(ICommandQueue& queue, const IVertexBuffer* mesh, const Float4x4* transform, uint64_t key, const IMaterial* material) {
+	if (!mesh) {
+		return;
+	}
+	DrawCommand cmd;
+	cmd.material = material;
+	cmd.texture = nullptr;
+	cmd.vertices = mesh;
+	cmd.transform = transform;
+	cmd.first = 0;
+	cmd.count = mesh->vertexCount();
+	cmd.primitive = Primitive::Triangles;
+	queue.submit(key, cmd);
+}
+
+void VectorCache::clear() {
+	// Frames in flight may still draw these
+	mRetired.reserve(mRetired.size() + mMeshes.size());
+	for (auto& [key, mesh] : mMeshes) {
+		mRetired.push_back(std::move(mesh));
+	}
+	mMeshes.clear();
+	mVertices = 0;
+	mStats.meshes = 0;
+	mStats.vertices = 0;
+}
@@ -0,0 +1,235 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/VectorPath.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//================================================================
+
+namespace {
+
+constexpr uint32_t MAX_CURVE_SEGMENTS = 64U;
+constexpr float KAPPA = 0.5522847498f;		// Cubic control distance for a quarter circle, of the radius
+
+inline uint64_t fnv1a(uint64_t h, const void* data, size_t size) noexcept {
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		h = (h ^ bytes[i]) * 1099511628211ULL;
+	}
+	return h;
+}
+
+inline Float2 lerp(const Float2& a, const Float2& b, float t) noexcept {
+	return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t };
+}
+
+inline float length(float x, float y) noexcept {
+	return std::sqrt(x * x + y * y);
+}
+
+// Segments keeping a curve with second difference `dd` within `tolerance`
+inline uint32_t curveSegments(float dd, float scale, float tolerance) noexcept {
+	const float n = std::ceil(std::sqrt(dd * scale / std::max(tolerance, 1e-4f)));
+	return std::clamp(static_cast<uint32_t>(n), 1U, MAX_CURVE_SEGMENTS);
+}
+
+// Append `p` unless it repeats the previous point
+inline void addPoint(std::vector<Float2>& points, uint32_t first, const Float2& p) {
+	if (points.size() > first) {
+		const Float2& last = points.back();
+		if (std::fabs(last.x - p.x) < 1e-6f && std::fabs(last.y - p.y) < 1e-6f) {
+			return;
+		}
+	}
+	points.push_back(p);
+}
+
+}
+
+//================================================================
+
+Brush::~Brush() noexcept {}
+Pen::~Pen() noexcept {}
+
+//================================================================
+
+void VectorPath::clear() noexcept {
+	mVerbs.clear();
+	mPoints.clear();
+	mHash = 14695981039346656037ULL;
+}
+
+void VectorPath::append(Verb verb, const Float2* points, uint32_t count) {
+	mVerbs.push_back(verb);
+	mPoints.insert(mPoints.end(), points, points + count);
+	mHash = fnv1a(mHash, &verb, sizeof(verb));
+	mHash = fnv1a(mHash, points, count * sizeof(Float2));
+}
+
+uint64_t VectorPath::hash() const noexcept {
+	return fnv1a(mHash, &mTolerance, sizeof(mTolerance));
+}
+
+void VectorPath::moveTo(const Float2& p) {
+	append(Verb::Move, &p, 1U);
+}
+
+void VectorPath::lineTo(const Float2& p) {
+	append(Verb::Line, &p, 1U);
+}
+
+void VectorPath::quadTo(const Float2& control, const Float2& p) {
+	const Float2 points[2] = { control, p };
+	append(Verb::Quad, points, 2U);
+}
+
+void VectorPath::cubicTo(const Float2& control0, const Float2& control1, const Float2& p) {
+	const Float2 points[3] = { control0, control1, p };
+	append(Verb::Cubic, points, 3U);
+}
+
+void VectorPath::close() {
+	append(Verb::Close, nullptr, 0U);
+}
+
+//----------------------------------------------------------------
+
+void VectorPath::rect(const Float2& min, const Float2& size) {
+	moveTo(min);
+	lineTo({ min.x + size.x, min.y });
+	lineTo({ min.x + size.x, min.y + size.y });
+	lineTo({ min.x, min.y + size.y });
+	close();
+}
+
+void VectorPath::roundedRect(const Float2& min, const Float2& size, float radius) {
+	const float r = std::min(radius, std::min(size.x, size.y) * 0.5f);
+	if (r <= 0.0f) {
+		rect(min, size);
+		return;
+	}
+	const float k = r * (1.0f - KAPPA);
+	const float x0 = min.x;
+	const float y0 = min.y;
+	const float x1 = min.x + size.x;
+	const float y1 = min.y + size.y;
+
+	moveTo({ x0 + r, y0 });
+	lineTo({ x1 - r, y0 });
+	cubicTo({ x1 - k, y0 }, { x1, y0 + k }, { x1, y0 + r });
+	lineTo({ x1, y1 - r });
+	cubicTo({ x1, y1 - k }, { x1 - k, y1 }, { x1 - r, y1 });
+	lineTo({ x0 + r, y1 });
+	cubicTo({ x0 + k, y1 }, { x0, y1 - k }, { x0, y1 - r });
+	lineTo({ x0, y0 + r });
+	cubicTo({ x0, y0 + k }, { x0 + k, y0 }, { x0 + r, y0 });
+	close();
+}
+
+void VectorPath::ellipse(const Float2& center, const Float2& radii) {
+	const float kx = radii.x * KAPPA;
+	const float ky = radii.y * KAPPA;
+	const float cx = center.x;
+	const float cy = center.y;
+
+	moveTo({ cx + radii.x, cy });
+	cubicTo({ cx + radii.x, cy + ky }, { cx + kx, cy + radii.y }, { cx, cy + radii.y });
+	cubicTo({ cx - kx, cy + radii.y }, { cx - radii.x, cy + ky }, { cx - radii.x, cy });
+	cubicTo({ cx - radii.x, cy - ky }, { cx - kx, cy - radii.y }, { cx, cy - radii.y });
+	cubicTo({ cx + kx, cy - radii.y }, { cx + radii.x, cy - ky }, { cx + radii.x, cy });
+	close();
+}
+
+//----------------------------------------------------------------
+
+void VectorPath::flatten(std::vector<Float2>& points, std::vector<VectorContour>& contours) const {
+	uint32_t first = static_cast<uint32_t>(points.size());
+	Float2 current = { 0.0f, 0.0f };
+	const auto endContour = [&](bool closed) {
+		uint32_t count = static_cast<uint32_t>(points.size()) - first;
+		if (closed && count > 1U) {
+			// The closing point usually repeats the first
+			const Float2& a = points[first];
+			const Float2& b = points.back();
+			if (std::fabs(a.x - b.x) < 1e-6f && std::fabs(a.y - b.y) < 1e-6f) {
+				points.pop_back();
+				--count;
+			}
+		}
+		if (count >= 2U) {
+			contours.push_back({ first, count, closed });
+		} else {
+			points.resize(first);
+		}
+		first = static_cast<uint32_t>(points.size());
+	};
+
+	const Float2* p = mPoints.data();
+	for (Verb verb : mVerbs) {
+		switch (verb) {
+		case Verb::Move:
+			endContour(false);
+			current = *p++;
+			addPoint(points, first, current);
+			break;
+
+		case Verb::Line:
+			if (points.size() == first) {
+				addPoint(points, first, current);
+			}
+			current = *p++;
+			addPoint(points, first, current);
+			break;
+
+		case Verb::Quad: {
+			if (points.size() == first) {
+				addPoint(points, first, current);
+			}
+			const Float2 c = p[0];
+			const Float2 e = p[1];
+			p += 2;
+			// Chord error of a quadratic is |p0 - 2 c + p1| h^2 / 4
+			const uint32_t n = curveSegments(length(current.x - 2.0f * c.x + e.x, current.y - 2.0f * c.y + e.y), 0.25f, mTolerance);
+			for (uint32_t i = 1; i <= n; ++i) {
+				const float t = static_cast<float>(i) / static_cast<float>(n);
+				addPoint(points, first, lerp(lerp(current, c, t), lerp(c, e, t), t));
+			}
+			current = e;
+			break;
+		}
+
+		case Verb::Cubic: {
+			if (points.size() == first) {
+				addPoint(points, first, current);
+			}
+			const Float2 c0 = p[0];
+			const Float2 c1 = p[1];
+			const Float2 e = p[2];
+			p += 3;
+			// Chord error of a cubic is at most 3 max|second difference| h^2 / 4
+			const float dd = std::max(length(current.x - 2.0f * c0.x + c1.x, current.y - 2.0f * c0.y + c1.y),
+				length(c0.x - 2.0f * c1.x + e.x, c0.y - 2.0f * c1.y + e.y));
+			const uint32_t n = curveSegments(dd, 0.75f, mTolerance);
+			for (uint32_t i = 1; i <= n; ++i) {
+				const float t = static_cast<float>(i) / static_cast<float>(n);
+				const Float2 a = lerp(lerp(current, c0, t), lerp(c0, c1, t), t);
+				const Float2 b = lerp(lerp(c0, c1, t), lerp(c1, e, t), t);
+				addPoint(points, first, lerp(a, b, t));
+			}
+			current = e;
+			break;
+		}
+
+		case Verb::Close:
+			if (points.size() > first) {
+				current = points[first];
+			}
+			endContour(true);
+			break;
+		}
+	}
+	endContour(false);
+}
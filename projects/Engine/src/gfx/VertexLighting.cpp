@@ -0,0 +1,336 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/VertexLighting.hh>
+#include <Engine/core/Jobs.hh>
+#include <Engine/math/simd.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t BLOCK_GRAIN = 256U;		// 4-vertex blocks per job
+constexpr size_t CACHE_FLOATS = 36U;		// Cached floats per block, 9 lanes of 4
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+inline uint64_t fnv64(uint64_t h, const void* data, size_t size) noexcept {
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		h = (h ^ bytes[i]) * FNV_PRIME;
+	}
+	return h;
+}
+
+inline float luminance(const Float3& c) noexcept {
+	return c.x * 0.299f + c.y * 0.587f + c.z * 0.114f;
+}
+
+// A light splatted across the four lanes
+struct KernelLight {
+	LightType	type;
+	SimdFloat4	color[3];
+	SimdFloat4	position[3];
+	SimdFloat4	direction[3];
+	SimdFloat4	invRange2;
+	SimdFloat4	spotScale;
+	SimdFloat4	spotBias;
+};
+
+inline SimdFloat4 saturate(SimdFloat4 a) noexcept {
+	return simdMin(simdMax(a, simdSplat(0.0f)), simdSplat(1.0f));
+}
+
+// Four vertices' world position and normal, light accumulates into `c`
+inline void shade(const KernelLight& l, const SimdFloat4 (&p)[3], const SimdFloat4 (&n)[3], SimdFloat4 (&c)[3]) noexcept {
+	const SimdFloat4 zero = simdSplat(0.0f);
+	SimdFloat4 amount;
+	if (l.type == LightType::Directional) {
+		amount = simdMax(zero, zero - (n[0] * l.direction[0] + n[1] * l.direction[1] + n[2] * l.direction[2]));
+	} else {
+		const SimdFloat4 lx = l.position[0] - p[0];
+		const SimdFloat4 ly = l.position[1] - p[1];
+		const SimdFloat4 lz = l.position[2] - p[2];
+		const SimdFloat4 d2 = simdMax(lx * lx + ly * ly + lz * lz, simdSplat(1.0e-8f));
+		const SimdFloat4 inv = simdSplat(1.0f) / simdSqrt(d2);
+		const SimdFloat4 ndl = simdMax(zero, (n[0] * lx + n[1] * ly + n[2] * lz) * inv);
+
+		// Windowed falloff, reaches zero at the range
+		const SimdFloat4 window = simdMax(zero, simdSplat(1.0f) - d2 * l.invRange2);
+		amount = ndl * window * window;
+		if (l.type == LightType::Spot) {
+			const SimdFloat4 cosine = zero - (lx * l.direction[0] + ly * l.direction[1] + lz * l.direction[2]) * inv;
+			amount = amount * saturate(cosine * l.spotScale + l.spotBias);
+		}
+	}
+	c[0] = c[0] + l.color[0] * amount;
+	c[1] = c[1] + l.color[1] * amount;
+	c[2] = c[2] + l.color[2] * amount;
+}
+
+// Object to world for four vertices, normals renormalized after the 3x3
+inline void transformBlock(const VertexLightingMesh& mesh, const Float4x4& world, size_t block, SimdFloat4 (&p)[3], SimdFloat4 (&n)[3]) noexcept {
+	alignas(16) float ps[3][4];
+	alignas(16) float ns[3][4];
+	const size_t first = block * 4U;
+	const size_t last = mesh.vertexCount - 1U;
+	for (size_t lane = 0; lane < 4U; ++lane) {
+		// The tail block repeats the last vertex
+		const size_t v = std::min(first + lane, last);
+		ps[0][lane] = mesh.positions[v].x;
+		ps[1][lane] = mesh.positions[v].y;
+		ps[2][lane] = mesh.positions[v].z;
+		ns[0][lane] = mesh.normals[v].x;
+		ns[1][lane] = mesh.normals[v].y;
+		ns[2][lane] = mesh.normals[v].z;
+	}
+	const SimdFloat4 x = simdLoad(ps[0]), y = simdLoad(ps[1]), z = simdLoad(ps[2]);
+	const SimdFloat4 nx = simdLoad(ns[0]), ny = simdLoad(ns[1]), nz = simdLoad(ns[2]);
+	const float* m = world.m;
+	for (size_t r = 0; r < 3U; ++r) {
+		p[r] = simdSplat(m[r]) * x + simdSplat(m[4 + r]) * y + simdSplat(m[8 + r]) * z + simdSplat(m[12 + r]);
+		n[r] = simdSplat(m[r]) * nx + simdSplat(m[4 + r]) * ny + simdSplat(m[8 + r]) * nz;
+	}
+	const SimdFloat4 len2 = simdMax(n[0] * n[0] + n[1] * n[1] + n[2] * n[2], simdSplat(1.0e-12f));
+	const SimdFloat4 inv = simdSplat(1.0f) / simdSqrt(len2);
+	n[0] = n[0] * inv;
+	n[1] = n[1] * inv;
+	n[2] = n[2] * inv;
+}
+
+// Base colour times light, alpha kept, into the vertices' colour field
+inline void writeBlock(const VertexLightingMesh& mesh, size_t block, const SimdFloat4 (&c)[3], GfxVertex* out) noexcept {
+	alignas(16) int32_t base[4];
+	const size_t first = block * 4U;
+	const size_t count = std::min<size_t>(4U, mesh.vertexCount - first);
+	for (size_t lane = 0; lane < 4U; ++lane) {
+		base[lane] = static_cast<int32_t>(mesh.colors ? mesh.colors[first + std::min(lane, count - 1U)] : 0xFFFFFFFFU);
+	}
+	const SimdInt4 argb = simdLoad(base);
+	const SimdInt4 byte = simdSplat(static_cast<int32_t>(0xFF));
+	const SimdFloat4 top = simdSplat(255.0f);
+	const SimdFloat4 r = simdMin(simdToFloat(simdShr<16>(argb) & byte) * c[0], top);
+	const SimdFloat4 g = simdMin(simdToFloat(simdShr<8>(argb) & byte) * c[1], top);
+	const SimdFloat4 b = simdMin(simdToFloat(argb & byte) * c[2], top);
+	const SimdInt4 lit = (argb & simdSplat(static_cast<int32_t>(0xFF000000U)))
+		| simdShl<16>(simdToInt(r)) | simdShl<8>(simdToInt(g)) | simdToInt(b);
+
+	alignas(16) int32_t packed[4];
+	simdStore(packed, lit);
+	for (size_t lane = 0; lane < count; ++lane) {
+		out[first + lane].color = static_cast<uint32_t>(packed[lane]);
+	}
+}
+
+} // namespace
+
+//================================================================
+
+Light::~Light() noexcept {}
+
+void Light::setCone(float inner, float outer) noexcept {
+	mInner = std::cos(inner);
+	mOuter = std::cos(std::max(outer, inner));
+}
+
+//================================================================
+
+VertexLighting::~VertexLighting() noexcept {}
+
+void VertexLighting::beginFrame(const Float3& ambient) {
+	mSources.clear();
+	mAmbient = ambient;
+	mStats = {};
+}
+
+bool VertexLighting::addLight(const ILight* light) {
+	if (!light || mSources.size() >= MAX_FRAME_LIGHTS) {
+		return false;
+	}
+	Source source;
+	source.type = light->type();
+	source.isStatic = light->isStatic();
+	source.color = light->color();
+	source.position = light->position();
+	source.direction = normalize(light->direction());
+	source.range = std::max(light->range(), 1.0e-4f);
+	source.invRange2 = 1.0f / (source.range * source.range);
+
+	const float inner = light->innerCone();
+	const float outer = std::min(light->outerCone(), inner - 1.0e-4f);
+	source.spotScale = 1.0f / (inner - outer);
+	source.spotBias = -outer * source.spotScale;
+	source.cosOuter = outer;
+	source.sinOuter = std::sqrt(std::max(0.0f, 1.0f - outer * outer));
+
+	const float params[] = { source.color.x, source.color.y, source.color.z, source.position.x, source.position.y, source.position.z,
+		source.direction.x, source.direction.y, source.direction.z, source.range, inner, outer };
+	source.hash = fnv64(fnv64(FNV_OFFSET, &source.type, sizeof(source.type)), params, sizeof(params));
+
+	mSources.push_back(source);
+	++mStats.lights;
+	return true;
+}
+
+//----------------------------------------------------------------
+
+uint32_t VertexLighting::select(const Aabb& bounds, uint32_t (&picked)[MAX_LIGHTS_PER_OBJECT]) {
+	float strength[MAX_LIGHTS_PER_OBJECT];
+	uint32_t count = 0;
+	const Float3 center = bounds.center();
+	const float radius = length(bounds.extents());
+
+	for (uint32_t i = 0; i < mSources.size(); ++i) {
+		const Source& s = mSources[i];
+		float weight = luminance(s.color);
+		if (s.type != LightType::Directional) {
+			// Range sphere against the box
+			const Float3 gap = max(max(bounds.min - s.position, s.position - bounds.max), Float3{ 0.0f, 0.0f, 0.0f });
+			const float d2 = dot(gap, gap);
+			if (d2 >= s.range * s.range) {
+				++mStats.lightsCulled;
+				continue;
+			}
+			// Cone against the box's bounding sphere
+			if (s.type == LightType::Spot) {
+				const Float3 v = center - s.position;
+				const float along = dot(v, s.direction);
+				const float across = std::sqrt(std::max(0.0f, dot(v, v) - along * along));
+				if (s.cosOuter * across - along * s.sinOuter > radius || along < -radius) {
+					++mStats.lightsCulled;
+					continue;
+				}
+			}
+			const float window = 1.0f - d2 * s.invRange2;
+			weight *= window * window;
+		}
+
+		// Keep the strongest, earlier lights win ties
+		if (count == MAX_LIGHTS_PER_OBJECT) {
+			++mStats.lightsDropped;
+			if (weight <= strength[count - 1U]) {
+				continue;
+			}
+			--count;
+		}
+		uint32_t at = count++;
+		while (at > 0 && strength[at - 1U] < weight) {
+			strength[at] = strength[at - 1U];
+			picked[at] = picked[at - 1U];
+			--at;
+		}
+		strength[at] = weight;
+		picked[at] = i;
+	}
+	return count;
+}
+
+void VertexLighting::light(const VertexLightingMesh& mesh, const Float4x4& world, const Aabb& bounds, GfxVertex* out, VertexLightCache* cache) {
+	if (!mesh.positions || !mesh.normals || !out || mesh.vertexCount == 0) {
+		return;
+	}
+	const auto start = Clock::now();
+	++mStats.objects;
+
+	uint32_t picked[MAX_LIGHTS_PER_OBJECT];
+	const uint32_t count = select(bounds, picked);
+
+	// Static lights go into the cache (in pick order, so the key follows the set), the rest are per frame
+	KernelLight cached[MAX_LIGHTS_PER_OBJECT];
+	KernelLight dynamic[MAX_LIGHTS_PER_OBJECT];
+	uint32_t cachedCount = 0;
+	uint32_t dynamicCount = 0;
+	// The cache holds world-space vertices, so the mesh and its placement are part of the key
+	uint64_t key = fnv64(FNV_OFFSET, &mesh.vertexCount, sizeof(mesh.vertexCount));
+	key = fnv64(key, &mesh.positions, sizeof(mesh.positions));
+	key = fnv64(key, &mesh.normals, sizeof(mesh.normals));
+	key = fnv64(key, world.m, sizeof(world.m));
+	for (uint32_t i = 0; i < count; ++i) {
+		const Source& s = mSources[picked[i]];
+		const bool toCache = cache && s.isStatic;
+		KernelLight& k = toCache ? cached[cachedCount++] : dynamic[dynamicCount++];
+		k.type = s.type;
+		k.color[0] = simdSplat(s.color.x);
+		k.color[1] = simdSplat(s.color.y);
+		k.color[2] = simdSplat(s.color.z);
+		k.position[0] = simdSplat(s.position.x);
+		k.position[1] = simdSplat(s.position.y);
+		k.position[2] = simdSplat(s.position.z);
+		k.direction[0] = simdSplat(s.direction.x);
+		k.direction[1] = simdSplat(s.direction.y);
+		k.direction[2] = simdSplat(s.direction.z);
+		k.invRange2 = simdSplat(s.invRange2);
+		k.spotScale = simdSplat(s.spotScale);
+		k.spotBias = simdSplat(s.spotBias);
+		if (toCache) {
+			key = fnv64(key, &s.hash, sizeof(s.hash));
+		}
+	}
+	key |= 1U;	// 0 is an invalidated cache
+
+	const size_t blocks = (static_cast<size_t>(mesh.vertexCount) + 3U) / 4U;
+	const bool rebuild = cache && (cache->mKey != key || cache->mData.size() != blocks * CACHE_FLOATS);
+	if (rebuild) {
+		cache->mData.resize(blocks * CACHE_FLOATS);
+		float* data = cache->mData.data();
+		JobSystem::instance().parallelFor(blocks, BLOCK_GRAIN, [&](size_t begin, size_t end) {
+			for (size_t block = begin; block < end; ++block) {
+				SimdFloat4 p[3], n[3];
+				SimdFloat4 c[3] = { simdSplat(0.0f), simdSplat(0.0f), simdSplat(0.0f) };
+				transformBlock(mesh, world, block, p, n);
+				for (uint32_t i = 0; i < cachedCount; ++i) {
+					shade(cached[i], p, n, c);
+				}
+				float* dst = data + block * CACHE_FLOATS;
+				for (size_t r = 0; r < 3U; ++r) {
+					simdStoreU(dst + r * 4U, p[r]);
+					simdStoreU(dst + 12U + r * 4U, n[r]);
+					simdStoreU(dst + 24U + r * 4U, c[r]);
+				}
+			}
+		});
+		cache->mKey = key;
+		++mStats.cacheRebuilds;
+	}
+
+	const SimdFloat4 ambient[3] = { simdSplat(mAmbient.x), simdSplat(mAmbient.y), simdSplat(mAmbient.z) };
+	const float* data = cache ? cache->mData.data() : nullptr;
+	JobSystem::instance().parallelFor(blocks, BLOCK_GRAIN, [&](size_t begin, size_t end) {
+		for (size_t block = begin; block < end; ++block) {
+			SimdFloat4 p[3], n[3];
+			SimdFloat4 c[3] = { ambient[0], ambient[1], ambient[2] };
+			if (data) {
+				const float* src = data + block * CACHE_FLOATS;
+				for (size_t r = 0; r < 3U; ++r) {
+					c[r] = c[r] + simdLoadU(src + 24U + r * 4U);
+				}
+				if (dynamicCount) {
+					for (size_t r = 0; r < 3U; ++r) {
+						p[r] = simdLoadU(src + r * 4U);
+						n[r] = simdLoadU(src + 12U + r * 4U);
+					}
+				}
+			} else {
+				transformBlock(mesh, world, block, p, n);
+			}
+			for (uint32_t i = 0; i < dynamicCount; ++i) {
+				shade(dynamic[i], p, n, c);
+			}
+			writeBlock(mesh, block, c, out);
+		}
+	});
+
+	if (cache && !rebuild && dynamicCount == 0) {
+		mStats.verticesCached += mesh.vertexCount;
+	} else {
+		mStats.verticesLit += mesh.vertexCount;
+	}
+	mStats.lightMs += std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
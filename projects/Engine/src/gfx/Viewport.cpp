@@ -0,0 +1,202 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/Viewport.hh>
+#include <Engine/core/Jobs.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr size_t UPSCALE_GRAIN = 16U;		// Rows per job
+
+// Source column or row and the 8-bit weight of the next one, per output pixel
+struct Tap {
+	uint32_t	i0;
+	uint32_t	i1;
+	uint32_t	f;
+};
+
+// Sample positions at pixel centres, 16.16 fixed point
+void buildTaps(std::vector<Tap>& taps, uint32_t srcSize, uint32_t dstSize, bool bilinear) {
+	taps.resize(dstSize);
+	const int64_t step = (static_cast<int64_t>(srcSize) << 16) / dstSize;
+	int64_t pos = step / 2 - (bilinear ? 0x8000 : 0);
+	for (uint32_t i = 0; i < dstSize; ++i, pos += step) {
+		const int64_t p = (pos < 0) ? 0 : pos;
+		const uint32_t i0 = std::min(static_cast<uint32_t>(p >> 16), srcSize - 1U);
+		taps[i] = { i0, std::min(i0 + 1U, srcSize - 1U), bilinear ? static_cast<uint32_t>((p >> 8) & 0xFFU) : 0U };
+	}
+}
+
+// a + (b - a) * f / 256 on all four channels, red / blue and alpha / green in two multiplies
+inline uint32_t lerpArgb(uint32_t a, uint32_t b, uint32_t f) noexcept {
+	const uint32_t g = 256U - f;
+	const uint32_t rb = (((a & 0x00FF00FFU) * g + (b & 0x00FF00FFU) * f) >> 8) & 0x00FF00FFU;
+	const uint32_t ag = (((a >> 8) & 0x00FF00FFU) * g + ((b >> 8) & 0x00FF00FFU) * f) & 0xFF00FF00U;
+	return rb | ag;
+}
+
+inline const uint32_t* rowOf(const uint32_t* image, size_t stride, uint32_t y) noexcept {
+	return reinterpret_cast<const uint32_t*>(reinterpret_cast<const uint8_t*>(image) + y * stride);
+}
+
+inline uint32_t* rowOf(uint32_t* image, size_t stride, uint32_t y) noexcept {
+	return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(image) + y * stride);
+}
+
+} // namespace
+
+//================================================================
+
+void upscaleArgb(const uint32_t* src, uint32_t srcWidth, uint32_t srcHeight, size_t srcStride,
+	uint32_t* dst, uint32_t dstWidth, uint32_t dstHeight, size_t dstStride, UpscaleFilter filter) {
+	if (!src || !dst || !srcWidth || !srcHeight || !dstWidth || !dstHeight) {
+		return;
+	}
+	if (srcWidth == dstWidth && srcHeight == dstHeight) {
+		for (uint32_t y = 0; y < dstHeight; ++y) {
+			std::memcpy(rowOf(dst, dstStride, y), rowOf(src, srcStride, y), dstWidth * sizeof(uint32_t));
+		}
+		return;
+	}
+
+	const bool bilinear = (filter == UpscaleFilter::Bilinear);
+	std::vector<Tap> columns;
+	std::vector<Tap> rows;
+	buildTaps(columns, srcWidth, dstWidth, bilinear);
+	buildTaps(rows, srcHeight, dstHeight, bilinear);
+	const Tap* cols = columns.data();
+	const Tap* ys = rows.data();
+
+	JobSystem::instance().parallelFor(dstHeight, UPSCALE_GRAIN, [=](size_t begin, size_t end) {
+		// Rows blended vertically once, then stretched; rows often repeat when upscaling
+		std::vector<uint32_t> blended(bilinear ? srcWidth : 0U);
+		uint32_t blendedRow = 0xFFFFFFFFU;
+		uint32_t blendedWeight = 0;
+
+		for (size_t y = begin; y < end; ++y) {
+			const Tap& ty = ys[y];
+			uint32_t* out = rowOf(dst, dstStride, static_cast<uint32_t>(y));
+
+			if (!bilinear) {
+				const uint32_t* r0 = rowOf(src, srcStride, ty.i0);
+				for (uint32_t x = 0; x < dstWidth; ++x) {
+					out[x] = r0[cols[x].i0];
+				}
+				continue;
+			}
+
+			if (ty.i0 != blendedRow || ty.f != blendedWeight) {
+				const uint32_t* r0 = rowOf(src, srcStride, ty.i0);
+				const uint32_t* r1 = rowOf(src, srcStride, ty.i1);
+				if (ty.f == 0U) {
+					std::memcpy(blended.data(), r0, srcWidth * sizeof(uint32_t));
+				} else {
+					for (uint32_t x = 0; x < srcWidth; ++x) {
+						blended[x] = lerpArgb(r0[x], r1[x], ty.f);
+					}
+				}
+				blendedRow = ty.i0;
+				blendedWeight = ty.f;
+			}
+
+			const uint32_t* row = blended.data();
+			for (uint32_t x = 0; x < dstWidth; ++x) {
+				const Tap& tx = cols[x];
+				out[x] = lerpArgb(row[tx.i0], row[tx.i1], tx.f);
+			}
+		}
+	});
+}
+
+//================================================================
+
+Viewport::Viewport(uint32_t width, uint32_t height, const ViewportSettings& settings)
+	: mSettings(settings)
+	, mTrace{}
+	, mTraceHead(0)
+	, mTraceCount(0)
+	, mWidth(width)
+	, mHeight(height)
+	, mRenderWidth(width)
+	, mRenderHeight(height)
+	, mCalmFrames(0)
+	, mScale(1.0f)
+	, mAverage(0.0f) {
+	applyScale(mSettings.maxScale);
+}
+
+Viewport::~Viewport() noexcept {}
+
+void Viewport::applyScale(float scale) noexcept {
+	mScale = std::clamp(scale, mSettings.minScale, mSettings.maxScale);
+	mRenderWidth = std::max(1U, static_cast<uint32_t>(std::lround(static_cast<float>(mWidth) * mScale)));
+	mRenderHeight = std::max(1U, static_cast<uint32_t>(std::lround(static_cast<float>(mHeight) * mScale)));
+}
+
+void Viewport::resize(uint32_t width, uint32_t height) noexcept {
+	mWidth = width;
+	mHeight = height;
+	applyScale(mScale);
+}
+
+void Viewport::setScale(float scale) noexcept {
+	applyScale(scale);
+	mAverage = 0.0f;
+	mCalmFrames = 0;
+}
+
+void Viewport::setSettings(const ViewportSettings& settings) noexcept {
+	mSettings = settings;
+	applyScale(mScale);
+}
+
+bool Viewport::update(float frameMs) noexcept {
+	const ViewportSettings& s = mSettings;
+	mAverage = (mAverage > 0.0f) ? mAverage + (frameMs - mAverage) * s.smoothing : frameMs;
+
+	float scale = mScale;
+	if (mAverage > s.budgetMs * s.dropAbove) {
+		// Straight to the middle of the band, cost taken as proportional to area
+		const float aim = s.budgetMs * 0.5f * (s.dropAbove + s.raiseBelow);
+		scale = mScale * std::sqrt(aim / mAverage);
+		mCalmFrames = 0;
+	} else if (mAverage < s.budgetMs * s.raiseBelow && mScale < s.maxScale) {
+		if (++mCalmFrames >= s.raiseFrames) {
+			// Only a step that should stay under the drop threshold
+			const float next = std::min(mScale + s.raiseStep, s.maxScale);
+			const float ratio = next / mScale;
+			if (mAverage * ratio * ratio < s.budgetMs * s.dropAbove) {
+				scale = next;
+			}
+			mCalmFrames = 0;
+		}
+	} else {
+		mCalmFrames = 0;
+	}
+
+	const uint32_t width = mRenderWidth;
+	const uint32_t height = mRenderHeight;
+	if (scale != mScale) {
+		// Expect the new size's cost from the next frame on
+		const float old = mScale;
+		applyScale(scale);
+		const float ratio = mScale / old;
+		mAverage *= ratio * ratio;
+	}
+
+	mTrace[mTraceHead] = { frameMs, mAverage, mScale };
+	mTraceHead = (mTraceHead + 1U) % TRACE_LENGTH;
+	mTraceCount = std::min(mTraceCount + 1U, TRACE_LENGTH);
+	return width != mRenderWidth || height != mRenderHeight;
+}
+
+void Viewport::present(const uint32_t* rendered, size_t renderedStride, uint32_t* output, size_t outputStride) const {
+	upscaleArgb(rendered, mRenderWidth, mRenderHeight, renderedStride, output, mWidth, mHeight, outputStride, mSettings.filter);
+}
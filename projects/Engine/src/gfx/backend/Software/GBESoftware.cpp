@@ -0,0 +1,493 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/backend/Software/GBESoftware.hh>
+#include <Engine/core/Jobs.hh>
+#include <Engine/gfx/Color.hh>
+#include <Engine/math/Geometry.hh>
+#include <Engine/math/simd.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline float elapsedMs(Clock::time_point start) noexcept {
+	return static_cast<float>(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+}
+
+//----------------------------------------------------------------
+
+// Texel to ARGB8888
+inline uint32_t decodeTexel(PixelFormat format, const uint8_t* p) noexcept {
+	if (format == PixelFormat::ARGB8888) {
+		uint32_t c;
+		std::memcpy(&c, p, sizeof(c));
+		return c;
+	}
+	uint16_t t;
+	std::memcpy(&t, p, sizeof(t));
+	return unpackPixel(format, t);
+}
+
+// Point sampler with wrapping
+struct Sampler {
+	const uint8_t*	texels;
+	size_t			texelBytes;
+	int32_t			width;
+	int32_t			height;
+	float			scaleU;
+	float			scaleV;
+	PixelFormat		format;
+
+	explicit Sampler(const ITexture* texture) noexcept
+		: texels(texture ? static_cast<const uint8_t*>(texture->pixels()) : nullptr)
+		, texelBytes(texture ? pixelFormatBytes(texture->format()) : 0U)
+		, width(texture ? static_cast<int32_t>(texture->width()) : 0)
+		, height(texture ? static_cast<int32_t>(texture->height()) : 0)
+		, scaleU(static_cast<float>(width))
+		, scaleV(static_cast<float>(height))
+		, format(texture ? texture->format() : PixelFormat::ARGB8888) {
+		if (width <= 0 || height <= 0) {
+			texels = nullptr;
+		}
+	}
+
+	inline uint32_t fetch(float u, float v) const noexcept {
+		int32_t x = static_cast<int32_t>(std::floor(u * scaleU)) % width;
+		int32_t y = static_cast<int32_t>(std::floor(v * scaleV)) % height;
+		x += (x < 0) ? width : 0;
+		y += (y < 0) ? height : 0;
+		return decodeTexel(format, texels + (static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * texelBytes);
+	}
+};
+
+inline uint32_t toByte(float v) noexcept {
+	return static_cast<uint32_t>(std::clamp(v, 0.0f, 255.0f) + 0.5f);
+}
+
+// (a * b) / 255, rounded
+inline uint32_t mul255(uint32_t a, uint32_t b) noexcept {
+	const uint32_t t = a * b + 128U;
+	return (t + (t >> 8)) >> 8;
+}
+
+} // namespace
+
+//================================================================
+
+GBESoftware::GBESoftware()
+	: mTarget(nullptr)
+	, mViewProj(Float4x4::identity())
+	, mMaterial(nullptr)
+	, mTexture(nullptr)
+	, mVertices(nullptr)
+	, mList(RenderList::Opaque)
+	, mPass(0)
+	, mStateDirty(true)
+	, mClearColor(0)
+	, mTilesX(0)
+	, mTilesY(0)
+	, mStats{} {
+}
+
+GBESoftware::~GBESoftware() noexcept {}
+
+//----------------------------------------------------------------
+
+void GBESoftware::beginFrame(SoftwareFrameBuffer& target, uint32_t clearColor) {
+	mTarget = &target;
+	mClearColor = clearColor;
+	mTilesX = (target.width() + TILE_WIDTH - 1U) / TILE_WIDTH;
+	mTilesY = (target.height() + TILE_HEIGHT - 1U) / TILE_HEIGHT;
+
+	mTileBins.resize(static_cast<size_t>(mTilesX) * mTilesY);
+	for (std::vector<uint32_t>& bin : mTileBins) {
+		bin.clear();
+	}
+	mTileFragments.assign(mTileBins.size(), 0U);
+	mTris.clear();
+	mStates.clear();
+	mStateDirty = true;
+	mStats = {};
+}
+
+void GBESoftware::endFrame() {
+	if (!mTarget) {
+		return;
+	}
+
+	const Clock::time_point start = Clock::now();
+	JobSystem::instance().parallelFor(mTileBins.size(), 1, [this](size_t begin, size_t end) {
+		for (size_t tile = begin; tile < end; ++tile) {
+			rasterizeTile(static_cast<uint32_t>(tile));
+		}
+	});
+
+	for (size_t tile = 0; tile < mTileBins.size(); ++tile) {
+		mStats.tilesRendered += mTileBins[tile].empty() ? 0U : 1U;
+		mStats.fragments += mTileFragments[tile];
+	}
+	mStats.rasterMs = elapsedMs(start);
+	mTarget = nullptr;
+}
+
+//----------------------------------------------------------------
+
+void GBESoftware::setPass(uint8_t pass) {
+	mPass = pass;
+}
+
+void GBESoftware::setRenderList(RenderList list) {
+	mStateDirty |= (list != mList);
+	mList = list;
+}
+
+void GBESoftware::bindMaterial(const IMaterial* material) {
+	mMaterial = material;
+}
+
+void GBESoftware::bindTexture(const ITexture* texture) {
+	mStateDirty |= (texture != mTexture);
+	mTexture = texture;
+}
+
+void GBESoftware::bindVertexBuffer(const IVertexBuffer* vertices) {
+	mVertices = vertices;
+}
+
+void GBESoftware::draw(const DrawCommand& cmd) {
+	const GfxVertex* src = mVertices ? mVertices->vertices() : nullptr;
+	if (!mTarget || !src || cmd.count < 3U || static_cast<uint64_t>(cmd.first) + cmd.count > mVertices->vertexCount()) {
+		return;
+	}
+
+	const Clock::time_point start = Clock::now();
+	if (mStateDirty) {
+		mStates.push_back({ mTexture, mList });
+		mStateDirty = false;
+	}
+
+	const Float4x4 m = cmd.transform ? (mViewProj * *cmd.transform) : mViewProj;
+	mClip.resize(cmd.count);
+	for (uint32_t i = 0; i < cmd.count; ++i) {
+		const GfxVertex& v = src[cmd.first + i];
+		const Float4 c = ::transform(m, v.position);
+		mClip[i] = {
+			c.x, c.y, c.z, c.w,
+			v.uv.x, v.uv.y,
+			static_cast<float>((v.color >> 16) & 0xFFU), static_cast<float>((v.color >> 8) & 0xFFU),
+			static_cast<float>(v.color & 0xFFU), static_cast<float>(v.color >> 24)
+		};
+	}
+
+	if (cmd.primitive == Primitive::TriangleStrip) {
+		for (uint32_t i = 0; i + 2U < cmd.count; ++i) {
+			clipTriangle(mClip[i], mClip[i + 1U], mClip[i + 2U]);
+		}
+		mStats.trianglesSubmitted += cmd.count - 2U;
+	} else {
+		for (uint32_t i = 0; i + 2U < cmd.count; i += 3U) {
+			clipTriangle(mClip[i], mClip[i + 1U], mClip[i + 2U]);
+		}
+		mStats.trianglesSubmitted += cmd.count / 3U;
+	}
+
+	++mStats.draws;
+	mStats.binMs += elapsedMs(start);
+}
+
+//----------------------------------------------------------------
+
+void GBESoftware::clipTriangle(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c) {
+	// Trivially outside one of the side planes
+	if ((a.x > a.w && b.x > b.w && c.x > c.w)
+	|| (a.x < -a.w && b.x < -b.w && c.x < -c.w)
+	|| (a.y > a.w && b.y > b.w && c.y > c.w)
+	|| (a.y < -a.w && b.y < -b.w && c.y < -c.w)) {
+		return;
+	}
+
+	auto lerp = [](const ClipVertex& p, const ClipVertex& q, float t) {
+		auto mix = [t](float x, float y) { return x + (y - x) * t; };
+		return ClipVertex{
+			mix(p.x, q.x), mix(p.y, q.y), mix(p.z, q.z), mix(p.w, q.w),
+			mix(p.u, q.u), mix(p.v, q.v),
+			mix(p.r, q.r), mix(p.g, q.g), mix(p.b, q.b), mix(p.a, q.a)
+		};
+	};
+
+	// Clip against the near plane (z >= -w)
+	const ClipVertex* v[3] = { &a, &b, &c };
+	ClipVertex poly[4];
+	size_t n = 0;
+	for (size_t k = 0; k < 3; ++k) {
+		const ClipVertex& p = *v[k];
+		const ClipVertex& q = *v[(k + 1U) % 3U];
+		const float dp = p.z + p.w;
+		const float dq = q.z + q.w;
+		if (dp >= 0.0f) {
+			poly[n++] = p;
+		}
+		if ((dp >= 0.0f) != (dq >= 0.0f)) {
+			poly[n++] = lerp(p, q, dp / (dp - dq));
+		}
+	}
+
+	for (size_t k = 1; k + 1U < n; ++k) {
+		setupTriangle(poly[0], poly[k], poly[k + 1U]);
+	}
+}
+
+void GBESoftware::setupTriangle(const ClipVertex& va, const ClipVertex& vb, const ClipVertex& vc) {
+	const float width = static_cast<float>(mTarget->width());
+	const float height = static_cast<float>(mTarget->height());
+
+	// Screen position, depth and 1/w per vertex
+	struct Projected {
+		float		x, y, z, invW;
+		float		attr[6];
+	};
+	auto project = [&](const ClipVertex& c) {
+		const float invW = 1.0f / c.w;
+		return Projected{
+			(c.x * invW + 1.0f) * 0.5f * width, (1.0f - c.y * invW) * 0.5f * height, c.z * invW * 0.5f + 0.5f, invW,
+			{ c.u * invW, c.v * invW, c.r * invW, c.g * invW, c.b * invW, c.a * invW }
+		};
+	};
+
+	Projected a = project(va), b = project(vb), c = project(vc);
+	float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	if (!(std::fabs(area) > 1.0e-8f)) {
+		return;
+	}
+	if (area < 0.0f) {
+		std::swap(b, c);
+		area = -area;
+	}
+
+	// Bounds clamped to the target in float, a vertex far off screen can exceed int32
+	const int32_t w = static_cast<int32_t>(mTarget->width());
+	const int32_t h = static_cast<int32_t>(mTarget->height());
+	SetupTri tri;
+	tri.x0 = clampToInt(std::floor(std::min({ a.x, b.x, c.x })), 0, w);
+	tri.y0 = clampToInt(std::floor(std::min({ a.y, b.y, c.y })), 0, h);
+	tri.x1 = clampToInt(std::ceil(std::max({ a.x, b.x, c.x })), -1, w - 1);
+	tri.y1 = clampToInt(std::ceil(std::max({ a.y, b.y, c.y })), -1, h - 1);
+	if (tri.x0 > tri.x1 || tri.y0 > tri.y1) {
+		return;
+	}
+
+	// Edge functions E(x, y) = A*x + B*y + C, >= 0 inside
+	const Projected* from[3] = { &a, &b, &c };
+	const Projected* to[3] = { &b, &c, &a };
+	tri.topLeft = 0;
+	for (uint32_t e = 0; e < 3; ++e) {
+		const float ea = from[e]->y - to[e]->y;
+		const float eb = to[e]->x - from[e]->x;
+		tri.edgeA[e] = ea;
+		tri.edgeB[e] = eb;
+		tri.edgeC[e] = -(ea * from[e]->x + eb * from[e]->y);
+
+		// Pixels exactly on an edge belong to the triangle only for top and left edges
+		tri.topLeft |= (ea > 0.0f || (ea == 0.0f && eb > 0.0f)) ? (1U << e) : 0U;
+	}
+
+	// Attribute planes from the barycentric weights: edge 1 is opposite a, 2 opposite b, 0 opposite c
+	const float invArea = 1.0f / area;
+	auto gradient = [&](float fa, float fb, float fc) {
+		return Gradient{
+			(tri.edgeA[1] * fa + tri.edgeA[2] * fb + tri.edgeA[0] * fc) * invArea,
+			(tri.edgeB[1] * fa + tri.edgeB[2] * fb + tri.edgeB[0] * fc) * invArea,
+			(tri.edgeC[1] * fa + tri.edgeC[2] * fb + tri.edgeC[0] * fc) * invArea
+		};
+	};
+	tri.z = gradient(a.z, b.z, c.z);
+	tri.invW = gradient(a.invW, b.invW, c.invW);
+	for (uint32_t i = 0; i < 6; ++i) {
+		tri.attr[i] = gradient(a.attr[i], b.attr[i], c.attr[i]);
+	}
+	tri.state = static_cast<uint32_t>(mStates.size() - 1U);
+
+	// Bin into every tile the triangle touches
+	const uint32_t index = static_cast<uint32_t>(mTris.size());
+	mTris.push_back(tri);
+	++mStats.trianglesBinned;
+
+	const uint32_t tx0 = static_cast<uint32_t>(tri.x0) / TILE_WIDTH, tx1 = static_cast<uint32_t>(tri.x1) / TILE_WIDTH;
+	const uint32_t ty0 = static_cast<uint32_t>(tri.y0) / TILE_HEIGHT, ty1 = static_cast<uint32_t>(tri.y1) / TILE_HEIGHT;
+	const bool single = (tx0 == tx1) || (ty0 == ty1);
+	for (uint32_t ty = ty0; ty <= ty1; ++ty) {
+		for (uint32_t tx = tx0; tx <= tx1; ++tx) {
+			if (!single) {
+				// Skip tiles entirely outside one edge, tested at the tile corner that maximizes it
+				bool outside = false;
+				for (uint32_t e = 0; e < 3 && !outside; ++e) {
+					const float cx = static_cast<float>(tx * TILE_WIDTH) + ((tri.edgeA[e] > 0.0f) ? TILE_WIDTH - 0.5f : 0.5f);
+					const float cy = static_cast<float>(ty * TILE_HEIGHT) + ((tri.edgeB[e] > 0.0f) ? TILE_HEIGHT - 0.5f : 0.5f);
+					outside = (tri.edgeA[e] * cx + tri.edgeB[e] * cy + tri.edgeC[e]) < 0.0f;
+				}
+				if (outside) {
+					continue;
+				}
+			}
+			mTileBins[static_cast<size_t>(ty) * mTilesX + tx].push_back(index);
+			++mStats.binEntries;
+		}
+	}
+}
+
+//----------------------------------------------------------------
+
+void GBESoftware::rasterizeTile(uint32_t tile) noexcept {
+	const int32_t tileX = static_cast<int32_t>((tile % mTilesX) * TILE_WIDTH);
+	const int32_t tileY = static_cast<int32_t>((tile / mTilesX) * TILE_HEIGHT);
+
+	// On-chip tile buffers
+	alignas(16) float depth[TILE_WIDTH * TILE_HEIGHT];
+	alignas(16) uint32_t color[TILE_WIDTH * TILE_HEIGHT];
+	std::fill_n(depth, TILE_WIDTH * TILE_HEIGHT, 1.0f);
+	std::fill_n(color, TILE_WIDTH * TILE_HEIGHT, mClearColor);
+
+	const SimdFloat4 laneOffsets = simdSet(0.5f, 1.5f, 2.5f, 3.5f);
+	const SimdFloat4 zero = simdSplat(0.0f);
+	const SimdFloat4 allSet = simdCmpGe(zero, zero);
+	uint64_t fragments = 0;
+
+	for (uint32_t index : mTileBins[tile]) {
+		const SetupTri& tri = mTris[index];
+		const DrawState& state = mStates[tri.state];
+		const Sampler sampler(state.texture);
+
+		// Pixel range inside the tile, x aligned down to the SIMD width
+		const int32_t x0 = std::max(tileX, tri.x0) & ~3;
+		const int32_t x1 = std::min(tileX + static_cast<int32_t>(TILE_WIDTH) - 1, tri.x1);
+		const int32_t y0 = std::max(tileY, tri.y0);
+		const int32_t y1 = std::min(tileY + static_cast<int32_t>(TILE_HEIGHT) - 1, tri.y1);
+		if (x0 > x1 || y0 > y1) {
+			continue;
+		}
+
+		SimdFloat4 edgeA[3], edgeB[3], edgeC[3], edgeStep[3], topLeft[3];
+		for (uint32_t e = 0; e < 3; ++e) {
+			edgeA[e] = simdSplat(tri.edgeA[e]);
+			edgeB[e] = simdSplat(tri.edgeB[e]);
+			edgeC[e] = simdSplat(tri.edgeC[e]);
+			edgeStep[e] = simdSplat(tri.edgeA[e] * 4.0f);
+			topLeft[e] = (tri.topLeft & (1U << e)) ? allSet : zero;
+		}
+
+		const SimdFloat4 four = simdSplat(4.0f);
+
+		for (int32_t y = y0; y <= y1; ++y) {
+			// Narrow the row to the span between the edges (padded a pixel, the SIMD test is exact)
+			const float fy = static_cast<float>(y) + 0.5f;
+			float spanMin = static_cast<float>(x0);
+			float spanMax = static_cast<float>(x1);
+			for (uint32_t e = 0; e < 3; ++e) {
+				const float rest = tri.edgeB[e] * fy + tri.edgeC[e];
+				if (tri.edgeA[e] > 0.0f) {
+					spanMin = std::max(spanMin, -rest / tri.edgeA[e] - 1.5f);
+				} else if (tri.edgeA[e] < 0.0f) {
+					spanMax = std::min(spanMax, -rest / tri.edgeA[e] + 0.5f);
+				} else if (rest < 0.0f) {
+					spanMax = -1.0f;
+				}
+			}
+			if (!(spanMin <= spanMax)) {
+				continue;
+			}
+			const int32_t sx0 = static_cast<int32_t>(spanMin) & ~3;
+			const int32_t sx1 = static_cast<int32_t>(spanMax);
+
+			const SimdFloat4 py = simdSplat(fy);
+			SimdFloat4 px = simdSplat(static_cast<float>(sx0)) + laneOffsets;
+			SimdFloat4 e0 = edgeA[0] * px + edgeB[0] * py + edgeC[0];
+			SimdFloat4 e1 = edgeA[1] * px + edgeB[1] * py + edgeC[1];
+			SimdFloat4 e2 = edgeA[2] * px + edgeB[2] * py + edgeC[2];
+			const size_t row = static_cast<size_t>(y - tileY) * TILE_WIDTH;
+
+			for (int32_t x = sx0; x <= sx1; x += 4) {
+				const SimdFloat4 inside =
+					(simdCmpLt(zero, e0) | (simdCmpGe(e0, zero) & topLeft[0]))
+					& (simdCmpLt(zero, e1) | (simdCmpGe(e1, zero) & topLeft[1]))
+					& (simdCmpLt(zero, e2) | (simdCmpGe(e2, zero) & topLeft[2]));
+
+				if (simdMoveMask(inside)) {
+					const size_t offset = row + static_cast<size_t>(x - tileX);
+					const SimdFloat4 z = simdSplat(tri.z.dx) * px + simdSplat(tri.z.dy) * py + simdSplat(tri.z.c);
+					const int pass = simdMoveMask(inside & simdCmpLe(z, simdLoad(depth + offset)));
+
+					if (pass) {
+						// Perspective-correct attributes for the four lanes
+						const SimdFloat4 invW = simdSplat(tri.invW.dx) * px + simdSplat(tri.invW.dy) * py + simdSplat(tri.invW.c);
+						const SimdFloat4 w = simdSplat(1.0f) / invW;
+						alignas(16) float lanes[7][4];
+						simdStore(lanes[6], z);
+						for (uint32_t i = 0; i < 6; ++i) {
+							const Gradient& g = tri.attr[i];
+							simdStore(lanes[i], (simdSplat(g.dx) * px + simdSplat(g.dy) * py + simdSplat(g.c)) * w);
+						}
+
+						for (uint32_t lane = 0; lane < 4; ++lane) {
+							if (!(pass & (1 << lane))) {
+								continue;
+							}
+
+							uint32_t r = toByte(lanes[2][lane]);
+							uint32_t g = toByte(lanes[3][lane]);
+							uint32_t b = toByte(lanes[4][lane]);
+							uint32_t a = toByte(lanes[5][lane]);
+							if (sampler.texels) {
+								const uint32_t t = sampler.fetch(lanes[0][lane], lanes[1][lane]);
+								r = mul255(r, (t >> 16) & 0xFFU);
+								g = mul255(g, (t >> 8) & 0xFFU);
+								b = mul255(b, t & 0xFFU);
+								a = mul255(a, t >> 24);
+							}
+
+							const size_t p = offset + lane;
+							if (state.list == RenderList::Translucent) {
+								const uint32_t d = color[p];
+								const uint32_t ia = 255U - a;
+								r = mul255(r, a) + mul255((d >> 16) & 0xFFU, ia);
+								g = mul255(g, a) + mul255((d >> 8) & 0xFFU, ia);
+								b = mul255(b, a) + mul255(d & 0xFFU, ia);
+								a = a + mul255(d >> 24, ia);
+							} else {
+								if (state.list == RenderList::PunchThrough && a < 128U) {
+									continue;
+								}
+								depth[p] = lanes[6][lane];
+							}
+							color[p] = (a << 24) | (r << 16) | (g << 8) | b;
+							++fragments;
+						}
+					}
+				}
+
+				e0 = e0 + edgeStep[0];
+				e1 = e1 + edgeStep[1];
+				e2 = e2 + edgeStep[2];
+				px = px + four;
+			}
+		}
+	}
+
+	// Write the tile out
+	const uint32_t fbWidth = mTarget->width();
+	const uint32_t fbHeight = mTarget->height();
+	const uint32_t columns = std::min(TILE_WIDTH, fbWidth - static_cast<uint32_t>(tileX));
+	const uint32_t rows = std::min(TILE_HEIGHT, fbHeight - static_cast<uint32_t>(tileY));
+	uint32_t* out = mTarget->pixels() + static_cast<size_t>(tileY) * fbWidth + static_cast<size_t>(tileX);
+	for (uint32_t y = 0; y < rows; ++y) {
+		std::memcpy(out + static_cast<size_t>(y) * fbWidth, color + static_cast<size_t>(y) * TILE_WIDTH, columns * sizeof(uint32_t));
+	}
+	mTileFragments[tile] = fragments;
+}
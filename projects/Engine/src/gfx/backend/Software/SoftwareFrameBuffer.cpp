@@ -0,0 +1,36 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/backend/Software/SoftwareFrameBuffer.hh>
+
+#include <algorithm>
+
+//================================================================
+
+SoftwareFrameBuffer::SoftwareFrameBuffer(uint32_t width, uint32_t height)
+	: mPixels(static_cast<size_t>(width) * height, 0U)
+	, mWidth(width)
+	, mHeight(height) {
+}
+
+SoftwareFrameBuffer::~SoftwareFrameBuffer() noexcept {}
+
+void SoftwareFrameBuffer::resize(uint32_t width, uint32_t height) {
+	mPixels.assign(static_cast<size_t>(width) * height, 0U);
+	mWidth = width;
+	mHeight = height;
+}
+
+void SoftwareFrameBuffer::clear(uint32_t color) noexcept {
+	std::fill(mPixels.begin(), mPixels.end(), color);
+}
+
+uint64_t SoftwareFrameBuffer::hash() const noexcept {
+	uint64_t h = 14695981039346656037ULL;
+	for (uint32_t p : mPixels) {
+		for (uint32_t i = 0; i < 4; ++i) {
+			h = (h ^ ((p >> (i * 8U)) & 0xFFU)) * 1099511628211ULL;
+		}
+	}
+	return h;
+}
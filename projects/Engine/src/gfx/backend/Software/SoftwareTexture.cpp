@@ -0,0 +1,20 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/backend/Software/SoftwareTexture.hh>
+
+#include <cstring>
+
+//================================================================
+
+SoftwareTexture::SoftwareTexture(uint32_t width, uint32_t height, PixelFormat format, const void* pixels)
+	: mPixels(static_cast<size_t>(width) * height * pixelFormatBytes(format))
+	, mWidth(width)
+	, mHeight(height)
+	, mFormat(format) {
+	if (pixels && !mPixels.empty()) {
+		std::memcpy(mPixels.data(), pixels, mPixels.size());
+	}
+}
+
+SoftwareTexture::~SoftwareTexture() noexcept {}
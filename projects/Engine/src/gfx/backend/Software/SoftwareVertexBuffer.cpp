@@ -0,0 +1,15 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/gfx/backend/Software/SoftwareVertexBuffer.hh>
+
+//================================================================
+
+SoftwareVertexBuffer::SoftwareVertexBuffer(uint32_t count, const GfxVertex* vertices)
+	: mVertices(count) {
+	if (vertices) {
+		mVertices.assign(vertices, vertices + count);
+	}
+}
+
+SoftwareVertexBuffer::~SoftwareVertexBuffer() noexcept {}
@@ -0,0 +1,62 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/io/CaptureFile.hh>
+
+//================================================================
+
+bool CaptureFile::open(const char* path, bool map) {
+	close();
+	if (!mFile.open(path, map)) {
+		return false;
+	}
+	if (!validate()) {
+		close();
+		return false;
+	}
+	const CaptureFileHeader* hdr = reinterpret_cast<const CaptureFileHeader*>(mFile.data());
+	mSections = reinterpret_cast<const CaptureSectionEntry*>(hdr + 1);
+	mCount = hdr->sectionCount;
+	return true;
+}
+
+void CaptureFile::close() noexcept {
+	mFile.close();
+	mSections = nullptr;
+	mCount = 0;
+}
+
+//----------------------------------------------------------------
+
+bool CaptureFile::validate() const noexcept {
+	const size_t size = mFile.size();
+	if (size < sizeof(CaptureFileHeader)) {
+		return false;
+	}
+	const CaptureFileHeader* hdr = reinterpret_cast<const CaptureFileHeader*>(mFile.data());
+	if (hdr->magic != CAPTURE_FILE_MAGIC || hdr->version != CAPTURE_FILE_VERSION || hdr->fileSize != size) {
+		return false;
+	}
+	const size_t tableEnd = sizeof(CaptureFileHeader) + hdr->sectionCount * sizeof(CaptureSectionEntry);
+	if (tableEnd > size) {
+		return false;
+	}
+	const CaptureSectionEntry* entries = reinterpret_cast<const CaptureSectionEntry*>(hdr + 1);
+	for (size_t i = 0; i < hdr->sectionCount; ++i) {
+		const CaptureSectionEntry& e = entries[i];
+		if ((e.offset % CAPTURE_FILE_ALIGNMENT) != 0 || e.offset < tableEnd
+		|| static_cast<size_t>(e.offset) + e.size > size) {
+			return false;
+		}
+	}
+	return true;
+}
+
+const CaptureSectionEntry* CaptureFile::find(CaptureSection type) const noexcept {
+	for (size_t i = 0; i < mCount; ++i) {
+		if (mSections[i].type == static_cast<uint32_t>(type)) {
+			return &mSections[i];
+		}
+	}
+	return nullptr;
+}
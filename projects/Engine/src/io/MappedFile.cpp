@@ -0,0 +1,168 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/io/MappedFile.hh>
+
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+#if defined(__DREAMCAST__)
+// Dreamcast: no file mapping, single aligned read
+#elif defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN		1
+#endif//WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#define DD25_MAPPED_FILE_WIN32	1
+#else
+// macOS, FreeBSD, Linux
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DD25_MAPPED_FILE_POSIX	1
+#endif//Dreamcast, Windows, POSIX
+
+//================================================================
+
+namespace {
+
+// Fallback path: the whole file in one aligned block
+bool readAligned(const char* path, uint8_t*& data, size_t& size) {
+	std::FILE* fp = std::fopen(path, "rb");
+	if (!fp) {
+		return false;
+	}
+	std::fseek(fp, 0, SEEK_END);
+	const long len = std::ftell(fp);
+	std::fseek(fp, 0, SEEK_SET);
+	if (len <= 0) {
+		std::fclose(fp);
+		return false;
+	}
+	const size_t padded = (static_cast<size_t>(len) + MappedFile::ALIGNMENT - 1U) & ~(MappedFile::ALIGNMENT - 1U);
+#if defined(_MSC_VER)
+	uint8_t* block = static_cast<uint8_t*>(_aligned_malloc(padded, MappedFile::ALIGNMENT));
+#else
+	uint8_t* block = static_cast<uint8_t*>(std::aligned_alloc(MappedFile::ALIGNMENT, padded));
+#endif//_MSC_VER
+	if (!block) {
+		std::fclose(fp);
+		return false;
+	}
+	const size_t got = std::fread(block, 1, static_cast<size_t>(len), fp);
+	std::fclose(fp);
+	if (got != static_cast<size_t>(len)) {
+#if defined(_MSC_VER)
+		_aligned_free(block);
+#else
+		std::free(block);
+#endif//_MSC_VER
+		return false;
+	}
+	data = block;
+	size = static_cast<size_t>(len);
+	return true;
+}
+
+} // namespace
+
+//================================================================
+
+MappedFile::~MappedFile() noexcept {
+	close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+	: mData(std::exchange(other.mData, nullptr))
+	, mSize(std::exchange(other.mSize, 0))
+	, mMapped(std::exchange(other.mMapped, false))
+	, mHandle(std::exchange(other.mHandle, nullptr)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this != &other) {
+		close();
+		mData = std::exchange(other.mData, nullptr);
+		mSize = std::exchange(other.mSize, 0);
+		mMapped = std::exchange(other.mMapped, false);
+		mHandle = std::exchange(other.mHandle, nullptr);
+	}
+	return *this;
+}
+
+//----------------------------------------------------------------
+
+bool MappedFile::open(const char* path, bool map) {
+	close();
+#if defined(DD25_MAPPED_FILE_POSIX)
+	const int fd = map ? ::open(path, O_RDONLY) : -1;
+	if (fd >= 0) {
+		struct stat st;
+		if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+			void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+			if (view != MAP_FAILED) {
+				mData = static_cast<uint8_t*>(view);
+				mSize = static_cast<size_t>(st.st_size);
+				mMapped = true;
+			}
+		}
+		::close(fd);
+		if (mMapped) {
+			return true;
+		}
+	}
+#elif defined(DD25_MAPPED_FILE_WIN32)
+	HANDLE file = map ? ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr)
+		: INVALID_HANDLE_VALUE;
+	if (file != INVALID_HANDLE_VALUE) {
+		LARGE_INTEGER len;
+		if (::GetFileSizeEx(file, &len) && len.QuadPart > 0) {
+			HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+			if (mapping) {
+				void* view = ::MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+				if (view) {
+					mData = static_cast<uint8_t*>(view);
+					mSize = static_cast<size_t>(len.QuadPart);
+					mMapped = true;
+					mHandle = mapping;
+				} else {
+					::CloseHandle(mapping);
+				}
+			}
+		}
+		::CloseHandle(file);
+		if (mMapped) {
+			return true;
+		}
+	}
+#else
+	(void)map;
+#endif//POSIX, Win32
+	mMapped = false;
+	return readAligned(path, mData, mSize);
+}
+
+void MappedFile::close() noexcept {
+	if (!mData) {
+		return;
+	}
+	if (mMapped) {
+#if defined(DD25_MAPPED_FILE_POSIX)
+		::munmap(mData, mSize);
+#elif defined(DD25_MAPPED_FILE_WIN32)
+		::UnmapViewOfFile(mData);
+		::CloseHandle(static_cast<HANDLE>(mHandle));
+#endif//POSIX, Win32
+	} else {
+#if defined(_MSC_VER)
+		_aligned_free(mData);
+#else
+		std::free(mData);
+#endif//_MSC_VER
+	}
+	mData = nullptr;
+	mSize = 0;
+	mMapped = false;
+	mHandle = nullptr;
+}
@@ -0,0 +1,75 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/io/SceneFile.hh>
+
+//================================================================
+
+bool SceneFile::open(const char* path, bool map) {
+	close();
+	if (!mFile.open(path, map)) {
+		return false;
+	}
+	if (!validate()) {
+		close();
+		return false;
+	}
+	const SceneFileHeader* hdr = reinterpret_cast<const SceneFileHeader*>(mFile.data());
+	mSections = reinterpret_cast<const SceneSectionEntry*>(hdr + 1);
+	mCount = hdr->sectionCount;
+	return true;
+}
+
+void SceneFile::close() noexcept {
+	mFile.close();
+	mSections = nullptr;
+	mCount = 0;
+}
+
+//----------------------------------------------------------------
+
+bool SceneFile::validate() const noexcept {
+	const size_t size = mFile.size();
+	if (size < sizeof(SceneFileHeader)) {
+		return false;
+	}
+	const SceneFileHeader* hdr = reinterpret_cast<const SceneFileHeader*>(mFile.data());
+	if (hdr->magic != SCENE_FILE_MAGIC || hdr->version != SCENE_FILE_VERSION || hdr->fileSize != size) {
+		return false;
+	}
+	const size_t tableEnd = sizeof(SceneFileHeader) + hdr->sectionCount * sizeof(SceneSectionEntry);
+	if (tableEnd > size) {
+		return false;
+	}
+	const SceneSectionEntry* entries = reinterpret_cast<const SceneSectionEntry*>(hdr + 1);
+	for (size_t i = 0; i < hdr->sectionCount; ++i) {
+		const SceneSectionEntry& e = entries[i];
+		if ((e.offset % SCENE_FILE_ALIGNMENT) != 0 || e.offset < tableEnd
+		|| static_cast<size_t>(e.offset) + e.size > size) {
+			return false;
+		}
+	}
+	return true;
+}
+
+const SceneSectionEntry* SceneFile::find(SceneSection type) const noexcept {
+	for (size_t i = 0; i < mCount; ++i) {
+		if (mSections[i].type == static_cast<uint32_t>(type)) {
+			return &mSections[i];
+		}
+	}
+	return nullptr;
+}
+
+const char* SceneFile::lookup(StringId id) const noexcept {
+	size_t count = 0;
+	size_t bytes = 0;
+	const SceneStringRecord* table = section<SceneStringRecord>(SceneSection::StringTable, count);
+	const char* strings = section<char>(SceneSection::Strings, bytes);
+	for (size_t i = 0; i < count; ++i) {
+		if (table[i].id == id && table[i].offset < bytes) {
+			return strings + table[i].offset;
+		}
+	}
+	return nullptr;
+}
@@ -0,0 +1,49 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/scene/Camera.hh>
+
+//================================================================
+
+Camera::Camera()
+	: mPos{ 0.0f, 0.0f, 0.0f }
+	, mView(Float4x4::identity())
+	, mProj(Float4x4::identity())
+	, mViewProj(Float4x4::identity())
+	, mFrustum{}
+	, mFovY(1.0471976f)	// 60 degrees
+	, mProjScale(0.0f)
+	, mWidth(640)
+	, mHeight(480) {
+	setPerspective(mFovY, static_cast<float>(mWidth) / static_cast<float>(mHeight), 0.1f, 1000.0f);
+}
+
+Camera::~Camera() noexcept {}
+
+//----------------------------------------------------------------
+
+void Camera::setPerspective(float fovY, float aspect, float zNear, float zFar) noexcept {
+	mFovY = fovY;
+	mProj = perspective(fovY, aspect, zNear, zFar);
+	updateDerived();
+}
+
+void Camera::lookAt(const Float3& eye, const Float3& target, const Float3& up) noexcept {
+	mPos = eye;
+	mView = ::lookAt(eye, target, up);
+	updateDerived();
+}
+
+void Camera::setViewportSize(uint16_t width, uint16_t height) noexcept {
+	mWidth = width;
+	mHeight = height;
+	updateDerived();
+}
+
+//----------------------------------------------------------------
+
+void Camera::updateDerived() noexcept {
+	mViewProj = mProj * mView;
+	mFrustum = Frustum::fromMatrix(mViewProj);
+	mProjScale = (0.5f * static_cast<float>(mHeight)) / std::tan(mFovY * 0.5f);
+}
@@ -0,0 +1,204 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/scene/CellVisibility.hh>
+
+#include <utility>
+
+//================================================================
+
+namespace {
+
+constexpr size_t MAX_POLY = 4U + Frustum::MAX_PLANES + 4U;
+
+// Sutherland-Hodgman against one plane, returns the new vertex count
+size_t clipPolygon(const Float3* in, size_t count, const Plane& plane, Float3* out) noexcept {
+	size_t n = 0;
+	for (size_t i = 0; i < count; ++i) {
+		const Float3& a = in[i];
+		const Float3& b = in[(i + 1U) % count];
+		const float da = plane.distance(a);
+		const float db = plane.distance(b);
+		if (da >= 0.0f) {
+			out[n++] = a;
+		}
+		if ((da >= 0.0f) != (db >= 0.0f)) {
+			out[n++] = a + (b - a) * (da / (da - db));
+		}
+	}
+	return n;
+}
+
+} // namespace
+
+//================================================================
+
+void CellVisibility::clear() noexcept {
+	mCells.clear();
+	mPortals.clear();
+	mPvs.clear();
+	mRowWords = 0;
+	mVisits.clear();
+	mEntries.clear();
+}
+
+bool CellVisibility::validate(const VisCell* cells, size_t cellCount, const VisPortal* portals, size_t portalCount) noexcept {
+	for (size_t i = 0; i < cellCount; ++i) {
+		if (uint64_t(cells[i].firstPortal) + cells[i].portalCount > portalCount) {
+			return false;
+		}
+	}
+	for (size_t i = 0; i < portalCount; ++i) {
+		if (portals[i].target >= cellCount) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void CellVisibility::assign(std::vector<VisCell>&& cells, std::vector<VisPortal>&& portals, std::vector<uint32_t>&& pvs) {
+	mCells = std::move(cells);
+	mPortals = std::move(portals);
+	mPvs = std::move(pvs);
+	mRowWords = rowWords(mCells.size());
+	mPvs.resize(mCells.size() * mRowWords, 0U);
+	mVisits.assign(mCells.size(), { 0U, INVALID_CELL });
+	mGeneration = 0;
+}
+
+uint32_t CellVisibility::findCell(const Float3& p) const noexcept {
+	const size_t count = mCells.size();
+	for (size_t i = 0; i < count; ++i) {
+		if (mCells[i].bounds.contains(p)) {
+			return static_cast<uint32_t>(i);
+		}
+	}
+	return INVALID_CELL;
+}
+
+//----------------------------------------------------------------
+
+bool CellVisibility::gatherVisible(uint32_t cameraCell, const Float3& eye, const Frustum& view, std::vector<VisibleCell>& out) const {
+	if (cameraCell >= mCells.size()) {
+		return false;
+	}
+	if (++mGeneration == 0) {
+		// Wrapped, forget every stale visit
+		mVisits.assign(mCells.size(), { 0U, INVALID_CELL });
+		mGeneration = 1;
+	}
+	mEntries.clear();
+	mOutBase = out.size();
+
+	uint32_t path[MAX_DEPTH];
+	walk(cameraCell, eye, view, cameraCell, 0, path, out);
+	return true;
+}
+
+//
+// Narrowed frusta all share the eye as apex, so a new view through
+// `poly` is inside an earlier frustum when every corner of the opening
+// is. The far plane is common to both and skipped.
+//
+bool CellVisibility::alreadySeen(uint32_t cell, const Float3* poly, size_t count, size_t depth,
+	const std::vector<VisibleCell>& out) const noexcept {
+	const CellVisit& visit = mVisits[cell];
+	if (visit.generation != mGeneration) {
+		return false;
+	}
+	for (uint32_t e = visit.latest; e != INVALID_CELL; e = mEntries[e].previous) {
+		if (mEntries[e].depth > depth) {
+			continue;	// Reached deeper, its walk may have stopped at MAX_DEPTH sooner
+		}
+		const Frustum& seen = out[mOutBase + e].frustum;
+		bool inside = true;
+		for (uint32_t i = 0; i + 1U < seen.count && inside; ++i) {
+			for (size_t v = 0; v < count; ++v) {
+				if (seen.planes[i].distance(poly[v]) < -1.0e-4f) {
+					inside = false;
+					break;
+				}
+			}
+		}
+		if (inside) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//
+// The last plane of every frustum is the far plane, narrowed frusta carry
+// it along so distance culling still applies beyond portals.
+//
+void CellVisibility::walk(uint32_t cell, const Float3& eye, const Frustum& frustum, uint32_t cameraCell,
+	size_t depth, uint32_t* path, std::vector<VisibleCell>& out) const {
+	// Chain the entry onto the cell's earlier ones
+	CellVisit& visit = mVisits[cell];
+	const uint32_t entry = static_cast<uint32_t>(out.size() - mOutBase);
+	mEntries.push_back({ (visit.generation == mGeneration) ? visit.latest : INVALID_CELL, static_cast<uint32_t>(depth) });
+	visit = { mGeneration, entry };
+	out.push_back({ cell, frustum });
+
+	if (depth >= MAX_DEPTH) {
+		return;
+	}
+	path[depth] = cell;
+
+	const VisCell& c = mCells[cell];
+	for (uint32_t p = 0; p < c.portalCount; ++p) {
+		const VisPortal& portal = mPortals[c.firstPortal + p];
+		const uint32_t target = portal.target;
+
+		// O(1) reject before any geometry work
+		if (!potentiallyVisible(cameraCell, target)) {
+			continue;
+		}
+		bool onPath = false;
+		for (size_t i = 0; i <= depth; ++i) {
+			onPath |= (path[i] == target);
+		}
+		if (onPath) {
+			continue;
+		}
+
+		// Clip the opening to what is still visible
+		Float3 bufA[MAX_POLY], bufB[MAX_POLY];
+		size_t n = 4;
+		for (size_t i = 0; i < 4U; ++i) {
+			bufA[i] = portal.verts[i];
+		}
+		Float3* src = bufA;
+		Float3* dst = bufB;
+		for (uint32_t i = 0; i < frustum.count && n >= 3U; ++i) {
+			n = clipPolygon(src, n, frustum.planes[i], dst);
+			std::swap(src, dst);
+		}
+		if (n < 3U || alreadySeen(target, src, n, depth + 1U, out)) {
+			continue;
+		}
+
+		Float3 centroid = { 0.0f, 0.0f, 0.0f };
+		for (size_t i = 0; i < n; ++i) {
+			centroid = centroid + src[i];
+		}
+		centroid = centroid * (1.0f / static_cast<float>(n));
+
+		// Portal plane, facing away from the eye
+		const Plane opening = Plane::through(portal.verts[0], portal.verts[1], portal.verts[2], eye);
+		const float eyeDist = opening.distance(eye);
+		if (eyeDist < 1.0e-3f || (n + 2U) > Frustum::MAX_PLANES) {
+			// Standing in the opening (or too many edges), keep the current frustum
+			walk(target, eye, frustum, cameraCell, depth + 1U, path, out);
+			continue;
+		}
+
+		Frustum narrowed = {};
+		for (size_t i = 0; i < n; ++i) {
+			narrowed.planes[narrowed.count++] = Plane::through(eye, src[i], src[(i + 1U) % n], centroid);
+		}
+		narrowed.planes[narrowed.count++] = { -opening.n, -opening.d };
+		narrowed.planes[narrowed.count++] = frustum.planes[frustum.count - 1U];
+		walk(target, eye, narrowed, cameraCell, depth + 1U, path, out);
+	}
+}
@@ -0,0 +1,216 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/scene/FramePipeline.hh>
+
+#include <chrono>
+#include <memory>
+
+#if DD25_JOBS_THREADED
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif//DD25_JOBS_THREADED
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline float elapsedMs(Clock::time_point start) noexcept {
+	return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+//================================================================
+
+//
+// Packet `frame % PACKETS` carries frame `frame`. The simulation may
+// take it once every frame before `frame - PACKETS + 1` has rendered,
+// the render side takes packets strictly in submission order.
+//
+struct FramePipeline::Impl {
+	std::unique_ptr<FramePacket>	packets[PACKETS];
+	uint64_t						submitted	= 0;
+	uint64_t						rendered	= 0;
+	Clock::time_point				building;	// When the open packet was handed out
+	FramePipelineStats				stats		= {};
+#if DD25_JOBS_THREADED
+	std::thread						thread;
+	std::mutex						lock;		// Guards the counters and stats
+	std::condition_variable			ready;		// Render side: a packet was submitted
+	std::condition_variable			freed;		// Simulation: a packet was rendered
+	bool							quit		= false;
+#endif//DD25_JOBS_THREADED
+};
+
+//================================================================
+
+FramePipeline::FramePipeline(RenderFn render, const FramePipelineSettings& settings)
+	: mSettings(settings)
+	, mRender(std::move(render))
+	, mBuilding(nullptr)
+	, mFrame(0)
+	, mImpl(std::make_unique<Impl>()) {
+	for (std::unique_ptr<FramePacket>& packet : mImpl->packets) {
+		packet = std::make_unique<FramePacket>(mSettings.maxCommands, mSettings.arenaBytes);
+	}
+
+#if DD25_JOBS_THREADED
+	if (!mSettings.threaded) {
+		return;
+	}
+	mImpl->thread = std::thread([this] {
+		Impl& impl = *mImpl;
+		for (;;) {
+			FramePacket* packet = nullptr;
+			const Clock::time_point idle = Clock::now();
+			{
+				std::unique_lock<std::mutex> guard(impl.lock);
+				impl.ready.wait(guard, [&] { return impl.quit || impl.rendered < impl.submitted; });
+				if (impl.rendered == impl.submitted) {
+					return;		// Quit with nothing left to draw
+				}
+				packet = impl.packets[impl.rendered % PACKETS].get();
+			}
+			const float waitMs = elapsedMs(idle);
+
+			// The packet is ours until `rendered` moves past it
+			const float renderMs = this->render(*packet);
+
+			{
+				std::lock_guard<std::mutex> guard(impl.lock);
+				++impl.rendered;
+				impl.stats.rendered = impl.rendered;
+				impl.stats.renderMs = renderMs;
+				impl.stats.renderWaitMs = waitMs;
+			}
+			impl.freed.notify_all();
+		}
+	});
+#else
+	mSettings.threaded = false;
+#endif//DD25_JOBS_THREADED
+}
+
+FramePipeline::~FramePipeline() noexcept {
+#if DD25_JOBS_THREADED
+	if (mImpl->thread.joinable()) {
+		{
+			std::lock_guard<std::mutex> guard(mImpl->lock);
+			mImpl->quit = true;
+		}
+		mImpl->ready.notify_all();
+		mImpl->thread.join();	// Drains what was submitted first
+	}
+#endif//DD25_JOBS_THREADED
+}
+
+bool FramePipeline::threaded() const noexcept {
+#if DD25_JOBS_THREADED
+	return mImpl->thread.joinable();
+#else
+	return false;
+#endif//DD25_JOBS_THREADED
+}
+
+float FramePipeline::render(FramePacket& packet) {
+	const Clock::time_point start = Clock::now();
+	if (mRender) {
+		mRender(packet);
+	}
+	if (mSettings.stream && packet.streamFence) {
+		mSettings.stream->retire(packet.streamFence);
+	}
+	return elapsedMs(start);
+}
+
+FramePacket& FramePipeline::acquire() {
+	if (mBuilding) {
+		return *mBuilding;
+	}
+
+#if DD25_JOBS_THREADED
+	if (threaded()) {
+		// The packet's previous frame has to be off the render side
+		const Clock::time_point start = Clock::now();
+		std::unique_lock<std::mutex> guard(mImpl->lock);
+		mImpl->freed.wait(guard, [&] { return mFrame < mImpl->rendered + PACKETS; });
+		mImpl->stats.simulateWaitMs = elapsedMs(start);
+	}
+#endif//DD25_JOBS_THREADED
+
+	FramePacket& packet = *mImpl->packets[mFrame % PACKETS];
+	packet.frame = mFrame;
+	packet.visible.clear();
+	packet.transforms.clear();
+	packet.queue.reset();
+	packet.streamFence = 0;
+	packet.simulateMs = 0.0f;
+	if (mSettings.stream) {
+		mSettings.stream->beginFrame();
+	}
+
+	mBuilding = &packet;
+	mImpl->building = Clock::now();
+	return packet;
+}
+
+void FramePipeline::submit() {
+	if (!mBuilding) {
+		return;
+	}
+	FramePacket& packet = *mBuilding;
+	mBuilding = nullptr;
+	++mFrame;
+
+	if (mSettings.stream) {
+		packet.streamFence = mSettings.stream->endFrame();
+	}
+	packet.queue.sort();
+	packet.simulateMs = elapsedMs(mImpl->building);
+
+#if DD25_JOBS_THREADED
+	if (threaded()) {
+		{
+			std::lock_guard<std::mutex> guard(mImpl->lock);
+			++mImpl->submitted;
+			mImpl->stats.submitted = mImpl->submitted;
+			mImpl->stats.simulateMs = packet.simulateMs;
+		}
+		mImpl->ready.notify_one();
+		return;
+	}
+#endif//DD25_JOBS_THREADED
+
+	// Sequential: the same frame, one side after the other
+	++mImpl->submitted;
+	const float renderMs = render(packet);
+	++mImpl->rendered;
+	mImpl->stats.submitted = mImpl->submitted;
+	mImpl->stats.rendered = mImpl->rendered;
+	mImpl->stats.simulateMs = packet.simulateMs;
+	mImpl->stats.renderMs = renderMs;
+	mImpl->stats.renderWaitMs = 0.0f;
+}
+
+void FramePipeline::flush() {
+#if DD25_JOBS_THREADED
+	if (threaded()) {
+		std::unique_lock<std::mutex> guard(mImpl->lock);
+		mImpl->freed.wait(guard, [&] { return mImpl->rendered == mImpl->submitted; });
+	}
+#endif//DD25_JOBS_THREADED
+}
+
+FramePipelineStats FramePipeline::stats() const {
+#if DD25_JOBS_THREADED
+	if (threaded()) {
+		std::lock_guard<std::mutex> guard(mImpl->lock);
+		return mImpl->stats;
+	}
+#endif//DD25_JOBS_THREADED
+	return mImpl->stats;
+}
@@ -0,0 +1,74 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/scene/Mesh.hh>
+#include <Engine/gfx/IVertexBuffer.hh>
+
+#include <cstring>
+
+//================================================================
+
+static_assert(sizeof(Vertex) == sizeof(Float3), "Float3 arrays are bound as Vertex arrays");
+static_assert(sizeof(UV) == sizeof(Float2), "Float2 arrays are bound as UV arrays");
+
+//================================================================
+
+Mesh::Mesh()
+	: mLen(0)
+	, mVerts(nullptr)
+	, mWeights(nullptr)
+	, mNormals(nullptr)
+	, mUVs(nullptr)
+	, mIDs(nullptr)
+	, mIndexCount(0)
+	, mDrawBuffer(nullptr)
+	, mDrawFirst{} {
+	std::memset(&mObjMatrix, 0, sizeof(mObjMatrix));
+}
+
+Mesh::~Mesh() noexcept {}
+
+//----------------------------------------------------------------
+
+void Mesh::bind(size_t vertexCount, const Float3* positions, const Float3* normals, const Float2* uvs,
+	const uint16_t* indices, size_t indexCount) noexcept {
+	// Mapped scene data is copy-on-write, the casts never write through
+	mLen = vertexCount;
+	mVerts = reinterpret_cast<Vertex*>(const_cast<Float3*>(positions));
+	mNormals = reinterpret_cast<shz_vec3*>(const_cast<Float3*>(normals));
+	mUVs = reinterpret_cast<UV*>(const_cast<Float2*>(uvs));
+	mIDs = const_cast<uint16_t*>(indices);
+	mIndexCount = indexCount;
+}
+
+void Mesh::expandLevels(std::vector<GfxVertex>& out, uint32_t color) {
+	const Float3* pos = positions();
+	const Float2* uv = uvs();
+	auto emit = [&](const uint16_t* ids, size_t count) {
+		for (size_t i = 0; i < count; ++i) {
+			const uint16_t v = ids[i];
+			out.push_back({ pos[v], color, uv ? uv[v] : Float2{ 0.0f, 0.0f } });
+		}
+	};
+
+	const size_t levels = mLods.levelCount();
+	if (levels == 0) {
+		mDrawFirst[0] = static_cast<uint32_t>(out.size());
+		emit(mIDs, mIndexCount);
+		return;
+	}
+	for (size_t i = 0; i < levels; ++i) {
+		mDrawFirst[i] = static_cast<uint32_t>(out.size());
+		emit(mLods.indices(i), mLods.level(i).indexCount);
+	}
+}
+
+void Mesh::setDrawBuffer(const IVertexBuffer* buffer, const uint32_t* levelFirst, size_t levels) noexcept {
+	mDrawBuffer = buffer;
+	if (!levelFirst) {
+		return;
+	}
+	for (size_t i = 0; i < levels && i < MeshLodChain::MAX_LEVELS; ++i) {
+		mDrawFirst[i] = levelFirst[i];
+	}
+}
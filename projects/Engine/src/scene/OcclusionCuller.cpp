@@ -0,0 +1,357 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/scene/OcclusionCuller.hh>
+#include <Engine/core/Jobs.hh>
+#include <Engine/math/Geometry.hh>
+#include <Engine/math/simd.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+inline float elapsedMs(Clock::time_point start) noexcept {
+	return static_cast<float>(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+}
+
+// Clip-space vertex
+struct ClipVert {
+	float		x, y, z, w;
+};
+
+inline ClipVert lerp(const ClipVert& a, const ClipVert& b, float t) noexcept {
+	return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t };
+}
+
+} // namespace
+
+//================================================================
+
+OcclusionCuller::OcclusionCuller()
+	: mViewProj(Float4x4::identity())
+	, mWidth(0)
+	, mHeight(0)
+	, mTilesX(0)
+	, mTilesY(0)
+	, mBlocksX(0)
+	, mStats{} {
+	setResolution(256U, 128U);
+}
+
+OcclusionCuller::~OcclusionCuller() noexcept {}
+
+//----------------------------------------------------------------
+
+void OcclusionCuller::setResolution(uint32_t width, uint32_t height) {
+	mTilesX = std::max(1U, (width + TILE_WIDTH - 1U) / TILE_WIDTH);
+	mTilesY = std::max(1U, (height + TILE_HEIGHT - 1U) / TILE_HEIGHT);
+	mWidth = mTilesX * TILE_WIDTH;
+	mHeight = mTilesY * TILE_HEIGHT;
+	mBlocksX = mWidth / BLOCK_SIZE;
+	mDepth.assign(static_cast<size_t>(mWidth) * mHeight, 1.0f);
+	mHiZ.assign(static_cast<size_t>(mBlocksX) * (mHeight / BLOCK_SIZE), 1.0f);
+	mTileBins.resize(static_cast<size_t>(mTilesX) * mTilesY);
+}
+
+uint32_t OcclusionCuller::addOccluder(const Mesh* mesh, const Float4x4& toWorld) {
+	Occluder occ = { mesh, toWorld, {} };
+	const Float3* pos = mesh->positions();
+	const size_t count = mesh->vertexCount();
+	for (size_t i = 0; i < count; ++i) {
+		const Float4 p = ::transform(toWorld, pos[i]);
+		const Float3 w = { p.x, p.y, p.z };
+		occ.bounds.min = i ? min(occ.bounds.min, w) : w;
+		occ.bounds.max = i ? max(occ.bounds.max, w) : w;
+	}
+	mOccluders.push_back(occ);
+	return static_cast<uint32_t>(mOccluders.size() - 1U);
+}
+
+void OcclusionCuller::clearOccluders() noexcept {
+	mOccluders.clear();
+}
+
+//----------------------------------------------------------------
+
+void OcclusionCuller::render(const Camera& camera) {
+	const Clock::time_point start = Clock::now();
+	mViewProj = camera.viewProjection();
+	const Frustum& frustum = camera.frustum();
+
+	// Occluders in view, each gets room for every triangle split in two
+	mVisibleOccluders.clear();
+	mTriFirst.clear();
+	uint32_t capacity = 0;
+	for (size_t i = 0; i < mOccluders.size(); ++i) {
+		if (!frustum.intersects(mOccluders[i].bounds)) {
+			continue;
+		}
+		mVisibleOccluders.push_back(static_cast<uint32_t>(i));
+		mTriFirst.push_back(capacity);
+		capacity += static_cast<uint32_t>(mOccluders[i].mesh->indexCount() / 3U) * 2U;
+	}
+	mTriCount.assign(mVisibleOccluders.size(), 0U);
+	mTris.resize(capacity);
+
+	JobSystem& jobs = JobSystem::instance();
+	jobs.parallelFor(mVisibleOccluders.size(), 1, [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			transform(mOccluders[mVisibleOccluders[i]], &mTris[mTriFirst[i]], mTriCount[i]);
+		}
+	});
+
+	// Bin by screen bounds
+	for (std::vector<uint32_t>& bin : mTileBins) {
+		bin.clear();
+	}
+	uint32_t rasterized = 0;
+	const float maxX = static_cast<float>(mWidth - 1U);
+	const float maxY = static_cast<float>(mHeight - 1U);
+	for (size_t o = 0; o < mVisibleOccluders.size(); ++o) {
+		for (uint32_t t = 0; t < mTriCount[o]; ++t) {
+			const uint32_t index = mTriFirst[o] + t;
+			const ScreenTri& tri = mTris[index];
+			const float x0 = std::max(0.0f, std::min({ tri.v[0].x, tri.v[1].x, tri.v[2].x }));
+			const float x1 = std::min(maxX, std::max({ tri.v[0].x, tri.v[1].x, tri.v[2].x }));
+			const float y0 = std::max(0.0f, std::min({ tri.v[0].y, tri.v[1].y, tri.v[2].y }));
+			const float y1 = std::min(maxY, std::max({ tri.v[0].y, tri.v[1].y, tri.v[2].y }));
+			if (x0 > x1 || y0 > y1) {
+				continue;
+			}
+			const uint32_t tx0 = static_cast<uint32_t>(x0) / TILE_WIDTH;
+			const uint32_t tx1 = static_cast<uint32_t>(x1) / TILE_WIDTH;
+			const uint32_t ty0 = static_cast<uint32_t>(y0) / TILE_HEIGHT;
+			const uint32_t ty1 = static_cast<uint32_t>(y1) / TILE_HEIGHT;
+			for (uint32_t ty = ty0; ty <= ty1; ++ty) {
+				for (uint32_t tx = tx0; tx <= tx1; ++tx) {
+					mTileBins[ty * mTilesX + tx].push_back(index);
+				}
+			}
+			++rasterized;
+		}
+	}
+
+	// Tiles own disjoint pixels and blocks, no locking needed
+	jobs.parallelFor(mTileBins.size(), 1, [this](size_t begin, size_t end) {
+		for (size_t t = begin; t < end; ++t) {
+			rasterizeTile(static_cast<uint32_t>(t));
+		}
+	});
+
+	mStats = {};
+	mStats.occluders = static_cast<uint32_t>(mVisibleOccluders.size());
+	mStats.trianglesRasterized = rasterized;
+	mStats.rasterMs = elapsedMs(start);
+}
+
+void OcclusionCuller::transform(const Occluder& occ, ScreenTri* out, uint32_t& count) const noexcept {
+	const Float4x4 m = mViewProj * occ.toWorld;
+	const Float3* pos = occ.mesh->positions();
+	const uint16_t* idx = occ.mesh->indices();
+	const size_t indexCount = occ.mesh->indexCount();
+	const float sx = 0.5f * static_cast<float>(mWidth);
+	const float sy = 0.5f * static_cast<float>(mHeight);
+
+	auto project = [&](const ClipVert& c) {
+		const float inv = 1.0f / c.w;
+		return Float3{ (c.x * inv + 1.0f) * sx, (1.0f - c.y * inv) * sy, c.z * inv * 0.5f + 0.5f };
+	};
+
+	count = 0;
+	for (size_t i = 0; i + 2U < indexCount; i += 3U) {
+		ClipVert v[3];
+		for (size_t k = 0; k < 3; ++k) {
+			const Float4 c = ::transform(m, pos[idx[i + k]]);
+			v[k] = { c.x, c.y, c.z, c.w };
+		}
+
+		// Trivially outside one of the side planes
+		if ((v[0].x > v[0].w && v[1].x > v[1].w && v[2].x > v[2].w)
+		|| (v[0].x < -v[0].w && v[1].x < -v[1].w && v[2].x < -v[2].w)
+		|| (v[0].y > v[0].w && v[1].y > v[1].w && v[2].y > v[2].w)
+		|| (v[0].y < -v[0].w && v[1].y < -v[1].w && v[2].y < -v[2].w)) {
+			continue;
+		}
+
+		// Clip against the near plane (z >= -w)
+		ClipVert poly[4];
+		size_t n = 0;
+		for (size_t k = 0; k < 3; ++k) {
+			const ClipVert& a = v[k];
+			const ClipVert& b = v[(k + 1U) % 3U];
+			const float da = a.z + a.w;
+			const float db = b.z + b.w;
+			if (da >= 0.0f) {
+				poly[n++] = a;
+			}
+			if ((da >= 0.0f) != (db >= 0.0f)) {
+				poly[n++] = lerp(a, b, da / (da - db));
+			}
+		}
+		if (n < 3) {
+			continue;
+		}
+
+		const Float3 p0 = project(poly[0]);
+		for (size_t k = 1; k + 1U < n; ++k) {
+			out[count++] = { { p0, project(poly[k]), project(poly[k + 1U]) } };
+		}
+	}
+}
+
+//----------------------------------------------------------------
+
+void OcclusionCuller::rasterizeTile(uint32_t tile) noexcept {
+	const uint32_t tileX = (tile % mTilesX) * TILE_WIDTH;
+	const uint32_t tileY = (tile / mTilesX) * TILE_HEIGHT;
+	float* depth = mDepth.data();
+
+	for (uint32_t y = tileY; y < tileY + TILE_HEIGHT; ++y) {
+		std::fill_n(depth + static_cast<size_t>(y) * mWidth + tileX, TILE_WIDTH, 1.0f);
+	}
+
+	const SimdFloat4 laneOffsets = simdSet(0.5f, 1.5f, 2.5f, 3.5f);
+	const SimdFloat4 zero = simdSplat(0.0f);
+
+	for (uint32_t index : mTileBins[tile]) {
+		const ScreenTri& tri = mTris[index];
+		Float3 a = tri.v[0], b = tri.v[1], c = tri.v[2];
+		float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (std::fabs(area) < 1.0e-6f) {
+			continue;
+		}
+		if (area < 0.0f) {
+			std::swap(b, c);
+			area = -area;
+		}
+
+		// Edge functions E(x, y) = A*x + B*y + C, >= 0 inside
+		const float a0 = a.y - b.y, b0 = b.x - a.x, c0 = -(a0 * a.x + b0 * a.y);	// a -> b, opposite c
+		const float a1 = b.y - c.y, b1 = c.x - b.x, c1 = -(a1 * b.x + b1 * b.y);	// b -> c, opposite a
+		const float a2 = c.y - a.y, b2 = a.x - c.x, c2 = -(a2 * c.x + b2 * c.y);	// c -> a, opposite b
+
+		// Depth plane from the barycentric weights
+		const float invArea = 1.0f / area;
+		const float za = (a1 * a.z + a2 * b.z + a0 * c.z) * invArea;
+		const float zb = (b1 * a.z + b2 * b.z + b0 * c.z) * invArea;
+		const float zc = (c1 * a.z + c2 * b.z + c0 * c.z) * invArea;
+
+		// Pixel range inside the tile, x aligned down to the SIMD width
+		const float fx0 = std::min({ a.x, b.x, c.x }), fx1 = std::max({ a.x, b.x, c.x });
+		const float fy0 = std::min({ a.y, b.y, c.y }), fy1 = std::max({ a.y, b.y, c.y });
+		const int32_t tx0 = static_cast<int32_t>(tileX), tx1 = static_cast<int32_t>(tileX + TILE_WIDTH) - 1;
+		const int32_t ty0 = static_cast<int32_t>(tileY), ty1 = static_cast<int32_t>(tileY + TILE_HEIGHT) - 1;
+		const int32_t x0 = clampToInt(std::floor(fx0), tx0, tx1 + 1) & ~3;
+		const int32_t x1 = clampToInt(std::ceil(fx1), tx0 - 1, tx1);
+		const int32_t y0 = clampToInt(std::floor(fy0), ty0, ty1 + 1);
+		const int32_t y1 = clampToInt(std::ceil(fy1), ty0 - 1, ty1);
+		if (x0 > x1 || y0 > y1) {
+			continue;
+		}
+
+		const SimdFloat4 stepE0 = simdSplat(a0 * 4.0f), stepE1 = simdSplat(a1 * 4.0f), stepE2 = simdSplat(a2 * 4.0f);
+		const SimdFloat4 stepZ = simdSplat(za * 4.0f);
+		const SimdFloat4 px0 = simdSplat(static_cast<float>(x0)) + laneOffsets;
+
+		for (int32_t y = y0; y <= y1; ++y) {
+			const SimdFloat4 py = simdSplat(static_cast<float>(y) + 0.5f);
+			SimdFloat4 e0 = simdSplat(a0) * px0 + simdSplat(b0) * py + simdSplat(c0);
+			SimdFloat4 e1 = simdSplat(a1) * px0 + simdSplat(b1) * py + simdSplat(c1);
+			SimdFloat4 e2 = simdSplat(a2) * px0 + simdSplat(b2) * py + simdSplat(c2);
+			SimdFloat4 z = simdSplat(za) * px0 + simdSplat(zb) * py + simdSplat(zc);
+			float* row = depth + static_cast<size_t>(y) * mWidth;
+
+			for (int32_t x = x0; x <= x1; x += 4) {
+				const SimdFloat4 inside = simdCmpGe(e0, zero) & simdCmpGe(e1, zero) & simdCmpGe(e2, zero);
+				if (simdMoveMask(inside)) {
+					const SimdFloat4 d = simdLoadU(row + x);
+					simdStoreU(row + x, simdSelect(inside, simdMin(d, z), d));
+				}
+				e0 = e0 + stepE0;
+				e1 = e1 + stepE1;
+				e2 = e2 + stepE2;
+				z = z + stepZ;
+			}
+		}
+	}
+
+	// Farthest depth per block
+	for (uint32_t by = tileY; by < tileY + TILE_HEIGHT; by += BLOCK_SIZE) {
+		for (uint32_t bx = tileX; bx < tileX + TILE_WIDTH; bx += BLOCK_SIZE) {
+			const float* p = depth + static_cast<size_t>(by) * mWidth + bx;
+			SimdFloat4 m = simdLoadU(p);
+			for (uint32_t r = 1; r < BLOCK_SIZE; ++r) {
+				m = simdMax(m, simdLoadU(p + static_cast<size_t>(r) * mWidth));
+			}
+			mHiZ[static_cast<size_t>(by / BLOCK_SIZE) * mBlocksX + bx / BLOCK_SIZE] = simdHMax(m);
+		}
+	}
+}
+
+//----------------------------------------------------------------
+
+bool OcclusionCuller::isOccluded(const Sphere& bounds) const noexcept {
+	const Float3 c = bounds.center;
+	const float r = bounds.radius;
+	float minX = 1.0e30f, minY = 1.0e30f, maxX = -1.0e30f, maxY = -1.0e30f, nearest = 1.0e30f;
+	for (uint32_t k = 0; k < 8; ++k) {
+		const Float3 corner = { c.x + ((k & 1U) ? r : -r), c.y + ((k & 2U) ? r : -r), c.z + ((k & 4U) ? r : -r) };
+		const Float4 p = ::transform(mViewProj, corner);
+		if (p.z < -p.w || p.w <= 0.0f) {
+			return false;	// Crosses the near plane
+		}
+		const float inv = 1.0f / p.w;
+		const float sx = (p.x * inv + 1.0f) * 0.5f * static_cast<float>(mWidth);
+		const float sy = (1.0f - p.y * inv) * 0.5f * static_cast<float>(mHeight);
+		minX = std::min(minX, sx);
+		maxX = std::max(maxX, sx);
+		minY = std::min(minY, sy);
+		maxY = std::max(maxY, sy);
+		nearest = std::min(nearest, p.z * inv * 0.5f + 0.5f);
+	}
+
+	// Grow by a pixel: coverage is sampled at pixel centres, so an occluder
+	// edge can stop anywhere inside the last pixel it marks
+	minX -= 1.0f;
+	minY -= 1.0f;
+	maxX += 1.0f;
+	maxY += 1.0f;
+
+	const float w = static_cast<float>(mWidth - 1U), h = static_cast<float>(mHeight - 1U);
+	if (maxX < 0.0f || maxY < 0.0f || minX > w || minY > h) {
+		return false;	// Off screen, leave that to frustum culling
+	}
+	const uint32_t bx0 = static_cast<uint32_t>(std::max(0.0f, minX)) / BLOCK_SIZE;
+	const uint32_t bx1 = static_cast<uint32_t>(std::min(w, maxX)) / BLOCK_SIZE;
+	const uint32_t by0 = static_cast<uint32_t>(std::max(0.0f, minY)) / BLOCK_SIZE;
+	const uint32_t by1 = static_cast<uint32_t>(std::min(h, maxY)) / BLOCK_SIZE;
+	for (uint32_t by = by0; by <= by1; ++by) {
+		const float* row = mHiZ.data() + static_cast<size_t>(by) * mBlocksX;
+		for (uint32_t bx = bx0; bx <= bx1; ++bx) {
+			if (nearest <= row[bx]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+size_t OcclusionCuller::filter(const Sphere* bounds, uint32_t* ids, size_t count) noexcept {
+	const Clock::time_point start = Clock::now();
+	size_t kept = 0;
+	for (size_t i = 0; i < count; ++i) {
+		if (!isOccluded(bounds[ids[i]])) {
+			ids[kept++] = ids[i];
+		}
+	}
+	mStats.tested = static_cast<uint32_t>(count);
+	mStats.culled = static_cast<uint32_t>(count - kept);
+	mStats.testMs = elapsedMs(start);
+	return kept;
+}
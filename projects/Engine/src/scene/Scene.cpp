@@ -0,0 +1,284 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/scene/Scene.hh>
+#include <Engine/gfx/ICommandQueue.hh>
+
+#include <chrono>
+#include <utility>
+
+//================================================================
+
+Scene::Scene()
+	: mLoadStats{}
+	, mLodHysteresis(0.1f)
+	, mLodStats{}
+	, mVisStats{}
+	, mOcclusionEnabled(false) {}
+
+Scene::~Scene() noexcept {}
+
+//----------------------------------------------------------------
+
+void Scene::clear() {
+	mMeshes.clear();
+	mBounds.clear();
+	mLods.clear();
+	mObjCells.clear();
+	mNames.clear();
+	mVisible.clear();
+	mVisibility.clear();
+	mFile.close();
+	mLoadStats = {};
+}
+
+Scene::ObjectId Scene::addObject(const Mesh* mesh, const Sphere& worldBounds, StringId name) {
+	const ObjectId id = static_cast<ObjectId>(mMeshes.size());
+	mMeshes.push_back(mesh);
+	mBounds.push_back(worldBounds);
+	mLods.push_back(0);
+	mObjCells.push_back({});
+	mNames.push_back(name);
+	assignCells(id);
+	return id;
+}
+
+Scene::ObjectId Scene::findObject(StringId name) const noexcept {
+	const size_t count = mNames.size();
+	for (size_t i = 0; i < count; ++i) {
+		if (mNames[i] == name) {
+			return static_cast<ObjectId>(i);
+		}
+	}
+	return INVALID_OBJECT;
+}
+
+//----------------------------------------------------------------
+
+bool Scene::load(const char* path) {
+	const auto start = std::chrono::steady_clock::now();
+	clear();
+	if (!mFile.open(path)) {
+		return false;
+	}
+
+	// Objects are mutable at runtime, copy them out
+	const size_t objCount = mFile.objectCount();
+	addObjects(mFile);
+	size_t copied = objCount * (sizeof(Sphere) + sizeof(uint32_t) + sizeof(StringId));
+
+	// Cells and portals
+	size_t cellCount = 0, portalCount = 0, pvsCount = 0;
+	const VisCell* cells = mFile.file().section<VisCell>(SceneSection::Cells, cellCount);
+	const VisPortal* portals = mFile.file().section<VisPortal>(SceneSection::Portals, portalCount);
+	const uint32_t* pvs = mFile.file().section<uint32_t>(SceneSection::Pvs, pvsCount);
+	if (cellCount > 0) {
+		if (pvsCount != cellCount * CellVisibility::rowWords(cellCount)
+		|| !CellVisibility::validate(cells, cellCount, portals, portalCount)) {
+			clear();
+			return false;
+		}
+		CellVisibility vis;
+		vis.assign(std::vector<VisCell>(cells, cells + cellCount),
+			std::vector<VisPortal>(portals, portals + portalCount),
+			std::vector<uint32_t>(pvs, pvs + pvsCount));
+		setVisibility(std::move(vis));
+		copied += cellCount * sizeof(VisCell) + portalCount * sizeof(VisPortal) + pvsCount * sizeof(uint32_t);
+	}
+
+	mLoadStats.fileBytes = mFile.file().file().size();
+	mLoadStats.copiedBytes = copied;
+	mLoadStats.meshes = static_cast<uint32_t>(mFile.meshCount());
+	mLoadStats.objects = static_cast<uint32_t>(objCount);
+	mLoadStats.mapped = mFile.file().file().isMapped();
+	mLoadStats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return true;
+}
+
+Scene::ObjectId Scene::addObjects(const SceneChunk& chunk) {
+	const ObjectId first = static_cast<ObjectId>(mMeshes.size());
+	const size_t count = chunk.objectCount();
+	const size_t total = mMeshes.size() + count;
+	mMeshes.reserve(total);
+	mBounds.reserve(total);
+	mNames.reserve(total);
+	for (size_t i = 0; i < count; ++i) {
+		mMeshes.push_back(chunk.objectMesh(i));
+		mBounds.push_back(chunk.objectBounds(i));
+		mNames.push_back(chunk.objectName(i));
+	}
+	mLods.resize(total, 0);
+	mObjCells.resize(total, ObjectCells{});
+	for (size_t i = first; i < total; ++i) {
+		assignCells(static_cast<ObjectId>(i));
+	}
+	return first;
+}
+
+void Scene::removeObjects(ObjectId first, size_t count) {
+	if (first >= mMeshes.size() || count == 0) {
+		return;
+	}
+	const size_t last = (first + count < mMeshes.size()) ? (first + count) : mMeshes.size();
+	mMeshes.erase(mMeshes.begin() + first, mMeshes.begin() + last);
+	mBounds.erase(mBounds.begin() + first, mBounds.begin() + last);
+	mLods.erase(mLods.begin() + first, mLods.begin() + last);
+	mObjCells.erase(mObjCells.begin() + first, mObjCells.begin() + last);
+	mNames.erase(mNames.begin() + first, mNames.begin() + last);
+	mVisible.clear();
+}
+
+void Scene::setObjectBounds(ObjectId id, const Sphere& worldBounds) noexcept {
+	mBounds[id] = worldBounds;
+	assignCells(id);
+}
+
+void Scene::assignCells(ObjectId id) noexcept {
+	ObjectCells& oc = mObjCells[id];
+	oc.count = 0;
+	const Sphere& s = mBounds[id];
+	const Aabb box = { s.center - Float3{ s.radius, s.radius, s.radius }, s.center + Float3{ s.radius, s.radius, s.radius } };
+	const size_t cells = mVisibility.cellCount();
+	for (size_t c = 0; c < cells; ++c) {
+		const Aabb& cb = mVisibility.cell(c).bounds;
+		if (box.max.x < cb.min.x || box.min.x > cb.max.x
+		||  box.max.y < cb.min.y || box.min.y > cb.max.y
+		||  box.max.z < cb.min.z || box.min.z > cb.max.z) {
+			continue;
+		}
+		if (oc.count == ObjectCells::MAX_CELLS) {
+			oc.count = 0;	// Too large, treat as exterior
+			return;
+		}
+		oc.cells[oc.count++] = static_cast<uint32_t>(c);
+	}
+}
+
+//----------------------------------------------------------------
+
+void Scene::setVisibility(CellVisibility&& visibility) {
+	mVisibility = std::move(visibility);
+	const size_t count = mMeshes.size();
+	for (size_t i = 0; i < count; ++i) {
+		assignCells(static_cast<ObjectId>(i));
+	}
+}
+
+void Scene::cull(const Camera& camera) {
+	SceneVisStats stats = {};
+	const Frustum& view = camera.frustum();
+	mVisible.clear();
+	mVisibleCells.clear();
+
+	const uint32_t cameraCell = mVisibility.findCell(camera.position());
+	const bool usePortals = mVisibility.gatherVisible(cameraCell, camera.position(), view, mVisibleCells);
+
+	if (usePortals) {
+		// Group the walk output by cell
+		const size_t cells = mVisibility.cellCount();
+		mCellFirst.assign(cells + 1U, 0U);
+		for (const VisibleCell& vc : mVisibleCells) {
+			++mCellFirst[vc.cell + 1U];
+		}
+		for (size_t c = 0; c < cells; ++c) {
+			mCellFirst[c + 1U] += mCellFirst[c];
+		}
+		mCellEntries.resize(mVisibleCells.size());
+		mCellFill.assign(mCellFirst.begin(), mCellFirst.end() - 1);
+		for (size_t i = 0; i < mVisibleCells.size(); ++i) {
+			mCellEntries[mCellFill[mVisibleCells[i].cell]++] = static_cast<uint32_t>(i);
+		}
+		stats.cellsVisited = static_cast<uint32_t>(mVisibleCells.size());
+	}
+
+	const size_t count = mMeshes.size();
+	for (size_t i = 0; i < count; ++i) {
+		const Sphere& bounds = mBounds[i];
+		++stats.objects;
+		const bool inFrustum = view.intersects(bounds);
+		stats.frustumVisible += inFrustum ? 1U : 0U;
+
+		const ObjectCells& oc = mObjCells[i];
+		bool visible = inFrustum;
+		if (usePortals && oc.count > 0) {
+			visible = false;
+			bool rejected = true;
+			for (uint32_t k = 0; k < oc.count && !visible; ++k) {
+				const uint32_t cell = oc.cells[k];
+				if (!mVisibility.potentiallyVisible(cameraCell, cell)) {
+					continue;
+				}
+				rejected = false;
+				for (uint32_t e = mCellFirst[cell]; e < mCellFirst[cell + 1U]; ++e) {
+					if (mVisibleCells[mCellEntries[e]].frustum.intersects(bounds)) {
+						visible = true;
+						break;
+					}
+				}
+			}
+			stats.pvsRejected += rejected ? 1U : 0U;
+		}
+
+		if (visible) {
+			mVisible.push_back(static_cast<ObjectId>(i));
+		}
+	}
+
+	if (mOcclusionEnabled && mOcclusion.occluderCount() > 0 && !mVisible.empty()) {
+		mOcclusion.render(camera);
+		const size_t kept = mOcclusion.filter(mBounds.data(), mVisible.data(), mVisible.size());
+		stats.occlusionCulled = static_cast<uint32_t>(mVisible.size() - kept);
+		mVisible.resize(kept);
+	}
+
+	stats.submitted = static_cast<uint32_t>(mVisible.size());
+	mVisStats = stats;
+}
+
+//----------------------------------------------------------------
+
+void Scene::selectLods(const Camera& camera) noexcept {
+	SceneLodStats stats = {};
+	for (const ObjectId i : mVisible) {
+		const Mesh* mesh = mMeshes[i];
+		if (!mesh) {
+			continue;
+		}
+		const MeshLodChain& chain = mesh->lods();
+		if (chain.levelCount() == 0) {
+			continue;
+		}
+		const uint8_t prev = mLods[i];
+		const uint8_t lod = chain.select(camera.projectedRadius(mBounds[i]), prev, mLodHysteresis);
+		mLods[i] = lod;
+
+		++stats.objects;
+		++stats.objectsPerLod[lod];
+		stats.trianglesSubmitted += chain.triangleCount(lod);
+		stats.trianglesFullDetail += chain.triangleCount(0);
+		stats.lodChanges += (lod != prev) ? 1U : 0U;
+	}
+	mLodStats = stats;
+}
+
+uint32_t Scene::submit(ICommandQueue& queue, const Camera& camera, float farDistance, const Float4x4* transforms,
+	const IMaterial* material, uint8_t pass) const {
+	const float invFar = (farDistance > 0.0f) ? 1.0f / farDistance : 0.0f;
+	uint32_t recorded = 0;
+	for (size_t i = 0; i < mVisible.size(); ++i) {
+		const ObjectId id = mVisible[i];
+		const Mesh* mesh = mMeshes[id];
+		if (!mesh || !mesh->drawBuffer()) {
+			continue;
+		}
+		const uint8_t lod = mLods[id];
+		const DrawCommand cmd = { material, nullptr, mesh->drawBuffer(), transforms ? &transforms[i] : nullptr,
+			mesh->drawFirst(lod), mesh->drawCount(lod), Primitive::Triangles };
+		const float depth = length(mBounds[id].center - camera.position()) * invFar;
+		if (!queue.submit(SortKey::make(pass, RenderList::Opaque, depth, 0, 0), cmd)) {
+			break;
+		}
+		++recorded;
+	}
+	return recorded;
+}
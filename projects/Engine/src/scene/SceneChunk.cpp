@@ -0,0 +1,81 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/scene/SceneChunk.hh>
+
+//================================================================
+
+bool SceneChunk::open(const char* path, bool map) {
+	close();
+	if (!mFile.open(path, map) || !bind()) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+void SceneChunk::close() noexcept {
+	mMeshes.reset();
+	mMeshCount = 0;
+	mBounds = nullptr;
+	mObjMeshes = nullptr;
+	mNames = nullptr;
+	mObjectCount = 0;
+	mFile.close();
+}
+
+//----------------------------------------------------------------
+
+bool SceneChunk::bind() {
+	size_t meshCount = 0, lodCount = 0, vertCount = 0, normCount = 0, uvCount = 0, idxCount = 0;
+	const SceneMeshRecord* meshes = mFile.section<SceneMeshRecord>(SceneSection::Meshes, meshCount);
+	const MeshLodLevel* lods = mFile.section<MeshLodLevel>(SceneSection::LodLevels, lodCount);
+	const Float3* positions = mFile.section<Float3>(SceneSection::Positions, vertCount);
+	const Float3* normals = mFile.section<Float3>(SceneSection::Normals, normCount);
+	const Float2* uvs = mFile.section<Float2>(SceneSection::Uvs, uvCount);
+	const uint16_t* indices = mFile.section<uint16_t>(SceneSection::Indices, idxCount);
+
+	// Meshes reference the file in place
+	mMeshes.reset(meshCount ? new Mesh[meshCount] : nullptr);
+	mMeshCount = meshCount;
+	for (size_t i = 0; i < meshCount; ++i) {
+		const SceneMeshRecord& rec = meshes[i];
+		// 64-bit sums, offsets near 4G must not wrap past the checks on 32-bit targets
+		if (uint64_t(rec.firstVertex) + rec.vertexCount > vertCount
+		|| uint64_t(rec.firstLod) + rec.lodCount > lodCount || rec.lodCount == 0) {
+			return false;
+		}
+		const MeshLodLevel* levels = lods + rec.firstLod;
+		const uint16_t* base = indices + rec.firstLodIndex;
+		for (size_t l = 0; l < rec.lodCount; ++l) {
+			if (uint64_t(rec.firstLodIndex) + levels[l].firstIndex + levels[l].indexCount > idxCount) {
+				return false;
+			}
+			// Every index must land inside the mesh's own vertices
+			const uint16_t* ids = base + levels[l].firstIndex;
+			for (uint32_t k = 0; k < levels[l].indexCount; ++k) {
+				if (ids[k] >= rec.vertexCount) {
+					return false;
+				}
+			}
+		}
+		mMeshes[i].bind(rec.vertexCount, positions + rec.firstVertex,
+			(normCount == vertCount) ? normals + rec.firstVertex : nullptr,
+			(uvCount == vertCount) ? uvs + rec.firstVertex : nullptr,
+			base + levels[0].firstIndex, levels[0].indexCount);
+		mMeshes[i].lods().assignExternal(levels, rec.lodCount, base);
+	}
+
+	// Object tables
+	size_t objMeshCount = 0, nameCount = 0;
+	mBounds = mFile.section<Sphere>(SceneSection::ObjectBounds, mObjectCount);
+	mObjMeshes = mFile.section<uint32_t>(SceneSection::ObjectMeshes, objMeshCount);
+	mNames = mFile.section<StringId>(SceneSection::ObjectNames, nameCount);
+	if (objMeshCount != mObjectCount) {
+		return false;
+	}
+	if (nameCount != mObjectCount) {
+		mNames = nullptr;
+	}
+	return true;
+}
@@ -0,0 +1,497 @@
+// Dream Disk 2025 Game Engine
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Engine/scene/SceneStreamer.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+#if DD25_JOBS_THREADED
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif//DD25_JOBS_THREADED
+
+//================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t NO_CHUNK = 0xFFFFFFFFU;
+constexpr uint32_t MAX_BACKOFF_SHIFT = 4U;		// Retry delay stops doubling at 16x
+
+// Main thread owns Idle <-> Queued, Loaded -> Resident -> Idle and
+// Failed -> Idle, the I/O worker owns Queued -> Loading -> Loaded/Failed.
+enum class ChunkState : uint8_t {
+	Idle,
+	Queued,
+	Loading,
+	Loaded,
+	Resident,
+	Failed
+};
+
+inline double seconds(Clock::time_point t) noexcept {
+	return std::chrono::duration<double>(t.time_since_epoch()).count();
+}
+
+inline float distance(const Aabb& box, const Float3& p) noexcept {
+	const Float3 d = max(max(box.min - p, p - box.max), Float3{ 0.0f, 0.0f, 0.0f });
+	return length(d);
+}
+
+} // namespace
+
+//================================================================
+
+struct SceneStreamer::Chunk {
+	StreamChunkDesc				desc;
+	SceneChunk					data;			// Written by the worker while Loading
+	std::atomic<ChunkState>		state{ ChunkState::Idle };
+	std::atomic<float>			priority{ 0.0f };	// Distance to the camera, lower loads first
+	size_t						bytes		= 0;	// Resident size, estimated until loaded once
+	uint32_t					lastWanted	= 0;	// Frame the chunk was last inside the load radius
+	uint32_t					failures	= 0;	// Failed reads in a row
+	uint32_t					retryFrame	= 0;	// When a Failed chunk goes back to Idle, 0 until scheduled
+	Scene::ObjectId				first		= 0;	// Committed object range
+	size_t						count		= 0;
+};
+
+struct SceneStreamer::Worker {
+	SceneStreamer*				owner		= nullptr;
+	std::atomic<uint64_t>		bytesRead{ 0 };
+	std::atomic<uint32_t>		failed{ 0 };
+	std::atomic<size_t>			bytesPerSecond{ 0 };	// Copy of the setting, read by the worker
+#if DD25_JOBS_THREADED
+	std::thread					thread;
+	std::mutex					lock;		// Guards `work` and `quit`
+	std::condition_variable		wake;
+	std::condition_variable		idle;
+	bool						work		= false;
+	bool						quit		= false;
+
+	void start() {
+		quit = false;
+		work = false;
+		thread = std::thread([this] { run(); });
+	}
+
+	void stop() {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			quit = true;
+		}
+		wake.notify_all();
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+
+	void kick() {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			work = true;
+		}
+		wake.notify_one();
+	}
+
+	void run() {
+		for (;;) {
+			Chunk* next = owner->nextQueued();
+			if (!next) {
+				std::unique_lock<std::mutex> guard(lock);
+				wake.wait(guard, [this] { return quit || work; });
+				if (quit) {
+					return;
+				}
+				work = false;
+				continue;
+			}
+			owner->service(*next);
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				if (quit) {
+					return;
+				}
+			}
+			idle.notify_all();
+		}
+	}
+#else
+	void start() {}
+	void stop() {}
+	void kick() {}
+#endif//DD25_JOBS_THREADED
+};
+
+//================================================================
+
+SceneStreamer::SceneStreamer()
+	: mChunkCount(0)
+	, mWorker(new Worker())
+	, mStats{}
+	, mCommittedBytes(0)
+	, mFrame(0)
+	, mLastPosition{ 0.0f, 0.0f, 0.0f }
+	, mVelocity{ 0.0f, 0.0f, 0.0f }
+	, mHasPosition(false) {
+	mWorker->owner = this;
+	mWorker->start();
+}
+
+SceneStreamer::~SceneStreamer() noexcept {
+	mWorker->stop();
+}
+
+//----------------------------------------------------------------
+
+void SceneStreamer::setChunks(const std::vector<StreamChunkDesc>& chunks) {
+	mWorker->stop();
+	mChunks.reset(chunks.empty() ? nullptr : new Chunk[chunks.size()]);
+	mChunkCount = chunks.size();
+	for (size_t i = 0; i < mChunkCount; ++i) {
+		mChunks[i].desc = chunks[i];
+		mChunks[i].bytes = chunks[i].bytes;
+	}
+	mStats = {};
+	mCommittedBytes = 0;
+	mWorker->bytesRead = 0;
+	mWorker->failed = 0;
+	mHasPosition = false;
+	mVelocity = { 0.0f, 0.0f, 0.0f };
+	mWorker->start();
+}
+
+bool SceneStreamer::isResident(size_t chunk) const noexcept {
+	return chunk < mChunkCount && mChunks[chunk].state.load(std::memory_order_acquire) == ChunkState::Resident;
+}
+
+//----------------------------------------------------------------
+
+SceneStreamer::Chunk* SceneStreamer::nextQueued() noexcept {
+	for (;;) {
+		Chunk* best = nullptr;
+		float bestPriority = 0.0f;
+		for (size_t i = 0; i < mChunkCount; ++i) {
+			Chunk& c = mChunks[i];
+			if (c.state.load(std::memory_order_relaxed) != ChunkState::Queued) {
+				continue;
+			}
+			const float p = c.priority.load(std::memory_order_relaxed);
+			if (!best || p < bestPriority) {
+				best = &c;
+				bestPriority = p;
+			}
+		}
+		if (!best) {
+			return nullptr;
+		}
+		// The main thread may have cancelled it in the meantime
+		ChunkState expected = ChunkState::Queued;
+		if (best->state.compare_exchange_strong(expected, ChunkState::Loading, std::memory_order_acquire)) {
+			return best;
+		}
+	}
+}
+
+void SceneStreamer::service(Chunk& chunk) {
+	const Clock::time_point start = Clock::now();
+	const bool ok = chunk.data.open(chunk.desc.path.c_str(), false);
+	const size_t read = ok ? chunk.data.file().file().size() : 0;
+	mWorker->bytesRead += read;
+	mWorker->failed += ok ? 0U : 1U;
+
+#if DD25_JOBS_THREADED
+	// Pace reads to the bandwidth cap (optical media, shared buses)
+	const size_t bps = mWorker->bytesPerSecond.load(std::memory_order_relaxed);
+	if (bps > 0 && read > 0) {
+		const auto budget = std::chrono::duration<double>(static_cast<double>(read) / static_cast<double>(bps));
+		std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(budget));
+	}
+#else
+	(void)start;
+#endif//DD25_JOBS_THREADED
+
+	chunk.state.store(ok ? ChunkState::Loaded : ChunkState::Failed, std::memory_order_release);
+}
+
+//----------------------------------------------------------------
+
+void SceneStreamer::update(Scene& scene, const Camera& camera, float dt) {
+	const Clock::time_point start = Clock::now();
+	++mFrame;
+	mStats.budgetDeferred = 0;
+	mWorker->bytesPerSecond.store(mSettings.ioBytesPerSecond, std::memory_order_relaxed);
+
+	// Predict where the camera is heading
+	const Float3 position = camera.position();
+	if (mHasPosition && dt > 0.0f) {
+		const Float3 v = (position - mLastPosition) * (1.0f / dt);
+		mVelocity = (mVelocity + v) * 0.5f;
+	}
+	mLastPosition = position;
+	mHasPosition = true;
+	const Float3 predicted = position + mVelocity * mSettings.lookAhead;
+
+	uint32_t cameraChunk = NO_CHUNK;
+	for (size_t i = 0; i < mChunkCount && cameraChunk == NO_CHUNK; ++i) {
+		if (mChunks[i].desc.bounds.contains(position)) {
+			cameraChunk = static_cast<uint32_t>(i);
+		}
+	}
+
+	request(scene, position, predicted);
+
+#if !DD25_JOBS_THREADED
+	// No I/O thread, load the most urgent chunk inline
+	if (Chunk* next = nextQueued()) {
+		service(*next);
+	}
+#endif//DD25_JOBS_THREADED
+
+	const double budgetEnd = seconds(start) + static_cast<double>(mSettings.commitBudgetMs) * 0.001;
+	commit(scene, budgetEnd, cameraChunk);
+
+	// Counters
+	mStats.resident = mStats.inFlight = mStats.pending = 0;
+	mStats.bytesResident = mStats.bytesInFlight = 0;
+	for (size_t i = 0; i < mChunkCount; ++i) {
+		const Chunk& c = mChunks[i];
+		switch (c.state.load(std::memory_order_acquire)) {
+			case ChunkState::Queued:
+			case ChunkState::Loading:
+				++mStats.inFlight;
+				mStats.bytesInFlight += c.bytes;
+				break;
+			case ChunkState::Loaded:
+				++mStats.pending;
+				mStats.bytesResident += c.data.residentBytes();
+				break;
+			case ChunkState::Resident:
+				++mStats.resident;
+				mStats.bytesResident += c.data.residentBytes();
+				break;
+			default:
+				break;
+		}
+	}
+	mStats.peakBytesInFlight = std::max(mStats.peakBytesInFlight, mStats.bytesInFlight);
+	mStats.bytesRead = mWorker->bytesRead.load(std::memory_order_relaxed);
+	mStats.failed = mWorker->failed.load(std::memory_order_relaxed);
+	if (cameraChunk != NO_CHUNK && mChunks[cameraChunk].state.load(std::memory_order_acquire) != ChunkState::Resident) {
+		++mStats.stalls;
+	}
+
+	mStats.updateMs = static_cast<float>(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+	mStats.maxUpdateMs = std::max(mStats.maxUpdateMs, mStats.updateMs);
+	mStats.hitches += (mStats.updateMs > mSettings.commitBudgetMs) ? 1U : 0U;
+}
+
+void SceneStreamer::request(Scene& scene, const Float3& position, const Float3& predicted) {
+	size_t resident = 0;
+	size_t inFlight = 0;
+	mCandidates.clear();
+	for (size_t i = 0; i < mChunkCount; ++i) {
+		Chunk& c = mChunks[i];
+		const float dist = std::min(distance(c.desc.bounds, position), distance(c.desc.bounds, predicted));
+		const bool wanted = dist <= mSettings.loadRadius;
+		c.priority.store(dist, std::memory_order_relaxed);
+		if (wanted) {
+			c.lastWanted = mFrame;
+		}
+
+		ChunkState state = c.state.load(std::memory_order_acquire);
+		if (state == ChunkState::Queued && !wanted) {
+			// Left the radius before the worker got to it
+			if (c.state.compare_exchange_strong(state, ChunkState::Idle, std::memory_order_relaxed)) {
+				continue;
+			}
+		}
+		if (state == ChunkState::Failed) {
+			// Back off, then let it be requested like any other
+			if (c.retryFrame == 0) {
+				c.retryFrame = mFrame + (mSettings.retryFrames << std::min(c.failures++, MAX_BACKOFF_SHIFT));
+			}
+			if (mFrame < c.retryFrame) {
+				continue;
+			}
+			c.data.close();
+			c.retryFrame = 0;
+			c.state.store(ChunkState::Idle, std::memory_order_relaxed);
+			state = ChunkState::Idle;
+			++mStats.retries;
+		}
+		switch (state) {
+			case ChunkState::Idle:
+				if (wanted) {
+					mCandidates.push_back(static_cast<uint32_t>(i));
+				}
+				break;
+			case ChunkState::Queued:
+			case ChunkState::Loading:
+				inFlight += c.bytes;
+				break;
+			case ChunkState::Loaded:
+			case ChunkState::Resident:
+				resident += c.data.residentBytes();
+				break;
+			default:
+				break;
+		}
+	}
+
+	// Nearest first
+	std::sort(mCandidates.begin(), mCandidates.end(), [this](uint32_t a, uint32_t b) {
+		return mChunks[a].priority.load(std::memory_order_relaxed) < mChunks[b].priority.load(std::memory_order_relaxed);
+	});
+
+	bool queued = false;
+	for (size_t k = 0; k < mCandidates.size(); ++k) {
+		Chunk& c = mChunks[mCandidates[k]];
+		if (c.bytes == 0 && mStats.committed > 0) {
+			// Never loaded, assume an average chunk
+			c.bytes = static_cast<size_t>(mCommittedBytes / mStats.committed);
+		}
+		if (inFlight > 0 && inFlight + c.bytes > mSettings.maxBytesInFlight) {
+			break;
+		}
+		while (resident + inFlight + c.bytes > mSettings.memoryBudget) {
+			const size_t freed = evictOne(scene);
+			if (freed == 0) {
+				break;
+			}
+			resident -= std::min(freed, resident);
+		}
+		if (resident + inFlight + c.bytes > mSettings.memoryBudget) {
+			mStats.budgetDeferred = static_cast<uint32_t>(mCandidates.size() - k);
+			break;
+		}
+		inFlight += c.bytes;
+		c.state.store(ChunkState::Queued, std::memory_order_release);
+		++mStats.requested;
+		queued = true;
+	}
+	if (queued) {
+		mWorker->kick();
+	}
+}
+
+void SceneStreamer::commit(Scene& scene, double budgetEnd, uint32_t cameraChunk) {
+	// The chunk under the camera goes in regardless of the budget
+	if (cameraChunk != NO_CHUNK) {
+		Chunk& c = mChunks[cameraChunk];
+		if (c.state.load(std::memory_order_acquire) == ChunkState::Loaded) {
+			attach(scene, c);
+		}
+	}
+
+	for (;;) {
+		Chunk* best = nullptr;
+		for (size_t i = 0; i < mChunkCount; ++i) {
+			Chunk& c = mChunks[i];
+			const ChunkState state = c.state.load(std::memory_order_acquire);
+			if (state != ChunkState::Loaded || c.lastWanted != mFrame) {
+				continue;
+			}
+			if (!best || c.priority.load(std::memory_order_relaxed) < best->priority.load(std::memory_order_relaxed)) {
+				best = &c;
+			}
+		}
+		if (!best || seconds(Clock::now()) >= budgetEnd) {
+			break;
+		}
+		attach(scene, *best);
+	}
+}
+
+void SceneStreamer::attach(Scene& scene, Chunk& chunk) {
+	chunk.failures = 0;
+	chunk.first = scene.addObjects(chunk.data);
+	chunk.count = chunk.data.objectCount();
+	chunk.bytes = chunk.data.residentBytes();
+	chunk.state.store(ChunkState::Resident, std::memory_order_relaxed);
+	mCommittedBytes += chunk.bytes;
+	++mStats.committed;
+}
+
+//----------------------------------------------------------------
+
+size_t SceneStreamer::evictOne(Scene& scene) {
+	// Least recently wanted chunk that isn't wanted this frame
+	Chunk* victim = nullptr;
+	for (size_t i = 0; i < mChunkCount; ++i) {
+		Chunk& c = mChunks[i];
+		const ChunkState state = c.state.load(std::memory_order_acquire);
+		if ((state != ChunkState::Resident && state != ChunkState::Loaded) || c.lastWanted == mFrame) {
+			continue;
+		}
+		if (!victim || c.lastWanted < victim->lastWanted) {
+			victim = &c;
+		}
+	}
+	if (!victim) {
+		return 0;
+	}
+	const size_t freed = victim->data.residentBytes();
+	evict(scene, *victim);
+	return freed;
+}
+
+void SceneStreamer::evict(Scene& scene, Chunk& chunk) {
+	if (chunk.state.load(std::memory_order_acquire) == ChunkState::Resident) {
+		scene.removeObjects(chunk.first, chunk.count);
+		for (size_t i = 0; i < mChunkCount; ++i) {
+			Chunk& c = mChunks[i];
+			if (c.state.load(std::memory_order_relaxed) == ChunkState::Resident && c.first > chunk.first) {
+				c.first -= static_cast<Scene::ObjectId>(chunk.count);
+			}
+		}
+		++mStats.evicted;
+	}
+	chunk.data.close();
+	chunk.count = 0;
+	chunk.state.store(ChunkState::Idle, std::memory_order_release);
+}
+
+void SceneStreamer::unloadAll(Scene& scene) {
+	for (size_t i = 0; i < mChunkCount; ++i) {
+		ChunkState expected = ChunkState::Queued;
+		mChunks[i].state.compare_exchange_strong(expected, ChunkState::Idle, std::memory_order_relaxed);
+	}
+	flush();
+	for (size_t i = 0; i < mChunkCount; ++i) {
+		const ChunkState state = mChunks[i].state.load(std::memory_order_acquire);
+		if (state == ChunkState::Resident || state == ChunkState::Loaded) {
+			evict(scene, mChunks[i]);
+		} else if (state == ChunkState::Failed) {
+			mChunks[i].data.close();
+			mChunks[i].state.store(ChunkState::Idle, std::memory_order_relaxed);
+		}
+		mChunks[i].failures = 0;
+		mChunks[i].retryFrame = 0;
+	}
+}
+
+void SceneStreamer::flush() {
+	auto busy = [this] {
+		for (size_t i = 0; i < mChunkCount; ++i) {
+			const ChunkState state = mChunks[i].state.load(std::memory_order_acquire);
+			if (state == ChunkState::Queued || state == ChunkState::Loading) {
+				return true;
+			}
+		}
+		return false;
+	};
+#if DD25_JOBS_THREADED
+	std::unique_lock<std::mutex> guard(mWorker->lock);
+	mWorker->idle.wait(guard, [&busy] { return !busy(); });
+#else
+	while (busy()) {
+		if (Chunk* next = nextQueued()) {
+			service(*next);
+		}
+	}
+#endif//DD25_JOBS_THREADED
+}
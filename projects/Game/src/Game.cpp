@@ -8,6 +8,73 @@
 #endif//EXIT_SUCCESS
 
 #include <Engine/Engine.hh>
+#include <Engine/gfx/CommandCapture.hh>
+#include <Engine/gfx/Viewport.hh>
+#include <Engine/gfx/backend/Software/GBESoftware.hh>
+#include <Engine/gfx/backend/Software/SoftwareFrameBuffer.hh>
+#include <Engine/gfx/backend/Software/SoftwareVertexBuffer.hh>
+#include <Engine/scene/FramePipeline.hh>
+#include <Engine/scene/Scene.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr uint32_t	SCREEN_WIDTH	= 640U;
+constexpr uint32_t	SCREEN_HEIGHT	= 480U;
+constexpr uint32_t	GRID			= 24U;			// Cubes per side of the field
+constexpr float		SPACING			= 3.0f;
+constexpr float		FRAME_SECONDS	= 1.0f / 60.0f;	// Fixed simulation step
+constexpr float		FAR_DISTANCE	= 200.0f;
+constexpr uint64_t	DEFAULT_FRAMES	= 600U;
+constexpr uint32_t	CLEAR_COLOR		= 0xFF203040U;
+constexpr uint32_t	TRACE_STEP		= 16U;			// Frames between printed viewport samples
+
+// Unit cube corners and its 12 triangles
+const Float3 CUBE_CORNERS[8] = {
+	{ -0.5f, -0.5f, -0.5f }, { 0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, -0.5f }, { -0.5f, 0.5f, -0.5f },
+	{ -0.5f, -0.5f, 0.5f }, { 0.5f, -0.5f, 0.5f }, { 0.5f, 0.5f, 0.5f }, { -0.5f, 0.5f, 0.5f }
+};
+
+const uint16_t CUBE_INDICES[36] = {
+	0, 2, 1, 0, 3, 2,	4, 5, 6, 4, 6, 7,	0, 1, 5, 0, 5, 4,
+	3, 6, 2, 3, 7, 6,	0, 4, 7, 0, 7, 3,	1, 2, 6, 1, 6, 5
+};
+
+const uint32_t CUBE_FACE_COLORS[6] = {
+	0xFFE04040U, 0xFF40E040U, 0xFF4040E0U, 0xFFE0E040U, 0xFF40E0E0U, 0xFFE040E0U
+};
+
+std::vector<GfxVertex> buildCube() {
+	std::vector<GfxVertex> vertices(36);
+	for (size_t i = 0; i < 36; ++i) {
+		vertices[i] = { CUBE_CORNERS[CUBE_INDICES[i]], CUBE_FACE_COLORS[i / 6], { 0.0f, 0.0f } };
+	}
+	return vertices;
+}
+
+// Rotation about Y then X, placed at `position`
+Float4x4 spin(const Float3& position, float yaw, float pitch) {
+	const float cy = std::cos(yaw), sy = std::sin(yaw);
+	const float cp = std::cos(pitch), sp = std::sin(pitch);
+	return { {
+		cy,			sp * sy,	-cp * sy,	0.0f,
+		0.0f,		cp,			sp,			0.0f,
+		sy,			-sp * cy,	cp * cy,	0.0f,
+		position.x,	position.y,	position.z,	1.0f
+	} };
+}
+
+} // namespace
+
+//================================================================
 
 // Entry Point
 int main(
@@ -15,6 +82,110 @@ int main(
 	char**		argv,
 	char**		envp
 ) {
-	//TODO: Create main Game Loop
+	const uint64_t frames = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_FRAMES;
+	const char* capturePath = (argc > 2 && *argv[2]) ? argv[2] : nullptr;	// Last frame, for `DD25Editor replay`
+
+	// A tighter render budget (ms) shows the dynamic resolution at work
+	ViewportSettings viewportSettings;
+	if (argc > 3) {
+		viewportSettings.budgetMs = std::strtof(argv[3], nullptr);
+	}
+
+	// Assets
+	const std::vector<GfxVertex> cubeVertices = buildCube();
+	SoftwareVertexBuffer cubeBuffer(static_cast<uint32_t>(cubeVertices.size()), cubeVertices.data());
+	Mesh cubeMesh;
+	cubeMesh.bind(8, CUBE_CORNERS, nullptr, nullptr, CUBE_INDICES, 36);
+	cubeMesh.setDrawBuffer(&cubeBuffer);	// buildCube() follows CUBE_INDICES, level 0 starts at 0
+
+	// World: a field of spinning cubes
+	Scene scene;
+	std::vector<Float3> positions;
+	const float half = 0.5f * SPACING * static_cast<float>(GRID - 1U);
+	for (uint32_t z = 0; z < GRID; ++z) {
+		for (uint32_t x = 0; x < GRID; ++x) {
+			const Float3 p = { static_cast<float>(x) * SPACING - half, 0.0f, static_cast<float>(z) * SPACING - half };
+			positions.push_back(p);
+			scene.addObject(&cubeMesh, { p, 0.87f });
+		}
+	}
+
+	Camera camera;
+	camera.setPerspective(1.0f, static_cast<float>(SCREEN_WIDTH) / static_cast<float>(SCREEN_HEIGHT), 0.5f, FAR_DISTANCE);
+	camera.setViewportSize(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+	//
+	// Render side: draws a finished packet while the next one is
+	// simulated. Frames are rasterised at the viewport's render size,
+	// which follows the raster time, and upscaled to the screen.
+	//
+	GBESoftware gbe;
+	Viewport viewport(SCREEN_WIDTH, SCREEN_HEIGHT, viewportSettings);
+	SoftwareFrameBuffer frameBuffer(viewport.renderWidth(), viewport.renderHeight());
+	SoftwareFrameBuffer screen(SCREEN_WIDTH, SCREEN_HEIGHT);
+	float minScale = viewport.renderScale();
+	uint32_t resizes = 0;
+	FramePipeline pipeline([&](FramePacket& packet) {
+		if (frameBuffer.width() != viewport.renderWidth() || frameBuffer.height() != viewport.renderHeight()) {
+			frameBuffer.resize(viewport.renderWidth(), viewport.renderHeight());
+			++resizes;
+		}
+		gbe.beginFrame(frameBuffer, CLEAR_COLOR);
+		gbe.setViewProjection(packet.camera.viewProjection());
+		packet.queue.execute(gbe);
+		gbe.endFrame();
+
+		viewport.update(gbe.stats().binMs + gbe.stats().rasterMs);
+		minScale = std::min(minScale, viewport.renderScale());
+		viewport.present(frameBuffer.pixels(), frameBuffer.width() * sizeof(uint32_t), screen.pixels(), SCREEN_WIDTH * sizeof(uint32_t));
+
+		if (capturePath && packet.frame + 1U == frames) {
+			CommandCapture capture;
+			capture.capture(packet.queue, { packet.camera.viewProjection(), packet.frame, frameBuffer.width(), frameBuffer.height(), CLEAR_COLOR, 0 });
+			if (!capture.write(capturePath)) {
+				std::fprintf(stderr, "can't write %s\n", capturePath);
+			}
+		}
+	});
+
+	// Simulation side
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t frame = 0; frame < frames; ++frame) {
+		const float t = static_cast<float>(frame) * FRAME_SECONDS;
+		FramePacket& packet = pipeline.acquire();
+
+		const Float3 eye = { std::sin(t * 0.2f) * half * 1.5f, half * 0.6f, std::cos(t * 0.2f) * half * 1.5f };
+		camera.lookAt(eye, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+		scene.cull(camera);
+		scene.selectLods(camera);
+
+		packet.camera = camera;
+		packet.visible = scene.visibleObjects();
+		packet.transforms.reserve(packet.visible.size());
+		for (const Scene::ObjectId id : packet.visible) {
+			const float phase = static_cast<float>(id) * 0.37f;
+			packet.transforms.push_back(spin(positions[id], t + phase, t * 0.5f + phase));
+		}
+
+		// Transforms are final, draws may point at them now
+		scene.submit(packet.queue, camera, FAR_DISTANCE, packet.transforms.data());
+
+		pipeline.submit();
+	}
+	pipeline.flush();
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::printf("%llu frames in %.2f s (%.1f fps, %s)\n", static_cast<unsigned long long>(frames), seconds,
+		seconds > 0.0 ? static_cast<double>(frames) / seconds : 0.0, pipeline.threaded() ? "render thread" : "sequential");
+
+	// Dynamic resolution over the frames the viewport still remembers, oldest first
+	std::printf("viewport: budget %.1f ms, scale %.2f now, %.2f lowest, %u resizes\n",
+		viewport.settings().budgetMs, viewport.renderScale(), minScale, resizes);
+	for (uint32_t age = viewport.traceCount(); age-- > 0;) {
+		if (age % TRACE_STEP == 0) {
+			const ViewportSample& sample = viewport.trace(age);
+			std::printf("  -%-3u raster %6.2f ms, average %6.2f ms, scale %.2f\n", age, sample.frameMs, sample.averageMs, sample.scale);
+		}
+	}
 	return EXIT_SUCCESS;
 }
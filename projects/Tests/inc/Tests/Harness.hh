@@ -0,0 +1,91 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#pragma once
+
+//////////////////////////////////////////////////////////////////
+#ifndef DD25_TESTS_HARNESS_HH
+#define DD25_TESTS_HARNESS_HH
+//////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//================================================================
+
+//
+// Minimal self-registering test and benchmark runner.
+//
+// `DD25_TEST` cases run by default (and under CTest), a failed
+// `DD25_CHECK` marks the case failed and keeps going. `DD25_BENCH` cases
+// only run with `--bench`, they print their measurements and are never
+// part of the pass/fail gate.
+//
+struct TestCase {
+	const char*		name;
+	void			(*run)();
+	bool			bench;
+};
+
+class TestRegistry {
+public:
+	static std::vector<TestCase>& cases() {
+		static std::vector<TestCase> sCases;
+		return sCases;
+	}
+
+	static int add(const char* name, void (*run)(), bool bench) {
+		cases().push_back({ name, run, bench });
+		return 0;
+	}
+
+	// Called by DD25_CHECK
+	static void fail(const char* file, int line, const char* expr);
+
+	static uint32_t& failures() {
+		static uint32_t sFailures = 0;
+		return sFailures;
+	}
+};
+
+#define DD25_TEST_CASE(name, bench)										\
+	static void name();													\
+	static const int name##Registered = TestRegistry::add(#name, name, bench);	\
+	static void name()
+
+#define DD25_TEST(name)		DD25_TEST_CASE(name, false)
+#define DD25_BENCH(name)	DD25_TEST_CASE(name, true)
+
+#define DD25_CHECK(cond)	((cond) ? (void)0 : TestRegistry::fail(__FILE__, __LINE__, #cond))
+
+//================================================================
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+inline double elapsedMs(Clock::time_point start) noexcept {
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Best of `runs` timings of `fn` in milliseconds, after one warm-up call
+template <typename Fn>
+double bestOf(uint32_t runs, Fn&& fn) {
+	fn();
+	double best = 1.0e30;
+	for (uint32_t i = 0; i < runs; ++i) {
+		const Clock::time_point start = Clock::now();
+		fn();
+		const double ms = elapsedMs(start);
+		best = (ms < best) ? ms : best;
+	}
+	return best;
+}
+
+} // namespace bench
+
+//////////////////////////////////////////////////////////////////
+#endif//DD25_TESTS_HARNESS_HH
+//////////////////////////////////////////////////////////////////
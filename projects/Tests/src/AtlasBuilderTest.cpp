@@ -0,0 +1,137 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Editor/AtlasBuilder.hh>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+// Source images with a texel pattern unique to each image and position
+struct ImageSet {
+	std::vector<std::vector<uint32_t>>	texels;
+	std::vector<AtlasImage>				images;
+
+	explicit ImageSet(size_t count, uint32_t maxSide) {
+		uint32_t seed = 0x2545F491U;
+		auto next = [&seed]() {
+			seed = seed * 1664525U + 1013904223U;
+			return seed >> 8;
+		};
+		texels.resize(count);
+		images.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			const uint32_t width = 1U + next() % maxSide;
+			const uint32_t height = 1U + next() % maxSide;
+			texels[i].resize(static_cast<size_t>(width) * height);
+			for (size_t t = 0; t < texels[i].size(); ++t) {
+				texels[i][t] = 0xFF000000U | static_cast<uint32_t>(i) << 12 | static_cast<uint32_t>(t & 0xFFFU);
+			}
+			images[i] = { texels[i].data(), width, height };
+		}
+	}
+};
+
+// Page texel `rect` covers at (x, y) of its source, which may lie in the gutter
+uint32_t pageTexel(const AtlasPage& page, const AtlasRect& rect, int32_t x, int32_t y) {
+	const int32_t x0 = static_cast<int32_t>(rect.u0 * static_cast<float>(page.width));
+	const int32_t y0 = static_cast<int32_t>(rect.v0 * static_cast<float>(page.height));
+	return page.mips[0][static_cast<size_t>(y0 + y) * page.width + static_cast<size_t>(x0 + x)];
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(atlasRectsMapBackToTheirImages) {
+	const ImageSet set(96, 60);
+	AtlasBuildSettings settings;
+	settings.pageWidth = 256U;
+	settings.pageHeight = 256U;
+	settings.padding = 4U;
+	settings.mipmaps = false;
+
+	std::vector<AtlasPage> pages;
+	std::vector<AtlasRect> rects;
+	AtlasBuildStats stats = {};
+	DD25_CHECK(AtlasBuilder().build(set.images.data(), set.images.size(), settings, pages, rects, &stats));
+	DD25_CHECK(pages.size() > 1);
+	DD25_CHECK(rects.size() == set.images.size());
+	DD25_CHECK(stats.bindsBefore == set.images.size());
+	DD25_CHECK(stats.bindsAfter == pages.size());
+
+	const int32_t pad = static_cast<int32_t>(settings.padding);
+	uint32_t wrong = 0;
+	uint32_t badGutter = 0;
+	for (size_t i = 0; i < set.images.size(); ++i) {
+		const AtlasImage& image = set.images[i];
+		const AtlasRect& rect = rects[i];
+		const int32_t w = static_cast<int32_t>(image.width);
+		const int32_t h = static_cast<int32_t>(image.height);
+		DD25_CHECK(rect.page < pages.size());
+		const AtlasPage& page = pages[rect.page];
+		DD25_CHECK(rect.u1 - rect.u0 == static_cast<float>(w) / static_cast<float>(page.width));
+		DD25_CHECK(rect.v1 - rect.v0 == static_cast<float>(h) / static_cast<float>(page.height));
+
+		// Every texel inside the rect and its gutter, the gutter repeating the nearest edge
+		for (int32_t y = -pad; y < h + pad; ++y) {
+			for (int32_t x = -pad; x < w + pad; ++x) {
+				const int32_t sx = std::clamp(x, 0, w - 1);
+				const int32_t sy = std::clamp(y, 0, h - 1);
+				const bool inside = (sx == x && sy == y);
+				const bool match = pageTexel(page, rect, x, y) == image.argb[static_cast<size_t>(sy) * image.width + static_cast<size_t>(sx)];
+				wrong += (inside && !match) ? 1U : 0U;
+				badGutter += (!inside && !match) ? 1U : 0U;
+			}
+		}
+	}
+	DD25_CHECK(wrong == 0);
+	DD25_CHECK(badGutter == 0);
+}
+
+DD25_TEST(atlasRejectsImagesLargerThanAPage) {
+	std::vector<uint32_t> texels(static_cast<size_t>(120) * 16, 0xFFFFFFFFU);
+	AtlasBuildSettings settings;
+	settings.pageWidth = 128U;
+	settings.pageHeight = 128U;
+	settings.padding = 4U;
+	settings.mipmaps = false;
+
+	std::vector<AtlasPage> pages;
+	std::vector<AtlasRect> rects;
+	const AtlasImage fits[] = { { texels.data(), 120, 16 } };
+	DD25_CHECK(AtlasBuilder().build(fits, 1, settings, pages, rects));
+	DD25_CHECK(pages.size() == 1);
+
+	// 120 texels plus two 5 texel gutters no longer fit in 128
+	settings.padding = 5U;
+	DD25_CHECK(!AtlasBuilder().build(fits, 1, settings, pages, rects));
+
+	const AtlasImage tooTall[] = { { texels.data(), 16, 129 } };
+	settings.padding = 0U;
+	DD25_CHECK(!AtlasBuilder().build(tooTall, 1, settings, pages, rects));
+}
+
+//================================================================
+
+//
+// Packing 400 mixed sprites onto 512x512 pages: occupancy, binds to
+// draw every sprite once, and pack and mip times.
+//
+DD25_BENCH(atlasBuild400Sprites) {
+	const ImageSet set(400, 96);
+	AtlasBuildSettings settings;
+
+	std::vector<AtlasPage> pages;
+	std::vector<AtlasRect> rects;
+	AtlasBuildStats stats = {};
+	AtlasBuilder().build(set.images.data(), set.images.size(), settings, pages, rects, &stats);
+	std::printf("  %zu images on %zu pages: occupancy %.1f%%, binds %zu -> %zu, pack %.2f ms, mips %.2f ms\n", stats.images, stats.pages,
+		stats.occupancy * 100.0, stats.bindsBefore, stats.bindsAfter, stats.packSeconds * 1000.0, stats.mipSeconds * 1000.0);
+}
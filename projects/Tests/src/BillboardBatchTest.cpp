@@ -0,0 +1,106 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/BillboardBatch.hh>
+#include <Engine/gfx/StreamVertexBuffer.hh>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+//================================================================
+
+namespace {
+
+const Float3 EYE = { 3.0f, 2.0f, 10.0f };
+
+// `count` billboards scattered in a flat 100 x 10 x 100 box about the origin
+void scatter(BillboardSet& set, uint32_t count, uint32_t seed) {
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> u(-50.0f, 50.0f);
+	set.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		set.add({ u(rng), u(rng) * 0.1f, u(rng) }, { 0.5f, 1.5f });
+	}
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(billboardTranslucentBackToFront) {
+	const uint32_t count = 1003U;
+	StreamVertexBuffer stream(1U << 16);
+	BillboardBatch batch(stream);
+	BillboardSet opaque(BillboardMode::Camera), translucent(BillboardMode::Camera);
+	scatter(opaque, count, 1U);
+	scatter(translucent, count, 2U);
+
+	stream.beginFrame();
+	batch.begin(lookAt(EYE, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }), 100.0f);
+	batch.add(opaque, RenderList::Opaque);
+	DD25_CHECK(batch.stats().sortMs == 0.0f);
+	batch.build();
+	DD25_CHECK(batch.stats().sorted == 0 && batch.stats().sortMs == 0.0f);
+	DD25_CHECK(batch.stats().vertices == count * 6U);
+
+	batch.begin(lookAt(EYE, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }), 100.0f);
+	batch.add(translucent, RenderList::Translucent);
+	batch.build();
+	DD25_CHECK(batch.stats().sorted == count);
+
+	// The quads were written last, depth along the view never increases
+	const Float3 forward = normalize(Float3{ 0.0f, 0.0f, 0.0f } - EYE);
+	const GfxVertex* v = stream.vertices() + ((count * 6U + 3U) & ~3U);
+	uint32_t violations = 0;
+	float previous = 1.0e30f;
+	for (uint32_t i = 0; i < count; ++i) {
+		const Float3 center = (v[i * 6U].position + v[i * 6U + 2U].position) * 0.5f;
+		const float depth = dot(center - EYE, forward);
+		violations += (depth > previous + 1.0e-4f) ? 1U : 0U;
+		previous = depth;
+	}
+	DD25_CHECK(violations == 0);
+	stream.retire(stream.endFrame());
+}
+
+//================================================================
+
+//
+// 100k billboards a set, camera facing and axis locked, opaque and
+// translucent: `build()` time split into the back to front sort and the
+// expansion into the stream.
+//
+DD25_BENCH(billboardBatch100k) {
+	const uint32_t count = 100000U;
+	StreamVertexBuffer stream(4U << 20);
+	BillboardBatch batch(stream);
+	BillboardSet camera(BillboardMode::Camera), axis(BillboardMode::Axis);
+	scatter(camera, count, 3U);
+	scatter(axis, count, 3U);
+	const Float4x4 view = lookAt(EYE, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+
+	struct Case { const char* name; const BillboardSet* set; RenderList list; };
+	const Case cases[] = {
+		{ "camera opaque", &camera, RenderList::Opaque },
+		{ "axis opaque", &axis, RenderList::Opaque },
+		{ "camera translucent", &camera, RenderList::Translucent },
+		{ "axis translucent", &axis, RenderList::Translucent },
+	};
+	for (const Case& c : cases) {
+		float sortMs = 0.0f, expandMs = 0.0f;
+		const double ms = bench::bestOf(20, [&] {
+			stream.beginFrame();
+			batch.begin(view, 100.0f);
+			batch.add(*c.set, c.list);
+			batch.build();
+			stream.retire(stream.endFrame());
+			sortMs = batch.stats().sortMs;
+			expandMs = batch.stats().expandMs;
+		});
+		std::printf("  %-20s %.3f ms best (last run: sort %.3f, expand %.3f), %.1f M billboards/s\n",
+			c.name, ms, sortMs, expandMs, count / ms / 1000.0);
+	}
+}
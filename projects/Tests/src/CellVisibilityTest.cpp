@@ -0,0 +1,119 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/scene/Scene.hh>
+
+#include <cstdio>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr float		ROOM		= 10.0f;
+constexpr float		HEIGHT		= 4.0f;
+
+//
+// `side` x `side` rooms with every shared wall fully open. The number of
+// portal paths between two rooms grows combinatorially with the grid,
+// while the visible set is simply the view frustum.
+//
+CellVisibility openGrid(uint32_t side) {
+	std::vector<VisCell> cells;
+	std::vector<VisPortal> portals;
+	auto at = [side](uint32_t x, uint32_t y) { return y * side + x; };
+
+	for (uint32_t y = 0; y < side; ++y) {
+		for (uint32_t x = 0; x < side; ++x) {
+			const float x0 = x * ROOM, x1 = x0 + ROOM;
+			const float y0 = y * ROOM, y1 = y0 + ROOM;
+			VisCell cell = { { { x0, y0, 0.0f }, { x1, y1, HEIGHT } }, static_cast<uint32_t>(portals.size()), 0U };
+			if (x > 0) {
+				portals.push_back({ { { x0, y0, 0.0f }, { x0, y1, 0.0f }, { x0, y1, HEIGHT }, { x0, y0, HEIGHT } }, at(x - 1U, y) });
+			}
+			if (x + 1U < side) {
+				portals.push_back({ { { x1, y0, 0.0f }, { x1, y1, 0.0f }, { x1, y1, HEIGHT }, { x1, y0, HEIGHT } }, at(x + 1U, y) });
+			}
+			if (y > 0) {
+				portals.push_back({ { { x0, y0, 0.0f }, { x1, y0, 0.0f }, { x1, y0, HEIGHT }, { x0, y0, HEIGHT } }, at(x, y - 1U) });
+			}
+			if (y + 1U < side) {
+				portals.push_back({ { { x0, y1, 0.0f }, { x1, y1, 0.0f }, { x1, y1, HEIGHT }, { x0, y1, HEIGHT } }, at(x, y + 1U) });
+			}
+			cell.portalCount = static_cast<uint32_t>(portals.size()) - cell.firstPortal;
+			cells.push_back(cell);
+		}
+	}
+
+	// Everything sees everything
+	const size_t count = cells.size();
+	std::vector<uint32_t> pvs(count * CellVisibility::rowWords(count), 0xFFFFFFFFU);
+
+	CellVisibility vis;
+	vis.assign(std::move(cells), std::move(portals), std::move(pvs));
+	return vis;
+}
+
+Camera cornerCamera() {
+	Camera camera;
+	camera.setViewportSize(640, 480);
+	camera.setPerspective(1.2f, 640.0f / 480.0f, 0.1f, 200.0f);
+	camera.lookAt({ 1.0f, 1.0f, 2.0f }, { 60.0f, 40.0f, 2.0f }, { 0.0f, 0.0f, 1.0f });
+	return camera;
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(cellWalkStaysBounded) {
+	const uint32_t side = 6U;
+	CellVisibility vis = openGrid(side);
+	const Camera camera = cornerCamera();
+
+	std::vector<VisibleCell> out;
+	DD25_CHECK(vis.gatherVisible(vis.findCell(camera.position()), camera.position(), camera.frustum(), out));
+
+	// One entry per path gave 265 entries here, it grows with every room added
+	DD25_CHECK(out.size() < side * side * 4U);
+
+	// Repeated walks (the generation counter) give the same answer
+	std::vector<VisibleCell> again;
+	vis.gatherVisible(vis.findCell(camera.position()), camera.position(), camera.frustum(), again);
+	DD25_CHECK(again.size() == out.size());
+}
+
+DD25_TEST(cellWalkIsConservative) {
+	// With every wall open, the portal walk must keep all that the frustum sees
+	const uint32_t side = 6U;
+	Scene scene;
+	for (uint32_t y = 0; y < side * 5U; ++y) {
+		for (uint32_t x = 0; x < side * 5U; ++x) {
+			scene.addObject(nullptr, { { x * 2.0f + 1.0f, y * 2.0f + 1.0f, 1.0f }, 0.3f });
+		}
+	}
+	scene.setVisibility(openGrid(side));
+
+	const Camera camera = cornerCamera();
+	scene.cull(camera);
+	DD25_CHECK(scene.visStats().submitted == scene.visStats().frustumVisible);
+	DD25_CHECK(scene.visStats().submitted > 0);
+}
+
+//================================================================
+
+DD25_BENCH(cellWalkOpenGrid) {
+	const Camera camera = cornerCamera();
+	for (const uint32_t side : { 4U, 6U, 8U, 12U }) {
+		CellVisibility vis = openGrid(side);
+		const uint32_t cell = vis.findCell(camera.position());
+		std::vector<VisibleCell> out;
+		const double ms = bench::bestOf(20, [&] {
+			out.clear();
+			vis.gatherVisible(cell, camera.position(), camera.frustum(), out);
+		});
+		std::printf("  %2ux%-2u rooms: %5zu entries, %.3f ms per walk\n", side, side, out.size(), ms);
+	}
+}
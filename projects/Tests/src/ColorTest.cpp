@@ -0,0 +1,139 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/Color.hh>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+// Batch conversion must agree with the per-pixel helpers, both ways
+template<typename C>
+uint32_t mismatches() {
+	std::vector<uint32_t> src(1024);
+	for (uint32_t v = 0; v < 256; ++v) {
+		src[v] = v << 24 | v << 16 | v << 8 | v;
+		src[256U + v] = (255U - v) << 24 | v << 16 | ((v * 7U) & 255U) << 8 | ((v * 13U) & 255U);
+		src[512U + v] = (v * 0x01010101U) ^ 0x00A5A5A5U;
+		src[768U + v] = v << 16;
+	}
+	std::vector<typename C::Storage> packed(src.size());
+	convertPixels(src.data(), PixelFormat::ARGB8888, src.size() * 4U, packed.data(), C::FORMAT, packed.size() * sizeof(typename C::Storage), static_cast<uint32_t>(src.size()), 1);
+
+	uint32_t bad = 0;
+	for (size_t i = 0; i < src.size(); ++i) {
+		bad += (packed[i] != C::pack(src[i])) ? 1U : 0U;
+	}
+	if constexpr (sizeof(typename C::Storage) == 2) {
+		std::vector<uint16_t> every(65536);
+		std::vector<uint32_t> unpacked(65536);
+		for (uint32_t i = 0; i < 65536U; ++i) {
+			every[i] = static_cast<uint16_t>(i);
+		}
+		convertPixels(every.data(), C::FORMAT, 65536U * 2U, unpacked.data(), PixelFormat::ARGB8888, 65536U * 4U, 65536U, 1);
+		for (uint32_t i = 0; i < 65536U; ++i) {
+			bad += (unpacked[i] != C::unpack(static_cast<uint16_t>(i))) ? 1U : 0U;
+		}
+	}
+	return bad;
+}
+
+// Horizontal red ramp, vertical green ramp, patterned blue
+std::vector<uint32_t> gradient(uint32_t width, uint32_t height) {
+	std::vector<uint32_t> image(static_cast<size_t>(width) * height);
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			image[static_cast<size_t>(y) * width + x] = 0xFF000000U | (x * 255U / (width - 1U)) << 16 | (y * 255U / (height - 1U)) << 8 | ((x ^ y) & 255U);
+		}
+	}
+	return image;
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(colorBatchMatchesPerPixel) {
+	DD25_CHECK(mismatches<ColorARGB1555>() == 0);
+	DD25_CHECK(mismatches<ColorRGB565>() == 0);
+	DD25_CHECK(mismatches<ColorARGB4444>() == 0);
+	DD25_CHECK(mismatches<ColorARGB8888>() == 0);
+}
+
+DD25_TEST(colorSrgbRoundTrip) {
+	std::vector<uint32_t> argb(256), back(256);
+	std::vector<Float4> linear(256);
+	for (uint32_t i = 0; i < 256; ++i) {
+		argb[i] = i << 24 | i << 16 | (255U - i) << 8 | i;
+	}
+	srgbToLinear(argb.data(), linear.data(), argb.size());
+	linearToSrgb(linear.data(), back.data(), back.size());
+	DD25_CHECK(argb == back);
+}
+
+DD25_TEST(colorDitherKeepsLocalMean) {
+	// Red through 565 and back: dithering trades pixel error for a truer 4x4 average
+	const uint32_t size = 256;
+	const std::vector<uint32_t> image = gradient(size, size);
+	std::vector<uint16_t> packed(image.size());
+	std::vector<uint32_t> back(image.size());
+	double blockError[3] = {};
+	for (uint32_t d = 0; d < 3; ++d) {
+		convertPixels(image.data(), PixelFormat::ARGB8888, size * 4U, packed.data(), PixelFormat::RGB565, size * 2U, size, size, static_cast<Dither>(d));
+		convertPixels(packed.data(), PixelFormat::RGB565, size * 2U, back.data(), PixelFormat::ARGB8888, size * 4U, size, size);
+		for (uint32_t by = 0; by < size; by += 4) {
+			for (uint32_t bx = 0; bx < size; bx += 4) {
+				double a = 0.0, b = 0.0;
+				for (uint32_t j = 0; j < 4; ++j) {
+					for (uint32_t i = 0; i < 4; ++i) {
+						a += (image[(by + j) * size + bx + i] >> 16) & 255U;
+						b += (back[(by + j) * size + bx + i] >> 16) & 255U;
+					}
+				}
+				blockError[d] += std::fabs(a - b) / 16.0;
+			}
+		}
+	}
+	DD25_CHECK(blockError[1] < blockError[0]);
+	DD25_CHECK(blockError[2] < blockError[0]);
+}
+
+//================================================================
+
+//
+// Megapixels per second through the batch kernels on a 1024x1024
+// image, against packing one pixel at a time.
+//
+DD25_BENCH(colorConvertMPs) {
+	const uint32_t w = 1024U, h = 1024U;
+	const std::vector<uint32_t> image = gradient(w, h);
+	std::vector<uint16_t> t16(image.size());
+	std::vector<uint32_t> t32(image.size());
+	std::vector<Float4> linear(image.size());
+	const double pixels = static_cast<double>(w) * h;
+
+	auto report = [&](const char* name, auto&& fn) {
+		const double ms = bench::bestOf(10, fn);
+		std::printf("  %-26s %8.1f MP/s\n", name, pixels / ms * 1.0e-3);
+	};
+	report("8888 -> 565", [&] { convertPixels(image.data(), PixelFormat::ARGB8888, w * 4U, t16.data(), PixelFormat::RGB565, w * 2U, w, h); });
+	report("8888 -> 565 ordered", [&] { convertPixels(image.data(), PixelFormat::ARGB8888, w * 4U, t16.data(), PixelFormat::RGB565, w * 2U, w, h, Dither::Ordered); });
+	report("8888 -> 565 diffusion", [&] { convertPixels(image.data(), PixelFormat::ARGB8888, w * 4U, t16.data(), PixelFormat::RGB565, w * 2U, w, h, Dither::ErrorDiffusion); });
+	report("8888 -> 1555", [&] { convertPixels(image.data(), PixelFormat::ARGB8888, w * 4U, t16.data(), PixelFormat::ARGB1555, w * 2U, w, h); });
+	report("8888 -> 4444", [&] { convertPixels(image.data(), PixelFormat::ARGB8888, w * 4U, t16.data(), PixelFormat::ARGB4444, w * 2U, w, h); });
+	report("565 -> 8888", [&] { convertPixels(t16.data(), PixelFormat::RGB565, w * 2U, t32.data(), PixelFormat::ARGB8888, w * 4U, w, h); });
+	report("copy + premultiply", [&] { t32 = image; premultiplyAlpha(t32.data(), t32.size()); });
+	report("sRGB -> linear", [&] { srgbToLinear(image.data(), linear.data(), image.size()); });
+	report("linear -> sRGB", [&] { linearToSrgb(linear.data(), t32.data(), t32.size()); });
+	report("per-pixel pack 8888 -> 565", [&] {
+		for (size_t i = 0; i < image.size(); ++i) {
+			t16[i] = ColorRGB565::pack(image[i]);
+		}
+	});
+}
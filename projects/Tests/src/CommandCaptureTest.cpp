@@ -0,0 +1,147 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/CommandCapture.hh>
+#include <Engine/gfx/MaterialSystem.hh>
+#include <Engine/gfx/backend/Software/SoftwareVertexBuffer.hh>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+const char* const CAPTURE_PATH = "dd25_test_capture.ddcq";
+
+// `draws` triangles from one buffer and material, one vertex apart
+bool writeCapture(const char* path, uint32_t draws) {
+	std::vector<GfxVertex> vertices(draws + 2U);
+	for (uint32_t i = 0; i < vertices.size(); ++i) {
+		vertices[i] = { { static_cast<float>(i % 64U), static_cast<float>(i / 64U), 0.0f }, 0xFFFFFFFFU, { 0.0f, 0.0f } };
+	}
+	SoftwareVertexBuffer buffer(static_cast<uint32_t>(vertices.size()), vertices.data());
+	MaterialSystem materials(4);
+	const Material* material = materials.create({});
+
+	CommandQueue queue(draws, 8U << 20);
+	for (uint32_t i = 0; i < draws; ++i) {
+		queue.submit(SortKey::make(0, RenderList::Opaque, 0.0f, 0, 0), { material, nullptr, &buffer, nullptr, i, 3, Primitive::Triangles });
+	}
+	queue.sort();
+
+	CommandCapture capture;
+	capture.capture(queue, { Float4x4::identity(), 0, 64, 64, 0xFF000000U, 0 });
+	return capture.write(path);
+}
+
+//
+// Rewrite record `index` of a section in place. Offsets come from the
+// file itself, so the edit lands on the record whatever the layout.
+//
+template <typename T, typename Fn>
+bool patchRecord(const char* path, CaptureSection section, size_t index, Fn&& edit) {
+	size_t offset = 0;
+	{
+		CaptureFile file;
+		size_t count = 0;
+		const T* records = file.open(path, false) ? file.section<T>(section, count) : nullptr;
+		if (!records || index >= count) {
+			return false;
+		}
+		offset = static_cast<size_t>(reinterpret_cast<const uint8_t*>(records + index) - file.file().data());
+	}
+
+	std::vector<char> bytes;
+	{
+		std::ifstream in(path, std::ios::binary);
+		bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	T record;
+	std::memcpy(&record, bytes.data() + offset, sizeof(T));
+	edit(record);
+	std::memcpy(bytes.data() + offset, &record, sizeof(T));
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	return static_cast<bool>(out);
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(commandReplayRoundTrip) {
+	DD25_CHECK(writeCapture(CAPTURE_PATH, 16));
+	CommandReplay replay;
+	DD25_CHECK(replay.open(CAPTURE_PATH, false));
+	DD25_CHECK(replay.drawCount() == 16 && replay.bufferCount() == 1 && replay.materialCount() == 1);
+
+	CommandQueue queue(64, 1U << 16);
+	DD25_CHECK(replay.submit(queue) == 16);
+	std::filesystem::remove(CAPTURE_PATH);
+}
+
+DD25_TEST(commandReplayRejectsDrawsPastTheirBuffer) {
+	CommandReplay replay;
+
+	// Past the span, and past it only once first + count wraps in 32 bits
+	const uint32_t firsts[2] = { 16U, 0xFFFFFFFEU };
+	for (const uint32_t first : firsts) {
+		DD25_CHECK(writeCapture(CAPTURE_PATH, 16));
+		DD25_CHECK(patchRecord<CaptureDrawRecord>(CAPTURE_PATH, CaptureSection::Draws, 3, [first](CaptureDrawRecord& d) {
+			d.first = first;
+		}));
+		DD25_CHECK(!replay.open(CAPTURE_PATH, false));
+		DD25_CHECK(!replay.isOpen());
+	}
+	std::filesystem::remove(CAPTURE_PATH);
+}
+
+DD25_TEST(commandReplayRejectsUnknownMaterialState) {
+	CommandReplay replay;
+	const size_t fields[3] = { offsetof(CaptureMaterialRecord, list), offsetof(CaptureMaterialRecord, cull), offsetof(CaptureMaterialRecord, shading) };
+	for (const size_t field : fields) {
+		DD25_CHECK(writeCapture(CAPTURE_PATH, 4));
+		DD25_CHECK(patchRecord<CaptureMaterialRecord>(CAPTURE_PATH, CaptureSection::Materials, 0, [field](CaptureMaterialRecord& m) {
+			reinterpret_cast<uint8_t*>(&m)[field] = 0xC8U;
+		}));
+		DD25_CHECK(!replay.open(CAPTURE_PATH, false));
+	}
+	std::filesystem::remove(CAPTURE_PATH);
+}
+
+//================================================================
+
+//
+// Opening a 100k draw capture (read, validated and rebuilt) and
+// replaying it into a queue: what the checks in `open()` cost.
+//
+DD25_BENCH(commandReplayOpen100k) {
+	const uint32_t draws = 100000U;
+	if (!writeCapture(CAPTURE_PATH, draws)) {
+		std::printf("  can't write %s\n", CAPTURE_PATH);
+		return;
+	}
+	const auto bytes = std::filesystem::file_size(CAPTURE_PATH);
+
+	CommandReplay replay;
+	const double mapMs = bench::bestOf(10, [&] { replay.open(CAPTURE_PATH, true); });
+	const double readMs = bench::bestOf(10, [&] { replay.open(CAPTURE_PATH, false); });
+	CommandQueue queue(draws, 8U << 20);
+	uint32_t accepted = 0;
+	const double submitMs = bench::bestOf(10, [&] {
+		queue.reset();
+		accepted = replay.submit(queue);
+	});
+	std::printf("  %u draws, %.1f MB: open %.3f ms mapped, %.3f ms read | submit %.3f ms (%u accepted)\n",
+		draws, static_cast<double>(bytes) / (1024.0 * 1024.0), mapMs, readMs, submitMs, accepted);
+	replay.close();
+	std::filesystem::remove(CAPTURE_PATH);
+}
@@ -0,0 +1,143 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/core/Jobs.hh>
+#include <Engine/gfx/CommandQueue.hh>
+#include <Engine/gfx/IGfxBackend.hh>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+// Counts what the queue asks for, never dereferences state
+class CountingBackend final : public IGfxBackend {
+public:
+	void setPass(uint8_t) override { ++binds; }
+	void setRenderList(RenderList) override { ++binds; }
+	void bindMaterial(const IMaterial*) override { ++binds; }
+	void bindTexture(const ITexture*) override { ++binds; }
+	void bindVertexBuffer(const IVertexBuffer*) override { ++binds; }
+	void draw(const DrawCommand& cmd) override { ++draws; first.push_back(cmd.first); }
+
+	uint32_t				binds = 0;
+	uint32_t				draws = 0;
+	std::vector<uint32_t>	first;
+};
+
+// Opaque handles the queue only compares
+const uint8_t HANDLES[16] = {};
+
+inline const ITexture* textureHandle(uint32_t i) noexcept {
+	return reinterpret_cast<const ITexture*>(&HANDLES[i]);
+}
+
+inline DrawCommand drawOf(uint32_t first, uint32_t texture = 0) noexcept {
+	return { nullptr, textureHandle(texture), nullptr, nullptr, first, 3, Primitive::Triangles };
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(commandQueueStopsAtCapacity) {
+	CommandQueue queue(8, 1U << 12);
+	for (uint32_t i = 0; i < 100; ++i) {
+		queue.submit(i, drawOf(i));
+	}
+	DD25_CHECK(queue.size() == 8);
+
+	// Drops past capacity cost no arena space
+	queue.sort();
+	DD25_CHECK(queue.stats().submitted == 8);
+	DD25_CHECK(queue.stats().dropped == 92);
+	DD25_CHECK(queue.stats().arenaBytes <= 8U * (sizeof(DrawCommand) + alignof(DrawCommand)));
+}
+
+DD25_TEST(commandQueueResortsAfterSubmit) {
+	CommandQueue queue(16, 1U << 12);
+	queue.submit(5, drawOf(5));
+	queue.submit(3, drawOf(3));
+	queue.sort();
+	queue.submit(1, drawOf(1));	// After the sort, must not execute out of order
+
+	CountingBackend backend;
+	queue.execute(backend);
+	DD25_CHECK(backend.draws == 3);
+	DD25_CHECK(backend.first.size() == 3 && backend.first[0] == 1 && backend.first[1] == 3 && backend.first[2] == 5);
+}
+
+DD25_TEST(commandQueueParallelSubmit) {
+	const uint32_t capacity = 10000U;
+	CommandQueue queue(capacity, 8U << 20);
+	JobSystem::instance().parallelFor(40000, 256, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			queue.submit(i, drawOf(static_cast<uint32_t>(i)));
+		}
+	});
+	queue.sort();
+	DD25_CHECK(queue.size() == capacity);
+	DD25_CHECK(queue.stats().submitted + queue.stats().dropped == 40000U);
+	bool sorted = true;
+	for (uint32_t i = 1; i < queue.size(); ++i) {
+		sorted &= queue.items()[i - 1].key <= queue.items()[i].key;
+	}
+	DD25_CHECK(sorted);
+}
+
+//================================================================
+
+//
+// 50k random draws over 8 textures in three lists, recorded from the job
+// system: radix sort against std::stable_sort on the same pairs, and the
+// binds the state filter saves.
+//
+DD25_BENCH(commandQueueSortExecute) {
+	const uint32_t draws = 50000U;
+	CommandQueue queue(draws, 8U << 20);
+	CountingBackend backend;
+
+	auto record = [&] {
+		queue.reset();
+		JobSystem::instance().parallelFor(draws, 512, [&](size_t begin, size_t end) {
+			std::mt19937 rng(static_cast<uint32_t>(begin));
+			for (size_t i = begin; i < end; ++i) {
+				const uint32_t t = rng() % 8U;
+				const RenderList list = static_cast<RenderList>(rng() % 3U);
+				const float depth = static_cast<float>(rng() % 1000U) / 1000.0f;
+				queue.submit(SortKey::make(0, list, depth, 0, t), drawOf(static_cast<uint32_t>(i), t));
+			}
+		});
+	};
+
+	const double recordMs = bench::bestOf(10, record);
+	double sortMs = 1.0e30, executeMs = 1.0e30;
+	uint32_t changes = 0, skipped = 0;
+	for (uint32_t i = 0; i < 10; ++i) {
+		record();
+		backend = CountingBackend();
+		queue.execute(backend);
+		sortMs = std::min<double>(sortMs, queue.stats().sortMs);
+		executeMs = std::min<double>(executeMs, queue.stats().executeMs);
+		changes = queue.stats().stateChanges;
+		skipped = queue.stats().redundantSkipped;
+	}
+
+	record();
+	std::vector<SortPair> pairs(queue.items(), queue.items() + queue.size());
+	std::vector<SortPair> copy;
+	const double stdMs = bench::bestOf(10, [&] {
+		copy = pairs;
+		std::stable_sort(copy.begin(), copy.end(), [](const SortPair& a, const SortPair& b) { return a.key < b.key; });
+	});
+
+	std::printf("  %u draws: record %.3f ms, radix sort %.3f ms (std::stable_sort %.3f ms), execute %.3f ms\n",
+		draws, recordMs, sortMs, stdMs, executeMs);
+	std::printf("  state changes %u, redundant binds skipped %u\n", changes, skipped);
+}
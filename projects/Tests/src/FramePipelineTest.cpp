@@ -0,0 +1,173 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/backend/Software/GBESoftware.hh>
+#include <Engine/gfx/backend/Software/SoftwareFrameBuffer.hh>
+#include <Engine/gfx/backend/Software/SoftwareVertexBuffer.hh>
+#include <Engine/scene/FramePipeline.hh>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr uint32_t	WIDTH		= 640U;
+constexpr uint32_t	HEIGHT		= 480U;
+constexpr uint32_t	GRID		= 24U;
+constexpr float		SPACING		= 3.0f;
+
+// Unit cube, one colour per face
+std::vector<GfxVertex> buildCube() {
+	static const Float3 corners[8] = {
+		{ -0.5f, -0.5f, -0.5f }, { 0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, -0.5f }, { -0.5f, 0.5f, -0.5f },
+		{ -0.5f, -0.5f, 0.5f }, { 0.5f, -0.5f, 0.5f }, { 0.5f, 0.5f, 0.5f }, { -0.5f, 0.5f, 0.5f }
+	};
+	static const uint16_t indices[36] = {
+		0, 2, 1, 0, 3, 2,	4, 5, 6, 4, 6, 7,	0, 1, 5, 0, 5, 4,
+		3, 6, 2, 3, 7, 6,	0, 4, 7, 0, 7, 3,	1, 2, 6, 1, 6, 5
+	};
+	static const uint32_t colors[6] = { 0xFFE04040U, 0xFF40E040U, 0xFF4040E0U, 0xFFE0E040U, 0xFF40E0E0U, 0xFFE040E0U };
+	std::vector<GfxVertex> vertices(36);
+	for (size_t i = 0; i < 36; ++i) {
+		vertices[i] = { corners[indices[i]], colors[i / 6], { 0.0f, 0.0f } };
+	}
+	return vertices;
+}
+
+// Busy work standing in for game logic
+void spin(float ms) {
+	const auto start = bench::Clock::now();
+	while (bench::elapsedMs(start) < ms) {
+	}
+}
+
+//
+// The Game's cube field orbited for `frames` frames, the render side
+// rasterising each packet and then waiting `presentMs` (a vsync), the
+// simulation spending `logicMs` on top of culling and recording.
+// Returns frames per second, `waitMs` gets the simulation's average
+// wait for a free packet.
+//
+double orbit(bool threaded, uint32_t frames, float presentMs, float logicMs, float& waitMs) {
+	const std::vector<GfxVertex> cube = buildCube();
+	SoftwareVertexBuffer cubeBuffer(static_cast<uint32_t>(cube.size()), cube.data());
+	std::vector<Float3> positions;
+	const float half = 0.5f * SPACING * static_cast<float>(GRID - 1U);
+	for (uint32_t z = 0; z < GRID; ++z) {
+		for (uint32_t x = 0; x < GRID; ++x) {
+			positions.push_back({ static_cast<float>(x) * SPACING - half, 0.0f, static_cast<float>(z) * SPACING - half });
+		}
+	}
+
+	Camera camera;
+	camera.setPerspective(1.0f, static_cast<float>(WIDTH) / static_cast<float>(HEIGHT), 0.5f, 200.0f);
+	camera.setViewportSize(WIDTH, HEIGHT);
+
+	GBESoftware gbe;
+	SoftwareFrameBuffer frameBuffer(WIDTH, HEIGHT);
+	FramePipelineSettings settings;
+	settings.threaded = threaded;
+	FramePipeline pipeline([&](FramePacket& packet) {
+		gbe.beginFrame(frameBuffer, 0xFF203040U);
+		gbe.setViewProjection(packet.camera.viewProjection());
+		packet.queue.execute(gbe);
+		gbe.endFrame();
+		std::this_thread::sleep_for(std::chrono::duration<float, std::milli>(presentMs));
+	}, settings);
+
+	waitMs = 0.0f;
+	const auto start = bench::Clock::now();
+	for (uint32_t frame = 0; frame < frames; ++frame) {
+		const float t = static_cast<float>(frame) / 60.0f;
+		FramePacket& packet = pipeline.acquire();
+		waitMs += pipeline.stats().simulateWaitMs;
+
+		const Float3 eye = { std::sin(t * 0.2f) * half * 1.5f, half * 0.6f, std::cos(t * 0.2f) * half * 1.5f };
+		camera.lookAt(eye, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+		packet.camera = camera;
+		for (size_t i = 0; i < positions.size(); ++i) {
+			if (camera.frustum().intersects(Sphere{ positions[i], 0.87f })) {
+				Float4x4 m = Float4x4::identity();
+				m.m[12] = positions[i].x;
+				m.m[13] = positions[i].y;
+				m.m[14] = positions[i].z;
+				packet.transforms.push_back(m);
+			}
+		}
+		for (size_t i = 0; i < packet.transforms.size(); ++i) {
+			const DrawCommand cmd = { nullptr, nullptr, &cubeBuffer, &packet.transforms[i], 0, 36, Primitive::Triangles };
+			packet.queue.submit(SortKey::make(0, RenderList::Opaque, 0.5f, 0, 0), cmd);
+		}
+		spin(logicMs);
+		pipeline.submit();
+	}
+	pipeline.flush();
+	waitMs /= static_cast<float>(frames);
+	return frames / (bench::elapsedMs(start) / 1000.0);
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(framePipelineRendersEveryPacketInOrder) {
+	for (const bool threaded : { false, true }) {
+		std::vector<uint64_t> rendered;
+		bool intact = true;		// Checked after the render side is done with it
+		FramePipelineSettings settings;
+		settings.threaded = threaded;
+		{
+			FramePipeline pipeline([&](FramePacket& packet) {
+				rendered.push_back(packet.frame);
+				intact &= packet.transforms.size() == 1 && packet.transforms[0].m[12] == static_cast<float>(packet.frame);
+			}, settings);
+			for (uint64_t frame = 0; frame < 50; ++frame) {
+				FramePacket& packet = pipeline.acquire();
+				DD25_CHECK(packet.frame == frame && packet.transforms.empty() && packet.queue.size() == 0);
+				Float4x4 m = Float4x4::identity();
+				m.m[12] = static_cast<float>(frame);
+				packet.transforms.push_back(m);
+				pipeline.submit();
+			}
+			pipeline.flush();
+			DD25_CHECK(pipeline.stats().submitted == 50 && pipeline.stats().rendered == 50);
+		}
+		bool ordered = rendered.size() == 50;
+		for (size_t i = 0; ordered && i < rendered.size(); ++i) {
+			ordered = rendered[i] == i;
+		}
+		DD25_CHECK(ordered && intact);
+	}
+}
+
+//================================================================
+
+//
+// Frames per second rendering on the calling thread against the render
+// thread, with the raster alone, behind a 4 ms present wait, and with
+// 3 ms of game logic on top. Overlap pays off as soon as either side
+// waits on something other than the CPU.
+//
+DD25_BENCH(framePipelineThroughput) {
+	struct Case { const char* name; float presentMs; float logicMs; };
+	const Case cases[] = {
+		{ "raster only", 0.0f, 0.0f },
+		{ "+4 ms present", 4.0f, 0.0f },
+		{ "+4 ms present, +3 ms logic", 4.0f, 3.0f },
+	};
+	const uint32_t frames = 300U;
+	for (const Case& c : cases) {
+		float seqWait = 0.0f, thrWait = 0.0f;
+		const double seqFps = orbit(false, frames, c.presentMs, c.logicMs, seqWait);
+		const double thrFps = orbit(true, frames, c.presentMs, c.logicMs, thrWait);
+		std::printf("  %-28s sequential %6.1f fps | render thread %6.1f fps (x%.2f, simulation waits %.2f ms a frame)\n",
+			c.name, seqFps, thrFps, thrFps / seqFps, thrWait);
+	}
+}
@@ -0,0 +1,174 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Editor/LightmapBaker.hh>
+#include <Engine/gfx/Lightmap.hh>
+#include <Engine/gfx/backend/Software/SoftwareTexture.hh>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+// A closed room with two boxes and an emissive ceiling panel
+struct Room {
+	Room() {
+		box({ 0.0f, 0.0f, 0.0f }, { 10.0f, 10.0f, 10.0f }, { 0.7f, 0.7f, 0.7f }, true);
+		box({ 2.0f, 0.0f, 2.0f }, { 5.0f, 6.0f, 5.0f }, { 0.8f, 0.3f, 0.3f }, false);
+		box({ 6.0f, 0.0f, 6.0f }, { 8.0f, 3.0f, 8.0f }, { 0.3f, 0.8f, 0.3f }, false);
+		quad({ 4.0f, 9.99f, 4.0f }, { 6.0f, 9.99f, 4.0f }, { 6.0f, 9.99f, 6.0f }, { 4.0f, 9.99f, 6.0f }, { 0.0f, 0.0f, 0.0f }, { 4.0f, 4.0f, 4.0f });
+
+		lights[0].type = LightmapLightType::Point;
+		lights[0].position = { 5.0f, 8.0f, 5.0f };
+		lights[0].color = { 20.0f, 18.0f, 15.0f };
+		lights[1].direction = normalize(Float3{ 0.3f, -1.0f, 0.2f });
+		lights[1].color = { 0.3f, 0.3f, 0.35f };
+	}
+
+	void quad(Float3 a, Float3 b, Float3 c, Float3 d, Float3 reflect, Float3 emit = { 0.0f, 0.0f, 0.0f }) {
+		const uint32_t first = static_cast<uint32_t>(positions.size());
+		positions.insert(positions.end(), { a, b, c, d });
+		for (uint32_t i : { 0U, 1U, 2U, 0U, 2U, 3U }) {
+			indices.push_back(first + i);
+		}
+		albedo.insert(albedo.end(), { reflect, reflect });
+		emission.insert(emission.end(), { emit, emit });
+	}
+
+	void box(Float3 lo, Float3 hi, Float3 reflect, bool inward) {
+		Float3 v[8];
+		for (uint32_t i = 0; i < 8; ++i) {
+			v[i] = { (i & 1U) ? hi.x : lo.x, (i & 2U) ? hi.y : lo.y, (i & 4U) ? hi.z : lo.z };
+		}
+		const uint32_t faces[6][4] = { { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+		for (const auto& f : faces) {
+			if (inward) {
+				quad(v[f[3]], v[f[2]], v[f[1]], v[f[0]], reflect);
+			} else {
+				quad(v[f[0]], v[f[1]], v[f[2]], v[f[3]], reflect);
+			}
+		}
+	}
+
+	LightmapBakeInput input() const {
+		return { positions.data(), nullptr, indices.data(), indices.size(), albedo.data(), emission.data(), lights, 2 };
+	}
+
+	std::vector<Float3>		positions;
+	std::vector<uint32_t>	indices;
+	std::vector<Float3>		albedo;
+	std::vector<Float3>		emission;
+	LightmapLight			lights[2];
+};
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(lightmapPacketsMatchSingleRays) {
+	const Room room;
+	TriangleBvh bvh;
+	bvh.build(room.positions.data(), room.indices.data(), room.indices.size() / 3U);
+
+	uint32_t mismatches = 0;
+	for (uint32_t i = 0; i < 500; ++i) {
+		RayPacket packet;
+		Ray rays[4];
+		const float tMax[4] = { 1.0e30f, 1.0e30f, 1.0e30f, 1.0e30f };
+		for (uint32_t l = 0; l < 4; ++l) {
+			const Float3 origin = { 1.0f + static_cast<float>(i * 7U % 80U) * 0.1f, 1.0f + static_cast<float>((l * 13U + i) % 80U) * 0.1f, 0.5f + static_cast<float>(i * 3U % 90U) * 0.1f };
+			const float a = static_cast<float>(i), b = static_cast<float>(l);
+			const Float3 dir = normalize(Float3{ std::sin(a * 0.37f + b), std::cos(a * 0.11f + b * 2.0f), std::sin(a * 0.7f - b) });
+			packet.set(l, origin, dir);
+			rays[l] = Ray(origin, dir);
+		}
+		BvhHit hits[4];
+		const uint32_t hitMask = bvh.intersect4(packet, tMax, hits);
+		const uint32_t occludedMask = bvh.occluded4(packet, tMax);
+		for (uint32_t l = 0; l < 4; ++l) {
+			BvhHit hit;
+			const bool single = bvh.intersect(rays[l], 1.0e30f, hit);
+			mismatches += (single != ((hitMask >> l) & 1U) || (single && std::fabs(hit.t - hits[l].t) > 1.0e-4f)) ? 1U : 0U;
+			mismatches += (bvh.occluded(rays[l], 1.0e30f) != ((occludedMask >> l) & 1U)) ? 1U : 0U;
+		}
+	}
+	DD25_CHECK(mismatches == 0);
+}
+
+DD25_TEST(lightmapBakeIsDeterministic) {
+	const Room room;
+	LightmapBakeSettings settings;
+	settings.size = 64;
+	settings.texelsPerUnit = 1.0f;
+	LightmapBakeResult first, second;
+	LightmapBaker baker;
+	DD25_CHECK(baker.bake(room.input(), settings, 2, first));
+	DD25_CHECK(baker.bake(room.input(), settings, 2, second));
+	DD25_CHECK(first.texture.data == second.texture.data);
+	DD25_CHECK(first.uvs.size() == room.indices.size());
+}
+
+DD25_TEST(lightmapBakeBindsAsILightmap) {
+	const Room room;
+	LightmapBakeSettings settings;
+	settings.size = 64;
+	settings.texelsPerUnit = 1.0f;
+	settings.overbright = 4.0f;
+	LightmapBakeResult result;
+	DD25_CHECK(LightmapBaker().bake(room.input(), settings, 1, result));
+
+	// The software backend samples row-order ARGB8888
+	std::vector<uint32_t> argb;
+	DD25_CHECK(TextureCooker::decode(result.texture, argb));
+	const SoftwareTexture texture(result.texture.width, result.texture.height, PixelFormat::ARGB8888, argb.data());
+	const Lightmap lightmap(&texture, result.intensityScale);
+	const ILightmap& bound = lightmap;
+	DD25_CHECK(bound.texture() == &texture);
+	DD25_CHECK(bound.texture()->width() == settings.size);
+	DD25_CHECK(bound.intensityScale() == settings.overbright);
+}
+
+//================================================================
+
+//
+// Four passes over a 256x256 page of the room: rays per second each
+// pass, with every texel's shadow and bounce rays traced as packets.
+//
+DD25_BENCH(lightmapRaysPerSecond) {
+	const Room room;
+	LightmapBakeSettings settings;
+	settings.size = 256;
+	settings.texelsPerUnit = 8.0f;
+	settings.cook.twiddle = true;
+
+	LightmapBaker baker;
+	if (!baker.begin(room.input(), settings)) {
+		std::printf("  begin failed\n");
+		return;
+	}
+	const LightmapBakeStats& stats = baker.stats();
+	std::printf("  %zu triangles, %zu charts, %zu texels at %.2f per unit, charted in %.3f s\n",
+		stats.triangles, stats.charts, stats.texels, stats.texelsPerUnit, stats.chartSeconds);
+
+	uint64_t rays = 0;
+	double seconds = 0.0;
+	for (uint32_t pass = 0; pass < 4; ++pass) {
+		baker.bakePass();
+		std::printf("  pass %u: %.2f Mrays/s (%.3f s)\n", stats.passes,
+			static_cast<double>(stats.rays - rays) / (stats.traceSeconds - seconds) * 1.0e-6, stats.traceSeconds - seconds);
+		rays = stats.rays;
+		seconds = stats.traceSeconds;
+	}
+
+	const auto start = bench::Clock::now();
+	LightmapBakeResult result;
+	TextureCookStats cook;
+	baker.resolve(result, &cook);
+	std::printf("  %llu rays, %.2f Mrays/s overall | resolve %.1f ms, %zu bytes cooked, PSNR %.1f dB\n",
+		static_cast<unsigned long long>(stats.rays), stats.raysPerSecond * 1.0e-6, bench::elapsedMs(start), result.texture.sizeBytes(), cook.psnr);
+}
@@ -0,0 +1,180 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Editor/LodBuilder.hh>
+#include <Engine/gfx/CommandQueue.hh>
+#include <Engine/gfx/backend/Software/SoftwareVertexBuffer.hh>
+#include <Engine/scene/Scene.hh>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr uint32_t	GRID		= 60U;		// Quads per side of the test surface
+constexpr float		FAR			= 400.0f;
+
+// Wavy unit patch, enough curvature that levels carry real error
+struct Patch {
+	std::vector<Float3>		positions;
+	std::vector<Float2>		uvs;
+	std::vector<uint16_t>	indices;
+
+	Patch() {
+		for (uint32_t y = 0; y <= GRID; ++y) {
+			for (uint32_t x = 0; x <= GRID; ++x) {
+				const float fx = static_cast<float>(x) / GRID;
+				const float fy = static_cast<float>(y) / GRID;
+				positions.push_back({ fx - 0.5f, fy - 0.5f, 0.1f * std::sin(fx * 6.0f) * std::cos(fy * 5.0f) });
+				uvs.push_back({ fx, fy });
+			}
+		}
+		for (uint32_t y = 0; y < GRID; ++y) {
+			for (uint32_t x = 0; x < GRID; ++x) {
+				const uint16_t a = static_cast<uint16_t>(y * (GRID + 1U) + x);
+				const uint16_t c = static_cast<uint16_t>(a + GRID + 1U);
+				indices.insert(indices.end(), { a, static_cast<uint16_t>(a + 1U), static_cast<uint16_t>(c + 1U), a, static_cast<uint16_t>(c + 1U), c });
+			}
+		}
+	}
+};
+
+// A patch with its chain built and expanded into a draw buffer
+struct LodFixture {
+	Patch					patch;
+	Mesh					mesh;
+	std::vector<GfxVertex>	vertices;
+	SoftwareVertexBuffer*	buffer = nullptr;
+
+	LodFixture() {
+		mesh.bind(patch.positions.size(), patch.positions.data(), nullptr, patch.uvs.data(), patch.indices.data(), patch.indices.size());
+		LodBuildSettings settings;
+		settings.levels = 6;
+		settings.pixelError = 0.05f;	// The patch is smooth, make the levels switch in on screen
+		LodBuilder().build(mesh, settings);
+		mesh.expandLevels(vertices, 0xFFFFFFFFU);
+		buffer = new SoftwareVertexBuffer(static_cast<uint32_t>(vertices.size()), vertices.data());
+		mesh.setDrawBuffer(buffer);
+	}
+
+	~LodFixture() noexcept { delete buffer; }
+};
+
+Camera makeCamera() {
+	Camera camera;
+	camera.setPerspective(1.0f, 640.0f / 480.0f, 0.5f, FAR);
+	camera.setViewportSize(640, 480);
+	camera.lookAt({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f });
+	return camera;
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(lodChainCoarsens) {
+	LodFixture f;
+	const MeshLodChain& chain = f.mesh.lods();
+	DD25_CHECK(chain.levelCount() > 1);
+	for (size_t i = 1; i < chain.levelCount(); ++i) {
+		DD25_CHECK(chain.triangleCount(i) < chain.triangleCount(i - 1));
+		DD25_CHECK(chain.level(i).screenSize <= chain.level(i - 1).screenSize);
+	}
+}
+
+DD25_TEST(lodRejectsIndicesPastTheVertices) {
+	Patch patch;
+	patch.indices[patch.indices.size() / 2U] = static_cast<uint16_t>(patch.positions.size());
+	const LodSourceMesh src = { patch.positions.data(), nullptr, patch.uvs.data(), patch.positions.size(), patch.indices.data(), patch.indices.size() };
+	MeshLodChain chain;
+	DD25_CHECK(LodBuilder().build(src, {}, chain) == 0);
+	DD25_CHECK(chain.levelCount() == 0);
+}
+
+DD25_TEST(lodSelectsVisibleOnly) {
+	LodFixture f;
+	Scene scene;
+	scene.addObject(&f.mesh, { { 0.0f, 0.0f, 300.0f }, 0.71f });	// Far, in view
+	scene.addObject(&f.mesh, { { 0.0f, 0.0f, -300.0f }, 0.71f });	// Far, behind the camera
+
+	const Camera camera = makeCamera();
+	scene.cull(camera);
+	scene.selectLods(camera);
+
+	DD25_CHECK(scene.visibleObjects().size() == 1);
+	DD25_CHECK(scene.lodStats().objects == 1);
+	DD25_CHECK(scene.objectLod(0) > 0);
+	DD25_CHECK(scene.objectLod(1) == 0);	// Never considered
+}
+
+DD25_TEST(lodSubmitsSelectedLevel) {
+	LodFixture f;
+	Scene scene;
+	scene.addObject(&f.mesh, { { 0.0f, 0.0f, 2.0f }, 0.71f });
+	scene.addObject(&f.mesh, { { 0.0f, 0.0f, 300.0f }, 0.71f });
+
+	const Camera camera = makeCamera();
+	scene.cull(camera);
+	scene.selectLods(camera);
+
+	CommandQueue queue(16, 1U << 12);
+	DD25_CHECK(scene.submit(queue, camera, FAR) == 2);
+	DD25_CHECK(queue.size() == 2);
+
+	// Submitted vertices are the selected levels, one per index
+	uint32_t expected = 0;
+	for (const Scene::ObjectId id : scene.visibleObjects()) {
+		expected += f.mesh.drawCount(scene.objectLod(id));
+	}
+	DD25_CHECK(scene.lodStats().trianglesSubmitted * 3U == expected);
+	DD25_CHECK(scene.lodStats().trianglesSubmitted < scene.lodStats().trianglesFullDetail);
+}
+
+//================================================================
+
+//
+// Triangles submitted per frame against how the objects are spread in
+// depth: the same 256 patches packed near the camera, spread evenly and
+// pushed far away.
+//
+DD25_BENCH(lodTrianglesByDistance) {
+	LodFixture f;
+	const Camera camera = makeCamera();
+	const uint32_t objects = 256U;
+
+	struct Distribution {
+		const char*	name;
+		float		nearest;
+		float		farthest;
+	};
+	const Distribution distributions[] = {
+		{ "near   1-5",	1.0f,	5.0f },
+		{ "even   1-100",	1.0f,	100.0f },
+		{ "far   20-100",	20.0f,	100.0f }
+	};
+
+	std::printf("  %u objects, %u triangles each at level 0, %zu levels\n", objects, f.mesh.lods().triangleCount(0), f.mesh.lods().levelCount());
+	for (const Distribution& d : distributions) {
+		Scene scene;
+		for (uint32_t i = 0; i < objects; ++i) {
+			const float t = static_cast<float>(i) / static_cast<float>(objects - 1U);
+			const float z = d.nearest + (d.farthest - d.nearest) * t;
+			scene.addObject(&f.mesh, { { std::sin(static_cast<float>(i)) * z * 0.3f, 0.0f, z }, 0.71f });
+		}
+		scene.cull(camera);
+		scene.selectLods(camera);
+		const SceneLodStats& stats = scene.lodStats();
+
+		std::printf("  %s: %6u of %6u triangles (%5.1f%%), objects per level:", d.name, stats.trianglesSubmitted,
+			stats.trianglesFullDetail, stats.trianglesFullDetail ? 100.0 * stats.trianglesSubmitted / stats.trianglesFullDetail : 0.0);
+		for (size_t l = 0; l < f.mesh.lods().levelCount(); ++l) {
+			std::printf(" %u", stats.objectsPerLod[l]);
+		}
+		std::printf("\n");
+	}
+}
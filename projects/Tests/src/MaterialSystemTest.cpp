@@ -0,0 +1,124 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/CommandQueue.hh>
+#include <Engine/gfx/IGfxBackend.hh>
+#include <Engine/gfx/MaterialSystem.hh>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+class BindCountingBackend final : public IGfxBackend {
+public:
+	void setPass(uint8_t) override {}
+	void setRenderList(RenderList) override {}
+	void bindMaterial(const IMaterial*) override { ++materials; }
+	void bindTexture(const ITexture*) override {}
+	void bindVertexBuffer(const IVertexBuffer*) override {}
+	void draw(const DrawCommand&) override {}
+
+	uint32_t	materials = 0;
+};
+
+PipelineState translucent(BlendFactor dst) {
+	PipelineState state;
+	state.list = RenderList::Translucent;
+	state.srcBlend = BlendFactor::SrcAlpha;
+	state.dstBlend = dst;
+	state.depthWrite = false;
+	return state;
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(materialDestroyIgnoresForeignAndDouble) {
+	MaterialSystem a(4), b(4);
+	Material* mine = a.create({});
+	Material* theirs = b.create({});
+
+	// Neither may put a slot on a's free list twice
+	a.destroy(theirs);
+	a.destroy(mine);
+	a.destroy(mine);
+	DD25_CHECK(a.stats().materials == 0);
+	DD25_CHECK(b.stats().materials == 1);
+
+	std::vector<Material*> made;
+	for (Material* m = a.create({}); m; m = a.create({})) {
+		made.push_back(m);
+	}
+	DD25_CHECK(made.size() == 4);
+	for (size_t i = 0; i < made.size(); ++i) {
+		for (size_t j = i + 1; j < made.size(); ++j) {
+			DD25_CHECK(made[i] != made[j]);
+		}
+	}
+}
+
+DD25_TEST(materialStatesAreShared) {
+	MaterialSystem system(16);
+	PipelineState fogged;
+	fogged.fog = true;
+	Material* first = system.create(fogged);
+	Material* second = system.create(fogged, { { 0.5f, 0.5f, 0.5f, 1.0f } });
+	DD25_CHECK(first->stateId() == second->stateId());
+	DD25_CHECK(first->sortKey() != second->sortKey());
+	DD25_CHECK(system.stats().uniqueStates == 1 && system.stats().deduplicated == 1);
+}
+
+//================================================================
+
+//
+// Sample scene: 400 materials over six pipeline states, 5000 draws keyed
+// by material slot against keyed by interned state. Reports what the
+// interning shares and the binds each ordering costs.
+//
+DD25_BENCH(materialSystemSampleScene) {
+	MaterialSystem system(1024);
+	PipelineState cutout, fogged, clamped;
+	cutout.list = RenderList::PunchThrough;
+	fogged.fog = true;
+	clamped.wrapU = clamped.wrapV = TextureWrap::Clamp;
+	const PipelineState kinds[6] = { {}, cutout, translucent(BlendFactor::InvSrcAlpha), translucent(BlendFactor::One), fogged, clamped };
+
+	std::mt19937 rng(11);
+	std::vector<Material*> materials;
+	for (uint32_t i = 0; i < 400; ++i) {
+		MaterialParams params;
+		params.color = { static_cast<float>(rng() % 255U) / 255.0f, 1.0f, 1.0f, 1.0f };
+		materials.push_back(system.create(kinds[rng() % 6U], params));
+	}
+	const MaterialSystemStats stats = system.stats();
+	std::printf("  %u materials, %u pipeline states (%u creates shared one), %zu parameter bytes\n",
+		stats.materials, stats.uniqueStates, stats.deduplicated, stats.paramBytes);
+
+	CommandQueue queue(8192);
+	for (const bool byState : { false, true }) {
+		BindCountingBackend backend;
+		std::mt19937 draws(5);
+		queue.reset();
+		for (uint32_t d = 0; d < 5000; ++d) {
+			Material* m = materials[draws() % materials.size()];
+			const uint32_t key = byState ? m->sortKey() : static_cast<uint32_t>(draws() % materials.size());
+			const float depth = static_cast<float>(draws() % 1000U) / 1000.0f;
+			queue.submit(SortKey::make(0, m->state().list, depth, key, draws() % 8U), { m, nullptr, nullptr, nullptr, 0, 3, Primitive::Triangles });
+		}
+		queue.execute(backend);
+		std::printf("  %-18s %u draws: %u state changes, %u material binds, %u pipeline changes\n",
+			byState ? "state-id keys:" : "per-material keys:", queue.stats().draws, queue.stats().stateChanges, backend.materials, queue.stats().pipelineChanges);
+	}
+
+	for (size_t i = 0; i < materials.size(); i += 2) {
+		system.destroy(materials[i]);
+	}
+	std::printf("  after destroying half: %u materials, %u pipeline states\n", system.stats().materials, system.stats().uniqueStates);
+}
@@ -0,0 +1,154 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/math/simd.hh>
+#include <Engine/scene/Scene.hh>
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+// Unit wall in x/z, facing y, scaled and placed per occluder
+const Float3 WALL_POSITIONS[4] = { { -0.5f, 0.0f, 0.0f }, { 0.5f, 0.0f, 0.0f }, { 0.5f, 0.0f, 1.0f }, { -0.5f, 0.0f, 1.0f } };
+const uint16_t WALL_INDICES[6] = { 0, 1, 2, 0, 2, 3 };
+
+Float4x4 placeWall(float x, float y, float width, float height) {
+	Float4x4 m = Float4x4::identity();
+	m.m[0] = width;
+	m.m[10] = height;
+	m.m[12] = x;
+	m.m[13] = y;
+	return m;
+}
+
+//
+// A street of walls in front of a grid of small objects, seen from
+// eye height. Returns the camera.
+//
+Camera buildStreet(Scene& scene, Mesh& wall, uint32_t rows) {
+	wall.bind(4, WALL_POSITIONS, nullptr, nullptr, WALL_INDICES, 6);
+	scene.setOcclusionCulling(true);
+	for (uint32_t r = 0; r < rows; ++r) {
+		const float y = 15.0f + 12.0f * static_cast<float>(r);
+		const float x = (r & 1U) ? 12.0f : -12.0f;
+		scene.occlusion().addOccluder(&wall, placeWall(x, y, 30.0f, 8.0f));
+	}
+	for (int32_t y = 5; y <= 120; y += 2) {
+		for (int32_t x = -40; x <= 40; x += 2) {
+			scene.addObject(&wall, { { static_cast<float>(x), static_cast<float>(y), 2.0f }, 0.8f });
+		}
+	}
+
+	Camera camera;
+	camera.setViewportSize(640, 480);
+	camera.setPerspective(1.2f, 640.0f / 480.0f, 0.1f, 200.0f);
+	camera.lookAt({ 0.0f, 0.0f, 3.0f }, { 0.0f, 40.0f, 3.0f }, { 0.0f, 0.0f, 1.0f });
+	return camera;
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(simdMatchesSse2Semantics) {
+	alignas(16) const float in[4] = { 0.5f, 1.5f, 2.5f, -2.5f };
+	alignas(16) int32_t out[4];
+	simdStore(out, simdToInt(simdLoad(in)));
+	DD25_CHECK(out[0] == 0 && out[1] == 2 && out[2] == 2 && out[3] == -2);
+
+	alignas(16) const float num[4] = { 1.0f, 2.0f, 10.0f, -7.0f };
+	alignas(16) const float den[4] = { 3.0f, 7.0f, 3.0f, 9.0f };
+	alignas(16) float q[4];
+	simdStore(q, simdLoad(num) / simdLoad(den));
+	for (size_t i = 0; i < 4; ++i) {
+		DD25_CHECK(q[i] == num[i] / den[i]);
+	}
+
+	// NaN in either lane gives the second operand, 0 * inf in a slab test included
+	const float nan = 0.0f * std::numeric_limits<float>::infinity();
+	alignas(16) const float a[4] = { nan, 1.0f, nan, -1.0f };
+	alignas(16) const float b[4] = { 2.0f, nan, -2.0f, nan };
+	alignas(16) float lo[4], hi[4];
+	simdStore(lo, simdMin(simdLoad(a), simdLoad(b)));
+	simdStore(hi, simdMax(simdLoad(a), simdLoad(b)));
+	DD25_CHECK(lo[0] == 2.0f && std::isnan(lo[1]) && lo[2] == -2.0f && std::isnan(lo[3]));
+	DD25_CHECK(hi[0] == 2.0f && std::isnan(hi[1]) && hi[2] == -2.0f && std::isnan(hi[3]));
+}
+
+DD25_TEST(occlusionOnlyCullsBehindWalls) {
+	Scene scene;
+	Mesh wall;
+	wall.bind(4, WALL_POSITIONS, nullptr, nullptr, WALL_INDICES, 6);
+	scene.setOcclusionCulling(true);
+	scene.occlusion().addOccluder(&wall, placeWall(0.0f, 20.0f, 40.0f, 10.0f));
+	for (int32_t y = 5; y <= 60; y += 2) {
+		for (int32_t x = -30; x <= 30; x += 2) {
+			scene.addObject(&wall, { { static_cast<float>(x), static_cast<float>(y), 2.0f }, 0.8f });
+		}
+	}
+
+	Camera camera;
+	camera.setViewportSize(640, 480);
+	camera.setPerspective(1.2f, 640.0f / 480.0f, 0.1f, 200.0f);
+	camera.lookAt({ 0.0f, 0.0f, 3.0f }, { 0.0f, 40.0f, 3.0f }, { 0.0f, 0.0f, 1.0f });
+	scene.cull(camera);
+
+	std::vector<bool> visible(scene.objectCount(), false);
+	for (const Scene::ObjectId id : scene.visibleObjects()) {
+		visible[id] = true;
+	}
+	uint32_t frontCulled = 0;
+	for (size_t i = 0; i < scene.objectCount(); ++i) {
+		const Sphere& b = scene.objectBounds(static_cast<Scene::ObjectId>(i));
+		if (camera.frustum().intersects(b) && !visible[i] && b.center.y < 20.0f + b.radius) {
+			++frontCulled;
+		}
+	}
+	DD25_CHECK(scene.visStats().occlusionCulled > 0);
+	DD25_CHECK(frontCulled == 0);
+}
+
+DD25_TEST(occlusionHugeTriangle) {
+	// An occluder reaching far past the screen and right up to the eye
+	Scene scene;
+	Mesh wall;
+	wall.bind(4, WALL_POSITIONS, nullptr, nullptr, WALL_INDICES, 6);
+	scene.setOcclusionCulling(true);
+	scene.occlusion().addOccluder(&wall, placeWall(0.0f, 0.2f, 1.0e6f, 1.0e6f));
+	scene.addObject(&wall, { { 0.0f, 50.0f, 2.0f }, 0.8f });
+
+	Camera camera;
+	camera.setViewportSize(640, 480);
+	camera.setPerspective(1.2f, 640.0f / 480.0f, 0.1f, 200.0f);
+	camera.lookAt({ 0.0f, 0.0f, 3.0f }, { 0.0f, 40.0f, 3.0f }, { 0.0f, 0.0f, 1.0f });
+	scene.cull(camera);
+	DD25_CHECK(scene.visibleObjects().empty());
+}
+
+//================================================================
+
+DD25_BENCH(occlusionStreet) {
+	for (const uint32_t rows : { 1U, 4U, 8U }) {
+		Scene scene;
+		Mesh wall;
+		const Camera camera = buildStreet(scene, wall, rows);
+
+		double rasterMs = 0.0, testMs = 0.0;
+		const double frameMs = bench::bestOf(20, [&] {
+			scene.cull(camera);
+			rasterMs = scene.occlusion().stats().rasterMs;
+			testMs = scene.occlusion().stats().testMs;
+		});
+		const SceneVisStats& vis = scene.visStats();
+		const OcclusionStats& occ = scene.occlusion().stats();
+		std::printf("  %u walls: %u objects, %u in frustum, %u drawn, %.1f%% of tested culled | cull %.3f ms best (last run: raster %.3f, test %.3f)\n",
+			rows, vis.objects, vis.frustumVisible, vis.submitted, occ.culledPercent(), frameMs, rasterMs, testMs);
+	}
+}
@@ -0,0 +1,140 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/PostChain.hh>
+#include <Engine/gfx/PostEffects.hh>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+// Ramps with a few white squares for bloom to catch
+std::vector<uint32_t> testImage(uint32_t width, uint32_t height) {
+	std::vector<uint32_t> image(static_cast<size_t>(width) * height);
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			uint32_t r = x * 255U / width, g = y * 255U / height, b = (x * 7U + y * 3U) & 255U;
+			if (((x / 40U) + (y / 40U)) % 7U == 0) {
+				r = g = b = 255U;
+			}
+			image[static_cast<size_t>(y) * width + x] = 0x80000000U | r << 16 | g << 8 | b;
+		}
+	}
+	return image;
+}
+
+// The five stock effects, set up as a game might
+struct Effects {
+	Effects() {
+		ColorGrade look;
+		look.exposure = 0.2f;
+		look.contrast = 1.1f;
+		look.saturation = 0.8f;
+		look.tint = { 1.0f, 0.95f, 0.9f };
+		grade.setGrade(look, 16);
+		fade.setAmount(0.25f);
+		crt.setScanlines(0.4f, 2);
+		crt.setMask(0.2f);
+		crt.setVignette(0.5f);
+		const uint32_t colors[4] = { 0xFF0F380FU, 0xFF306230U, 0xFF8BAC0FU, 0xFF9BBC0FU };
+		palette.setPalette(colors, 4);
+		palette.setDither(true);
+		palette.setAmount(0.5f);
+	}
+
+	void addTo(PostChain& chain) {
+		for (IVisualFX* effect : { static_cast<IVisualFX*>(&bloom), static_cast<IVisualFX*>(&grade), static_cast<IVisualFX*>(&fade),
+				static_cast<IVisualFX*>(&crt), static_cast<IVisualFX*>(&palette) }) {
+			chain.add(effect);
+		}
+	}
+
+	BloomFX			bloom;
+	ColorGradeFX	grade;
+	FadeFX			fade;
+	CrtFX			crt;
+	PaletteFX		palette;
+};
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(postChainFusedMatchesUnfused) {
+	// Unfused clamps and rounds to 8 bits between passes; bloom's overbright and palette snapping are left out
+	const uint32_t w = 203, h = 77;
+	const std::vector<uint32_t> source = testImage(w, h);
+	std::vector<uint32_t> fused(source.size()), unfused(source.size());
+	Effects effects;
+	PostChain chain;
+	chain.add(&effects.grade);
+	chain.add(&effects.fade);
+	chain.add(&effects.crt);
+
+	const PostImage src = { const_cast<uint32_t*>(source.data()), w, h, w * 4U };
+	DD25_CHECK(chain.apply(src, { fused.data(), w, h, w * 4U }));
+	const uint32_t fusedPasses = chain.stats().passes;
+	chain.setSettings({ false, 1U << 20 });
+	DD25_CHECK(chain.apply(src, { unfused.data(), w, h, w * 4U }));
+	DD25_CHECK(fusedPasses == 1 && chain.stats().passes == 3);
+
+	int worst = 0;
+	for (size_t i = 0; i < fused.size(); ++i) {
+		for (uint32_t shift = 0; shift < 32; shift += 8) {
+			worst = std::max(worst, std::abs(static_cast<int>((fused[i] >> shift) & 255U) - static_cast<int>((unfused[i] >> shift) & 255U)));
+		}
+	}
+	DD25_CHECK(worst <= 1);
+}
+
+DD25_TEST(postChainDropsWhatDoesNotFit) {
+	// Bloom's targets can't fit, the fade after it still runs, once per frame
+	const uint32_t w = 640, h = 480;
+	const std::vector<uint32_t> source = testImage(w, h);
+	std::vector<uint32_t> out(source.size());
+	Effects effects;
+	PostChain chain({ true, 1000U });
+	chain.add(&effects.bloom);
+	chain.add(&effects.fade);
+	for (uint32_t frame = 0; frame < 3; ++frame) {
+		DD25_CHECK(chain.apply({ const_cast<uint32_t*>(source.data()), w, h, w * 4U }, { out.data(), w, h, w * 4U }));
+		DD25_CHECK(chain.stats().skipped == 1 && chain.stats().effects == 1 && chain.stats().passes == 1);
+		DD25_CHECK(chain.pool().stats().targets == 0);
+	}
+	DD25_CHECK(out[0] != source[0]);
+}
+
+//================================================================
+
+//
+// The five stock effects at 640x480 and 1920x1080, fused into as few
+// passes as their inputs allow against one pass per effect.
+//
+DD25_BENCH(postChainFusedVsUnfused) {
+	Effects effects;
+	for (const auto& [w, h] : { std::make_pair(640U, 480U), std::make_pair(1920U, 1080U) }) {
+		const std::vector<uint32_t> source = testImage(w, h);
+		std::vector<uint32_t> out(source.size());
+		const PostImage src = { const_cast<uint32_t*>(source.data()), w, h, w * 4U };
+		const PostImage dst = { out.data(), w, h, w * 4U };
+
+		PostChain chain({ true, 4U << 20 });
+		effects.addTo(chain);
+		for (const bool fuse : { true, false }) {
+			chain.setSettings({ fuse, 4U << 20 });
+			float prepareMs = 0.0f;
+			const double ms = bench::bestOf(10, [&] {
+				chain.apply(src, dst);
+				prepareMs = chain.stats().prepareMs;
+			});
+			std::printf("  %4ux%-4u %-7s %7.2f ms, %u passes over %u tiles (last prepare %.2f ms), pool peak %zu bytes\n",
+				w, h, fuse ? "fused" : "unfused", ms, chain.stats().passes, chain.stats().tiles, prepareMs, chain.pool().peakBytes());
+		}
+	}
+}
@@ -0,0 +1,213 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/RenderTargetPool.hh>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr RenderTargetDesc FULL		= { 64, 64, PixelFormat::ARGB8888 };	// 16 KB
+constexpr RenderTargetDesc HALF		= { 32, 32, PixelFormat::ARGB8888 };	// 4 KB
+constexpr RenderTargetDesc WIDE		= { 128, 64, PixelFormat::ARGB8888 };	// 32 KB
+constexpr size_t FULL_BYTES			= 64U * 64U * 4U;
+constexpr size_t HALF_BYTES			= 32U * 32U * 4U;
+constexpr size_t WIDE_BYTES			= 128U * 64U * 4U;
+
+// Declare a target used from pass `first` to `last`
+RenderTargetId declareUsed(RenderTargetPool& pool, const RenderTargetDesc& desc, uint32_t first, uint32_t last) {
+	const RenderTargetId id = pool.declare(desc);
+	pool.use(id, first);
+	pool.use(id, last);
+	return id;
+}
+
+// Fill the whole target, so a surface smaller than its target shows up under a sanitizer
+void clear(RenderTarget* target, uint8_t value) {
+	std::memset(target->data(), value, target->stride() * target->height());
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(renderTargetsAliasDisjointLifetimes) {
+	RenderTargetPool pool;
+	pool.beginFrame();
+	const RenderTargetId a = declareUsed(pool, FULL, 0, 1);
+	const RenderTargetId b = declareUsed(pool, FULL, 2, 3);
+	const RenderTargetId c = declareUsed(pool, HALF, 4, 4);		// Takes the front of the same surface
+	DD25_CHECK(pool.compile());
+
+	DD25_CHECK(pool.target(a) && pool.target(a)->pixels() == pool.target(b)->pixels());
+	DD25_CHECK(pool.target(c) && pool.target(c)->pixels() == pool.target(a)->pixels());
+	DD25_CHECK(pool.target(c)->width() == HALF.width);
+	DD25_CHECK(pool.stats().surfaces == 1);
+	DD25_CHECK(pool.stats().aliased == 2);
+	DD25_CHECK(pool.stats().requestedBytes == FULL_BYTES * 2U + HALF_BYTES);
+	DD25_CHECK(pool.stats().usedBytes == FULL_BYTES);
+	DD25_CHECK(pool.allocatedBytes() == FULL_BYTES);
+}
+
+DD25_TEST(renderTargetsKeepOverlappingLifetimesApart) {
+	RenderTargetPool pool;
+	pool.beginFrame();
+	const RenderTargetId a = declareUsed(pool, FULL, 0, 2);
+	const RenderTargetId b = declareUsed(pool, FULL, 2, 3);		// Shares pass 2 with `a`
+	const RenderTargetId c = declareUsed(pool, HALF, 1, 1);		// Inside `a`'s lifetime
+	DD25_CHECK(pool.compile());
+
+	const void* pa = pool.target(a)->pixels();
+	const void* pb = pool.target(b)->pixels();
+	const void* pc = pool.target(c)->pixels();
+	DD25_CHECK(pa != pb && pa != pc);
+	DD25_CHECK(pool.stats().surfaces == 2);
+	DD25_CHECK(pool.stats().aliased == 1);		// `c` fits in `b`'s surface before pass 2
+	DD25_CHECK(pc == pb);
+	DD25_CHECK(pool.allocatedBytes() == FULL_BYTES * 2U);
+}
+
+DD25_TEST(renderTargetsUnusedGetNoMemory) {
+	RenderTargetPool pool;
+	pool.beginFrame();
+	const RenderTargetId used = declareUsed(pool, HALF, 0, 0);
+	const RenderTargetId unused = pool.declare(WIDE);
+	DD25_CHECK(pool.compile());
+
+	DD25_CHECK(pool.target(used) != nullptr);
+	DD25_CHECK(pool.target(unused) == nullptr);
+	DD25_CHECK(pool.target(RenderTargetPool::INVALID) == nullptr);
+	DD25_CHECK(pool.stats().targets == 2);
+	DD25_CHECK(pool.stats().culled == 1);
+	DD25_CHECK(pool.stats().requestedBytes == HALF_BYTES);
+	DD25_CHECK(pool.allocatedBytes() == HALF_BYTES);
+}
+
+DD25_TEST(renderTargetsOverBudgetAllocateNothing) {
+	RenderTargetPool pool({ FULL_BYTES + HALF_BYTES, 8U });
+	pool.beginFrame();
+	declareUsed(pool, HALF, 0, 0);
+	DD25_CHECK(pool.compile());
+	DD25_CHECK(pool.allocatedBytes() == HALF_BYTES);
+
+	// Two full targets at once can't fit, and the pool is left as it was
+	pool.beginFrame();
+	const RenderTargetId a = declareUsed(pool, FULL, 0, 1);
+	const RenderTargetId b = declareUsed(pool, FULL, 1, 2);
+	DD25_CHECK(!pool.compile());
+	DD25_CHECK(pool.stats().overBudget);
+	DD25_CHECK(pool.target(a) == nullptr && pool.target(b) == nullptr);
+	DD25_CHECK(pool.allocatedBytes() == HALF_BYTES);
+	DD25_CHECK(pool.peakBytes() == HALF_BYTES);
+
+	// Declared again without the overlap they alias and fit
+	pool.redeclare();
+	const RenderTargetId c = declareUsed(pool, FULL, 0, 1);
+	const RenderTargetId d = declareUsed(pool, FULL, 2, 2);
+	DD25_CHECK(pool.compile());
+	DD25_CHECK(!pool.stats().overBudget);
+	DD25_CHECK(pool.stats().targets == 2);
+	DD25_CHECK(pool.target(c) && pool.target(c)->pixels() == pool.target(d)->pixels());
+	DD25_CHECK(pool.allocatedBytes() == FULL_BYTES + HALF_BYTES);
+}
+
+DD25_TEST(renderTargetsFreeIdleSurfacesForNewOnes) {
+	RenderTargetPool pool({ WIDE_BYTES + HALF_BYTES + HALF_BYTES, 8U });
+	pool.beginFrame();
+	declareUsed(pool, FULL, 0, 1);
+	declareUsed(pool, HALF, 0, 1);
+	DD25_CHECK(pool.compile());
+	DD25_CHECK(pool.stats().surfacesCreated == 2);
+	DD25_CHECK(pool.allocatedBytes() == FULL_BYTES + HALF_BYTES);
+
+	// The idle full surface has to go for the wide one, which moves into its place
+	pool.beginFrame();
+	const RenderTargetId half = declareUsed(pool, HALF, 0, 0);
+	const RenderTargetId wide = declareUsed(pool, WIDE, 0, 1);
+	DD25_CHECK(pool.compile());
+	DD25_CHECK(pool.stats().surfacesCreated == 1);
+	DD25_CHECK(pool.stats().surfacesFreed == 1);
+	DD25_CHECK(pool.allocatedBytes() == WIDE_BYTES + HALF_BYTES);
+	DD25_CHECK(pool.peakBytes() == WIDE_BYTES + HALF_BYTES);
+	RenderTarget* w = pool.target(wide);
+	RenderTarget* h = pool.target(half);
+	DD25_CHECK(w && h && w->pixels() != h->pixels());
+	clear(w, 0x11);
+	clear(h, 0x22);
+	DD25_CHECK(static_cast<const uint8_t*>(w->pixels())[WIDE_BYTES - 1U] == 0x11);
+}
+
+DD25_TEST(renderTargetsTrackPeakAndIdleFrees) {
+	RenderTargetPool pool({ 1U << 20, 2U });
+	pool.beginFrame();
+	declareUsed(pool, FULL, 0, 1);
+	declareUsed(pool, FULL, 1, 2);
+	declareUsed(pool, HALF, 0, 2);
+	DD25_CHECK(pool.compile());
+	DD25_CHECK(pool.peakBytes() == FULL_BYTES * 2U + HALF_BYTES);
+
+	// A steady smaller frame reuses what is there and allocates nothing new
+	for (uint32_t frame = 0; frame < 2; ++frame) {
+		pool.beginFrame();
+		declareUsed(pool, HALF, 0, 0);
+		DD25_CHECK(pool.compile());
+		DD25_CHECK(pool.stats().surfacesCreated == 0);
+	}
+	DD25_CHECK(pool.allocatedBytes() == FULL_BYTES * 2U + HALF_BYTES);
+
+	// Unused for more than idleFrames frames, the full surfaces go
+	pool.beginFrame();
+	DD25_CHECK(pool.stats().surfacesFreed == 2);
+	DD25_CHECK(pool.allocatedBytes() == HALF_BYTES);
+	DD25_CHECK(pool.peakBytes() == FULL_BYTES * 2U + HALF_BYTES);
+
+	declareUsed(pool, FULL, 0, 0);
+	DD25_CHECK(pool.compile());
+	pool.trim();
+	DD25_CHECK(pool.allocatedBytes() == FULL_BYTES);
+	DD25_CHECK(pool.target(0) != nullptr);
+}
+
+//================================================================
+
+//
+// A post chain's worth of targets declared and compiled every frame:
+// compile time, and the memory aliasing saves over one surface per
+// target.
+//
+DD25_BENCH(renderTargetPoolCompile) {
+	constexpr uint32_t FRAMES = 10000U;
+	const RenderTargetDesc chain[] = {
+		{ 640, 480, PixelFormat::RGB565 },		// Scene copy
+		{ 320, 240, PixelFormat::RGB565 },		// Bloom down
+		{ 160, 120, PixelFormat::RGB565 },
+		{ 80, 60, PixelFormat::RGB565 },
+		{ 160, 120, PixelFormat::RGB565 },		// Bloom up
+		{ 320, 240, PixelFormat::RGB565 },
+		{ 640, 480, PixelFormat::RGB565 },		// Tone map
+		{ 640, 480, PixelFormat::RGB565 }		// FXAA
+	};
+	RenderTargetPool pool;
+
+	const auto start = bench::Clock::now();
+	for (uint32_t frame = 0; frame < FRAMES; ++frame) {
+		pool.beginFrame();
+		uint32_t pass = 0;
+		for (const RenderTargetDesc& desc : chain) {
+			declareUsed(pool, desc, pass, pass + 1U);		// Written by one pass, read by the next
+			++pass;
+		}
+		pool.compile();
+	}
+	const double ms = bench::elapsedMs(start);
+
+	const RenderTargetPoolStats& stats = pool.stats();
+	std::printf("  %u targets: %.2f us per frame, %u surfaces, %u aliased, %zu of %zu bytes (peak %zu)\n", stats.targets,
+		ms * 1000.0 / FRAMES, stats.surfaces, stats.aliased, stats.usedBytes, stats.requestedBytes, pool.peakBytes());
+}
@@ -0,0 +1,305 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Editor/LodBuilder.hh>
+#include <Editor/SceneWriter.hh>
+#include <Engine/scene/Scene.hh>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr const char* SCENE_PATH	= "dd25_test_scene.dds";
+constexpr const char* TEXT_PATH		= "dd25_test_scene.txt";
+
+struct Grid {
+	std::vector<Float3>		positions;
+	std::vector<Float3>		normals;
+	std::vector<Float2>		uvs;
+	std::vector<uint16_t>	indices;
+
+	explicit Grid(uint32_t quads) {
+		for (uint32_t y = 0; y <= quads; ++y) {
+			for (uint32_t x = 0; x <= quads; ++x) {
+				positions.push_back({ static_cast<float>(x), static_cast<float>(y), 0.1f * static_cast<float>((x * y) % 3U) });
+				normals.push_back({ 0.0f, 0.0f, 1.0f });
+				uvs.push_back({ static_cast<float>(x) / quads, static_cast<float>(y) / quads });
+			}
+		}
+		for (uint32_t y = 0; y < quads; ++y) {
+			for (uint32_t x = 0; x < quads; ++x) {
+				const uint16_t a = static_cast<uint16_t>(y * (quads + 1U) + x);
+				const uint16_t c = static_cast<uint16_t>(a + quads + 1U);
+				indices.insert(indices.end(), { a, static_cast<uint16_t>(a + 1U), static_cast<uint16_t>(c + 1U), a, static_cast<uint16_t>(c + 1U), c });
+			}
+		}
+	}
+
+	inline LodSourceMesh source() const noexcept {
+		return { positions.data(), normals.data(), uvs.data(), positions.size(), indices.data(), indices.size() };
+	}
+};
+
+// Two rooms joined by one portal
+CellVisibility twoRooms(uint32_t firstPortal, uint32_t target) {
+	std::vector<VisCell> cells = {
+		{ { { 0.0f, 0.0f, 0.0f }, { 10.0f, 10.0f, 4.0f } }, firstPortal, 1U },
+		{ { { 10.0f, 0.0f, 0.0f }, { 20.0f, 10.0f, 4.0f } }, 0U, 0U }
+	};
+	std::vector<VisPortal> portals = {
+		{ { { 10.0f, 4.0f, 0.0f }, { 10.0f, 6.0f, 0.0f }, { 10.0f, 6.0f, 3.0f }, { 10.0f, 4.0f, 3.0f } }, target }
+	};
+	std::vector<uint32_t> pvs(2U * CellVisibility::rowWords(2U), 0x3U);
+	CellVisibility vis;
+	vis.assign(std::move(cells), std::move(portals), std::move(pvs));
+	return vis;
+}
+
+bool loads(const SceneWriter& writer) {
+	if (!writer.write(SCENE_PATH)) {
+		return false;
+	}
+	Scene scene;
+	const bool ok = scene.load(SCENE_PATH);
+	std::remove(SCENE_PATH);
+	return ok;
+}
+
+// Patch a field of the first mesh record of a serialized file
+bool loadsWithMeshPatch(const SceneWriter& writer, size_t fieldOffset, uint32_t value) {
+	std::vector<uint8_t> bytes;
+	writer.serialize(bytes);
+	SceneFileHeader hdr;
+	std::memcpy(&hdr, bytes.data(), sizeof(hdr));
+	for (uint16_t i = 0; i < hdr.sectionCount; ++i) {
+		SceneSectionEntry e;
+		std::memcpy(&e, bytes.data() + sizeof(hdr) + i * sizeof(e), sizeof(e));
+		if (e.type == static_cast<uint32_t>(SceneSection::Meshes)) {
+			std::memcpy(bytes.data() + e.offset + fieldOffset, &value, sizeof(value));
+		}
+	}
+
+	FILE* f = std::fopen(SCENE_PATH, "wb");
+	if (!f) {
+		return false;
+	}
+	std::fwrite(bytes.data(), 1, bytes.size(), f);
+	std::fclose(f);
+	Scene scene;
+	const bool ok = scene.load(SCENE_PATH);
+	std::remove(SCENE_PATH);
+	return ok;
+}
+
+//----------------------------------------------------------------
+
+//
+// The loader the file format replaces: a text dump read back with
+// stdio, every mesh's arrays allocated as they are parsed.
+//
+struct NaiveMesh {
+	std::vector<Float3>		positions;
+	std::vector<Float3>		normals;
+	std::vector<Float2>		uvs;
+	std::vector<uint16_t>	indices;
+	Mesh					mesh;
+};
+
+struct NaiveScene {
+	std::vector<std::unique_ptr<NaiveMesh>>	meshes;
+	std::vector<Sphere>						bounds;
+	std::vector<uint32_t>					objMeshes;
+};
+
+void writeText(const char* path, const Grid& grid, uint32_t meshes, uint32_t objects) {
+	FILE* f = std::fopen(path, "w");
+	if (!f) {
+		return;
+	}
+	std::fprintf(f, "meshes %u\n", meshes);
+	for (uint32_t m = 0; m < meshes; ++m) {
+		std::fprintf(f, "mesh %zu %zu\n", grid.positions.size(), grid.indices.size());
+		for (size_t v = 0; v < grid.positions.size(); ++v) {
+			const Float3& p = grid.positions[v];
+			const Float3& n = grid.normals[v];
+			const Float2& t = grid.uvs[v];
+			std::fprintf(f, "%g %g %g %g %g %g %g %g\n", p.x, p.y, p.z, n.x, n.y, n.z, t.x, t.y);
+		}
+		for (const uint16_t i : grid.indices) {
+			std::fprintf(f, "%u\n", i);
+		}
+	}
+	std::fprintf(f, "objects %u\n", objects);
+	for (uint32_t o = 0; o < objects; ++o) {
+		std::fprintf(f, "%u %g %g %g %g\n", o % meshes, static_cast<float>(o), 0.0f, 0.0f, 30.0f);
+	}
+	std::fclose(f);
+}
+
+bool readText(const char* path, NaiveScene& scene) {
+	FILE* f = std::fopen(path, "r");
+	if (!f) {
+		return false;
+	}
+	unsigned meshes = 0, objects = 0;
+	if (std::fscanf(f, "meshes %u\n", &meshes) != 1) {
+		std::fclose(f);
+		return false;
+	}
+	for (unsigned m = 0; m < meshes; ++m) {
+		size_t vcount = 0, icount = 0;
+		if (std::fscanf(f, "mesh %zu %zu\n", &vcount, &icount) != 2) {
+			std::fclose(f);
+			return false;
+		}
+		std::unique_ptr<NaiveMesh> mesh(new NaiveMesh);
+		for (size_t v = 0; v < vcount; ++v) {
+			Float3 p, n;
+			Float2 t;
+			std::fscanf(f, "%f %f %f %f %f %f %f %f\n", &p.x, &p.y, &p.z, &n.x, &n.y, &n.z, &t.x, &t.y);
+			mesh->positions.push_back(p);
+			mesh->normals.push_back(n);
+			mesh->uvs.push_back(t);
+		}
+		for (size_t i = 0; i < icount; ++i) {
+			unsigned id = 0;
+			std::fscanf(f, "%u\n", &id);
+			mesh->indices.push_back(static_cast<uint16_t>(id));
+		}
+		mesh->mesh.bind(vcount, mesh->positions.data(), mesh->normals.data(), mesh->uvs.data(), mesh->indices.data(), icount);
+		scene.meshes.push_back(std::move(mesh));
+	}
+	std::fscanf(f, "objects %u\n", &objects);
+	for (unsigned o = 0; o < objects; ++o) {
+		unsigned mesh = 0;
+		Sphere s;
+		std::fscanf(f, "%u %f %f %f %f\n", &mesh, &s.center.x, &s.center.y, &s.center.z, &s.radius);
+		scene.objMeshes.push_back(mesh);
+		scene.bounds.push_back(s);
+	}
+	std::fclose(f);
+	return true;
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(sceneFileRoundTrip) {
+	const Grid grid(16);
+	MeshLodChain chain;
+	LodBuilder().build(grid.source(), LodBuildSettings{}, chain);
+
+	SceneWriter writer;
+	const uint32_t mesh = writer.addMesh("grid", grid.source(), &chain);
+	writer.addObject("a", mesh, { { 1.0f, 2.0f, 3.0f }, 4.0f });
+	writer.addObject("b", mesh, { { 5.0f, 6.0f, 7.0f }, 8.0f });
+	writer.setVisibility(twoRooms(0U, 1U));
+	DD25_CHECK(writer.write(SCENE_PATH));
+
+	Scene scene;
+	DD25_CHECK(scene.load(SCENE_PATH));
+	std::remove(SCENE_PATH);
+	DD25_CHECK(scene.objectCount() == 2);
+	const Scene::ObjectId b = scene.findObject(StringId("b"));
+	DD25_CHECK(b == 1);
+	DD25_CHECK(scene.objectBounds(b).radius == 8.0f);
+	const Mesh* m = scene.objectMesh(b);
+	DD25_CHECK(m && m->vertexCount() == grid.positions.size());
+	DD25_CHECK(m && m->lods().levelCount() == chain.levelCount());
+	DD25_CHECK(scene.visibility().cellCount() == 2);
+}
+
+DD25_TEST(sceneFileRejectsBadIndices) {
+	Grid grid(4);
+	grid.indices[7] = static_cast<uint16_t>(grid.positions.size());	// One past the last vertex
+	SceneWriter writer;
+	writer.addObject("a", writer.addMesh("grid", grid.source()), { { 0.0f, 0.0f, 0.0f }, 1.0f });
+	DD25_CHECK(!loads(writer));
+}
+
+DD25_TEST(sceneFileRejectsWrappingRanges) {
+	const Grid grid(4);
+	SceneWriter writer;
+	writer.addObject("a", writer.addMesh("grid", grid.source()), { { 0.0f, 0.0f, 0.0f }, 1.0f });
+	DD25_CHECK(loadsWithMeshPatch(writer, offsetof(SceneMeshRecord, firstVertex), 0U));
+	DD25_CHECK(!loadsWithMeshPatch(writer, offsetof(SceneMeshRecord, firstVertex), 0xFFFFFFF0U));
+	DD25_CHECK(!loadsWithMeshPatch(writer, offsetof(SceneMeshRecord, firstLodIndex), 0xFFFFFFF0U));
+	DD25_CHECK(!loadsWithMeshPatch(writer, offsetof(SceneMeshRecord, firstLod), 0xFFFFFFFFU));
+}
+
+DD25_TEST(sceneFileRejectsBadPortals) {
+	const Grid grid(4);
+	for (const bool badTarget : { false, true }) {
+		SceneWriter writer;
+		writer.addObject("a", writer.addMesh("grid", grid.source()), { { 0.0f, 0.0f, 0.0f }, 1.0f });
+		writer.setVisibility(badTarget ? twoRooms(0U, 7U) : twoRooms(0xFFFFFFFFU, 1U));
+		DD25_CHECK(!loads(writer));
+	}
+}
+
+DD25_TEST(sceneWriterEmptyMesh) {
+	SceneWriter writer;
+	const LodSourceMesh empty = { nullptr, nullptr, nullptr, 0, nullptr, 0 };
+	writer.addObject("a", writer.addMesh("empty", empty), { { 0.0f, 0.0f, 0.0f }, 1.0f });
+	DD25_CHECK(loads(writer));
+}
+
+//================================================================
+
+//
+// Load time of a large scene: the cooked file mapped and read in one go,
+// against parsing the same content from text into per-mesh allocations.
+//
+DD25_BENCH(sceneLoadVsNaive) {
+	const uint32_t meshes = 64U, objects = 20000U;
+	const Grid grid(40);
+	MeshLodChain chain;
+	LodBuilder().build(grid.source(), LodBuildSettings{}, chain);
+
+	SceneWriter writer;
+	for (uint32_t m = 0; m < meshes; ++m) {
+		char name[32];
+		std::snprintf(name, sizeof(name), "mesh%u", m);
+		writer.addMesh(name, grid.source(), &chain);
+	}
+	for (uint32_t o = 0; o < objects; ++o) {
+		char name[32];
+		std::snprintf(name, sizeof(name), "obj%u", o);
+		writer.addObject(name, o % meshes, { { static_cast<float>(o), 0.0f, 0.0f }, 30.0f });
+	}
+	writer.write(SCENE_PATH);
+	writeText(TEXT_PATH, grid, meshes, objects);
+
+	Scene scene;
+	const double mappedMs = bench::bestOf(5, [&] { scene.load(SCENE_PATH); });
+	const size_t fileBytes = scene.loadStats().fileBytes;
+	const size_t copiedBytes = scene.loadStats().copiedBytes;
+
+	SceneChunk chunk;
+	const double readMs = bench::bestOf(5, [&] { chunk.open(SCENE_PATH, false); });
+
+	NaiveScene naive;
+	const double naiveMs = bench::bestOf(2, [&] {
+		naive = NaiveScene();
+		readText(TEXT_PATH, naive);
+	});
+
+	std::printf("  %u meshes (%zu verts, %zu levels), %u objects, %.1f KB cooked\n", meshes, grid.positions.size(),
+		chain.levelCount(), objects, fileBytes / 1024.0);
+	std::printf("  mapped   %8.3f ms  (%zu bytes copied)\n", mappedMs, copiedBytes);
+	std::printf("  read     %8.3f ms  (one aligned read)\n", readMs);
+	std::printf("  naive    %8.3f ms  (text, base level only, x%.0f)\n", naiveMs, mappedMs > 0.0 ? naiveMs / mappedMs : 0.0);
+	std::printf("  objects  %zu / %zu\n", scene.objectCount(), naive.bounds.size());
+
+	std::remove(SCENE_PATH);
+	std::remove(TEXT_PATH);
+}
@@ -0,0 +1,228 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Editor/SceneWriter.hh>
+#include <Engine/scene/SceneStreamer.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr float		CHUNK_LENGTH	= 20.0f;	// Along x, chunks form a row
+
+inline uint32_t objectsIn(uint32_t chunk) noexcept {
+	return 2U + chunk % 4U;
+}
+
+inline std::string chunkPath(uint32_t chunk) {
+	return "dd25_test_stream_" + std::to_string(chunk) + ".dds";
+}
+
+// Chunk `chunk` of the row, its objects strung out along x inside it
+bool writeChunk(uint32_t chunk) {
+	static const Float3 positions[3] = { { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } };
+	static const uint16_t indices[3] = { 0, 1, 2 };
+	SceneWriter writer;
+	const uint32_t mesh = writer.addMesh("tri", { positions, nullptr, nullptr, 3, indices, 3 });
+	for (uint32_t j = 0; j < objectsIn(chunk); ++j) {
+		const std::string name = "o" + std::to_string(chunk) + "_" + std::to_string(j);
+		writer.addObject(name.c_str(), mesh, { { static_cast<float>(chunk) * CHUNK_LENGTH + 2.0f + 3.0f * j, 10.0f, 5.0f }, 1.0f });
+	}
+	return writer.write(chunkPath(chunk).c_str());
+}
+
+std::vector<StreamChunkDesc> writeRow(uint32_t count) {
+	std::vector<StreamChunkDesc> chunks;
+	for (uint32_t i = 0; i < count; ++i) {
+		writeChunk(i);
+		const float x = static_cast<float>(i) * CHUNK_LENGTH;
+		chunks.push_back({ chunkPath(i), { { x, 0.0f, 0.0f }, { x + CHUNK_LENGTH, 20.0f, 10.0f } }, 0 });
+	}
+	return chunks;
+}
+
+void removeRow(uint32_t count) {
+	for (uint32_t i = 0; i < count; ++i) {
+		std::remove(chunkPath(i).c_str());
+	}
+}
+
+// Resident size of the biggest chunk of the row
+size_t largestChunk(uint32_t count) {
+	size_t bytes = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		SceneChunk chunk;
+		if (chunk.open(chunkPath(i).c_str(), false)) {
+			bytes = std::max(bytes, chunk.residentBytes());
+		}
+	}
+	return bytes;
+}
+
+Camera cameraAt(float x) {
+	Camera camera;
+	camera.setPerspective(1.0f, 4.0f / 3.0f, 0.5f, 200.0f);
+	camera.setViewportSize(640, 480);
+	camera.lookAt({ x, 10.0f, 5.0f }, { x + 1.0f, 10.0f, 5.0f }, { 0.0f, 0.0f, 1.0f });
+	return camera;
+}
+
+//
+// Every object in the scene belongs to a resident chunk and every
+// resident chunk has all of its objects in, told apart by position.
+//
+bool sceneMatchesResidency(const Scene& scene, const SceneStreamer& streamer) {
+	std::vector<uint32_t> found(streamer.chunkCount(), 0U);
+	for (size_t id = 0; id < scene.objectCount(); ++id) {
+		const float x = scene.objectBounds(static_cast<Scene::ObjectId>(id)).center.x;
+		const size_t chunk = static_cast<size_t>(x / CHUNK_LENGTH);
+		if (chunk >= found.size()) {
+			return false;
+		}
+		++found[chunk];
+	}
+	size_t expected = 0;
+	for (size_t i = 0; i < streamer.chunkCount(); ++i) {
+		const uint32_t count = streamer.isResident(i) ? objectsIn(static_cast<uint32_t>(i)) : 0U;
+		if (found[i] != count) {
+			return false;
+		}
+		expected += count;
+	}
+	return scene.objectCount() == expected;
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(sceneStreamerTraversesARow) {
+	const uint32_t count = 12U;
+	SceneStreamer streamer;
+	streamer.setChunks(writeRow(count));
+	SceneStreamSettings settings;
+	settings.loadRadius = 15.0f;
+	settings.lookAhead = 0.0f;
+	settings.memoryBudget = largestChunk(count) * 4U;
+	settings.maxBytesInFlight = largestChunk(count) * 2U;
+	streamer.setSettings(settings);
+
+	// Loads finish between frames on odd frames only, so evictions hit any order of commits
+	Scene scene;
+	bool consistent = true;
+	uint32_t frame = 0;
+	for (float x = 1.0f; x < static_cast<float>(count) * CHUNK_LENGTH; x += 2.0f, ++frame) {
+		streamer.update(scene, cameraAt(x), 1.0f / 60.0f);
+		consistent &= sceneMatchesResidency(scene, streamer);
+		if (frame & 1U) {
+			streamer.flush();
+		}
+	}
+	DD25_CHECK(consistent);
+	DD25_CHECK(streamer.stats().evicted > 0);
+	DD25_CHECK(streamer.stats().failed == 0);
+	DD25_CHECK(streamer.isResident(count - 1U));
+
+	streamer.unloadAll(scene);
+	DD25_CHECK(scene.objectCount() == 0 && streamer.stats().committed > count / 2U);
+	for (size_t i = 0; i < count; ++i) {
+		DD25_CHECK(!streamer.isResident(i));
+	}
+	removeRow(count);
+}
+
+DD25_TEST(sceneStreamerRetriesFailedReads) {
+	std::remove(chunkPath(0).c_str());
+	SceneStreamer streamer;
+	streamer.setChunks({ { chunkPath(0), { { 0.0f, 0.0f, 0.0f }, { CHUNK_LENGTH, 20.0f, 10.0f } }, 1024U } });
+	SceneStreamSettings settings;
+	settings.retryFrames = 4U;
+	streamer.setSettings(settings);
+
+	Scene scene;
+	auto frame = [&] {
+		streamer.update(scene, cameraAt(5.0f), 1.0f / 60.0f);
+		streamer.flush();
+	};
+
+	// Missing media: fails, waits out the backoff, fails again
+	for (uint32_t f = 0; f < 8; ++f) {
+		frame();
+	}
+	DD25_CHECK(streamer.stats().failed == 2 && streamer.stats().retries == 1);
+	DD25_CHECK(!streamer.isResident(0) && scene.objectCount() == 0);
+
+	// Back, picked up on the next retry (8 frames after the second failure)
+	DD25_CHECK(writeChunk(0));
+	uint32_t frames = 0;
+	while (!streamer.isResident(0) && frames < 20) {
+		frame();
+		++frames;
+	}
+	DD25_CHECK(streamer.isResident(0) && frames > 1 && streamer.stats().retries == 2);
+	DD25_CHECK(scene.objectCount() == objectsIn(0));
+
+	// unloadAll() forgets failures, the chunk comes straight back
+	streamer.unloadAll(scene);
+	std::remove(chunkPath(0).c_str());
+	frame();
+	frame();
+	DD25_CHECK(streamer.stats().failed == 3);
+	streamer.unloadAll(scene);
+	DD25_CHECK(writeChunk(0));
+	frame();
+	frame();
+	DD25_CHECK(streamer.isResident(0) && scene.objectCount() == objectsIn(0));
+	streamer.unloadAll(scene);
+	DD25_CHECK(scene.objectCount() == 0);
+	removeRow(1);
+}
+
+//================================================================
+
+//
+// Flying down a row of 64 chunks at 120 units/s with reads capped at
+// 48 KB/s, so a chunk takes about a chunk crossing to read, and 2 ms
+// of frame time: frames spent standing in a chunk that isn't in yet,
+// frames over the commit budget and the worst update, with and without
+// look-ahead.
+//
+DD25_BENCH(sceneStreamerTraversal) {
+	const uint32_t count = 64U;
+	const std::vector<StreamChunkDesc> chunks = writeRow(count);
+	const size_t largest = largestChunk(count);
+	for (const float lookAhead : { 0.0f, 0.25f }) {
+		SceneStreamer streamer;
+		streamer.setChunks(chunks);
+		SceneStreamSettings settings;
+		settings.loadRadius = 15.0f;
+		settings.lookAhead = lookAhead;
+		settings.memoryBudget = largest * 6U;
+		settings.maxBytesInFlight = largest * 3U;
+		settings.ioBytesPerSecond = 48U << 10;
+		streamer.setSettings(settings);
+
+		Scene scene;
+		const auto start = bench::Clock::now();
+		uint32_t frames = 0;
+		for (float x = 1.0f; x < static_cast<float>(count) * CHUNK_LENGTH; x += 2.0f, ++frames) {
+			streamer.update(scene, cameraAt(x), 1.0f / 60.0f);
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+		const double ms = bench::elapsedMs(start);
+		const SceneStreamStats& s = streamer.stats();
+		std::printf("  look-ahead %.2f s: %u frames in %.0f ms | %u stalls, %u hitches, max update %.3f ms | %u committed, %u evicted, peak %zu bytes in flight\n",
+			lookAhead, frames, ms, s.stalls, s.hitches, s.maxUpdateMs, s.committed, s.evicted, s.peakBytesInFlight);
+		streamer.unloadAll(scene);
+	}
+	removeRow(count);
+}
@@ -0,0 +1,161 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/ShaderCache.hh>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr const char* CACHE_DIR		= "dd25_test_shaders";
+constexpr const char* PREWARM_PATH	= "dd25_test_shaders/prewarm.txt";
+
+// A few ms of hashing stands in for the optimizer
+bool slowCompile(const std::string& source, const std::string& defines, std::vector<uint8_t>& binary) {
+	const std::string all = defines + source;
+	uint64_t h = 14695981039346656037ULL;
+	for (uint32_t round = 0; round < 6000; ++round) {
+		for (char c : all) {
+			h = (h ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+		}
+	}
+	binary.resize(2048);
+	for (size_t i = 0; i < binary.size(); ++i) {
+		binary[i] = static_cast<uint8_t>(h >> (i % 56U));
+	}
+	return true;
+}
+
+bool fastCompile(const std::string& source, const std::string& defines, std::vector<uint8_t>& binary) {
+	binary.assign(defines.begin(), defines.end());
+	binary.insert(binary.end(), source.begin(), source.end());
+	return true;
+}
+
+void resetCacheDir() {
+	std::filesystem::remove_all(CACHE_DIR);
+	std::filesystem::create_directories(CACHE_DIR);
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(shaderCacheWarmNeverCompiles) {
+	resetCacheDir();
+	{
+		ShaderCache cache(fastCompile, CACHE_DIR, 1);
+		const uint32_t program = cache.addProgram("world", "void main() {}");
+		DD25_CHECK(cache.get(program, 3) != nullptr);
+		DD25_CHECK(cache.get(program, 3) != nullptr);
+		DD25_CHECK(cache.stats().compiles == 1 && cache.stats().memoryHits == 1 && cache.stats().diskWrites == 1);
+	}
+	ShaderCache warm(fastCompile, CACHE_DIR, 1);
+	const uint32_t program = warm.addProgram("world", "void main() {}");
+	DD25_CHECK(warm.get(program, 3) != nullptr);
+	DD25_CHECK(warm.stats().compiles == 0 && warm.stats().diskHits == 1);
+	std::filesystem::remove_all(CACHE_DIR);
+}
+
+DD25_TEST(shaderCacheReplacesStaleFile) {
+	// A file already at the variant's name that doesn't match is rebuilt and overwritten
+	resetCacheDir();
+	const std::string source = "void main() {}";
+	{
+		ShaderCache cache(fastCompile, CACHE_DIR, 1);
+		DD25_CHECK(cache.get(cache.addProgram("world", source), 5) != nullptr);
+		DD25_CHECK(cache.stats().diskWrites == 1);
+	}
+	for (const auto& entry : std::filesystem::directory_iterator(CACHE_DIR)) {
+		std::FILE* fp = std::fopen(entry.path().string().c_str(), "wb");
+		std::fputs("stale", fp);
+		std::fclose(fp);
+	}
+	{
+		ShaderCache cache(fastCompile, CACHE_DIR, 1);
+		DD25_CHECK(cache.get(cache.addProgram("world", source), 5) != nullptr);
+		DD25_CHECK(cache.stats().compiles == 1 && cache.stats().diskWrites == 1);
+	}
+	ShaderCache cache(fastCompile, CACHE_DIR, 1);
+	DD25_CHECK(cache.get(cache.addProgram("world", source), 5) != nullptr);
+	DD25_CHECK(cache.stats().diskHits == 1 && cache.stats().compiles == 0);
+	std::filesystem::remove_all(CACHE_DIR);
+}
+
+DD25_TEST(shaderCacheAddProgramWhileBuilding) {
+	ShaderCache cache(fastCompile);
+	const uint32_t first = cache.addProgram("p0", "p0");
+	std::thread builder([&] {
+		for (ShaderKey key = 0; key < 2000; ++key) {
+			cache.get(first, key);
+		}
+	});
+	for (uint32_t i = 1; i < 200; ++i) {
+		const std::string name = "p" + std::to_string(i);
+		cache.addProgram(name.c_str(), name);
+	}
+	builder.join();
+	DD25_CHECK(cache.findProgram("p199") == 199U);
+	DD25_CHECK(cache.stats().compiles == 2000U);
+}
+
+//================================================================
+
+//
+// Startup against a recorded play session's prewarm list: with no
+// binaries on disk (cold), with them (warm), and after a source edit.
+//
+DD25_BENCH(shaderCacheStartup) {
+	resetCacheDir();
+	std::string source(400, 'x');
+
+	auto session = [&](bool play, const char* label) {
+		const auto start = bench::Clock::now();
+		ShaderCache cache(slowCompile, CACHE_DIR, 1);
+		cache.addProgram("world", source);
+		cache.addProgram("skinned", source + "y");
+		cache.addProgram("ui", "ui");
+		const size_t warmed = play ? 0 : cache.prewarm(PREWARM_PATH);
+		const double startupMs = bench::elapsedMs(start);
+
+		if (play) {
+			// Four threads asking for permutations as a level would
+			std::vector<std::thread> threads;
+			for (uint32_t t = 0; t < 4; ++t) {
+				threads.emplace_back([&cache, t] {
+					for (uint32_t i = 0; i < 200; ++i) {
+						cache.get(i % 3U, (i * 7U + t) % 64U);
+					}
+				});
+			}
+			for (std::thread& thread : threads) {
+				thread.join();
+			}
+			cache.savePrewarmList(PREWARM_PATH);
+		}
+
+		const ShaderCacheStats stats = cache.stats();
+		std::printf("  %-7s startup %7.1f ms, %3zu prewarmed | %u compiles (%.1f ms summed), %u disk hits (%.2f ms), %u written\n",
+			label, startupMs, warmed, stats.compiles, stats.compileMs, stats.diskHits, stats.diskMs, stats.diskWrites);
+	};
+
+	session(true, "play");
+	for (const auto& entry : std::filesystem::directory_iterator(CACHE_DIR)) {
+		if (entry.path().extension() == ".shd") {
+			std::filesystem::remove(entry.path());
+		}
+	}
+	session(false, "cold");
+	session(false, "warm");
+	source[0] = 'z';
+	session(false, "edited");
+	std::filesystem::remove_all(CACHE_DIR);
+}
@@ -0,0 +1,127 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/backend/Software/GBESoftware.hh>
+#include <Engine/gfx/backend/Software/SoftwareTexture.hh>
+#include <Engine/gfx/backend/Software/SoftwareVertexBuffer.hh>
+
+#include <cstring>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr uint32_t	WIDTH		= 160;
+constexpr uint32_t	HEIGHT		= 120;
+
+// 8x8 two-colour checker, one texel per cell
+SoftwareTexture checker(PixelFormat format, uint32_t on, uint32_t off) {
+	SoftwareTexture texture(8, 8, format);
+	const size_t bpp = pixelFormatBytes(format);
+	for (uint32_t y = 0; y < 8; ++y) {
+		for (uint32_t x = 0; x < 8; ++x) {
+			const uint32_t value = ((x ^ y) & 1U) ? on : off;
+			std::memcpy(texture.data() + (y * 8U + x) * bpp, &value, bpp);
+		}
+	}
+	return texture;
+}
+
+// Two triangles covering [x0,x1]x[y0,y1] in clip space
+SoftwareVertexBuffer quad(float x0, float y0, float x1, float y1, float z, uint32_t color) {
+	const GfxVertex v[6] = {
+		{ { x0, y0, z }, color, { 0.0f, 0.0f } }, { { x1, y0, z }, color, { 4.0f, 0.0f } }, { { x1, y1, z }, color, { 4.0f, 4.0f } },
+		{ { x0, y0, z }, color, { 0.0f, 0.0f } }, { { x1, y1, z }, color, { 4.0f, 4.0f } }, { { x0, y1, z }, color, { 0.0f, 4.0f } },
+	};
+	return SoftwareVertexBuffer(6, v);
+}
+
+void drawAll(GBESoftware& backend, const ITexture* texture, const SoftwareVertexBuffer& vertices, RenderList list) {
+	backend.setRenderList(list);
+	backend.bindTexture(texture);
+	backend.bindVertexBuffer(&vertices);
+	backend.draw({ nullptr, texture, &vertices, nullptr, 0, vertices.vertexCount(), Primitive::Triangles });
+}
+
+} // namespace
+
+//================================================================
+
+//
+// Golden hashes of small frames. A change here is a change in what the
+// software backend puts on screen, check the frame before updating them.
+//
+
+DD25_TEST(softwareRasterTexturedQuads) {
+	SoftwareFrameBuffer target(WIDTH, HEIGHT);
+	GBESoftware backend;
+	const SoftwareTexture textures[4] = {
+		checker(PixelFormat::ARGB1555, 0xFC00U, 0x03FFU),
+		checker(PixelFormat::RGB565, 0xF800U, 0x07FFU),
+		checker(PixelFormat::ARGB4444, 0xFF00U, 0x00FFU),
+		checker(PixelFormat::ARGB8888, 0xFFFF0000U, 0x00FFFFFFU),
+	};
+
+	backend.beginFrame(target, 0xFF202040U);
+	for (uint32_t i = 0; i < 4; ++i) {
+		const float x = -0.9f + 0.45f * static_cast<float>(i);
+		const SoftwareVertexBuffer vertices = quad(x, -0.5f, x + 0.4f, 0.5f, 0.2f, 0xFFFFFFFFU);
+		drawAll(backend, &textures[i], vertices, i == 0 ? RenderList::PunchThrough : RenderList::Opaque);
+	}
+	backend.endFrame();
+	DD25_CHECK(target.hash() == 0x289aa189ee19d225ULL);
+}
+
+DD25_TEST(softwareRasterTranslucentOverOpaque) {
+	SoftwareFrameBuffer target(WIDTH, HEIGHT);
+	GBESoftware backend;
+	const SoftwareVertexBuffer back = quad(-0.8f, -0.8f, 0.4f, 0.4f, 0.6f, 0xFF3080F0U);
+	const SoftwareVertexBuffer front = quad(-0.4f, -0.4f, 0.8f, 0.8f, 0.3f, 0x80FF4020U);
+
+	backend.beginFrame(target, 0xFF000000U);
+	drawAll(backend, nullptr, back, RenderList::Opaque);
+	drawAll(backend, nullptr, front, RenderList::Translucent);
+	backend.endFrame();
+	DD25_CHECK(target.hash() == 0x7b9228631ccf3b25ULL);
+}
+
+DD25_TEST(softwareRasterPerspectiveFloor) {
+	SoftwareFrameBuffer target(WIDTH, HEIGHT);
+	GBESoftware backend;
+	const SoftwareTexture texture = checker(PixelFormat::RGB565, 0xF800U, 0x07FFU);
+	const GfxVertex floor[4] = {
+		{ { -5.0f, 0.0f, -5.0f }, 0xFFFF0000U, { 0.0f, 0.0f } }, { { 5.0f, 0.0f, -5.0f }, 0xFF00FF00U, { 8.0f, 0.0f } },
+		{ { -5.0f, 0.0f, 5.0f }, 0xFF0000FFU, { 0.0f, 8.0f } }, { { 5.0f, 0.0f, 5.0f }, 0xFFFFFFFFU, { 8.0f, 8.0f } },
+	};
+	const SoftwareVertexBuffer vertices(4, floor);
+
+	backend.beginFrame(target, 0xFF000000U);
+	backend.setViewProjection(perspective(1.0f, static_cast<float>(WIDTH) / HEIGHT, 0.1f, 100.0f) * lookAt({ 0.0f, 1.0f, 3.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }));
+	backend.setRenderList(RenderList::Opaque);
+	backend.bindTexture(&texture);
+	backend.bindVertexBuffer(&vertices);
+	backend.draw({ nullptr, &texture, &vertices, nullptr, 0, 4, Primitive::TriangleStrip });
+	backend.endFrame();
+	DD25_CHECK(target.hash() == 0xd9cdfcc1efad3b17ULL);
+}
+
+DD25_TEST(softwareRasterHugeTriangle) {
+	// Vertices far past int32 once in pixels, the bounds must clamp rather than wrap
+	SoftwareFrameBuffer target(WIDTH, HEIGHT);
+	GBESoftware backend;
+	const GfxVertex huge[3] = {
+		{ { -1.0e12f, -1.0e12f, 0.5f }, 0xFF00FF00U, { 0.0f, 0.0f } },
+		{ { 1.0e12f, -1.0e12f, 0.5f }, 0xFF00FF00U, { 0.0f, 0.0f } },
+		{ { 0.0f, 1.0e12f, 0.5f }, 0xFF00FF00U, { 0.0f, 0.0f } },
+	};
+	const SoftwareVertexBuffer vertices(3, huge);
+
+	backend.beginFrame(target, 0xFF000000U);
+	drawAll(backend, nullptr, vertices, RenderList::Opaque);
+	backend.endFrame();
+	DD25_CHECK(target.pixel(WIDTH / 2U, HEIGHT / 2U) == 0xFF00FF00U);
+	DD25_CHECK(target.hash() == 0x048ba1d8ffd3bb25ULL);
+}
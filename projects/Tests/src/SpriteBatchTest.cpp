@@ -0,0 +1,149 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/CommandQueue.hh>
+#include <Engine/gfx/SpriteBatch.hh>
+#include <Engine/gfx/backend/Software/GBESoftware.hh>
+#include <Engine/gfx/backend/Software/SoftwareTexture.hh>
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr uint32_t	PAGES		= 8;
+constexpr uint32_t	REGIONS		= 64;		// 8 per page
+
+class Sprite final : public ISprite {
+public:
+	const TextureAtlas* atlas() const noexcept override { return mAtlas; }
+	uint32_t region() const noexcept override { return mRegion; }
+
+	const TextureAtlas*	mAtlas	= nullptr;
+	uint32_t			mRegion	= 0;
+};
+
+// Eight 64x64 pages cut into 4x4 cells, the first 8 regions of each page used
+struct SpriteSheet {
+	SpriteSheet() {
+		std::vector<const ITexture*> views;
+		for (uint32_t i = 0; i < PAGES; ++i) {
+			std::vector<uint32_t> pixels(64U * 64U, 0xFF000000U | (i * 0x203040U));
+			pages.emplace_back(new SoftwareTexture(64, 64, PixelFormat::ARGB8888, pixels.data()));
+			views.push_back(pages.back().get());
+		}
+		std::vector<AtlasRect> rects;
+		for (uint32_t i = 0; i < REGIONS; ++i) {
+			const float u = static_cast<float>(i % 4U) * 0.25f, v = static_cast<float>((i / 4U) % 4U) * 0.25f;
+			rects.push_back({ u, v, u + 0.25f, v + 0.25f, static_cast<uint16_t>(i / 8U), 0 });
+		}
+		atlas.setPages(std::move(views));
+		atlas.setRects(std::move(rects));
+		for (uint32_t i = 0; i < REGIONS; ++i) {
+			sprites[i].mAtlas = &atlas;
+			sprites[i].mRegion = i;
+		}
+	}
+
+	std::vector<std::unique_ptr<SoftwareTexture>>	pages;
+	TextureAtlas									atlas;
+	Sprite											sprites[REGIONS];
+};
+
+std::vector<SpriteInstance> scatter(const SpriteSheet& sheet, uint32_t count, uint32_t layers) {
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::vector<SpriteInstance> out(count);
+	for (SpriteInstance& s : out) {
+		s.sprite = &sheet.sprites[rng() % REGIONS];
+		s.position = { unit(rng) * 640.0f, unit(rng) * 480.0f };
+		s.size = { 4.0f + unit(rng) * 12.0f, 4.0f + unit(rng) * 12.0f };
+		s.rotation = unit(rng) * 6.28f;
+		s.layer = static_cast<uint16_t>(rng() % layers);
+	}
+	return out;
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(spriteBatchOrdersByLayerThenPage) {
+	const SpriteSheet sheet;
+	const std::vector<SpriteInstance> sprites = scatter(sheet, 5000, 4);
+	SpriteBatch batch(5000);
+	batch.begin();
+	for (const SpriteInstance& s : sprites) {
+		batch.add(s);
+	}
+	batch.build();
+
+	// At most one batch per layer and page, laid out back to back
+	DD25_CHECK(batch.stats().sprites == 5000U);
+	DD25_CHECK(batch.batchCount() <= 4U * PAGES);
+	uint32_t next = 0;
+	for (size_t i = 0; i < batch.batchCount(); ++i) {
+		DD25_CHECK(batch.batch(i).first == next);
+		next += batch.batch(i).count;
+	}
+	DD25_CHECK(next == batch.stats().vertices);
+}
+
+//================================================================
+
+//
+// 50k rotated sprites over 8 pages: random layers and sprites, then a
+// coherent set where neighbours share a page. One draw per sprite is
+// what this replaces.
+//
+DD25_BENCH(spriteBatch50k) {
+	const uint32_t count = 50000U;
+	const SpriteSheet sheet;
+	std::vector<SpriteInstance> random = scatter(sheet, count, 16);
+	std::vector<SpriteInstance> coherent = random;
+	for (uint32_t i = 0; i < count; ++i) {
+		coherent[i].sprite = &sheet.sprites[(i / 500U) % PAGES * 8U + i % 8U];
+		coherent[i].layer = static_cast<uint16_t>(i / 6250U);
+	}
+
+	SpriteBatch batch(count);
+	CommandQueue queue(count + 16U, 8U << 20);
+	GBESoftware backend;
+	SoftwareFrameBuffer target(640, 480);
+	for (const auto& [name, set] : { std::make_pair("random", &random), std::make_pair("coherent", &coherent) }) {
+		float sortMs = 0.0f, expandMs = 0.0f;
+		const double addMs = bench::bestOf(10, [&] {
+			batch.begin();
+			for (const SpriteInstance& s : *set) {
+				batch.add(s);
+			}
+		});
+		const double buildMs = bench::bestOf(10, [&] {
+			batch.begin();
+			for (const SpriteInstance& s : *set) {
+				batch.add(s);
+			}
+			batch.build();
+			sortMs = batch.stats().sortMs;
+			expandMs = batch.stats().expandMs;
+		});
+
+		queue.reset();
+		batch.submit(queue, 0, RenderList::Translucent);
+		queue.sort();
+		backend.beginFrame(target, 0xFF000000U);
+		backend.setViewProjection(orthographic(0.0f, 640.0f, 480.0f, 0.0f, -1.0f, 1.0f));
+		queue.execute(backend);
+		backend.endFrame();
+
+		const SpriteBatchStats& stats = batch.stats();
+		std::printf("  %-8s %u sprites: %u draws (was %u), %u runs merged | add %.2f ms, add+build %.2f ms (last: sort %.2f, expand %.2f) | raster %.2f ms\n",
+			name, stats.sprites, stats.batches, count, stats.merged, addMs, buildMs, sortMs, expandMs, backend.stats().rasterMs);
+	}
+}
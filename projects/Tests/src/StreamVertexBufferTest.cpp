@@ -0,0 +1,264 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/StreamVertexBuffer.hh>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+// One allocation and the tag its vertices were written with
+struct Span {
+	uint32_t	first;
+	uint32_t	count;
+	uint32_t	tag;
+};
+
+// Write `count` vertices tagged `tag`, recording where they went
+bool writeTagged(StreamVertexBuffer& stream, uint32_t count, uint32_t tag, std::vector<Span>& spans) {
+	std::vector<GfxVertex> vertices(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		vertices[i] = { { static_cast<float>(i), 0.0f, 0.0f }, tag, { 0.0f, 0.0f } };
+	}
+	uint32_t first = 0;
+	if (!stream.write(vertices.data(), count, first)) {
+		return false;
+	}
+	spans.push_back({ first, count, tag });
+	return true;
+}
+
+// Spans that were overwritten, ran past the end or start off a 32 byte line
+uint32_t damagedSpans(const StreamVertexBuffer& stream, const std::vector<Span>& spans) {
+	uint32_t damaged = 0;
+	for (const Span& span : spans) {
+		const GfxVertex* v = stream.vertices() + span.first;
+		bool intact = (span.first + span.count <= stream.capacity()) && (reinterpret_cast<uintptr_t>(v) % StreamVertexBuffer::ALIGNMENT == 0);
+		for (uint32_t i = 0; intact && i < span.count; ++i) {
+			intact = (v[i].color == span.tag && v[i].position.x == static_cast<float>(i));
+		}
+		damaged += intact ? 0U : 1U;
+	}
+	return damaged;
+}
+
+// Retire `fence` from another thread after a delay, as a render thread would
+std::thread retireLater(StreamVertexBuffer& stream, uint64_t fence) {
+	return std::thread([&stream, fence]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		stream.retire(fence);
+	});
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(streamVertexReusesRetiredFrames) {
+	StreamVertexBuffer stream(64, 3);
+	DD25_CHECK(stream.capacity() == 64);
+	uint32_t first = 0;
+
+	uint64_t fences[3] = {};
+	for (uint32_t frame = 0; frame < 3; ++frame) {
+		stream.beginFrame();
+		DD25_CHECK(stream.allocate(16, first) && first == frame * 16U);
+		fences[frame] = stream.endFrame();
+	}
+	DD25_CHECK(fences[0] == 1 && fences[1] == 2 && fences[2] == 3);
+
+	// Frame 4 takes frame 1's slot, so it needs frame 1 retired first
+	stream.retire(fences[0]);
+	stream.beginFrame();
+	DD25_CHECK(stream.allocate(16, first) && first == 48);
+	DD25_CHECK(stream.allocate(16, first) && first == 0);	// Frame 1's space
+	stream.endFrame();
+	DD25_CHECK(stream.stats().wrapStalls == 0);
+
+	// A fence retires every frame up to it, frame 3's covers frame 2
+	stream.retire(fences[2]);
+	stream.beginFrame();
+	DD25_CHECK(stream.allocate(32, first) && first == 16);
+	stream.endFrame();
+	DD25_CHECK(stream.stats().wrapStalls == 0);
+	DD25_CHECK(stream.stats().failed == 0);
+}
+
+DD25_TEST(streamVertexWrapsWithoutStraddling) {
+	StreamVertexBuffer stream(1502, 3);		// Rounded down to whole 4 vertex granules
+	DD25_CHECK(stream.capacity() == 1500);
+
+	std::vector<Span> frames[3];
+	uint64_t fences[3] = {};
+	uint32_t damaged = 0;
+	uint32_t failed = 0;
+	uint32_t tag = 1;
+	for (uint32_t frame = 0; frame < 60; ++frame) {
+		const uint32_t slot = frame % 3U;
+		if (frame >= 3) {
+			// The oldest frame was in flight until now, check nothing wrote over it
+			damaged += damagedSpans(stream, frames[slot]);
+			stream.retire(fences[slot]);
+		}
+		stream.beginFrame();
+		frames[slot].clear();
+		for (uint32_t n = 0; n < 9; ++n) {
+			failed += writeTagged(stream, 1U + (tag * 37U) % 41U, tag, frames[slot]) ? 0U : 1U;
+			++tag;
+		}
+		fences[slot] = stream.endFrame();
+		damaged += damagedSpans(stream, frames[slot]);
+		DD25_CHECK(stream.stats().wrapStalls == 0);
+	}
+	DD25_CHECK(damaged == 0);
+	DD25_CHECK(failed == 0);
+}
+
+DD25_TEST(streamVertexFailsWhenOnlyItsFrameIsLeft) {
+	StreamVertexBuffer stream(64, 2);
+	uint32_t first = 0;
+
+	stream.beginFrame();
+	DD25_CHECK(stream.allocate(48, first) != nullptr);
+	DD25_CHECK(stream.allocate(32, first) == nullptr);		// Nothing older to wait for
+	DD25_CHECK(stream.allocate(65, first) == nullptr);		// Never fits
+	DD25_CHECK(stream.allocate(0, first) == nullptr);		// Not a failure
+	DD25_CHECK(stream.allocate(16, first) != nullptr && first == 48);
+	stream.endFrame();
+	DD25_CHECK(stream.stats().allocations == 2);
+	DD25_CHECK(stream.stats().failed == 2);
+	DD25_CHECK(stream.stats().wrapStalls == 0);
+
+	// Once the previous frame retires the whole ring is this frame's
+	stream.retire(1);
+	stream.beginFrame();
+	DD25_CHECK(stream.allocate(64, first) != nullptr && first == 0);
+	stream.endFrame();
+	DD25_CHECK(stream.stats().failed == 0);
+}
+
+DD25_TEST(streamVertexCountsStallsAndPeak) {
+	StreamVertexBuffer stream(64, 2);
+	uint32_t first = 0;
+
+	stream.beginFrame();
+	DD25_CHECK(stream.allocate(40, first) != nullptr);
+	const uint64_t fence = stream.endFrame();
+	DD25_CHECK(stream.stats().peakBytes == 40U * sizeof(GfxVertex));
+
+	// 40 + 32 doesn't fit until frame 1 retires, wrapping skips 24 vertices at the end
+	stream.beginFrame();
+	std::thread render = retireLater(stream, fence);
+	DD25_CHECK(stream.allocate(32, first) != nullptr && first == 0);
+	render.join();
+	stream.endFrame();
+	DD25_CHECK(stream.stats().wrapStalls == 1);
+	DD25_CHECK(stream.stats().stallMs > 0.0f);
+	DD25_CHECK(stream.stats().peakBytes == 56U * sizeof(GfxVertex));	// The skipped 24 can't be used either
+
+	// beginFrame() waiting on the oldest frame counts as well
+	stream.beginFrame();
+	DD25_CHECK(stream.stats().wrapStalls == 1);		// Still frame 2's, counters are read at endFrame()
+	stream.endFrame();
+	DD25_CHECK(stream.stats().wrapStalls == 0);
+	render = retireLater(stream, 2);
+	stream.beginFrame();
+	render.join();
+	DD25_CHECK(stream.allocate(32, first) != nullptr && first == 32);
+	DD25_CHECK(stream.allocate(32, first) != nullptr && first == 0);
+	stream.endFrame();
+	DD25_CHECK(stream.stats().wrapStalls == 1);
+	DD25_CHECK(stream.stats().peakBytes == 64U * sizeof(GfxVertex));
+}
+
+DD25_TEST(streamVertexThreadedWriters) {
+	constexpr uint32_t THREADS = 4U;
+	constexpr uint32_t WRITES = 64U;
+	StreamVertexBuffer stream(THREADS * WRITES * 32U * 4U, 3);	// Three frames at most plus wrap padding
+
+	std::vector<Span> frames[3];
+	uint64_t fences[3] = {};
+	uint32_t damaged = 0;
+	uint32_t failed = 0;
+	for (uint32_t frame = 0; frame < 24; ++frame) {
+		const uint32_t slot = frame % 3U;
+		if (frame >= 3) {
+			damaged += damagedSpans(stream, frames[slot]);
+			stream.retire(fences[slot]);
+		}
+		stream.beginFrame();
+
+		std::vector<Span> spans[THREADS];
+		uint32_t misses[THREADS] = {};
+		std::vector<std::thread> writers;
+		for (uint32_t t = 0; t < THREADS; ++t) {
+			writers.emplace_back([&, t]() {
+				for (uint32_t n = 0; n < WRITES; ++n) {
+					const uint32_t tag = (frame * THREADS + t) * WRITES + n + 1U;
+					misses[t] += writeTagged(stream, 1U + tag % 32U, tag, spans[t]) ? 0U : 1U;
+				}
+			});
+		}
+		for (std::thread& writer : writers) {
+			writer.join();
+		}
+
+		frames[slot].clear();
+		for (uint32_t t = 0; t < THREADS; ++t) {
+			frames[slot].insert(frames[slot].end(), spans[t].begin(), spans[t].end());
+			failed += misses[t];
+		}
+		fences[slot] = stream.endFrame();
+		damaged += damagedSpans(stream, frames[slot]);
+		DD25_CHECK(stream.stats().allocations == THREADS * WRITES);
+	}
+	DD25_CHECK(damaged == 0);
+	DD25_CHECK(failed == 0);
+}
+
+//================================================================
+
+//
+// Streaming 2048 sprite quads per frame through `write()` against
+// copying them into a plain vector, with the ring sized for three
+// frames and retired as soon as each frame ends.
+//
+DD25_BENCH(streamVertexWrite) {
+	constexpr uint32_t QUADS = 2048U;
+	constexpr uint32_t FRAMES = 200U;
+	StreamVertexBuffer stream(QUADS * 4U * 3U, 3);
+	std::vector<GfxVertex> quad(4, GfxVertex{ { 1.0f, 2.0f, 3.0f }, 0xFFFFFFFFU, { 0.5f, 0.5f } });
+	std::vector<GfxVertex> plain;
+	plain.reserve(QUADS * 4U);
+
+	const double streamMs = bench::bestOf(5, [&]() {
+		for (uint32_t frame = 0; frame < FRAMES; ++frame) {
+			stream.beginFrame();
+			uint32_t first = 0;
+			for (uint32_t q = 0; q < QUADS; ++q) {
+				stream.write(quad.data(), 4, first);
+			}
+			stream.retire(stream.endFrame());
+		}
+	});
+	const double vectorMs = bench::bestOf(5, [&]() {
+		for (uint32_t frame = 0; frame < FRAMES; ++frame) {
+			plain.clear();
+			for (uint32_t q = 0; q < QUADS; ++q) {
+				plain.insert(plain.end(), quad.begin(), quad.end());
+			}
+		}
+	});
+
+	const double megabytes = static_cast<double>(QUADS) * 4.0 * sizeof(GfxVertex) * FRAMES / (1024.0 * 1024.0);
+	std::printf("  stream %.3f ms/frame (%.0f MB/s), vector %.3f ms/frame, wrap stalls %u, peak %zu bytes\n", streamMs / FRAMES,
+		megabytes / (streamMs / 1000.0), vectorMs / FRAMES, stream.stats().wrapStalls, stream.stats().peakBytes);
+}
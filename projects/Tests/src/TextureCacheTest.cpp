@@ -0,0 +1,98 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/TextureCache.hh>
+
+#include <vector>
+
+//================================================================
+
+namespace {
+
+// Full mip chain of RGB565 zeros, `levels` of it
+TextureSource chain(uint32_t size, uint32_t levels, std::vector<uint8_t>& pixels) {
+	pixels.assign(static_cast<size_t>(size) * size * 2U, 0);
+	TextureSource source = { size, size, PixelFormat::RGB565, {} };
+	for (uint32_t level = 0; level < levels; ++level) {
+		source.levels.push_back(pixels.data());
+	}
+	return source;
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(textureCacheOversizedDoesNotBlock) {
+	// 128 KB texture in a 64 KB budget, queued ahead of one that fits
+	TextureCacheSettings settings;
+	settings.vramBudget = 64U << 10;
+	settings.uploadBytesPerFrame = 16U << 10;
+	TextureCache cache(settings);
+
+	std::vector<uint8_t> bigPixels, smallPixels;
+	const TextureId big = cache.add(chain(256, 1, bigPixels));
+	const TextureId small = cache.add(chain(64, 7, smallPixels));
+
+	const ITexture* bigView = nullptr;
+	for (uint32_t frame = 0; frame < 100; ++frame) {
+		cache.beginFrame();
+		bigView = cache.request(big);
+		cache.request(small);
+		cache.endFrame();
+	}
+	DD25_CHECK(cache.isResident(small));
+	DD25_CHECK(!cache.isResident(big));
+	DD25_CHECK(bigView == nullptr);
+	DD25_CHECK(cache.residentBytes() <= settings.vramBudget);
+}
+
+DD25_TEST(textureCacheOversizedKeepsCoarseLevels) {
+	// 256x256 with mips is ~170 KB, only 128x128 and down fit in 64 KB
+	TextureCacheSettings settings;
+	settings.vramBudget = 64U << 10;
+	TextureCache cache(settings);
+
+	std::vector<uint8_t> pixels;
+	const TextureId id = cache.add(chain(256, 9, pixels));
+	const ITexture* view = nullptr;
+	for (uint32_t frame = 0; frame < 10; ++frame) {
+		cache.beginFrame();
+		view = cache.request(id);
+		cache.endFrame();
+	}
+	DD25_CHECK(view != nullptr && view->width() == 128U);
+	DD25_CHECK(!cache.isResident(id));
+	DD25_CHECK(cache.residentBytes() <= settings.vramBudget);
+
+	// Settled, nothing left queued for it
+	cache.beginFrame();
+	cache.request(id);
+	cache.endFrame();
+	DD25_CHECK(cache.stats().uploadBytes == 0 && cache.stats().budgetDeferred == 0);
+}
+
+DD25_TEST(textureCacheWaitingUploadDoesNotBlock) {
+	// The first texture can't evict the one in use, the second still streams in
+	TextureCacheSettings settings;
+	settings.vramBudget = 48U << 10;
+	TextureCache cache(settings);
+
+	std::vector<uint8_t> heldPixels, waitPixels, smallPixels;
+	const TextureId held = cache.add(chain(128, 1, heldPixels));
+	const TextureId wait = cache.add(chain(128, 1, waitPixels));
+	const TextureId small = cache.add(chain(32, 6, smallPixels));
+
+	for (uint32_t frame = 0; frame < 10; ++frame) {
+		cache.beginFrame();
+		cache.request(held);
+		cache.request(wait);
+		cache.request(small);
+		cache.endFrame();
+	}
+	DD25_CHECK(cache.isResident(held));
+	DD25_CHECK(!cache.isResident(wait));
+	DD25_CHECK(cache.isResident(small));
+}
@@ -0,0 +1,169 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Editor/TextureCooker.hh>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+// Smooth colour ramps with a soft ring, the kind of source VQ is meant for
+std::vector<uint32_t> sourceImage(uint32_t width, uint32_t height) {
+	std::vector<uint32_t> image(static_cast<size_t>(width) * height);
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			const float u = static_cast<float>(x) / static_cast<float>(width - 1U);
+			const float v = static_cast<float>(y) / static_cast<float>(height - 1U);
+			const float ring = 0.5f + 0.5f * std::sin(12.0f * std::hypot(u - 0.5f, v - 0.5f));
+			const uint32_t r = static_cast<uint32_t>(255.0f * u);
+			const uint32_t g = static_cast<uint32_t>(255.0f * v);
+			const uint32_t b = static_cast<uint32_t>(255.0f * ring);
+			image[static_cast<size_t>(y) * width + x] = 0xFF000000U | r << 16 | g << 8 | b;
+		}
+	}
+	return image;
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(textureTwiddleIsABijection) {
+	const uint32_t sizes[][2] = { { 8, 8 }, { 32, 8 }, { 8, 32 }, { 64, 2 }, { 1, 16 }, { 16, 1 } };
+	for (const auto& size : sizes) {
+		const uint32_t width = size[0];
+		const uint32_t height = size[1];
+		std::vector<uint32_t> hits(static_cast<size_t>(width) * height, 0U);
+		bool inRange = true;
+		for (uint32_t y = 0; y < height; ++y) {
+			for (uint32_t x = 0; x < width; ++x) {
+				const uint32_t index = TextureCooker::twiddleIndex(x, y, width, height);
+				if (index < hits.size()) {
+					++hits[index];
+				} else {
+					inRange = false;
+				}
+			}
+		}
+		DD25_CHECK(inRange);
+		uint32_t once = 0;
+		for (const uint32_t h : hits) {
+			once += (h == 1U) ? 1U : 0U;
+		}
+		DD25_CHECK(once == hits.size());
+	}
+}
+
+DD25_TEST(textureCookRoundTripsArgb8888) {
+	const std::vector<uint32_t> source = sourceImage(64, 16);
+	for (const bool twiddle : { false, true }) {
+		TextureCookSettings settings;
+		settings.format = PixelFormat::ARGB8888;
+		settings.twiddle = twiddle;
+		CookedTexture cooked;
+		TextureCookStats stats = {};
+		DD25_CHECK(TextureCooker().cook(source.data(), 64, 16, settings, cooked, &stats));
+		DD25_CHECK(cooked.twiddled == twiddle);
+		DD25_CHECK(std::isinf(stats.psnr));
+
+		std::vector<uint32_t> decoded;
+		DD25_CHECK(TextureCooker::decode(cooked, decoded));
+		DD25_CHECK(decoded == source);
+	}
+}
+
+DD25_TEST(textureCookKeepsQuality) {
+	const uint32_t width = 128;
+	const uint32_t height = 128;
+	const std::vector<uint32_t> source = sourceImage(width, height);
+
+	// The red and green ramps are symmetric about the diagonal through their
+	// mean, so VQ splits that never leave it show up as a collapse in PSNR
+	struct Case {
+		PixelFormat	format;
+		bool		vq;
+		uint32_t	codebookSize;
+		double		minPsnr;
+	};
+	const Case cases[] = {
+		{ PixelFormat::RGB565,		false,	0U,		38.0 },
+		{ PixelFormat::ARGB1555,	false,	0U,		34.0 },
+		{ PixelFormat::ARGB4444,	false,	0U,		28.0 },
+		{ PixelFormat::RGB565,		true,	64U,	22.0 },
+		{ PixelFormat::RGB565,		true,	256U,	28.0 },
+		{ PixelFormat::ARGB1555,	true,	256U,	28.0 }
+	};
+	for (const Case& c : cases) {
+		TextureCookSettings settings;
+		settings.format = c.format;
+		settings.vq = c.vq;
+		settings.codebookSize = c.vq ? c.codebookSize : settings.codebookSize;
+		CookedTexture cooked;
+		TextureCookStats stats = {};
+		DD25_CHECK(TextureCooker().cook(source.data(), width, height, settings, cooked, &stats));
+		DD25_CHECK(stats.psnr > c.minPsnr);
+		DD25_CHECK(stats.cookedBytes == cooked.sizeBytes());
+		if (c.vq) {
+			DD25_CHECK(cooked.data.size() == static_cast<size_t>(width / 2U) * (height / 2U));
+		} else {
+			DD25_CHECK(cooked.data.size() == static_cast<size_t>(width) * height * 2U);
+		}
+	}
+}
+
+DD25_TEST(textureCookRejectsBadInput) {
+	const std::vector<uint32_t> source = sourceImage(16, 16);
+	CookedTexture cooked;
+	TextureCookSettings settings;
+	settings.vq = true;
+	settings.format = PixelFormat::ARGB8888;
+	DD25_CHECK(!TextureCooker().cook(source.data(), 16, 16, settings, cooked));
+
+	settings.format = PixelFormat::RGB565;
+	settings.codebookSize = 257U;
+	DD25_CHECK(!TextureCooker().cook(source.data(), 16, 16, settings, cooked));
+
+	settings = {};
+	DD25_CHECK(!TextureCooker().cook(source.data(), 12, 16, settings, cooked));
+	DD25_CHECK(!TextureCooker().cook(nullptr, 16, 16, settings, cooked));
+}
+
+//================================================================
+
+//
+// Quality, size and encode time of a 256x256 source cooked to each
+// 16-bit format, straight and VQ compressed.
+//
+DD25_BENCH(textureCookFormats) {
+	const uint32_t size = 256U;
+	const std::vector<uint32_t> source = sourceImage(size, size);
+
+	struct Case {
+		const char*	name;
+		PixelFormat	format;
+		bool		vq;
+	};
+	const Case cases[] = {
+		{ "RGB565       ",	PixelFormat::RGB565,	false },
+		{ "ARGB1555     ",	PixelFormat::ARGB1555,	false },
+		{ "ARGB4444     ",	PixelFormat::ARGB4444,	false },
+		{ "RGB565 VQ    ",	PixelFormat::RGB565,	true },
+		{ "ARGB1555 VQ  ",	PixelFormat::ARGB1555,	true }
+	};
+	std::printf("  %ux%u source, %zu bytes\n", size, size, source.size() * sizeof(uint32_t));
+	for (const Case& c : cases) {
+		TextureCookSettings settings;
+		settings.format = c.format;
+		settings.vq = c.vq;
+		CookedTexture cooked;
+		TextureCookStats stats = {};
+		TextureCooker().cook(source.data(), size, size, settings, cooked, &stats);
+		std::printf("  %s: psnr %5.2f dB, %6zu bytes, %8.4f s\n", c.name, stats.psnr, stats.cookedBytes, stats.seconds);
+	}
+}
@@ -0,0 +1,220 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/CommandQueue.hh>
+#include <Engine/gfx/TileMap.hh>
+#include <Engine/gfx/backend/Software/SoftwareTexture.hh>
+#include <Engine/scene/FramePipeline.hh>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr uint32_t	TILES		= 128;		// 64 per page
+
+class Tileset final : public ITileset {
+public:
+	Tileset() {
+		std::vector<const ITexture*> views;
+		for (uint32_t i = 0; i < 2; ++i) {
+			std::vector<uint32_t> pixels(128U * 128U, 0xFF000000U | (i * 0x405060U));
+			mPages.emplace_back(new SoftwareTexture(128, 128, PixelFormat::ARGB8888, pixels.data()));
+			views.push_back(mPages.back().get());
+		}
+		std::vector<AtlasRect> rects;
+		for (uint32_t i = 0; i < TILES; ++i) {
+			const uint32_t j = i % 64U;
+			const float u = static_cast<float>(j % 8U) / 8.0f, v = static_cast<float>(j / 8U) / 8.0f;
+			rects.push_back({ u, v, u + 0.125f, v + 0.125f, static_cast<uint16_t>(i / 64U), 0 });
+		}
+		mAtlas.setPages(std::move(views));
+		mAtlas.setRects(std::move(rects));
+	}
+
+	const TextureAtlas* atlas() const noexcept override { return &mAtlas; }
+	uint32_t tileCount() const noexcept override { return TILES; }
+
+private:
+	std::vector<std::unique_ptr<SoftwareTexture>>	mPages;
+	TextureAtlas									mAtlas;
+};
+
+// Random tiles over both pages, one in ten empty
+std::vector<uint16_t> randomTiles(uint32_t width, uint32_t height) {
+	std::vector<uint16_t> tiles(static_cast<size_t>(width) * height);
+	std::mt19937 rng(3);
+	for (uint16_t& t : tiles) {
+		t = (rng() % 10U == 0) ? TileMap::EMPTY : static_cast<uint16_t>(rng() % TILES);
+	}
+	return tiles;
+}
+
+// A recorded draw and what its vertices held then
+struct DrawnRange {
+	const IVertexBuffer*	vertices;
+	uint32_t				first;
+	uint32_t				count;
+	uint64_t				hash;
+};
+
+// FNV-1a over the draw's vertices, 0 once the buffer no longer covers it
+uint64_t hashRange(const IVertexBuffer* vertices, uint32_t first, uint32_t count) noexcept {
+	if (vertices->vertexCount() < first + count) {
+		return 0;
+	}
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(vertices->vertices() + first);
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (size_t i = 0; i < count * sizeof(GfxVertex); ++i) {
+		hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(tileMapBakesOnlyWhatChanges) {
+	const Tileset tileset;
+	TileMap map(&tileset, 256, 256);
+	const std::vector<uint16_t> tiles = randomTiles(256, 256);
+	map.setTiles(tiles.data());
+	CommandQueue queue(1024, 1U << 20);
+
+	map.draw(queue, { 0.0f, 0.0f }, { 640.0f, 480.0f }, 0, RenderList::Opaque);
+	const uint32_t visible = map.stats().visibleChunks;
+	DD25_CHECK(visible > 0 && map.stats().chunksBaked == visible);
+	DD25_CHECK(map.stats().draws <= visible * 2U);
+
+	// Same view, nothing rebuilt; one tile changed, one chunk rebuilt
+	queue.reset();
+	map.draw(queue, { 0.0f, 0.0f }, { 640.0f, 480.0f }, 0, RenderList::Opaque);
+	DD25_CHECK(map.stats().chunksBaked == 0);
+	map.setTile(3, 3, 7);
+	queue.reset();
+	map.draw(queue, { 0.0f, 0.0f }, { 640.0f, 480.0f }, 0, RenderList::Opaque);
+	DD25_CHECK(map.stats().chunksBaked == 1);
+	DD25_CHECK(map.tile(3, 3) == 7);
+}
+
+DD25_TEST(tileMapKeepsResidentChunksBounded) {
+	const Tileset tileset;
+	TileMapSettings settings;
+	settings.maxResidentChunks = 16;
+	TileMap map(&tileset, 1024, 1024, settings);
+	const std::vector<uint16_t> tiles = randomTiles(1024, 1024);
+	map.setTiles(tiles.data());
+	CommandQueue queue(1024, 1U << 20);
+
+	uint32_t maxResident = 0;
+	for (uint32_t f = 0; f < 600; ++f) {
+		const float x = static_cast<float>(f) * 20.0f, y = static_cast<float>(f) * 10.0f;
+		queue.reset();
+		map.draw(queue, { x, y }, { x + 640.0f, y + 480.0f }, 0, RenderList::Opaque);
+		maxResident = std::max(maxResident, map.stats().residentChunks);
+	}
+	DD25_CHECK(maxResident <= settings.maxResidentChunks);
+}
+
+DD25_TEST(tileMapLeavesDrawsInFlightAlone) {
+	// Scrolling, editing and animating every frame while earlier frames may still be rendering
+	static_assert(TileMap::FRAMES_IN_FLIGHT >= FramePipeline::PACKETS, "TileMap must outlast the frame pipeline");
+	const Tileset tileset;
+	TileMapSettings settings;
+	settings.maxResidentChunks = 4;
+	TileMap map(&tileset, 1024, 1024, settings);
+	std::vector<uint16_t> tiles = randomTiles(1024, 1024);
+	for (size_t i = 0; i < tiles.size(); i += 7U) {
+		tiles[i] = 5;
+	}
+	map.setTiles(tiles.data());
+	const uint16_t frames[4] = { 5, 6, 7, 8 };
+	map.addAnimation(frames, 4, 1.0f / 60.0f);
+
+	CommandQueue queue(1024, 1U << 20);
+	std::vector<std::vector<DrawnRange>> recorded;
+	uint32_t changed = 0, retired = 0;
+	for (uint32_t f = 0; f < 240; ++f) {
+		const float x = static_cast<float>(f) * 40.0f, y = static_cast<float>(f) * 7.0f;
+		map.update(1.0f / 60.0f);
+		map.setTile(static_cast<uint32_t>(x / 16.0f) + 3U, static_cast<uint32_t>(y / 16.0f) + 3U, static_cast<uint16_t>(f % TILES));
+		queue.reset();
+		map.draw(queue, { x, y }, { x + 640.0f, y + 480.0f }, 0, RenderList::Opaque);
+		retired += map.stats().buffersRetired;
+
+		// Every draw of the frames still in flight reads what it did when recorded
+		for (const std::vector<DrawnRange>& frame : recorded) {
+			for (const DrawnRange& d : frame) {
+				changed += (hashRange(d.vertices, d.first, d.count) != d.hash) ? 1U : 0U;
+			}
+		}
+
+		queue.sort();
+		std::vector<DrawnRange> draws;
+		for (uint32_t i = 0; i < queue.size(); ++i) {
+			const DrawCommand& cmd = queue.command(queue.items()[i]);
+			draws.push_back({ cmd.vertices, cmd.first, cmd.count, hashRange(cmd.vertices, cmd.first, cmd.count) });
+		}
+		recorded.push_back(std::move(draws));
+		if (recorded.size() > TileMap::FRAMES_IN_FLIGHT) {
+			recorded.erase(recorded.begin());
+		}
+	}
+	DD25_CHECK(changed == 0);
+	DD25_CHECK(retired > 0);
+}
+
+//================================================================
+
+//
+// A minute of scrolling over a 4096x4096 map with one animated tile:
+// average and worst draw() time, and how much geometry it holds.
+//
+DD25_BENCH(tileMapScroll4096) {
+	const uint32_t side = 4096U;
+	const Tileset tileset;
+	TileMap map(&tileset, side, side);
+	const std::vector<uint16_t> tiles = randomTiles(side, side);
+
+	auto start = bench::Clock::now();
+	map.setTiles(tiles.data());
+	const double setMs = bench::elapsedMs(start);
+	const uint16_t frames[4] = { 5, 6, 7, 8 };
+	map.addAnimation(frames, 4, 0.25f);
+
+	CommandQueue queue(4096, 1U << 20);
+	const uint32_t count = 3600U;
+	double sumMs = 0.0, maxMs = 0.0;
+	uint32_t maxBaked = 0, maxResident = 0, maxDraws = 0, patched = 0, evicted = 0;
+	for (uint32_t f = 0; f < count; ++f) {
+		const float x = static_cast<float>(f) * 3.0f, y = static_cast<float>(f) * 1.5f;
+		map.update(1.0f / 60.0f);
+		queue.reset();
+		start = bench::Clock::now();
+		map.draw(queue, { x, y }, { x + 640.0f, y + 480.0f }, 0, RenderList::Opaque);
+		const double ms = bench::elapsedMs(start);
+		sumMs += ms;
+		if (f > 0) {
+			maxMs = std::max(maxMs, ms);
+		}
+
+		const TileMapStats& stats = map.stats();
+		maxBaked = std::max(maxBaked, stats.chunksBaked);
+		maxResident = std::max(maxResident, stats.residentChunks);
+		maxDraws = std::max(maxDraws, stats.draws);
+		patched += stats.animatedPatched;
+		evicted += stats.chunksEvicted;
+	}
+	std::printf("  %ux%u tiles, setTiles %.1f ms | %u frames: draw %.3f ms avg, %.3f ms worst\n",
+		side, side, setMs, count, sumMs / count, maxMs);
+	std::printf("  at most %u chunks baked a frame, %u resident, %u draws | %u animated tiles patched, %u chunks evicted\n",
+		maxBaked, maxResident, maxDraws, patched, evicted);
+}
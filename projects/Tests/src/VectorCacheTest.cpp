@@ -0,0 +1,177 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/CommandQueue.hh>
+#include <Engine/gfx/VectorCache.hh>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr double	PI		= 3.14159265358979323846;
+
+// Signed area of a triangle list, `absolute` gets the unsigned sum
+double area(const GfxVertex* v, size_t count, double* absolute = nullptr) {
+	double sum = 0.0, abs = 0.0;
+	for (size_t i = 0; i + 2 < count; i += 3) {
+		const double t = 0.5 * ((v[i + 1].position.x - v[i].position.x) * (v[i + 2].position.y - v[i].position.y)
+			- (v[i + 2].position.x - v[i].position.x) * (v[i + 1].position.y - v[i].position.y));
+		sum += t;
+		abs += std::fabs(t);
+	}
+	if (absolute) {
+		*absolute = abs;
+	}
+	return sum;
+}
+
+double area(const std::vector<GfxVertex>& v, double* absolute = nullptr) {
+	return area(v.data(), v.size(), absolute);
+}
+
+// One of four shapes on a 20-wide grid, nudged right by `t`
+void shape(VectorPath& path, uint32_t i, float t) {
+	const float x = static_cast<float>(i % 20U) * 30.0f + t, y = static_cast<float>(i / 20U) * 40.0f;
+	switch (i % 4U) {
+	case 0:
+		path.roundedRect({ x, y }, { 28.0f, 20.0f }, 6.0f);
+		break;
+	case 1:
+		path.ellipse({ x + 10.0f, y + 10.0f }, { 10.0f, 8.0f });
+		break;
+	case 2:
+		path.roundedRect({ x, y }, { 28.0f, 20.0f }, 5.0f);
+		path.ellipse({ x + 14.0f, y + 10.0f }, { -5.0f, 5.0f });		// Reversed winding, a hole
+		break;
+	default:
+		path.moveTo({ x, y });
+		path.lineTo({ x + 10.0f, y + 15.0f });
+		path.quadTo({ x + 15.0f, y + 25.0f }, { x + 25.0f, y });
+		path.lineTo({ x + 12.0f, y + 5.0f });
+		path.close();
+		break;
+	}
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(vectorFillAreas) {
+	const Brush brush(0xFFFF0000U);
+	std::vector<GfxVertex> out;
+
+	VectorPath circle;
+	circle.setTolerance(0.01f);
+	circle.ellipse({ 0.0f, 0.0f }, { 100.0f, 100.0f });
+	tessellateFill(circle, brush, out);
+	DD25_CHECK(std::fabs(std::fabs(area(out)) - PI * 1.0e4) < PI * 1.0e4 * 1.0e-3);
+
+	// A square with a square hole, beside a concave arrow
+	out.clear();
+	VectorPath holes;
+	holes.rect({ 0.0f, 0.0f }, { 10.0f, 10.0f });
+	holes.moveTo({ 3.0f, 3.0f });
+	holes.lineTo({ 3.0f, 7.0f });
+	holes.lineTo({ 7.0f, 7.0f });
+	holes.lineTo({ 7.0f, 3.0f });
+	holes.close();
+	holes.moveTo({ 20.0f, 0.0f });
+	holes.lineTo({ 30.0f, 0.0f });
+	holes.lineTo({ 25.0f, 5.0f });
+	holes.lineTo({ 30.0f, 10.0f });
+	holes.lineTo({ 20.0f, 10.0f });
+	holes.close();
+	tessellateFill(holes, brush, out);
+	double absolute = 0.0;
+	const double signedArea = area(out, &absolute);
+	DD25_CHECK(std::fabs(absolute - 159.0) < 1.0e-3);
+	DD25_CHECK(std::fabs(std::fabs(signedArea) - absolute) < 1.0e-3);
+}
+
+DD25_TEST(vectorCacheClearKeepsMeshesInFlight) {
+	VectorCache cache;
+	const Brush brush;
+	VectorPath path;
+	path.ellipse({ 0.0f, 0.0f }, { 10.0f, 10.0f });
+
+	cache.beginFrame();
+	const IVertexBuffer* mesh = cache.fill(path, brush);
+	DD25_CHECK(mesh != nullptr);
+	const uint32_t count = mesh->vertexCount();
+	const double before = area(mesh->vertices(), count);
+
+	// Forgotten at once, still drawable by the frames already recorded
+	cache.clear();
+	cache.beginFrame();
+	DD25_CHECK(cache.fill(path, brush) != nullptr && cache.stats().tessellated == 1);
+	for (uint32_t f = 1; f < VectorCache::FRAMES_IN_FLIGHT; ++f) {
+		cache.beginFrame();
+	}
+	DD25_CHECK(mesh->vertexCount() == count && area(mesh->vertices(), count) == before);
+}
+
+//================================================================
+
+//
+// 200 filled and stroked shapes a frame for 300 frames: served from the
+// cache, with the paths rebuilt (same hash, still cached), and
+// tessellated from scratch every frame. Areas of the cached meshes are
+// checked against fresh tessellation.
+//
+DD25_BENCH(vectorCacheVsRetessellate) {
+	const uint32_t shapes = 200U, frames = 300U;
+	const Brush brush(0xFFFF0000U);
+	Pen pen(0xFFFFFFFFU, 2.0f);
+	pen.setJoin(LineJoin::Round);
+	std::vector<VectorPath> paths(shapes);
+	for (uint32_t i = 0; i < shapes; ++i) {
+		shape(paths[i], i, 0.0f);
+	}
+
+	VectorCache cache;
+	CommandQueue queue;
+	const Float4x4 identity = Float4x4::identity();
+	std::vector<GfxVertex> scratch;
+	const char* names[3] = { "cached", "rebuilt paths", "retessellated" };
+	for (uint32_t mode = 0; mode < 3; ++mode) {
+		const auto start = bench::Clock::now();
+		for (uint32_t f = 0; f < frames; ++f) {
+			cache.beginFrame();
+			queue.reset();
+			for (uint32_t i = 0; i < shapes; ++i) {
+				if (mode == 1) {
+					paths[i].clear();
+					shape(paths[i], i, 0.0f);
+				}
+				if (mode == 2) {
+					scratch.clear();
+					tessellateFill(paths[i], brush, scratch);
+					tessellateStroke(paths[i], pen, scratch);
+					continue;
+				}
+				VectorCache::submit(queue, cache.fill(paths[i], brush), &identity, SortKey::make(0, RenderList::Opaque, 0.0f, 0, 0));
+				VectorCache::submit(queue, cache.stroke(paths[i], pen), &identity, SortKey::make(0, RenderList::Opaque, 0.0f, 0, 0));
+			}
+		}
+		const double ms = bench::elapsedMs(start) / frames;
+		const VectorCacheStats& stats = cache.stats();
+		std::printf("  %-14s %.4f ms a frame | last frame: %u requests, %u hits, %u tessellated, %u meshes, %zu vertices\n",
+			names[mode], ms, stats.requests, stats.hits, stats.tessellated, stats.meshes, stats.vertices);
+	}
+
+	uint32_t wrong = 0;
+	for (uint32_t i = 0; i < shapes; ++i) {
+		const IVertexBuffer* mesh = cache.fill(paths[i], brush);
+		scratch.clear();
+		tessellateFill(paths[i], brush, scratch);
+		wrong += (!mesh || area(mesh->vertices(), mesh->vertexCount()) != area(scratch)) ? 1U : 0U;
+	}
+	std::printf("  cached fill areas differing from fresh tessellation: %u of %u\n", wrong, shapes);
+}
@@ -0,0 +1,154 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/VertexLighting.hh>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr uint32_t	OBJECTS		= 64;
+
+// A unit sphere of `count` scattered points
+struct Ball {
+	explicit Ball(uint32_t count)
+		: positions(count)
+		, normals(count) {
+		for (uint32_t i = 0; i < count; ++i) {
+			const float a = static_cast<float>(i) * 0.0123f, b = static_cast<float>(i) * 0.377f;
+			normals[i] = normalize(Float3{ std::cos(a) * std::sin(b), std::cos(b), std::sin(a) * std::sin(b) });
+			positions[i] = normals[i];
+		}
+	}
+
+	VertexLightingMesh mesh() const { return { positions.data(), normals.data(), nullptr, static_cast<uint32_t>(positions.size()) }; }
+
+	std::vector<Float3>		positions;
+	std::vector<Float3>		normals;
+};
+
+// A sun and eight static points and spots over an 8x8 grid of objects
+std::vector<Light> staticLights() {
+	std::vector<Light> lights;
+	lights.reserve(9);
+	lights.emplace_back(LightType::Directional, true);
+	lights.back().setDirection({ 0.3f, -1.0f, 0.2f });
+	lights.back().setColor({ 0.6f, 0.6f, 0.5f });
+	for (uint32_t i = 0; i < 8; ++i) {
+		Light& light = lights.emplace_back((i % 3U == 2U) ? LightType::Spot : LightType::Point, true);
+		light.setPosition({ static_cast<float>(i % 4U) * 8.0f, 3.0f, static_cast<float>(i / 4U) * 8.0f });
+		light.setRange(9.0f);
+		light.setColor({ 1.0f, 0.8f, 0.6f });
+		light.setDirection({ 0.0f, -1.0f, 0.0f });
+		light.setCone(0.5f, 0.8f);
+	}
+	return lights;
+}
+
+Float4x4 placeAt(float x, float z) {
+	Float4x4 world = Float4x4::identity();
+	world.m[12] = x;
+	world.m[14] = z;
+	return world;
+}
+
+Aabb boundsAt(float x, float z) {
+	return { { x - 1.0f, -1.0f, z - 1.0f }, { x + 1.0f, 1.0f, z + 1.0f } };
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(vertexLightCacheFollowsPlacementAndMesh) {
+	const Ball ball(64), other(64);
+	std::vector<Light> lights = staticLights();
+	std::vector<GfxVertex> cachedOut(64), freshOut(64);
+	VertexLightCache cache;
+	VertexLighting lighting;
+
+	auto frame = [&](const Ball& mesh, float x, VertexLightCache* target, std::vector<GfxVertex>& out) {
+		lighting.beginFrame({ 0.1f, 0.1f, 0.12f });
+		for (const Light& light : lights) {
+			lighting.addLight(&light);
+		}
+		lighting.light(mesh.mesh(), placeAt(x, 4.0f), boundsAt(x, 4.0f), out.data(), target);
+	};
+
+	frame(ball, 2.0f, &cache, cachedOut);
+	frame(ball, 2.0f, &cache, cachedOut);
+	DD25_CHECK(lighting.stats().cacheRebuilds == 0);
+
+	// Moved by a little, still reached by the same lights: must relight, not reuse
+	frame(ball, 3.0f, &cache, cachedOut);
+	DD25_CHECK(lighting.stats().cacheRebuilds == 1);
+	frame(ball, 3.0f, nullptr, freshOut);
+	bool same = true;
+	for (size_t i = 0; i < cachedOut.size(); ++i) {
+		same &= cachedOut[i].color == freshOut[i].color;
+	}
+	DD25_CHECK(same);
+
+	// Another mesh of the same size through the same cache
+	frame(other, 3.0f, &cache, cachedOut);
+	DD25_CHECK(lighting.stats().cacheRebuilds == 1);
+}
+
+//================================================================
+
+//
+// 64 objects of 4096 vertices under nine static lights, 50 frames:
+// uncached, cached with only static light, and cached with a moving
+// dynamic light on top. Vertices per ms through light().
+//
+DD25_BENCH(vertexLighting64x4096) {
+	const uint32_t vertices = 4096U;
+	const Ball ball(vertices);
+	std::vector<Light> lights = staticLights();
+	Light mover(LightType::Point, false);
+	mover.setRange(6.0f);
+	mover.setColor({ 0.0f, 0.0f, 2.0f });
+
+	std::vector<std::vector<GfxVertex>> out(OBJECTS, std::vector<GfxVertex>(vertices));
+	std::vector<VertexLightCache> caches(OBJECTS);
+	VertexLighting lighting;
+	auto frame = [&](bool useCache, bool dynamic, float t) {
+		lighting.beginFrame({ 0.1f, 0.1f, 0.12f });
+		for (const Light& light : lights) {
+			lighting.addLight(&light);
+		}
+		mover.setPosition({ t, 2.0f, 4.0f });
+		if (dynamic) {
+			lighting.addLight(&mover);
+		}
+		for (uint32_t o = 0; o < OBJECTS; ++o) {
+			const float x = static_cast<float>(o % 8U) * 4.0f, z = static_cast<float>(o / 8U) * 4.0f;
+			lighting.light(ball.mesh(), placeAt(x, z), boundsAt(x, z), out[o].data(), useCache ? &caches[o] : nullptr);
+		}
+	};
+
+	const char* names[3] = { "uncached", "cached static", "cached + dynamic" };
+	for (uint32_t mode = 0; mode < 3; ++mode) {
+		for (VertexLightCache& cache : caches) {
+			cache.invalidate();
+		}
+		frame(mode > 0, mode == 2, 0.0f);
+
+		uint64_t lit = 0, cached = 0;
+		double ms = 0.0;
+		for (uint32_t f = 0; f < 50; ++f) {
+			frame(mode > 0, mode == 2, static_cast<float>(f) * 0.3f);
+			lit += lighting.stats().verticesLit;
+			cached += lighting.stats().verticesCached;
+			ms += lighting.stats().lightMs;
+		}
+		std::printf("  %-17s %.3f ms a frame, %.0f vertices/ms (%llu lit, %llu from cache)\n",
+			names[mode], ms / 50.0, static_cast<double>(lit + cached) / ms, static_cast<unsigned long long>(lit), static_cast<unsigned long long>(cached));
+	}
+}
@@ -0,0 +1,145 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#include <Engine/gfx/Viewport.hh>
+
+#include <cstdio>
+#include <vector>
+
+//================================================================
+
+namespace {
+
+constexpr uint32_t WIDTH	= 640U;
+constexpr uint32_t HEIGHT	= 480U;
+
+// Render time proportional to the pixels drawn, `fullMs` at full resolution
+inline float frameCost(const Viewport& viewport, float fullMs) noexcept {
+	return fullMs * viewport.renderScale() * viewport.renderScale();
+}
+
+// Feed `frames` frames of the cost model, returns how often the render size changed
+uint32_t run(Viewport& viewport, float fullMs, uint32_t frames) {
+	uint32_t changes = 0;
+	for (uint32_t i = 0; i < frames; ++i) {
+		changes += viewport.update(frameCost(viewport, fullMs)) ? 1U : 0U;
+	}
+	return changes;
+}
+
+} // namespace
+
+//================================================================
+
+DD25_TEST(viewportDropsToMinScaleWhenOverBudget) {
+	Viewport viewport(WIDTH, HEIGHT);
+	const ViewportSettings& s = viewport.settings();
+	DD25_CHECK(viewport.renderScale() == s.maxScale);
+
+	// Even half resolution can't make the budget, the scale stops at the floor
+	run(viewport, s.budgetMs * 6.0f, 60);
+	DD25_CHECK(viewport.renderScale() == s.minScale);
+	DD25_CHECK(viewport.renderWidth() == WIDTH / 2U);
+	DD25_CHECK(viewport.renderHeight() == HEIGHT / 2U);
+	DD25_CHECK(viewport.traceCount() == 60);
+	DD25_CHECK(viewport.trace(0).scale == s.minScale);
+}
+
+DD25_TEST(viewportStepsBackUpWithoutOscillating) {
+	Viewport viewport(WIDTH, HEIGHT);
+	const ViewportSettings& s = viewport.settings();
+	viewport.setScale(s.minScale);
+
+	// Cheap frames: one raiseStep every raiseFrames, up to maxScale, never down
+	const uint32_t steps = static_cast<uint32_t>((s.maxScale - s.minScale) / s.raiseStep + 0.5f);
+	uint32_t changes = 0;
+	uint32_t drops = 0;
+	for (uint32_t i = 0; i < steps * s.raiseFrames; ++i) {
+		const float before = viewport.renderScale();
+		changes += viewport.update(frameCost(viewport, s.budgetMs * 0.5f)) ? 1U : 0U;
+		drops += (viewport.renderScale() < before) ? 1U : 0U;
+	}
+	DD25_CHECK(viewport.renderScale() == s.maxScale);
+	DD25_CHECK(changes == steps);
+	DD25_CHECK(drops == 0);
+	DD25_CHECK(run(viewport, s.budgetMs * 0.5f, 200) == 0);
+
+	// Heavier frames only ever step down (the average lags the load), then it stays put
+	uint32_t raises = 0;
+	for (uint32_t i = 0; i < 120; ++i) {
+		const float before = viewport.renderScale();
+		viewport.update(frameCost(viewport, s.budgetMs * 1.2f));
+		raises += (viewport.renderScale() > before) ? 1U : 0U;
+	}
+	DD25_CHECK(raises == 0);
+	const float settled = viewport.renderScale();
+	DD25_CHECK(settled > s.minScale && settled < s.maxScale);
+	DD25_CHECK(run(viewport, s.budgetMs * 1.2f, 600) == 0);
+	DD25_CHECK(viewport.renderScale() == settled);
+}
+
+DD25_TEST(viewportUpscaleKeepsConstantAndEqualImages) {
+	const uint32_t color = 0x80C04020U;
+	const uint32_t srcWidth = 37U, srcHeight = 23U;
+	const uint32_t dstWidth = 100U, dstHeight = 61U;
+	const std::vector<uint32_t> flat(static_cast<size_t>(srcWidth) * srcHeight, color);
+
+	for (const UpscaleFilter filter : { UpscaleFilter::Nearest, UpscaleFilter::Bilinear }) {
+		std::vector<uint32_t> out(static_cast<size_t>(dstWidth) * dstHeight, 0U);
+		upscaleArgb(flat.data(), srcWidth, srcHeight, srcWidth * sizeof(uint32_t), out.data(), dstWidth, dstHeight, dstWidth * sizeof(uint32_t), filter);
+		uint32_t wrong = 0;
+		for (const uint32_t p : out) {
+			wrong += (p != color) ? 1U : 0U;
+		}
+		DD25_CHECK(wrong == 0);
+	}
+
+	// Equal sizes copy exactly, whatever the strides
+	const uint32_t srcStride = srcWidth + 3U;
+	const uint32_t dstStride = srcWidth + 9U;
+	std::vector<uint32_t> image(static_cast<size_t>(srcStride) * srcHeight);
+	for (size_t i = 0; i < image.size(); ++i) {
+		image[i] = static_cast<uint32_t>(i * 2654435761U);
+	}
+	std::vector<uint32_t> copy(static_cast<size_t>(dstStride) * srcHeight, 0U);
+	upscaleArgb(image.data(), srcWidth, srcHeight, srcStride * sizeof(uint32_t), copy.data(), srcWidth, srcHeight, dstStride * sizeof(uint32_t), UpscaleFilter::Bilinear);
+	uint32_t wrong = 0;
+	for (uint32_t y = 0; y < srcHeight; ++y) {
+		for (uint32_t x = 0; x < srcWidth; ++x) {
+			wrong += (copy[static_cast<size_t>(y) * dstStride + x] != image[static_cast<size_t>(y) * srcStride + x]) ? 1U : 0U;
+		}
+		wrong += (copy[static_cast<size_t>(y) * dstStride + srcWidth] != 0U) ? 1U : 0U;	// Padding untouched
+	}
+	DD25_CHECK(wrong == 0);
+}
+
+//================================================================
+
+//
+// Presenting a frame rendered at each scale step to 640x480, nearest
+// and bilinear.
+//
+DD25_BENCH(viewportPresent) {
+	std::vector<uint32_t> rendered(static_cast<size_t>(WIDTH) * HEIGHT);
+	std::vector<uint32_t> output(static_cast<size_t>(WIDTH) * HEIGHT);
+	for (size_t i = 0; i < rendered.size(); ++i) {
+		rendered[i] = static_cast<uint32_t>(i * 2654435761U) | 0xFF000000U;
+	}
+
+	for (const float scale : { 0.5f, 0.75f, 1.0f }) {
+		ViewportSettings settings;
+		std::printf("  scale %.2f:", scale);
+		for (const UpscaleFilter filter : { UpscaleFilter::Nearest, UpscaleFilter::Bilinear }) {
+			settings.filter = filter;
+			Viewport viewport(WIDTH, HEIGHT, settings);
+			viewport.setScale(scale);
+			const double ms = bench::bestOf(10, [&]() {
+				viewport.present(rendered.data(), viewport.renderWidth() * sizeof(uint32_t), output.data(), WIDTH * sizeof(uint32_t));
+			});
+			std::printf(" %s %.3f ms", (filter == UpscaleFilter::Nearest) ? "nearest" : "bilinear", ms);
+		}
+		std::printf("\n");
+	}
+}
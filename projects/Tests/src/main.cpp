@@ -0,0 +1,62 @@
+// Dream Disk 2025 Game Tests
+// Author: Jesse Stojan
+// Copyright (c) 2025 Jesse Stojan.
+#include <Tests/Harness.hh>
+
+#ifndef EXIT_SUCCESS
+#define EXIT_SUCCESS	0
+#endif//EXIT_SUCCESS
+
+#ifndef EXIT_FAILURE
+#define EXIT_FAILURE	1
+#endif//EXIT_FAILURE
+
+#include <cstdio>
+#include <cstring>
+
+//================================================================
+
+void TestRegistry::fail(const char* file, int line, const char* expr) {
+	std::fprintf(stderr, "  %s:%d: check failed: %s\n", file, line, expr);
+	++failures();
+}
+
+//================================================================
+
+// Entry Point: DD25Tests [--bench] [name filter]
+int main(
+	int			argc,
+	char**		argv,
+	char**		envp
+) {
+	bool benchmarks = false;
+	const char* filter = nullptr;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--bench") == 0) {
+			benchmarks = true;
+		} else {
+			filter = argv[i];
+		}
+	}
+
+	uint32_t ran = 0;
+	uint32_t failed = 0;
+	for (const TestCase& test : TestRegistry::cases()) {
+		if (test.bench != benchmarks || (filter && !std::strstr(test.name, filter))) {
+			continue;
+		}
+		std::printf("%s %s\n", benchmarks ? "[bench]" : "[test] ", test.name);
+		std::fflush(stdout);
+
+		const uint32_t before = TestRegistry::failures();
+		test.run();
+		++ran;
+		if (TestRegistry::failures() != before) {
+			std::printf("  FAILED\n");
+			++failed;
+		}
+	}
+
+	std::printf("%u run, %u failed\n", ran, failed);
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}